@@ -0,0 +1,154 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/batched_simulator.h"
+
+#include <algorithm>
+#include <random>
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+int VectorSize(const Game& game, bool use_observation) {
+  return use_observation ? game.ObservationNormalizedVectorSize()
+                         : game.InformationStateNormalizedVectorSize();
+}
+
+}  // namespace
+
+BatchedSimulator::BatchedSimulator(const Game& game, int batch_size, int seed)
+    : game_(game),
+      batch_size_(batch_size),
+      observation_size_(VectorSize(
+          game, game.GetType().provides_observation_as_normalized_vector)),
+      num_distinct_actions_(game.NumDistinctActions()),
+      use_observation_(
+          game.GetType().provides_observation_as_normalized_vector),
+      rng_(seed) {
+  SPIEL_CHECK_GT(batch_size, 0);
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("BatchedSimulator only supports sequential games.");
+  }
+  states_.resize(batch_size_);
+  observations_.resize(batch_size_ * observation_size_);
+  legal_masks_.resize(batch_size_ * num_distinct_actions_);
+  mask_words_.resize((num_distinct_actions_ + 63) / 64);
+  current_players_.resize(batch_size_);
+  rewards_.resize(batch_size_ * game_.NumPlayers());
+  episode_ended_.resize(batch_size_);
+  Reset();
+}
+
+void BatchedSimulator::Reset() {
+  std::fill(rewards_.begin(), rewards_.end(), 0.0);
+  std::fill(episode_ended_.begin(), episode_ended_.end(), false);
+  for (int i = 0; i < batch_size_; ++i) {
+    states_[i] = game_.NewInitialState();
+    RollChanceNodes(i);
+    RefillRow(i);
+  }
+}
+
+void BatchedSimulator::StepAll(const std::vector<Action>& actions) {
+  SPIEL_CHECK_EQ(actions.size(), batch_size_);
+  const int num_players = game_.NumPlayers();
+  for (int i = 0; i < batch_size_; ++i) {
+    State* state = states_[i].get();
+    SPIEL_CHECK_FALSE(state->IsTerminal());
+    state->ApplyAction(actions[i]);
+    RollChanceNodes(i);
+    state = states_[i].get();
+
+    std::vector<double> rewards = state->Rewards();
+    for (int p = 0; p < num_players; ++p) {
+      rewards_[i * num_players + p] = rewards[p];
+    }
+
+    if (state->IsTerminal()) {
+      episode_ended_[i] = true;
+      states_[i] = game_.NewInitialState();
+      RollChanceNodes(i);
+    } else {
+      episode_ended_[i] = false;
+    }
+    RefillRow(i);
+  }
+}
+
+void BatchedSimulator::TransformedObservations(
+    int transform, std::vector<double>* observations) const {
+  const std::vector<int> shape =
+      use_observation_ ? game_.ObservationNormalizedVectorShape()
+                       : game_.InformationStateNormalizedVectorShape();
+  observations->resize(observations_.size());
+  for (int i = 0; i < batch_size_; ++i) {
+    SymmetryTransformPlanes(shape, transform,
+                            &observations_[i * observation_size_],
+                            &(*observations)[i * observation_size_]);
+  }
+}
+
+void BatchedSimulator::RollChanceNodes(int i) {
+  State* state = states_[i].get();
+  while (!state->IsTerminal() && state->IsChanceNode()) {
+    state->ApplyAction(
+        state
+            ->SampleChanceOutcome(
+                std::uniform_real_distribution<double>(0.0, 1.0)(rng_))
+            .first);
+  }
+}
+
+void BatchedSimulator::RefillRow(int i) {
+  const State* state = states_[i].get();
+  const int player = state->CurrentPlayer();
+  current_players_[i] = player;
+
+  double* observation_row = &observations_[i * observation_size_];
+  if (use_observation_) {
+    state->ObservationAsNormalizedVector(player, observation_row);
+  } else {
+    state->InformationStateAsNormalizedVector(player, observation_row);
+  }
+
+  // Masks come via the bitset fast path: games with bitboard move legality
+  // fill the words without generating a move list, and the expansion to the
+  // int row is a branch-free sweep.
+  int* mask_row = &legal_masks_[i * num_distinct_actions_];
+  state->LegalActionsBitset(mask_words_.data());
+  for (int a = 0; a < num_distinct_actions_; ++a) {
+    mask_row[a] = (mask_words_[a / 64] >> (a % 64)) & 1;
+  }
+}
+
+std::vector<std::unique_ptr<State>> SampleDealtInitialStates(const Game& game,
+                                                             int num_states,
+                                                             FastRng* rng) {
+  SPIEL_CHECK_GE(num_states, 0);
+  std::vector<std::unique_ptr<State>> states;
+  states.reserve(num_states);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int i = 0; i < num_states; ++i) {
+    std::unique_ptr<State> state = game.NewStateFromPool();
+    while (!state->IsTerminal() && state->IsChanceNode()) {
+      state->ApplyAction(state->SampleChanceOutcome(uniform(*rng)).first);
+    }
+    states.push_back(std::move(state));
+  }
+  return states;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
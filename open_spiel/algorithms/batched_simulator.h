@@ -0,0 +1,132 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_SIMULATOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_SIMULATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Advances a fixed batch of environments of one game in lockstep, the
+// vectorized-environment interface the learning loops expect. The per-step
+// data - observations, legal action masks, current players, rewards - is
+// kept in flat row-major buffers that are refilled in place on every step,
+// so a batched evaluator can consume them without further copying.
+//
+// Conventions:
+//  - Chance nodes are rolled forward internally with the simulator's own
+//    generator, so callers only ever see decision nodes.
+//  - When an episode ends, its returns are recorded, episode_ended() is set
+//    for that row, and the environment is reset to a fresh initial state in
+//    the same call; the buffers then describe the new episode's first
+//    decision node.
+//  - Rewards are read at the decision and terminal states the simulator
+//    stops at; only sequential games are supported.
+//
+// The game must outlive the simulator.
+class BatchedSimulator {
+ public:
+  BatchedSimulator(const Game& game, int batch_size, int seed = 0);
+
+  int batch_size() const { return batch_size_; }
+  int observation_size() const { return observation_size_; }
+  int num_distinct_actions() const { return num_distinct_actions_; }
+
+  // Resets every environment to a fresh initial state and refills the
+  // buffers. Called by the constructor.
+  void Reset();
+
+  // Applies actions[i] to environment i for every i and refills the buffers.
+  // actions.size() must equal batch_size(), and each action must be legal in
+  // its environment.
+  void StepAll(const std::vector<Action>& actions);
+
+  // [batch_size, observation_size]: row i is environment i's normalized
+  // observation (or information state, for games that only provide that) for
+  // the player to act.
+  const std::vector<double>& observations() const { return observations_; }
+
+  // Fills *observations with the current batch observations transformed by
+  // the given board symmetry (see SymmetryTransformCell in spiel_utils.h),
+  // for training-time data augmentation without a copy pass outside C++.
+  // Requires a 3-dimensional {planes, rows, cols} observation shape;
+  // policy targets trained against the transformed rows must be permuted
+  // with SymmetryCellPermutation. Which transforms are actual symmetries
+  // of the game is the caller's responsibility.
+  void TransformedObservations(int transform,
+                               std::vector<double>* observations) const;
+
+  // [batch_size, num_distinct_actions]: 1 for legal actions, 0 otherwise.
+  const std::vector<int>& legal_masks() const { return legal_masks_; }
+
+  // [batch_size]: the player to act in each environment.
+  const std::vector<int>& current_players() const { return current_players_; }
+
+  // [batch_size, num_players]: the rewards accrued by the last StepAll call,
+  // including the terminal rewards of episodes that ended during it.
+  const std::vector<double>& rewards() const { return rewards_; }
+
+  // [batch_size]: whether environment i's episode ended during the last
+  // StepAll call (and was therefore reset).
+  const std::vector<bool>& episode_ended() const { return episode_ended_; }
+
+  // Read access to the underlying states, e.g. for rendering.
+  const State& state(int i) const { return *states_[i]; }
+
+ private:
+  // Rolls environment i past any chance nodes.
+  void RollChanceNodes(int i);
+
+  // Refills the observation, legal mask and current player rows of
+  // environment i from its state.
+  void RefillRow(int i);
+
+  const Game& game_;
+  const int batch_size_;
+  const int observation_size_;
+  const int num_distinct_actions_;
+  const bool use_observation_;  // Observation vs information state vectors.
+
+  FastRng rng_;
+  std::vector<std::unique_ptr<State>> states_;
+
+  std::vector<double> observations_;
+  std::vector<int> legal_masks_;
+  std::vector<uint64_t> mask_words_;  // Scratch for LegalActionsBitset.
+  std::vector<int> current_players_;
+  std::vector<double> rewards_;
+  std::vector<bool> episode_ended_;
+};
+
+// Samples num_states dealt initial states in one call: each state is taken
+// from the game's state pool, rolled past its opening chance nodes (the
+// card deals in bridge, leduc_poker or liars_dice) with the shared rng
+// stream, and returned at its first decision node. Monte Carlo evaluation
+// jobs that need many fresh deals per step should use this instead of
+// constructing and dealing states one by one, and hand the states back via
+// Game::ReleaseStateToPool so their memory is recycled into the next batch.
+std::vector<std::unique_ptr<State>> SampleDealtInitialStates(const Game& game,
+                                                             int num_states,
+                                                             FastRng* rng);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_BATCHED_SIMULATOR_H_
@@ -0,0 +1,161 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/batched_simulator.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Steps a batch of tic-tac-toe environments and checks the buffers against
+// per-state computations every step.
+void BuffersMatchStatesTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  constexpr int kBatchSize = 4;
+  BatchedSimulator simulator(*game, kBatchSize);
+  SPIEL_CHECK_EQ(simulator.batch_size(), kBatchSize);
+  SPIEL_CHECK_EQ(simulator.observation_size(),
+                 game->ObservationNormalizedVectorSize());
+
+  FastRng rng(42);
+  for (int step = 0; step < 30; ++step) {
+    for (int i = 0; i < kBatchSize; ++i) {
+      const State& state = simulator.state(i);
+      SPIEL_CHECK_FALSE(state.IsTerminal());
+      SPIEL_CHECK_FALSE(state.IsChanceNode());
+      SPIEL_CHECK_EQ(simulator.current_players()[i], state.CurrentPlayer());
+
+      std::vector<int> mask = state.LegalActionsMask();
+      std::vector<double> observation =
+          state.ObservationAsNormalizedVector(state.CurrentPlayer());
+      for (int j = 0; j < simulator.num_distinct_actions(); ++j) {
+        SPIEL_CHECK_EQ(
+            simulator.legal_masks()[i * simulator.num_distinct_actions() + j],
+            mask[j]);
+      }
+      for (int j = 0; j < simulator.observation_size(); ++j) {
+        SPIEL_CHECK_EQ(
+            simulator.observations()[i * simulator.observation_size() + j],
+            observation[j]);
+      }
+    }
+
+    // Pick a random legal action per environment and step.
+    std::vector<Action> actions(kBatchSize);
+    for (int i = 0; i < kBatchSize; ++i) {
+      std::vector<Action> legal = simulator.state(i).LegalActions();
+      actions[i] = legal[rng() % legal.size()];
+    }
+    simulator.StepAll(actions);
+  }
+}
+
+// Pig has chance nodes; the simulator must roll past them and only ever
+// stop at decision nodes, and reset finished episodes automatically.
+void ChanceNodesAndAutoResetTest() {
+  std::unique_ptr<Game> game =
+      LoadGame("pig", {{"winscore", GameParameter(10)},
+                       {"horizon", GameParameter(30)}});
+  constexpr int kBatchSize = 8;
+  BatchedSimulator simulator(*game, kBatchSize, /*seed=*/7);
+
+  FastRng rng(1234);
+  int episodes_ended = 0;
+  for (int step = 0; step < 200; ++step) {
+    std::vector<Action> actions(kBatchSize);
+    for (int i = 0; i < kBatchSize; ++i) {
+      SPIEL_CHECK_FALSE(simulator.state(i).IsChanceNode());
+      SPIEL_CHECK_FALSE(simulator.state(i).IsTerminal());
+      std::vector<Action> legal = simulator.state(i).LegalActions();
+      actions[i] = legal[rng() % legal.size()];
+    }
+    simulator.StepAll(actions);
+    for (int i = 0; i < kBatchSize; ++i) {
+      if (simulator.episode_ended()[i]) {
+        ++episodes_ended;
+        // The terminal rewards of the finished episode are exposed, and the
+        // environment has already been reset to a fresh decision node.
+        double sum = 0;
+        for (int p = 0; p < game->NumPlayers(); ++p) {
+          sum += simulator.rewards()[i * game->NumPlayers() + p];
+        }
+        SPIEL_CHECK_FLOAT_EQ(sum, 0.0);  // Zero-sum game.
+        SPIEL_CHECK_EQ(simulator.state(i).History().size(), 0);
+      }
+    }
+  }
+  SPIEL_CHECK_GT(episodes_ended, 0);
+}
+
+// The batch deal generator hands back states at their first decision node
+// with the opening deal applied, and recycles pooled state memory between
+// batches.
+void SampleDealtInitialStatesTest() {
+  FastRng rng(99);
+  for (const char* game_name : {"leduc_poker", "liars_dice", "tic_tac_toe"}) {
+    std::unique_ptr<Game> game = LoadGame(game_name);
+    for (int batch = 0; batch < 3; ++batch) {
+      std::vector<std::unique_ptr<State>> states =
+          SampleDealtInitialStates(*game, /*num_states=*/16, &rng);
+      SPIEL_CHECK_EQ(states.size(), 16);
+      for (std::unique_ptr<State>& state : states) {
+        SPIEL_CHECK_FALSE(state->IsChanceNode());
+        SPIEL_CHECK_FALSE(state->IsTerminal());
+        SPIEL_CHECK_GE(state->CurrentPlayer(), 0);
+        game->ReleaseStateToPool(std::move(state));
+      }
+    }
+  }
+}
+
+// Transformed observation rows are the symmetry transform of the plain
+// rows: the identity leaves them unchanged and the 180-degree rotation is
+// its own inverse.
+void TransformedObservationsTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  const std::vector<int> shape = game->ObservationNormalizedVectorShape();
+  BatchedSimulator simulator(*game, /*batch_size=*/2);
+  simulator.StepAll({0, 4});
+
+  std::vector<double> identity;
+  simulator.TransformedObservations(/*transform=*/0, &identity);
+  SPIEL_CHECK_TRUE(identity == simulator.observations());
+
+  std::vector<double> rotated;
+  simulator.TransformedObservations(/*transform=*/2, &rotated);
+  std::vector<double> restored(rotated.size());
+  for (int i = 0; i < simulator.batch_size(); ++i) {
+    SymmetryTransformPlanes(shape, /*transform=*/2,
+                            &rotated[i * simulator.observation_size()],
+                            &restored[i * simulator.observation_size()]);
+  }
+  SPIEL_CHECK_TRUE(restored == simulator.observations());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::BuffersMatchStatesTest();
+  open_spiel::algorithms::ChanceNodesAndAutoResetTest();
+  open_spiel::algorithms::SampleDealtInitialStatesTest();
+  open_spiel::algorithms::TransformedObservationsTest();
+}
@@ -15,12 +15,245 @@
 #include "open_spiel/algorithms/cfr.h"
 
 #include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <utility>
 
+#include "open_spiel/algorithms/cfr_checkpoint.h"
+#include "open_spiel/algorithms/tree_traversal.h"
 #include "open_spiel/spiel_optional.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/thread_affinity.h"
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
+
+// Kernels for the inner loops of regret matching, shared by the table
+// representations and the regret-matching+ reset. They are deliberately
+// branch-free straight-line arithmetic over contiguous arrays: the
+// per-element `if (regret > 0)` of the obvious formulation prevents
+// compilers from vectorizing these loops, while max/divide/multiply-add map
+// directly onto SIMD instructions. On wide-action games these loops are a
+// large share of an iteration, so this matters more than it looks.
+
+// Returns the sum of max(regrets[i], 0) over the first `n` entries.
+inline double SumPositiveRegrets(const double* regrets, int n) {
+  double sum = 0.0;
+  for (int i = 0; i < n; ++i) {
+    sum += std::max(regrets[i], 0.0);
+  }
+  return sum;
+}
+
+// Fills policy[i] = max(regrets[i], 0) / sum_positive_regrets. Division is
+// kept (rather than multiplying by the reciprocal) so the results are
+// bit-identical to the branching formulation it replaces.
+inline void PositiveRegretsToPolicy(const double* regrets,
+                                    double sum_positive_regrets,
+                                    double* policy, int n) {
+  for (int i = 0; i < n; ++i) {
+    policy[i] = std::max(regrets[i], 0.0) / sum_positive_regrets;
+  }
+}
+
+// The regret-matching+ floor: regrets[i] = max(regrets[i], 0).
+inline void FloorRegretsAtZero(double* regrets, int n) {
+  for (int i = 0; i < n; ++i) {
+    regrets[i] = std::max(regrets[i], 0.0);
+  }
+}
+
+// Accumulates dst[i] += weight * src[i].
+inline void AccumulateWeighted(const double* src, double weight, double* dst,
+                               int n) {
+  for (int i = 0; i < n; ++i) {
+    dst[i] += weight * src[i];
+  }
+}
+
+// Scales values[i] *= factor.
+inline void ScaleArray(double* values, double factor, int n) {
+  for (int i = 0; i < n; ++i) {
+    values[i] *= factor;
+  }
+}
+
+// The discounting sweep over regrets: positive entries are scaled by
+// pos_factor, the rest by neg_factor. The select compiles to a blend, so
+// the loop stays vectorizable.
+inline void DiscountRegrets(double* regrets, double pos_factor,
+                            double neg_factor, int n) {
+  for (int i = 0; i < n; ++i) {
+    regrets[i] *= regrets[i] > 0 ? pos_factor : neg_factor;
+  }
+}
+
+}  // namespace
+
+namespace {
+
+// The recursion behind BuildTreeOrderedFlatTable: depth-first, children in
+// legal-action order, mirroring the CFR traversal.
+void AddInfoStatesDepthFirst(const State& state, double init_value,
+                             CFRInfoStateValuesFlatTable* table) {
+  if (state.IsTerminal()) {
+    return;
+  }
+  if (state.IsChanceNode()) {
+    for (const auto& outcome : state.ChanceOutcomes()) {
+      AddInfoStatesDepthFirst(*state.Child(outcome.first), init_value, table);
+    }
+    return;
+  }
+  std::string info_state = state.InformationStateKey(state.CurrentPlayer());
+  std::vector<Action> legal_actions = state.LegalActions();
+  if (table->GetId(info_state) == -1) {
+    table->AddInfoState(info_state, legal_actions, init_value);
+  }
+  for (const Action& action : legal_actions) {
+    AddInfoStatesDepthFirst(*state.Child(action), init_value, table);
+  }
+}
+
+}  // namespace
+
+CFRInfoStateValuesFlatTable BuildTreeOrderedFlatTable(const Game& game,
+                                                      double init_value) {
+  CFRInfoStateValuesFlatTable table;
+  AddInfoStatesDepthFirst(*game.NewInitialState(), init_value, &table);
+  return table;
+}
+
+namespace {
+
+// Largest magnitude over `n` entries, the basis of the int16 scales.
+double MaxAbsValue(const std::vector<double>& values, int begin, int n) {
+  double max_abs = 0.0;
+  for (int i = 0; i < n; ++i) {
+    max_abs = std::max(max_abs, std::fabs(values[begin + i]));
+  }
+  return max_abs;
+}
+
+// Quantizes value against scale (the magnitude mapped to 32767); a zero
+// scale means the whole range is zero.
+int16_t QuantizeInt16(double value, float scale) {
+  if (scale == 0) return 0;
+  return static_cast<int16_t>(std::lround(value / scale * 32767.0));
+}
+
+}  // namespace
+
+CFRQuantizedInfoStateValuesTable::CFRQuantizedInfoStateValuesTable(
+    const CFRInfoStateValuesTable& table, CFRValueStorage storage,
+    double hot_threshold)
+    : storage_(storage), offsets_(1, 0) {
+  ids_.reserve(table.size());
+  offsets_.reserve(table.size() + 1);
+  // Reserve exactly: ApproxBytes reports capacities, and geometric growth
+  // would overstate the footprint by up to 2x.
+  std::size_t total_values = 0;
+  for (const auto& entry : table) total_values += entry.second.num_actions();
+  legal_actions_.reserve(total_values);
+  if (storage_ == CFRValueStorage::kFloat32) {
+    regrets_f32_.reserve(total_values);
+    policy_f32_.reserve(total_values);
+  } else {
+    regrets_i16_.reserve(total_values);
+    policy_i16_.reserve(total_values);
+    scales_.reserve(table.size());
+  }
+  for (const auto& entry : table) {
+    const CFRInfoStateValues& vals = entry.second;
+    const int num = vals.num_actions();
+    ids_[entry.first] = num_info_states();
+    offsets_.push_back(offsets_.back() + num);
+    legal_actions_.insert(legal_actions_.end(), vals.legal_actions.begin(),
+                          vals.legal_actions.end());
+
+    const double max_abs =
+        std::max(MaxAbsValue(vals.cumulative_regrets, 0, num),
+                 MaxAbsValue(vals.cumulative_policy, 0, num));
+    if (max_abs > hot_threshold) {
+      // Too large to quantize acceptably; keep the doubles. The quantized
+      // slots are still filled so the arrays stay aligned with offsets_.
+      hot_entries_[entry.first] = vals;
+    }
+
+    if (storage_ == CFRValueStorage::kFloat32) {
+      for (int aidx = 0; aidx < num; ++aidx) {
+        regrets_f32_.push_back(vals.cumulative_regrets[aidx]);
+        policy_f32_.push_back(vals.cumulative_policy[aidx]);
+      }
+    } else {
+      // One scale for both rows: the error stays within max_abs / 32767,
+      // the bound the class documents.
+      const float scale = max_abs;
+      scales_.push_back(scale);
+      for (int aidx = 0; aidx < num; ++aidx) {
+        regrets_i16_.push_back(
+            QuantizeInt16(vals.cumulative_regrets[aidx], scale));
+        policy_i16_.push_back(
+            QuantizeInt16(vals.cumulative_policy[aidx], scale));
+      }
+    }
+  }
+}
+
+CFRInfoStateValuesTable CFRQuantizedInfoStateValuesTable::Dequantize() const {
+  CFRInfoStateValuesTable table;
+  table.reserve(ids_.size());
+  for (const auto& entry : ids_) {
+    auto hot_iter = hot_entries_.find(entry.first);
+    if (hot_iter != hot_entries_.end()) {
+      table[entry.first] = hot_iter->second;
+      continue;
+    }
+    const int id = entry.second;
+    const int begin = offsets_[id];
+    const int num = offsets_[id + 1] - begin;
+    CFRInfoStateValues vals(std::vector<Action>(
+        legal_actions_.begin() + begin, legal_actions_.begin() + begin + num));
+    if (storage_ == CFRValueStorage::kFloat32) {
+      for (int aidx = 0; aidx < num; ++aidx) {
+        vals.cumulative_regrets[aidx] = regrets_f32_[begin + aidx];
+        vals.cumulative_policy[aidx] = policy_f32_[begin + aidx];
+      }
+    } else {
+      const double scale = scales_[id] / 32767.0;
+      for (int aidx = 0; aidx < num; ++aidx) {
+        vals.cumulative_regrets[aidx] = regrets_i16_[begin + aidx] * scale;
+        vals.cumulative_policy[aidx] = policy_i16_[begin + aidx] * scale;
+      }
+    }
+    table[entry.first] = vals;
+  }
+  return table;
+}
+
+int64_t CFRQuantizedInfoStateValuesTable::ApproxBytes() const {
+  int64_t bytes = static_cast<int64_t>(ids_.bucket_count()) * sizeof(void*);
+  for (const auto& entry : ids_) {
+    bytes += sizeof(entry) + 2 * sizeof(void*) + entry.first.capacity();
+  }
+  bytes += static_cast<int64_t>(offsets_.capacity()) * sizeof(int) +
+           static_cast<int64_t>(legal_actions_.capacity()) * sizeof(Action) +
+           static_cast<int64_t>(regrets_f32_.capacity() +
+                                policy_f32_.capacity() +
+                                scales_.capacity()) *
+               sizeof(float) +
+           static_cast<int64_t>(regrets_i16_.capacity() +
+                                policy_i16_.capacity()) *
+               sizeof(int16_t);
+  for (const auto& entry : hot_entries_) {
+    bytes += sizeof(entry) + 2 * sizeof(void*) + entry.first.capacity() +
+             static_cast<int64_t>(entry.second.num_actions()) *
+                 (sizeof(Action) + 2 * sizeof(double));
+  }
+  return bytes;
+}
 
 CFRAveragePolicy::CFRAveragePolicy(
     const CFRInfoStateValuesTable& info_states,
@@ -56,17 +289,153 @@ ActionsAndProbs CFRAveragePolicy::GetStatePolicy(
   return actions_and_probs;
 }
 
+CFRCurrentPolicy::CFRCurrentPolicy(
+    const CFRInfoStateValuesTable& info_states,
+    std::shared_ptr<TabularPolicy> default_policy)
+    : info_states_(info_states), default_policy_(default_policy) {}
+
+ActionsAndProbs CFRCurrentPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  ActionsAndProbs actions_and_probs;
+  auto entry = info_states_.find(info_state);
+  if (entry == info_states_.end()) {
+    if (default_policy_) {
+      return default_policy_->GetStatePolicy(info_state);
+    } else {
+      return actions_and_probs;
+    }
+  }
+
+  const auto& is_vals = entry->second;
+  const int num = is_vals.num_actions();
+  const double sum_positive_regrets =
+      SumPositiveRegrets(is_vals.cumulative_regrets.data(), num);
+  for (int aidx = 0; aidx < num; ++aidx) {
+    const double prob =
+        sum_positive_regrets > 0
+            ? std::max(is_vals.cumulative_regrets[aidx], 0.0) /
+                  sum_positive_regrets
+            : 1.0 / num;
+    actions_and_probs.push_back({is_vals.legal_actions[aidx], prob});
+  }
+  return actions_and_probs;
+}
+
+CFRInfoStateValuesFlatTable::CFRInfoStateValuesFlatTable(
+    const CFRInfoStateValuesTable& table)
+    : offsets_(1, 0) {
+  for (const auto& entry : table) {
+    int id = AddInfoState(entry.first, entry.second.legal_actions);
+    const int begin = offsets_[id];
+    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+      cumulative_regrets_[begin + aidx] =
+          entry.second.cumulative_regrets[aidx];
+      cumulative_policy_[begin + aidx] = entry.second.cumulative_policy[aidx];
+    }
+  }
+}
+
+int CFRInfoStateValuesFlatTable::AddInfoState(
+    const std::string& info_state, const std::vector<Action>& legal_actions,
+    double init_value) {
+  SPIEL_CHECK_EQ(ids_.count(info_state), 0);
+  const int id = num_info_states();
+  ids_[info_state] = id;
+  offsets_.push_back(offsets_.back() + legal_actions.size());
+  legal_actions_.insert(legal_actions_.end(), legal_actions.begin(),
+                        legal_actions.end());
+  cumulative_regrets_.resize(offsets_.back(), init_value);
+  cumulative_policy_.resize(offsets_.back(), init_value);
+  current_policy_.resize(offsets_.back(), 0);
+  return id;
+}
+
+int CFRInfoStateValuesFlatTable::GetId(const std::string& info_state) const {
+  auto it = ids_.find(info_state);
+  return it == ids_.end() ? -1 : it->second;
+}
+
+void CFRInfoStateValuesFlatTable::ApplyRegretMatching() {
+  for (int id = 0; id < num_info_states(); ++id) {
+    const int begin = offsets_[id];
+    const int num = offsets_[id + 1] - begin;
+    const double sum_positive_regrets =
+        SumPositiveRegrets(&cumulative_regrets_[begin], num);
+    if (sum_positive_regrets > 0) {
+      PositiveRegretsToPolicy(&cumulative_regrets_[begin], sum_positive_regrets,
+                              &current_policy_[begin], num);
+    } else {
+      std::fill(current_policy_.begin() + begin,
+                current_policy_.begin() + begin + num, 1.0 / num);
+    }
+  }
+}
+
+void CFRInfoStateValuesFlatTable::ApplyDiscounting(double pos_factor,
+                                                   double neg_factor,
+                                                   double policy_factor) {
+  // One fused sweep per array; no per-info-state indirection.
+  DiscountRegrets(cumulative_regrets_.data(), pos_factor, neg_factor,
+                  cumulative_regrets_.size());
+  ScaleArray(cumulative_policy_.data(), policy_factor,
+             cumulative_policy_.size());
+}
+
+CFRInfoStateValuesTable CFRInfoStateValuesFlatTable::ToTable() const {
+  CFRInfoStateValuesTable table;
+  for (const auto& entry : ids_) {
+    const int begin = offsets_[entry.second];
+    const int num = num_actions(entry.second);
+    CFRInfoStateValues is_vals(std::vector<Action>(
+        legal_actions_.begin() + begin, legal_actions_.begin() + begin + num));
+    for (int aidx = 0; aidx < num; ++aidx) {
+      is_vals.cumulative_regrets[aidx] = cumulative_regrets_[begin + aidx];
+      is_vals.cumulative_policy[aidx] = cumulative_policy_[begin + aidx];
+    }
+    table[entry.first] = is_vals;
+  }
+  return table;
+}
+
+int64_t ApproxTableBytes(const CFRInfoStateValuesTable& table) {
+  // The bucket array, plus per entry the hash node (key/value pair and a
+  // couple of pointers of node overhead), the key's heap storage and the
+  // four value arrays.
+  int64_t bytes = static_cast<int64_t>(table.bucket_count()) * sizeof(void*);
+  for (const auto& entry : table) {
+    bytes += sizeof(entry) + 2 * sizeof(void*);
+    bytes += entry.first.capacity();
+    const CFRInfoStateValues& vals = entry.second;
+    bytes += static_cast<int64_t>(vals.legal_actions.capacity()) *
+                 sizeof(Action) +
+             static_cast<int64_t>(vals.cumulative_regrets.capacity() +
+                                  vals.cumulative_policy.capacity() +
+                                  vals.cached_policy.capacity()) *
+                 sizeof(double);
+  }
+  return bytes;
+}
+
 CFRSolverBase::CFRSolverBase(const Game& game,
                              bool initialize_cumulative_values,
                              bool alternating_updates, bool linear_averaging,
                              bool regret_matching_plus)
     : game_(game),
+      root_state_(game.NewInitialState()),
+      root_reach_probs_(game_.NumPlayers() + 1, 1.0),
       regret_matching_plus_(regret_matching_plus),
       alternating_updates_(alternating_updates),
       linear_averaging_(linear_averaging),
       chance_player_(game.NumPlayers()),
-      root_state_(game.NewInitialState()),
-      root_reach_probs_(game_.NumPlayers() + 1, 1.0) {
+      two_player_zero_sum_(
+          game.NumPlayers() == 2 &&
+          game.GetType().utility == GameType::Utility::kZeroSum) {
+  // Reserve the value table up front when the game declares its info state
+  // count; rehashing a large table mid-run costs a full copy and transiently
+  // doubles its memory.
+  if (game.ExpectedNumInfoStates() > 0) {
+    info_states_.reserve(game.ExpectedNumInfoStates());
+  }
   if (initialize_cumulative_values) {
     InitializeUniformPolicy(*root_state_);
   }
@@ -84,7 +453,7 @@ void CFRSolverBase::InitializeUniformPolicy(const State& state) {
   }
 
   int current_player = state.CurrentPlayer();
-  std::string info_state = state.InformationState(current_player);
+  std::string info_state = state.InformationStateKey(current_player);
   std::vector<Action> legal_actions = state.LegalActions();
 
   CFRInfoStateValues is_vals(legal_actions, kInitialPositiveValue_);
@@ -95,23 +464,124 @@ void CFRSolverBase::InitializeUniformPolicy(const State& state) {
   }
 }
 
+void CFRSolverBase::WarmStart(const Policy& policy, double weight,
+                              const CFRInfoStateKeyMap& info_state_map) {
+  SPIEL_CHECK_GT(weight, 0);
+  // Priming after updates have run would mix two accumulation scales.
+  SPIEL_CHECK_EQ(iteration_, 0);
+  DepthFirstTraversal traversal(game_.NewInitialState());
+  while (const State* state = traversal.Next()) {
+    if (state->IsTerminal() || state->IsChanceNode()) continue;
+    const std::string info_state = state->InformationStateKey();
+    const ActionsAndProbs source_policy = policy.GetStatePolicy(
+        info_state_map ? info_state_map(info_state) : info_state);
+    if (source_policy.empty()) continue;
+    const std::vector<Action> legal_actions = state->LegalActions();
+    CFRInfoStateValues is_vals(legal_actions);
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      const double prob = GetProb(source_policy, legal_actions[aidx]);
+      if (prob <= 0) continue;  // Missing or zero-probability action.
+      // Positive regrets proportional to the probabilities make regret
+      // matching reproduce the source policy; the same mass in the
+      // cumulative policy seeds the average.
+      is_vals.cumulative_regrets[aidx] = weight * prob;
+      is_vals.cumulative_policy[aidx] = weight * prob;
+    }
+    info_states_[info_state] = is_vals;
+  }
+}
+
 void CFRSolverBase::EvaluateAndUpdatePolicy() {
+  SPIEL_STATS_TIMER("cfr/evaluate_and_update_policy");
+  SPIEL_STATS_INC("cfr/iterations");
   ++iteration_;
+  // 2-player zero-sum games take the scalar recursion. Depth-limited solving
+  // stays on the general path, as leaf evaluators return per-player values.
+  const bool scalar_path = two_player_zero_sum_ && trunk_depth_ == 0;
   if (alternating_updates_) {
     for (int player = 0; player < game_.NumPlayers(); player++) {
-      ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_);
+      if (scalar_path) {
+        ComputeCounterFactualRegret2p(*root_state_, player, 1.0, 1.0, 1.0);
+      } else {
+        ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_);
+      }
       if (regret_matching_plus_) {
         ApplyRegretMatchingPlusReset();
       }
       ClearCachedPolicies();
     }
   } else {
-    ComputeCounterFactualRegret(*root_state_, kNullopt, root_reach_probs_);
+    if (scalar_path) {
+      ComputeCounterFactualRegret2p(*root_state_, kNullopt, 1.0, 1.0, 1.0);
+    } else {
+      ComputeCounterFactualRegret(*root_state_, kNullopt, root_reach_probs_);
+    }
     if (regret_matching_plus_) {
       ApplyRegretMatchingPlusReset();
     }
     ClearCachedPolicies();
   }
+  if (discounting_ != CFRDiscounting::kNone) {
+    ApplyDiscountingSweep();
+  }
+  // The table only grows during the traversals above, so the iteration
+  // boundary is the one place the budget needs checking — and the one place
+  // a checkpoint is clean to resume from.
+  CheckMemoryBudget();
+  SPIEL_STATS_SET_GAUGE("cfr/table_size", info_states_.size());
+}
+
+void CFRSolverBase::SetMemoryBudget(int64_t max_bytes,
+                                    const std::string& checkpoint_filename) {
+  max_table_bytes_ = max_bytes;
+  budget_checkpoint_filename_ = checkpoint_filename;
+}
+
+void CFRSolverBase::CheckMemoryBudget() const {
+  if (max_table_bytes_ <= 0) return;
+  const int64_t bytes = ApproxTableBytes(info_states_);
+  if (bytes < max_table_bytes_) return;
+  std::string message = absl::StrCat(
+      "CFR value table over its memory budget after iteration ", iteration_,
+      ": ~", bytes, " bytes used, budget ", max_table_bytes_, ".");
+  if (!budget_checkpoint_filename_.empty()) {
+    SaveCheckpoint(budget_checkpoint_filename_);
+    absl::StrAppend(&message, " Checkpoint written to ",
+                    budget_checkpoint_filename_,
+                    "; resume with LoadCheckpoint.");
+  }
+  SpielFatalError(message);
+}
+
+void CFRSolverBase::EnableDiscounting(CFRDiscounting discounting,
+                                      double alpha, double beta,
+                                      double gamma) {
+  discounting_ = discounting;
+  discount_alpha_ = alpha;
+  discount_beta_ = beta;
+  discount_gamma_ = gamma;
+}
+
+// Applies the end-of-iteration discount factors (see CFRDiscounting in the
+// header) to every table entry.
+void CFRSolverBase::ApplyDiscountingSweep() {
+  const double t = iteration_;
+  double pos_factor, neg_factor, policy_factor;
+  if (discounting_ == CFRDiscounting::kLinear) {
+    pos_factor = neg_factor = policy_factor = t / (t + 1);
+  } else {
+    const double t_alpha = std::pow(t, discount_alpha_);
+    const double t_beta = std::pow(t, discount_beta_);
+    pos_factor = t_alpha / (t_alpha + 1);
+    neg_factor = t_beta / (t_beta + 1);
+    policy_factor = std::pow(t / (t + 1), discount_gamma_);
+  }
+  for (auto& entry : info_states_) {
+    const int num = entry.second.num_actions();
+    DiscountRegrets(entry.second.cumulative_regrets.data(), pos_factor,
+                    neg_factor, num);
+    ScaleArray(entry.second.cumulative_policy.data(), policy_factor, num);
+  }
 }
 
 static double CounterFactualReachProb(
@@ -139,16 +609,39 @@ static double CounterFactualReachProb(
 std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
     const State& state, const Optional<int>& alternating_player,
     const std::vector<double>& reach_probabilities) {
+  SPIEL_STATS_INC("cfr/nodes_visited");
   if (state.IsTerminal()) {
     return state.Returns();
   }
+  // Depth-limited solving (see EnableDepthLimit): the subtree below the
+  // trunk is replaced by a cached leaf value.
+  if (trunk_depth_ > 0 &&
+      static_cast<int>(state.History().size()) >= trunk_depth_) {
+    return LeafValue(state);
+  }
+  // Reach-probability pruning (see CFRReachPruningSolver): outside of the
+  // periodic full passes, skip subtrees whose counterfactual reach for the
+  // updating player has fallen below the threshold. Every regret update
+  // below here is weighted by at most that reach; the zero value returned
+  // slightly biases the ancestors' updates until the next full pass.
+  if (reach_full_pass_every_ > 0 && alternating_player &&
+      iteration_ % reach_full_pass_every_ != 0 &&
+      CounterFactualReachProb(reach_probabilities, *alternating_player) <
+          reach_pruning_threshold_) {
+    return std::vector<double>(game_.NumPlayers(), 0.0);
+  }
   if (state.IsChanceNode()) {
-    ActionsAndProbs actions_and_probs = state.ChanceOutcomes();
-    std::vector<double> dist(actions_and_probs.size(), 0);
-    std::vector<Action> outcomes(actions_and_probs.size(), 0);
-    for (int oidx = 0; oidx < actions_and_probs.size(); ++oidx) {
-      outcomes[oidx] = actions_and_probs[oidx].first;
-      dist[oidx] = actions_and_probs[oidx].second;
+    ActionsAndProbs local_outcomes;
+    const ActionsAndProbs* actions_and_probs = state.StaticChanceOutcomes();
+    if (actions_and_probs == nullptr) {
+      local_outcomes = state.ChanceOutcomes();
+      actions_and_probs = &local_outcomes;
+    }
+    std::vector<double> dist(actions_and_probs->size(), 0);
+    std::vector<Action> outcomes(actions_and_probs->size(), 0);
+    for (int oidx = 0; oidx < actions_and_probs->size(); ++oidx) {
+      outcomes[oidx] = (*actions_and_probs)[oidx].first;
+      dist[oidx] = (*actions_and_probs)[oidx].second;
     }
     return ComputeCounterFactualRegretForActionProbs(
         state, alternating_player, reach_probabilities, chance_player_, dist,
@@ -162,41 +655,83 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegret(
   }
 
   int current_player = state.CurrentPlayer();
-  std::string info_state = state.InformationState();
-  std::vector<Action> legal_actions = state.LegalActions(current_player);
-  std::vector<double> info_state_policy =
-      ComputeOrGetPolicy(info_state, legal_actions);
+  // Children are visited through Child() clones, so `state` is not modified
+  // while these references are held.
+  const std::string& info_state = state.InformationStateKeyCached();
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+
+  // When this player's policy is overridden (see policy_overrides_ in the
+  // header), play the override and leave the table alone: the overridden
+  // player's regrets and average policy are not part of the update.
+  const bool overridden = !policy_overrides_.empty() &&
+                          policy_overrides_[current_player] != nullptr;
+  std::vector<double> info_state_policy;
+  if (overridden) {
+    ActionsAndProbs override_policy =
+        policy_overrides_[current_player]->GetStatePolicy(info_state);
+    info_state_policy.reserve(legal_actions.size());
+    for (const Action& action : legal_actions) {
+      const double prob = GetProb(override_policy, action);
+      info_state_policy.push_back(prob >= 0 ? prob : 0.0);
+    }
+  } else {
+    info_state_policy = ComputeOrGetPolicy(info_state, legal_actions);
+  }
+
+  // Regret-based pruning (see CFRPruningSolver): at the updating player's
+  // nodes, mark actions that regret matching has excluded and whose
+  // cumulative regret sits below the threshold; their subtrees are skipped
+  // below, except on periodic revisit iterations.
+  std::vector<bool> pruned_actions;
+  bool any_pruned = false;
+  if (prune_revisit_every_ > 0 && !overridden && alternating_player &&
+      *alternating_player == current_player &&
+      iteration_ % prune_revisit_every_ != 0) {
+    auto entry = info_states_.find(info_state);
+    if (entry != info_states_.end()) {
+      pruned_actions.resize(legal_actions.size(), false);
+      for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+        if (info_state_policy[aidx] == 0.0 &&
+            entry->second.cumulative_regrets[aidx] < pruning_threshold_) {
+          pruned_actions[aidx] = true;
+          any_pruned = true;
+        }
+      }
+    }
+  }
 
   std::vector<double> child_utilities;
   child_utilities.reserve(legal_actions.size());
   const std::vector<double> state_value =
       ComputeCounterFactualRegretForActionProbs(
           state, alternating_player, reach_probabilities, current_player,
-          info_state_policy, legal_actions, &child_utilities);
+          info_state_policy, legal_actions, &child_utilities,
+          any_pruned ? &pruned_actions : nullptr);
+
+  if (overridden) {
+    return state_value;
+  }
 
-  CFRInfoStateValues is_vals = info_states_[info_state];
+  CFRInfoStateValues& is_vals = info_states_[info_state];
   SPIEL_CHECK_FALSE(is_vals.empty());
 
   if (!alternating_player || *alternating_player == current_player) {
     const double self_reach_prob = reach_probabilities[current_player];
     const double cfr_reach_prob =
         CounterFactualReachProb(reach_probabilities, current_player);
+    const double current_value = state_value[current_player];
+    // Linear averaging only changes the accumulation weight, so the branch
+    // can be hoisted out of the loop.
+    const double policy_weight =
+        linear_averaging_ ? iteration_ * self_reach_prob : self_reach_prob;
 
     for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
-      double cfr_regret = cfr_reach_prob *
-                          (child_utilities[aidx] - state_value[current_player]);
-
-      is_vals.cumulative_regrets[aidx] += cfr_regret;
-      if (linear_averaging_) {
-        is_vals.cumulative_policy[aidx] +=
-            iteration_ * self_reach_prob * info_state_policy[aidx];
-      } else {
-        is_vals.cumulative_policy[aidx] +=
-            self_reach_prob * info_state_policy[aidx];
-      }
+      if (any_pruned && pruned_actions[aidx]) continue;
+      is_vals.cumulative_regrets[aidx] +=
+          cfr_reach_prob * (child_utilities[aidx] - current_value);
     }
-
-    info_states_[info_state] = is_vals;
+    AccumulateWeighted(info_state_policy.data(), policy_weight,
+                       is_vals.cumulative_policy.data(), legal_actions.size());
   }
 
   return state_value;
@@ -220,10 +755,17 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegretForActionProbs(
     const std::vector<double>& reach_probabilities, const int current_player,
     const std::vector<double>& info_state_policy,
     const std::vector<Action>& legal_actions,
-    std::vector<double>* child_values_out) {
+    std::vector<double>* child_values_out,
+    const std::vector<bool>* pruned_actions) {
   std::vector<double> state_value(game_.NumPlayers());
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    if (pruned_actions != nullptr && (*pruned_actions)[aidx]) {
+      // The action has probability zero, so the subtree contributes nothing
+      // to the state value; the caller skips its regret update as well.
+      if (child_values_out != nullptr) child_values_out->push_back(0);
+      continue;
+    }
     const Action action = legal_actions[aidx];
     const double prob = info_state_policy[aidx];
     const std::unique_ptr<State> new_state = state.Child(action);
@@ -241,6 +783,135 @@ std::vector<double> CFRSolverBase::ComputeCounterFactualRegretForActionProbs(
   return state_value;
 }
 
+// Two-player zero-sum specialization of the recursion above. Values are
+// tracked from player 0's perspective only (player 1's value is the exact
+// negation), and the reach-probability vector is replaced by three scalars,
+// so a node allocates nothing beyond its child states and the per-action
+// utility buffer. The regret and average-policy updates are identical to the
+// general path, and on a zero-sum game the two recursions produce bitwise
+// identical tables.
+double CFRSolverBase::ComputeCounterFactualRegret2p(
+    const State& state, const Optional<int>& alternating_player,
+    const double reach_p0, const double reach_p1, const double reach_chance) {
+  SPIEL_STATS_INC("cfr/nodes_visited");
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(0);
+  }
+  // Reach-probability pruning, as in the general recursion.
+  if (reach_full_pass_every_ > 0 && alternating_player &&
+      iteration_ % reach_full_pass_every_ != 0 &&
+      (*alternating_player == 0 ? reach_p1 : reach_p0) * reach_chance <
+          reach_pruning_threshold_) {
+    return 0.0;
+  }
+  if (state.IsChanceNode()) {
+    double value = 0;
+    ActionsAndProbs local_outcomes;
+    const ActionsAndProbs* chance_outcomes = state.StaticChanceOutcomes();
+    if (chance_outcomes == nullptr) {
+      local_outcomes = state.ChanceOutcomes();
+      chance_outcomes = &local_outcomes;
+    }
+    for (const auto& outcome_and_prob : *chance_outcomes) {
+      const std::unique_ptr<State> child = state.Child(outcome_and_prob.first);
+      value += outcome_and_prob.second *
+               ComputeCounterFactualRegret2p(
+                   *child, alternating_player, reach_p0, reach_p1,
+                   reach_chance * outcome_and_prob.second);
+    }
+    return value;
+  }
+  if (reach_p0 == 0.0 && reach_p1 == 0.0) {
+    // As in the general recursion, a value under an all-zero reach never
+    // influences the parent update.
+    return 0.0;
+  }
+
+  const int current_player = state.CurrentPlayer();
+  const std::string& info_state = state.InformationStateKeyCached();
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+
+  const bool overridden = !policy_overrides_.empty() &&
+                          policy_overrides_[current_player] != nullptr;
+  std::vector<double> info_state_policy;
+  if (overridden) {
+    ActionsAndProbs override_policy =
+        policy_overrides_[current_player]->GetStatePolicy(info_state);
+    info_state_policy.reserve(legal_actions.size());
+    for (const Action& action : legal_actions) {
+      const double prob = GetProb(override_policy, action);
+      info_state_policy.push_back(prob >= 0 ? prob : 0.0);
+    }
+  } else {
+    info_state_policy = ComputeOrGetPolicy(info_state, legal_actions);
+  }
+
+  // Regret-based pruning, exactly as in the general recursion.
+  std::vector<bool> pruned_actions;
+  bool any_pruned = false;
+  if (prune_revisit_every_ > 0 && !overridden && alternating_player &&
+      *alternating_player == current_player &&
+      iteration_ % prune_revisit_every_ != 0) {
+    auto entry = info_states_.find(info_state);
+    if (entry != info_states_.end()) {
+      pruned_actions.resize(legal_actions.size(), false);
+      for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+        if (info_state_policy[aidx] == 0.0 &&
+            entry->second.cumulative_regrets[aidx] < pruning_threshold_) {
+          pruned_actions[aidx] = true;
+          any_pruned = true;
+        }
+      }
+    }
+  }
+
+  std::vector<double> child_utilities;  // For current_player.
+  child_utilities.reserve(legal_actions.size());
+  double state_value = 0.0;  // Player 0's value.
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    if (any_pruned && pruned_actions[aidx]) {
+      child_utilities.push_back(0);
+      continue;
+    }
+    const double prob = info_state_policy[aidx];
+    const std::unique_ptr<State> new_state = state.Child(legal_actions[aidx]);
+    const double child_value = ComputeCounterFactualRegret2p(
+        *new_state, alternating_player,
+        current_player == 0 ? reach_p0 * prob : reach_p0,
+        current_player == 1 ? reach_p1 * prob : reach_p1, reach_chance);
+    state_value += prob * child_value;
+    child_utilities.push_back(current_player == 0 ? child_value
+                                                  : -child_value);
+  }
+
+  if (overridden) {
+    return state_value;
+  }
+
+  CFRInfoStateValues& is_vals = info_states_[info_state];
+  SPIEL_CHECK_FALSE(is_vals.empty());
+
+  if (!alternating_player || *alternating_player == current_player) {
+    const double self_reach_prob = current_player == 0 ? reach_p0 : reach_p1;
+    const double cfr_reach_prob =
+        (current_player == 0 ? reach_p1 : reach_p0) * reach_chance;
+    const double current_value =
+        current_player == 0 ? state_value : -state_value;
+    const double policy_weight =
+        linear_averaging_ ? iteration_ * self_reach_prob : self_reach_prob;
+
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      if (any_pruned && pruned_actions[aidx]) continue;
+      is_vals.cumulative_regrets[aidx] +=
+          cfr_reach_prob * (child_utilities[aidx] - current_value);
+    }
+    AccumulateWeighted(info_state_policy.data(), policy_weight,
+                       is_vals.cumulative_policy.data(), legal_actions.size());
+  }
+
+  return state_value;
+}
+
 bool CFRSolverBase::AllPlayersHaveZeroReachProb(
     const std::vector<double>& reach_probabilities) const {
   for (int i = 0; i < game_.NumPlayers(); i++) {
@@ -270,23 +941,16 @@ std::vector<double> CFRSolverBase::ComputeOrGetPolicy(
 }
 
 void CFRInfoStateValues::ApplyRegretMatching() {
-  double sum_positive_regrets = 0.0;
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (cumulative_regrets[aidx] > 0) {
-      sum_positive_regrets += cumulative_regrets[aidx];
-    }
-  }
+  const int num = num_actions();
+  const double sum_positive_regrets =
+      SumPositiveRegrets(cumulative_regrets.data(), num);
 
-  cached_policy.resize(legal_actions.size());
-  for (int aidx = 0; aidx < num_actions(); ++aidx) {
-    if (sum_positive_regrets > 0) {
-      cached_policy[aidx] =
-          cumulative_regrets[aidx] > 0
-              ? cumulative_regrets[aidx] / sum_positive_regrets
-              : 0;
-    } else {
-      cached_policy[aidx] = 1.0 / legal_actions.size();
-    }
+  cached_policy.resize(num);
+  if (sum_positive_regrets > 0) {
+    PositiveRegretsToPolicy(cumulative_regrets.data(), sum_positive_regrets,
+                            cached_policy.data(), num);
+  } else {
+    std::fill(cached_policy.begin(), cached_policy.end(), 1.0 / num);
   }
 }
 
@@ -313,12 +977,105 @@ int CFRInfoStateValues::SampleActionIndex(double epsilon, double z) {
 //  performed as an additional step.
 void CFRSolverBase::ApplyRegretMatchingPlusReset() {
   for (auto& entry : info_states_) {
-    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
-      if (entry.second.cumulative_regrets[aidx] < 0) {
-        entry.second.cumulative_regrets[aidx] = 0;
+    FloorRegretsAtZero(entry.second.cumulative_regrets.data(),
+                       entry.second.num_actions());
+  }
+}
+
+void CFRSolverBase::SaveCheckpoint(const std::string& filename) const {
+  SaveCFRCheckpoint(filename, game_.ToString(), iteration_,
+                    /*rng_state=*/"", info_states_);
+}
+
+void CFRSolverBase::LoadCheckpoint(const std::string& filename) {
+  CFRCheckpoint checkpoint = LoadCFRCheckpoint(filename);
+  if (checkpoint.game_string != game_.ToString()) {
+    SpielFatalError("CFR checkpoint was written for a different game: " +
+                    checkpoint.game_string);
+  }
+  iteration_ = checkpoint.iteration;
+  info_states_ = std::move(checkpoint.table);
+}
+
+void CFRSolverBase::EnableRegretPruning(double threshold, int revisit_every) {
+  SPIEL_CHECK_LT(threshold, 0);
+  SPIEL_CHECK_GE(revisit_every, 1);
+  if (!alternating_updates_) {
+    SpielFatalError("Regret-based pruning requires alternating updates.");
+  }
+  pruning_threshold_ = threshold;
+  prune_revisit_every_ = revisit_every;
+}
+
+void CFRSolverBase::EnableReachPruning(double reach_threshold,
+                                       int full_pass_every) {
+  SPIEL_CHECK_GT(reach_threshold, 0);
+  SPIEL_CHECK_LT(reach_threshold, 1);
+  SPIEL_CHECK_GE(full_pass_every, 1);
+  if (!alternating_updates_) {
+    SpielFatalError(
+        "Reach-probability pruning requires alternating updates.");
+  }
+  reach_pruning_threshold_ = reach_threshold;
+  reach_full_pass_every_ = full_pass_every;
+}
+
+void CFRSolverBase::EnableDepthLimit(int depth, CFRLeafEvaluator evaluator,
+                                     int num_rollouts, int seed) {
+  SPIEL_CHECK_GE(depth, 1);
+  if (evaluator == nullptr) {
+    SPIEL_CHECK_GE(num_rollouts, 1);
+  }
+  trunk_depth_ = depth;
+  leaf_evaluator_ = std::move(evaluator);
+  leaf_rollouts_ = num_rollouts;
+  leaf_rng_.seed(seed);
+}
+
+// Returns the leaf value for a depth-limited state, computing and caching it
+// on first visit. The cache is keyed by history, so every iteration after
+// the first reads the trunk boundary from the cache and never descends below
+// it.
+std::vector<double> CFRSolverBase::LeafValue(const State& state) {
+  const std::string key = state.HistoryString();
+  auto it = leaf_value_cache_.find(key);
+  if (it != leaf_value_cache_.end()) {
+    return it->second;
+  }
+  std::vector<double> value = leaf_evaluator_ != nullptr
+                                  ? leaf_evaluator_(state)
+                                  : RolloutLeafValue(state);
+  SPIEL_CHECK_EQ(value.size(), game_.NumPlayers());
+  leaf_value_cache_[key] = value;
+  return value;
+}
+
+// The default evaluator: average returns over leaf_rollouts_ uniform-random
+// playouts from the state.
+std::vector<double> CFRSolverBase::RolloutLeafValue(const State& state) {
+  std::vector<double> value(game_.NumPlayers(), 0.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int rollout = 0; rollout < leaf_rollouts_; ++rollout) {
+    std::unique_ptr<State> playout = state.Clone();
+    while (!playout->IsTerminal()) {
+      if (playout->IsChanceNode()) {
+        playout->ApplyAction(SampleChanceOutcome(playout->ChanceOutcomes(),
+                                                 uniform(leaf_rng_)));
+      } else {
+        std::vector<Action> legal_actions = playout->LegalActions();
+        std::uniform_int_distribution<int> dist(0, legal_actions.size() - 1);
+        playout->ApplyAction(legal_actions[dist(leaf_rng_)]);
       }
     }
+    std::vector<double> returns = playout->Returns();
+    for (int p = 0; p < game_.NumPlayers(); ++p) {
+      value[p] += returns[p];
+    }
+  }
+  for (int p = 0; p < game_.NumPlayers(); ++p) {
+    value[p] /= leaf_rollouts_;
   }
+  return value;
 }
 
 void CFRSolverBase::ClearCachedPolicies() {
@@ -327,5 +1084,180 @@ void CFRSolverBase::ClearCachedPolicies() {
   }
 }
 
+CFRParallelSolver::CFRParallelSolver(const Game& game, int num_threads,
+                                     bool pin_workers, bool deterministic)
+    : game_(game),
+      num_threads_(num_threads),
+      pin_workers_(pin_workers),
+      deterministic_(deterministic),
+      chance_player_(game.NumPlayers()),
+      root_state_(game.NewInitialState()) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (!root_state_->IsChanceNode()) {
+    SpielFatalError(
+        "CFRParallelSolver requires the initial state to be a chance node; "
+        "that is where the work is partitioned.");
+  }
+  if (game.ExpectedNumInfoStates() > 0) {
+    info_states_.reserve(game.ExpectedNumInfoStates());
+  }
+}
+
+void CFRParallelSolver::EvaluateAndUpdatePolicy() {
+  SPIEL_STATS_TIMER("cfr/evaluate_and_update_policy");
+  SPIEL_STATS_INC("cfr/iterations");
+  ActionsAndProbs root_outcomes = root_state_->ChanceOutcomes();
+  // In deterministic mode every root outcome gets its own local table and
+  // the tables merge in outcome order, fixing the floating point addition
+  // order regardless of how the outcomes land on workers; otherwise the
+  // outcomes a worker handles share one table, merged in worker order.
+  std::vector<CFRInfoStateValuesTable> local_tables(
+      deterministic_ ? root_outcomes.size() : num_threads_);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    workers.emplace_back([this, t, &root_outcomes, &local_tables]() {
+      if (pin_workers_) PinCurrentThreadToCpu(t % NumAvailableCpus());
+      // Round-robin assignment of root outcomes to this worker.
+      for (int oidx = t; oidx < root_outcomes.size(); oidx += num_threads_) {
+        std::vector<double> reach_probabilities(game_.NumPlayers() + 1, 1.0);
+        reach_probabilities[chance_player_] = root_outcomes[oidx].second;
+        TraverseSubtree(*root_state_->Child(root_outcomes[oidx].first),
+                        reach_probabilities,
+                        &local_tables[deterministic_ ? oidx : t]);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const CFRInfoStateValuesTable& local_table : local_tables) {
+    MergeTable(local_table);
+  }
+  SPIEL_STATS_SET_GAUGE("cfr/table_size", info_states_.size());
+}
+
+// Returns the current policy for the info state, doing regret matching over
+// the cumulative regrets in the shared table (which is read-only while the
+// worker threads run). Info states not yet in the table play uniformly.
+std::vector<double> CFRParallelSolver::PolicyFromSharedTable(
+    const std::string& info_state,
+    const std::vector<Action>& legal_actions) const {
+  auto entry = info_states_.find(info_state);
+  if (entry == info_states_.end()) {
+    return std::vector<double>(legal_actions.size(),
+                               1.0 / legal_actions.size());
+  }
+  const std::vector<double>& regrets = entry->second.cumulative_regrets;
+  double sum_positive_regrets = 0.0;
+  for (double regret : regrets) {
+    if (regret > 0) sum_positive_regrets += regret;
+  }
+  std::vector<double> policy(regrets.size());
+  for (int aidx = 0; aidx < regrets.size(); ++aidx) {
+    if (sum_positive_regrets > 0) {
+      policy[aidx] =
+          regrets[aidx] > 0 ? regrets[aidx] / sum_positive_regrets : 0;
+    } else {
+      policy[aidx] = 1.0 / regrets.size();
+    }
+  }
+  return policy;
+}
+
+// The worker-side analogue of ComputeCounterFactualRegret: reads policies
+// from the shared table and writes all increments to local_table.
+std::vector<double> CFRParallelSolver::TraverseSubtree(
+    const State& state, const std::vector<double>& reach_probabilities,
+    CFRInfoStateValuesTable* local_table) const {
+  if (state.IsTerminal()) {
+    return state.Returns();
+  }
+  if (state.IsChanceNode()) {
+    std::vector<double> state_value(game_.NumPlayers(), 0.0);
+    ActionsAndProbs local_outcomes;
+    const ActionsAndProbs* chance_outcomes = state.StaticChanceOutcomes();
+    if (chance_outcomes == nullptr) {
+      local_outcomes = state.ChanceOutcomes();
+      chance_outcomes = &local_outcomes;
+    }
+    for (const auto& outcome : *chance_outcomes) {
+      std::vector<double> new_reach_probabilities(reach_probabilities);
+      new_reach_probabilities[chance_player_] *= outcome.second;
+      std::vector<double> child_value = TraverseSubtree(
+          *state.Child(outcome.first), new_reach_probabilities, local_table);
+      for (int i = 0; i < state_value.size(); ++i) {
+        state_value[i] += outcome.second * child_value[i];
+      }
+    }
+    return state_value;
+  }
+  bool all_zero = true;
+  for (int i = 0; i < game_.NumPlayers(); ++i) {
+    if (reach_probabilities[i] != 0.0) {
+      all_zero = false;
+      break;
+    }
+  }
+  if (all_zero) {
+    return std::vector<double>(game_.NumPlayers(), 0.0);
+  }
+
+  const int current_player = state.CurrentPlayer();
+  const std::string& info_state = state.InformationStateKeyCached();
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+  const std::vector<double> info_state_policy =
+      PolicyFromSharedTable(info_state, legal_actions);
+
+  std::vector<double> state_value(game_.NumPlayers(), 0.0);
+  std::vector<double> child_utilities;
+  child_utilities.reserve(legal_actions.size());
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    const double prob = info_state_policy[aidx];
+    std::vector<double> new_reach_probabilities(reach_probabilities);
+    new_reach_probabilities[current_player] *= prob;
+    std::vector<double> child_value =
+        TraverseSubtree(*state.Child(legal_actions[aidx]),
+                        new_reach_probabilities, local_table);
+    for (int i = 0; i < state_value.size(); ++i) {
+      state_value[i] += prob * child_value[i];
+    }
+    child_utilities.push_back(child_value[current_player]);
+  }
+
+  CFRInfoStateValues& local_vals = (*local_table)[info_state];
+  if (local_vals.empty()) {
+    local_vals = CFRInfoStateValues(legal_actions);
+  }
+  const double self_reach_prob = reach_probabilities[current_player];
+  const double cfr_reach_prob =
+      CounterFactualReachProb(reach_probabilities, current_player);
+  const double current_value = state_value[current_player];
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    local_vals.cumulative_regrets[aidx] +=
+        cfr_reach_prob * (child_utilities[aidx] - current_value);
+  }
+  AccumulateWeighted(info_state_policy.data(), self_reach_prob,
+                     local_vals.cumulative_policy.data(),
+                     legal_actions.size());
+  return state_value;
+}
+
+void CFRParallelSolver::MergeTable(const CFRInfoStateValuesTable& local_table) {
+  for (const auto& entry : local_table) {
+    auto it = info_states_.find(entry.first);
+    if (it == info_states_.end()) {
+      info_states_[entry.first] = entry.second;
+      continue;
+    }
+    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+      it->second.cumulative_regrets[aidx] +=
+          entry.second.cumulative_regrets[aidx];
+      it->second.cumulative_policy[aidx] +=
+          entry.second.cumulative_policy[aidx];
+    }
+  }
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
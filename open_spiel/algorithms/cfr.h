@@ -15,6 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_H_
 
+#include <cstdint>
+#include <functional>
+#include <random>
+
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_optional.h"
@@ -50,6 +54,150 @@ struct CFRInfoStateValues {
 using CFRInfoStateValuesTable =
     std::unordered_map<std::string, CFRInfoStateValues>;
 
+// Approximate heap footprint of the table in bytes: the keys, the four
+// per-entry value arrays, and an estimate of the hash map's own storage.
+// Allocator overhead is not counted, so treat the result as a lower bound.
+int64_t ApproxTableBytes(const CFRInfoStateValuesTable& table);
+
+// A structure-of-arrays counterpart of CFRInfoStateValuesTable: the regrets,
+// cumulative policies and current policies of all info states live in
+// contiguous arrays, indexed by a dense info state id plus a per-info-state
+// offset. A full regret-matching sweep is then a single pass over contiguous
+// memory (amenable to vectorization), and the per-entry overhead of the
+// map-of-structs representation goes away, which matters for Leduc-sized
+// tables and above.
+class CFRInfoStateValuesFlatTable {
+ public:
+  CFRInfoStateValuesFlatTable() : offsets_(1, 0) {}
+
+  // Builds a flat table holding the same values as `table`. Dense ids are
+  // assigned in the table's iteration order.
+  explicit CFRInfoStateValuesFlatTable(const CFRInfoStateValuesTable& table);
+
+  // Adds an info state which must not already be present, returning its
+  // dense id. Values are initialized to init_value.
+  int AddInfoState(const std::string& info_state,
+                   const std::vector<Action>& legal_actions,
+                   double init_value = 0);
+
+  // Returns the dense id for the info state, or -1 if it is not present.
+  int GetId(const std::string& info_state) const;
+
+  int num_info_states() const { return offsets_.size() - 1; }
+  int num_actions(int id) const { return offsets_[id + 1] - offsets_[id]; }
+
+  // Entries for info state `id` live in the half-open index range
+  // [offset(id), offset(id + 1)) of the arrays below.
+  int offset(int id) const { return offsets_[id]; }
+  std::vector<Action>& legal_actions() { return legal_actions_; }
+  std::vector<double>& cumulative_regrets() { return cumulative_regrets_; }
+  std::vector<double>& cumulative_policy() { return cumulative_policy_; }
+  std::vector<double>& current_policy() { return current_policy_; }
+  const std::vector<Action>& legal_actions() const { return legal_actions_; }
+  const std::vector<double>& cumulative_regrets() const {
+    return cumulative_regrets_;
+  }
+  const std::vector<double>& cumulative_policy() const {
+    return cumulative_policy_;
+  }
+  const std::vector<double>& current_policy() const { return current_policy_; }
+
+  // Applies regret matching to every info state in one pass over the
+  // contiguous arrays, filling current_policy().
+  void ApplyRegretMatching();
+
+  // Scales every cumulative regret by pos_factor (where positive) or
+  // neg_factor (where negative), and every cumulative policy entry by
+  // policy_factor, as one fused sweep per contiguous array. This is the
+  // discounting step of LCFR/DCFR (see the discounting solvers below).
+  void ApplyDiscounting(double pos_factor, double neg_factor,
+                        double policy_factor);
+
+  // Copies the values back into the map-of-structs representation, e.g. to
+  // extract an average policy through CFRAveragePolicy.
+  CFRInfoStateValuesTable ToTable() const;
+
+ private:
+  std::unordered_map<std::string, int> ids_;
+  std::vector<int> offsets_;  // Length num_info_states() + 1.
+  std::vector<Action> legal_actions_;
+  std::vector<double> cumulative_regrets_;
+  std::vector<double> cumulative_policy_;
+  std::vector<double> current_policy_;
+};
+
+// Builds a flat table covering every info state of the game, with dense ids
+// assigned in depth-first visitation order — the order the CFR tree walk
+// touches info states. With the structure-of-arrays layout this makes a
+// traversal's table accesses near-sequential in memory instead of following
+// the hash map's scattered placement, which matters once the table outgrows
+// the caches. Ids are assigned at an info state's first DFS visit, matching
+// the first touch in a traversal. Values are initialized to init_value.
+CFRInfoStateValuesFlatTable BuildTreeOrderedFlatTable(const Game& game,
+                                                      double init_value = 0);
+
+// Storage precision of a quantized value table. kFloat32 stores every value
+// as a 4-byte float (half the memory of doubles, ~7 significant digits);
+// kInt16 stores 2-byte integers against one scale factor per info state and
+// per array (a quarter of the memory, relative error bounded by 1/65534 of
+// the info state's largest magnitude).
+enum class CFRValueStorage {
+  kFloat32,
+  kInt16,
+};
+
+// A quantized, memory-compact copy of a CFRInfoStateValuesTable. Cumulative
+// regrets only steer regret matching and cumulative policies are normalized
+// on read, so the low-order bits of their doubles carry no information a
+// stored table needs: quantized storage halves (fp32) or quarters (int16)
+// the value memory, which is the binding constraint on which games fit on a
+// solve box. Info states whose largest magnitude exceeds hot_threshold —
+// where absolute quantization error would grow with the magnitude — keep
+// their values in full doubles on the side; for a converged table these hot
+// entries are few.
+//
+// The quantized table is storage, not a live solver accumulator: small
+// regret increments would vanish against a large quantized sum. Dequantize
+// back to a CFRInfoStateValuesTable to resume solving (e.g. through
+// WarmStart or by continuing on the dequantized table) or to extract a
+// policy through CFRAveragePolicy. Cached policies are transient and not
+// stored; regret matching recomputes them.
+class CFRQuantizedInfoStateValuesTable {
+ public:
+  explicit CFRQuantizedInfoStateValuesTable(
+      const CFRInfoStateValuesTable& table,
+      CFRValueStorage storage = CFRValueStorage::kFloat32,
+      double hot_threshold = 1e9);
+
+  // Rebuilds a full-precision table holding the dequantized values.
+  CFRInfoStateValuesTable Dequantize() const;
+
+  int num_info_states() const { return offsets_.size() - 1; }
+  int num_hot_entries() const { return hot_entries_.size(); }
+
+  // Approximate heap footprint in bytes, on the same basis as
+  // ApproxTableBytes so before/after comparisons are meaningful.
+  int64_t ApproxBytes() const;
+
+ private:
+  CFRValueStorage storage_;
+  std::unordered_map<std::string, int> ids_;
+  std::vector<int> offsets_;  // Length num_info_states() + 1.
+  std::vector<Action> legal_actions_;
+  // kFloat32 storage.
+  std::vector<float> regrets_f32_;
+  std::vector<float> policy_f32_;
+  // kInt16 storage: values against one scale per info state, shared by the
+  // regret and policy rows. Sharing keeps the error within the documented
+  // max_abs / 32767 bound while halving the scale overhead, which at two
+  // actions per info state would otherwise eat the whole width saving.
+  std::vector<int16_t> regrets_i16_;
+  std::vector<int16_t> policy_i16_;
+  std::vector<float> scales_;  // Length num_info_states().
+  // Entries kept in full precision; Dequantize prefers these.
+  std::unordered_map<std::string, CFRInfoStateValues> hot_entries_;
+};
+
 // A policy that extracts the average policy from the CFR table values, which
 // can be passed to tabular exploitability.
 class CFRAveragePolicy : public Policy {
@@ -67,6 +215,47 @@ class CFRAveragePolicy : public Policy {
   std::shared_ptr<TabularPolicy> default_policy_;
 };
 
+// A policy that extracts the current (regret-matched) policy from the CFR
+// table values. Unlike the cached policies inside the solvers, this computes
+// the regret matching on every lookup, so it always reflects the table's
+// current regrets and never mutates the table.
+class CFRCurrentPolicy : public Policy {
+ public:
+  // Returns the current policy from the CFR values. If a default policy is
+  // passed in, then it is used if the lookup fails (use nullptr to not use a
+  // default policy).
+  CFRCurrentPolicy(const CFRInfoStateValuesTable& info_states,
+                   std::shared_ptr<TabularPolicy> default_policy);
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+
+ private:
+  const CFRInfoStateValuesTable& info_states_;
+  std::shared_ptr<TabularPolicy> default_policy_;
+};
+
+// Discounting schemes applied to the cumulative regrets and policy at
+// iteration boundaries (Brown & Sandholm, "Solving Imperfect-Information
+// Games via Discounted Regret Minimization", AAAI 2019). Linear CFR scales
+// both by t/(t+1) after iteration t, which is equivalent to weighting
+// iteration t's contributions by t. Discounted CFR scales positive regrets
+// by t^alpha/(t^alpha+1), negative regrets by t^beta/(t^beta+1), and the
+// cumulative policy by (t/(t+1))^gamma.
+enum class CFRDiscounting {
+  kNone,
+  kLinear,
+  kDiscounted,
+};
+
+// Evaluates a depth-limited leaf state, returning a value for each player.
+// Used by the depth-limited (trunk) solving option; see EnableDepthLimit and
+// CFRTrunkSolver below. The state passed in is non-terminal.
+using CFRLeafEvaluator = std::function<std::vector<double>(const State&)>;
+
+// Maps one game's information state key to the corresponding key of the
+// game a warm-start policy was solved on. Used by CFRSolverBase::WarmStart
+// for cross-configuration warm starts; identity when null.
+using CFRInfoStateKeyMap = std::function<std::string(const std::string&)>;
+
 // Base class supporting different flavours of the Counterfactual Regret
 // Minimization (CFR) algorithm.
 //
@@ -87,9 +276,10 @@ class CFRSolverBase {
   CFRSolverBase(const Game& game, bool initialize_cumulative_values,
                 bool alternating_updates, bool linear_averaging,
                 bool regret_matching_plus);
+  virtual ~CFRSolverBase() = default;
 
   // Performs one step of the CFR algorithm.
-  void EvaluateAndUpdatePolicy();
+  virtual void EvaluateAndUpdatePolicy();
 
   // Computes the average policy, containing the policy for all players.
   // The returned policy instance should only be used during the lifetime of
@@ -98,47 +288,168 @@ class CFRSolverBase {
     return std::unique_ptr<Policy>(new CFRAveragePolicy(info_states_, nullptr));
   }
 
- private:
-  static constexpr double kInitialPositiveValue_ = 1e-5;
+  // Read-only view of the cumulative value table. Used by the streaming
+  // policy export (see policy_export.h), which writes average-policy
+  // snapshots straight from the table instead of materializing a second one.
+  const CFRInfoStateValuesTable& InfoStateValuesTable() const {
+    return info_states_;
+  }
+
+  // Writes the solver state (iteration count and the cumulative value table)
+  // to a binary checkpoint file, and restores it so a run can be resumed.
+  // Loading checks the checkpoint was written for the same game. See
+  // cfr_checkpoint.h for the format.
+  void SaveCheckpoint(const std::string& filename) const;
+  void LoadCheckpoint(const std::string& filename);
 
+  // Caps the cumulative value table at roughly max_bytes (non-positive, the
+  // default, means unlimited). The budget is checked at the end of every
+  // EvaluateAndUpdatePolicy — the table only grows during iterations — and
+  // when exceeded the solver writes a checkpoint to checkpoint_filename (if
+  // one is given) and stops with SpielFatalError, so a run on a game that
+  // turns out not to fit ends at a clean, resumable iteration boundary
+  // instead of being OOM-killed mid-traversal. Resume on a bigger machine
+  // with LoadCheckpoint. The check uses ApproxTableBytes, a lower bound, so
+  // leave the budget some headroom below the actual memory limit.
+  void SetMemoryBudget(int64_t max_bytes,
+                       const std::string& checkpoint_filename = "");
+
+  // Primes the tables from an existing policy before the first iteration:
+  // at every information state covered by the policy, the cumulative
+  // regrets and cumulative policy are set to `weight` times the policy's
+  // action probabilities, so regret matching reproduces the policy on the
+  // first iteration and the prior carries roughly `weight` iterations'
+  // worth of accumulated mass before new regrets can move the policy away.
+  // When `info_state_map` is non-null it translates this game's information
+  // state keys to the keys of the (possibly differently configured) game
+  // the policy was solved on, enabling warm starts across a config sweep;
+  // information states the policy does not cover are left untouched. Must
+  // be called before the first EvaluateAndUpdatePolicy.
+  void WarmStart(const Policy& policy, double weight = 1.0,
+                 const CFRInfoStateKeyMap& info_state_map = nullptr);
+
+ protected:
   std::vector<double> ComputeCounterFactualRegret(
       const State& state, const Optional<int>& alternating_player,
       const std::vector<double>& reach_probabilities);
 
+  void ApplyRegretMatchingPlusReset();
+
+  void ClearCachedPolicies();
+
+  const Game& game_;
+  const std::unique_ptr<State> root_state_;
+  const std::vector<double> root_reach_probs_;
+
+  // Iteration to support linear_policy.
+  int iteration_ = 0;
+  CFRInfoStateValuesTable info_states_;
+
+  // When non-empty, the traversal reads the policy at the given player's
+  // decision nodes from the override instead of regret matching, and skips
+  // the regret and average-policy updates there. This is the extension point
+  // for best-response-aware variants (see cfr_br.h); the plain solvers leave
+  // it empty. A null entry means no override for that player.
+  std::vector<const Policy*> policy_overrides_;
+
+  // Enables regret-based pruning (see CFRPruningSolver below for the
+  // semantics). Only valid with alternating updates.
+  void EnableRegretPruning(double threshold, int revisit_every);
+
+  // Enables reach-probability pruning (see CFRReachPruningSolver below for
+  // the semantics). Only valid with alternating updates.
+  void EnableReachPruning(double reach_threshold, int full_pass_every);
+
+  // Enables discounting (see CFRDiscounting above and the LCFR/DCFR solvers
+  // below). The exponents are only read in kDiscounted mode.
+  void EnableDiscounting(CFRDiscounting discounting, double alpha = 1.5,
+                         double beta = 0.5, double gamma = 2.0);
+
+  // Enables depth-limited (trunk) solving: non-terminal states `depth` moves
+  // from the root (counting chance moves) are treated as leaves whose values
+  // come from `evaluator`, or — when evaluator is null — from the average
+  // returns of `num_rollouts` uniform-random playouts. A leaf's value is
+  // computed on first visit and cached by history, so later iterations
+  // traverse only the trunk. See CFRTrunkSolver below.
+  void EnableDepthLimit(int depth, CFRLeafEvaluator evaluator = nullptr,
+                        int num_rollouts = 100, int seed = 0);
+
+ private:
+  static constexpr double kInitialPositiveValue_ = 1e-5;
+
   std::vector<double> ComputeCounterFactualRegretForActionProbs(
       const State& state, const Optional<int>& alternating_player,
       const std::vector<double>& reach_probabilities, const int current_player,
       const std::vector<double>& info_state_policy,
       const std::vector<Action>& legal_actions,
-      std::vector<double>* child_values_out = nullptr);
+      std::vector<double>* child_values_out = nullptr,
+      const std::vector<bool>* pruned_actions = nullptr);
+
+  // Two-player zero-sum specialization of ComputeCounterFactualRegret: the
+  // per-player value vector collapses to a scalar (player 0's value; player
+  // 1's is its negation) and the reach-probability vector to three scalars,
+  // removing the per-node heap allocations and player loops of the general
+  // recursion. Selected automatically in EvaluateAndUpdatePolicy when the
+  // game qualifies; the general recursion remains for N-player and
+  // general-sum games and for depth-limited solving, whose leaf evaluators
+  // return per-player values.
+  double ComputeCounterFactualRegret2p(
+      const State& state, const Optional<int>& alternating_player,
+      double reach_p0, double reach_p1, double reach_chance);
 
   void InitializeUniformPolicy(const State& state);
 
   std::vector<double> ComputeOrGetPolicy(
       const std::string& info_state, const std::vector<Action>& legal_actions);
 
-  void ApplyRegretMatchingPlusReset();
-
   std::vector<double> RegretMatching(const std::string& info_state,
                                      const std::vector<Action>& legal_actions);
 
   bool AllPlayersHaveZeroReachProb(
       const std::vector<double>& reach_probabilities) const;
 
-  void ClearCachedPolicies();
-
-  const Game& game_;
   const bool regret_matching_plus_;
   const bool alternating_updates_;
   const bool linear_averaging_;
 
   const int chance_player_;
-  const std::unique_ptr<State> root_state_;
-  const std::vector<double> root_reach_probs_;
 
-  // Iteration to support linear_policy.
-  int iteration_ = 0;
-  CFRInfoStateValuesTable info_states_;
+  // True when the game is 2-player zero-sum; enables the scalar recursion
+  // above.
+  const bool two_player_zero_sum_;
+
+  // Regret-based pruning state; pruning is off while prune_revisit_every_
+  // is 0. See EnableRegretPruning.
+  double pruning_threshold_ = 0;
+  int prune_revisit_every_ = 0;
+
+  // Reach-probability pruning state; off while reach_full_pass_every_ is 0.
+  // See EnableReachPruning.
+  double reach_pruning_threshold_ = 0;
+  int reach_full_pass_every_ = 0;
+
+  // Memory budget state; off while max_table_bytes_ is 0. See
+  // SetMemoryBudget.
+  void CheckMemoryBudget() const;
+  int64_t max_table_bytes_ = 0;
+  std::string budget_checkpoint_filename_;
+
+  // Discounting state; see EnableDiscounting.
+  void ApplyDiscountingSweep();
+  CFRDiscounting discounting_ = CFRDiscounting::kNone;
+  double discount_alpha_ = 1.5;
+  double discount_beta_ = 0.5;
+  double discount_gamma_ = 2.0;
+
+  // Depth-limited solving state; off while trunk_depth_ is 0. See
+  // EnableDepthLimit.
+  std::vector<double> LeafValue(const State& state);
+  std::vector<double> RolloutLeafValue(const State& state);
+  int trunk_depth_ = 0;
+  CFRLeafEvaluator leaf_evaluator_;
+  int leaf_rollouts_ = 0;
+  std::mt19937 leaf_rng_;
+  std::unordered_map<std::string, std::vector<double>> leaf_value_cache_;
 };
 
 // Standard CFR implementation.
@@ -153,6 +464,176 @@ class CFRSolver : public CFRSolverBase {
                       /*regret_matching_plus=*/false) {}
 };
 
+// A multithreaded CFR implementation using simultaneous updates.
+//
+// Each iteration partitions the root chance outcomes (e.g. the deals in
+// poker, or the rolls in dice games) across a pool of worker threads. Workers
+// read the current policy from the shared table (which is frozen during the
+// iteration) and accumulate regret and average-policy increments into
+// per-thread tables, which are merged into the shared table when all workers
+// have joined. Since regrets and policy increments are sums over histories,
+// this computes exactly the same update as the single-threaded simultaneous
+// version; only the order of floating point additions differs.
+//
+// The game's initial state must be a chance node; that is where the work is
+// split.
+class CFRParallelSolver {
+ public:
+  // With pin_workers set, worker t is pinned to CPU t during each iteration.
+  // On multi-socket machines this keeps a worker's per-thread table and the
+  // subtrees it traverses on one NUMA node; see thread_affinity.h.
+  //
+  // With deterministic set, each root chance outcome accumulates into its
+  // own local table and the local tables merge in outcome order, instead of
+  // one table per worker merged in worker order. The floating point addition
+  // order is then fixed, so results are bit-identical for any num_threads,
+  // at the cost of one local table (and one merge pass) per outcome rather
+  // than per thread.
+  CFRParallelSolver(const Game& game, int num_threads,
+                    bool pin_workers = false, bool deterministic = false);
+
+  // Performs one step of the CFR algorithm, spread over the thread pool.
+  void EvaluateAndUpdatePolicy();
+
+  // Computes the average policy, containing the policy for all players.
+  // The returned policy instance should only be used during the lifetime of
+  // the solver object.
+  std::unique_ptr<Policy> AveragePolicy() const {
+    return std::unique_ptr<Policy>(new CFRAveragePolicy(info_states_, nullptr));
+  }
+
+ private:
+  std::vector<double> TraverseSubtree(
+      const State& state, const std::vector<double>& reach_probabilities,
+      CFRInfoStateValuesTable* local_table) const;
+
+  std::vector<double> PolicyFromSharedTable(
+      const std::string& info_state,
+      const std::vector<Action>& legal_actions) const;
+
+  void MergeTable(const CFRInfoStateValuesTable& local_table);
+
+  const Game& game_;
+  const int num_threads_;
+  const bool pin_workers_;
+  const bool deterministic_;
+  const int chance_player_;
+  const std::unique_ptr<State> root_state_;
+  CFRInfoStateValuesTable info_states_;
+};
+
+// CFR with regret-based pruning (Brown & Sandholm, "Regret-Based Pruning in
+// Extensive-Form Games", NIPS 2015).
+//
+// During the updating player's regret pass, subtrees under actions whose
+// current probability is zero and whose cumulative regret has fallen below
+// `pruning_threshold` (a negative number) are not descended into, and their
+// regret update is skipped for the iteration. Because the skipped actions
+// have probability zero, the values propagated up the tree are unchanged;
+// only the pruned actions' own regrets go temporarily stale. Every
+// `prune_revisit_every` iterations a full traversal is performed so pruned
+// actions regain regret and can re-enter the support.
+//
+// The threshold is in cumulative-regret units, which grow with the number of
+// iterations times the utility range: the more negative the threshold, the
+// later actions are pruned and the less that is saved; a threshold too close
+// to zero prunes actions that were about to recover. The revisit period
+// bounds how stale a pruned action's regret can get.
+class CFRPruningSolver : public CFRSolverBase {
+ public:
+  CFRPruningSolver(const Game& game, double pruning_threshold = -100.0,
+                   int prune_revisit_every = 25)
+      : CFRSolverBase(game, /*initialize_cumulative_values=*/false,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {
+    EnableRegretPruning(pruning_threshold, prune_revisit_every);
+  }
+};
+
+// CFR with reach-probability pruning.
+//
+// During the updating player's pass, subtrees whose counterfactual reach —
+// the product of the opponent's and chance's reach probabilities — has
+// fallen below `reach_threshold` are not descended into. The regret updates
+// below such a node are weighted by exactly that reach, so what is dropped
+// is negligible for the iteration; the node's value is approximated by
+// zero, which does bias the updating player's regrets at its ancestors, so
+// every `full_pass_every` iterations a full traversal restores exactness.
+//
+// After the early iterations, large parts of the tree sit under near-zero
+// opponent reach (the opponent's regret matching has driven the actions
+// leading there out of its support), so most of the walk is skipped at a
+// small, periodically corrected cost in update accuracy. A larger threshold
+// prunes more and leans harder on the full passes; a shorter period costs
+// more full walks but bounds the staleness.
+class CFRReachPruningSolver : public CFRSolverBase {
+ public:
+  explicit CFRReachPruningSolver(const Game& game,
+                                 double reach_threshold = 1e-8,
+                                 int full_pass_every = 10)
+      : CFRSolverBase(game, /*initialize_cumulative_values=*/false,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {
+    EnableReachPruning(reach_threshold, full_pass_every);
+  }
+};
+
+// Depth-limited ("trunk") CFR: CFR run on the tree truncated `depth` moves
+// from the root, with the subtrees below replaced by cached leaf values.
+//
+// With the default rollout evaluator the leaf values are Monte Carlo
+// estimates of the returns under uniform play; passing a CFRLeafEvaluator
+// substitutes any other value source (e.g. a learned value function, or
+// values from a previous solve of the bottom of the game). Leaf values are
+// fixed across iterations, so the trunk converges to an equilibrium of the
+// truncated game, not of the full game — the approximation quality is
+// entirely down to the evaluator. The payoff is a full-width trunk update at
+// a fraction of the full-tree traversal cost, which is what makes iterating
+// on large games practical.
+class CFRTrunkSolver : public CFRSolverBase {
+ public:
+  CFRTrunkSolver(const Game& game, int depth,
+                 CFRLeafEvaluator leaf_evaluator = nullptr,
+                 int num_rollouts = 100, int seed = 0)
+      : CFRSolverBase(game, /*initialize_cumulative_values=*/false,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {
+    EnableDepthLimit(depth, std::move(leaf_evaluator), num_rollouts, seed);
+  }
+};
+
+// Linear CFR: CFR where iteration t's regret and average-policy
+// contributions are weighted by t, implemented by scaling the cumulative
+// values by t/(t+1) at the end of each iteration. Converges markedly faster
+// than vanilla CFR per iteration at the same per-iteration cost.
+class LCFRSolver : public CFRSolverBase {
+ public:
+  explicit LCFRSolver(const Game& game)
+      : CFRSolverBase(game, /*initialize_cumulative_values=*/false,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {
+    EnableDiscounting(CFRDiscounting::kLinear);
+  }
+};
+
+// Discounted CFR with the paper's recommended parameters (alpha=1.5,
+// beta=0.5, gamma=2). See the CFRDiscounting comment above for the scheme.
+class DCFRSolver : public CFRSolverBase {
+ public:
+  explicit DCFRSolver(const Game& game, double alpha = 1.5, double beta = 0.5,
+                      double gamma = 2.0)
+      : CFRSolverBase(game, /*initialize_cumulative_values=*/false,
+                      /*alternating_updates=*/true,
+                      /*linear_averaging=*/false,
+                      /*regret_matching_plus=*/false) {
+    EnableDiscounting(CFRDiscounting::kDiscounted, alpha, beta, gamma);
+  }
+};
+
 // CFR+ implementation.
 //
 // See https://poker.cs.ualberta.ca/publications/2015-ijcai-cfrplus.pdf
@@ -0,0 +1,60 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_br.h"
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+CFRBRSolver::CFRBRSolver(const Game& game)
+    : CFRSolverBase(game, /*initialize_cumulative_values=*/true,
+                    /*alternating_updates=*/true,
+                    /*linear_averaging=*/false,
+                    /*regret_matching_plus=*/false),
+      uniform_policy_(std::shared_ptr<TabularPolicy>(
+          new TabularPolicy(GetUniformPolicy(game)))),
+      br_policies_(game.NumPlayers()) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  // Built once; every iteration reuses the cached history trees and infoset
+  // decompositions through SetPolicy.
+  best_responders_.reserve(game.NumPlayers());
+  for (int p = 0; p < game.NumPlayers(); ++p) {
+    best_responders_.emplace_back(
+        new TabularBestResponse(game, p, uniform_policy_.get()));
+  }
+}
+
+void CFRBRSolver::EvaluateAndUpdatePolicy() {
+  SPIEL_STATS_TIMER("cfr_br/evaluate_and_update_policy");
+  ++iteration_;
+  CFRCurrentPolicy current_policy(info_states_, uniform_policy_);
+  for (int player = 0; player < game_.NumPlayers(); ++player) {
+    const int opponent = 1 - player;
+    // The opponent best-responds to the player's current policy; only the
+    // player's part of current_policy matters to the responder.
+    best_responders_[opponent]->SetPolicy(&current_policy);
+    br_policies_[opponent].reset(new BestResponseActionsPolicy(
+        best_responders_[opponent]->GetBestResponseActions()));
+    policy_overrides_.assign(game_.NumPlayers(), nullptr);
+    policy_overrides_[opponent] = br_policies_[opponent].get();
+    ComputeCounterFactualRegret(*root_state_, player, root_reach_probs_);
+    ClearCachedPolicies();
+  }
+  policy_overrides_.clear();
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,84 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_BR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_BR_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A deterministic policy that puts probability one on a fixed action per
+// information state: the responder's best-response actions, as returned by
+// TabularBestResponse::GetBestResponseActions.
+class BestResponseActionsPolicy : public Policy {
+ public:
+  explicit BestResponseActionsPolicy(
+      std::unordered_map<std::string, Action> actions)
+      : actions_(std::move(actions)) {}
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override {
+    auto iter = actions_.find(info_state);
+    if (iter == actions_.end()) return {};
+    return {{iter->second, 1.0}};
+  }
+
+ private:
+  std::unordered_map<std::string, Action> actions_;
+};
+
+// CFR-BR: CFR against a best responder (Johanson, Bard, Burch & Bowling,
+// "Finding Optimal Abstract Strategies in Extensive-Form Games", AAAI 2012).
+// Each iteration updates one player's regrets with the opponent playing an
+// exact best response to that player's current (regret-matched) policy; the
+// player's average policy then converges to an equilibrium of the full game
+// even when the player's strategy space is abstracted. Two-player only.
+//
+// The best responses are the expensive part, so each player's
+// TabularBestResponse is constructed once and re-targeted with SetPolicy
+// every iteration: the history tree and infoset decomposition are built at
+// construction and shared across all iterations, leaving only the
+// policy-dependent values to recompute (tabular_exploitability.h).
+class CFRBRSolver : public CFRSolverBase {
+ public:
+  explicit CFRBRSolver(const Game& game);
+
+  // Performs one step of the CFR-BR algorithm: for each player, computes the
+  // opponent's best response to the current policy, then runs that player's
+  // CFR regret pass against it.
+  void EvaluateAndUpdatePolicy() override;
+
+ private:
+  // Seeds CFRCurrentPolicy lookups for info states the regret passes have
+  // not touched yet.
+  std::shared_ptr<TabularPolicy> uniform_policy_;
+
+  // One responder per player, re-targeted with SetPolicy each iteration so
+  // the cached tree and infoset decomposition are reused.
+  std::vector<std::unique_ptr<TabularBestResponse>> best_responders_;
+  std::vector<std::unique_ptr<BestResponseActionsPolicy>> br_policies_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_BR_H_
@@ -0,0 +1,173 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_checkpoint.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kCheckpointMagic = 0x4643534f;  // "OSCF", little-endian.
+constexpr uint32_t kCheckpointVersion = 1;
+
+// Unsigned LEB128.
+void AppendVarint(uint64_t value, std::string* buffer) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer->push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+uint64_t ReadVarint(const std::string& data, std::size_t* offset) {
+  uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (*offset >= data.size()) {
+      SpielFatalError("CFR checkpoint truncated inside a varint.");
+    }
+    uint8_t byte = static_cast<uint8_t>(data[(*offset)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+    shift += 7;
+  }
+}
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const std::string& data, std::size_t* offset) {
+  if (*offset + sizeof(T) > data.size()) {
+    SpielFatalError("CFR checkpoint truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+void AppendString(const std::string& value, std::string* buffer) {
+  AppendVarint(value.size(), buffer);
+  buffer->append(value);
+}
+
+std::string ReadString(const std::string& data, std::size_t* offset) {
+  const std::size_t length = ReadVarint(data, offset);
+  if (*offset + length > data.size()) {
+    SpielFatalError("CFR checkpoint truncated inside a string.");
+  }
+  std::string value = data.substr(*offset, length);
+  *offset += length;
+  return value;
+}
+
+}  // namespace
+
+void SaveCFRCheckpoint(const std::string& filename,
+                       const std::string& game_string, int64_t iteration,
+                       const std::string& rng_state,
+                       const CFRInfoStateValuesTable& table) {
+  std::string buffer;
+  AppendRaw<uint32_t>(kCheckpointMagic, &buffer);
+  AppendRaw<uint32_t>(kCheckpointVersion, &buffer);
+  AppendString(game_string, &buffer);
+  AppendRaw<int64_t>(iteration, &buffer);
+  AppendString(rng_state, &buffer);
+
+  AppendVarint(table.size(), &buffer);
+  for (const auto& entry : table) {
+    const CFRInfoStateValues& values = entry.second;
+    AppendString(entry.first, &buffer);
+    AppendVarint(values.legal_actions.size(), &buffer);
+    for (Action action : values.legal_actions) {
+      AppendVarint(action, &buffer);
+    }
+    for (double regret : values.cumulative_regrets) {
+      AppendRaw<double>(regret, &buffer);
+    }
+    for (double policy : values.cumulative_policy) {
+      AppendRaw<double>(policy, &buffer);
+    }
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open CFR checkpoint for writing: " + filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write CFR checkpoint: " + filename);
+  }
+}
+
+CFRCheckpoint LoadCFRCheckpoint(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError("Could not open CFR checkpoint for reading: " + filename);
+  }
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+
+  std::size_t offset = 0;
+  if (ReadRaw<uint32_t>(data, &offset) != kCheckpointMagic) {
+    SpielFatalError("Not a CFR checkpoint: " + filename);
+  }
+  if (ReadRaw<uint32_t>(data, &offset) != kCheckpointVersion) {
+    SpielFatalError("Unsupported CFR checkpoint version in: " + filename);
+  }
+
+  CFRCheckpoint checkpoint;
+  checkpoint.game_string = ReadString(data, &offset);
+  checkpoint.iteration = ReadRaw<int64_t>(data, &offset);
+  checkpoint.rng_state = ReadString(data, &offset);
+
+  const uint64_t num_entries = ReadVarint(data, &offset);
+  checkpoint.table.reserve(num_entries);
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    std::string key = ReadString(data, &offset);
+    const uint64_t num_actions = ReadVarint(data, &offset);
+    std::vector<Action> legal_actions(num_actions);
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      legal_actions[aidx] = ReadVarint(data, &offset);
+    }
+    CFRInfoStateValues values(legal_actions);
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      values.cumulative_regrets[aidx] = ReadRaw<double>(data, &offset);
+    }
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      values.cumulative_policy[aidx] = ReadRaw<double>(data, &offset);
+    }
+    checkpoint.table[key] = values;
+  }
+  if (offset != data.size()) {
+    SpielFatalError("Trailing bytes in CFR checkpoint: " + filename);
+  }
+  return checkpoint;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,63 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_CHECKPOINT_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_CHECKPOINT_H_
+
+#include <cstdint>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+
+// Binary checkpointing for the tabular CFR family of solvers, so that a long
+// run can be resumed after a crash instead of starting over.
+//
+// A checkpoint file is a fixed header (magic, version), the game string as
+// produced by Game::ToString() (the same identity used by
+// SerializeGameAndState), the iteration count, the random number generator
+// state (as produced by operator<< on the generator; empty for deterministic
+// solvers), and then the info state table: per entry the key, the legal
+// actions, and the cumulative regret and policy arrays. Current policies are
+// not stored since they are recomputed from the regrets.
+//
+// The solvers expose SaveCheckpoint/LoadCheckpoint built on these functions;
+// they are public so other table-based solvers can reuse the format.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct CFRCheckpoint {
+  std::string game_string;
+  int64_t iteration = 0;
+  // Serialized generator state, or empty if the solver has none.
+  std::string rng_state;
+  CFRInfoStateValuesTable table;
+};
+
+// Writes a checkpoint to filename, replacing any existing file. The table is
+// taken by reference so saving does not copy it. Calls SpielFatalError if
+// the file cannot be written.
+void SaveCFRCheckpoint(const std::string& filename,
+                       const std::string& game_string, int64_t iteration,
+                       const std::string& rng_state,
+                       const CFRInfoStateValuesTable& table);
+
+// Reads a checkpoint written by SaveCFRCheckpoint. Calls SpielFatalError if
+// the file cannot be read, is truncated, or has a bad magic or version.
+CFRCheckpoint LoadCFRCheckpoint(const std::string& filename);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_CHECKPOINT_H_
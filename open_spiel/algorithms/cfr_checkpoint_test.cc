@@ -0,0 +1,91 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_checkpoint.h"
+
+#include <cstdio>
+#include <memory>
+
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr const char* kCheckpointFile = "/tmp/open_spiel_cfr_checkpoint_test";
+
+// A solver resumed from a checkpoint must produce exactly the same policy as
+// one that ran straight through, since the table round-trips bit-exactly.
+void CFRCheckpointResumeTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+
+  CFRSolver solver(*game);
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  solver.SaveCheckpoint(kCheckpointFile);
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const double straight_nash_conv = NashConv(*game, *solver.AveragePolicy());
+
+  CFRSolver resumed(*game);
+  resumed.LoadCheckpoint(kCheckpointFile);
+  for (int i = 0; i < 10; i++) {
+    resumed.EvaluateAndUpdatePolicy();
+  }
+  const double resumed_nash_conv = NashConv(*game, *resumed.AveragePolicy());
+
+  SPIEL_CHECK_EQ(straight_nash_conv, resumed_nash_conv);
+  std::remove(kCheckpointFile);
+}
+
+// The MCCFR checkpoint also restores the internal generator, so the resumed
+// run samples the same trajectories as the original.
+void MCCFRCheckpointResumeTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+
+  ExternalSamplingMCCFRSolver solver(*game, /*seed=*/375931064);
+  for (int i = 0; i < 100; i++) {
+    solver.RunIteration();
+  }
+  solver.SaveCheckpoint(kCheckpointFile);
+  for (int i = 0; i < 100; i++) {
+    solver.RunIteration();
+  }
+  const double straight_nash_conv = NashConv(*game, *solver.AveragePolicy());
+
+  // A different seed, to show the loaded generator state takes over.
+  ExternalSamplingMCCFRSolver resumed(*game, /*seed=*/1);
+  resumed.LoadCheckpoint(kCheckpointFile);
+  for (int i = 0; i < 100; i++) {
+    resumed.RunIteration();
+  }
+  const double resumed_nash_conv = NashConv(*game, *resumed.AveragePolicy());
+
+  SPIEL_CHECK_EQ(straight_nash_conv, resumed_nash_conv);
+  std::remove(kCheckpointFile);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::CFRCheckpointResumeTest();
+  open_spiel::algorithms::MCCFRCheckpointResumeTest();
+}
@@ -0,0 +1,397 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_compiled_tree.h"
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kCompiledTreeMagic = 0x5443534f;  // "OSCT", little-endian.
+constexpr uint32_t kCompiledTreeVersion = 1;
+
+// Unsigned LEB128.
+void AppendVarint(uint64_t value, std::string* buffer) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer->push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+uint64_t ReadVarint(const std::string& data, std::size_t* offset) {
+  uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (*offset >= data.size()) {
+      SpielFatalError("Compiled CFR tree truncated inside a varint.");
+    }
+    uint8_t byte = static_cast<uint8_t>(data[(*offset)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+    shift += 7;
+  }
+}
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const std::string& data, std::size_t* offset) {
+  if (*offset + sizeof(T) > data.size()) {
+    SpielFatalError("Compiled CFR tree truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+void AppendString(const std::string& value, std::string* buffer) {
+  AppendVarint(value.size(), buffer);
+  buffer->append(value);
+}
+
+std::string ReadString(const std::string& data, std::size_t* offset) {
+  const std::size_t length = ReadVarint(data, offset);
+  if (*offset + length > data.size()) {
+    SpielFatalError("Compiled CFR tree truncated inside a string.");
+  }
+  std::string value = data.substr(*offset, length);
+  *offset += length;
+  return value;
+}
+
+// Each array is written as a varint length followed by fixed-width elements,
+// so loading can resize once and read the elements straight in.
+template <typename T>
+void AppendArray(const std::vector<T>& values, std::string* buffer) {
+  AppendVarint(values.size(), buffer);
+  for (const T& value : values) AppendRaw<T>(value, buffer);
+}
+
+template <typename T>
+std::vector<T> ReadArray(const std::string& data, std::size_t* offset) {
+  const uint64_t size = ReadVarint(data, offset);
+  std::vector<T> values(size);
+  for (uint64_t i = 0; i < size; ++i) values[i] = ReadRaw<T>(data, offset);
+  return values;
+}
+
+// The compilation recursion. Nodes get ids in depth-first pre-order; a
+// node's child slots are allocated before its children are compiled, so the
+// slot ranges come out contiguous and child_begin stays monotone without a
+// second pass. Returns the compiled node's id.
+int CompileNode(const State& state, CompiledCFRTree* tree,
+                std::unordered_map<std::string, int>* info_set_ids) {
+  const int node = tree->NumNodes();
+  tree->kind.push_back(kCompiledTerminalNode);  // Overwritten below.
+  tree->ref.push_back(-1);
+  tree->child_begin.push_back(tree->child.size());
+
+  if (state.IsTerminal()) {
+    tree->ref[node] = tree->returns.size() / tree->num_players;
+    for (double value : state.Returns()) tree->returns.push_back(value);
+    return node;
+  }
+
+  if (state.IsChanceNode()) {
+    tree->kind[node] = kCompiledChanceNode;
+    const ActionsAndProbs outcomes = state.ChanceOutcomes();
+    const int begin = tree->child.size();
+    for (const std::pair<Action, double>& outcome : outcomes) {
+      tree->child.push_back(-1);  // Filled below.
+      tree->chance_prob.push_back(outcome.second);
+    }
+    for (int slot = 0; slot < static_cast<int>(outcomes.size()); ++slot) {
+      const std::unique_ptr<State> next = state.Child(outcomes[slot].first);
+      // Compiled into a local first: the recursion grows tree->child, so
+      // indexing it on the left of the assignment could evaluate against a
+      // buffer the reallocation has already freed.
+      const int child_node = CompileNode(*next, tree, info_set_ids);
+      tree->child[begin + slot] = child_node;
+    }
+    return node;
+  }
+
+  if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "CompileCFRTree does not support simultaneous nodes; wrap the game "
+        "with TurnBasedSimultaneousGame.");
+  }
+
+  tree->kind[node] = kCompiledDecisionNode;
+  const std::string info_state = state.InformationStateKey();
+  const std::vector<Action> actions = state.LegalActions();
+  auto iter = info_set_ids->find(info_state);
+  int info_set;
+  if (iter == info_set_ids->end()) {
+    info_set = tree->NumInfoSets();
+    (*info_set_ids)[info_state] = info_set;
+    tree->info_set_keys.push_back(info_state);
+    tree->info_set_player.push_back(state.CurrentPlayer());
+    for (Action action : actions) tree->legal_actions.push_back(action);
+    tree->action_begin.push_back(tree->legal_actions.size());
+  } else {
+    info_set = iter->second;
+    // Every node of an info set must offer the same actions.
+    SPIEL_CHECK_EQ(tree->action_begin[info_set + 1] -
+                       tree->action_begin[info_set],
+                   static_cast<int>(actions.size()));
+  }
+  tree->ref[node] = info_set;
+
+  const int begin = tree->child.size();
+  for (std::size_t slot = 0; slot < actions.size(); ++slot) {
+    tree->child.push_back(-1);
+    tree->chance_prob.push_back(0);
+  }
+  for (int slot = 0; slot < static_cast<int>(actions.size()); ++slot) {
+    const std::unique_ptr<State> next = state.Child(actions[slot]);
+    // As at the chance node above: take the child id before indexing.
+    const int child_node = CompileNode(*next, tree, info_set_ids);
+    tree->child[begin + slot] = child_node;
+  }
+  return node;
+}
+
+}  // namespace
+
+CompiledCFRTree CompileCFRTree(const Game& game) {
+  CompiledCFRTree tree;
+  tree.game_string = game.ToString();
+  tree.num_players = game.NumPlayers();
+  tree.action_begin.push_back(0);
+  std::unordered_map<std::string, int> info_set_ids;
+  const std::unique_ptr<State> root = game.NewInitialState();
+  CompileNode(*root, &tree, &info_set_ids);
+  tree.child_begin.push_back(tree.child.size());
+  return tree;
+}
+
+void SaveCompiledCFRTree(const CompiledCFRTree& tree,
+                         const std::string& filename) {
+  std::string buffer;
+  AppendRaw<uint32_t>(kCompiledTreeMagic, &buffer);
+  AppendRaw<uint32_t>(kCompiledTreeVersion, &buffer);
+  AppendString(tree.game_string, &buffer);
+  AppendVarint(tree.num_players, &buffer);
+  AppendArray(tree.kind, &buffer);
+  AppendArray(tree.ref, &buffer);
+  AppendArray(tree.child_begin, &buffer);
+  AppendArray(tree.child, &buffer);
+  AppendArray(tree.chance_prob, &buffer);
+  AppendArray(tree.returns, &buffer);
+  AppendVarint(tree.info_set_keys.size(), &buffer);
+  for (const std::string& key : tree.info_set_keys) {
+    AppendString(key, &buffer);
+  }
+  AppendArray(tree.info_set_player, &buffer);
+  AppendArray(tree.action_begin, &buffer);
+  AppendArray(tree.legal_actions, &buffer);
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open compiled CFR tree for writing: " +
+                    filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write compiled CFR tree: " + filename);
+  }
+}
+
+CompiledCFRTree LoadCompiledCFRTree(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError("Could not open compiled CFR tree for reading: " +
+                    filename);
+  }
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+
+  std::size_t offset = 0;
+  if (ReadRaw<uint32_t>(data, &offset) != kCompiledTreeMagic) {
+    SpielFatalError("Not a compiled CFR tree: " + filename);
+  }
+  if (ReadRaw<uint32_t>(data, &offset) != kCompiledTreeVersion) {
+    SpielFatalError("Unsupported compiled CFR tree version in: " + filename);
+  }
+
+  CompiledCFRTree tree;
+  tree.game_string = ReadString(data, &offset);
+  tree.num_players = ReadVarint(data, &offset);
+  tree.kind = ReadArray<int8_t>(data, &offset);
+  tree.ref = ReadArray<int>(data, &offset);
+  tree.child_begin = ReadArray<int>(data, &offset);
+  tree.child = ReadArray<int>(data, &offset);
+  tree.chance_prob = ReadArray<double>(data, &offset);
+  tree.returns = ReadArray<double>(data, &offset);
+  const uint64_t num_info_sets = ReadVarint(data, &offset);
+  tree.info_set_keys.reserve(num_info_sets);
+  for (uint64_t i = 0; i < num_info_sets; ++i) {
+    tree.info_set_keys.push_back(ReadString(data, &offset));
+  }
+  tree.info_set_player = ReadArray<int>(data, &offset);
+  tree.action_begin = ReadArray<int>(data, &offset);
+  tree.legal_actions = ReadArray<Action>(data, &offset);
+  if (offset != data.size()) {
+    SpielFatalError("Trailing bytes in compiled CFR tree: " + filename);
+  }
+  return tree;
+}
+
+CompiledCFRSolver::CompiledCFRSolver(const CompiledCFRTree& tree)
+    : tree_(tree),
+      cumulative_regrets_(tree.legal_actions.size(), 0),
+      cumulative_policy_(tree.legal_actions.size(), 0),
+      current_policy_(tree.legal_actions.size(), 0) {
+  SPIEL_CHECK_GT(tree.NumNodes(), 0);
+}
+
+void CompiledCFRSolver::ApplyRegretMatching() {
+  for (int i = 0; i < tree_.NumInfoSets(); ++i) {
+    const int begin = tree_.action_begin[i];
+    const int end = tree_.action_begin[i + 1];
+    double positive_sum = 0;
+    for (int slot = begin; slot < end; ++slot) {
+      if (cumulative_regrets_[slot] > 0) {
+        positive_sum += cumulative_regrets_[slot];
+      }
+    }
+    if (positive_sum > 0) {
+      for (int slot = begin; slot < end; ++slot) {
+        current_policy_[slot] = cumulative_regrets_[slot] > 0
+                                    ? cumulative_regrets_[slot] / positive_sum
+                                    : 0;
+      }
+    } else {
+      const double uniform = 1.0 / (end - begin);
+      for (int slot = begin; slot < end; ++slot) {
+        current_policy_[slot] = uniform;
+      }
+    }
+  }
+}
+
+std::vector<double> CompiledCFRSolver::RecurseCFR(int node,
+                                                  std::vector<double>* reach,
+                                                  double chance_reach) {
+  const int begin = tree_.child_begin[node];
+  const int end = tree_.child_begin[node + 1];
+
+  if (tree_.kind[node] == kCompiledTerminalNode) {
+    std::vector<double> values(tree_.num_players);
+    for (int p = 0; p < tree_.num_players; ++p) {
+      values[p] = tree_.Return(tree_.ref[node], p);
+    }
+    return values;
+  }
+
+  if (tree_.kind[node] == kCompiledChanceNode) {
+    std::vector<double> values(tree_.num_players, 0);
+    for (int slot = begin; slot < end; ++slot) {
+      if (slot + 1 < end) SPIEL_PREFETCH(&tree_.kind[tree_.child[slot + 1]]);
+      const double prob = tree_.chance_prob[slot];
+      const std::vector<double> child_values =
+          RecurseCFR(tree_.child[slot], reach, chance_reach * prob);
+      for (int p = 0; p < tree_.num_players; ++p) {
+        values[p] += prob * child_values[p];
+      }
+    }
+    return values;
+  }
+
+  const int info_set = tree_.ref[node];
+  const int player = tree_.info_set_player[info_set];
+  const int action_begin = tree_.action_begin[info_set];
+  const int num_actions = end - begin;
+
+  std::vector<double> values(tree_.num_players, 0);
+  std::vector<double> child_player_values(num_actions);
+  const double player_reach = (*reach)[player];
+  for (int a = 0; a < num_actions; ++a) {
+    if (a + 1 < num_actions) {
+      // Ask for the next child's node entry while this child's subtree is
+      // walked; most children are shallow, so the line is in by the time
+      // the loop comes back around.
+      SPIEL_PREFETCH(&tree_.kind[tree_.child[begin + a + 1]]);
+    }
+    const double action_prob = current_policy_[action_begin + a];
+    (*reach)[player] = player_reach * action_prob;
+    const std::vector<double> child_values =
+        RecurseCFR(tree_.child[begin + a], reach, chance_reach);
+    child_player_values[a] = child_values[player];
+    for (int p = 0; p < tree_.num_players; ++p) {
+      values[p] += action_prob * child_values[p];
+    }
+  }
+  (*reach)[player] = player_reach;
+
+  // Counterfactual reach: chance times the other players' contributions.
+  double counterfactual_reach = chance_reach;
+  for (int p = 0; p < tree_.num_players; ++p) {
+    if (p != player) counterfactual_reach *= (*reach)[p];
+  }
+  for (int a = 0; a < num_actions; ++a) {
+    cumulative_regrets_[action_begin + a] +=
+        counterfactual_reach * (child_player_values[a] - values[player]);
+    cumulative_policy_[action_begin + a] +=
+        player_reach * current_policy_[action_begin + a];
+  }
+  return values;
+}
+
+void CompiledCFRSolver::RunIteration() {
+  ApplyRegretMatching();
+  std::vector<double> reach(tree_.num_players, 1.0);
+  RecurseCFR(/*node=*/0, &reach, /*chance_reach=*/1.0);
+}
+
+TabularPolicy CompiledCFRSolver::AveragePolicy() const {
+  std::unordered_map<std::string, ActionsAndProbs> policy;
+  policy.reserve(tree_.NumInfoSets());
+  for (int i = 0; i < tree_.NumInfoSets(); ++i) {
+    const int begin = tree_.action_begin[i];
+    const int end = tree_.action_begin[i + 1];
+    double sum = 0;
+    for (int slot = begin; slot < end; ++slot) {
+      sum += cumulative_policy_[slot];
+    }
+    ActionsAndProbs state_policy;
+    state_policy.reserve(end - begin);
+    for (int slot = begin; slot < end; ++slot) {
+      const double prob = sum > 0 ? cumulative_policy_[slot] / sum
+                                  : 1.0 / (end - begin);
+      state_policy.push_back({tree_.legal_actions[slot], prob});
+    }
+    policy[tree_.info_set_keys[i]] = std::move(state_policy);
+  }
+  return TabularPolicy(policy);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
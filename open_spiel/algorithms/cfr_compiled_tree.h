@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_COMPILED_TREE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_COMPILED_TREE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// Node kinds of a compiled CFR tree.
+constexpr int8_t kCompiledDecisionNode = 0;
+constexpr int8_t kCompiledChanceNode = 1;
+constexpr int8_t kCompiledTerminalNode = 2;
+
+// The full game tree — histories, not the merged state space of
+// game_graph.h — flattened into structure-of-arrays CSR form, together with
+// a dense information set index. Compiling expands the tree through the
+// State objects exactly once; a CFR iteration over the compiled tree is then
+// pure array arithmetic, with no cloning, no ApplyAction and no key hashing.
+// The tree serializes to disk (SaveCompiledCFRTree below), so workloads that
+// rerun CFR on the same game many times — hyperparameter sweeps in
+// particular — compile once and reload.
+struct CompiledCFRTree {
+  std::string game_string;  // Game::ToString() of the compiled game.
+  int num_players = 0;
+
+  // Per-node arrays, indexed by node id; the root is node 0 and ids are
+  // assigned in depth-first pre-order, the order a CFR traversal visits.
+  std::vector<int8_t> kind;  // One of the kCompiled*Node constants.
+  // Decision nodes: the dense info set id (see the info set arrays below).
+  // Terminal nodes: the row of `returns` holding the node's returns.
+  // Chance nodes: -1.
+  std::vector<int> ref;
+  // The child slots of node id are [child_begin[id], child_begin[id+1]);
+  // slot s leads to node child[s]. At a chance node chance_prob[s] is the
+  // outcome's probability; at a decision node the slot order matches the
+  // info set's legal-action order and chance_prob[s] is zero.
+  std::vector<int> child_begin;  // Length NumNodes() + 1.
+  std::vector<int> child;
+  std::vector<double> chance_prob;
+  // Terminal returns, row-major: returns[ref[id] * num_players + player].
+  std::vector<double> returns;
+
+  // Per-info-set arrays, indexed by info set id. Ids are assigned at an info
+  // set's first depth-first visit — the order a CFR traversal first touches
+  // it, so tables indexed by id are walked near-sequentially.
+  std::vector<std::string> info_set_keys;
+  std::vector<int> info_set_player;
+  // The legal actions of info set i occupy the half-open slot range
+  // [action_begin[i], action_begin[i+1]) of legal_actions; value tables
+  // indexed by the same slots line up with it (see CompiledCFRSolver).
+  std::vector<int> action_begin;  // Length NumInfoSets() + 1.
+  std::vector<Action> legal_actions;
+
+  int NumNodes() const { return kind.size(); }
+  int NumInfoSets() const { return info_set_keys.size(); }
+
+  double Return(int terminal_row, int player) const {
+    return returns[terminal_row * num_players + player];
+  }
+};
+
+// Compiles the game's full tree. The game must be sequential (turn-based);
+// for simultaneous games apply TurnBasedSimultaneousGame first.
+CompiledCFRTree CompileCFRTree(const Game& game);
+
+// Writes the tree to filename (binary), replacing any existing file, and
+// reads it back. Loading validates a format magic and version; running over
+// a tree compiled from a different game is detected through game_string by
+// the caller.
+void SaveCompiledCFRTree(const CompiledCFRTree& tree,
+                         const std::string& filename);
+CompiledCFRTree LoadCompiledCFRTree(const std::string& filename);
+
+// Vanilla CFR (simultaneous regret and average-policy updates for all
+// players each iteration) run entirely over a compiled tree. The values live
+// in arrays parallel to the tree's legal-action slots, so regret matching is
+// one pass over contiguous memory and the traversal never touches a State
+// object. The tree is borrowed and must outlive the solver.
+class CompiledCFRSolver {
+ public:
+  explicit CompiledCFRSolver(const CompiledCFRTree& tree);
+
+  void RunIteration();
+
+  // The average policy over the cumulative policy so far, keyed by the
+  // tree's info set keys. Info sets never reached under the current play
+  // get a uniform policy.
+  TabularPolicy AveragePolicy() const;
+
+ private:
+  // Fills current_policy_ from the positive cumulative regrets.
+  void ApplyRegretMatching();
+
+  // The CFR recursion; returns the per-player values of `node` under the
+  // current policy. reach holds the players' reach probabilities and is
+  // restored before returning.
+  std::vector<double> RecurseCFR(int node, std::vector<double>* reach,
+                                 double chance_reach);
+
+  const CompiledCFRTree& tree_;
+  // Slot-parallel to tree_.legal_actions.
+  std::vector<double> cumulative_regrets_;
+  std::vector<double> cumulative_policy_;
+  std::vector<double> current_policy_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_CFR_COMPILED_TREE_H_
@@ -0,0 +1,128 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/cfr_compiled_tree.h"
+
+#include <cstdio>
+
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CompiledTreeIsWellFormed(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  const CompiledCFRTree tree = CompileCFRTree(*game);
+  SPIEL_CHECK_EQ(tree.game_string, game->ToString());
+  SPIEL_CHECK_EQ(tree.num_players, game->NumPlayers());
+  SPIEL_CHECK_GT(tree.NumNodes(), 0);
+  SPIEL_CHECK_GT(tree.NumInfoSets(), 0);
+  SPIEL_CHECK_EQ(tree.child_begin.size(), tree.NumNodes() + 1);
+  SPIEL_CHECK_EQ(tree.action_begin.size(), tree.NumInfoSets() + 1);
+  SPIEL_CHECK_EQ(tree.child.size(), tree.chance_prob.size());
+  for (int node = 0; node < tree.NumNodes(); ++node) {
+    const int begin = tree.child_begin[node];
+    const int end = tree.child_begin[node + 1];
+    SPIEL_CHECK_LE(begin, end);
+    if (tree.kind[node] == kCompiledTerminalNode) {
+      // Terminals have no children and a valid returns row.
+      SPIEL_CHECK_EQ(begin, end);
+      SPIEL_CHECK_GE(tree.ref[node], 0);
+      SPIEL_CHECK_LE((tree.ref[node] + 1) * tree.num_players,
+                     tree.returns.size());
+      continue;
+    }
+    SPIEL_CHECK_LT(begin, end);
+    for (int slot = begin; slot < end; ++slot) {
+      SPIEL_CHECK_GT(tree.child[slot], node);
+      SPIEL_CHECK_LT(tree.child[slot], tree.NumNodes());
+    }
+    if (tree.kind[node] == kCompiledChanceNode) {
+      double sum = 0;
+      for (int slot = begin; slot < end; ++slot) {
+        sum += tree.chance_prob[slot];
+      }
+      SPIEL_CHECK_FLOAT_NEAR(sum, 1.0, 1e-9);
+    } else {
+      // Decision slots line up with the info set's legal actions.
+      const int info_set = tree.ref[node];
+      SPIEL_CHECK_GE(info_set, 0);
+      SPIEL_CHECK_LT(info_set, tree.NumInfoSets());
+      SPIEL_CHECK_EQ(end - begin, tree.action_begin[info_set + 1] -
+                                      tree.action_begin[info_set]);
+    }
+  }
+}
+
+void SaveLoadRoundTrips(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  const CompiledCFRTree tree = CompileCFRTree(*game);
+  const std::string filename = "/tmp/open_spiel_compiled_tree_test";
+  SaveCompiledCFRTree(tree, filename);
+  const CompiledCFRTree loaded = LoadCompiledCFRTree(filename);
+  std::remove(filename.c_str());
+  SPIEL_CHECK_EQ(loaded.game_string, tree.game_string);
+  SPIEL_CHECK_EQ(loaded.num_players, tree.num_players);
+  SPIEL_CHECK_TRUE(loaded.kind == tree.kind);
+  SPIEL_CHECK_TRUE(loaded.ref == tree.ref);
+  SPIEL_CHECK_TRUE(loaded.child_begin == tree.child_begin);
+  SPIEL_CHECK_TRUE(loaded.child == tree.child);
+  SPIEL_CHECK_TRUE(loaded.chance_prob == tree.chance_prob);
+  SPIEL_CHECK_TRUE(loaded.returns == tree.returns);
+  SPIEL_CHECK_TRUE(loaded.info_set_keys == tree.info_set_keys);
+  SPIEL_CHECK_TRUE(loaded.info_set_player == tree.info_set_player);
+  SPIEL_CHECK_TRUE(loaded.action_begin == tree.action_begin);
+  SPIEL_CHECK_TRUE(loaded.legal_actions == tree.legal_actions);
+}
+
+void CompiledCFRKuhnConverges() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  const CompiledCFRTree tree = CompileCFRTree(*game);
+  CompiledCFRSolver solver(tree);
+  for (int i = 0; i < 300; ++i) {
+    solver.RunIteration();
+  }
+  const TabularPolicy average_policy = solver.AveragePolicy();
+  SPIEL_CHECK_LE(Exploitability(*game, average_policy), 0.05);
+}
+
+void CompiledCFRLeducConverges() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  const CompiledCFRTree tree = CompileCFRTree(*game);
+  CompiledCFRSolver solver(tree);
+  for (int i = 0; i < 100; ++i) {
+    solver.RunIteration();
+  }
+  const TabularPolicy average_policy = solver.AveragePolicy();
+  SPIEL_CHECK_LE(Exploitability(*game, average_policy), 0.2);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace alg = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  alg::CompiledTreeIsWellFormed("kuhn_poker");
+  alg::CompiledTreeIsWellFormed("leduc_poker");
+  alg::CompiledTreeIsWellFormed("liars_dice");
+  alg::SaveLoadRoundTrips("kuhn_poker");
+  alg::SaveLoadRoundTrips("leduc_poker");
+  alg::CompiledCFRKuhnConverges();
+  alg::CompiledCFRLeducConverges();
+}
@@ -14,12 +14,14 @@
 
 #include "open_spiel/algorithms/cfr.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/algorithms/tree_traversal.h"
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
@@ -50,6 +52,125 @@ void CheckExploitabilityKuhnPoker(const Game& game, const Policy& policy) {
   SPIEL_CHECK_LE(Exploitability(game, policy), 0.05);
 }
 
+void CFRTest_FlatTableMatchesMapTable() {
+  // Build a small map-of-structs table with mixed-sign regrets.
+  CFRInfoStateValuesTable table;
+  table["a"] = CFRInfoStateValues({0, 1, 2});
+  table["a"].cumulative_regrets = {1.0, -2.0, 3.0};
+  table["a"].cumulative_policy = {0.25, 0.5, 0.25};
+  table["b"] = CFRInfoStateValues({5, 7});
+  table["b"].cumulative_regrets = {-1.0, -4.0};
+
+  CFRInfoStateValuesFlatTable flat_table(table);
+  SPIEL_CHECK_EQ(flat_table.num_info_states(), 2);
+  flat_table.ApplyRegretMatching();
+
+  for (auto& entry : table) {
+    entry.second.ApplyRegretMatching();
+    const int id = flat_table.GetId(entry.first);
+    SPIEL_CHECK_GE(id, 0);
+    SPIEL_CHECK_EQ(flat_table.num_actions(id), entry.second.num_actions());
+    const int begin = flat_table.offset(id);
+    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+      SPIEL_CHECK_EQ(flat_table.legal_actions()[begin + aidx],
+                     entry.second.legal_actions[aidx]);
+      SPIEL_CHECK_FLOAT_EQ(flat_table.current_policy()[begin + aidx],
+                           entry.second.cached_policy[aidx]);
+    }
+  }
+
+  // Converting back must preserve all values.
+  CFRInfoStateValuesTable round_trip = flat_table.ToTable();
+  SPIEL_CHECK_EQ(round_trip.size(), table.size());
+  for (const auto& entry : table) {
+    const CFRInfoStateValues& rt_vals = round_trip[entry.first];
+    for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+      SPIEL_CHECK_EQ(rt_vals.cumulative_regrets[aidx],
+                     entry.second.cumulative_regrets[aidx]);
+      SPIEL_CHECK_EQ(rt_vals.cumulative_policy[aidx],
+                     entry.second.cumulative_policy[aidx]);
+    }
+  }
+}
+
+void CFRTest_MemoryBudget() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  // Kuhn poker's table is tiny, so a generous budget is never hit and the
+  // run is unaffected; the byte estimate grows as the table fills in.
+  solver.SetMemoryBudget(/*max_bytes=*/int64_t{1} << 30);
+  const int64_t empty_bytes = ApproxTableBytes(solver.InfoStateValuesTable());
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const int64_t filled_bytes = ApproxTableBytes(solver.InfoStateValuesTable());
+  SPIEL_CHECK_GT(filled_bytes, empty_bytes);
+  SPIEL_CHECK_EQ(solver.InfoStateValuesTable().size(), 12);
+  // The over-budget path checkpoints and stops with SpielFatalError, which
+  // cannot be exercised here.
+}
+
+void CFRTest_QuantizedTable() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const CFRInfoStateValuesTable& table = solver.InfoStateValuesTable();
+
+  // fp32 storage halves the value memory and keeps ~7 significant digits;
+  // int16 quarters it with error bounded by the per-info-state scale. Both
+  // dequantized tables still induce a near-Nash average policy.
+  CFRQuantizedInfoStateValuesTable quantized_f32(table);
+  CFRQuantizedInfoStateValuesTable quantized_i16(table,
+                                                 CFRValueStorage::kInt16);
+  SPIEL_CHECK_LT(quantized_i16.ApproxBytes(), quantized_f32.ApproxBytes());
+  SPIEL_CHECK_LT(quantized_f32.ApproxBytes(), ApproxTableBytes(table));
+  SPIEL_CHECK_EQ(quantized_f32.num_hot_entries(), 0);
+
+  for (CFRValueStorage storage :
+       {CFRValueStorage::kFloat32, CFRValueStorage::kInt16}) {
+    CFRQuantizedInfoStateValuesTable quantized(table, storage);
+    CFRInfoStateValuesTable restored = quantized.Dequantize();
+    SPIEL_CHECK_EQ(restored.size(), table.size());
+    for (const auto& entry : table) {
+      const CFRInfoStateValues& vals = restored.at(entry.first);
+      double max_abs = 0;
+      for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+        max_abs = std::max(max_abs,
+                           std::fabs(entry.second.cumulative_regrets[aidx]));
+        max_abs = std::max(max_abs,
+                           std::fabs(entry.second.cumulative_policy[aidx]));
+      }
+      const double tolerance = storage == CFRValueStorage::kFloat32
+                                   ? max_abs * 1e-6
+                                   : max_abs / 32767.0;
+      for (int aidx = 0; aidx < entry.second.num_actions(); ++aidx) {
+        SPIEL_CHECK_EQ(vals.legal_actions[aidx],
+                       entry.second.legal_actions[aidx]);
+        SPIEL_CHECK_LE(std::fabs(vals.cumulative_regrets[aidx] -
+                                 entry.second.cumulative_regrets[aidx]),
+                       tolerance);
+        SPIEL_CHECK_LE(std::fabs(vals.cumulative_policy[aidx] -
+                                 entry.second.cumulative_policy[aidx]),
+                       tolerance);
+      }
+    }
+    CFRAveragePolicy average_policy(restored, nullptr);
+    CheckExploitabilityKuhnPoker(*game, average_policy);
+  }
+
+  // A tiny hot threshold routes everything through the exact side table.
+  CFRQuantizedInfoStateValuesTable all_hot(table, CFRValueStorage::kInt16,
+                                           /*hot_threshold=*/0);
+  SPIEL_CHECK_EQ(all_hot.num_hot_entries(), static_cast<int>(table.size()));
+  CFRInfoStateValuesTable exact = all_hot.Dequantize();
+  for (const auto& entry : table) {
+    SPIEL_CHECK_TRUE(exact.at(entry.first).cumulative_regrets ==
+                     entry.second.cumulative_regrets);
+  }
+}
+
 void CFRTest_KuhnPoker() {
   std::unique_ptr<Game> game = LoadGame("kuhn_poker");
   CFRSolver solver(*game);
@@ -72,6 +193,257 @@ void CFRPlusTest_KuhnPoker() {
   CheckExploitabilityKuhnPoker(*game, *average_policy);
 }
 
+void CFRParallelTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRParallelSolver solver(*game, /*num_threads=*/2);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CheckPoliciesBitwiseEqual(const State& state, const Policy& policy_a,
+                               const Policy& policy_b) {
+  if (state.IsTerminal()) return;
+  if (!state.IsChanceNode()) {
+    const std::string key = state.InformationStateKey(state.CurrentPlayer());
+    SPIEL_CHECK_TRUE(policy_a.GetStatePolicy(key) ==
+                     policy_b.GetStatePolicy(key));
+  }
+  for (Action action : state.LegalActions()) {
+    CheckPoliciesBitwiseEqual(*state.Child(action), policy_a, policy_b);
+  }
+}
+
+void CFRParallelDeterministicTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRParallelSolver solver_a(*game, /*num_threads=*/1, /*pin_workers=*/false,
+                             /*deterministic=*/true);
+  CFRParallelSolver solver_b(*game, /*num_threads=*/3, /*pin_workers=*/false,
+                             /*deterministic=*/true);
+  for (int i = 0; i < 10; i++) {
+    solver_a.EvaluateAndUpdatePolicy();
+    solver_b.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> policy_a = solver_a.AveragePolicy();
+  const std::unique_ptr<Policy> policy_b = solver_b.AveragePolicy();
+  CheckPoliciesBitwiseEqual(*game->NewInitialState(), *policy_a, *policy_b);
+}
+
+// A depth limit the game never reaches leaves the traversal untouched, so
+// the trunk solver is bitwise-identical to plain CFR. This also pins the
+// 2-player zero-sum scalar recursion against the general one: plain CFR
+// takes the scalar path on kuhn_poker, while the trunk solver always runs
+// the general per-player-vector recursion.
+void CFRTrunkTest_FullDepthMatchesCFR() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRSolver full(*game);
+  CFRTrunkSolver trunk(*game, /*depth=*/100);
+  for (int i = 0; i < 20; i++) {
+    full.EvaluateAndUpdatePolicy();
+    trunk.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> policy_a = full.AveragePolicy();
+  const std::unique_ptr<Policy> policy_b = trunk.AveragePolicy();
+  CheckPoliciesBitwiseEqual(*game->NewInitialState(), *policy_a, *policy_b);
+}
+
+// Depth 3 in kuhn cuts right after player 0's move: the trunk's only
+// decision nodes are player 0's three card info states (no betting has
+// happened yet), and the evaluator is called exactly once per depth-3
+// history (6 deals times 2 actions) no matter how many iterations run,
+// since leaf values are cached.
+void CFRTrunkTest_LeafCacheAndTrunkOnly() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  int evaluator_calls = 0;
+  CFRLeafEvaluator evaluator = [&evaluator_calls](const State& state) {
+    ++evaluator_calls;
+    return std::vector<double>(state.NumPlayers(), 0.0);
+  };
+  CFRTrunkSolver solver(*game, /*depth=*/3, evaluator);
+  for (int i = 0; i < 10; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_EQ(solver.InfoStateValuesTable().size(), 3);
+  SPIEL_CHECK_EQ(evaluator_calls, 12);
+}
+
+// The default rollout evaluator: the trunk solves against Monte Carlo leaf
+// values under uniform play.
+void CFRTrunkTest_RolloutLeaves() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRTrunkSolver solver(*game, /*depth=*/3, /*leaf_evaluator=*/nullptr,
+                        /*num_rollouts=*/50, /*seed=*/17);
+  for (int i = 0; i < 100; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_EQ(solver.InfoStateValuesTable().size(), 3);
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(0);
+  state->ApplyAction(1);
+  ActionsAndProbs state_policy = average_policy->GetStatePolicy(
+      state->InformationStateKey(state->CurrentPlayer()));
+  SPIEL_CHECK_EQ(state_policy.size(), 2);
+}
+
+// Records the first-visit order of info states in a depth-first walk, the
+// reference ordering for CFRTest_TreeOrderedFlatTable.
+void CollectInfoStatesDepthFirst(const State& state,
+                                 std::vector<std::string>* keys) {
+  if (state.IsTerminal()) return;
+  if (state.IsChanceNode()) {
+    for (const auto& outcome : state.ChanceOutcomes()) {
+      CollectInfoStatesDepthFirst(*state.Child(outcome.first), keys);
+    }
+    return;
+  }
+  std::string info_state = state.InformationStateKey(state.CurrentPlayer());
+  if (std::find(keys->begin(), keys->end(), info_state) == keys->end()) {
+    keys->push_back(info_state);
+  }
+  for (const Action& action : state.LegalActions()) {
+    CollectInfoStatesDepthFirst(*state.Child(action), keys);
+  }
+}
+
+void CFRTest_TreeOrderedFlatTable() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRInfoStateValuesFlatTable table = BuildTreeOrderedFlatTable(*game);
+  // Kuhn has 6 info states per player, 2 actions each.
+  SPIEL_CHECK_EQ(table.num_info_states(), 12);
+  for (int id = 0; id < table.num_info_states(); ++id) {
+    SPIEL_CHECK_EQ(table.num_actions(id), 2);
+  }
+  // Ids must follow the depth-first first-visit order of the tree walk.
+  std::vector<std::string> keys;
+  CollectInfoStatesDepthFirst(*game->NewInitialState(), &keys);
+  SPIEL_CHECK_EQ(keys.size(), table.num_info_states());
+  for (int id = 0; id < table.num_info_states(); ++id) {
+    SPIEL_CHECK_EQ(table.GetId(keys[id]), id);
+  }
+}
+
+void LCFRTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  LCFRSolver solver(*game);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void DCFRTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  DCFRSolver solver(*game);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CFRTest_FlatTableDiscounting() {
+  // The fused flat-table sweep must match discounting the map entries.
+  CFRInfoStateValuesTable table;
+  table["a"] = CFRInfoStateValues({0, 1, 2});
+  table["a"].cumulative_regrets = {1.0, -2.0, 3.0};
+  table["a"].cumulative_policy = {0.25, 0.5, 0.25};
+  table["b"] = CFRInfoStateValues({5, 7});
+  table["b"].cumulative_regrets = {-1.0, 4.0};
+  table["b"].cumulative_policy = {0.75, 0.25};
+
+  const double pos_factor = 0.9;
+  const double neg_factor = 0.5;
+  const double policy_factor = 0.8;
+  CFRInfoStateValuesFlatTable flat_table(table);
+  flat_table.ApplyDiscounting(pos_factor, neg_factor, policy_factor);
+
+  CFRInfoStateValuesTable discounted = flat_table.ToTable();
+  for (const auto& entry : table) {
+    const CFRInfoStateValues& expected = entry.second;
+    const CFRInfoStateValues& actual = discounted[entry.first];
+    for (int aidx = 0; aidx < expected.num_actions(); ++aidx) {
+      const double regret = expected.cumulative_regrets[aidx];
+      SPIEL_CHECK_FLOAT_EQ(
+          actual.cumulative_regrets[aidx],
+          regret * (regret > 0 ? pos_factor : neg_factor));
+      SPIEL_CHECK_FLOAT_EQ(actual.cumulative_policy[aidx],
+                           expected.cumulative_policy[aidx] * policy_factor);
+    }
+  }
+}
+
+void CFRPruningTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  // A threshold small enough to actually prune within 300 iterations on
+  // Kuhn; convergence must match the unpruned solver's bounds.
+  CFRPruningSolver solver(*game, /*pruning_threshold=*/-10.0,
+                          /*prune_revisit_every=*/25);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CFRReachPruningTest_KuhnPoker() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  // Once regret matching drives opponent actions out of the support, the
+  // subtrees below them carry zero counterfactual reach and are pruned;
+  // convergence must match the unpruned solver's bounds.
+  CFRReachPruningSolver solver(*game, /*reach_threshold=*/1e-6,
+                               /*full_pass_every=*/10);
+  for (int i = 0; i < 300; i++) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> average_policy = solver.AveragePolicy();
+  CheckNashKuhnPoker(*game, *average_policy);
+  CheckExploitabilityKuhnPoker(*game, *average_policy);
+}
+
+void CFRTest_WarmStartFromPolicy() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRSolver source(*game);
+  for (int i = 0; i < 200; i++) {
+    source.EvaluateAndUpdatePolicy();
+  }
+  const std::unique_ptr<Policy> source_policy = source.AveragePolicy();
+
+  // Priming reproduces the source policy before any iterations. The mapping
+  // hook is exercised with the identity.
+  CFRSolver warm(*game);
+  warm.WarmStart(*source_policy, /*weight=*/200,
+                 [](const std::string& key) { return key; });
+  const std::unique_ptr<Policy> primed = warm.AveragePolicy();
+  DepthFirstTraversal traversal(game->NewInitialState());
+  while (const State* state = traversal.Next()) {
+    if (state->IsTerminal() || state->IsChanceNode()) continue;
+    const std::string key = state->InformationStateKey();
+    const ActionsAndProbs primed_policy = primed->GetStatePolicy(key);
+    const ActionsAndProbs expected_policy = source_policy->GetStatePolicy(key);
+    for (const Action action : state->LegalActions()) {
+      SPIEL_CHECK_FLOAT_NEAR(GetProb(primed_policy, action),
+                             GetProb(expected_policy, action), 1e-9);
+    }
+  }
+
+  // A few iterations on the warm solver stay ahead of the same number from
+  // a cold start.
+  CFRSolver cold(*game);
+  for (int i = 0; i < 10; i++) {
+    warm.EvaluateAndUpdatePolicy();
+    cold.EvaluateAndUpdatePolicy();
+  }
+  SPIEL_CHECK_LT(Exploitability(*game, *warm.AveragePolicy()),
+                 Exploitability(*game, *cold.AveragePolicy()));
+}
+
 void CFRTest_KuhnPokerRunsWithThreePlayers(bool initialize_cumulative_values,
                                            bool linear_averaging,
                                            bool regret_matching_plus,
@@ -161,8 +533,23 @@ void CFRTest_TicTacToe(int num_iterations, double nashconv_upper_bound) {
 namespace algorithms = open_spiel::algorithms;
 
 int main(int argc, char** argv) {
+  algorithms::CFRTest_FlatTableMatchesMapTable();
+  algorithms::CFRTest_MemoryBudget();
+  algorithms::CFRTest_QuantizedTable();
   algorithms::CFRTest_KuhnPoker();
   algorithms::CFRPlusTest_KuhnPoker();
+  algorithms::CFRParallelTest_KuhnPoker();
+  algorithms::CFRParallelDeterministicTest_KuhnPoker();
+  algorithms::CFRPruningTest_KuhnPoker();
+  algorithms::CFRReachPruningTest_KuhnPoker();
+  algorithms::CFRTest_WarmStartFromPolicy();
+  algorithms::LCFRTest_KuhnPoker();
+  algorithms::DCFRTest_KuhnPoker();
+  algorithms::CFRTest_FlatTableDiscounting();
+  algorithms::CFRTest_TreeOrderedFlatTable();
+  algorithms::CFRTrunkTest_FullDepthMatchesCFR();
+  algorithms::CFRTrunkTest_LeafCacheAndTrunkOnly();
+  algorithms::CFRTrunkTest_RolloutLeaves();
   algorithms::CFRTest_KuhnPokerRunsWithThreePlayers(
       /*initialize_cumulative_values=*/false,
       /*linear_averaging=*/false,
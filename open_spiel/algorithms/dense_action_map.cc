@@ -0,0 +1,40 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/dense_action_map.h"
+
+#include <algorithm>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+DenseActionMap::DenseActionMap(const Game& game)
+    : dense_to_sparse_(game.PossibleDistinctActions()),
+      sparse_to_dense_(game.NumDistinctActions(), -1) {
+  SPIEL_CHECK_TRUE(std::is_sorted(dense_to_sparse_.begin(),
+                                  dense_to_sparse_.end()));
+  for (int dense = 0; dense < dense_to_sparse_.size(); ++dense) {
+    const Action action = dense_to_sparse_[dense];
+    SPIEL_CHECK_GE(action, 0);
+    SPIEL_CHECK_LT(action, sparse_to_dense_.size());
+    // Duplicates would silently alias table entries.
+    SPIEL_CHECK_EQ(sparse_to_dense_[action], -1);
+    sparse_to_dense_[action] = dense;
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
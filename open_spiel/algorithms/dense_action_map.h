@@ -0,0 +1,69 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DENSE_ACTION_MAP_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DENSE_ACTION_MAP_H_
+
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A bidirectional mapping between a game's sparse action ids and a dense
+// range [0, NumDenseActions()). Games whose action encoding packs move
+// components into bitfields leave most ids in [0, NumDistinctActions())
+// unused (chess reaches about 7% of its 1 << 15 ids), so arrays indexed by
+// action id -- tabular policies, regret tables, network policy heads --
+// waste memory proportionally. Build the map once per game and size those
+// arrays by NumDenseActions() instead, translating with ToDense/FromDense.
+//
+// The map is built from Game::PossibleDistinctActions(); for games that do
+// not override it the mapping is the identity.
+class DenseActionMap {
+ public:
+  explicit DenseActionMap(const Game& game);
+
+  // The number of reachable action ids.
+  int NumDenseActions() const { return dense_to_sparse_.size(); }
+
+  // Maps a game action id to its dense index. It is an error to pass an
+  // action id the game declared unreachable.
+  int ToDense(Action action) const {
+    SPIEL_CHECK_GE(action, 0);
+    SPIEL_CHECK_LT(action, sparse_to_dense_.size());
+    const int dense = sparse_to_dense_[action];
+    SPIEL_CHECK_GE(dense, 0);
+    return dense;
+  }
+
+  // Maps a dense index back to the game's action id.
+  Action FromDense(int dense) const {
+    SPIEL_CHECK_GE(dense, 0);
+    SPIEL_CHECK_LT(dense, dense_to_sparse_.size());
+    return dense_to_sparse_[dense];
+  }
+
+ private:
+  // dense index -> action id, ascending.
+  std::vector<Action> dense_to_sparse_;
+  // action id -> dense index, -1 for unreachable ids.
+  std::vector<int> sparse_to_dense_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_DENSE_ACTION_MAP_H_
@@ -0,0 +1,74 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/dense_action_map.h"
+
+#include <memory>
+#include <random>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void IdentityMapTest() {
+  // Tic-tac-toe uses every action id, so the map is the identity.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  DenseActionMap map(*game);
+  SPIEL_CHECK_EQ(map.NumDenseActions(), game->NumDistinctActions());
+  for (int i = 0; i < map.NumDenseActions(); ++i) {
+    SPIEL_CHECK_EQ(map.ToDense(i), i);
+    SPIEL_CHECK_EQ(map.FromDense(i), i);
+  }
+}
+
+void ChessCompactionTest() {
+  // Chess's bitfield encoding reaches only the geometrically possible
+  // moves: 1792 queen/knight from-to pairs plus the promotion variants,
+  // far below the 1 << 15 encodable ids.
+  std::unique_ptr<Game> game = LoadGame("chess");
+  DenseActionMap map(*game);
+  SPIEL_CHECK_GT(map.NumDenseActions(), 1792);
+  SPIEL_CHECK_LT(map.NumDenseActions(), 4096);
+
+  // The dense ids round-trip.
+  for (int dense = 0; dense < map.NumDenseActions(); ++dense) {
+    SPIEL_CHECK_EQ(map.ToDense(map.FromDense(dense)), dense);
+  }
+
+  // Every action that comes up in play has a dense id.
+  std::mt19937 rng(2875);
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (int i = 0; i < 60 && !state->IsTerminal(); ++i) {
+    std::vector<Action> legal_actions = state->LegalActions();
+    for (Action action : legal_actions) {
+      SPIEL_CHECK_GE(map.ToDense(action), 0);
+      SPIEL_CHECK_LT(map.ToDense(action), map.NumDenseActions());
+    }
+    state->ApplyAction(
+        legal_actions[std::uniform_int_distribution<int>(
+            0, legal_actions.size() - 1)(rng)]);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::IdentityMapTest();
+  open_spiel::algorithms::ChessCompactionTest();
+}
@@ -89,6 +89,78 @@ void DeterministicTabularPolicy::CreateTable(const Game& game, int player) {
   }
 }
 
+IndexedDeterministicPolicy::IndexedDeterministicPolicy(const Game& game,
+                                                       int player)
+    : player_(player) {
+  std::unordered_map<std::string, std::vector<Action>> legal_actions_map =
+      GetLegalActionsMap(game, -1, player);
+  keys_.reserve(legal_actions_map.size());
+  for (const auto& info_state_actions : legal_actions_map) {
+    keys_.push_back(info_state_actions.first);
+  }
+  // Sorted keys make the counting order independent of the hash order.
+  std::sort(keys_.begin(), keys_.end());
+  id_by_key_.reserve(keys_.size());
+  action_begin_.push_back(0);
+  for (const std::string& key : keys_) {
+    id_by_key_.emplace(key, id_by_key_.size());
+    const std::vector<Action>& legal_actions = legal_actions_map[key];
+    SPIEL_CHECK_GT(legal_actions.size(), 0);
+    actions_.insert(actions_.end(), legal_actions.begin(),
+                    legal_actions.end());
+    action_begin_.push_back(actions_.size());
+  }
+  index_.resize(keys_.size(), 0);
+}
+
+Action IndexedDeterministicPolicy::GetAction(
+    const std::string& info_state) const {
+  const int id = InfoStateId(info_state);
+  SPIEL_CHECK_GE(id, 0);
+  return GetAction(id);
+}
+
+ActionsAndProbs IndexedDeterministicPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  const int id = InfoStateId(info_state);
+  SPIEL_CHECK_GE(id, 0);
+  ActionsAndProbs state_policy;
+  state_policy.reserve(action_begin_[id + 1] - action_begin_[id]);
+  const Action policy_action = GetAction(id);
+  for (int slot = action_begin_[id]; slot < action_begin_[id + 1]; ++slot) {
+    state_policy.push_back(std::pair<Action, double>(
+        actions_[slot], actions_[slot] == policy_action ? 1.0 : 0.0));
+  }
+  return state_policy;
+}
+
+bool IndexedDeterministicPolicy::NextPolicy() {
+  // The indices are the digits of a mixed-base counter: find the first digit
+  // that can be incremented and reset the ones skipped over.
+  for (int id = 0; id < static_cast<int>(index_.size()); ++id) {
+    if (index_[id] + 1 < action_begin_[id + 1] - action_begin_[id]) {
+      index_[id] += 1;
+      std::fill(index_.begin(), index_.begin() + id, 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+void IndexedDeterministicPolicy::ResetDefaultPolicy() {
+  std::fill(index_.begin(), index_.end(), 0);
+}
+
+std::string IndexedDeterministicPolicy::ToString(
+    const std::string& delimiter) const {
+  std::string str = "";
+  for (int id = 0; id < static_cast<int>(keys_.size()); ++id) {
+    absl::StrAppend(&str, keys_[id], " ", delimiter, " ",
+                    "action = ", GetAction(id), "\n");
+  }
+  return str;
+}
+
 std::string DeterministicTabularPolicy::ToString(
     const std::string& delimiter) const {
   std::string str = "";
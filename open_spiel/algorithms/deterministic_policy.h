@@ -104,6 +104,59 @@ class DeterministicTabularPolicy : public Policy {
   int player_;
 };
 
+// An indexed equivalent of DeterministicTabularPolicy: information states
+// get dense ids (in sorted key order), the legal actions live in one flat
+// array, and the policy itself is just the array of chosen action indices.
+// NextPolicy() is then a plain odometer increment with no hashing or
+// allocation, which is what makes exhaustive sweeps over millions of
+// deterministic policies practical. String lookups are still supported for
+// use as a Policy, but the intended access path in a sweep is by id.
+class IndexedDeterministicPolicy : public Policy {
+ public:
+  // Creates the first policy in the counting order: every information state
+  // set to its first legal action.
+  IndexedDeterministicPolicy(const Game& game, int player);
+
+  int num_info_states() const { return keys_.size(); }
+
+  // Returns the id of the information state, or -1 if it is not in the
+  // table.
+  int InfoStateId(const std::string& info_state) const {
+    auto iter = id_by_key_.find(info_state);
+    return iter == id_by_key_.end() ? -1 : iter->second;
+  }
+
+  const std::string& InfoStateKey(int id) const { return keys_[id]; }
+
+  Action GetAction(int id) const {
+    return actions_[action_begin_[id] + index_[id]];
+  }
+  Action GetAction(const std::string& info_state) const;
+
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+
+  // Advances to the next policy in the counting order over the ids (the
+  // same mixed-base order as DeterministicTabularPolicy::NextPolicy, with
+  // the ids as digits). Returns false when the current policy is the last
+  // one, leaving it unchanged.
+  bool NextPolicy();
+
+  // Resets to the first policy in the counting order.
+  void ResetDefaultPolicy();
+
+  std::string ToString(const std::string& delimiter) const;
+
+ private:
+  int player_;
+  std::vector<std::string> keys_;  // Sorted information state strings.
+  std::unordered_map<std::string, int> id_by_key_;
+  // The legal actions of id are actions_[action_begin_[id]] (inclusive)
+  // to actions_[action_begin_[id + 1]] (exclusive).
+  std::vector<int> action_begin_;
+  std::vector<Action> actions_;
+  std::vector<int> index_;  // The chosen action index of each id.
+};
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
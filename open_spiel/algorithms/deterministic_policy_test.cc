@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/deterministic_policy.h"
 
+#include <set>
+#include <string>
+
 #include "open_spiel/games/kuhn_poker.h"
 
 namespace open_spiel {
@@ -39,10 +42,44 @@ void KuhnDeterministicPolicyTest() {
   SPIEL_CHECK_EQ(p1_policies, 64);  // 2^6
 }
 
+void KuhnIndexedDeterministicPolicyTest() {
+  kuhn_poker::KuhnGame kuhn_game({});
+
+  for (int player : {0, 1}) {
+    IndexedDeterministicPolicy policy(kuhn_game, player);
+    SPIEL_CHECK_EQ(policy.num_info_states(), 6);
+
+    // The enumeration has the same length as the string-keyed one, and every
+    // policy visited is distinct.
+    std::set<std::string> seen;
+    seen.insert(policy.ToString(":"));
+    while (policy.NextPolicy()) {
+      seen.insert(policy.ToString(":"));
+    }
+    SPIEL_CHECK_EQ(seen.size(), 64);  // 2^6
+
+    // After the last policy, the id and string lookups still agree.
+    for (int id = 0; id < policy.num_info_states(); ++id) {
+      const std::string& key = policy.InfoStateKey(id);
+      SPIEL_CHECK_EQ(policy.InfoStateId(key), id);
+      SPIEL_CHECK_EQ(policy.GetAction(key), policy.GetAction(id));
+      for (const auto& action_and_prob : policy.GetStatePolicy(key)) {
+        SPIEL_CHECK_EQ(action_and_prob.second,
+                       action_and_prob.first == policy.GetAction(id) ? 1.0
+                                                                     : 0.0);
+      }
+    }
+
+    policy.ResetDefaultPolicy();
+    SPIEL_CHECK_TRUE(seen.count(policy.ToString(":")) == 1);
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::algorithms::KuhnDeterministicPolicyTest();
+  open_spiel::algorithms::KuhnIndexedDeterministicPolicyTest();
 }
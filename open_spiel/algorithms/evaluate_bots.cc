@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "open_spiel/algorithms/evaluate_bots.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #include "open_spiel/spiel_bots.h"
 
 namespace open_spiel {
@@ -45,4 +52,97 @@ std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
   return state->Returns();
 }
 
+namespace {
+
+// Plays every episode of one matchup. The worker thread that claimed the
+// matchup owns the bots, so no synchronization is needed while stepping them.
+void PlayMatchup(const Game& game,
+                 const std::vector<BotFactory>& bot_factories, int seed,
+                 MatchupResult* result) {
+  const int num_players = game.NumPlayers();
+  std::vector<std::unique_ptr<Bot>> bots;
+  std::vector<Bot*> bot_ptrs;
+  bots.push_back(bot_factories[result->bot0](game, /*player_id=*/0, seed));
+  bots.push_back(bot_factories[result->bot1](game, /*player_id=*/1, seed + 1));
+  for (auto& bot : bots) bot_ptrs.push_back(bot.get());
+
+  std::vector<double> sum(num_players, 0.0);
+  std::vector<double> sum_squares(num_players, 0.0);
+  for (int episode = 0; episode < result->num_episodes; ++episode) {
+    std::unique_ptr<State> state = game.NewStateFromPool();
+    std::vector<double> returns =
+        EvaluateBots(state.get(), bot_ptrs, seed + 2 + episode);
+    game.ReleaseStateToPool(std::move(state));
+    for (int p = 0; p < num_players; ++p) {
+      sum[p] += returns[p];
+      sum_squares[p] += returns[p] * returns[p];
+    }
+  }
+
+  const int n = result->num_episodes;
+  result->mean_returns.resize(num_players);
+  result->confidence_radius.resize(num_players, 0.0);
+  for (int p = 0; p < num_players; ++p) {
+    double mean = sum[p] / n;
+    result->mean_returns[p] = mean;
+    if (n > 1) {
+      double variance =
+          std::max(0.0, (sum_squares[p] - n * mean * mean) / (n - 1));
+      result->confidence_radius[p] = 1.96 * std::sqrt(variance / n);
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<MatchupResult> RoundRobinTournament(
+    const Game& game, const std::vector<BotFactory>& bot_factories,
+    int episodes_per_matchup, int seed, int num_threads) {
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+  SPIEL_CHECK_GE(bot_factories.size(), 2);
+  SPIEL_CHECK_GT(episodes_per_matchup, 0);
+  SPIEL_CHECK_GE(num_threads, 1);
+
+  const int num_bots = bot_factories.size();
+  std::vector<MatchupResult> results;
+  for (int i = 0; i < num_bots; ++i) {
+    for (int j = 0; j < num_bots; ++j) {
+      if (i == j) continue;
+      MatchupResult result;
+      result.bot0 = i;
+      result.bot1 = j;
+      result.num_episodes = episodes_per_matchup;
+      results.push_back(result);
+    }
+  }
+
+  // Each matchup is seeded from its position in the schedule, so the results
+  // do not depend on which thread runs it.
+  auto matchup_seed = [seed, episodes_per_matchup](std::size_t index) {
+    return seed + static_cast<int>(index) * (episodes_per_matchup + 2);
+  };
+
+  if (num_threads == 1) {
+    for (std::size_t m = 0; m < results.size(); ++m) {
+      PlayMatchup(game, bot_factories, matchup_seed(m), &results[m]);
+    }
+    return results;
+  }
+
+  std::atomic<std::size_t> next_matchup(0);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&]() {
+      while (true) {
+        std::size_t m = next_matchup++;
+        if (m >= results.size()) return;
+        PlayMatchup(game, bot_factories, matchup_seed(m), &results[m]);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  return results;
+}
+
 }  // namespace open_spiel
@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -27,6 +29,38 @@ namespace open_spiel {
 std::vector<double> EvaluateBots(State* state, const std::vector<Bot*>& bots,
                                  int seed);
 
+// Creates a bot playing as player_id. The tournament runner below calls a
+// factory once per (matchup, player) on the worker thread that will step the
+// bot, since Bot instances are stateful and must not be shared across
+// threads.
+using BotFactory =
+    std::function<std::unique_ptr<Bot>(const Game& game, int player_id,
+                                       int seed)>;
+
+// Aggregated returns of one matchup of a round-robin tournament.
+struct MatchupResult {
+  // Indices into the factory vector: bot0 plays as player 0, bot1 as
+  // player 1.
+  int bot0;
+  int bot1;
+  int num_episodes;
+
+  // Per-player mean return, with the 95% confidence half-width around it.
+  std::vector<double> mean_returns;
+  std::vector<double> confidence_radius;
+};
+
+// Plays every ordered pair of distinct bots against each other for
+// episodes_per_matchup episodes of the (two-player) game, splitting the
+// matchups across num_threads worker threads. Each worker constructs its own
+// bots, reuses them across the episodes of a matchup, and draws episode
+// states from the game's state pool, so nothing is loaded per episode.
+// Matchups are seeded deterministically from `seed`, making results
+// independent of the thread schedule.
+std::vector<MatchupResult> RoundRobinTournament(
+    const Game& game, const std::vector<BotFactory>& bot_factories,
+    int episodes_per_matchup, int seed, int num_threads = 1);
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EVALUATE_BOTS_H_
@@ -42,7 +42,44 @@ void BotTest_RandomVsRandom() {
   SPIEL_CHECK_FLOAT_NEAR(average_results[1], -0.125, 0.01);
 }  // namespace
 
+void BotTest_RoundRobinTournament() {
+  auto game = LoadGame("kuhn_poker");
+  BotFactory random_bot_factory = [](const Game& game, int player_id,
+                                     int seed) {
+    return MakeUniformRandomBot(game, player_id, seed);
+  };
+  std::vector<BotFactory> factories(2, random_bot_factory);
+
+  constexpr int num_episodes = 50000;
+  std::vector<MatchupResult> results = RoundRobinTournament(
+      *game, factories, num_episodes, /*seed=*/42, /*num_threads=*/2);
+
+  // Two bots -> two ordered matchups.
+  SPIEL_CHECK_EQ(results.size(), 2);
+  for (const MatchupResult& result : results) {
+    SPIEL_CHECK_EQ(result.num_episodes, num_episodes);
+    SPIEL_CHECK_EQ(result.mean_returns.size(), 2);
+    // Kuhn is zero-sum, and uniform random play favours player 0 by 0.125.
+    SPIEL_CHECK_FLOAT_NEAR(result.mean_returns[0] + result.mean_returns[1],
+                           0.0, 1e-12);
+    SPIEL_CHECK_FLOAT_NEAR(result.mean_returns[0], 0.125, 0.02);
+    SPIEL_CHECK_GT(result.confidence_radius[0], 0.0);
+    SPIEL_CHECK_LT(result.confidence_radius[0], 0.02);
+  }
+
+  // Matchups are seeded independently of the thread schedule, so a re-run
+  // with the same seed reproduces the results exactly.
+  std::vector<MatchupResult> rerun = RoundRobinTournament(
+      *game, factories, num_episodes, /*seed=*/42, /*num_threads=*/1);
+  for (std::size_t m = 0; m < results.size(); ++m) {
+    SPIEL_CHECK_EQ(results[m].mean_returns, rerun[m].mean_returns);
+  }
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::BotTest_RandomVsRandom(); }
+int main(int argc, char** argv) {
+  open_spiel::BotTest_RandomVsRandom();
+  open_spiel::BotTest_RoundRobinTournament();
+}
@@ -16,6 +16,7 @@
 
 #include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "open_spiel/simultaneous_move_game.h"
@@ -25,45 +26,65 @@ namespace open_spiel {
 namespace algorithms {
 namespace {
 
-// Implements the recursive traversal using a general way to access the
-// player's policies via a function that takes as arguments the player id and
-// information state.
-std::vector<double> ExpectedReturnsImpl(
-    const State& state,
-    const std::function<ActionsAndProbs(int, const std::string&)>& policy_func,
-    int depth_limit) {
-  if (state.IsTerminal() || depth_limit == 0) {
-    return state.Rewards();
-  }
+using PolicyFunc = std::function<ActionsAndProbs(int, const std::string&)>;
 
-  int num_players = state.NumPlayers();
-  std::vector<double> values(num_players, 0.0);
+// One level of the evaluation, as an explicit stack frame. The traversal
+// used to be recursive; on deep games the native call stack is a scarce
+// resource, so the post-order value computation is driven by a frame stack
+// instead (see tree_traversal.h for the pre-order counterpart). A frame
+// holds its node's partial value and the (probability, actions) list of
+// children still to evaluate; children are cloned one at a time when their
+// turn comes, so memory stays at one state and one frame per level of the
+// current path, as in the recursion.
+struct EvalFrame {
+  std::unique_ptr<State> state;
+  // Weight of this node's finished value in its parent's accumulation.
+  double prob_in_parent = 1.0;
+  // This node's depth_limit, as the recursion would have received it
+  // (negative: unlimited).
+  int remaining_depth = -1;
+  // Accumulated values; seeded with Rewards() at decision and simultaneous
+  // nodes, zeros at chance nodes.
+  std::vector<double> values;
+  // Pending children as (probability, actions to apply): one action for
+  // chance and turn-based nodes, one action per player at simultaneous
+  // nodes. Zero-probability children are filtered out at decision and
+  // simultaneous nodes, as before.
+  std::vector<std::pair<double, std::vector<Action>>> pending;
+  std::size_t next = 0;
+  bool cacheable = false;
+  uint64_t cache_key = 0;
+};
+
+// Fills a frame's seed values and pending-children list for a non-terminal,
+// non-depth-exhausted state; mirrors one level of the old recursion.
+void ExpandFrame(const State& state, const PolicyFunc& policy_func,
+                 EvalFrame* frame) {
+  const int num_players = state.NumPlayers();
+  frame->values.assign(num_players, 0.0);
   if (state.IsChanceNode()) {
-    ActionsAndProbs action_and_probs = state.ChanceOutcomes();
-    for (const auto& action_and_prob : action_and_probs) {
-      std::unique_ptr<State> child = state.Child(action_and_prob.first);
-      std::vector<double> child_values =
-          ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
-      for (int p = 0; p < num_players; ++p) {
-        values[p] += action_and_prob.second * child_values[p];
-      }
+    for (const auto& action_and_prob : state.ChanceOutcomes()) {
+      frame->pending.push_back(
+          {action_and_prob.second, {action_and_prob.first}});
     }
   } else if (state.IsSimultaneousNode()) {
-    // Walk over all the joint actions, and weight by the product of
-    // probabilities to choose them.
-    values = state.Rewards();
+    // Weight each joint action by the product of the players' probabilities
+    // of choosing it.
+    frame->values = state.Rewards();
     auto smstate = dynamic_cast<const SimMoveState*>(&state);
     SPIEL_CHECK_TRUE(smstate != nullptr);
     std::vector<ActionsAndProbs> state_policies(num_players);
     for (int p = 0; p < num_players; ++p) {
-      state_policies[p] = policy_func(p, state.InformationState(p));
+      state_policies[p] = policy_func(p, state.InformationStateKey(p));
       if (state_policies[p].empty()) {
-        SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
+        SpielFatalError("Error in ExpectedReturns; infostate not found.");
       }
     }
-    for (const Action flat_action : smstate->LegalActions()) {
-      std::vector<Action> actions =
-          smstate->FlatJointActionToActions(flat_action);
+    // Iterate the joint actions directly rather than materializing the flat
+    // list and expanding each id; the full cross-product of states is never
+    // allocated, only the surviving (probability, actions) entries.
+    smstate->ForEachJointAction([&](Action flat_action,
+                                    const std::vector<Action>& actions) {
       double joint_action_prob = 1.0;
       for (int p = 0; p < num_players; ++p) {
         double player_action_prob = GetProb(state_policies[p], actions[p]);
@@ -74,65 +95,194 @@ std::vector<double> ExpectedReturnsImpl(
           break;
         }
       }
-
       if (joint_action_prob > 0.0) {
-        std::unique_ptr<State> child = state.Clone();
-        child->ApplyActions(actions);
-        std::vector<double> child_values =
-            ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
-        for (int p = 0; p < num_players; ++p) {
-          values[p] += joint_action_prob * child_values[p];
-        }
+        frame->pending.push_back({joint_action_prob, actions});
       }
-    }
+    });
   } else {
     // Turn-based decision node.
     int player = state.CurrentPlayer();
     ActionsAndProbs state_policy =
-        policy_func(player, state.InformationState());
+        policy_func(player, state.InformationStateKey());
     if (state_policy.empty()) {
-      SpielFatalError("Error in ExpectedReturnsImpl; infostate not found.");
+      SpielFatalError("Error in ExpectedReturns; infostate not found.");
     }
-    values = state.Rewards();
+    frame->values = state.Rewards();
     for (const Action action : state.LegalActions()) {
-      std::unique_ptr<State> child = state.Child(action);
       double action_prob = GetProb(state_policy, action);
       SPIEL_CHECK_GE(action_prob, 0.0);
       SPIEL_CHECK_LE(action_prob, 1.0);
       if (action_prob > 0.0) {
-        std::vector<double> child_values =
-            ExpectedReturnsImpl(*child, policy_func, depth_limit - 1);
+        frame->pending.push_back({action_prob, {action}});
+      }
+    }
+  }
+}
+
+// Builds the child state for a pending entry of the frame.
+std::unique_ptr<State> MakeChild(const State& state,
+                                 const std::vector<Action>& actions) {
+  if (state.IsSimultaneousNode()) {
+    std::unique_ptr<State> child = state.Clone();
+    child->ApplyActions(actions);
+    return child;
+  }
+  return state.Child(actions[0]);
+}
+
+// Implements the traversal using a general way to access the player's
+// policies via a function that takes as arguments the player id and
+// information state.
+std::vector<double> ExpectedReturnsImpl(
+    const State& state, const PolicyFunc& policy_func, int depth_limit,
+    ExpectedReturnsCache* cache) {
+  if (state.IsTerminal() || depth_limit == 0) {
+    return state.Rewards();
+  }
+
+  // Only full traversals are memoized: a truncated subtree value depends on
+  // the remaining depth, so depth-limited lookups would be wrong.
+  const bool use_cache = cache != nullptr && depth_limit < 0;
+  if (use_cache) {
+    auto it = cache->find(state.HashValue());
+    if (it != cache->end()) {
+      return it->second;
+    }
+  }
+
+  const int num_players = state.NumPlayers();
+  std::vector<EvalFrame> stack;
+  {
+    EvalFrame root;
+    root.remaining_depth = depth_limit;
+    root.cacheable = use_cache;
+    if (use_cache) root.cache_key = state.HashValue();
+    ExpandFrame(state, policy_func, &root);
+    root.state = state.Clone();
+    stack.push_back(std::move(root));
+  }
+
+  std::vector<double> completed;
+  while (!stack.empty()) {
+    EvalFrame& top = stack.back();
+    if (top.next == top.pending.size()) {
+      // All children folded in: finish this node and fold its value into
+      // the parent frame.
+      SPIEL_CHECK_EQ(top.values.size(), num_players);
+      if (top.cacheable) {
+        (*cache)[top.cache_key] = top.values;
+      }
+      completed = std::move(top.values);
+      const double weight = top.prob_in_parent;
+      stack.pop_back();
+      if (!stack.empty()) {
+        EvalFrame& parent = stack.back();
         for (int p = 0; p < num_players; ++p) {
-          values[p] += action_prob * child_values[p];
+          parent.values[p] += weight * completed[p];
         }
       }
+      continue;
+    }
+
+    const auto& entry = top.pending[top.next++];
+    std::unique_ptr<State> child = MakeChild(*top.state, entry.second);
+    const int child_depth = top.remaining_depth - 1;
+    if (child->IsTerminal() || child_depth == 0) {
+      const std::vector<double> rewards = child->Rewards();
+      for (int p = 0; p < num_players; ++p) {
+        top.values[p] += entry.first * rewards[p];
+      }
+      continue;
     }
+    if (use_cache) {
+      auto it = cache->find(child->HashValue());
+      if (it != cache->end()) {
+        for (int p = 0; p < num_players; ++p) {
+          top.values[p] += entry.first * it->second[p];
+        }
+        continue;
+      }
+    }
+
+    EvalFrame frame;
+    frame.prob_in_parent = entry.first;
+    frame.remaining_depth = child_depth;
+    frame.cacheable = use_cache;
+    if (use_cache) frame.cache_key = child->HashValue();
+    ExpandFrame(*child, policy_func, &frame);
+    frame.state = std::move(child);
+    // Invalidates `top`; the loop re-reads the stack top.
+    stack.push_back(std::move(frame));
   }
-  SPIEL_CHECK_EQ(values.size(), state.NumPlayers());
-  return values;
+  return completed;
 }
 }  // namespace
 
 std::vector<double> ExpectedReturns(const State& state,
                                     const std::vector<const Policy*>& policies,
-                                    int depth_limit) {
+                                    int depth_limit,
+                                    ExpectedReturnsCache* cache) {
   return ExpectedReturnsImpl(
       state,
       [&policies](int player, const std::string& info_state) {
         return policies[player]->GetStatePolicy(info_state);
       },
-      depth_limit);
+      depth_limit, cache);
 }
 
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit) {
+                                    int depth_limit,
+                                    ExpectedReturnsCache* cache) {
   return ExpectedReturnsImpl(
       state,
       [&joint_policy](int player, const std::string& info_state) {
         return joint_policy.GetStatePolicy(info_state);
       },
-      depth_limit);
+      depth_limit, cache);
+}
+
+std::vector<double> ParallelExpectedReturns(const State& state,
+                                            const Policy& joint_policy,
+                                            int depth_limit,
+                                            int num_threads) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  if (num_threads == 1 || depth_limit == 0 || state.IsTerminal() ||
+      !state.IsChanceNode()) {
+    return ExpectedReturns(state, joint_policy, depth_limit);
+  }
+
+  const ActionsAndProbs outcomes = state.ChanceOutcomes();
+  const int num_players = state.NumPlayers();
+  std::vector<std::vector<double>> partial_values(
+      num_threads, std::vector<double>(num_players, 0.0));
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    workers.emplace_back([t, num_threads, depth_limit, num_players, &state,
+                          &joint_policy, &outcomes, &partial_values]() {
+      // Round-robin assignment of root outcomes to this worker.
+      for (int oidx = t; oidx < outcomes.size(); oidx += num_threads) {
+        std::unique_ptr<State> child = state.Child(outcomes[oidx].first);
+        std::vector<double> child_values =
+            ExpectedReturns(*child, joint_policy, depth_limit - 1);
+        for (int p = 0; p < num_players; ++p) {
+          partial_values[t][p] += outcomes[oidx].second * child_values[p];
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  std::vector<double> values(num_players, 0.0);
+  for (const std::vector<double>& partial : partial_values) {
+    for (int p = 0; p < num_players; ++p) {
+      values[p] += partial[p];
+    }
+  }
+  return values;
 }
 
 }  // namespace algorithms
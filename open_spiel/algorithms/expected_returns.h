@@ -15,7 +15,9 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPECTED_RETURNS_H_
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -23,18 +25,49 @@
 namespace open_spiel {
 namespace algorithms {
 
+// A subtree-value cache keyed by State::HashValue(), so identical positions
+// reached through different histories are evaluated once per pass — and, if
+// the cache is kept across calls, once per policy. Only sound for
+// perfect-information games (where the policy seen below a position depends
+// only on the position, not on how it was reached), and the cached values
+// are tied to the policy they were computed under: discard or clear the
+// cache whenever the policy changes. Keys are 64-bit hashes, with the usual
+// transposition-table caveat that a hash collision silently returns the
+// colliding position's value.
+using ExpectedReturnsCache = std::unordered_map<uint64_t, std::vector<double>>;
+
 // Computes the (undiscounted) expected returns from a depth-limited search
 // starting at the state and following each player's policy. Using a negative
 // depth will do a full tree traversal (from the specified state).
 //
 // The second overloaded function acts the same way, except assumes that all of
 // the players' policies are encapsulated in one joint policy.
+//
+// When a cache is supplied, full traversals (negative depth) memoize subtree
+// values by position; depth-limited traversals ignore the cache since a
+// subtree's truncated value depends on the remaining depth. See the
+// ExpectedReturnsCache comment above for when this is sound.
 std::vector<double> ExpectedReturns(const State& state,
                                     const std::vector<const Policy*>& policies,
-                                    int depth_limit);
+                                    int depth_limit,
+                                    ExpectedReturnsCache* cache = nullptr);
 std::vector<double> ExpectedReturns(const State& state,
                                     const Policy& joint_policy,
-                                    int depth_limit);
+                                    int depth_limit,
+                                    ExpectedReturnsCache* cache = nullptr);
+
+// As ExpectedReturns, with the subtrees under the root chance node's
+// outcomes evaluated on num_threads worker threads, round-robin. The
+// outcomes are independent, so each worker accumulates its own weighted
+// partial sums and the results are merged after the join; only the order of
+// floating point additions can differ from the single-threaded traversal.
+// Falls back to the single-threaded traversal when the state is not a
+// chance node (or num_threads is 1). The policy must be safe for concurrent
+// GetStatePolicy calls (true of TabularPolicy and the other policies in
+// policy.h).
+std::vector<double> ParallelExpectedReturns(const State& state,
+                                            const Policy& joint_policy,
+                                            int depth_limit, int num_threads);
 
 }  // namespace algorithms
 }  // namespace open_spiel
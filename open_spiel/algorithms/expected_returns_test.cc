@@ -0,0 +1,99 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/expected_returns.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Cached evaluation must return the same values as the plain traversal, on
+// cold and warm caches alike. Tic-tac-toe transposes heavily (the same board
+// is reached by many move orders), so the cache is actually exercised.
+void CachedReturnsMatchUncachedTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  std::unique_ptr<State> root = game->NewInitialState();
+
+  std::vector<double> expected =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/-1);
+
+  ExpectedReturnsCache cache;
+  std::vector<double> cold =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/-1, &cache);
+  SPIEL_CHECK_GT(cache.size(), 0);
+  std::vector<double> warm =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/-1, &cache);
+
+  SPIEL_CHECK_EQ(expected.size(), cold.size());
+  SPIEL_CHECK_EQ(expected.size(), warm.size());
+  for (int p = 0; p < game->NumPlayers(); ++p) {
+    SPIEL_CHECK_FLOAT_EQ(cold[p], expected[p]);
+    SPIEL_CHECK_FLOAT_EQ(warm[p], expected[p]);
+  }
+}
+
+// Depth-limited traversals must not read or populate the cache.
+void DepthLimitedIgnoresCacheTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  std::unique_ptr<State> root = game->NewInitialState();
+
+  std::vector<double> expected =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/3);
+  ExpectedReturnsCache cache;
+  std::vector<double> cached =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/3, &cache);
+  SPIEL_CHECK_EQ(cache.size(), 0);
+  for (int p = 0; p < game->NumPlayers(); ++p) {
+    SPIEL_CHECK_FLOAT_EQ(cached[p], expected[p]);
+  }
+}
+
+// The parallel split over root chance outcomes must agree with the
+// single-threaded traversal; leduc's root deal gives the workers real
+// subtrees to share.
+void ParallelReturnsMatchSequentialTest() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  std::unique_ptr<State> root = game->NewInitialState();
+
+  std::vector<double> expected =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/-1);
+  for (int num_threads = 1; num_threads <= 3; ++num_threads) {
+    std::vector<double> values = ParallelExpectedReturns(
+        *root, uniform_policy, /*depth_limit=*/-1, num_threads);
+    SPIEL_CHECK_EQ(values.size(), expected.size());
+    for (int p = 0; p < game->NumPlayers(); ++p) {
+      SPIEL_CHECK_FLOAT_EQ(values[p], expected[p]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::CachedReturnsMatchUncachedTest();
+  open_spiel::algorithms::DepthLimitedIgnoresCacheTest();
+  open_spiel::algorithms::ParallelReturnsMatchSequentialTest();
+}
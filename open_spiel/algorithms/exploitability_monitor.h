@@ -0,0 +1,93 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_MONITOR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_MONITOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/spiel.h"
+
+// Background convergence monitoring for the tabular CFR solvers. Computing
+// NashConv on the solver thread pauses iteration for a full best-response
+// pass; the monitor instead snapshots the solver's value table (a plain
+// copy, cheap next to an evaluation) and runs NashConv on its own thread
+// while the solver keeps iterating. Completed evaluations are kept in memory
+// and optionally appended to a CSV sink, giving a convergence time series
+// without stealing solver wall-clock.
+
+namespace open_spiel {
+namespace algorithms {
+
+// One completed evaluation.
+struct ExploitabilityRecord {
+  int iteration;     // The solver iteration the snapshot was taken at.
+  double seconds;    // Wall-clock since the monitor was created.
+  double nash_conv;  // NashConv of the snapshot's average policy.
+};
+
+class ExploitabilityMonitor {
+ public:
+  // The game must outlive the monitor. When csv_filename is non-empty, each
+  // completed evaluation appends an "iteration,seconds,nash_conv" row (a
+  // header row is written up front).
+  explicit ExploitabilityMonitor(const Game& game,
+                                 const std::string& csv_filename = "");
+
+  // Waits for any in-flight evaluation to finish.
+  ~ExploitabilityMonitor();
+
+  // Snapshots the table and schedules a NashConv evaluation of its average
+  // policy on the background thread. Returns false — and copies nothing —
+  // when an evaluation is still in flight, so the solver thread never
+  // blocks on the monitor; callers just request again a few iterations
+  // later.
+  bool RequestEvaluation(int iteration, const CFRInfoStateValuesTable& table);
+
+  // Blocks until no evaluation is in flight. Call before reading the final
+  // record or the CSV at the end of a run.
+  void Flush();
+
+  // Completed evaluations, oldest first.
+  std::vector<ExploitabilityRecord> Records() const;
+
+ private:
+  void WorkerLoop();
+
+  const Game& game_;
+  std::ofstream csv_;
+  const std::chrono::steady_clock::time_point start_time_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  bool stop_ = false;     // Destructor has run; worker should exit.
+  bool busy_ = false;     // A snapshot is queued or being evaluated.
+  int snapshot_iteration_ = 0;
+  CFRInfoStateValuesTable snapshot_;
+  std::vector<ExploitabilityRecord> records_;
+
+  std::thread worker_;  // Last member: joins before the state above dies.
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXPLOITABILITY_MONITOR_H_
@@ -14,20 +14,55 @@
 
 #include "open_spiel/algorithms/external_sampling_mccfr.h"
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
 #include <numeric>
 #include <random>
+#include <sstream>
+#include <thread>
+#include <utility>
 
 #include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/cfr_checkpoint.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
+#include "open_spiel/thread_affinity.h"
 
 namespace open_spiel {
 namespace algorithms {
+namespace {
+
+// Fixed-width little-endian doubles for the tier records; the values must
+// round-trip bit-exactly so an eviction-and-reload is a no-op.
+void AppendFixedDouble(double value, std::string* buffer) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    buffer->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+double ReadFixedDouble(const uint8_t* data, std::size_t size,
+                       std::size_t* offset) {
+  SPIEL_CHECK_LE(*offset + 8, size);
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; ++i) {
+    bits |= static_cast<uint64_t>(data[*offset + i]) << (8 * i);
+  }
+  *offset += 8;
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
 
 ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
                                                          int seed,
                                                          AverageType avg_type)
     : game_(game.Clone()),
+      history_independent_states_(game.GetType().history_independent_state),
       rng_(new std::mt19937(seed)),
       avg_type_(avg_type),
       dist_(0.0, 1.0),
@@ -36,15 +71,184 @@ ExternalSamplingMCCFRSolver::ExternalSamplingMCCFRSolver(const Game& game,
 
 void ExternalSamplingMCCFRSolver::RunIteration() { RunIteration(rng_.get()); }
 
+void ExternalSamplingMCCFRSolver::SaveCheckpoint(
+    const std::string& filename) const {
+  std::ostringstream rng_state;
+  rng_state << *rng_;
+  SaveCFRCheckpoint(filename, game_->ToString(), /*iteration=*/0,
+                    rng_state.str(), info_states_);
+}
+
+void ExternalSamplingMCCFRSolver::LoadCheckpoint(const std::string& filename) {
+  CFRCheckpoint checkpoint = LoadCFRCheckpoint(filename);
+  if (checkpoint.game_string != game_->ToString()) {
+    SpielFatalError("CFR checkpoint was written for a different game: " +
+                    checkpoint.game_string);
+  }
+  info_states_ = std::move(checkpoint.table);
+  if (!checkpoint.rng_state.empty()) {
+    std::istringstream rng_state(checkpoint.rng_state);
+    rng_state >> *rng_;
+  }
+}
+
+void ExternalSamplingMCCFRSolver::EnableColdEviction(
+    int evict_after_epochs, const std::string& tier_filename) {
+  SPIEL_CHECK_GE(evict_after_epochs, 1);
+  eviction_enabled_ = true;
+  evict_after_epochs_ = evict_after_epochs;
+  tier_filename_ = tier_filename;
+  tier_out_.open(tier_filename, std::ios::binary | std::ios::trunc);
+  if (!tier_out_) {
+    SpielFatalError("Could not open eviction tier file for writing: " +
+                    tier_filename);
+  }
+  tier_out_.flush();
+  tier_in_.open(tier_filename, std::ios::binary);
+  if (!tier_in_) {
+    SpielFatalError("Could not open eviction tier file for reading: " +
+                    tier_filename);
+  }
+  // Entries that predate this call (e.g. from LoadCheckpoint) start their
+  // eviction clock now.
+  for (const auto& entry : info_states_) {
+    last_touched_epoch_[entry.first] = epoch_;
+  }
+}
+
+void ExternalSamplingMCCFRSolver::ReloadEvicted() {
+  for (const auto& entry : tier_index_) {
+    info_states_[entry.first] = ReadTierRecord(entry.first);
+    last_touched_epoch_[entry.first] = epoch_;
+  }
+  tier_index_.clear();
+}
+
+CFRInfoStateValues& ExternalSamplingMCCFRSolver::LookupInfoState(
+    const std::string& is_key, const std::vector<Action>& legal_actions) {
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  if (!eviction_enabled_) {
+    return info_states_
+        .insert(
+            {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)})
+        .first->second;
+  }
+  auto iter = info_states_.find(is_key);
+  if (iter == info_states_.end()) {
+    auto tier_iter = tier_index_.find(is_key);
+    if (tier_iter != tier_index_.end()) {
+      iter = info_states_.insert({is_key, ReadTierRecord(is_key)}).first;
+      // The in-memory copy is authoritative again; the tier record becomes
+      // garbage (a re-eviction appends a fresh one).
+      tier_index_.erase(tier_iter);
+      ++num_reloads_;
+    } else {
+      iter =
+          info_states_
+              .insert(
+                  {is_key,
+                   CFRInfoStateValues(legal_actions, kInitialTableValues)})
+              .first;
+    }
+  }
+  last_touched_epoch_[is_key] = epoch_;
+  return iter->second;
+}
+
+void ExternalSamplingMCCFRSolver::EvictColdInfoStates() {
+  const int64_t cutoff = epoch_ - evict_after_epochs_;
+  bool wrote = false;
+  for (auto iter = info_states_.begin(); iter != info_states_.end();) {
+    auto touched = last_touched_epoch_.find(iter->first);
+    if (touched != last_touched_epoch_.end() && touched->second < cutoff) {
+      WriteTierRecord(iter->first, iter->second);
+      last_touched_epoch_.erase(touched);
+      iter = info_states_.erase(iter);
+      wrote = true;
+    } else {
+      ++iter;
+    }
+  }
+  // One flush per sweep so the read stream below sees the new records.
+  if (wrote) tier_out_.flush();
+}
+
+void ExternalSamplingMCCFRSolver::WriteTierRecord(
+    const std::string& is_key, const CFRInfoStateValues& values) {
+  std::string record;
+  AppendVarint(is_key.size(), &record);
+  record.append(is_key);
+  AppendVarint(values.legal_actions.size(), &record);
+  for (Action action : values.legal_actions) {
+    AppendVarint(action, &record);
+  }
+  for (double regret : values.cumulative_regrets) {
+    AppendFixedDouble(regret, &record);
+  }
+  for (double policy : values.cumulative_policy) {
+    AppendFixedDouble(policy, &record);
+  }
+  tier_out_.write(record.data(), record.size());
+  if (!tier_out_) {
+    SpielFatalError("Could not write to eviction tier file: " +
+                    tier_filename_);
+  }
+  tier_index_[is_key] = {tier_bytes_, static_cast<int64_t>(record.size())};
+  tier_bytes_ += record.size();
+}
+
+CFRInfoStateValues ExternalSamplingMCCFRSolver::ReadTierRecord(
+    const std::string& is_key) {
+  const std::pair<int64_t, int64_t>& location = tier_index_.at(is_key);
+  std::string buffer(location.second, '\0');
+  tier_in_.clear();
+  tier_in_.seekg(location.first);
+  tier_in_.read(&buffer[0], buffer.size());
+  if (!tier_in_) {
+    SpielFatalError("Could not read from eviction tier file: " +
+                    tier_filename_);
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  std::size_t offset = 0;
+  const uint64_t key_length = ReadVarint(data, buffer.size(), &offset);
+  if (key_length != is_key.size() ||
+      buffer.compare(offset, key_length, is_key) != 0) {
+    SpielFatalError("Eviction tier record does not match its index entry.");
+  }
+  offset += key_length;
+  const uint64_t num_actions = ReadVarint(data, buffer.size(), &offset);
+  std::vector<Action> legal_actions(num_actions);
+  for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+    legal_actions[aidx] = ReadVarint(data, buffer.size(), &offset);
+  }
+  CFRInfoStateValues values(legal_actions);
+  for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+    values.cumulative_regrets[aidx] = ReadFixedDouble(data, buffer.size(),
+                                                      &offset);
+  }
+  for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+    values.cumulative_policy[aidx] = ReadFixedDouble(data, buffer.size(),
+                                                     &offset);
+  }
+  SPIEL_CHECK_EQ(offset, buffer.size());
+  return values;
+}
+
 void ExternalSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
+  SPIEL_STATS_INC("mccfr_es/iterations");
   for (int p = 0; p < game_->NumPlayers(); ++p) {
-    UpdateRegrets(*game_->NewInitialState(), p, rng);
+    UpdateRegrets(*NewRootState(), p, rng);
   }
 
   if (avg_type_ == AverageType::kFull) {
     std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
-    FullUpdateAverage(*game_->NewInitialState(), reach_probs);
+    FullUpdateAverage(*NewRootState(), reach_probs);
   }
+
+  ++epoch_;
+  if (eviction_enabled_) EvictColdInfoStates();
+  SPIEL_STATS_SET_GAUGE("mccfr_es/table_size", info_states_.size());
 }
 
 double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
@@ -53,7 +257,7 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   if (state.IsTerminal()) {
     return state.PlayerReturn(player);
   } else if (state.IsChanceNode()) {
-    Action action = SampleChanceOutcome(state.ChanceOutcomes(), dist_(*rng));
+    Action action = state.SampleChanceOutcome(dist_(*rng)).first;
     return UpdateRegrets(*state.Child(action), player, rng);
   } else if (state.IsSimultaneousNode()) {
     SpielFatalError(
@@ -62,15 +266,12 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
   }
 
   int cur_player = state.CurrentPlayer();
-  std::string is_key = state.InformationState(cur_player);
-  std::vector<Action> legal_actions = state.LegalActions();
-
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+  std::string is_key = state.InformationStateKey(cur_player);
+  // All children are visited through Child() clones, so `state` is not
+  // modified while this reference is held.
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
 
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy = LookupInfoState(is_key, legal_actions);
   info_state_copy.ApplyRegretMatching();
 
   double value = 0;
@@ -89,7 +290,8 @@ double ExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
     }
   }
 
-  // Now the regret and avg strategy updates.
+  // Now the regret and avg strategy updates. The entry cannot have been
+  // evicted since the lookup above: eviction only runs between iterations.
   CFRInfoStateValues& info_state = info_states_[is_key];
 
   if (cur_player == player) {
@@ -132,15 +334,10 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   if (sum == 0.0) return;
 
   int cur_player = state.CurrentPlayer();
-  std::string is_key = state.InformationState(cur_player);
-  std::vector<Action> legal_actions = state.LegalActions();
-
-  // The insert here only inserts the default value if the key is not found,
-  // otherwise returns the entry in the map.
-  auto iter_and_result = info_states_.insert(
-      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+  std::string is_key = state.InformationStateKey(cur_player);
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
 
-  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  CFRInfoStateValues info_state_copy = LookupInfoState(is_key, legal_actions);
   info_state_copy.ApplyRegretMatching();
 
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
@@ -149,7 +346,8 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
     FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
   }
 
-  // Now update the cumulative policy.
+  // Now update the cumulative policy. As in UpdateRegrets, the entry cannot
+  // have been evicted while the recursion above ran.
   CFRInfoStateValues& info_state = info_states_[is_key];
   for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
     info_state.cumulative_policy[aidx] +=
@@ -157,5 +355,391 @@ void ExternalSamplingMCCFRSolver::FullUpdateAverage(
   }
 }
 
+ParallelExternalSamplingMCCFRSolver::ParallelExternalSamplingMCCFRSolver(
+    const Game& game, int num_threads, int seed, AverageType avg_type,
+    bool pin_workers)
+    : game_(game.Clone()),
+      history_independent_states_(game.GetType().history_independent_state),
+      num_threads_(num_threads),
+      seed_(seed),
+      avg_type_(avg_type),
+      pin_workers_(pin_workers),
+      uniform_policy_(std::shared_ptr<TabularPolicy>(
+          new TabularPolicy(GetUniformPolicy(game)))) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  shards_.reserve(kNumShards);
+  for (int i = 0; i < kNumShards; ++i) {
+    shards_.emplace_back(new Shard);
+  }
+}
+
+ParallelExternalSamplingMCCFRSolver::Shard&
+ParallelExternalSamplingMCCFRSolver::ShardForKey(const std::string& is_key) {
+  return *shards_[std::hash<std::string>()(is_key) % kNumShards];
+}
+
+void ParallelExternalSamplingMCCFRSolver::RunIterations(int num_iterations) {
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    workers.emplace_back([this, t, num_iterations]() {
+      if (pin_workers_) PinCurrentThreadToCpu(t % NumAvailableCpus());
+      std::seed_seq seq{seed_, t};
+      std::mt19937 rng(seq);
+      for (int iter = t; iter < num_iterations; iter += num_threads_) {
+        SPIEL_STATS_INC("mccfr_es/iterations");
+        for (int p = 0; p < game_->NumPlayers(); ++p) {
+          UpdateRegrets(*NewRootState(), p, &rng);
+        }
+        if (avg_type_ == AverageType::kFull) {
+          std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
+          FullUpdateAverage(*NewRootState(), reach_probs);
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+#ifdef OPEN_SPIEL_ENABLE_STATS
+  // Summing the shard sizes takes every shard lock, so only do it when the
+  // stats build wants the gauge (the workers are all joined, so there is no
+  // contention to speak of).
+  int64_t table_size = 0;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    table_size += shard->table.size();
+  }
+  SPIEL_STATS_SET_GAUGE("mccfr_es/table_size", table_size);
+#endif
+}
+
+void ParallelExternalSamplingMCCFRSolver::RunIterationsDeterministic(
+    int num_iterations) {
+  int done = 0;
+  while (done < num_iterations) {
+    // Rounds are aligned to the global iteration index — round r always
+    // covers iterations [r * kDeterministicRoundSize, (r + 1) *
+    // kDeterministicRoundSize) — so the partition into rounds does not
+    // depend on how the run is split across calls. A call boundary can cut
+    // a round short; round_base_ then carries the start-of-round snapshot
+    // into the next call so the round's remaining iterations still read the
+    // table as it stood when the round began.
+    const int offset = deterministic_iterations_run_ % kDeterministicRoundSize;
+    const int round = std::min(kDeterministicRoundSize - offset,
+                               num_iterations - done);
+    std::vector<Overlay> overlays(round);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads_);
+    for (int t = 0; t < num_threads_; ++t) {
+      workers.emplace_back([this, t, round, &overlays]() {
+        if (pin_workers_) PinCurrentThreadToCpu(t % NumAvailableCpus());
+        for (int i = t; i < round; i += num_threads_) {
+          // Seeded by the global iteration index, not the worker index, so
+          // the sampled trajectories do not depend on num_threads. The
+          // shards are read-only until the workers join.
+          std::seed_seq seq{seed_, deterministic_iterations_run_ + i};
+          std::mt19937 rng(seq);
+          for (int p = 0; p < game_->NumPlayers(); ++p) {
+            UpdateRegretsDeterministic(*NewRootState(), p, &rng, &overlays[i]);
+          }
+          if (avg_type_ == AverageType::kFull) {
+            std::vector<double> reach_probs(game_->NumPlayers(), 1.0);
+            FullUpdateAverageDeterministic(*NewRootState(), reach_probs,
+                                           &overlays[i]);
+          }
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (const Overlay& overlay : overlays) {
+      MergeOverlay(overlay);
+    }
+    deterministic_iterations_run_ += round;
+    done += round;
+    if (deterministic_iterations_run_ % kDeterministicRoundSize == 0) {
+      round_base_.clear();
+    }
+  }
+}
+
+CFRInfoStateValues& ParallelExternalSamplingMCCFRSolver::OverlayEntry(
+    const std::string& is_key, const std::vector<Action>& legal_actions,
+    Overlay* overlay) {
+  auto iter = overlay->find(is_key);
+  if (iter == overlay->end()) {
+    CFRInfoStateValues base(legal_actions, kInitialTableValues);
+    // When a call boundary already merged part of this round, the shard
+    // entry is ahead of the round snapshot; round_base_ holds the
+    // start-of-round value for every key those merges touched.
+    auto base_iter = round_base_.find(is_key);
+    if (base_iter != round_base_.end()) {
+      base = base_iter->second;
+    } else {
+      const CFRInfoStateValuesTable& table = ShardForKey(is_key).table;
+      auto shard_iter = table.find(is_key);
+      if (shard_iter != table.end()) base = shard_iter->second;
+    }
+    iter = overlay->emplace(is_key, std::make_pair(base, base)).first;
+  }
+  return iter->second.first;
+}
+
+void ParallelExternalSamplingMCCFRSolver::MergeOverlay(
+    const Overlay& overlay) {
+  for (const auto& entry : overlay) {
+    const CFRInfoStateValues& working = entry.second.first;
+    const CFRInfoStateValues& base = entry.second.second;
+    // The overlay's base is the start-of-round value (see OverlayEntry);
+    // record it so later iterations of the same round read it even if a
+    // call boundary lands between them and this merge. emplace keeps the
+    // first record when a key recurs across the round's overlays.
+    round_base_.emplace(entry.first, base);
+    // Each key's increments merge independently of every other key, so the
+    // overlay's iteration order does not affect the result; only the
+    // overlay-by-overlay (i.e. iteration) order matters.
+    CFRInfoStateValuesTable& table = ShardForKey(entry.first).table;
+    CFRInfoStateValues& info_state =
+        table.insert({entry.first, base}).first->second;
+    for (int aidx = 0; aidx < working.num_actions(); ++aidx) {
+      info_state.cumulative_regrets[aidx] +=
+          working.cumulative_regrets[aidx] - base.cumulative_regrets[aidx];
+      info_state.cumulative_policy[aidx] +=
+          working.cumulative_policy[aidx] - base.cumulative_policy[aidx];
+    }
+  }
+}
+
+double ParallelExternalSamplingMCCFRSolver::UpdateRegretsDeterministic(
+    const State& state, int player, std::mt19937* rng, Overlay* overlay) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(player);
+  } else if (state.IsChanceNode()) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    Action action = state.SampleChanceOutcome(dist(*rng)).first;
+    return UpdateRegretsDeterministic(*state.Child(action), player, rng,
+                                      overlay);
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  int cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationStateKey(cur_player);
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+
+  CFRInfoStateValues info_state_copy =
+      OverlayEntry(is_key, legal_actions, overlay);
+  info_state_copy.ApplyRegretMatching();
+
+  double value = 0;
+  std::vector<double> child_values(legal_actions.size(), 0);
+
+  if (cur_player != player) {
+    // Sample at opponent nodes.
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    int aidx = info_state_copy.SampleActionIndex(0.0, dist(*rng));
+    value = UpdateRegretsDeterministic(*state.Child(legal_actions[aidx]),
+                                       player, rng, overlay);
+  } else {
+    // Walk over all actions at my nodes
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      child_values[aidx] = UpdateRegretsDeterministic(
+          *state.Child(legal_actions[aidx]), player, rng, overlay);
+      value += info_state_copy.cached_policy[aidx] * child_values[aidx];
+    }
+  }
+
+  // Re-fetch: the recursion may have rehashed the overlay.
+  CFRInfoStateValues& info_state =
+      OverlayEntry(is_key, legal_actions, overlay);
+
+  if (cur_player == player) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_regrets[aidx] += (child_values[aidx] - value);
+    }
+  }
+
+  if (avg_type_ == AverageType::kSimple &&
+      cur_player == ((player + 1) % game_->NumPlayers())) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_policy[aidx] += info_state_copy.cached_policy[aidx];
+    }
+  }
+
+  return value;
+}
+
+void ParallelExternalSamplingMCCFRSolver::FullUpdateAverageDeterministic(
+    const State& state, const std::vector<double>& reach_probs,
+    Overlay* overlay) {
+  if (state.IsTerminal()) {
+    return;
+  } else if (state.IsChanceNode()) {
+    for (Action action : state.LegalActions()) {
+      FullUpdateAverageDeterministic(*state.Child(action), reach_probs,
+                                     overlay);
+    }
+    return;
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  // If all the probs are zero, no need to keep going.
+  double sum = std::accumulate(reach_probs.begin(), reach_probs.end(), 0.0);
+  if (sum == 0.0) return;
+
+  int cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationStateKey(cur_player);
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+
+  CFRInfoStateValues info_state_copy =
+      OverlayEntry(is_key, legal_actions, overlay);
+  info_state_copy.ApplyRegretMatching();
+
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    std::vector<double> new_reach_probs = reach_probs;
+    new_reach_probs[cur_player] *= info_state_copy.cached_policy[aidx];
+    FullUpdateAverageDeterministic(*state.Child(legal_actions[aidx]),
+                                   new_reach_probs, overlay);
+  }
+
+  CFRInfoStateValues& info_state =
+      OverlayEntry(is_key, legal_actions, overlay);
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    info_state.cumulative_policy[aidx] +=
+        (reach_probs[cur_player] * info_state_copy.cached_policy[aidx]);
+  }
+}
+
+std::unique_ptr<Policy> ParallelExternalSamplingMCCFRSolver::AveragePolicy()
+    const {
+  merged_table_.clear();
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    merged_table_.insert(shard->table.begin(), shard->table.end());
+  }
+  return std::unique_ptr<Policy>(
+      new CFRAveragePolicy(merged_table_, uniform_policy_));
+}
+
+double ParallelExternalSamplingMCCFRSolver::UpdateRegrets(const State& state,
+                                                          int player,
+                                                          std::mt19937* rng) {
+  if (state.IsTerminal()) {
+    return state.PlayerReturn(player);
+  } else if (state.IsChanceNode()) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    Action action = state.SampleChanceOutcome(dist(*rng)).first;
+    return UpdateRegrets(*state.Child(action), player, rng);
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  int cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationStateKey(cur_player);
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+  Shard& shard = ShardForKey(is_key);
+
+  // Snapshot the entry under the shard lock, then regret-match on the copy.
+  CFRInfoStateValues info_state_copy;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter_and_result = shard.table.insert(
+        {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+    info_state_copy = iter_and_result.first->second;
+  }
+  info_state_copy.ApplyRegretMatching();
+
+  double value = 0;
+  std::vector<double> child_values(legal_actions.size(), 0);
+
+  if (cur_player != player) {
+    // Sample at opponent nodes.
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    int aidx = info_state_copy.SampleActionIndex(0.0, dist(*rng));
+    value = UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+  } else {
+    // Walk over all actions at my nodes
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      child_values[aidx] =
+          UpdateRegrets(*state.Child(legal_actions[aidx]), player, rng);
+      value += info_state_copy.cached_policy[aidx] * child_values[aidx];
+    }
+  }
+
+  // Now the regret and avg strategy updates, applied under the shard lock.
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  CFRInfoStateValues& info_state = shard.table[is_key];
+
+  if (cur_player == player) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_regrets[aidx] += (child_values[aidx] - value);
+    }
+  }
+
+  if (avg_type_ == AverageType::kSimple &&
+      cur_player == ((player + 1) % game_->NumPlayers())) {
+    for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+      info_state.cumulative_policy[aidx] += info_state_copy.cached_policy[aidx];
+    }
+  }
+
+  return value;
+}
+
+void ParallelExternalSamplingMCCFRSolver::FullUpdateAverage(
+    const State& state, const std::vector<double>& reach_probs) {
+  if (state.IsTerminal()) {
+    return;
+  } else if (state.IsChanceNode()) {
+    for (Action action : state.LegalActions()) {
+      FullUpdateAverage(*state.Child(action), reach_probs);
+    }
+    return;
+  } else if (state.IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  // If all the probs are zero, no need to keep going.
+  double sum = std::accumulate(reach_probs.begin(), reach_probs.end(), 0.0);
+  if (sum == 0.0) return;
+
+  int cur_player = state.CurrentPlayer();
+  std::string is_key = state.InformationStateKey(cur_player);
+  const std::vector<Action>& legal_actions = state.LegalActionsCached();
+  Shard& shard = ShardForKey(is_key);
+
+  CFRInfoStateValues info_state_copy;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter_and_result = shard.table.insert(
+        {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+    info_state_copy = iter_and_result.first->second;
+  }
+  info_state_copy.ApplyRegretMatching();
+
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    std::vector<double> new_reach_probs = reach_probs;
+    new_reach_probs[cur_player] *= info_state_copy.cached_policy[aidx];
+    FullUpdateAverage(*state.Child(legal_actions[aidx]), new_reach_probs);
+  }
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  CFRInfoStateValues& info_state = shard.table[is_key];
+  for (int aidx = 0; aidx < legal_actions.size(); ++aidx) {
+    info_state.cumulative_policy[aidx] +=
+        (reach_probs[cur_player] * info_state_copy.cached_policy[aidx]);
+  }
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
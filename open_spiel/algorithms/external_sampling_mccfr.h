@@ -15,8 +15,14 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_EXTERNAL_SAMPLING_MCCFR_H_
 
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/algorithms/cfr.h"
@@ -79,17 +85,199 @@ class ExternalSamplingMCCFRSolver {
         new CFRAveragePolicy(info_states_, uniform_policy_));
   }
 
+  // Writes the solver state (the cumulative value table and the internal
+  // random number generator) to a binary checkpoint file, and restores it so
+  // a run can be resumed. Loading checks the checkpoint was written for the
+  // same game. See cfr_checkpoint.h for the format.
+  void SaveCheckpoint(const std::string& filename) const;
+  void LoadCheckpoint(const std::string& filename);
+
+  // Reads and replaces the underlying value table. Used by the distribution
+  // layer (see mccfr_distributed.h) to run this solver on table snapshots.
+  const CFRInfoStateValuesTable& InfoStateValuesTable() const {
+    return info_states_;
+  }
+  void SetInfoStateValuesTable(CFRInfoStateValuesTable table) {
+    info_states_ = std::move(table);
+  }
+
+  // Most info states in a sampled run are touched rarely but the table above
+  // only ever grows. After this call, every entry carries the epoch (the
+  // iteration count) it was last touched in, and at the end of each iteration
+  // any entry untouched for evict_after_epochs epochs is appended to the tier
+  // file and dropped from the table, keeping the RAM-resident working set
+  // near the actually-hot info states. A traversal that reaches an evicted
+  // info state reloads it from the tier transparently. Re-evicting an entry
+  // appends a fresh record and orphans the old one, so the tier file can
+  // grow past the live evicted set; the file is recreated by this call and
+  // is not meaningful across runs.
+  //
+  // AveragePolicy, SaveCheckpoint and InfoStateValuesTable only see the
+  // RAM-resident entries; call ReloadEvicted first to pull the evicted
+  // entries back into the table.
+  void EnableColdEviction(int evict_after_epochs,
+                          const std::string& tier_filename);
+
+  // Reloads every evicted info state from the tier file into the table.
+  void ReloadEvicted();
+
+  // The number of info states currently resident only in the tier file, and
+  // the number of reloads the traversals have triggered.
+  int num_evicted_info_states() const { return tier_index_.size(); }
+  int64_t num_tier_reloads() const { return num_reloads_; }
+
  private:
   double UpdateRegrets(const State& state, int player, std::mt19937* rng);
   void FullUpdateAverage(const State& state,
                          const std::vector<double>& reach_probs);
 
+  // Returns the table entry for is_key, inserting the initial values if the
+  // key is new. With eviction enabled, also tags the entry with the current
+  // epoch and reloads it from the tier file if it was evicted.
+  CFRInfoStateValues& LookupInfoState(const std::string& is_key,
+                                      const std::vector<Action>& legal_actions);
+  void EvictColdInfoStates();
+  void WriteTierRecord(const std::string& is_key,
+                       const CFRInfoStateValues& values);
+  CFRInfoStateValues ReadTierRecord(const std::string& is_key);
+
+  // Creates the root state for a sampled traversal. The traversals never
+  // read the history, so tracking is disabled when the game permits it.
+  std::unique_ptr<State> NewRootState() const {
+    std::unique_ptr<State> state = game_->NewInitialState();
+    if (history_independent_states_) state->DisableHistoryTracking();
+    return state;
+  }
+
   std::unique_ptr<Game> game_;
+  bool history_independent_states_;
   std::unique_ptr<std::mt19937> rng_;
   AverageType avg_type_;
   CFRInfoStateValuesTable info_states_;
   std::uniform_real_distribution<double> dist_;
   std::shared_ptr<TabularPolicy> uniform_policy_;
+
+  // Cold-infoset eviction state; see EnableColdEviction.
+  bool eviction_enabled_ = false;
+  int evict_after_epochs_ = 0;
+  int64_t epoch_ = 0;
+  int64_t num_reloads_ = 0;
+  int64_t tier_bytes_ = 0;
+  std::string tier_filename_;
+  std::ofstream tier_out_;
+  std::ifstream tier_in_;
+  std::unordered_map<std::string, int64_t> last_touched_epoch_;
+  // Key -> (offset, length) of the newest tier record holding that key.
+  std::unordered_map<std::string, std::pair<int64_t, int64_t>> tier_index_;
+};
+
+// A multithreaded variant of the solver above. The info state table is
+// sharded by key hash with one mutex per shard, so worker threads running
+// independent sampled traversals only contend when they happen to touch the
+// same shard at the same time. Each worker seeds its own RNG from the solver
+// seed and its worker index, so the set of sampled trajectories is
+// deterministic for a given (seed, num_threads) pair; the interleaving of
+// table updates is not, which is the usual MCCFR trade-off.
+class ParallelExternalSamplingMCCFRSolver {
+ public:
+  static constexpr double kInitialTableValues = 0.000001;
+  static constexpr int kNumShards = 64;
+
+  // With pin_workers set, worker t is pinned to CPU t for the duration of
+  // RunIterations. On multi-socket machines this keeps each worker's table
+  // insertions on its own NUMA node (Linux allocates on first touch), so the
+  // worker's later updates to the entries it sampled into existence stay
+  // node-local instead of crossing sockets; see thread_affinity.h.
+  ParallelExternalSamplingMCCFRSolver(
+      const Game& game, int num_threads, int seed = 0,
+      AverageType avg_type = AverageType::kSimple, bool pin_workers = false);
+
+  // Runs the specified number of external sampling MCCFR iterations, divided
+  // round-robin among the worker threads. Each iteration updates the regrets
+  // and average strategy for all players.
+  void RunIterations(int num_iterations);
+
+  // As RunIterations, but bit-reproducible: a given seed produces the same
+  // table for any num_threads and for any split of the iterations across
+  // calls. Iterations are processed in rounds of kDeterministicRoundSize,
+  // aligned to the global iteration index; within a round every iteration
+  // reads the table as it stood at the start of the round, draws from an
+  // RNG seeded by its global iteration index, and accumulates its updates
+  // in a private overlay, and the overlays merge into the table in
+  // iteration order once the round's workers have joined. The frozen reads
+  // make an iteration's policy up to one round stale — the same staleness the distribution
+  // layer introduces (see mccfr_distributed.h) — and the private overlays
+  // cost roughly 10-20% over RunIterations. Reproducibility assumes all
+  // iterations of the run go through this method.
+  void RunIterationsDeterministic(int num_iterations);
+
+  // Iterations per deterministic round. A constant rather than num_threads
+  // so that the results do not depend on the thread count; threads beyond
+  // the round size sit idle.
+  static constexpr int kDeterministicRoundSize = 16;
+
+  // Computes the average policy, containing the policy for all players.
+  // The returned policy instance should only be used during the lifetime of
+  // the solver object, and not while RunIterations is in progress.
+  std::unique_ptr<Policy> AveragePolicy() const;
+
+ private:
+  // A slice of the info state table, guarded by its own lock.
+  struct Shard {
+    std::mutex mutex;
+    CFRInfoStateValuesTable table;
+  };
+
+  // One deterministic iteration's private view of the table: the working
+  // copy of every entry the traversal has touched, alongside the value it
+  // had at the start of the round so the merge can add just the increments.
+  using Overlay =
+      std::unordered_map<std::string,
+                         std::pair<CFRInfoStateValues, CFRInfoStateValues>>;
+
+  Shard& ShardForKey(const std::string& is_key);
+  double UpdateRegrets(const State& state, int player, std::mt19937* rng);
+  void FullUpdateAverage(const State& state,
+                         const std::vector<double>& reach_probs);
+
+  // The deterministic-mode counterparts of the two methods above; identical
+  // traversals, but reading and writing the iteration's overlay instead of
+  // the shared shards.
+  CFRInfoStateValues& OverlayEntry(const std::string& is_key,
+                                   const std::vector<Action>& legal_actions,
+                                   Overlay* overlay);
+  double UpdateRegretsDeterministic(const State& state, int player,
+                                    std::mt19937* rng, Overlay* overlay);
+  void FullUpdateAverageDeterministic(const State& state,
+                                      const std::vector<double>& reach_probs,
+                                      Overlay* overlay);
+  void MergeOverlay(const Overlay& overlay);
+
+  // See ExternalSamplingMCCFRSolver::NewRootState.
+  std::unique_ptr<State> NewRootState() const {
+    std::unique_ptr<State> state = game_->NewInitialState();
+    if (history_independent_states_) state->DisableHistoryTracking();
+    return state;
+  }
+
+  std::unique_ptr<Game> game_;
+  bool history_independent_states_;
+  const int num_threads_;
+  const int seed_;
+  AverageType avg_type_;
+  const bool pin_workers_;
+  // Global iteration counter for deterministic mode, so successive
+  // RunIterationsDeterministic calls continue the same seed stream.
+  int deterministic_iterations_run_ = 0;
+  // Start-of-round values of the keys merged so far in the current aligned
+  // round, so a round cut short by a call boundary resumes against the same
+  // snapshot; cleared when the round completes. Read-only while workers run.
+  std::unordered_map<std::string, CFRInfoStateValues> round_base_;
+  // unique_ptr because std::mutex makes Shard immovable.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::shared_ptr<TabularPolicy> uniform_policy_;
+  // Merged view of the shards, refreshed by AveragePolicy.
+  mutable CFRInfoStateValuesTable merged_table_;
 };
 
 }  // namespace algorithms
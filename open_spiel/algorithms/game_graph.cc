@@ -0,0 +1,129 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/game_graph.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "open_spiel/algorithms/get_all_states.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+GameGraph CompileGameGraph(const Game& game, int depth_limit,
+                           std::function<std::string(const State&)>
+                               canonical_key) {
+  std::map<std::string, std::unique_ptr<State>> states;
+  if (canonical_key == nullptr) {
+    states = GetAllStates(game, depth_limit, /*include_terminals=*/true,
+                          /*include_chance_states=*/false);
+  } else {
+    // Walk the tree deduplicating by the canonical key, so every state of a
+    // symmetry class collapses onto the first representative reached.
+    std::function<void(const State&, int)> walk = [&](const State& state,
+                                                      int depth) {
+      if (state.IsChanceNode()) {
+        for (const auto& outcome : state.ChanceOutcomes()) {
+          walk(*state.Child(outcome.first), depth + 1);
+        }
+        return;
+      }
+      std::string key = canonical_key(state);
+      if (states.find(key) != states.end()) return;
+      auto iter = states.emplace(std::move(key), state.Clone()).first;
+      if (state.IsTerminal()) return;
+      if (depth_limit >= 0 && depth >= depth_limit) return;
+      for (Action action : iter->second->LegalActions()) {
+        walk(*iter->second->Child(action), depth + 1);
+      }
+    };
+    walk(*game.NewInitialState(), 0);
+  }
+  auto key_of = [&canonical_key](const State& state) {
+    return canonical_key == nullptr ? state.ToString() : canonical_key(state);
+  };
+  GameGraph graph;
+  graph.num_players = game.NumPlayers();
+  graph.id_by_key.reserve(states.size());
+  for (const auto& kv : states) {
+    graph.id_by_key.emplace(kv.first, graph.keys.size());
+    graph.keys.push_back(kv.first);
+  }
+  const int num_enumerated = graph.keys.size();
+
+  // Enumerated attributes are assigned by id below; state_id() appends the
+  // attributes of cut-off successors behind them, in id order. A cut-off
+  // successor behaves as a terminal state with zero returns.
+  graph.is_terminal.resize(num_enumerated);
+  graph.player.resize(num_enumerated);
+  graph.returns.resize(num_enumerated * graph.num_players, 0.0);
+
+  auto state_id = [&graph](const std::string& key) {
+    auto iter = graph.id_by_key.find(key);
+    if (iter != graph.id_by_key.end()) return iter->second;
+    const int id = graph.keys.size();
+    graph.id_by_key.emplace(key, id);
+    graph.keys.push_back(key);
+    graph.is_terminal.push_back(true);
+    graph.player.push_back(kTerminalPlayerId);
+    graph.returns.resize(graph.returns.size() + graph.num_players, 0.0);
+    return id;
+  };
+
+  graph.action_begin.push_back(0);
+  graph.outcome_begin.push_back(0);
+  for (int id = 0; id < num_enumerated; ++id) {
+    const State& state = *states[graph.keys[id]];
+    graph.is_terminal[id] = state.IsTerminal();
+    graph.player[id] = state.CurrentPlayer();
+    if (state.IsTerminal()) {
+      std::vector<double> returns = state.Returns();
+      // A mis-sized Returns() would otherwise read past the end below.
+      SPIEL_CHECK_EQ(returns.size(), graph.num_players);
+      for (int p = 0; p < graph.num_players; ++p) {
+        graph.returns[id * graph.num_players + p] = returns[p];
+      }
+    } else {
+      for (auto action : state.LegalActions()) {
+        graph.action.push_back(action);
+        auto next_state = state.Child(action);
+        if (next_state->IsChanceNode()) {
+          // For a chance node, record the realized successor of each outcome
+          // together with its probability.
+          for (const auto& actionprob : next_state->ChanceOutcomes()) {
+            auto realized_next_state = next_state->Child(actionprob.first);
+            graph.successor.push_back(state_id(key_of(*realized_next_state)));
+            graph.prob.push_back(actionprob.second);
+          }
+        } else {
+          // A non-chance node is equivalent to transition with probability 1.
+          graph.successor.push_back(state_id(key_of(*next_state)));
+          graph.prob.push_back(1.0);
+        }
+        graph.outcome_begin.push_back(graph.successor.size());
+      }
+    }
+    graph.action_begin.push_back(graph.outcome_begin.size() - 1);
+  }
+  // Cut-off successors have no actions.
+  graph.action_begin.resize(graph.keys.size() + 1,
+                            graph.outcome_begin.size() - 1);
+  return graph;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
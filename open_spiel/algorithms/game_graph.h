@@ -0,0 +1,99 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_GRAPH_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_GRAPH_H_
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A dense, immutable successor graph of a game's enumerated state space.
+// States are identified by their ToString() key (as in GetAllStates) and get
+// dense ids in key order; the transition structure is flattened into
+// CSR-style arrays with chance nodes collapsed into outcome distributions.
+// Compiling the graph expands the game tree once; every tabular pass over it
+// afterwards (value iteration, repeated evaluations of the same game) is
+// pure array arithmetic that never touches a State object.
+//
+// Because states are merged by ToString(), the graph represents the game
+// faithfully only where the string identifies the state (perfect-information
+// games); algorithms that need per-history reach probabilities (e.g.
+// TabularBestResponse) must keep walking the tree.
+struct GameGraph {
+  int num_players = 0;
+
+  // Per-state arrays, indexed by id. Successors cut off by the depth limit
+  // appear as terminal states with zero returns and no actions.
+  std::vector<std::string> keys;  // The state string of each id.
+  std::vector<bool> is_terminal;
+  std::vector<int> player;  // Acting player; kTerminalPlayerId at terminals.
+  // Returns of all players, row-major: returns[id * num_players + player].
+  // Zero at non-terminal states.
+  std::vector<double> returns;
+
+  // The action slots of state `id` are [action_begin[id], action_begin[id+1]);
+  // slot `slot` holds legal action `action[slot]`, whose realized outcomes
+  // are the (successor, prob) pairs at
+  // [outcome_begin[slot], outcome_begin[slot+1]). Applying action[slot] leads
+  // to a single successor with probability 1 unless a chance node follows.
+  std::vector<int> action_begin;
+  std::vector<Action> action;
+  std::vector<int> outcome_begin;
+  std::vector<int> successor;
+  std::vector<double> prob;
+
+  int NumStates() const { return keys.size(); }
+
+  // Returns the id of the state with this key, or -1 if it is not in the
+  // graph.
+  int StateId(const std::string& key) const {
+    auto iter = id_by_key.find(key);
+    return iter == id_by_key.end() ? -1 : iter->second;
+  }
+
+  double Return(int id, int player) const {
+    return returns[id * num_players + player];
+  }
+
+  std::unordered_map<std::string, int> id_by_key;
+};
+
+// Compiles the states reachable within depth_limit of the initial state
+// (every state if depth_limit is negative) into a GameGraph. Chance states
+// are collapsed, so ids cover only decision and terminal states.
+// Currently not implemented for simultaneous games.
+//
+// When canonical_key is given it replaces ToString() as the state identity,
+// and all states mapping to the same key are merged onto one representative.
+// Passing a key that canonicalizes board symmetries (State::CanonicalKey,
+// for games whose type sets provides_canonical_key) cuts the state count
+// by nearly the symmetry group's order; this is sound for any tabular pass
+// whose values are invariant under the symmetry. The key must identify the
+// state up to the intended merging: states with equal keys must have
+// equivalent continuations.
+GameGraph CompileGameGraph(
+    const Game& game, int depth_limit = -1,
+    std::function<std::string(const State&)> canonical_key = nullptr);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_GRAPH_H_
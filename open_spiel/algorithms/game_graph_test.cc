@@ -0,0 +1,117 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/game_graph.h"
+
+#include "open_spiel/algorithms/get_all_states.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void GraphMatchesGetAllStatesTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameGraph graph = CompileGameGraph(*game);
+  auto states = GetAllStates(*game, /*depth_limit=*/-1,
+                             /*include_terminals=*/true,
+                             /*include_chance_states=*/false);
+
+  // No chance nodes and no depth limit, so the ids are exactly the
+  // enumerated states, and every state's structure matches the State it was
+  // compiled from.
+  SPIEL_CHECK_EQ(graph.NumStates(), states.size());
+  for (const auto& kv : states) {
+    const int id = graph.StateId(kv.first);
+    SPIEL_CHECK_GE(id, 0);
+    SPIEL_CHECK_EQ(graph.keys[id], kv.first);
+    SPIEL_CHECK_EQ(graph.is_terminal[id], kv.second->IsTerminal());
+    SPIEL_CHECK_EQ(graph.player[id], kv.second->CurrentPlayer());
+    if (kv.second->IsTerminal()) {
+      SPIEL_CHECK_EQ(graph.action_begin[id], graph.action_begin[id + 1]);
+      SPIEL_CHECK_EQ(graph.Return(id, 0), kv.second->PlayerReturn(0));
+      SPIEL_CHECK_EQ(graph.Return(id, 1), kv.second->PlayerReturn(1));
+    } else {
+      std::vector<Action> legal_actions = kv.second->LegalActions();
+      SPIEL_CHECK_EQ(graph.action_begin[id + 1] - graph.action_begin[id],
+                     legal_actions.size());
+      for (int i = 0; i < static_cast<int>(legal_actions.size()); ++i) {
+        const int slot = graph.action_begin[id] + i;
+        SPIEL_CHECK_EQ(graph.action[slot], legal_actions[i]);
+        // Deterministic game: one successor per action, probability 1.
+        SPIEL_CHECK_EQ(graph.outcome_begin[slot + 1] -
+                           graph.outcome_begin[slot],
+                       1);
+        const int o = graph.outcome_begin[slot];
+        SPIEL_CHECK_EQ(graph.prob[o], 1.0);
+        SPIEL_CHECK_EQ(graph.keys[graph.successor[o]],
+                       kv.second->Child(legal_actions[i])->ToString());
+      }
+    }
+  }
+  SPIEL_CHECK_EQ(graph.StateId("not a state"), -1);
+}
+
+void ChanceOutcomesCollapsedTest() {
+  // Pig interleaves decisions with dice rolls; the graph must contain no
+  // chance states, only decision states whose outcome distributions sum
+  // to one.
+  std::unique_ptr<Game> game =
+      LoadGame("pig", {{"winscore", GameParameter(6)},
+                       {"horizon", GameParameter(10)},
+                       {"diceoutcomes", GameParameter(2)}});
+  GameGraph graph = CompileGameGraph(*game);
+  SPIEL_CHECK_EQ(graph.num_players, 2);
+  for (int id = 0; id < graph.NumStates(); ++id) {
+    SPIEL_CHECK_NE(graph.player[id], kChancePlayerId);
+    for (int slot = graph.action_begin[id]; slot < graph.action_begin[id + 1];
+         ++slot) {
+      double total_prob = 0;
+      for (int o = graph.outcome_begin[slot];
+           o < graph.outcome_begin[slot + 1]; ++o) {
+        SPIEL_CHECK_GT(graph.prob[o], 0.0);
+        SPIEL_CHECK_LE(graph.prob[o], 1.0);
+        total_prob += graph.prob[o];
+      }
+      SPIEL_CHECK_FLOAT_EQ(total_prob, 1.0);
+    }
+  }
+}
+
+void DepthLimitCutoffTest() {
+  // With depth limit 0 only the root is expanded; its successors appear as
+  // cut-off states: terminal, zero return, no actions.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameGraph graph = CompileGameGraph(*game, /*depth_limit=*/0);
+  SPIEL_CHECK_EQ(graph.NumStates(), 10);  // The root and its 9 children.
+  const int root = graph.StateId(game->NewInitialState()->ToString());
+  SPIEL_CHECK_FALSE(graph.is_terminal[root]);
+  for (int id = 0; id < graph.NumStates(); ++id) {
+    if (id == root) continue;
+    SPIEL_CHECK_TRUE(graph.is_terminal[id]);
+    SPIEL_CHECK_EQ(graph.Return(id, 0), 0);
+    SPIEL_CHECK_EQ(graph.action_begin[id], graph.action_begin[id + 1]);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::GraphMatchesGetAllStatesTest();
+  open_spiel::algorithms::ChanceOutcomesCollapsedTest();
+  open_spiel::algorithms::DepthLimitCutoffTest();
+}
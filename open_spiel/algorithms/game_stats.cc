@@ -0,0 +1,287 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/game_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Deduplication shards, one lock each, as in get_all_states.cc.
+constexpr int kNumKeyShards = 64;
+
+struct KeyShard {
+  std::mutex mutex;
+  std::unordered_set<std::string> keys;
+};
+
+// Inserts the key into its shard; true if it was not there before.
+bool InsertKey(std::string key, std::vector<KeyShard>* shards) {
+  KeyShard& shard =
+      (*shards)[std::hash<std::string>()(key) % kNumKeyShards];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return shard.keys.insert(std::move(key)).second;
+}
+
+void CountAt(std::vector<uint64_t>* counts, int index) {
+  if (static_cast<int>(counts->size()) <= index) counts->resize(index + 1, 0);
+  ++(*counts)[index];
+}
+
+void MergeInto(const GameStats& from, GameStats* into) {
+  into->num_states += from.num_states;
+  into->num_decision_states += from.num_decision_states;
+  into->num_chance_states += from.num_chance_states;
+  into->num_terminal_states += from.num_terminal_states;
+  for (std::size_t p = 0; p < from.num_infosets.size(); ++p) {
+    into->num_infosets[p] += from.num_infosets[p];
+  }
+  if (into->terminal_depth_counts.size() < from.terminal_depth_counts.size()) {
+    into->terminal_depth_counts.resize(from.terminal_depth_counts.size(), 0);
+  }
+  for (std::size_t d = 0; d < from.terminal_depth_counts.size(); ++d) {
+    into->terminal_depth_counts[d] += from.terminal_depth_counts[d];
+  }
+  if (into->branching_counts.size() < from.branching_counts.size()) {
+    into->branching_counts.resize(from.branching_counts.size(), 0);
+  }
+  for (std::size_t b = 0; b < from.branching_counts.size(); ++b) {
+    into->branching_counts[b] += from.branching_counts[b];
+  }
+  into->max_depth = std::max(into->max_depth, from.max_depth);
+  into->max_branching = std::max(into->max_branching, from.max_branching);
+}
+
+// Shared walk context: the deduplication shards and the per-player infoset
+// shards are shared between workers, the stats are worker-local.
+struct WalkContext {
+  int depth_limit;
+  bool collect_infosets;
+  std::vector<KeyShard> state_shards;
+  std::vector<std::vector<KeyShard>> infoset_shards;  // Per player.
+};
+
+// Counts the state if it has not been visited; true if its children should
+// be walked. Duplicate states prune the subtree: everything below has
+// been counted from the first visit.
+bool VisitState(const State& state, int depth, WalkContext* context,
+                GameStats* stats) {
+  if (!InsertKey(state.ToString(), &context->state_shards)) return false;
+  ++stats->num_states;
+  stats->max_depth = std::max(stats->max_depth, depth);
+  if (state.IsTerminal()) {
+    ++stats->num_terminal_states;
+    CountAt(&stats->terminal_depth_counts, depth);
+    return false;
+  }
+  if (state.IsChanceNode()) {
+    ++stats->num_chance_states;
+  } else {
+    ++stats->num_decision_states;
+    const int branching = state.LegalActions().size();
+    CountAt(&stats->branching_counts, branching);
+    stats->max_branching = std::max(stats->max_branching, branching);
+    if (context->collect_infosets) {
+      const int player = state.CurrentPlayer();
+      if (InsertKey(state.InformationState(player),
+                    &context->infoset_shards[player])) {
+        ++stats->num_infosets[player];
+      }
+    }
+  }
+  return context->depth_limit < 0 || depth < context->depth_limit;
+}
+
+void WalkSubtree(const State& state, int depth, WalkContext* context,
+                 GameStats* stats) {
+  if (!VisitState(state, depth, context, stats)) return;
+  for (Action action : state.LegalActions()) {
+    WalkSubtree(*state.Child(action), depth + 1, context, stats);
+  }
+}
+
+GameStats MakeEmptyStats(const Game& game) {
+  GameStats stats;
+  stats.num_infosets.assign(game.NumPlayers(), 0);
+  return stats;
+}
+
+}  // namespace
+
+double GameStats::AverageBranching() const {
+  uint64_t states = 0;
+  uint64_t actions = 0;
+  for (std::size_t b = 0; b < branching_counts.size(); ++b) {
+    states += branching_counts[b];
+    actions += b * branching_counts[b];
+  }
+  return states == 0 ? 0.0 : static_cast<double>(actions) / states;
+}
+
+std::string GameStats::ToString() const {
+  std::ostringstream out;
+  out << (sampled ? "Sampled visits: " : "Distinct states: ") << num_states
+      << " (" << num_decision_states << " decision, " << num_chance_states
+      << " chance, " << num_terminal_states << " terminal)" << std::endl;
+  out << "Max depth: " << max_depth << ", max branching: " << max_branching
+      << ", average branching: " << AverageBranching() << std::endl;
+  if (!sampled && !num_infosets.empty()) {
+    out << "Infosets per player:";
+    for (uint64_t count : num_infosets) out << " " << count;
+    out << std::endl;
+  }
+  out << "Terminal depth counts:";
+  for (std::size_t d = 0; d < terminal_depth_counts.size(); ++d) {
+    if (terminal_depth_counts[d] > 0) {
+      out << " " << d << ":" << terminal_depth_counts[d];
+    }
+  }
+  out << std::endl;
+  out << "Branching counts:";
+  for (std::size_t b = 0; b < branching_counts.size(); ++b) {
+    if (branching_counts[b] > 0) out << " " << b << ":" << branching_counts[b];
+  }
+  out << std::endl;
+  return out.str();
+}
+
+GameStats AnalyzeGameTree(const Game& game, int depth_limit,
+                          int num_threads) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("AnalyzeGameTree only supports sequential games.");
+  }
+  WalkContext context;
+  context.depth_limit = depth_limit;
+  context.collect_infosets = game.GetType().provides_information_state;
+  context.state_shards = std::vector<KeyShard>(kNumKeyShards);
+  if (context.collect_infosets) {
+    for (int p = 0; p < game.NumPlayers(); ++p) {
+      context.infoset_shards.emplace_back(kNumKeyShards);
+    }
+  }
+  GameStats total = MakeEmptyStats(game);
+  std::unique_ptr<State> root = game.NewInitialState();
+
+  if (num_threads <= 1) {
+    WalkSubtree(*root, 0, &context, &total);
+    return total;
+  }
+
+  // Expand breadth-first until there are enough subtrees to keep the
+  // workers busy, counting the expanded interior states here; the workers
+  // then claim the remaining subtrees through a shared counter.
+  std::deque<std::pair<std::unique_ptr<State>, int>> frontier;
+  frontier.emplace_back(std::move(root), 0);
+  while (!frontier.empty() &&
+         frontier.size() < static_cast<std::size_t>(4 * num_threads)) {
+    std::unique_ptr<State> state = std::move(frontier.front().first);
+    const int depth = frontier.front().second;
+    frontier.pop_front();
+    if (!VisitState(*state, depth, &context, &total)) continue;
+    for (Action action : state->LegalActions()) {
+      frontier.emplace_back(state->Child(action), depth + 1);
+    }
+  }
+
+  std::vector<std::pair<std::unique_ptr<State>, int>> subtrees(
+      std::make_move_iterator(frontier.begin()),
+      std::make_move_iterator(frontier.end()));
+  std::atomic<std::size_t> next_subtree(0);
+  std::mutex merge_mutex;
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    workers.emplace_back([&]() {
+      GameStats local = MakeEmptyStats(game);
+      while (true) {
+        const std::size_t index = next_subtree++;
+        if (index >= subtrees.size()) break;
+        WalkSubtree(*subtrees[index].first, subtrees[index].second, &context,
+                    &local);
+      }
+      std::lock_guard<std::mutex> lock(merge_mutex);
+      MergeInto(local, &total);
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  return total;
+}
+
+GameStats SampleGameStats(const Game& game, int num_playouts, int num_threads,
+                          int seed) {
+  SPIEL_CHECK_GE(num_playouts, 0);
+  GameStats total = MakeEmptyStats(game);
+  total.sampled = true;
+  std::atomic<int> next_playout(0);
+  std::mutex merge_mutex;
+
+  auto run = [&](int thread_index) {
+    FastRng rng(seed + thread_index * 0x9e3779b9u);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    GameStats local = MakeEmptyStats(game);
+    local.sampled = true;
+    while (next_playout++ < num_playouts) {
+      std::unique_ptr<State> state = game.NewInitialState();
+      int depth = 0;
+      while (!state->IsTerminal()) {
+        ++local.num_states;
+        local.max_depth = std::max(local.max_depth, depth);
+        if (state->IsChanceNode()) {
+          ++local.num_chance_states;
+          state->ApplyAction(state->SampleChanceOutcome(uniform(rng)).first);
+        } else {
+          ++local.num_decision_states;
+          std::vector<Action> legal = state->LegalActions();
+          const int branching = legal.size();
+          CountAt(&local.branching_counts, branching);
+          local.max_branching = std::max(local.max_branching, branching);
+          state->ApplyAction(legal[rng() % legal.size()]);
+        }
+        ++depth;
+      }
+      ++local.num_states;
+      ++local.num_terminal_states;
+      local.max_depth = std::max(local.max_depth, depth);
+      CountAt(&local.terminal_depth_counts, depth);
+    }
+    std::lock_guard<std::mutex> lock(merge_mutex);
+    MergeInto(local, &total);
+  };
+
+  if (num_threads <= 1) {
+    run(0);
+    return total;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) workers.emplace_back(run, t);
+  for (std::thread& worker : workers) worker.join();
+  return total;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_STATS_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_STATS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+// Measured game-tree statistics. The declared game metrics (MaxGameLength,
+// NumDistinctActions, NumPlayers) are bounds chosen by the game author and
+// are sometimes wildly conservative; experiments sized from them
+// over-reserve tables or trip rehash storms when the bound is too tight.
+// These passes measure the real numbers: distinct reachable states,
+// information sets per player, the terminal depth histogram and the
+// branching-factor distribution.
+
+namespace open_spiel {
+namespace algorithms {
+
+struct GameStats {
+  // Whether the numbers come from sampled playouts rather than an
+  // exhaustive walk. Sampled counts are per visit, not deduplicated.
+  bool sampled = false;
+
+  uint64_t num_states = 0;  // Decision + chance + terminal.
+  uint64_t num_decision_states = 0;
+  uint64_t num_chance_states = 0;
+  uint64_t num_terminal_states = 0;
+
+  // Distinct information states of each player where that player acts.
+  // Only filled by the exhaustive walk, and only for games providing
+  // information state strings.
+  std::vector<uint64_t> num_infosets;
+
+  // terminal_depth_counts[d] terminals were first reached at depth d
+  // (moves from the root, chance moves included);
+  // branching_counts[b] decision states offered exactly b legal actions.
+  std::vector<uint64_t> terminal_depth_counts;
+  std::vector<uint64_t> branching_counts;
+
+  int max_depth = 0;
+  int max_branching = 0;
+
+  // The mean number of legal actions over the counted decision states.
+  double AverageBranching() const;
+
+  // A multi-line human-readable report.
+  std::string ToString() const;
+};
+
+// Walks every distinct state reachable within depth_limit (all of them if
+// negative), deduplicating by State::ToString as in GetAllStates. With
+// num_threads > 1 the walk splits into a frontier of root subtrees that
+// worker threads claim through a shared counter, deduplicating into
+// sharded hash sets. Exhaustive: use only where the state space fits in
+// memory, and fall back to SampleGameStats elsewhere.
+GameStats AnalyzeGameTree(const Game& game, int depth_limit = -1,
+                          int num_threads = 1);
+
+// The sampling fallback for big games: num_playouts uniformly random
+// playouts (chance sampled from its distribution), counting visited nodes
+// without deduplication. Depth and branching distributions converge
+// quickly; state counts only measure the playout lengths.
+GameStats SampleGameStats(const Game& game, int num_playouts,
+                          int num_threads = 1, int seed = 0);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GAME_STATS_H_
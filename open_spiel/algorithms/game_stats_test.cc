@@ -0,0 +1,127 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/game_stats.h"
+
+#include <memory>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Tic-tac-toe has 5478 distinct states; the histograms must account for
+// every counted state.
+void TicTacToeExhaustiveTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameStats stats = AnalyzeGameTree(*game);
+  SPIEL_CHECK_FALSE(stats.sampled);
+  SPIEL_CHECK_EQ(stats.num_states, 5478);
+  SPIEL_CHECK_EQ(stats.num_states, stats.num_decision_states +
+                                       stats.num_chance_states +
+                                       stats.num_terminal_states);
+  SPIEL_CHECK_EQ(stats.num_chance_states, 0);
+  SPIEL_CHECK_EQ(stats.max_depth, 9);
+  SPIEL_CHECK_EQ(stats.max_branching, 9);
+
+  uint64_t terminals = 0;
+  for (uint64_t count : stats.terminal_depth_counts) terminals += count;
+  SPIEL_CHECK_EQ(terminals, stats.num_terminal_states);
+  uint64_t decisions = 0;
+  for (uint64_t count : stats.branching_counts) decisions += count;
+  SPIEL_CHECK_EQ(decisions, stats.num_decision_states);
+  SPIEL_CHECK_GT(stats.AverageBranching(), 1.0);
+  SPIEL_CHECK_FALSE(stats.ToString().empty());
+}
+
+// The parallel walk must measure the same numbers as the serial one.
+void ParallelMatchesSerialTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameStats serial = AnalyzeGameTree(*game);
+  GameStats parallel = AnalyzeGameTree(*game, /*depth_limit=*/-1,
+                                       /*num_threads=*/4);
+  SPIEL_CHECK_EQ(parallel.num_states, serial.num_states);
+  SPIEL_CHECK_EQ(parallel.num_decision_states, serial.num_decision_states);
+  SPIEL_CHECK_EQ(parallel.num_terminal_states, serial.num_terminal_states);
+  SPIEL_CHECK_EQ(parallel.max_depth, serial.max_depth);
+  SPIEL_CHECK_EQ(parallel.max_branching, serial.max_branching);
+  SPIEL_CHECK_TRUE(parallel.branching_counts == serial.branching_counts);
+}
+
+// Kuhn poker: each player acts in six distinct information sets, and the
+// chance deal is counted separately from the decision states.
+void KuhnInfosetsTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  GameStats stats = AnalyzeGameTree(*game);
+  SPIEL_CHECK_EQ(stats.num_infosets.size(), 2);
+  SPIEL_CHECK_EQ(stats.num_infosets[0], 6);
+  SPIEL_CHECK_EQ(stats.num_infosets[1], 6);
+  SPIEL_CHECK_GT(stats.num_chance_states, 0);
+}
+
+// The preallocation hints a game declares must match the measured counts
+// (and default to -1 where nothing is declared).
+void HintsMatchMeasuredCountsTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  GameStats stats = AnalyzeGameTree(*game);
+  uint64_t total_infosets = 0;
+  for (uint64_t count : stats.num_infosets) total_infosets += count;
+  SPIEL_CHECK_EQ(game->ExpectedNumInfoStates(), total_infosets);
+  SPIEL_CHECK_EQ(game->ExpectedNumHistories(), stats.num_states);
+
+  std::unique_ptr<Game> undeclared = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_EQ(undeclared->ExpectedNumInfoStates(), -1);
+  SPIEL_CHECK_EQ(undeclared->ExpectedNumHistories(), -1);
+}
+
+// The depth limit caps the walk without breaking the accounting.
+void DepthLimitTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameStats shallow = AnalyzeGameTree(*game, /*depth_limit=*/2);
+  SPIEL_CHECK_EQ(shallow.max_depth, 2);
+  // 1 root + 9 depth-1 states + 72 depth-2 states.
+  SPIEL_CHECK_EQ(shallow.num_states, 82);
+  SPIEL_CHECK_EQ(shallow.num_terminal_states, 0);
+}
+
+// Sampling counts one terminal per playout and never exceeds the true
+// maximum depth.
+void SampledPlayoutsTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  constexpr int kPlayouts = 100;
+  GameStats stats = SampleGameStats(*game, kPlayouts, /*num_threads=*/2,
+                                    /*seed=*/17);
+  SPIEL_CHECK_TRUE(stats.sampled);
+  SPIEL_CHECK_EQ(stats.num_terminal_states, kPlayouts);
+  uint64_t terminals = 0;
+  for (uint64_t count : stats.terminal_depth_counts) terminals += count;
+  SPIEL_CHECK_EQ(terminals, kPlayouts);
+  SPIEL_CHECK_LE(stats.max_depth, 9);
+  SPIEL_CHECK_GE(stats.max_depth, 5);  // No game ends before move five.
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TicTacToeExhaustiveTest();
+  open_spiel::algorithms::ParallelMatchesSerialTest();
+  open_spiel::algorithms::KuhnInfosetsTest();
+  open_spiel::algorithms::HintsMatchMeasuredCountsTest();
+  open_spiel::algorithms::DepthLimitTest();
+  open_spiel::algorithms::SampledPlayoutsTest();
+}
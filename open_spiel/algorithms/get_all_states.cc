@@ -14,64 +14,238 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/algorithms/tree_traversal.h"
+
 namespace open_spiel {
 namespace algorithms {
 namespace {
 
-// Walk a subgame and return all states contained in the subgames. This does
-// a recursive tree walk, therefore all valid sequences must have finite number
-// of actions. The state collection is key-indexed by the state's string
-// representation so that duplicates are not added.
+// States are deduplicated into a fixed number of shards, each guarded by its
+// own mutex, so that worker threads walking disjoint subtrees only contend
+// when they hash to the same shard.
+constexpr int kNumStateShards = 64;
+
+struct StateShard {
+  std::mutex mutex;
+  // Maps the state string to a clone of the state, or to nullptr when the
+  // caller only asked for the keys.
+  std::map<std::string, std::unique_ptr<State>> states;
+};
+
+// Tracks the approximate bytes retained by the collection against an
+// optional cap (negative means unlimited). The counter is atomic so workers
+// can account without taking a shared lock.
+struct StateMemoryBudget {
+  std::atomic<int64_t> used{0};
+  int64_t max_bytes = -1;
+};
+
+// Nominal charge for a retained clone beyond its action history; the true
+// size is game-specific and not visible here, so this stands in for the
+// state object itself.
+constexpr int64_t kNominalStateBytes = 128;
+
+// Approximate bytes retained by one new entry: the key's heap storage and
+// the map node, plus — when a clone is kept — the nominal state charge and
+// the clone's action history.
+int64_t ApproxEntryBytes(const std::string& key, bool keep_states,
+                         const State& state) {
+  int64_t bytes =
+      static_cast<int64_t>(key.capacity()) +
+      sizeof(std::pair<const std::string, std::unique_ptr<State>>) +
+      4 * sizeof(void*);
+  if (keep_states) {
+    bytes += kNominalStateBytes +
+             static_cast<int64_t>(state.HistoryView().size()) * sizeof(Action);
+  }
+  return bytes;
+}
+
+// Records the state in its shard if its key is not already present. Clones
+// the state only for a first visit, and only when keep_states is set. On a
+// first visit, also invokes on_state (if set), outside of the shard lock so
+// that slow callbacks do not serialize the workers.
+void VisitState(const State& state, std::vector<StateShard>* shards,
+                bool keep_states, bool use_canonical_keys,
+                const std::function<void(const State&)>& on_state,
+                StateMemoryBudget* budget) {
+  std::string key = use_canonical_keys ? state.CanonicalKey()
+                                       : state.ToString();
+  const int64_t entry_bytes = ApproxEntryBytes(key, keep_states, state);
+  StateShard& shard =
+      (*shards)[std::hash<std::string>()(key) % kNumStateShards];
+  bool inserted = false;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.states.find(key);
+    if (iter == shard.states.end()) {
+      shard.states[std::move(key)] = keep_states ? state.Clone() : nullptr;
+      inserted = true;
+    }
+  }
+  if (!inserted) return;
+  if (budget->max_bytes >= 0 &&
+      budget->used.fetch_add(entry_bytes) + entry_bytes > budget->max_bytes) {
+    SpielFatalError(
+        "State enumeration is over its memory budget. This game's states do "
+        "not fit in the budget; use ForEachState to stream them without "
+        "retaining a collection, or raise the budget.");
+  }
+  if (on_state) {
+    on_state(state);
+  }
+}
+
+// Walk a subgame and record all states contained in the subgames. All valid
+// sequences must have a finite number of actions. The state collection is
+// key-indexed by the state's string representation so that duplicates are not
+// added. The walk is driven by DepthFirstTraversal rather than native
+// recursion, so arbitrarily deep games cannot exhaust the call stack.
 // Requires State::Clone() to be implemented.
 // Use with extreme caution!
 // Currently not implemented for simultaneous games.
-void GetSubgameStates(State* state,
-                      std::map<std::string, std::unique_ptr<State>>* all_states,
-                      int depth_limit, int depth, bool include_terminals,
-                      bool include_chance_states) {
-  if (state->IsTerminal()) {
-    if (include_terminals) {
-      // Include if not already present and then terminate recursion.
-      std::string key = state->ToString();
-      if (all_states->find(key) == all_states->end()) {
-        (*all_states)[key] = state->Clone();
+void GetSubgameStates(std::unique_ptr<State> state,
+                      std::vector<StateShard>* shards, int depth_limit,
+                      int start_depth, bool include_terminals,
+                      bool include_chance_states, bool keep_states,
+                      bool use_canonical_keys,
+                      const std::function<void(const State&)>& on_state,
+                      StateMemoryBudget* budget) {
+  // The subtree root sits start_depth moves into the game, so the traversal's
+  // limit is expressed relative to it. It extends one level past depth_limit
+  // because terminal states just beyond the limit are still included, exactly
+  // as in the recursive walk this replaces.
+  int local_limit = -1;
+  if (depth_limit >= 0) {
+    local_limit = std::max(0, depth_limit - start_depth + 1);
+  }
+  DepthFirstTraversal traversal(std::move(state), local_limit);
+  while (const State* s = traversal.Next()) {
+    if (s->IsTerminal()) {
+      if (include_terminals) {
+        // Include if not already present; the traversal does not descend
+        // below terminal states.
+        VisitState(*s, shards, keep_states, use_canonical_keys, on_state,
+                   budget);
       }
+      continue;
+    }
+    const int depth = start_depth + traversal.depth();
+    if (depth_limit >= 0 && depth > depth_limit) {
+      // Non-terminal state past the limit; the traversal's own limit already
+      // prevents a descent below it.
+      continue;
+    }
+    if (!s->IsChanceNode() || include_chance_states) {
+      // Decision node; add only if not already present.
+      VisitState(*s, shards, keep_states, use_canonical_keys, on_state,
+                 budget);
     }
-    return;
   }
+}
 
-  if (depth_limit >= 0 && depth > depth_limit) {
+// Fills the shards with every state reachable from the root. With
+// num_threads > 1, a breadth-first expansion from the root builds a frontier
+// of independent subtrees; the frontier states are then claimed by worker
+// threads, which walk their subtrees recursively as in the serial case.
+void EnumerateStates(const Game& game, std::vector<StateShard>* shards,
+                     int depth_limit, bool include_terminals,
+                     bool include_chance_states, bool keep_states,
+                     int num_threads, bool use_canonical_keys,
+                     const std::function<void(const State&)>& on_state,
+                     int64_t max_bytes) {
+  StateMemoryBudget budget;
+  budget.max_bytes = max_bytes;
+  std::unique_ptr<State> root = game.NewInitialState();
+
+  if (num_threads <= 1) {
+    GetSubgameStates(std::move(root), shards, depth_limit, 0,
+                     include_terminals, include_chance_states, keep_states,
+                     use_canonical_keys, on_state, &budget);
     return;
   }
 
-  if (!state->IsChanceNode() || include_chance_states) {
-    // Decision node; add only if not already present
-    std::string key = state->ToString();
-    if (all_states->find(key) == all_states->end()) {
-      (*all_states)[key] = state->Clone();
+  // Expand breadth-first until there are enough subtrees to keep the workers
+  // busy. Each expanded interior state is visited here; its children are
+  // pushed with their depth so the workers can resume the depth accounting.
+  std::deque<std::pair<std::unique_ptr<State>, int>> frontier;
+  frontier.emplace_back(std::move(root), 0);
+  while (!frontier.empty() &&
+         frontier.size() < static_cast<std::size_t>(4 * num_threads)) {
+    std::unique_ptr<State> state = std::move(frontier.front().first);
+    int depth = frontier.front().second;
+    frontier.pop_front();
+
+    if (state->IsTerminal()) {
+      if (include_terminals) {
+        VisitState(*state, shards, keep_states, use_canonical_keys, on_state,
+                   &budget);
+      }
+      continue;
+    }
+    if (depth_limit >= 0 && depth > depth_limit) {
+      continue;
+    }
+    if (!state->IsChanceNode() || include_chance_states) {
+      VisitState(*state, shards, keep_states, use_canonical_keys, on_state,
+                 &budget);
+    }
+    for (auto action : state->LegalActions()) {
+      auto next_state = state->Clone();
+      next_state->ApplyAction(action);
+      frontier.emplace_back(std::move(next_state), depth + 1);
     }
   }
 
-  for (auto action : state->LegalActions()) {
-    auto next_state = state->Clone();
-    next_state->ApplyAction(action);
-    GetSubgameStates(next_state.get(), all_states, depth_limit, depth + 1,
-                     include_terminals, include_chance_states);
+  // Workers claim frontier subtrees through a shared counter.
+  std::vector<std::pair<std::unique_ptr<State>, int>> subtrees(
+      std::make_move_iterator(frontier.begin()),
+      std::make_move_iterator(frontier.end()));
+  std::atomic<std::size_t> next_subtree(0);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    workers.emplace_back([&]() {
+      while (true) {
+        std::size_t index = next_subtree++;
+        if (index >= subtrees.size()) return;
+        GetSubgameStates(std::move(subtrees[index].first), shards, depth_limit,
+                         subtrees[index].second, include_terminals,
+                         include_chance_states, keep_states,
+                         use_canonical_keys, on_state, &budget);
+      }
+    });
   }
+  for (auto& worker : workers) worker.join();
 }
 
 }  // namespace
 
 std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
-    bool include_chance_states) {
-  // Get the root state.
-  std::unique_ptr<State> state = game.NewInitialState();
-  std::map<std::string, std::unique_ptr<State>> all_states;
+    bool include_chance_states, int num_threads, bool use_canonical_keys,
+    int64_t max_bytes) {
+  std::vector<StateShard> shards(kNumStateShards);
+  EnumerateStates(game, &shards, depth_limit, include_terminals,
+                  include_chance_states, /*keep_states=*/true, num_threads,
+                  use_canonical_keys, /*on_state=*/nullptr, max_bytes);
 
-  // Then, do a recursive tree walk to fill up the map.
-  GetSubgameStates(state.get(), &all_states, depth_limit, 0, include_terminals,
-                   include_chance_states);
+  // Merge the shards into a single map. No locking is needed here as the
+  // workers have all been joined.
+  std::map<std::string, std::unique_ptr<State>> all_states;
+  for (StateShard& shard : shards) {
+    for (auto& key_and_state : shard.states) {
+      all_states[key_and_state.first] = std::move(key_and_state.second);
+    }
+  }
 
   if (all_states.empty()) {
     SpielFatalError("GetSubgameStates returned 0 states!");
@@ -80,5 +254,38 @@ std::map<std::string, std::unique_ptr<State>> GetAllStates(
   return all_states;
 }
 
+std::unordered_set<std::string> GetAllStateKeys(
+    const Game& game, int depth_limit, bool include_terminals,
+    bool include_chance_states, int num_threads, bool use_canonical_keys,
+    int64_t max_bytes) {
+  std::vector<StateShard> shards(kNumStateShards);
+  EnumerateStates(game, &shards, depth_limit, include_terminals,
+                  include_chance_states, /*keep_states=*/false, num_threads,
+                  use_canonical_keys, /*on_state=*/nullptr, max_bytes);
+
+  std::unordered_set<std::string> all_keys;
+  for (StateShard& shard : shards) {
+    for (auto& key_and_state : shard.states) {
+      all_keys.insert(key_and_state.first);
+    }
+  }
+
+  if (all_keys.empty()) {
+    SpielFatalError("GetSubgameStates returned 0 states!");
+  }
+
+  return all_keys;
+}
+
+void ForEachState(const Game& game, int depth_limit, bool include_terminals,
+                  bool include_chance_states,
+                  const std::function<void(const State&)>& on_state,
+                  int num_threads, bool use_canonical_keys) {
+  std::vector<StateShard> shards(kNumStateShards);
+  EnumerateStates(game, &shards, depth_limit, include_terminals,
+                  include_chance_states, /*keep_states=*/false, num_threads,
+                  use_canonical_keys, on_state, /*max_bytes=*/-1);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
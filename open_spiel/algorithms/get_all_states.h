@@ -15,7 +15,11 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_GET_ALL_STATES_H_
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_set>
 
 #include "open_spiel/spiel.h"
 
@@ -33,11 +37,49 @@ namespace algorithms {
 //
 // Currently only works for sequential games.
 //
+// With num_threads > 1 the walk is split among worker threads at a frontier
+// of subtrees near the root, deduplicating into a sharded hash table with
+// one lock per shard.
+//
 // Note: negative depth limit means no limit, 0 means only root, etc..
+//
+// With use_canonical_keys, states are indexed and deduplicated by
+// State::CanonicalKey() instead of ToString(), so all states of a symmetry
+// class collapse onto one entry; only useful for games whose type sets
+// provides_canonical_key.
+//
+// A non-negative max_bytes caps the approximate bytes retained by the
+// collection (keys, map nodes and — for GetAllStates — an estimate per kept
+// clone). When a game turns out not to fit, the enumeration stops with
+// SpielFatalError as soon as the cap is hit instead of running into the
+// OOM-killer; the error suggests ForEachState, which streams the states
+// without retaining them. The estimate is a lower bound, so leave some
+// headroom below the actual memory limit.
 
 std::map<std::string, std::unique_ptr<State>> GetAllStates(
     const Game& game, int depth_limit, bool include_terminals,
-    bool include_chance_states);
+    bool include_chance_states, int num_threads = 1,
+    bool use_canonical_keys = false, int64_t max_bytes = -1);
+
+// Same traversal, but only collects the set of unique state strings, for
+// callers that need deduplication or counting and not the state objects
+// themselves; this avoids retaining a clone per state.
+std::unordered_set<std::string> GetAllStateKeys(
+    const Game& game, int depth_limit, bool include_terminals,
+    bool include_chance_states, int num_threads = 1,
+    bool use_canonical_keys = false, int64_t max_bytes = -1);
+
+// Streaming variant: invokes `on_state` exactly once per unique state during
+// the traversal, without retaining a clone per state. Only the deduplication
+// keys stay in memory, so this handles games whose states do not all fit in
+// RAM; callers that need the states later can write state.Serialize() to disk
+// from the callback. The state passed to the callback is only valid for the
+// duration of the call. With num_threads > 1, the callback is invoked
+// concurrently from the worker threads and must be thread-safe.
+void ForEachState(const Game& game, int depth_limit, bool include_terminals,
+                  bool include_chance_states,
+                  const std::function<void(const State&)>& on_state,
+                  int num_threads = 1, bool use_canonical_keys = false);
 
 }  // namespace algorithms
 }  // namespace open_spiel
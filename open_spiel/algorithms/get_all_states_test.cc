@@ -14,6 +14,8 @@
 
 #include "open_spiel/algorithms/get_all_states.h"
 
+#include <atomic>
+
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -25,4 +27,45 @@ int main(int argc, char **argv) {
   auto states = algorithms::GetAllStates(game, -1, /*include_terminals=*/true,
                                          /*include_chance_states=*/true);
   SPIEL_CHECK_EQ(states.size(), ttt::kNumberStates);
+
+  // The parallel traversal must find exactly the same states.
+  auto parallel_states = algorithms::GetAllStates(
+      game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/4);
+  SPIEL_CHECK_EQ(parallel_states.size(), states.size());
+  for (const auto& key_and_state : states) {
+    SPIEL_CHECK_TRUE(parallel_states.find(key_and_state.first) !=
+                     parallel_states.end());
+  }
+
+  // The keys-only variant returns the same set without retaining clones.
+  auto keys = algorithms::GetAllStateKeys(game, -1, /*include_terminals=*/true,
+                                          /*include_chance_states=*/true,
+                                          /*num_threads=*/4);
+  SPIEL_CHECK_EQ(keys.size(), states.size());
+
+  // Canonical keys collapse the 8 board symmetries into one entry each.
+  auto canonical_keys = algorithms::GetAllStateKeys(
+      game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/1, /*use_canonical_keys=*/true);
+  SPIEL_CHECK_LT(canonical_keys.size(), keys.size());
+  SPIEL_CHECK_GT(canonical_keys.size(), keys.size() / 8);
+
+  // A generous memory budget leaves the enumeration unaffected. (A budget
+  // that is hit stops with SpielFatalError, which cannot be exercised here.)
+  auto budgeted_states = algorithms::GetAllStates(
+      game, -1, /*include_terminals=*/true, /*include_chance_states=*/true,
+      /*num_threads=*/1, /*use_canonical_keys=*/false,
+      /*max_bytes=*/int64_t{1} << 30);
+  SPIEL_CHECK_EQ(budgeted_states.size(), states.size());
+
+  // The streaming variant visits each unique state exactly once.
+  std::atomic<int> num_visited(0);
+  algorithms::ForEachState(game, -1, /*include_terminals=*/true,
+                           /*include_chance_states=*/true,
+                           [&num_visited](const open_spiel::State& state) {
+                             ++num_visited;
+                           },
+                           /*num_threads=*/4);
+  SPIEL_CHECK_EQ(num_visited.load(), ttt::kNumberStates);
 }
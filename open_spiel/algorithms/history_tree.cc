@@ -14,8 +14,12 @@
 
 #include "open_spiel/algorithms/history_tree.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <thread>
 #include <unordered_set>
 
 #include "open_spiel/spiel.h"
@@ -23,60 +27,6 @@
 
 namespace open_spiel {
 namespace algorithms {
-namespace {
-
-std::unique_ptr<HistoryNode> RecursivelyBuildGameTree(
-    std::unique_ptr<State> state, int player_id,
-    std::unordered_map<std::string, HistoryNode*>* state_to_node) {
-  std::unique_ptr<HistoryNode> node(
-      new HistoryNode(player_id, std::move(state)));
-  if (state_to_node == nullptr) SpielFatalError("state_to_node is null.");
-  (*state_to_node)[node->GetHistory()] = node.get();
-  State* state_ptr = node->GetState();
-  switch (node->GetType()) {
-    case StateType::kChance: {
-      double probability_sum = 0;
-      for (const auto& outcome_and_prob : state_ptr->ChanceOutcomes()) {
-        Action outcome = outcome_and_prob.first;
-        double prob = outcome_and_prob.second;
-        std::unique_ptr<State> child = state_ptr->Child(outcome);
-        if (child == nullptr) {
-          SpielFatalError("Can't add child; child is null.");
-        }
-        probability_sum += prob;
-        std::unique_ptr<HistoryNode> child_node = RecursivelyBuildGameTree(
-            std::move(child), player_id, state_to_node);
-        node->AddChild(outcome, {prob, std::move(child_node)});
-      }
-      SPIEL_CHECK_FLOAT_EQ(probability_sum, 1.0);
-      break;
-    }
-    case StateType::kDecision: {
-      for (const auto& legal_action : state_ptr->LegalActions()) {
-        std::unique_ptr<State> child = state_ptr->Child(legal_action);
-
-        // Note: The probabilities here are meaningless if state.CurrentPlayer()
-        // != player_id, as we'll be getting the probabilities from the policy
-        // during the call to Value. For state.CurrentPlayer() == player_id,
-        // the probabilities are equal to 1. for every action as these are
-        // *counter-factual* probabilities, which ignore the probability of
-        // the player that we are playing as.
-        node->AddChild(legal_action,
-                       {1., RecursivelyBuildGameTree(
-                                std::move(child), player_id, state_to_node)});
-      }
-      break;
-    }
-    case StateType::kTerminal: {
-      // As we assign terminal utilities to node.value in the constructor of
-      // HistoryNode, we don't have anything to do here.
-      break;
-    }
-  }
-  return node;
-}
-
-}  // namespace
 
 HistoryNode::HistoryNode(int player_id, std::unique_ptr<State> game_state)
     : state_(std::move(game_state)),
@@ -85,50 +35,61 @@ HistoryNode::HistoryNode(int player_id, std::unique_ptr<State> game_state)
   // Unless it's the opposing player's turn, we always view the game from the
   // view of player player_id.
   if (type_ == StateType::kDecision && state_->CurrentPlayer() != player_id) {
-    infostate_ = state_->InformationState();
+    infostate_ = state_->InformationStateKey();
   } else {
-    infostate_ = state_->InformationState(player_id);
+    infostate_ = state_->InformationStateKey(player_id);
   }
-  // Compute & store the legal actions so we can check that all actions we're
-  // adding are legal.
-  for (Action action : state_->LegalActions()) legal_actions_.insert(action);
+  // Compute & store the legal actions (sorted) so we can check that all
+  // actions we're adding are legal.
+  legal_actions_ = state_->LegalActions();
+  std::sort(legal_actions_.begin(), legal_actions_.end());
   if (type_ == StateType::kTerminal) {
     value_ = state_->PlayerReturn(player_id);
   }
 }
 
-void HistoryNode::AddChild(
-    Action outcome, std::pair<double, std::unique_ptr<HistoryNode>> child) {
-  if (!legal_actions_.count(outcome)) SpielFatalError("Child is not legal.");
-  if (child.second == nullptr) {
-    SpielFatalError("Error inserting child; child is null.");
+void HistoryNode::AddChild(Action outcome, std::pair<double, int> child) {
+  if (!std::binary_search(legal_actions_.begin(), legal_actions_.end(),
+                          outcome)) {
+    SpielFatalError("Child is not legal.");
+  }
+  if (child.second < 0) {
+    SpielFatalError("Error inserting child; child id is negative.");
   }
   if (child.first < 0. || child.first > 1.) {
     SpielFatalError(absl::StrCat(
         "AddChild error: Probability for child must be in [0, 1], not: ",
         child.first));
   }
-  child_info_[outcome] = std::move(child);
+  // Keep child_info_ sorted by action; children usually arrive in increasing
+  // action order, making this a push_back in the common case.
+  auto it = std::lower_bound(
+      child_info_.begin(), child_info_.end(), outcome,
+      [](const std::pair<Action, std::pair<double, int>>& entry,
+         Action action) { return entry.first < action; });
+  if (it != child_info_.end() && it->first == outcome) {
+    it->second = child;
+  } else {
+    child_info_.insert(it, {outcome, child});
+  }
   if (child_info_.size() > legal_actions_.size()) {
     SpielFatalError("More children than legal actions.");
   }
 }
 
-std::pair<double, HistoryNode*> HistoryNode::GetChild(Action outcome) {
-  auto it = child_info_.find(outcome);
-  if (it == child_info_.end()) {
+std::pair<double, int> HistoryNode::GetChild(Action outcome) {
+  auto it = std::lower_bound(
+      child_info_.begin(), child_info_.end(), outcome,
+      [](const std::pair<Action, std::pair<double, int>>& entry,
+         Action action) { return entry.first < action; });
+  if (it == child_info_.end() || it->first != outcome) {
     SpielFatalError("Error getting child; action not found.");
   }
   // it->second.first is the probability associated with outcome, so as it is a
   // probability, it must be in [0, 1].
   SPIEL_CHECK_GE(it->second.first, 0.);
   SPIEL_CHECK_LE(it->second.first, 1.);
-  std::pair<double, HistoryNode*> child =
-      std::make_pair(it->second.first, it->second.second.get());
-  if (child.second == nullptr) {
-    SpielFatalError("Error getting child; child is null.");
-  }
-  return child;
+  return it->second;
 }
 
 std::vector<Action> HistoryNode::GetChildActions() const {
@@ -139,11 +100,13 @@ std::vector<Action> HistoryNode::GetChildActions() const {
 }
 
 HistoryNode* HistoryTree::GetByHistory(const std::string& history) {
-  HistoryNode* node = state_to_node_[history];
-  if (node == nullptr) {
-    SpielFatalError(absl::StrCat("Node is null for history: '", history, "'"));
+  // Pure lookup (no insertion on a miss), so that concurrent readers of a
+  // fully-built tree do not mutate the map.
+  auto it = state_to_node_.find(history);
+  if (it == state_to_node_.end()) {
+    SpielFatalError(absl::StrCat("No node for history: '", history, "'"));
   }
-  return node;
+  return &nodes_[it->second];
 }
 
 std::vector<std::string> HistoryTree::GetHistories() {
@@ -155,10 +118,88 @@ std::vector<std::string> HistoryTree::GetHistories() {
   return histories;
 }
 
+int HistoryTree::BuildGameTree(std::unique_ptr<State> state, int player_id) {
+  // The build is driven by an explicit frame stack rather than native
+  // recursion: histories can run deeper than the call stack is tall. Both the
+  // node pool and the frame stack relocate as they grow, so frames address
+  // nodes by id and the loop addresses frames by index, never by reference
+  // held across a push.
+  struct Frame {
+    int id;
+    // Children still to build, as (action, probability) pairs: the chance
+    // outcomes at chance nodes, and (legal action, 1.) at decision nodes.
+    //
+    // Note: The probabilities are meaningless at decision nodes where
+    // state.CurrentPlayer() != player_id, as we'll be getting the
+    // probabilities from the policy during the call to Value. For
+    // state.CurrentPlayer() == player_id, the probabilities are equal to 1.
+    // for every action as these are *counter-factual* probabilities, which
+    // ignore the probability of the player that we are playing as.
+    ActionsAndProbs outcomes;
+    std::size_t next = 0;
+    double probability_sum = 0;
+    bool is_chance = false;
+  };
+
+  // Allocates a pool node for the state and prepares its frame.
+  auto make_frame = [this, player_id](std::unique_ptr<State> s) {
+    Frame frame;
+    frame.id = nodes_.size();
+    nodes_.emplace_back(player_id, std::move(s));
+    state_to_node_[nodes_[frame.id].GetHistory()] = frame.id;
+    State* state_ptr = nodes_[frame.id].GetState();
+    switch (nodes_[frame.id].GetType()) {
+      case StateType::kChance: {
+        frame.is_chance = true;
+        frame.outcomes = state_ptr->ChanceOutcomes();
+        break;
+      }
+      case StateType::kDecision: {
+        for (const auto& legal_action : state_ptr->LegalActions()) {
+          frame.outcomes.push_back({legal_action, 1.});
+        }
+        break;
+      }
+      case StateType::kTerminal: {
+        // As we assign terminal utilities to node.value in the constructor
+        // of HistoryNode, terminal frames have no children to build.
+        break;
+      }
+    }
+    return frame;
+  };
+
+  const int root_id = nodes_.size();
+  std::vector<Frame> stack;
+  stack.push_back(make_frame(std::move(state)));
+  while (!stack.empty()) {
+    const std::size_t top = stack.size() - 1;
+    if (stack[top].next == stack[top].outcomes.size()) {
+      if (stack[top].is_chance) {
+        SPIEL_CHECK_FLOAT_EQ(stack[top].probability_sum, 1.0);
+      }
+      stack.pop_back();
+      continue;
+    }
+    const Action outcome = stack[top].outcomes[stack[top].next].first;
+    const double prob = stack[top].outcomes[stack[top].next].second;
+    ++stack[top].next;
+    std::unique_ptr<State> child =
+        nodes_[stack[top].id].GetState()->Child(outcome);
+    if (child == nullptr) {
+      SpielFatalError("Can't add child; child is null.");
+    }
+    stack[top].probability_sum += prob;
+    Frame child_frame = make_frame(std::move(child));
+    nodes_[stack[top].id].AddChild(outcome, {prob, child_frame.id});
+    stack.push_back(std::move(child_frame));
+  }
+  return root_id;
+}
+
 // Builds game tree consisting of all decision nodes for player_id.
 HistoryTree::HistoryTree(std::unique_ptr<State> state, int player_id) {
-  root_ =
-      RecursivelyBuildGameTree(std::move(state), player_id, &state_to_node_);
+  root_id_ = BuildGameTree(std::move(state), player_id);
 }
 
 ActionsAndProbs GetSuccessorsWithProbs(const State& state,
@@ -177,9 +218,9 @@ ActionsAndProbs GetSuccessorsWithProbs(const State& state,
   } else {
     // Finally, we look at the policy we are finding a best response to, and
     // get our probabilities from there.
-    auto state_policy = policy->GetStatePolicy(state.InformationState());
+    auto state_policy = policy->GetStatePolicy(state.InformationStateKey());
     if (state_policy.empty()) {
-      SpielFatalError(state.InformationState() + " not found in policy.");
+      SpielFatalError(state.InformationStateKey() + " not found in policy.");
     }
     return state_policy;
   }
@@ -236,7 +277,7 @@ GetAllInfoSets(std::unique_ptr<State> state, int best_responder_id,
   for (const auto& state_and_prob : states_and_probs) {
     // We look at each decision from the perspective of the best_responder.
     std::string infostate =
-        state_and_prob.first->InformationState(best_responder_id);
+        state_and_prob.first->InformationStateKey(best_responder_id);
     infosets[infostate].push_back(
         {tree->GetByHistory(state_and_prob.first->ToString()),
          state_and_prob.second});
@@ -244,5 +285,115 @@ GetAllInfoSets(std::unique_ptr<State> state, int best_responder_id,
   return infosets;
 }
 
+namespace {
+
+// One best-responder decision node found during the tree walk: its infostate
+// key, the node, and the counter-factual probability of reaching it.
+struct InfoSetEntry {
+  std::string key;
+  HistoryNode* node;
+  double prob;
+};
+
+// Walks the subtree below node, accumulating the product of the chance and
+// opponent probabilities along the path (the best responder's own actions
+// count as probability one), and emits a flat entry for every best-responder
+// decision node. Grouping the entries by key is left to the caller, which is
+// what lets the aggregation run in parallel.
+void CollectInfoSetEntries(HistoryTree* tree, HistoryNode* node,
+                           int best_responder_id, const Policy* policy,
+                           double prob, std::vector<InfoSetEntry>* entries) {
+  if (node->GetType() == StateType::kTerminal) return;
+  State* state = node->GetState();
+  if (state->CurrentPlayer() == best_responder_id) {
+    entries->push_back(
+        {state->InformationStateKey(best_responder_id), node, prob});
+  }
+  ActionsAndProbs actions_and_probs =
+      GetSuccessorsWithProbs(*state, best_responder_id, policy);
+  for (Action action : node->GetChildActions()) {
+    const double action_prob = GetProb(actions_and_probs, action);
+    SPIEL_CHECK_GE(action_prob, 0);
+    CollectInfoSetEntries(tree, tree->GetNode(node->GetChild(action).second),
+                          best_responder_id, policy, prob * action_prob,
+                          entries);
+  }
+}
+
+}  // namespace
+
+std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
+GetAllInfoSetsFromTree(HistoryTree* tree, int best_responder_id,
+                       const Policy* policy, int num_threads) {
+  std::vector<InfoSetEntry> entries;
+  CollectInfoSetEntries(tree, tree->Root(), best_responder_id, policy,
+                        /*prob=*/1.0, &entries);
+
+  std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
+      infosets;
+  const int num_buckets =
+      std::min(num_threads, static_cast<int>(entries.size()));
+  if (num_buckets <= 1) {
+    infosets.reserve(entries.size());
+    for (InfoSetEntry& entry : entries) {
+      infosets[std::move(entry.key)].push_back({entry.node, entry.prob});
+    }
+    return infosets;
+  }
+
+  // Bucket each entry by a hash of its key, hashing each key exactly once,
+  // with the entries split into contiguous ranges across the workers.
+  std::vector<uint32_t> bucket_of(entries.size());
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(num_buckets);
+    for (int t = 0; t < num_buckets; ++t) {
+      workers.emplace_back([t, num_buckets, &entries, &bucket_of]() {
+        const std::hash<std::string> hasher;
+        const std::size_t begin = t * entries.size() / num_buckets;
+        const std::size_t end = (t + 1) * entries.size() / num_buckets;
+        for (std::size_t i = begin; i < end; ++i) {
+          bucket_of[i] = hasher(entries[i].key) % num_buckets;
+        }
+      });
+    }
+    for (auto& worker : workers) worker.join();
+  }
+
+  // Each worker owns one bucket and aggregates that bucket's entries into a
+  // private shard. The buckets partition the key space, so no two workers
+  // ever touch the same infoset and the shards need no locking.
+  std::vector<
+      std::unordered_map<std::string,
+                         std::vector<std::pair<HistoryNode*, double>>>>
+      shards(num_buckets);
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(num_buckets);
+    for (int t = 0; t < num_buckets; ++t) {
+      workers.emplace_back([t, &entries, &bucket_of, &shards]() {
+        auto& shard = shards[t];
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+          if (bucket_of[i] != static_cast<uint32_t>(t)) continue;
+          shard[std::move(entries[i].key)].push_back(
+              {entries[i].node, entries[i].prob});
+        }
+      });
+    }
+    for (auto& worker : workers) worker.join();
+  }
+
+  // Merge the disjoint shards into the result map.
+  std::size_t num_keys = 0;
+  for (const auto& shard : shards) num_keys += shard.size();
+  infosets.reserve(num_keys);
+  for (auto& shard : shards) {
+    for (auto& kv : shard) {
+      infosets.emplace(kv.first, std::move(kv.second));
+    }
+  }
+  return infosets;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -19,6 +19,8 @@
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
@@ -46,12 +48,15 @@ class HistoryNode {
 
   Action NumChildren() const { return child_info_.size(); }
 
-  void AddChild(Action outcome,
-                std::pair<double, std::unique_ptr<HistoryNode>> child);
+  // Children are identified by their id in the enclosing HistoryTree's node
+  // pool (see HistoryTree::GetNode), not by pointer: the pool is a vector
+  // that relocates as it grows during the build, and ids also survive moving
+  // the tree. Only the (probability, id) pair is stored here.
+  void AddChild(Action outcome, std::pair<double, int> child);
 
   std::vector<Action> GetChildActions() const;
 
-  std::pair<double, HistoryNode*> GetChild(Action outcome);
+  std::pair<double, int> GetChild(Action outcome);
 
  private:
   std::unique_ptr<State> state_;
@@ -60,10 +65,15 @@ class HistoryNode {
   StateType type_;
   double value_;
 
-  // Map from legal actions to transition probabilities. Uses a map as we need
-  // to preserve the order of the actions.
-  std::unordered_set<Action> legal_actions_;
-  std::map<Action, std::pair<double, std::unique_ptr<HistoryNode>>> child_info_;
+  // Legal actions, sorted, so that the legality check in AddChild is a
+  // binary search.
+  std::vector<Action> legal_actions_;
+
+  // Children as (action, (probability, node id)) entries, kept sorted by
+  // action. A sorted flat vector preserves the action ordering the std::map
+  // used to provide while making lookup a binary search and iteration
+  // cache-linear.
+  std::vector<std::pair<Action, std::pair<double, int>>> child_info_;
 };
 
 // History here refers to the fact that we're using histories- i.e.
@@ -79,7 +89,13 @@ class HistoryTree {
   // viewed from the perspective of the player making the decision.
   HistoryTree(std::unique_ptr<State> state, int player_id);
 
-  HistoryNode* Root() { return root_.get(); }
+  HistoryNode* Root() { return &nodes_[root_id_]; }
+
+  // Resolves a node id (as stored in HistoryNode child entries) against the
+  // pool. Ids are assigned in depth-first creation order, so resolving the
+  // children of a node during a tree walk touches a nearby stretch of the
+  // pool rather than scattered heap allocations.
+  HistoryNode* GetNode(int node_id) { return &nodes_[node_id]; }
 
   HistoryNode* GetByHistory(const std::string& history);
 
@@ -89,10 +105,21 @@ class HistoryTree {
   Action NumHistories() { return state_to_node_.size(); }
 
  private:
-  std::unique_ptr<HistoryNode> root_;
+  // Allocates a node in the pool for the given state, builds the subtree
+  // below it (iteratively, with an explicit frame stack), and returns the
+  // node's id.
+  int BuildGameTree(std::unique_ptr<State> state, int player_id);
+
+  // Contiguous pool owning every node in the tree, in depth-first creation
+  // order. The pool relocates while it grows, which is why nodes link to
+  // their children by id rather than by pointer; pointers handed out by
+  // Root/GetNode/GetByHistory are stable once the tree is built.
+  std::vector<HistoryNode> nodes_;
 
-  // Maps histories to HistoryNodes.
-  std::unordered_map<std::string, HistoryNode*> state_to_node_;
+  int root_id_ = -1;
+
+  // Maps histories to node ids in the pool.
+  std::unordered_map<std::string, int> state_to_node_;
 };
 
 // Returns a map of infostate strings to a vector of history nodes with
@@ -106,6 +133,20 @@ std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
 GetAllInfoSets(std::unique_ptr<State> state, int best_responder_id,
                const Policy* policy, HistoryTree* tree);
 
+// As GetAllInfoSets, but computes the counter-factual probabilities in a
+// single pass over an already-built tree, without re-walking the game or
+// cloning any states. Use this when only the policy has changed since the
+// tree was built.
+// With num_threads > 1, the grouping is restructured as a bucket sort: the
+// tree walk emits flat (key, history, probability) entries, the keys are
+// hashed in parallel, and each worker aggregates the entries whose hash
+// lands in its bucket into a private map. Buckets partition the key space,
+// so no two workers ever touch the same infoset, and the merged result is
+// identical to the single-threaded build.
+std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
+GetAllInfoSetsFromTree(HistoryTree* tree, int best_responder_id,
+                       const Policy* policy, int num_threads = 1);
+
 // For a given state, returns all successor states with accompanying
 // counter-factual probabilities.
 ActionsAndProbs GetSuccessorsWithProbs(const State& state,
@@ -446,6 +446,37 @@ void TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid1() {
                            /*best_responder_id=*/1);
 }
 
+// Verifies that the parallel bucketed grouping in GetAllInfoSetsFromTree
+// produces exactly the map the single-threaded build produces.
+void TestParallelGetAllInfoSetsFromTreeMatchesSequential() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  for (const auto& best_responder_id : {0, 1}) {
+    HistoryTree tree(game->NewInitialState(), best_responder_id);
+    auto sequential = GetAllInfoSetsFromTree(&tree, best_responder_id, &policy,
+                                             /*num_threads=*/1);
+    for (int num_threads : {2, 4}) {
+      auto parallel = GetAllInfoSetsFromTree(&tree, best_responder_id, &policy,
+                                             num_threads);
+      SPIEL_CHECK_EQ(parallel.size(), sequential.size());
+      for (const auto& kv : sequential) {
+        auto it = parallel.find(kv.first);
+        if (it == parallel.end()) {
+          SpielFatalError(absl::StrCat("Infoset ", kv.first,
+                                       " missing from parallel build."));
+        }
+        // The entries within an infoset come from the same depth-first walk
+        // in both builds, so the order must match too.
+        SPIEL_CHECK_EQ(it->second.size(), kv.second.size());
+        for (std::size_t i = 0; i < kv.second.size(); ++i) {
+          SPIEL_CHECK_TRUE(it->second[i].first == kv.second[i].first);
+          SPIEL_CHECK_EQ(it->second[i].second, kv.second[i].second);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -467,4 +498,6 @@ int main(int argc, char** argv) {
       TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid0();
   open_spiel::algorithms::
       TestGetAllInfoSetsHasRightCounterFactualProbsOptimalPid1();
+  open_spiel::algorithms::
+      TestParallelGetAllInfoSetsFromTreeMatchesSequential();
 }
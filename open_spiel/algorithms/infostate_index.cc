@@ -0,0 +1,207 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/infostate_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "open_spiel/algorithms/get_all_states.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kIndexMagic = 0x5849534f;  // "OSIX", little-endian.
+constexpr uint32_t kIndexVersion = 1;
+
+// Unsigned LEB128.
+void AppendVarint(uint64_t value, std::string* buffer) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer->push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+uint64_t ReadVarint(const std::string& data, std::size_t* offset) {
+  uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (*offset >= data.size()) {
+      SpielFatalError("Info state index truncated inside a varint.");
+    }
+    uint8_t byte = static_cast<uint8_t>(data[(*offset)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+    shift += 7;
+  }
+}
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const std::string& data, std::size_t* offset) {
+  if (*offset + sizeof(T) > data.size()) {
+    SpielFatalError("Info state index truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+void AppendString(const std::string& value, std::string* buffer) {
+  AppendVarint(value.size(), buffer);
+  buffer->append(value);
+}
+
+std::string ReadString(const std::string& data, std::size_t* offset) {
+  const std::size_t length = ReadVarint(data, offset);
+  if (*offset + length > data.size()) {
+    SpielFatalError("Info state index truncated inside a string.");
+  }
+  std::string value = data.substr(*offset, length);
+  *offset += length;
+  return value;
+}
+
+}  // namespace
+
+InfoStateIndex::InfoStateIndex(const Game& game)
+    : game_string_(game.ToString()) {
+  if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("InfoStateIndex requires sequential games.");
+  }
+
+  // Collect the acting player's key at every reachable decision node. A
+  // std::map keeps the keys sorted, which is exactly the id order.
+  std::map<std::string, std::vector<Action>> infosets;
+  ForEachState(game, /*depth_limit=*/-1, /*include_terminals=*/false,
+               /*include_chance_states=*/false,
+               [&infosets](const State& state) {
+                 infosets.emplace(state.InformationStateKey(),
+                                  state.LegalActions());
+               });
+
+  keys_.reserve(infosets.size());
+  legal_actions_.reserve(infosets.size());
+  for (auto& entry : infosets) {
+    keys_.push_back(entry.first);
+    legal_actions_.push_back(std::move(entry.second));
+  }
+}
+
+int64_t InfoStateIndex::IndexOf(const std::string& key) const {
+  auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+  if (it == keys_.end() || *it != key) return -1;
+  return it - keys_.begin();
+}
+
+const std::string& InfoStateIndex::KeyAt(int64_t id) const {
+  SPIEL_CHECK_GE(id, 0);
+  SPIEL_CHECK_LT(id, keys_.size());
+  return keys_[id];
+}
+
+const std::vector<Action>& InfoStateIndex::LegalActionsAt(int64_t id) const {
+  SPIEL_CHECK_GE(id, 0);
+  SPIEL_CHECK_LT(id, legal_actions_.size());
+  return legal_actions_[id];
+}
+
+void SaveInfoStateIndex(const InfoStateIndex& index,
+                        const std::string& filename) {
+  std::string buffer;
+  AppendRaw<uint32_t>(kIndexMagic, &buffer);
+  AppendRaw<uint32_t>(kIndexVersion, &buffer);
+  AppendString(index.game_string(), &buffer);
+
+  AppendVarint(index.NumInfoStates(), &buffer);
+  for (int64_t id = 0; id < index.NumInfoStates(); ++id) {
+    AppendString(index.KeyAt(id), &buffer);
+    const std::vector<Action>& actions = index.LegalActionsAt(id);
+    AppendVarint(actions.size(), &buffer);
+    for (Action action : actions) {
+      AppendVarint(action, &buffer);
+    }
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open info state index for writing: " +
+                    filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write info state index: " + filename);
+  }
+}
+
+InfoStateIndex LoadInfoStateIndex(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError("Could not open info state index for reading: " +
+                    filename);
+  }
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+
+  std::size_t offset = 0;
+  if (ReadRaw<uint32_t>(data, &offset) != kIndexMagic) {
+    SpielFatalError("Not an info state index: " + filename);
+  }
+  if (ReadRaw<uint32_t>(data, &offset) != kIndexVersion) {
+    SpielFatalError("Unsupported info state index version in: " + filename);
+  }
+
+  InfoStateIndex index;
+  index.game_string_ = ReadString(data, &offset);
+
+  const uint64_t num_entries = ReadVarint(data, &offset);
+  index.keys_.reserve(num_entries);
+  index.legal_actions_.reserve(num_entries);
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    std::string key = ReadString(data, &offset);
+    // Keys were written in id (sorted) order.
+    if (!index.keys_.empty() && !(index.keys_.back() < key)) {
+      SpielFatalError("Info state index keys out of order in: " + filename);
+    }
+    index.keys_.push_back(std::move(key));
+    const uint64_t num_actions = ReadVarint(data, &offset);
+    std::vector<Action> actions(num_actions);
+    for (uint64_t aidx = 0; aidx < num_actions; ++aidx) {
+      actions[aidx] = ReadVarint(data, &offset);
+    }
+    index.legal_actions_.push_back(std::move(actions));
+  }
+  if (offset != data.size()) {
+    SpielFatalError("Trailing bytes in info state index: " + filename);
+  }
+  return index;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
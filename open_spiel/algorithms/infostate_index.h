@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INFOSTATE_INDEX_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INFOSTATE_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A dense index over a game's information states. Building one enumerates
+// every reachable decision node once (via the GetAllStates machinery) and
+// assigns the acting player's InformationStateKey at each a dense id in
+// [0, NumInfoStates()) — the keys the tabular algorithms (CFR, best
+// response, tabular policies) use for their hash maps. Ids are positions in
+// the sorted key list, so the mapping is minimal and perfect: lookups are a
+// binary search with no hashing and no allocation, and a table indexed by id
+// is a plain array. The enumeration is paid once per game configuration; the
+// index can be saved to disk and reloaded so later experiments on the same
+// configuration skip it entirely.
+class InfoStateIndex {
+ public:
+  // Enumerates the game's reachable decision nodes and builds the index.
+  // The game must be sequential (turn-based).
+  explicit InfoStateIndex(const Game& game);
+
+  // Game::ToString() of the game the index was built for.
+  const std::string& game_string() const { return game_string_; }
+
+  int64_t NumInfoStates() const { return keys_.size(); }
+
+  // The dense id of the key, or -1 if the information state was not seen
+  // during enumeration.
+  int64_t IndexOf(const std::string& key) const;
+
+  // The key with the given dense id.
+  const std::string& KeyAt(int64_t id) const;
+
+  // The legal actions at the information state with the given dense id, in
+  // the order the game reported them, so array-backed tables can size their
+  // per-infoset blocks without touching the game again.
+  const std::vector<Action>& LegalActionsAt(int64_t id) const;
+
+ private:
+  InfoStateIndex() = default;
+
+  std::string game_string_;
+  // Sorted; a key's position is its dense id.
+  std::vector<std::string> keys_;
+  // Aligned with keys_.
+  std::vector<std::vector<Action>> legal_actions_;
+
+  friend InfoStateIndex LoadInfoStateIndex(const std::string& filename);
+};
+
+// Writes the index to filename, replacing any existing file. The file is a
+// fixed header (magic, version), the game string, and then the keys in id
+// order, each with its legal actions. Calls SpielFatalError if the file
+// cannot be written.
+void SaveInfoStateIndex(const InfoStateIndex& index,
+                        const std::string& filename);
+
+// Reads an index written by SaveInfoStateIndex. Calls SpielFatalError if the
+// file cannot be read, is truncated, or has a bad magic or version.
+InfoStateIndex LoadInfoStateIndex(const std::string& filename);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_INFOSTATE_INDEX_H_
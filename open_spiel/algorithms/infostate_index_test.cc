@@ -0,0 +1,89 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/infostate_index.h"
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Kuhn has 6 information states per player; ids must be a bijection onto
+// [0, 12) and unknown keys must miss.
+void KuhnIndexTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  InfoStateIndex index(*game);
+
+  SPIEL_CHECK_EQ(index.NumInfoStates(), 12);
+  for (int64_t id = 0; id < index.NumInfoStates(); ++id) {
+    SPIEL_CHECK_EQ(index.IndexOf(index.KeyAt(id)), id);
+    SPIEL_CHECK_GT(index.LegalActionsAt(id).size(), 0);
+  }
+  SPIEL_CHECK_EQ(index.IndexOf("no such info state"), -1);
+}
+
+// Every infoset visited in a fresh traversal must resolve to a valid dense
+// id whose stored legal actions match the game's.
+void LeducLookupTest() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  InfoStateIndex index(*game);
+  SPIEL_CHECK_GT(index.NumInfoStates(), 0);
+
+  std::function<void(const State&)> walk = [&](const State& state) {
+    if (state.IsTerminal()) return;
+    if (!state.IsChanceNode()) {
+      int64_t id = index.IndexOf(state.InformationStateKey());
+      SPIEL_CHECK_GE(id, 0);
+      SPIEL_CHECK_TRUE(index.LegalActionsAt(id) == state.LegalActions());
+    }
+    for (Action action : state.LegalActions()) {
+      walk(*state.Child(action));
+    }
+  };
+  walk(*game->NewInitialState());
+}
+
+void SaveLoadRoundTripTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  InfoStateIndex index(*game);
+
+  std::string filename = "/tmp/open_spiel_infostate_index_test.bin";
+  SaveInfoStateIndex(index, filename);
+  InfoStateIndex loaded = LoadInfoStateIndex(filename);
+  std::remove(filename.c_str());
+
+  SPIEL_CHECK_EQ(loaded.game_string(), index.game_string());
+  SPIEL_CHECK_EQ(loaded.NumInfoStates(), index.NumInfoStates());
+  for (int64_t id = 0; id < index.NumInfoStates(); ++id) {
+    SPIEL_CHECK_EQ(loaded.KeyAt(id), index.KeyAt(id));
+    SPIEL_CHECK_TRUE(loaded.LegalActionsAt(id) == index.LegalActionsAt(id));
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::KuhnIndexTest();
+  open_spiel::algorithms::LeducLookupTest();
+  open_spiel::algorithms::SaveLoadRoundTripTest();
+}
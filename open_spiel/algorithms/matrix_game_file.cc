@@ -0,0 +1,223 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/matrix_game_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kMatrixGameFileMagic = 0x474d534f;  // "OSMG", little-endian.
+constexpr uint32_t kMatrixGameFileVersion = 1;
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const uint8_t* data, std::size_t size, std::size_t* offset) {
+  if (*offset + sizeof(T) > size) {
+    SpielFatalError("Matrix game file truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+void AppendString(const std::string& value, std::string* buffer) {
+  AppendVarint(value.size(), buffer);
+  buffer->append(value);
+}
+
+std::string ReadString(const uint8_t* data, std::size_t size,
+                       std::size_t* offset) {
+  std::size_t length = ReadVarint(data, size, offset);
+  if (*offset + length > size) {
+    SpielFatalError("Matrix game file truncated inside a string.");
+  }
+  std::string value(reinterpret_cast<const char*>(data + *offset), length);
+  *offset += length;
+  return value;
+}
+
+// Owns the file descriptor and mapping; shared by the loaded game and all of
+// its clones so the payoffs stay mapped as long as any of them is alive.
+struct MappedFile {
+  ~MappedFile() {
+    if (data != nullptr) munmap(const_cast<uint8_t*>(data), size);
+    if (fd >= 0) close(fd);
+  }
+
+  int fd = -1;
+  const uint8_t* data = nullptr;
+  std::size_t size = 0;
+};
+
+class MappedMatrixGame : public matrix_game::MatrixGame {
+ public:
+  MappedMatrixGame(GameType game_type,
+                   std::vector<std::string> row_action_names,
+                   std::vector<std::string> col_action_names,
+                   const double* row_utilities, const double* col_utilities,
+                   std::shared_ptr<MappedFile> mapping)
+      : MatrixGame(game_type, {}, std::move(row_action_names),
+                   std::move(col_action_names), row_utilities, col_utilities),
+        mapping_(std::move(mapping)) {}
+
+  std::unique_ptr<Game> Clone() const override {
+    return std::unique_ptr<Game>(new MappedMatrixGame(*this));
+  }
+
+ private:
+  std::shared_ptr<MappedFile> mapping_;
+};
+
+}  // namespace
+
+void SaveMatrixGameFile(const matrix_game::MatrixGame& game,
+                        const std::string& filename) {
+  const int num_rows = game.NumRows();
+  const int num_cols = game.NumCols();
+  const GameType type = game.GetType();
+
+  std::string buffer;
+  AppendRaw<uint32_t>(kMatrixGameFileMagic, &buffer);
+  AppendRaw<uint32_t>(kMatrixGameFileVersion, &buffer);
+  AppendRaw<uint32_t>(num_rows, &buffer);
+  AppendRaw<uint32_t>(num_cols, &buffer);
+  AppendRaw<uint8_t>(static_cast<uint8_t>(type.utility), &buffer);
+  AppendString(type.short_name, &buffer);
+  AppendString(type.long_name, &buffer);
+  for (int r = 0; r < num_rows; ++r) {
+    AppendString(game.RowActionName(r), &buffer);
+  }
+  for (int c = 0; c < num_cols; ++c) {
+    AppendString(game.ColActionName(c), &buffer);
+  }
+
+  // Pad to an 8-byte boundary so that the mapped payoff tables are aligned
+  // for direct access as doubles (the mapping itself is page-aligned).
+  while (buffer.size() % sizeof(double) != 0) buffer.push_back('\0');
+
+  const std::size_t table_bytes = num_rows * num_cols * sizeof(double);
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Could not open matrix game file for write: ",
+                                 filename));
+  }
+  file.write(buffer.data(), buffer.size());
+  file.write(reinterpret_cast<const char*>(game.RowUtilities()), table_bytes);
+  file.write(reinterpret_cast<const char*>(game.ColUtilities()), table_bytes);
+  if (!file) {
+    SpielFatalError(absl::StrCat("Error writing matrix game file: ",
+                                 filename));
+  }
+}
+
+std::unique_ptr<matrix_game::MatrixGame> LoadMatrixGameFile(
+    const std::string& filename) {
+  auto mapping = std::make_shared<MappedFile>();
+  mapping->fd = open(filename.c_str(), O_RDONLY);
+  if (mapping->fd < 0) {
+    SpielFatalError(absl::StrCat("Could not open matrix game file: ",
+                                 filename));
+  }
+  struct stat file_stat;
+  if (fstat(mapping->fd, &file_stat) != 0) {
+    SpielFatalError(absl::StrCat("Could not stat matrix game file: ",
+                                 filename));
+  }
+  mapping->size = file_stat.st_size;
+  void* address =
+      mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, mapping->fd, 0);
+  if (address == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Could not mmap matrix game file: ",
+                                 filename));
+  }
+  mapping->data = static_cast<const uint8_t*>(address);
+
+  const uint8_t* data = mapping->data;
+  const std::size_t size = mapping->size;
+  std::size_t offset = 0;
+  if (ReadRaw<uint32_t>(data, size, &offset) != kMatrixGameFileMagic) {
+    SpielFatalError(absl::StrCat("Not a matrix game file: ", filename));
+  }
+  uint32_t version = ReadRaw<uint32_t>(data, size, &offset);
+  if (version != kMatrixGameFileVersion) {
+    SpielFatalError(absl::StrCat("Unsupported matrix game file version: ",
+                                 version));
+  }
+  const int num_rows = ReadRaw<uint32_t>(data, size, &offset);
+  const int num_cols = ReadRaw<uint32_t>(data, size, &offset);
+  GameType::Utility utility =
+      static_cast<GameType::Utility>(ReadRaw<uint8_t>(data, size, &offset));
+  std::string short_name = ReadString(data, size, &offset);
+  std::string long_name = ReadString(data, size, &offset);
+  std::vector<std::string> row_names;
+  std::vector<std::string> col_names;
+  row_names.reserve(num_rows);
+  col_names.reserve(num_cols);
+  for (int r = 0; r < num_rows; ++r) {
+    row_names.push_back(ReadString(data, size, &offset));
+  }
+  for (int c = 0; c < num_cols; ++c) {
+    col_names.push_back(ReadString(data, size, &offset));
+  }
+  while (offset % sizeof(double) != 0) ++offset;
+
+  const std::size_t table_bytes = num_rows * num_cols * sizeof(double);
+  if (offset + 2 * table_bytes > size) {
+    SpielFatalError(absl::StrCat("Matrix game file truncated: ", filename));
+  }
+  const double* row_utilities =
+      reinterpret_cast<const double*>(data + offset);
+  const double* col_utilities =
+      reinterpret_cast<const double*>(data + offset + table_bytes);
+
+  GameType game_type{
+      /*short_name=*/short_name,
+      /*long_name=*/long_name,
+      GameType::Dynamics::kSimultaneous,
+      GameType::ChanceMode::kDeterministic,
+      GameType::Information::kOneShot,
+      utility,
+      GameType::RewardModel::kTerminal,
+      /*max_num_players=*/2,
+      /*min_num_players=*/2,
+      /*provides_information_state=*/true,
+      /*provides_information_state_as_normalized_vector=*/true,
+      /*parameter_specification=*/{}  // no parameters
+  };
+
+  return std::unique_ptr<matrix_game::MatrixGame>(new MappedMatrixGame(
+      game_type, std::move(row_names), std::move(col_names), row_utilities,
+      col_utilities, std::move(mapping)));
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,50 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_FILE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_FILE_H_
+
+#include <memory>
+#include <string>
+
+#include "open_spiel/matrix_game.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A binary on-disk format for normal-form (matrix) games. A file is a fixed
+// header (magic, version, table dimensions, utility type) followed by the
+// game and action names (varint-length-prefixed strings), zero padding up to
+// an 8-byte boundary, and then the two payoff tables as raw row-major
+// doubles. Empirical-game pipelines produce tables with tens of thousands of
+// strategies per side; storing the payoffs in their in-memory layout means
+// loading one involves no per-cell parsing at all.
+
+// Writes the game's names and payoff tables to filename, replacing any
+// existing file.
+void SaveMatrixGameFile(const matrix_game::MatrixGame& game,
+                        const std::string& filename);
+
+// Memory-maps filename and returns a MatrixGame whose payoff tables are
+// served directly from the mapping: nothing is parsed or copied, and pages
+// are faulted in only as cells are touched. The mapping is shared with every
+// clone of the returned game and unmapped when the last one is destroyed.
+std::unique_ptr<matrix_game::MatrixGame> LoadMatrixGameFile(
+    const std::string& filename);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MATRIX_GAME_FILE_H_
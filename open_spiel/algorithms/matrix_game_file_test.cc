@@ -0,0 +1,80 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/matrix_game_file.h"
+
+#include <cstdio>
+
+#include "open_spiel/algorithms/matrix_game_utils.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckGamesEqual(const matrix_game::MatrixGame& expected,
+                     const matrix_game::MatrixGame& actual) {
+  SPIEL_CHECK_EQ(actual.NumRows(), expected.NumRows());
+  SPIEL_CHECK_EQ(actual.NumCols(), expected.NumCols());
+  SPIEL_CHECK_EQ(actual.GetType().short_name, expected.GetType().short_name);
+  SPIEL_CHECK_TRUE(actual.GetType().utility == expected.GetType().utility);
+  for (int r = 0; r < expected.NumRows(); ++r) {
+    SPIEL_CHECK_EQ(actual.RowActionName(r), expected.RowActionName(r));
+    for (int c = 0; c < expected.NumCols(); ++c) {
+      if (r == 0) {
+        SPIEL_CHECK_EQ(actual.ColActionName(c), expected.ColActionName(c));
+      }
+      SPIEL_CHECK_EQ(actual.RowUtility(r, c), expected.RowUtility(r, c));
+      SPIEL_CHECK_EQ(actual.ColUtility(r, c), expected.ColUtility(r, c));
+    }
+  }
+}
+
+void RoundTripTest() {
+  std::unique_ptr<Game> blotto = LoadGame("blotto");
+  std::unique_ptr<matrix_game::MatrixGame> original =
+      AsMatrixGame(blotto.get());
+
+  std::string filename = "/tmp/open_spiel_matrix_game_file_test_blotto";
+  std::remove(filename.c_str());
+  SaveMatrixGameFile(*original, filename);
+
+  std::unique_ptr<matrix_game::MatrixGame> loaded =
+      LoadMatrixGameFile(filename);
+  CheckGamesEqual(*original, *loaded);
+  SPIEL_CHECK_EQ(loaded->MinUtility(), original->MinUtility());
+  SPIEL_CHECK_EQ(loaded->MaxUtility(), original->MaxUtility());
+
+  // The loaded game plays like any other matrix game...
+  std::unique_ptr<State> state = loaded->NewInitialState();
+  state->ApplyActions({0, 13});
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_EQ(state->Returns()[0], original->RowUtility(0, 13));
+
+  // ... and the mapping survives the original handle being destroyed, since
+  // clones share ownership of it.
+  std::unique_ptr<Game> clone = loaded->Clone();
+  loaded.reset();
+  CheckGamesEqual(*original,
+                  *dynamic_cast<const matrix_game::MatrixGame*>(clone.get()));
+
+  std::remove(filename.c_str());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) { open_spiel::algorithms::RoundTripTest(); }
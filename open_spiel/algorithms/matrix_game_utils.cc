@@ -14,6 +14,9 @@
 
 #include "open_spiel/algorithms/matrix_game_utils.h"
 
+#include <atomic>
+#include <thread>
+
 #include "open_spiel/algorithms/deterministic_policy.h"
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/simultaneous_move_game.h"
@@ -48,43 +51,95 @@ std::unique_ptr<MatrixGame> AsMatrixGame(const Game* game) {
 }
 
 std::unique_ptr<MatrixGame> AsMatrixGame(const NormalFormGame* game) {
+  return AsMatrixGame(game, /*num_threads=*/1);
+}
+
+std::unique_ptr<MatrixGame> AsMatrixGame(const NormalFormGame* game,
+                                         int num_threads,
+                                         const MatrixGame* previous) {
   SPIEL_CHECK_EQ(game->NumPlayers(), 2);
+  SPIEL_CHECK_GE(num_threads, 1);
   std::unique_ptr<State> initial_state = game->NewInitialState();
   std::vector<std::vector<Action>> legal_actions = {
       initial_state->LegalActions(0), initial_state->LegalActions(1)};
 
+  const int num_rows = legal_actions[0].size();
+  const int num_cols = legal_actions[1].size();
+
   std::vector<std::string> row_names;
   std::vector<std::string> col_names;
-  std::vector<double> row_utils;
-  std::vector<double> col_utils;
-  int num_rows = legal_actions[0].size();
-  int num_cols = legal_actions[1].size();
-
-  GameType type = game->GetType();
-  type.min_num_players = 2;
-  type.max_num_players = 2;
-
+  row_names.reserve(num_rows);
+  col_names.reserve(num_cols);
   for (int r = 0; r < num_rows; ++r) {
-    Action row_action = legal_actions[0][r];
-    row_names.push_back(initial_state->ActionToString(0, row_action));
-
-    for (int c = 0; c < num_cols; ++c) {
-      Action col_action = legal_actions[1][c];
-      if (col_names.size() < num_cols) {
-        col_names.push_back(initial_state->ActionToString(1, col_action));
-      }
+    row_names.push_back(initial_state->ActionToString(0, legal_actions[0][r]));
+  }
+  for (int c = 0; c < num_cols; ++c) {
+    col_names.push_back(initial_state->ActionToString(1, legal_actions[1][c]));
+  }
 
-      std::unique_ptr<State> clone = initial_state->Clone();
-      clone->ApplyActions({row_action, col_action});
-      SPIEL_CHECK_TRUE(clone->IsTerminal());
-      std::vector<double> returns = clone->Returns();
-      SPIEL_CHECK_EQ(returns.size(), 2);
+  // The previous table must cover a prefix of the current action sets; the
+  // names are cheap to check and catch passing a table of the wrong game.
+  int prev_rows = 0;
+  int prev_cols = 0;
+  if (previous != nullptr) {
+    prev_rows = previous->NumRows();
+    prev_cols = previous->NumCols();
+    SPIEL_CHECK_LE(prev_rows, num_rows);
+    SPIEL_CHECK_LE(prev_cols, num_cols);
+    for (int r = 0; r < prev_rows; ++r) {
+      SPIEL_CHECK_EQ(previous->RowActionName(r), row_names[r]);
+    }
+    for (int c = 0; c < prev_cols; ++c) {
+      SPIEL_CHECK_EQ(previous->ColActionName(c), col_names[c]);
+    }
+  }
 
-      row_utils.push_back(returns[0]);
-      col_utils.push_back(returns[1]);
+  std::vector<double> row_utils(num_rows * num_cols, 0);
+  std::vector<double> col_utils(num_rows * num_cols, 0);
+
+  // The cells are independent, so the workers pull whole rows off a shared
+  // counter and write disjoint slices of the payoff vectors; each worker
+  // replays the game from its own copy of the initial state. Cells the
+  // previous table already covers are copied instead of replayed.
+  std::atomic<int> next_row(0);
+  auto evaluate_rows = [&]() {
+    std::unique_ptr<State> local_initial = initial_state->Clone();
+    for (int r = next_row++; r < num_rows; r = next_row++) {
+      for (int c = 0; c < num_cols; ++c) {
+        const int cell = r * num_cols + c;
+        if (r < prev_rows && c < prev_cols) {
+          row_utils[cell] = previous->RowUtility(r, c);
+          col_utils[cell] = previous->ColUtility(r, c);
+          continue;
+        }
+        std::unique_ptr<State> clone = local_initial->Clone();
+        clone->ApplyActions({legal_actions[0][r], legal_actions[1][c]});
+        SPIEL_CHECK_TRUE(clone->IsTerminal());
+        std::vector<double> returns = clone->Returns();
+        SPIEL_CHECK_EQ(returns.size(), 2);
+        row_utils[cell] = returns[0];
+        col_utils[cell] = returns[1];
+      }
+    }
+  };
+
+  if (num_threads == 1) {
+    evaluate_rows();
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back(evaluate_rows);
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
     }
   }
 
+  GameType type = game->GetType();
+  type.min_num_players = 2;
+  type.max_num_players = 2;
+
   return std::unique_ptr<MatrixGame>(
       new MatrixGame(type, {}, row_names, col_names, row_utils, col_utils));
 }
@@ -36,6 +36,18 @@ std::unique_ptr<matrix_game::MatrixGame> AsMatrixGame(
     const NormalFormGame* game);
 std::unique_ptr<matrix_game::MatrixGame> AsMatrixGame(const Game* game);
 
+// As above, with the cells evaluated by num_threads worker threads, each
+// replaying the game from its own copy of the initial state; the cells are
+// independent, so the workers share nothing. If `previous` is non-null it
+// must be the table built from a prefix of the game's current action sets
+// (checked by action name); its cells are copied over and only cells
+// involving a newly added row or column are replayed. This is the shape of
+// an empirical-game (PSRO-style) loop, where one new strategy per player is
+// added to a large table each iteration.
+std::unique_ptr<matrix_game::MatrixGame> AsMatrixGame(
+    const NormalFormGame* game, int num_threads,
+    const matrix_game::MatrixGame* previous = nullptr);
+
 // Creates a two-player extensive-form game (EFG)'s equivalent matrix game.
 //
 // Note that this matrix game will have a row (respectively column) for each
@@ -45,6 +45,85 @@ void ExtensiveToMatrixGameTest() {
   SPIEL_CHECK_EQ(kuhn_matrix_game->NumCols(), 64);
 }
 
+void ParallelAndIncrementalAsMatrixGameTest() {
+  std::unique_ptr<Game> blotto = LoadGame("blotto");
+  std::unique_ptr<matrix_game::MatrixGame> serial = AsMatrixGame(blotto.get());
+
+  // The parallel build must produce exactly the same table.
+  const NormalFormGame* nfg =
+      dynamic_cast<const NormalFormGame*>(blotto.get());
+  std::unique_ptr<matrix_game::MatrixGame> parallel =
+      AsMatrixGame(nfg, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(parallel->NumRows(), serial->NumRows());
+  SPIEL_CHECK_EQ(parallel->NumCols(), serial->NumCols());
+  for (int r = 0; r < serial->NumRows(); ++r) {
+    for (int c = 0; c < serial->NumCols(); ++c) {
+      SPIEL_CHECK_EQ(parallel->RowUtility(r, c), serial->RowUtility(r, c));
+      SPIEL_CHECK_EQ(parallel->ColUtility(r, c), serial->ColUtility(r, c));
+    }
+  }
+
+  // Build a table covering only a prefix of the action sets, then extend it
+  // incrementally; the result must again match the full table.
+  const int prefix_rows = 10;
+  const int prefix_cols = 7;
+  std::vector<std::string> prefix_row_names;
+  std::vector<std::string> prefix_col_names;
+  std::vector<double> prefix_row_utils;
+  std::vector<double> prefix_col_utils;
+  for (int r = 0; r < prefix_rows; ++r) {
+    prefix_row_names.push_back(serial->RowActionName(r));
+    for (int c = 0; c < prefix_cols; ++c) {
+      if (r == 0) prefix_col_names.push_back(serial->ColActionName(c));
+      prefix_row_utils.push_back(serial->RowUtility(r, c));
+      prefix_col_utils.push_back(serial->ColUtility(r, c));
+    }
+  }
+  matrix_game::MatrixGame prefix_game(
+      serial->GetType(), {}, prefix_row_names, prefix_col_names,
+      prefix_row_utils, prefix_col_utils);
+  std::unique_ptr<matrix_game::MatrixGame> extended =
+      AsMatrixGame(nfg, /*num_threads=*/2, &prefix_game);
+  for (int r = 0; r < serial->NumRows(); ++r) {
+    for (int c = 0; c < serial->NumCols(); ++c) {
+      SPIEL_CHECK_EQ(extended->RowUtility(r, c), serial->RowUtility(r, c));
+      SPIEL_CHECK_EQ(extended->ColUtility(r, c), serial->ColUtility(r, c));
+    }
+  }
+}
+
+void ExpectedUtilityTest() {
+  // Matching pennies.
+  std::unique_ptr<matrix_game::MatrixGame> game = matrix_game::CreateMatrixGame(
+      {{1, -1}, {-1, 1}}, {{-1, 1}, {1, -1}});
+
+  const std::vector<double> uniform = {0.5, 0.5};
+  const std::vector<double> pure_heads = {1.0, 0.0};
+  const std::vector<double> uneven = {0.25, 0.75};
+  SPIEL_CHECK_FLOAT_NEAR(game->ExpectedUtility(0, uniform, uniform), 0.0,
+                         1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(game->ExpectedUtility(0, pure_heads, uneven), -0.5,
+                         1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(game->ExpectedUtility(1, pure_heads, uneven), 0.5,
+                         1e-12);
+
+  // One matrix-vector product gives every pure strategy's payoff against a
+  // mixed opponent.
+  std::vector<double> row_values = game->PureStrategyUtilities(0, uneven);
+  SPIEL_CHECK_FLOAT_NEAR(row_values[0], -0.5, 1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(row_values[1], 0.5, 1e-12);
+  std::vector<double> col_values = game->PureStrategyUtilities(1, pure_heads);
+  SPIEL_CHECK_FLOAT_NEAR(col_values[0], -1.0, 1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(col_values[1], 1.0, 1e-12);
+
+  // The batch call agrees with the per-profile one.
+  std::vector<double> batch = game->BatchExpectedUtility(
+      0, {uniform, pure_heads}, {uniform, uneven});
+  SPIEL_CHECK_EQ(batch.size(), 2);
+  SPIEL_CHECK_FLOAT_NEAR(batch[0], 0.0, 1e-12);
+  SPIEL_CHECK_FLOAT_NEAR(batch[1], -0.5, 1e-12);
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -52,4 +131,6 @@ void ExtensiveToMatrixGameTest() {
 int main(int argc, char** argv) {
   open_spiel::algorithms::ConvertToMatrixGameTest();
   open_spiel::algorithms::ExtensiveToMatrixGameTest();
+  open_spiel::algorithms::ExpectedUtilityTest();
+  open_spiel::algorithms::ParallelAndIncrementalAsMatrixGameTest();
 }
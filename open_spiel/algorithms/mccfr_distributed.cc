@@ -0,0 +1,238 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/mccfr_distributed.h"
+
+#include <cstring>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kDeltaMagic = 0x444d534f;  // "OSMD", little-endian.
+constexpr uint32_t kDeltaVersion = 1;
+
+// Unsigned LEB128.
+void AppendVarint(uint64_t value, std::string* buffer) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer->push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+uint64_t ReadVarint(const std::string& data, std::size_t* offset) {
+  uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (*offset >= data.size()) {
+      SpielFatalError("MCCFR delta truncated inside a varint.");
+    }
+    uint8_t byte = static_cast<uint8_t>(data[(*offset)++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+    shift += 7;
+  }
+}
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const std::string& data, std::size_t* offset) {
+  if (*offset + sizeof(T) > data.size()) {
+    SpielFatalError("MCCFR delta truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+void AppendString(const std::string& value, std::string* buffer) {
+  AppendVarint(value.size(), buffer);
+  buffer->append(value);
+}
+
+std::string ReadString(const std::string& data, std::size_t* offset) {
+  const std::size_t length = ReadVarint(data, offset);
+  if (*offset + length > data.size()) {
+    SpielFatalError("MCCFR delta truncated inside a string.");
+  }
+  std::string value = data.substr(*offset, length);
+  *offset += length;
+  return value;
+}
+
+// Appends one delta entry: the key, the legal actions, and the regret and
+// policy increments.
+void AppendEntry(const std::string& key, const std::vector<Action>& actions,
+                 const std::vector<double>& regret_deltas,
+                 const std::vector<double>& policy_deltas,
+                 std::string* buffer) {
+  AppendString(key, buffer);
+  AppendVarint(actions.size(), buffer);
+  for (Action action : actions) {
+    AppendVarint(action, buffer);
+  }
+  for (double regret : regret_deltas) {
+    AppendRaw<double>(regret, buffer);
+  }
+  for (double policy : policy_deltas) {
+    AppendRaw<double>(policy, buffer);
+  }
+}
+
+}  // namespace
+
+std::string SerializeMCCFRDelta(const std::string& game_string,
+                                const CFRInfoStateValuesTable& base,
+                                const CFRInfoStateValuesTable& current) {
+  std::string buffer;
+  AppendRaw<uint32_t>(kDeltaMagic, &buffer);
+  AppendRaw<uint32_t>(kDeltaVersion, &buffer);
+  AppendString(game_string, &buffer);
+
+  // The entry count precedes the entries, so encode the entries into a side
+  // buffer first and count as we go.
+  uint64_t num_entries = 0;
+  std::string entries;
+  std::vector<double> regret_deltas;
+  std::vector<double> policy_deltas;
+  for (const auto& entry : current) {
+    const CFRInfoStateValues& values = entry.second;
+    auto base_iter = base.find(entry.first);
+    if (base_iter == base.end()) {
+      ++num_entries;
+      AppendEntry(entry.first, values.legal_actions,
+                  values.cumulative_regrets, values.cumulative_policy,
+                  &entries);
+      continue;
+    }
+    const CFRInfoStateValues& base_values = base_iter->second;
+    SPIEL_CHECK_EQ(base_values.legal_actions.size(),
+                   values.legal_actions.size());
+    bool changed = false;
+    regret_deltas.resize(values.num_actions());
+    policy_deltas.resize(values.num_actions());
+    for (int i = 0; i < values.num_actions(); ++i) {
+      regret_deltas[i] =
+          values.cumulative_regrets[i] - base_values.cumulative_regrets[i];
+      policy_deltas[i] =
+          values.cumulative_policy[i] - base_values.cumulative_policy[i];
+      if (regret_deltas[i] != 0 || policy_deltas[i] != 0) changed = true;
+    }
+    if (!changed) continue;
+    ++num_entries;
+    AppendEntry(entry.first, values.legal_actions, regret_deltas,
+                policy_deltas, &entries);
+  }
+  AppendVarint(num_entries, &buffer);
+  buffer.append(entries);
+  return buffer;
+}
+
+void ApplyMCCFRDelta(const std::string& delta,
+                     const std::string& expected_game_string,
+                     CFRInfoStateValuesTable* table) {
+  std::size_t offset = 0;
+  if (ReadRaw<uint32_t>(delta, &offset) != kDeltaMagic) {
+    SpielFatalError("Not an MCCFR delta.");
+  }
+  const uint32_t version = ReadRaw<uint32_t>(delta, &offset);
+  if (version != kDeltaVersion) {
+    SpielFatalError(absl::StrCat("Unsupported MCCFR delta version: ",
+                                 version));
+  }
+  const std::string game_string = ReadString(delta, &offset);
+  if (game_string != expected_game_string) {
+    SpielFatalError(absl::StrCat("MCCFR delta is for a different game: got '",
+                                 game_string, "', expected '",
+                                 expected_game_string, "'."));
+  }
+
+  const uint64_t num_entries = ReadVarint(delta, &offset);
+  for (uint64_t n = 0; n < num_entries; ++n) {
+    const std::string key = ReadString(delta, &offset);
+    const uint64_t num_actions = ReadVarint(delta, &offset);
+    std::vector<Action> legal_actions(num_actions);
+    for (uint64_t i = 0; i < num_actions; ++i) {
+      legal_actions[i] = ReadVarint(delta, &offset);
+    }
+    auto iter = table->find(key);
+    if (iter == table->end()) {
+      iter = table->emplace(key, CFRInfoStateValues(legal_actions)).first;
+    } else {
+      SPIEL_CHECK_EQ(iter->second.legal_actions.size(), num_actions);
+    }
+    CFRInfoStateValues& values = iter->second;
+    for (uint64_t i = 0; i < num_actions; ++i) {
+      values.cumulative_regrets[i] += ReadRaw<double>(delta, &offset);
+    }
+    for (uint64_t i = 0; i < num_actions; ++i) {
+      values.cumulative_policy[i] += ReadRaw<double>(delta, &offset);
+    }
+  }
+  if (offset != delta.size()) {
+    SpielFatalError("Trailing bytes after MCCFR delta.");
+  }
+}
+
+DistributedMCCFRMerger::DistributedMCCFRMerger(const Game& game)
+    : game_string_(game.ToString()),
+      uniform_policy_(std::shared_ptr<TabularPolicy>(
+          new TabularPolicy(GetUniformPolicy(game)))) {}
+
+void DistributedMCCFRMerger::ApplyDelta(const std::string& delta) {
+  ApplyMCCFRDelta(delta, game_string_, &table_);
+  ++num_deltas_applied_;
+}
+
+std::string DistributedMCCFRMerger::TableSnapshot() const {
+  return SerializeMCCFRDelta(game_string_, CFRInfoStateValuesTable(), table_);
+}
+
+DistributedMCCFRWorker::DistributedMCCFRWorker(const Game& game, int seed,
+                                               AverageType avg_type)
+    : game_string_(game.ToString()), solver_(game, seed, avg_type) {}
+
+void DistributedMCCFRWorker::LoadSnapshot(const std::string& snapshot) {
+  CFRInfoStateValuesTable table;
+  ApplyMCCFRDelta(snapshot, game_string_, &table);
+  baseline_ = table;
+  solver_.SetInfoStateValuesTable(std::move(table));
+}
+
+void DistributedMCCFRWorker::RunIterations(int num_iterations) {
+  for (int i = 0; i < num_iterations; ++i) {
+    solver_.RunIteration();
+  }
+}
+
+std::string DistributedMCCFRWorker::FlushDelta() {
+  std::string delta = SerializeMCCFRDelta(game_string_, baseline_,
+                                          solver_.InfoStateValuesTable());
+  baseline_ = solver_.InfoStateValuesTable();
+  return delta;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,127 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCCFR_DISTRIBUTED_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCCFR_DISTRIBUTED_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/external_sampling_mccfr.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// A distribution layer for external sampling MCCFR: workers run iterations
+// on a local snapshot of the value table and periodically ship the updates
+// they have accumulated since their last flush ("deltas") to a merger that
+// owns the authoritative table. Because cumulative regrets and average
+// policy counters are sums over sampled trajectories, a delta merges into
+// the master table by element-wise addition, and running several workers is
+// equivalent to one solver whose iterations read slightly stale policies —
+// a staleness sampled CFR tolerates well.
+//
+// Only the delta format and merge semantics live here; the transport is the
+// caller's. Deltas and snapshots are opaque byte strings to be moved between
+// processes however the deployment likes (files, an RPC layer, a queue). A
+// snapshot is simply a delta against an empty table, so one format serves
+// both directions.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Serializes the element-wise difference `current - base` of two value
+// tables. Entries absent from `base` are included whole; entries whose
+// values are unchanged are omitted, which is what keeps periodic deltas
+// small. The game string is embedded so the receiver can reject deltas from
+// a different game.
+std::string SerializeMCCFRDelta(const std::string& game_string,
+                                const CFRInfoStateValuesTable& base,
+                                const CFRInfoStateValuesTable& current);
+
+// Adds the increments in `delta` into `table`, creating entries as needed.
+// Calls SpielFatalError if the delta is malformed or was produced for a
+// game other than `expected_game_string`.
+void ApplyMCCFRDelta(const std::string& delta,
+                     const std::string& expected_game_string,
+                     CFRInfoStateValuesTable* table);
+
+// Owns the authoritative value table: applies worker deltas and hands out
+// table snapshots. Single-threaded; a deployment serializes access to it the
+// same way it transports the blobs.
+class DistributedMCCFRMerger {
+ public:
+  explicit DistributedMCCFRMerger(const Game& game);
+
+  // Merges one worker delta into the table by element-wise addition.
+  void ApplyDelta(const std::string& delta);
+
+  // Serializes the full table for shipping to workers.
+  std::string TableSnapshot() const;
+
+  // Computes the average policy, containing the policy for all players. The
+  // returned policy instance should only be used during the lifetime of the
+  // merger object.
+  std::unique_ptr<Policy> AveragePolicy() const {
+    return std::unique_ptr<Policy>(
+        new CFRAveragePolicy(table_, uniform_policy_));
+  }
+
+  const CFRInfoStateValuesTable& Table() const { return table_; }
+  int64_t num_deltas_applied() const { return num_deltas_applied_; }
+
+ private:
+  std::string game_string_;
+  CFRInfoStateValuesTable table_;
+  std::shared_ptr<TabularPolicy> uniform_policy_;
+  int64_t num_deltas_applied_ = 0;
+};
+
+// One worker node: an external sampling MCCFR solver whose table is seeded
+// from merger snapshots and whose accumulated updates are flushed as deltas.
+// The intended loop per sync interval is
+//   worker.LoadSnapshot(<snapshot from the merger>);
+//   worker.RunIterations(n);
+//   <ship worker.FlushDelta() to the merger>;
+// though flushing without reloading (or reloading less often) also works;
+// the worker then keeps building on its own updates.
+class DistributedMCCFRWorker {
+ public:
+  // Give each worker a distinct seed so they sample distinct trajectories.
+  DistributedMCCFRWorker(const Game& game, int seed,
+                         AverageType avg_type = AverageType::kSimple);
+
+  // Replaces the local table (and the delta baseline) with the snapshot.
+  void LoadSnapshot(const std::string& snapshot);
+
+  // Runs external sampling MCCFR iterations on the local table.
+  void RunIterations(int num_iterations);
+
+  // Serializes the updates accumulated since the last flush (or snapshot
+  // load) and makes the current table the new baseline.
+  std::string FlushDelta();
+
+ private:
+  std::string game_string_;
+  ExternalSamplingMCCFRSolver solver_;
+  // The table as of the last LoadSnapshot/FlushDelta; deltas are diffed
+  // against it.
+  CFRInfoStateValuesTable baseline_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCCFR_DISTRIBUTED_H_
@@ -14,93 +14,388 @@
 
 #include "open_spiel/algorithms/mcts.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <limits>
 #include <random>
+#include <thread>
+
+#include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace algorithms {
+
+int SearchTree::AllocateChildren(int count) {
+  const int begin = nodes_.size();
+  nodes_.resize(nodes_.size() + count);
+  return begin;
+}
+
+void SearchTree::ReRoot(int new_root_index) {
+  std::vector<SearchNode> old_nodes;
+  old_nodes.swap(nodes_);
+  nodes_.reserve(old_nodes.size());
+  nodes_.push_back(std::move(old_nodes[new_root_index]));
+  // Copy the subtree over in breadth-first order; every node before index i
+  // already lives in the new arena, with children_begin still pointing into
+  // the old one until its children are moved across.
+  for (int i = 0; i < nodes_.size(); ++i) {
+    const int old_begin = nodes_[i].children_begin;
+    if (old_begin < 0) continue;
+    const int count = nodes_[i].actions.size();
+    const int new_begin = nodes_.size();
+    for (int c = 0; c < count; ++c) {
+      nodes_.push_back(std::move(old_nodes[old_begin + c]));
+    }
+    nodes_[i].children_begin = new_begin;
+  }
+}
+
+void SearchTree::Reset() {
+  nodes_.clear();
+  nodes_.emplace_back();
+}
+
+void SearchTree::Merge(const SearchTree& other) {
+  MergeSubtree(/*index=*/0, other, /*other_index=*/0);
+}
+
+void SearchTree::MergeSubtree(int index, const SearchTree& other,
+                              int other_index) {
+  const SearchNode& src = other.nodes_[other_index];
+  nodes_[index].explore_count += src.explore_count;
+  nodes_[index].total_reward += src.total_reward;
+  if (src.children_begin < 0) return;
+  if (nodes_[index].children_begin < 0) {
+    // AllocateChildren may reallocate the arena, so take the copies first.
+    std::vector<Action> actions = src.actions;
+    const int children_begin = AllocateChildren(actions.size());
+    nodes_[index].actions = std::move(actions);
+    nodes_[index].children_begin = children_begin;
+    nodes_[index].player_sign = src.player_sign;
+  }
+  // Both trees expanded this node from the same state, so the action lists
+  // (and hence the child ranges) line up.
+  SPIEL_CHECK_EQ(nodes_[index].actions.size(), src.actions.size());
+  for (int i = 0; i < src.actions.size(); ++i) {
+    MergeSubtree(nodes_[index].children_begin + i, other,
+                 src.children_begin + i);
+  }
+}
+
+double SearchTree::ChildValue(const SearchNode& node, int child_index,
+                              double uct_c) const {
+  const SearchNode& child = nodes_[node.children_begin + child_index];
+  // Unexplored nodes have infinite value
+  if (child.explore_count == 0)
+    return std::numeric_limits<double>::infinity();
+
+  // The "greedy-value" of choosing a given child is always with respect to
+  // the current player for this node.
+  return node.player_sign * child.total_reward / child.explore_count +
+         uct_c * sqrt(log(node.explore_count) / child.explore_count);
+}
+
 namespace {
 
-// A node in the search tree for MCTS
-struct SearchNode {
-  int explore_count = 0;    // number of times this node was explored
-  int player_sign = 0;      // 1 for player 0, -1 for player 1
-  double total_reward = 0;  // total reward passing through this node
-
-  // The two following vectors are aligned: actions[i] applied to this state
-  // gives the state corresponding to node children[i].
-  std::vector<Action> actions;
-  std::vector<SearchNode> children;
-
-  // UCT value of given child
-  double ChildValue(int child_index, double uct_c) const {
-    const auto& child = children[child_index];
-    // Unexplored nodes have infinite value
-    if (child.explore_count == 0)
-      return std::numeric_limits<double>::infinity();
-
-    // The "greedy-value" of choosing a given child is always with respect to
-    // the current player for this node.
-    return player_sign * child.total_reward / child.explore_count +
-           uct_c * sqrt(log(explore_count) / child.explore_count);
-  }
-
-  // Returns the most visited action in this node.
-  Action MostVisitedAction() {
-    Action chosen_action = actions[0];
-    int largest_visit = children[0].explore_count;
-    for (int i = 0; i < children.size(); ++i) {
-      if (children[i].explore_count > largest_visit) {
-        largest_visit = children[i].explore_count;
-        chosen_action = actions[i];
-      }
+// Fixed 8-byte little-endian IEEE encoding for the reward sums; varints
+// would not round-trip doubles.
+void AppendFixedDouble(double value, std::string* buffer) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    buffer->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+double ReadFixedDouble(const uint8_t* data, std::size_t size,
+                       std::size_t* offset) {
+  SPIEL_CHECK_LE(*offset + 8, size);
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; ++i) {
+    bits |= static_cast<uint64_t>(data[*offset + i]) << (8 * i);
+  }
+  *offset += 8;
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+void SearchTree::Serialize(std::string* buffer) const {
+  AppendVarint(nodes_.size(), buffer);
+  for (const SearchNode& node : nodes_) {
+    AppendVarint(node.explore_count, buffer);
+    // player_sign is -1, 0 or 1 and children_begin is -1 for unexpanded
+    // nodes; both are shifted up by one to stay non-negative.
+    AppendVarint(node.player_sign + 1, buffer);
+    AppendVarint(node.children_begin + 1, buffer);
+    AppendFixedDouble(node.total_reward, buffer);
+    AppendVarint(node.actions.size(), buffer);
+    for (Action action : node.actions) {
+      AppendVarint(action, buffer);
+    }
+  }
+}
+
+void SearchTree::Deserialize(const uint8_t* data, std::size_t size,
+                             std::size_t* offset) {
+  const std::size_t num_nodes = ReadVarint(data, size, offset);
+  SPIEL_CHECK_GE(num_nodes, 1);
+  nodes_.clear();
+  nodes_.resize(num_nodes);
+  for (SearchNode& node : nodes_) {
+    node.explore_count = ReadVarint(data, size, offset);
+    node.player_sign = static_cast<int>(ReadVarint(data, size, offset)) - 1;
+    node.children_begin =
+        static_cast<int64_t>(ReadVarint(data, size, offset)) - 1;
+    node.total_reward = ReadFixedDouble(data, size, offset);
+    node.actions.resize(ReadVarint(data, size, offset));
+    for (Action& action : node.actions) {
+      action = ReadVarint(data, size, offset);
+    }
+    // Each node's child range must lie inside the arena.
+    if (node.children_begin >= 0) {
+      SPIEL_CHECK_LE(node.children_begin + node.actions.size(), num_nodes);
+    }
+  }
+}
+
+Action SearchTree::MostVisitedAction(const SearchNode& node) const {
+  Action chosen_action = node.actions[0];
+  int largest_visit = nodes_[node.children_begin].explore_count;
+  for (int i = 0; i < node.actions.size(); ++i) {
+    const SearchNode& child = nodes_[node.children_begin + i];
+    if (child.explore_count > largest_visit) {
+      largest_visit = child.explore_count;
+      chosen_action = node.actions[i];
     }
-    return chosen_action;
   }
+  return chosen_action;
+}
 
-  SearchNode() {}
-};
+int SearchGraph::GetOrCreateNode(uint64_t key, bool force) {
+  auto iter = node_index_.find(key);
+  if (iter != node_index_.end()) return iter->second;
+  if (!force && OverMemoryBudget()) return -1;
+  const int index = nodes_.size();
+  nodes_.emplace_back();
+  node_index_.emplace(key, index);
+  return index;
+}
+
+void SearchGraph::Reset() {
+  nodes_.clear();
+  node_index_.clear();
+  child_entries_ = 0;
+}
+
+int64_t SearchGraph::ApproxBytes() const {
+  // The hash index estimate counts the bucket array plus, per entry, the
+  // key/value pair and the typical two pointers of node overhead.
+  const int64_t index_bytes =
+      static_cast<int64_t>(node_index_.bucket_count()) * sizeof(void*) +
+      static_cast<int64_t>(node_index_.size()) *
+          (sizeof(std::pair<uint64_t, int>) + 2 * sizeof(void*));
+  return static_cast<int64_t>(nodes_.capacity()) * sizeof(DagNode) +
+         child_entries_ * (sizeof(Action) + sizeof(int)) + index_bytes;
+}
+
+double SearchGraph::ChildValue(const DagNode& node, int child_index,
+                               double uct_c) const {
+  const int child_node_index = node.children[child_index];
+  if (child_node_index < 0) return std::numeric_limits<double>::infinity();
+  const DagNode& child = nodes_[child_node_index];
+  if (child.explore_count == 0)
+    return std::numeric_limits<double>::infinity();
+
+  // The shared child may have been visited more often than this parent; the
+  // UCT formula is unchanged, the exploitation term just starts out sharper.
+  return node.player_sign * child.total_reward / child.explore_count +
+         uct_c * sqrt(log(node.explore_count) / child.explore_count);
+}
+
+Action SearchGraph::MostVisitedAction(const DagNode& node) const {
+  Action chosen_action = node.actions[0];
+  int largest_visit = -1;
+  for (int i = 0; i < node.actions.size(); ++i) {
+    const int child_node_index = node.children[i];
+    const int visits =
+        child_node_index < 0 ? 0 : nodes_[child_node_index].explore_count;
+    if (visits > largest_visit) {
+      largest_visit = visits;
+      chosen_action = node.actions[i];
+    }
+  }
+  return chosen_action;
+}
+
+namespace {
 
 // The expansion portion of the MCTS algorithm.
-// Starting from the initial state, apply actions according to UCT until a new
-// node is added
-std::unique_ptr<State> ApplyTreePolicy(SearchNode* root,
-                                       std::vector<SearchNode*>* visit_path,
+// Starting from the root, apply actions according to UCT until a new
+// node is added. The visit path holds arena indices, since expanding a node
+// may grow the arena and invalidate node references.
+template <typename Rng>
+std::unique_ptr<State> ApplyTreePolicy(SearchTree* tree,
+                                       std::vector<int>* visit_path,
                                        const State& state, double uct_c,
-                                       std::mt19937* rng) {
-  // visit_path records each SearchNode that was visited during this expansion
-  visit_path->push_back(root);
+                                       Rng* rng) {
+  // visit_path records each node that was visited during this expansion
+  visit_path->push_back(0);
   auto working_state = state.Clone();
-  SearchNode* current_node = root;
+  int current_index = 0;
   while (!working_state->IsTerminal()) {
-    if (current_node->explore_count == 0) {
-      // This node is explored for the first time, so initialize this node.
-      for (auto action : working_state->LegalActions()) {
-        current_node->actions.push_back(action);
-        current_node->children.emplace_back();
+    if (tree->node(current_index).explore_count == 0) {
+      // A tree over its memory budget stops growing: the node is evaluated
+      // as a leaf and left unexpanded. The root is always expanded, so the
+      // search always has children to select an action from.
+      if (current_index != 0 && tree->OverMemoryBudget()) {
+        return working_state;
       }
-      current_node->player_sign =
+      // This node is explored for the first time, so initialize this node.
+      std::vector<Action> legal_actions = working_state->LegalActions();
+      const int children_begin = tree->AllocateChildren(legal_actions.size());
+      SearchNode& current_node = tree->node(current_index);
+      current_node.actions = std::move(legal_actions);
+      current_node.children_begin = children_begin;
+      current_node.player_sign =
           (working_state->CurrentPlayer() == 0) ? 1 : -1;
       return working_state;
     }
 
+    // A node whose expansion was refused by the budget stays a leaf on
+    // every revisit; its statistics keep accumulating through the backups.
+    if (tree->node(current_index).children_begin < 0) {
+      return working_state;
+    }
+
     // Find next state to visit.
     // For decision nodes, choose child with highest UCT value
     // For chance nodes, sample according to the distribution of that node
+    const SearchNode& current_node = tree->node(current_index);
     int max_index = -1;
     if (working_state->IsChanceNode()) {
-      auto outcomes = working_state->ChanceOutcomes();
-      double rand = std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
-      double s = 0;
+      const Action outcome =
+          working_state
+              ->SampleChanceOutcome(
+                  std::uniform_real_distribution<double>(0.0, 1.0)(*rng))
+              .first;
+      max_index = std::find(current_node.actions.begin(),
+                            current_node.actions.end(), outcome) -
+                  current_node.actions.begin();
+    } else {
+      double max_value = -std::numeric_limits<double>::infinity();
+      for (int index = 0; index < current_node.actions.size(); ++index) {
+        // The children sit contiguously in the arena; request the next
+        // one's statistics while this one is scored.
+        if (index + 1 < current_node.actions.size()) {
+          SPIEL_PREFETCH(
+              &tree->node(current_node.children_begin + index + 1));
+        }
+        double val = tree->ChildValue(current_node, index, uct_c);
+        if (val > max_value) {
+          max_index = index;
+          max_value = val;
+        }
+      }
+    }
 
-      for (max_index = 0; s < rand; ++max_index) {
-        s += outcomes[max_index].second;
+    // Apply the action and visit the next node
+    working_state->ApplyAction(current_node.actions[max_index]);
+    current_index = current_node.children_begin + max_index;
+    visit_path->push_back(current_index);
+  }
+
+  return working_state;
+}
+
+// The expansion portion of the transposition-aware search. The same descent
+// as ApplyTreePolicy, except that moving to a child resolves the reached
+// state by hash: a position seen before (along any move order) continues
+// into its existing node rather than a fresh one. With pw_c > 0 the search
+// also widens progressively: actions are kept sorted by prior, and only the
+// first ceil(pw_c * N^pw_alpha) of them compete in the selection at a node
+// with N visits.
+template <typename Rng>
+std::unique_ptr<State> ApplyDagTreePolicy(SearchGraph* graph,
+                                          std::vector<int>* visit_path,
+                                          int root_index, const State& state,
+                                          double uct_c,
+                                          const Evaluator& evaluator,
+                                          double pw_c, double pw_alpha,
+                                          Rng* rng) {
+  visit_path->push_back(root_index);
+  auto working_state = state.Clone();
+  int current_index = root_index;
+  while (!working_state->IsTerminal()) {
+    if (graph->node(current_index).explore_count == 0) {
+      if (graph->node(current_index).actions.empty()) {
+        // This node is explored for the first time, so initialize this node.
+        // (A node created earlier in this very simulation, via a cycle in the
+        // graph, is already initialized; it is still a leaf of this descent.)
+        std::vector<Action> legal_actions;
+        if (pw_c > 0) {
+          // Highest prior first: the widening schedule admits children in
+          // this order. The stable sort keeps LegalActions order on ties, so
+          // a uniform prior degrades to the unwidened ordering.
+          ActionsAndProbs prior = evaluator.Prior(*working_state);
+          std::stable_sort(prior.begin(), prior.end(),
+                           [](const std::pair<Action, double>& a,
+                              const std::pair<Action, double>& b) {
+                             return a.second > b.second;
+                           });
+          legal_actions.reserve(prior.size());
+          for (const std::pair<Action, double>& entry : prior) {
+            legal_actions.push_back(entry.first);
+          }
+        } else {
+          legal_actions = working_state->LegalActions();
+        }
+        DagNode& current_node = graph->node(current_index);
+        current_node.children.assign(legal_actions.size(), -1);
+        graph->AccountChildEntries(legal_actions.size());
+        current_node.actions = std::move(legal_actions);
+        current_node.player_sign =
+            (working_state->CurrentPlayer() == 0) ? 1 : -1;
       }
+      return working_state;
+    }
+
+    // Find next state to visit, as in ApplyTreePolicy.
+    const DagNode& current_node = graph->node(current_index);
+    int max_index = -1;
+    if (working_state->IsChanceNode()) {
+      const Action outcome =
+          working_state
+              ->SampleChanceOutcome(
+                  std::uniform_real_distribution<double>(0.0, 1.0)(*rng))
+              .first;
+      max_index = std::find(current_node.actions.begin(),
+                            current_node.actions.end(), outcome) -
+                  current_node.actions.begin();
     } else {
+      int num_eligible = current_node.actions.size();
+      if (pw_c > 0) {
+        num_eligible = std::min<int>(
+            num_eligible,
+            std::max<int>(1, std::ceil(pw_c * std::pow(
+                                                  current_node.explore_count,
+                                                  pw_alpha))));
+      }
       double max_value = -std::numeric_limits<double>::infinity();
-      for (int index = 0; index < current_node->actions.size(); ++index) {
-        double val = current_node->ChildValue(index, uct_c);
+      for (int index = 0; index < num_eligible; ++index) {
+        // As in the tree descent, request the next resolved child's
+        // statistics while this one is scored (unresolved links are -1 and
+        // score as unexplored without touching a node).
+        if (index + 1 < num_eligible &&
+            current_node.children[index + 1] >= 0) {
+          SPIEL_PREFETCH(&graph->node(current_node.children[index + 1]));
+        }
+        double val = graph->ChildValue(current_node, index, uct_c);
         if (val > max_value) {
           max_index = index;
           max_value = val;
@@ -108,49 +403,108 @@ std::unique_ptr<State> ApplyTreePolicy(SearchNode* root,
       }
     }
 
-    // Apply the action and visit the next node
-    working_state->ApplyAction(current_node->actions[max_index]);
-    current_node = &current_node->children[max_index];
-    visit_path->push_back(current_node);
+    // Apply the action, then resolve the reached state to its node. The
+    // lookup may append to the arena and invalidate current_node, so go back
+    // through the graph to record the link.
+    working_state->ApplyAction(current_node.actions[max_index]);
+    int child_index = current_node.children[max_index];
+    if (child_index < 0) {
+      child_index = graph->GetOrCreateNode(working_state->HashValue());
+      if (child_index < 0) {
+        // A graph over its memory budget refuses new nodes; treat the
+        // frontier as a leaf. The link stays -1, so a later search with
+        // room (or after a Reset) can still resolve it.
+        return working_state;
+      }
+      graph->node(current_index).children[max_index] = child_index;
+    }
+    current_index = child_index;
+    visit_path->push_back(current_index);
   }
 
   return working_state;
 }
 }  // namespace
 
+ActionsAndProbs Evaluator::Prior(const State& state) const {
+  if (state.IsChanceNode()) return state.ChanceOutcomes();
+  std::vector<Action> legal_actions = state.LegalActions();
+  ActionsAndProbs prior;
+  prior.reserve(legal_actions.size());
+  for (Action action : legal_actions) {
+    prior.emplace_back(action, 1.0 / legal_actions.size());
+  }
+  return prior;
+}
+
+std::vector<double> SingleStateBatchEvaluator::evaluate(
+    const std::vector<const State*>& states) const {
+  std::vector<double> values;
+  values.reserve(states.size());
+  for (const State* state : states) {
+    values.push_back(evaluator_.evaluate(*state));
+  }
+  return values;
+}
+
 double RandomRolloutEvaluator::evaluate(const State& state) const {
+  // A local generator keeps concurrent calls from racing on shared state;
+  // the atomic counter keeps the draws distinct across calls.
+  FastRng rng(num_evaluations_++);
   double result = 0;
   for (int i = 0; i < n_rollouts_; ++i) {
     auto working_state = state.Clone();
-    while (!working_state->IsTerminal()) {
+    // Rollout states are only stepped forward, so their history is never
+    // read; skip maintaining it when the game allows.
+    if (history_independent_states_) working_state->DisableHistoryTracking();
+    int num_moves = 0;
+    while (!working_state->IsTerminal() &&
+           (max_rollout_length_ <= 0 || num_moves < max_rollout_length_)) {
+      ++num_moves;
       if (working_state->IsChanceNode()) {
-        auto outcomes = working_state->ChanceOutcomes();
-        Action action = SampleChanceOutcome(
-            outcomes, std::uniform_real_distribution<double>(0.0, 1.0)(rng_));
+        Action action =
+            working_state
+                ->SampleChanceOutcome(
+                    std::uniform_real_distribution<double>(0.0, 1.0)(rng))
+                .first;
         working_state->ApplyAction(action);
       } else {
-        auto actions = working_state->LegalActions();
-        std::uniform_int_distribution<int> dist(0, actions.size() - 1);
-        int index = dist(rng_);
-        working_state->ApplyAction(actions[index]);
+        Action action = kInvalidAction;
+        if (playout_policy_ != nullptr) {
+          action = playout_policy_->SamplePlayoutAction(*working_state, &rng);
+        }
+        if (action == kInvalidAction) {
+          auto actions = working_state->LegalActions();
+          std::uniform_int_distribution<int> dist(0, actions.size() - 1);
+          action = actions[dist(rng)];
+        }
+        working_state->ApplyAction(action);
       }
     }
-    result += working_state->PlayerReturn(0);
+    // A playout cut short by the length cap is scored statically in place.
+    result += working_state->IsTerminal() ? working_state->PlayerReturn(0)
+                                          : working_state->QuickEvaluate();
   }
   return result / n_rollouts_;
 }
 
-Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
-                 const Evaluator& evaluator) {
-  std::mt19937 rng;
-  SearchNode root;
-  std::vector<SearchNode*> visit_path;
+namespace {
+
+template <typename Rng>
+Action MCTSearchImpl(const State& state, double uct_c, int max_search_nodes,
+                     const Evaluator& evaluator, SearchTree* tree, Rng* rng,
+                     SearchDeadline* deadline = nullptr) {
+  SPIEL_STATS_TIMER("mcts/search");
+  std::vector<int> visit_path;
   visit_path.reserve(64);
   for (int i = 0; i < max_search_nodes; ++i) {
+    // The clock is consulted only after the first simulation, so the root
+    // always has statistics to choose an action from.
+    if (i > 0 && deadline != nullptr && deadline->Expired()) break;
+    SPIEL_STATS_INC("mcts/simulations");
     visit_path.clear();
     // First expand the node
-    auto working_state =
-        ApplyTreePolicy(&root, &visit_path, state, uct_c, &rng);
+    auto working_state = ApplyTreePolicy(tree, &visit_path, state, uct_c, rng);
 
     // Now evaluate this node
     double node_value;
@@ -160,17 +514,435 @@ Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
       node_value = evaluator.evaluate(*working_state);
 
     // Propagate values back
-    for (auto node : visit_path) {
-      node->total_reward += node_value;
-      node->explore_count += 1;
+    for (int node_index : visit_path) {
+      SearchNode& node = tree->node(node_index);
+      node.total_reward += node_value;
+      node.explore_count += 1;
     }
   }
 
-  return root.MostVisitedAction();
+  SPIEL_STATS_SET_GAUGE("mcts/tree_nodes", tree->num_nodes());
+  SPIEL_STATS_SET_GAUGE("mcts/tree_bytes", tree->ApproxBytes());
+  return tree->MostVisitedAction(tree->root());
+}
+
+Action MCTSearchDagImpl(const State& state, double uct_c,
+                        int max_search_nodes, const Evaluator& evaluator,
+                        double pw_c, double pw_alpha, SearchGraph* graph,
+                        FastRng* rng) {
+  SPIEL_STATS_TIMER("mcts/search_dag");
+  const int root_index =
+      graph->GetOrCreateNode(state.HashValue(), /*force=*/true);
+  std::vector<int> visit_path;
+  visit_path.reserve(64);
+  for (int i = 0; i < max_search_nodes; ++i) {
+    SPIEL_STATS_INC("mcts/simulations");
+    visit_path.clear();
+    // First expand the node
+    auto working_state =
+        ApplyDagTreePolicy(graph, &visit_path, root_index, state, uct_c,
+                           evaluator, pw_c, pw_alpha, rng);
+
+    // Now evaluate this node
+    double node_value;
+    if (working_state->IsTerminal())
+      node_value = working_state->PlayerReturn(0);
+    else
+      node_value = evaluator.evaluate(*working_state);
+
+    // Propagate values back. A node the descent crossed twice (a cycle in
+    // the graph) is credited once per crossing, as in path-based backup.
+    for (int node_index : visit_path) {
+      DagNode& node = graph->node(node_index);
+      node.total_reward += node_value;
+      node.explore_count += 1;
+    }
+  }
+
+  SPIEL_STATS_SET_GAUGE("mcts/graph_nodes", graph->num_nodes());
+  SPIEL_STATS_SET_GAUGE("mcts/graph_bytes", graph->ApproxBytes());
+  return graph->MostVisitedAction(graph->node(root_index));
+}
+
+}  // namespace
+
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree,
+                 std::mt19937* rng) {
+  return MCTSearchImpl(state, uct_c, max_search_nodes, evaluator, tree, rng);
+}
+
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree, FastRng* rng) {
+  return MCTSearchImpl(state, uct_c, max_search_nodes, evaluator, tree, rng);
+}
+
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree) {
+  FastRng rng;
+  return MCTSearch(state, uct_c, max_search_nodes, evaluator, tree, &rng);
+}
+
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator) {
+  SearchTree tree;
+  return MCTSearch(state, uct_c, max_search_nodes, evaluator, &tree);
+}
+
+Action MCTSearchTimed(const State& state, double uct_c, int max_search_nodes,
+                      double max_seconds, const Evaluator& evaluator,
+                      SearchTree* tree, FastRng* rng) {
+  // A clock read is negligible next to a simulation (a full rollout), so
+  // check every simulation and keep the overshoot to a single one.
+  SearchDeadline deadline(max_seconds, /*check_interval=*/1);
+  return MCTSearchImpl(state, uct_c, max_search_nodes, evaluator, tree, rng,
+                       &deadline);
+}
+
+Action MCTSearchTimed(const State& state, double uct_c, int max_search_nodes,
+                      double max_seconds, const Evaluator& evaluator,
+                      SearchTree* tree) {
+  FastRng rng;
+  return MCTSearchTimed(state, uct_c, max_search_nodes, max_seconds, evaluator,
+                        tree, &rng);
+}
+
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator, SearchGraph* graph,
+                    FastRng* rng) {
+  return MCTSearchDagImpl(state, uct_c, max_search_nodes, evaluator,
+                          /*pw_c=*/0, /*pw_alpha=*/0, graph, rng);
+}
+
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator, SearchGraph* graph) {
+  FastRng rng;
+  return MCTSearchDag(state, uct_c, max_search_nodes, evaluator, graph, &rng);
+}
+
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator) {
+  SearchGraph graph;
+  return MCTSearchDag(state, uct_c, max_search_nodes, evaluator, &graph);
+}
+
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha, SearchGraph* graph, FastRng* rng) {
+  SPIEL_CHECK_GT(pw_c, 0);
+  SPIEL_CHECK_GT(pw_alpha, 0);
+  return MCTSearchDagImpl(state, uct_c, max_search_nodes, evaluator, pw_c,
+                          pw_alpha, graph, rng);
+}
+
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha, SearchGraph* graph) {
+  FastRng rng;
+  return MCTSearchWidened(state, uct_c, max_search_nodes, evaluator, pw_c,
+                          pw_alpha, graph, &rng);
+}
+
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha) {
+  SearchGraph graph;
+  return MCTSearchWidened(state, uct_c, max_search_nodes, evaluator, pw_c,
+                          pw_alpha, &graph);
+}
+
+std::vector<ChanceOutcomeSearchResult> MCTSearchChanceOutcomes(
+    const State& state, double uct_c, int max_search_nodes,
+    const Evaluator& evaluator, int num_threads,
+    std::vector<SearchTree>* trees) {
+  SPIEL_CHECK_TRUE(state.IsChanceNode());
+  SPIEL_CHECK_GE(num_threads, 1);
+  const ActionsAndProbs outcomes = state.ChanceOutcomes();
+  if (trees != nullptr && trees->size() != outcomes.size()) {
+    trees->clear();
+    trees->resize(outcomes.size());
+  }
+  std::vector<ChanceOutcomeSearchResult> results(outcomes.size());
+
+  // The workers pull outcomes off a shared counter: with more outcomes than
+  // threads (21 distinct backgammon rolls on a handful of cores) this
+  // balances the uneven per-outcome budgets without any further
+  // coordination.
+  std::atomic<int> next_outcome(0);
+  auto search_outcomes = [&](int thread_num) {
+    FastRng rng(thread_num);
+    for (int i = next_outcome++; i < outcomes.size(); i = next_outcome++) {
+      const Action outcome = outcomes[i].first;
+      const double probability = outcomes[i].second;
+      std::unique_ptr<State> child = state.Child(outcome);
+      const int simulations = std::max(
+          1, static_cast<int>(max_search_nodes * probability + 0.5));
+      SearchTree local_tree;
+      SearchTree* tree = trees != nullptr ? &(*trees)[i] : &local_tree;
+      const Action best_action =
+          MCTSearch(*child, uct_c, simulations, evaluator, tree, &rng);
+      const SearchNode& root = tree->root();
+      results[i].outcome = outcome;
+      results[i].probability = probability;
+      results[i].best_action = best_action;
+      results[i].value = root.total_reward / root.explore_count;
+    }
+  };
+
+  if (num_threads == 1) {
+    search_outcomes(0);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      workers.emplace_back(search_outcomes, t);
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+  return results;
+}
+
+std::vector<ChanceOutcomeSearchResult> MCTSearchChanceOutcomes(
+    const State& state, double uct_c, int max_search_nodes,
+    const Evaluator& evaluator, int num_threads) {
+  return MCTSearchChanceOutcomes(state, uct_c, max_search_nodes, evaluator,
+                                 num_threads, /*trees=*/nullptr);
+}
+
+namespace {
+// Reward penalty applied to a selected path until its evaluation arrives.
+constexpr double kVirtualLoss = 1.0;
+}  // namespace
+
+Action MCTSearchBatched(const State& state, double uct_c, int max_search_nodes,
+                        const BatchEvaluator& evaluator, int batch_size,
+                        SearchTree* tree) {
+  SPIEL_CHECK_GE(batch_size, 1);
+  FastRng rng;
+  std::vector<std::vector<int>> pending_paths;
+  std::vector<std::unique_ptr<State>> pending_states;
+  int num_simulations = 0;
+  while (num_simulations < max_search_nodes) {
+    pending_paths.clear();
+    pending_states.clear();
+
+    // Collect a batch of leaves. A virtual loss guards each selected path:
+    // the explore count goes up right away (it doubles as the real visit)
+    // and the reward is penalized from the parent's perspective, so the
+    // next descent is steered away from paths awaiting evaluation.
+    while (pending_paths.size() < batch_size &&
+           num_simulations < max_search_nodes) {
+      std::vector<int> visit_path;
+      auto working_state =
+          ApplyTreePolicy(tree, &visit_path, state, uct_c, &rng);
+      tree->node(visit_path[0]).explore_count += 1;
+      for (int k = 1; k < visit_path.size(); ++k) {
+        SearchNode& node = tree->node(visit_path[k]);
+        node.explore_count += 1;
+        node.total_reward -=
+            kVirtualLoss * tree->node(visit_path[k - 1]).player_sign;
+      }
+      pending_paths.push_back(std::move(visit_path));
+      pending_states.push_back(std::move(working_state));
+      ++num_simulations;
+    }
+
+    // Flush: evaluate all the non-terminal leaves in one call.
+    std::vector<const State*> to_evaluate;
+    for (const auto& pending_state : pending_states) {
+      if (!pending_state->IsTerminal()) to_evaluate.push_back(pending_state.get());
+    }
+    std::vector<double> values;
+    if (!to_evaluate.empty()) values = evaluator.evaluate(to_evaluate);
+    SPIEL_CHECK_EQ(values.size(), to_evaluate.size());
+
+    // Back up the values, reverting each path's virtual loss.
+    int value_index = 0;
+    for (int p = 0; p < pending_paths.size(); ++p) {
+      const double node_value = pending_states[p]->IsTerminal()
+                                    ? pending_states[p]->PlayerReturn(0)
+                                    : values[value_index++];
+      const std::vector<int>& visit_path = pending_paths[p];
+      tree->node(visit_path[0]).total_reward += node_value;
+      for (int k = 1; k < visit_path.size(); ++k) {
+        tree->node(visit_path[k]).total_reward +=
+            node_value +
+            kVirtualLoss * tree->node(visit_path[k - 1]).player_sign;
+      }
+    }
+  }
+
+  return tree->MostVisitedAction(tree->root());
+}
+
+Action MCTSearchBatched(const State& state, double uct_c, int max_search_nodes,
+                        const BatchEvaluator& evaluator, int batch_size) {
+  SearchTree tree;
+  return MCTSearchBatched(state, uct_c, max_search_nodes, evaluator,
+                          batch_size, &tree);
+}
+
+void MCTSBot::AdvanceTree(const State& state) {
+  std::vector<Action> history = state.History();
+  if (!has_tree_ || history.size() < root_history_.size() ||
+      !std::equal(root_history_.begin(), root_history_.end(),
+                  history.begin())) {
+    // The state does not extend the one we searched last; start over.
+    has_tree_ = false;
+  }
+
+  // Re-root on each action taken since the last search.
+  for (int i = root_history_.size(); has_tree_ && i < history.size(); ++i) {
+    const SearchNode& root = tree_.root();
+    int child_index = -1;
+    for (int j = 0; j < root.actions.size(); ++j) {
+      if (root.actions[j] == history[i]) {
+        child_index = j;
+        break;
+      }
+    }
+    if (child_index >= 0 &&
+        tree_.node(root.children_begin + child_index).explore_count > 0) {
+      tree_.ReRoot(root.children_begin + child_index);
+    } else {
+      // The subtree below this action was never explored (or the action was
+      // a chance outcome we never expanded); nothing worth keeping.
+      has_tree_ = false;
+    }
+  }
+
+  if (!has_tree_) {
+    tree_.Reset();
+    has_tree_ = true;
+  }
+  root_history_ = std::move(history);
+}
+
+Action MCTSBot::ParallelSearch(const State& state) {
+  const int sims_per_worker =
+      (max_search_nodes_ + num_threads_ - 1) / num_threads_;
+  std::vector<SearchTree> worker_trees(num_threads_);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    workers.emplace_back([this, t, &state, &worker_trees, sims_per_worker]() {
+      FastRng rng(t);
+      // Each worker keeps its own deadline; they all start (roughly) now, so
+      // the workers stop together when there is a time budget.
+      MCTSearchTimed(state, uct_c_, sims_per_worker, max_seconds_, evaluator_,
+                     &worker_trees[t], &rng);
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  // The persistent tree keeps whatever was reused from previous moves; the
+  // workers' fresh statistics are added on top.
+  for (const SearchTree& worker_tree : worker_trees) {
+    tree_.Merge(worker_tree);
+  }
+  return tree_.MostVisitedAction(tree_.root());
+}
+
+void MCTSBot::StartPondering(const State& state, Action action) {
+  std::unique_ptr<State> ponder_state = state.Clone();
+  ponder_state->ApplyAction(action);
+  if (ponder_state->IsTerminal()) return;
+
+  // Re-root on our own move now instead of at the next Step, so the ponder
+  // search grows exactly the subtree the next search continues from.
+  const SearchNode& root = tree_.root();
+  int child_index = -1;
+  for (int i = 0; i < root.actions.size(); ++i) {
+    if (root.actions[i] == action) {
+      child_index = i;
+      break;
+    }
+  }
+  if (child_index >= 0 &&
+      tree_.node(root.children_begin + child_index).explore_count > 0) {
+    tree_.ReRoot(root.children_begin + child_index);
+  } else {
+    // The chosen subtree was never explored; ponder from a fresh root.
+    tree_.Reset();
+  }
+  root_history_.push_back(action);
+
+  stop_ponder_.store(false, std::memory_order_relaxed);
+  ponder_thread_ =
+      std::thread(&MCTSBot::PonderLoop, this, std::move(ponder_state));
+}
+
+void MCTSBot::StopPondering() {
+  if (!ponder_thread_.joinable()) return;
+  stop_ponder_.store(true, std::memory_order_relaxed);
+  ponder_thread_.join();
+}
+
+void MCTSBot::PonderLoop(std::unique_ptr<State> state) {
+  // Searching in small slices bounds the stop latency to one slice while
+  // keeping the per-slice bookkeeping negligible.
+  constexpr int kPonderSliceSimulations = 128;
+  FastRng rng;
+  while (!stop_ponder_.load(std::memory_order_relaxed)) {
+    MCTSearch(*state, uct_c_, kPonderSliceSimulations, evaluator_, &tree_,
+              &rng);
+  }
+}
+
+namespace {
+
+constexpr uint64_t kBotSnapshotMagic = 0x6d637473;  // "mcts"
+constexpr uint64_t kBotSnapshotVersion = 1;
+
+}  // namespace
+
+void MCTSBot::Serialize(std::string* buffer) const {
+  // The tree may only be touched with the ponder thread stopped.
+  const_cast<MCTSBot*>(this)->StopPondering();
+  AppendVarint(kBotSnapshotMagic, buffer);
+  AppendVarint(kBotSnapshotVersion, buffer);
+  AppendVarint(std::hash<std::string>()(game_.GetType().short_name), buffer);
+  AppendVarint(has_tree_ ? 1 : 0, buffer);
+  AppendVarint(root_history_.size(), buffer);
+  for (Action action : root_history_) {
+    AppendVarint(action, buffer);
+  }
+  tree_.Serialize(buffer);
+}
+
+void MCTSBot::Restore(const std::string& buffer) {
+  StopPondering();
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  const std::size_t size = buffer.size();
+  std::size_t offset = 0;
+  SPIEL_CHECK_EQ(ReadVarint(data, size, &offset), kBotSnapshotMagic);
+  SPIEL_CHECK_EQ(ReadVarint(data, size, &offset), kBotSnapshotVersion);
+  SPIEL_CHECK_EQ(ReadVarint(data, size, &offset),
+                 std::hash<std::string>()(game_.GetType().short_name));
+  has_tree_ = ReadVarint(data, size, &offset) != 0;
+  root_history_.resize(ReadVarint(data, size, &offset));
+  for (Action& action : root_history_) {
+    action = ReadVarint(data, size, &offset);
+  }
+  tree_.Deserialize(data, size, &offset);
+  // Trailing bytes mean the snapshot was not produced by Serialize.
+  SPIEL_CHECK_EQ(offset, size);
 }
 
 std::pair<ActionsAndProbs, Action> MCTSBot::Step(const State& state) {
-  auto mcts_action = MCTSearch(state, uct_c_, max_search_nodes_, evaluator_);
+  // The tree may only be touched with the ponder thread stopped.
+  StopPondering();
+  AdvanceTree(state);
+  FastRng rng;
+  Action mcts_action =
+      num_threads_ > 1
+          ? ParallelSearch(state)
+          : MCTSearchTimed(state, uct_c_, max_search_nodes_, max_seconds_,
+                           evaluator_, &tree_, &rng);
+  if (ponder_) StartPondering(state, mcts_action);
   return {{{mcts_action, 1.0}}, mcts_action};
 }
 
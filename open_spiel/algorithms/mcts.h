@@ -15,8 +15,12 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_MCTS_H_
 
+#include <atomic>
 #include <memory>
 #include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
@@ -27,24 +31,279 @@ namespace algorithms {
 // Abstract class representing an evaluation function for a game.
 // The evaluation function takes in an intermediate state in the game and
 // returns an evaluation of that state, which should correlate with chances of
-// winning the game for player 0.
+// winning the game for player 0. Implementations must be safe to call from
+// several threads at once, since the parallel search mode of MCTSBot shares
+// one evaluator among its workers.
 class Evaluator {
  public:
   virtual ~Evaluator() = default;
   virtual double evaluate(const State& state) const = 0;
+
+  // A prior over the legal actions of the state, used by the
+  // progressive-widening search to decide the order in which children are
+  // admitted. The default is uniform for decision nodes and the outcome
+  // distribution for chance nodes; evaluators with a policy head should
+  // override this.
+  virtual ActionsAndProbs Prior(const State& state) const;
+};
+
+// An evaluator that scores a whole batch of states in one call. This is the
+// interface to implement for evaluators whose backend is much more efficient
+// on batches than on single states, e.g. a neural network running on an
+// accelerator; the batched search loop below collects leaves and flushes
+// them through this in configurable batch sizes.
+class BatchEvaluator {
+ public:
+  virtual ~BatchEvaluator() = default;
+  // Returns one evaluation per state, aligned with the input.
+  virtual std::vector<double> evaluate(
+      const std::vector<const State*>& states) const = 0;
+};
+
+// Adapts a single-state Evaluator to the batch interface, evaluating the
+// batch one state at a time. Useful as a drop-in until a genuinely batched
+// evaluator is available.
+class SingleStateBatchEvaluator : public BatchEvaluator {
+ public:
+  explicit SingleStateBatchEvaluator(const Evaluator& evaluator)
+      : evaluator_(evaluator) {}
+  std::vector<double> evaluate(
+      const std::vector<const State*>& states) const override;
+
+ private:
+  const Evaluator& evaluator_;
+};
+
+// How a playout (rollout) picks the action to play at a decision node. The
+// uniform-random default is correct for any game but wasteful in games with
+// long playouts and obvious moves; a game-specific policy (see
+// playout_policies.h) both shortens the playouts and raises their signal, so
+// the search needs fewer simulations per decision. Implementations must be
+// safe to call from several threads at once, like the evaluators above.
+class PlayoutPolicy {
+ public:
+  virtual ~PlayoutPolicy() = default;
+
+  // Returns the action to play at `state`, which is a non-terminal decision
+  // node, or kInvalidAction to defer to a uniform-random choice over
+  // LegalActions(). Deferring lets a policy handle only the positions its
+  // heuristics speak to (e.g. captures available) at no cost elsewhere.
+  virtual Action SamplePlayoutAction(const State& state, FastRng* rng)
+      const = 0;
 };
 
 // A simple evaluator that returns the average outcome of playing random actions
 // from the given state until the end of the game.
 // n_rollouts is the number of random outcomes to be considered.
+// Pass game.GetType().history_independent_state for
+// history_independent_states: when true, the rollout states skip history
+// tracking entirely (see State::DisableHistoryTracking), bringing a playout
+// step down to pure game-logic cost.
+// If playout_policy is non-null it chooses the playout actions at decision
+// nodes (chance nodes are always sampled by their outcome distribution); the
+// policy must outlive the evaluator.
+// A positive max_rollout_length caps each playout at that many moves; a
+// playout cut short is scored with State::QuickEvaluate(), so the cap may
+// only be set for games whose GameType sets provides_quick_evaluate. In
+// games whose playouts run long (80+ moves in backgammon), a cap of 10-20
+// multiplies the simulations per second at little cost in signal.
 class RandomRolloutEvaluator : public Evaluator {
  public:
-  explicit RandomRolloutEvaluator(int n_rollouts) : n_rollouts_{n_rollouts} {}
+  explicit RandomRolloutEvaluator(int n_rollouts,
+                                  bool history_independent_states = false,
+                                  const PlayoutPolicy* playout_policy = nullptr,
+                                  int max_rollout_length = 0)
+      : n_rollouts_{n_rollouts},
+        history_independent_states_{history_independent_states},
+        playout_policy_{playout_policy},
+        max_rollout_length_{max_rollout_length} {}
   double evaluate(const State& state) const override;
 
  private:
   int n_rollouts_;
-  mutable std::mt19937 rng_;
+  bool history_independent_states_;
+  const PlayoutPolicy* playout_policy_;
+  int max_rollout_length_;
+  // Each call draws its rollouts with its own generator, seeded from this
+  // counter, so that concurrent calls do not race on shared rng state.
+  mutable std::atomic<int> num_evaluations_{0};
+};
+
+// A node in the search tree for MCTS. Nodes live in the arena of a
+// SearchTree; a node's children occupy the contiguous index range
+// [children_begin, children_begin + actions.size()) of that arena, with
+// actions[i] leading to the child at children_begin + i.
+struct SearchNode {
+  int explore_count = 0;    // number of times this node was explored
+  int player_sign = 0;      // 1 for player 0, -1 for player 1
+  double total_reward = 0;  // total reward passing through this node
+  int children_begin = -1;  // arena index of the first child, -1 if unexpanded
+
+  // The legal actions at this node, aligned with its children.
+  std::vector<Action> actions;
+
+  SearchNode() {}
+};
+
+// A monotonic arena holding all the nodes of one search tree, rooted at
+// index 0. Each node's children are allocated contiguously, so the UCT
+// descent walks dense index ranges instead of chasing per-node heap
+// allocations; nothing is freed until the tree is re-rooted or reset.
+class SearchTree {
+ public:
+  SearchTree() { Reset(); }
+
+  SearchNode& root() { return nodes_[0]; }
+  SearchNode& node(int index) { return nodes_[index]; }
+  const SearchNode& node(int index) const { return nodes_[index]; }
+  int num_nodes() const { return nodes_.size(); }
+
+  // Appends `count` fresh unexpanded nodes to the arena and returns the
+  // index of the first. May invalidate node references, but not indices.
+  int AllocateChildren(int count);
+
+  // Discards everything but the subtree below the given node, compacting it
+  // to the front of the arena with its statistics intact. Used by MCTSBot to
+  // advance the tree past an observed action between moves.
+  void ReRoot(int new_root_index);
+
+  // Clears the tree back to a single unexplored root.
+  void Reset();
+
+  // Approximate heap footprint of the arena in bytes: the node array plus
+  // one action entry per allocated child. Vector headers and allocator
+  // overhead are not counted, so treat the result as a lower bound and
+  // leave budgets some headroom.
+  int64_t ApproxBytes() const {
+    return static_cast<int64_t>(nodes_.capacity()) * sizeof(SearchNode) +
+           static_cast<int64_t>(num_nodes() - 1) * sizeof(Action);
+  }
+
+  // Caps the arena at roughly max_bytes (non-positive, the default, means
+  // unlimited). A search whose tree is over budget stops growing it: nodes
+  // that would be expanded are evaluated as leaves instead (on every visit),
+  // while simulations and backups continue, so the search degrades smoothly
+  // rather than being OOM-killed. The root is always expanded. ReRoot and
+  // Reset free nodes and give the next search room again; Merge is not
+  // capped, as it copies subtrees a worker's own budget already admitted.
+  void SetMemoryBudget(int64_t max_bytes) { max_bytes_ = max_bytes; }
+
+  // Whether a budget is set and the arena has reached it.
+  bool OverMemoryBudget() const {
+    return max_bytes_ > 0 && ApproxBytes() >= max_bytes_;
+  }
+
+  // Adds the statistics of `other` (a tree built by searching the same
+  // state) into this tree, copying over any subtrees this tree has not
+  // expanded itself. Used to combine the per-worker trees of the parallel
+  // search mode.
+  void Merge(const SearchTree& other);
+
+  // UCT value of the given child of a node.
+  double ChildValue(const SearchNode& node, int child_index,
+                    double uct_c) const;
+
+  // Returns the most visited action at the given node.
+  Action MostVisitedAction(const SearchNode& node) const;
+
+  // Appends a compact binary snapshot of the whole arena to *buffer. The
+  // arena layout (contiguous child index ranges) is preserved, so restoring
+  // yields a byte-for-byte equivalent tree.
+  void Serialize(std::string* buffer) const;
+
+  // Rebuilds the tree from a snapshot written by Serialize, reading from
+  // data at *offset and advancing it past the snapshot. Fails fatally on a
+  // truncated or inconsistent snapshot.
+  void Deserialize(const uint8_t* data, std::size_t size, std::size_t* offset);
+
+ private:
+  void MergeSubtree(int index, const SearchTree& other, int other_index);
+
+  std::vector<SearchNode> nodes_;
+  int64_t max_bytes_ = 0;
+};
+
+// A node in the search graph of the transposition-aware search below. Unlike
+// SearchNode, children are linked individually: children[i] is the arena
+// index of the node reached by actions[i], or -1 until that state is first
+// visited, at which point it may resolve to a node some other line of play
+// created earlier.
+struct DagNode {
+  int explore_count = 0;    // number of times this node was explored
+  int player_sign = 0;      // 1 for player 0, -1 for player 1
+  double total_reward = 0;  // total reward passing through this node
+
+  // The legal actions at this node, and the child each one leads to.
+  std::vector<Action> actions;
+  std::vector<int> children;
+
+  DagNode() {}
+};
+
+// The arena of a transposition-aware search, keyed by State::HashValue():
+// states that transpose into one another share a single node, so statistics
+// gathered along one move order are reused by every other order reaching the
+// same position. Games that set GameType::provides_hash_value have cheap
+// incremental-style keys; the default string hash is correct but slower.
+//
+// Note that a hash that deliberately ignores part of the state (e.g. oware
+// and chess drop the repetition history) merges states that differ only in
+// that part; this is the usual transposition-table approximation. Graphs may
+// contain cycles when real positions can repeat, but a descent is bounded by
+// the actual game state reaching a terminal, never by the graph shape.
+class SearchGraph {
+ public:
+  SearchGraph() {}
+
+  DagNode& node(int index) { return nodes_[index]; }
+  const DagNode& node(int index) const { return nodes_[index]; }
+  int num_nodes() const { return nodes_.size(); }
+
+  // Returns the arena index of the node keyed by `key`, appending a fresh
+  // unexpanded node if the key has not been seen before. May invalidate node
+  // references, but not indices. If creating the node would take the graph
+  // over its memory budget, returns -1 instead; the search loops treat a
+  // refused child as a leaf. With force = true the budget is ignored, which
+  // the searches use for their root so a search always has one.
+  int GetOrCreateNode(uint64_t key, bool force = false);
+
+  // Clears the graph back to empty.
+  void Reset();
+
+  // Approximate heap footprint in bytes: the node array, the per-node action
+  // and child arrays, and an estimate of the hash index. A lower bound, as
+  // with SearchTree::ApproxBytes; leave budgets some headroom.
+  int64_t ApproxBytes() const;
+
+  // Caps the graph at roughly max_bytes (non-positive, the default, means
+  // unlimited). Once over budget, GetOrCreateNode refuses to create new
+  // nodes and the search evaluates the frontier as leaves; statistics keep
+  // accumulating in the nodes already present. Reset clears the budget's
+  // usage but not the budget itself.
+  void SetMemoryBudget(int64_t max_bytes) { max_bytes_ = max_bytes; }
+
+  // Whether a budget is set and the graph has reached it.
+  bool OverMemoryBudget() const {
+    return max_bytes_ > 0 && ApproxBytes() >= max_bytes_;
+  }
+
+  // Called by the search loops when a node's action and child arrays are
+  // filled in at expansion, so ApproxBytes can account for them without
+  // walking the arena.
+  void AccountChildEntries(int count) { child_entries_ += count; }
+
+  // UCT value of the given child of a node. Children whose state has never
+  // been reached are unexplored, hence infinite.
+  double ChildValue(const DagNode& node, int child_index, double uct_c) const;
+
+  // Returns the most visited action at the given node.
+  Action MostVisitedAction(const DagNode& node) const;
+
+ private:
+  std::vector<DagNode> nodes_;
+  std::unordered_map<uint64_t, int> node_index_;
+  int64_t child_entries_ = 0;
+  int64_t max_bytes_ = 0;
 };
 
 // A vanilla Monte-Carlo Tree Search algorithm.
@@ -68,22 +327,187 @@ class RandomRolloutEvaluator : public Evaluator {
 Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
                  const Evaluator& evaluator);
 
+// Same as above, but continues the search in the given tree, which may
+// already hold statistics from previous searches of the same state.
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree);
+
+// Same as above with an explicit random number generator, so that the
+// workers of a parallel search sample chance nodes independently. Either
+// engine works; FastRng (spiel_utils.h) is what the internal searches use.
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree,
+                 std::mt19937* rng);
+Action MCTSearch(const State& state, double uct_c, int max_search_nodes,
+                 const Evaluator& evaluator, SearchTree* tree, FastRng* rng);
+
+// Same as MCTSearch with an additional wall-clock budget: the search stops
+// at whichever of the simulation count and max_seconds runs out first (a
+// non-positive max_seconds means no time limit). At least one simulation
+// always runs, so the returned action is always legal. Under a per-move time
+// control this spends the whole budget on fast positions instead of the
+// fixed simulation count sized for the slowest ones.
+Action MCTSearchTimed(const State& state, double uct_c, int max_search_nodes,
+                      double max_seconds, const Evaluator& evaluator,
+                      SearchTree* tree, FastRng* rng);
+Action MCTSearchTimed(const State& state, double uct_c, int max_search_nodes,
+                      double max_seconds, const Evaluator& evaluator,
+                      SearchTree* tree);
+
+// A transposition-aware variant of MCTSearch over a SearchGraph: simulations
+// that reach the same position through different move orders pool their
+// statistics in one shared node instead of duplicating the subtree below it.
+// In games where transpositions are common (connect_four, oware) this
+// multiplies the effective simulations per position at fixed memory. The
+// graph may be reused across searches of the same or successive states; the
+// root is found by hash, so statistics below it carry over.
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator, SearchGraph* graph,
+                    FastRng* rng);
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator, SearchGraph* graph);
+Action MCTSearchDag(const State& state, double uct_c, int max_search_nodes,
+                    const Evaluator& evaluator);
+
+// A progressive-widening variant of the transposition-aware search, for
+// games whose branching factor would otherwise explode memory and spread the
+// simulation budget too thin (backgammon's move sequences, wide goofspiel
+// nodes). A node's actions are sorted by Evaluator::Prior at expansion, and
+// only the first ceil(pw_c * N^pw_alpha) of them (at least one, at most all)
+// are eligible for selection after N visits, so both the children linked and
+// the simulations spent scale with how often the node is actually reached.
+// Chance nodes are never widened; their outcomes are sampled by probability
+// as usual. Typical values: pw_c = 1.0, pw_alpha in [0.25, 0.5].
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha, SearchGraph* graph, FastRng* rng);
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha, SearchGraph* graph);
+Action MCTSearchWidened(const State& state, double uct_c, int max_search_nodes,
+                        const Evaluator& evaluator, double pw_c,
+                        double pw_alpha);
+
+// The result of searching one outcome of a chance node: the subtree's most
+// visited action and its root value estimate (for player 0), alongside the
+// outcome and its probability.
+struct ChanceOutcomeSearchResult {
+  Action outcome = kInvalidAction;
+  double probability = 0;
+  Action best_action = kInvalidAction;
+  double value = 0;
+};
+
+// Root-parallel search of a chance node, e.g. a backgammon position before
+// the roll: each outcome's subtree is searched by its own worker, with the
+// simulation budget split across the outcomes in proportion to their
+// probability (at least one simulation each). Chance outcomes are natural
+// fork points: the subtrees are disjoint, so beyond the shared evaluator
+// (which must be thread-safe) the workers contend on nothing. If `trees` is
+// non-null it holds one tree per outcome, resized if needed, and statistics
+// accumulate in it across calls.
+std::vector<ChanceOutcomeSearchResult> MCTSearchChanceOutcomes(
+    const State& state, double uct_c, int max_search_nodes,
+    const Evaluator& evaluator, int num_threads,
+    std::vector<SearchTree>* trees);
+std::vector<ChanceOutcomeSearchResult> MCTSearchChanceOutcomes(
+    const State& state, double uct_c, int max_search_nodes,
+    const Evaluator& evaluator, int num_threads);
+
+// A variant of MCTSearch driven by a BatchEvaluator: up to batch_size leaves
+// are collected per round and evaluated in a single call. Each selected path
+// is guarded by a virtual loss until its evaluation arrives, so successive
+// descents within a round spread out instead of piling onto the same leaf.
+Action MCTSearchBatched(const State& state, double uct_c, int max_search_nodes,
+                        const BatchEvaluator& evaluator, int batch_size,
+                        SearchTree* tree);
+Action MCTSearchBatched(const State& state, double uct_c, int max_search_nodes,
+                        const BatchEvaluator& evaluator, int batch_size);
+
 // A SpielBot that uses the MCTS algorithm as its policy.
+//
+// The bot keeps its search tree across calls to Step: before each search it
+// re-roots the tree on the actions observed since the previous call (its own
+// move and the opponents' replies, recovered from the state's history), so
+// the simulations spent below the new root on previous turns are reused.
+//
+// With num_threads > 1 the bot searches in parallel at the root: the
+// simulation budget is split among worker threads, each building its own
+// tree with an independently seeded rng, and the worker trees are merged
+// into the persistent tree before choosing the most visited action. The
+// evaluator is shared among the workers and must be thread-safe.
+//
+// With ponder = true the bot keeps searching on a background thread during
+// the opponent's turn: after each Step it re-roots the tree on its chosen
+// action and expands it from the resulting state until the next Step
+// arrives. Combined with tree reuse this turns the opponent's thinking time
+// into free simulations. The ponder thread has no simulation budget, so in
+// untimed settings where the opponent replies instantly it adds little.
 class MCTSBot : public Bot {
  public:
+  // max_seconds is an optional wall-clock budget per call to Step;
+  // non-positive means the full max_search_nodes are always run.
   MCTSBot(const Game& game, int player, double uct_c, int max_search_nodes,
-          const Evaluator& evaluator)
+          const Evaluator& evaluator, int num_threads = 1,
+          double max_seconds = 0, bool ponder = false)
       : Bot{game, player},
         uct_c_{uct_c},
         max_search_nodes_{max_search_nodes},
-        evaluator_{evaluator} {}
+        evaluator_{evaluator},
+        num_threads_{num_threads},
+        max_seconds_{max_seconds},
+        ponder_{ponder} {}
+
+  ~MCTSBot() override { StopPondering(); }
 
   std::pair<ActionsAndProbs, Action> Step(const State& state) override;
 
+  // Snapshot support (see Bot): the snapshot holds the persistent search
+  // tree and the history it is rooted at, validated against the game on
+  // Restore. Both stop a running ponder thread first; Restore discards any
+  // state the bot held before.
+  void Serialize(std::string* buffer) const override;
+  void Restore(const std::string& buffer) override;
+
  private:
+  // Advances the persistent search tree to match `state`, re-rooting on the
+  // actions observed since the last call. Discards the tree if the state's
+  // history does not extend the tree's, or if an observed action leads to an
+  // unexplored subtree.
+  void AdvanceTree(const State& state);
+
+  // Runs the search budget split among num_threads_ workers and merges the
+  // resulting trees into tree_.
+  Action ParallelSearch(const State& state);
+
+  // Re-roots the tree on `action` taken from `state` and starts the
+  // background search from the resulting state. No-op if that state is
+  // terminal.
+  void StartPondering(const State& state, Action action);
+
+  // Signals the ponder thread to stop and joins it. The tree may only be
+  // touched while no ponder thread is running.
+  void StopPondering();
+
+  // Body of the ponder thread: searches tree_ from `state` in small slices
+  // until stopped.
+  void PonderLoop(std::unique_ptr<State> state);
+
   double uct_c_;
   int max_search_nodes_;
   const Evaluator& evaluator_;
+  int num_threads_;
+  double max_seconds_;
+  const bool ponder_;
+
+  // Search tree kept across moves, rooted at the state given to the last
+  // call to Step, whose history is root_history_.
+  SearchTree tree_;
+  std::vector<Action> root_history_;
+  bool has_tree_ = false;
+
+  std::thread ponder_thread_;
+  std::atomic<bool> stop_ponder_{false};
 };
 
 }  // namespace algorithms
@@ -14,6 +14,8 @@
 
 #include "open_spiel/algorithms/mcts.h"
 
+#include <algorithm>
+
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/spiel_bots.h"
 
@@ -40,7 +42,320 @@ void BotTest_RandomVsRandom() {
   SPIEL_CHECK_FLOAT_NEAR(average_results[1], -0.125, 0.01);
 }
 
+void SearchTreeReRootTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::SearchTree tree;
+  std::unique_ptr<State> state = game->NewInitialState();
+  algorithms::MCTSearch(*state, /*uct_c=*/2.0, /*max_search_nodes=*/100,
+                        evaluator, &tree);
+
+  // Re-rooting on a child must keep its statistics and drop the rest of the
+  // arena.
+  const int child_index = tree.root().children_begin;
+  const int child_explore_count = tree.node(child_index).explore_count;
+  const int total_nodes = tree.num_nodes();
+  tree.ReRoot(child_index);
+  SPIEL_CHECK_EQ(tree.root().explore_count, child_explore_count);
+  SPIEL_CHECK_LT(tree.num_nodes(), total_nodes);
+}
+
+void BotTest_MCTSBotTreeReuse() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::MCTSBot bot0(*game, /*player=*/0, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator);
+  algorithms::MCTSBot bot1(*game, /*player=*/1, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator);
+  std::vector<Bot*> bots = {&bot0, &bot1};
+
+  // Play two full games with the same bots: within a game, Step is called on
+  // successive states, exercising re-rooting on both players' moves; the
+  // second game starts from a fresh initial state, exercising the reset when
+  // the history does not extend the tree's.
+  for (int game_num = 0; game_num < 2; ++game_num) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      Action action = bots[state->CurrentPlayer()]->Step(*state).second;
+      state->ApplyAction(action);
+    }
+  }
+}
+
+void MCTSearchBatchedTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator rollout_evaluator(/*n_rollouts=*/1);
+  algorithms::SingleStateBatchEvaluator evaluator(rollout_evaluator);
+
+  // Play a full game choosing every move with the batched search.
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    Action action = algorithms::MCTSearchBatched(
+        *state, /*uct_c=*/2.0, /*max_search_nodes=*/100, evaluator,
+        /*batch_size=*/8);
+    std::vector<Action> legal_actions = state->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                               action) != legal_actions.end());
+    state->ApplyAction(action);
+  }
+}
+
+void MCTSearchTimedTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+
+  // An essentially empty time budget still runs one simulation, so a legal
+  // action comes back; a generous one behaves like the plain search.
+  for (double max_seconds : {1e-9, 300.0}) {
+    algorithms::SearchTree tree;
+    std::unique_ptr<State> state = game->NewInitialState();
+    Action action = algorithms::MCTSearchTimed(
+        *state, /*uct_c=*/2.0, /*max_search_nodes=*/100, max_seconds,
+        evaluator, &tree);
+    std::vector<Action> legal_actions = state->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                               action) != legal_actions.end());
+  }
+}
+
+void MCTSearchDagTest() {
+  // Two lookups of the same key resolve to one node: this is the mechanism
+  // by which transposed move orders pool their statistics.
+  algorithms::SearchGraph graph;
+  SPIEL_CHECK_EQ(graph.GetOrCreateNode(42), graph.GetOrCreateNode(42));
+  SPIEL_CHECK_EQ(graph.num_nodes(), 1);
+  graph.Reset();
+  SPIEL_CHECK_EQ(graph.num_nodes(), 0);
+
+  // Play a full game of connect_four (which provides a hash value and is
+  // rich in transpositions) choosing every move with the transposition-aware
+  // search, reusing the graph across moves so each search continues from the
+  // statistics gathered below its position on previous turns.
+  auto game = LoadGame("connect_four");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    Action action = algorithms::MCTSearchDag(
+        *state, /*uct_c=*/2.0, /*max_search_nodes=*/100, evaluator, &graph);
+    std::vector<Action> legal_actions = state->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                               action) != legal_actions.end());
+    state->ApplyAction(action);
+  }
+}
+
+void SearchTreeMemoryBudgetTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+
+  // A budget of 64 nodes' worth of arena: expansions stop once the arena
+  // reaches it, so the final node count can exceed 64 by at most the last
+  // expansion's children. The search still returns a legal action.
+  algorithms::SearchTree tree;
+  tree.SetMemoryBudget(64 * sizeof(algorithms::SearchNode));
+  std::unique_ptr<State> state = game->NewInitialState();
+  Action action = algorithms::MCTSearch(*state, /*uct_c=*/2.0,
+                                        /*max_search_nodes=*/500, evaluator,
+                                        &tree);
+  SPIEL_CHECK_TRUE(tree.OverMemoryBudget());
+  SPIEL_CHECK_LE(tree.num_nodes(), 64 + 9);
+  std::vector<Action> legal_actions = state->LegalActions();
+  SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                             action) != legal_actions.end());
+
+  // The same search without a budget grows well past the capped arena.
+  algorithms::SearchTree free_tree;
+  algorithms::MCTSearch(*state, /*uct_c=*/2.0, /*max_search_nodes=*/500,
+                        evaluator, &free_tree);
+  SPIEL_CHECK_GT(free_tree.num_nodes(), tree.num_nodes());
+}
+
+void SearchGraphMemoryBudgetTest() {
+  auto game = LoadGame("connect_four");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+
+  // Budgeted graph: node creation stops once ApproxBytes reaches the cap,
+  // the frontier is evaluated as leaves, and a legal action still comes
+  // back.
+  algorithms::SearchGraph graph;
+  graph.SetMemoryBudget(/*max_bytes=*/8192);
+  std::unique_ptr<State> state = game->NewInitialState();
+  Action action = algorithms::MCTSearchDag(
+      *state, /*uct_c=*/2.0, /*max_search_nodes=*/500, evaluator, &graph);
+  SPIEL_CHECK_TRUE(graph.OverMemoryBudget());
+  std::vector<Action> legal_actions = state->LegalActions();
+  SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                             action) != legal_actions.end());
+
+  algorithms::SearchGraph free_graph;
+  algorithms::MCTSearchDag(*state, /*uct_c=*/2.0, /*max_search_nodes=*/500,
+                           evaluator, &free_graph);
+  SPIEL_CHECK_GT(free_graph.ApproxBytes(), graph.ApproxBytes());
+  SPIEL_CHECK_GT(free_graph.num_nodes(), graph.num_nodes());
+}
+
+void MCTSearchWidenedTest() {
+  // With pw_c = 1 and pw_alpha = 0.25, a node visited N times considers at
+  // most ceil(N^0.25) of its actions; after 50 simulations through the root
+  // that is 3, so at most 3 of tic_tac_toe's 9 root children may have been
+  // linked.
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::SearchGraph graph;
+  std::unique_ptr<State> state = game->NewInitialState();
+  algorithms::MCTSearchWidened(*state, /*uct_c=*/2.0, /*max_search_nodes=*/50,
+                               evaluator, /*pw_c=*/1.0, /*pw_alpha=*/0.25,
+                               &graph);
+  const algorithms::DagNode& root = graph.node(0);
+  SPIEL_CHECK_EQ(root.actions.size(), 9);
+  int resolved_children = 0;
+  for (int child_index : root.children) {
+    if (child_index >= 0) ++resolved_children;
+  }
+  SPIEL_CHECK_GT(resolved_children, 0);
+  SPIEL_CHECK_LE(resolved_children, 3);
+
+  // The widened search still plays a legal full game.
+  while (!state->IsTerminal()) {
+    Action action = algorithms::MCTSearchWidened(
+        *state, /*uct_c=*/2.0, /*max_search_nodes=*/50, evaluator,
+        /*pw_c=*/1.0, /*pw_alpha=*/0.25, &graph);
+    std::vector<Action> legal_actions = state->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                               action) != legal_actions.end());
+    state->ApplyAction(action);
+  }
+}
+
+void MCTSearchChanceOutcomesTest() {
+  // Backgammon's initial state is a chance node (the opening roll); search
+  // every outcome in parallel and check each subtree chose a legal action.
+  auto game = LoadGame("backgammon");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_TRUE(state->IsChanceNode());
+  std::vector<algorithms::ChanceOutcomeSearchResult> results =
+      algorithms::MCTSearchChanceOutcomes(*state, /*uct_c=*/2.0,
+                                          /*max_search_nodes=*/40, evaluator,
+                                          /*num_threads=*/2);
+  SPIEL_CHECK_EQ(results.size(), state->ChanceOutcomes().size());
+  double total_probability = 0;
+  for (const algorithms::ChanceOutcomeSearchResult& result : results) {
+    std::unique_ptr<State> child = state->Child(result.outcome);
+    std::vector<Action> legal_actions = child->LegalActions();
+    SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                               result.best_action) != legal_actions.end());
+    total_probability += result.probability;
+  }
+  SPIEL_CHECK_FLOAT_NEAR(total_probability, 1.0, 1e-9);
+}
+
+void BotTest_MCTSBotPonder() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::MCTSBot bot0(*game, /*player=*/0, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator,
+                           /*num_threads=*/1, /*max_seconds=*/0,
+                           /*ponder=*/true);
+  algorithms::MCTSBot bot1(*game, /*player=*/1, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator,
+                           /*num_threads=*/1, /*max_seconds=*/0,
+                           /*ponder=*/true);
+  std::vector<Bot*> bots = {&bot0, &bot1};
+
+  // Both bots ponder while the other moves. The second game exercises
+  // stopping a ponder thread whose line of play the new game abandons; the
+  // bots are destroyed with their last ponder threads still running.
+  for (int game_num = 0; game_num < 2; ++game_num) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    while (!state->IsTerminal()) {
+      Action action = bots[state->CurrentPlayer()]->Step(*state).second;
+      std::vector<Action> legal_actions = state->LegalActions();
+      SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                                 action) != legal_actions.end());
+      state->ApplyAction(action);
+    }
+  }
+}
+
+void CappedRolloutTest() {
+  // Backgammon playouts run 80+ moves; capped at 15 they are scored with
+  // the pip count (State::QuickEvaluate), which stays within the utility
+  // range of the game.
+  auto game = LoadGame("backgammon");
+  algorithms::RandomRolloutEvaluator evaluator(
+      /*n_rollouts=*/4, /*history_independent_states=*/true,
+      /*playout_policy=*/nullptr, /*max_rollout_length=*/15);
+  std::unique_ptr<State> state = game->NewInitialState();
+  double value = evaluator.evaluate(*state);
+  SPIEL_CHECK_GE(value, game->MinUtility());
+  SPIEL_CHECK_LE(value, game->MaxUtility());
+}
+
+void MCTSBotSerializeRestoreTest() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::MCTSBot bot(*game, /*player=*/0, /*uct_c=*/2.0,
+                          /*max_search_nodes=*/100, evaluator);
+  std::unique_ptr<State> state = game->NewInitialState();
+  Action action = bot.Step(*state).second;
+
+  std::string snapshot;
+  bot.Serialize(&snapshot);
+  SPIEL_CHECK_FALSE(snapshot.empty());
+
+  // An identically configured bot restored from the snapshot serializes
+  // back to the same bytes: the tree survived the round trip exactly.
+  algorithms::MCTSBot restored(*game, /*player=*/0, /*uct_c=*/2.0,
+                               /*max_search_nodes=*/100, evaluator);
+  restored.Restore(snapshot);
+  std::string snapshot2;
+  restored.Serialize(&snapshot2);
+  SPIEL_CHECK_TRUE(snapshot == snapshot2);
+
+  // The restored bot keeps playing from where the original left off,
+  // re-rooting its restored tree onto the advanced state.
+  state->ApplyAction(action);
+  state->ApplyAction(state->LegalActions()[0]);
+  Action next_action = restored.Step(*state).second;
+  std::vector<Action> legal_actions = state->LegalActions();
+  SPIEL_CHECK_TRUE(std::find(legal_actions.begin(), legal_actions.end(),
+                             next_action) != legal_actions.end());
+}
+
+void BotTest_ParallelMCTSBot() {
+  auto game = LoadGame("tic_tac_toe");
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  algorithms::MCTSBot bot0(*game, /*player=*/0, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator,
+                           /*num_threads=*/2);
+  algorithms::MCTSBot bot1(*game, /*player=*/1, /*uct_c=*/2.0,
+                           /*max_search_nodes=*/100, evaluator,
+                           /*num_threads=*/2);
+  std::vector<Bot*> bots = {&bot0, &bot1};
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    Action action = bots[state->CurrentPlayer()]->Step(*state).second;
+    state->ApplyAction(action);
+  }
+}
+
 }  // namespace
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::BotTest_RandomVsRandom(); }
+int main(int argc, char** argv) {
+  open_spiel::BotTest_RandomVsRandom();
+  open_spiel::SearchTreeReRootTest();
+  open_spiel::BotTest_MCTSBotTreeReuse();
+  open_spiel::BotTest_ParallelMCTSBot();
+  open_spiel::BotTest_MCTSBotPonder();
+  open_spiel::MCTSBotSerializeRestoreTest();
+  open_spiel::MCTSearchBatchedTest();
+  open_spiel::MCTSearchTimedTest();
+  open_spiel::MCTSearchDagTest();
+  open_spiel::SearchTreeMemoryBudgetTest();
+  open_spiel::SearchGraphMemoryBudgetTest();
+  open_spiel::MCTSearchWidenedTest();
+  open_spiel::MCTSearchChanceOutcomesTest();
+  open_spiel::CappedRolloutTest();
+}
@@ -15,7 +15,9 @@
 #include "open_spiel/algorithms/minimax.h"
 
 #include <algorithm>  // std::max
+#include <array>
 #include <limits>
+#include <utility>
 
 #include "open_spiel/games/tic_tac_toe.h"
 #include "open_spiel/spiel.h"
@@ -25,6 +27,119 @@ namespace open_spiel {
 namespace algorithms {
 namespace {
 
+// Entry of the transposition table. Searches run with a negative depth limit
+// to mean "unlimited", so the empty-slot marker must be below any reachable
+// depth.
+constexpr int kEmptySlotDepth = std::numeric_limits<int>::min();
+
+struct TTEntry {
+  enum Bound : uint8_t { kExact, kLowerBound, kUpperBound };
+
+  uint64_t key = 0;
+  int depth = kEmptySlotDepth;
+  double value = 0;
+  Action best_action = kInvalidAction;
+  Bound bound = kExact;
+};
+
+// A fixed-size transposition table keyed on State::HashValue, with
+// replace-by-depth: results searched to a greater depth overwrite shallower
+// ones occupying their slot.
+class TranspositionTable {
+ public:
+  explicit TranspositionTable(int num_entries) : entries_(num_entries) {}
+
+  const TTEntry* Probe(uint64_t key) const {
+    const TTEntry& entry = entries_[key % entries_.size()];
+    return (entry.depth != kEmptySlotDepth && entry.key == key) ? &entry
+                                                                : nullptr;
+  }
+
+  void Store(const TTEntry& entry) {
+    TTEntry& slot = entries_[entry.key % entries_.size()];
+    if (slot.key == entry.key || entry.depth >= slot.depth) {
+      slot = entry;
+    }
+  }
+
+ private:
+  std::vector<TTEntry> entries_;
+};
+
+constexpr int kNumTranspositionTableEntries = 1 << 18;
+
+// Orders the actions at a node so that the likely-best ones are searched
+// first. Combines, from strongest to weakest signal: the transposition
+// table's best action, the killer moves of the current ply (actions that
+// recently produced a cutoff at the same distance from the root), and the
+// history counters (actions that produced cutoffs anywhere, weighted by
+// search depth) added to the game-supplied heuristic score.
+class MoveOrderer {
+ public:
+  MoveOrderer(int num_players, int num_distinct_actions,
+              MoveOrderingFunction ordering_function)
+      : ordering_function_(std::move(ordering_function)),
+        history_(num_players,
+                 std::vector<double>(num_distinct_actions, 0)) {}
+
+  void OrderMoves(const State& state, int player, int ply, Action hash_move,
+                  std::vector<Action>* actions) {
+    std::vector<std::pair<double, Action>> scored_actions;
+    scored_actions.reserve(actions->size());
+    for (Action action : *actions) {
+      double score = history_[player][action];
+      if (ordering_function_) {
+        score += ordering_function_(state, action);
+      }
+      if (action == hash_move) {
+        score += kHashMoveBonus;
+      } else if (IsKiller(ply, action)) {
+        score += kKillerBonus;
+      }
+      scored_actions.push_back({score, action});
+    }
+    std::stable_sort(scored_actions.begin(), scored_actions.end(),
+                     [](const std::pair<double, Action>& a,
+                        const std::pair<double, Action>& b) {
+                       return a.first > b.first;
+                     });
+    for (int i = 0; i < actions->size(); ++i) {
+      (*actions)[i] = scored_actions[i].second;
+    }
+  }
+
+  // Records that `action` caused a cutoff at the given ply with `depth`
+  // remaining (negative when searching without a depth limit).
+  void RecordCutoff(int player, int ply, int depth, Action action) {
+    history_[player][action] += depth > 0 ? depth * depth : 1;
+    if (ply >= killers_.size()) {
+      killers_.resize(ply + 1, {{kInvalidAction, kInvalidAction}});
+    }
+    if (killers_[ply][0] != action) {
+      killers_[ply][1] = killers_[ply][0];
+      killers_[ply][0] = action;
+    }
+  }
+
+ private:
+  bool IsKiller(int ply, Action action) const {
+    return ply < killers_.size() &&
+           (killers_[ply][0] == action || killers_[ply][1] == action);
+  }
+
+  // The bonuses just need to dominate any realistic history or heuristic
+  // score, with the hash move in front of the killers.
+  static constexpr double kHashMoveBonus = 1e12;
+  static constexpr double kKillerBonus = 1e9;
+
+  MoveOrderingFunction ordering_function_;
+  std::vector<std::vector<double>> history_;      // [player][action]
+  std::vector<std::array<Action, 2>> killers_;    // [ply]
+};
+
+constexpr double MoveOrderer::kHashMoveBonus;
+constexpr double MoveOrderer::kKillerBonus;
+
 // An alpha-beta algorithm.
 //
 // Implements a min-max algorithm with alpha-beta pruning.
@@ -42,12 +157,30 @@ namespace {
 //     `maximum_depth` and the node is not terminal.
 //   maximizing_player_id: The id of the MAX player. The other player is assumed
 //     to be MIN.
+//   use_undo: Whether the game supports UndoAction, in which case the search
+//     walks the tree with this single state object and zero allocations per
+//     node. Otherwise each child is visited on a clone of the state.
+//   tt: The transposition table. A position searched before to at least the
+//     required depth is answered from the table; otherwise its stored best
+//     action is tried first, which is what makes iterative deepening pay off.
+//   orderer: Maintains the killer/history statistics and applies them (and
+//     the game-supplied heuristic, if any) to order the actions at each node.
+//   ply: The distance from the search root, indexing the killer moves.
+//   deadline: An optional wall-clock budget. When it expires the search
+//     unwinds immediately and its return value is meaningless; the caller
+//     must discard the pass. May be nullptr for no time limit.
 //
 // Returns:
 //   The optimal value of the sub-game starting in state (given alpha/beta).
 double _alpha_beta(State* state, int depth, double alpha, double beta,
                    std::function<double(const State&)> value_function,
-                   int maximizing_player_id, Action* best_action) {
+                   int maximizing_player_id, Action* best_action,
+                   bool use_undo, TranspositionTable* tt, MoveOrderer* orderer,
+                   int ply, SearchDeadline* deadline) {
+  if (deadline != nullptr && deadline->Expired()) {
+    return 0;
+  }
+
   if (state->IsTerminal()) {
     return state->PlayerReturn(maximizing_player_id);
   }
@@ -62,65 +195,139 @@ double _alpha_beta(State* state, int depth, double alpha, double beta,
     return value_function(*state);
   }
 
-  int player = state->CurrentPlayer();
-  if (player == maximizing_player_id) {
-    double value = -std::numeric_limits<double>::infinity();
-
-    for (auto action : state->LegalActions()) {
-      state->ApplyAction(action);
-      double child_value =
-          _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
-                      /*beta=*/beta, value_function, maximizing_player_id,
-                      /*best_action=*/nullptr);
-      state->UndoAction(player, action);
-
-      if (child_value > value) {
-        value = child_value;
+  const uint64_t key = state->HashValue();
+  const double original_alpha = alpha;
+  const double original_beta = beta;
+  Action hash_move = kInvalidAction;
+  const TTEntry* entry = tt->Probe(key);
+  if (entry != nullptr) {
+    hash_move = entry->best_action;
+    if (entry->depth >= depth && entry->best_action != kInvalidAction) {
+      bool cutoff = false;
+      if (entry->bound == TTEntry::kExact) {
+        cutoff = true;
+      } else if (entry->bound == TTEntry::kLowerBound) {
+        alpha = std::max(alpha, entry->value);
+      } else {
+        beta = std::min(beta, entry->value);
+      }
+      if (cutoff || alpha >= beta) {
         if (best_action != nullptr) {
-          *best_action = action;
+          *best_action = entry->best_action;
         }
-      }
-
-      alpha = std::max(alpha, value);
-      if (alpha >= beta) {
-        break;  // beta cut-off
+        return entry->value;
       }
     }
+  }
 
-    return value;
-  } else {
-    double value = std::numeric_limits<double>::infinity();
+  int player = state->CurrentPlayer();
+  const bool maximizing = (player == maximizing_player_id);
+  double value = maximizing ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+  Action local_best_action = kInvalidAction;
+  bool aborted = false;
 
-    for (auto action : state->LegalActions()) {
+  // Searches one child and folds its value into value/alpha/beta. Returns
+  // true when this node is done: either the window closed (cut-off) or the
+  // deadline expired mid-search.
+  auto search_child = [&](Action action) -> bool {
+    double child_value;
+    if (use_undo) {
       state->ApplyAction(action);
-      double child_value =
+      child_value =
           _alpha_beta(state, /*depth=*/depth - 1, /*alpha=*/alpha,
                       /*beta=*/beta, value_function, maximizing_player_id,
-                      /*best_action=*/nullptr);
+                      /*best_action=*/nullptr, use_undo, tt, orderer,
+                      ply + 1, deadline);
       state->UndoAction(player, action);
+    } else {
+      std::unique_ptr<State> child = state->Child(action);
+      child_value =
+          _alpha_beta(child.get(), /*depth=*/depth - 1, /*alpha=*/alpha,
+                      /*beta=*/beta, value_function, maximizing_player_id,
+                      /*best_action=*/nullptr, use_undo, tt, orderer,
+                      ply + 1, deadline);
+    }
 
-      if (child_value < value) {
-        value = child_value;
-        if (best_action != nullptr) {
-          *best_action = action;
-        }
+    if (deadline != nullptr && deadline->HasExpired()) {
+      // child_value comes from a cut-short search; discard it and unwind.
+      aborted = true;
+      return true;
+    }
+
+    if (maximizing ? child_value > value : child_value < value) {
+      value = child_value;
+      local_best_action = action;
+      if (best_action != nullptr) {
+        *best_action = action;
       }
+    }
 
+    if (maximizing) {
+      alpha = std::max(alpha, value);
+    } else {
       beta = std::min(beta, value);
-      if (alpha >= beta) {
-        break;  // alpha cut-off
+    }
+    if (alpha >= beta) {
+      orderer->RecordCutoff(player, ply, depth, action);
+      return true;  // alpha/beta cut-off
+    }
+    return false;
+  };
+
+  // Try the transposition table's action before materializing the move list:
+  // when it produces the cutoff on its own — the common case once iterative
+  // deepening has primed the table — the remaining moves are never generated
+  // for games with a native ForEachLegalAction. The lazy scan only verifies
+  // that the stored action is legal here (the table is keyed on a 64-bit
+  // hash, so collisions are possible), stopping at the first match.
+  bool done = false;
+  bool searched_hash_move = false;
+  if (hash_move != kInvalidAction) {
+    bool hash_move_legal = false;
+    state->ForEachLegalAction([&hash_move_legal, hash_move](Action action) {
+      if (action == hash_move) {
+        hash_move_legal = true;
+        return false;
       }
+      return true;
+    });
+    if (hash_move_legal) {
+      searched_hash_move = true;
+      done = search_child(hash_move);
     }
+  }
 
+  if (!done) {
+    std::vector<Action> legal_actions = state->LegalActions();
+    orderer->OrderMoves(*state, player, ply, hash_move, &legal_actions);
+    for (Action action : legal_actions) {
+      if (searched_hash_move && action == hash_move) continue;
+      if (search_child(action)) break;
+    }
+  }
+
+  if (aborted) {
     return value;
   }
+
+  TTEntry new_entry;
+  new_entry.key = key;
+  new_entry.depth = depth;
+  new_entry.value = value;
+  new_entry.best_action = local_best_action;
+  new_entry.bound = value <= original_alpha
+                        ? TTEntry::kUpperBound
+                        : value >= original_beta ? TTEntry::kLowerBound
+                                                 : TTEntry::kExact;
+  tt->Store(new_entry);
+
+  return value;
 }
-}  // namespace
 
-std::pair<double, Action> AlphaBetaSearch(
-    const Game& game, const State* state,
-    std::function<double(const State&)> value_function, int depth_limit,
-    int maximizing_player_id) {
+// Checks that `game` is within the class the alpha-beta search supports,
+// failing fatally otherwise.
+void ValidateGameForAlphaBeta(const Game& game) {
   if (game.NumPlayers() != 2) {
     SpielFatalError("Game must be a 2-player game");
   }
@@ -142,6 +349,15 @@ std::pair<double, Action> AlphaBetaSearch(
     SpielFatalError(
         absl::StrCat("The game must be 0-sum, not  ", game_info.utility));
   }
+}
+}  // namespace
+
+std::pair<double, Action> AlphaBetaSearch(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    int maximizing_player_id, MoveOrderingFunction ordering_function) {
+  ValidateGameForAlphaBeta(game);
+  GameType game_info = game.GetType();
 
   std::unique_ptr<State> search_root;
   if (state == nullptr) {
@@ -156,12 +372,94 @@ std::pair<double, Action> AlphaBetaSearch(
 
   double infinity = std::numeric_limits<double>::infinity();
   Action best_action = kInvalidAction;
-  double value = _alpha_beta(
-      search_root.get(), /*depth=*/depth_limit, /*alpha=*/-infinity,
-      /*beta=*/infinity, value_function, maximizing_player_id, &best_action);
+  double value = 0;
+  TranspositionTable tt(kNumTranspositionTableEntries);
+  MoveOrderer orderer(game.NumPlayers(), game.NumDistinctActions(),
+                      std::move(ordering_function));
+  if (value_function && depth_limit > 0) {
+    // Iterative deepening: the shallow passes are cheap and leave their best
+    // actions in the transposition table, giving the deeper passes
+    // near-optimal move ordering.
+    for (int depth = 1; depth <= depth_limit; ++depth) {
+      value = _alpha_beta(
+          search_root.get(), /*depth=*/depth, /*alpha=*/-infinity,
+          /*beta=*/infinity, value_function, maximizing_player_id,
+          &best_action, /*use_undo=*/game_info.provides_undo, &tt, &orderer,
+          /*ply=*/0, /*deadline=*/nullptr);
+    }
+  } else {
+    // Without a value function the shallower passes would fail on reaching
+    // their depth limit (and a negative depth limit means unlimited), so
+    // search the full depth directly.
+    value = _alpha_beta(
+        search_root.get(), /*depth=*/depth_limit, /*alpha=*/-infinity,
+        /*beta=*/infinity, value_function, maximizing_player_id, &best_action,
+        /*use_undo=*/game_info.provides_undo, &tt, &orderer, /*ply=*/0,
+        /*deadline=*/nullptr);
+  }
 
   return std::pair<double, Action>(value, best_action);
 }
 
+std::pair<double, Action> AlphaBetaSearchTimed(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    double max_seconds, int maximizing_player_id,
+    MoveOrderingFunction ordering_function, int* completed_depth) {
+  ValidateGameForAlphaBeta(game);
+  if (!value_function) {
+    SpielFatalError(
+        "AlphaBetaSearchTimed requires a value_function: every deepening "
+        "pass except possibly the last is depth-limited.");
+  }
+  GameType game_info = game.GetType();
+
+  std::unique_ptr<State> search_root;
+  if (state == nullptr) {
+    search_root = game.NewInitialState();
+  } else {
+    search_root = state->Clone();
+  }
+
+  if (maximizing_player_id == kInvalidPlayer) {
+    maximizing_player_id = search_root->CurrentPlayer();
+  }
+
+  // Searching deeper than the longest possible game cannot change the
+  // result, so that is where unlimited deepening stops.
+  if (depth_limit <= 0) {
+    depth_limit = game.MaxGameLength();
+  }
+
+  double infinity = std::numeric_limits<double>::infinity();
+  double value = 0;
+  Action best_action = kInvalidAction;
+  int deepest_completed = 0;
+  TranspositionTable tt(kNumTranspositionTableEntries);
+  MoveOrderer orderer(game.NumPlayers(), game.NumDistinctActions(),
+                      std::move(ordering_function));
+  SearchDeadline deadline(max_seconds);
+  for (int depth = 1; depth <= depth_limit; ++depth) {
+    Action pass_best_action = kInvalidAction;
+    // The depth-1 pass runs without the clock so that there is always a
+    // completed pass to answer from.
+    double pass_value = _alpha_beta(
+        search_root.get(), /*depth=*/depth, /*alpha=*/-infinity,
+        /*beta=*/infinity, value_function, maximizing_player_id,
+        &pass_best_action, /*use_undo=*/game_info.provides_undo, &tt,
+        &orderer, /*ply=*/0, depth == 1 ? nullptr : &deadline);
+    if (deadline.HasExpired()) break;
+    value = pass_value;
+    best_action = pass_best_action;
+    deepest_completed = depth;
+    if (deadline.Expired()) break;
+  }
+
+  if (completed_depth != nullptr) {
+    *completed_depth = deepest_completed;
+  }
+  return std::pair<double, Action>(value, best_action);
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
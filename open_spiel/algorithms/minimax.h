@@ -23,6 +23,13 @@
 namespace open_spiel {
 namespace algorithms {
 
+// Signature of a game-supplied move ordering heuristic: returns a score for
+// applying `action` in `state`. Higher-scored actions are searched first,
+// which raises the cutoff rate of the alpha-beta search. The heuristic is
+// combined with the killer-move and history statistics the search maintains
+// itself, so it only needs to encode game knowledge (e.g. captures first).
+using MoveOrderingFunction = std::function<double(const State&, Action)>;
+
 // Solves deterministic, 2-players, perfect-information 0-sum game.
 //
 // For small games only! Please use keyword arguments for optional arguments.
@@ -39,6 +46,8 @@ namespace algorithms {
 //   maximizing_player_id: The id of the MAX player. The other player is assumed
 //     to be MIN. Passing in kInvalidPlayer will set this to the search root's
 //     current player.
+//   ordering_function: An optional game-supplied move ordering heuristic, see
+//     above. Use `nullptr` for none.
 
 //   Returns:
 //     A pair of the value of the game for the maximizing player when both
@@ -47,7 +56,24 @@ namespace algorithms {
 std::pair<double, Action> AlphaBetaSearch(
     const Game& game, const State* state,
     std::function<double(const State&)> value_function, int depth_limit,
-    int maximizing_player_id);
+    int maximizing_player_id,
+    MoveOrderingFunction ordering_function = nullptr);
+
+// A wall-clock-budgeted AlphaBetaSearch for match play on time controls.
+// Iterative deepening runs until depth_limit (non-positive: the game's
+// maximum length) or until max_seconds runs out, whichever comes first, and
+// the value and action of the deepest fully completed pass are returned; a
+// pass cut short by the clock is discarded. The depth-1 pass is exempt from
+// the clock, so a legal action is always returned. If completed_depth is
+// non-null, the depth of the returned pass is written to it. Because every
+// pass except possibly the last is depth-limited, a value_function is
+// required.
+std::pair<double, Action> AlphaBetaSearchTimed(
+    const Game& game, const State* state,
+    std::function<double(const State&)> value_function, int depth_limit,
+    double max_seconds, int maximizing_player_id,
+    MoveOrderingFunction ordering_function = nullptr,
+    int* completed_depth = nullptr);
 
 }  // namespace algorithms
 }  // namespace open_spiel
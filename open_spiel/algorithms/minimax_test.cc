@@ -65,6 +65,45 @@ void AlphaBetaSearchTest_TicTacToe_Loss() {
   SPIEL_CHECK_EQ(-1.0, value_and_action.first);
 }
 
+void AlphaBetaSearchTest_TicTacToe_MoveOrdering() {
+  tic_tac_toe::TicTacToeGame game({});
+
+  // Move ordering must not change the value of the game; prefer the centre
+  // cell, then inner-ring cells, which is a reasonable heuristic here.
+  MoveOrderingFunction ordering = [](const State& state, Action action) {
+    return action == 4 ? 2.0 : (action % 2 == 1 ? 1.0 : 0.0);
+  };
+  std::pair<double, Action> value_and_action =
+      AlphaBetaSearch(game, nullptr, {}, -1, kInvalidPlayer, ordering);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+}
+
+void AlphaBetaSearchTimedTest_TicTacToe() {
+  tic_tac_toe::TicTacToeGame game({});
+  auto value_function = [](const State& state) { return 0.0; };
+
+  // With a generous budget the deepening reaches the full game length and
+  // finds the game-theoretic value (a draw).
+  int completed_depth = -1;
+  std::pair<double, Action> value_and_action = AlphaBetaSearchTimed(
+      game, nullptr, value_function, /*depth_limit=*/-1, /*max_seconds=*/300,
+      kInvalidPlayer, /*ordering_function=*/nullptr, &completed_depth);
+  SPIEL_CHECK_EQ(0.0, value_and_action.first);
+  SPIEL_CHECK_EQ(completed_depth, game.MaxGameLength());
+
+  // With an essentially empty budget the clock expires at its first check (a
+  // few dozen node entries in), so only the first pass or two complete. The
+  // clock-exempt depth-1 pass guarantees the action is still legal.
+  value_and_action = AlphaBetaSearchTimed(
+      game, nullptr, value_function, /*depth_limit=*/-1,
+      /*max_seconds=*/1e-9, kInvalidPlayer, /*ordering_function=*/nullptr,
+      &completed_depth);
+  SPIEL_CHECK_GE(completed_depth, 1);
+  SPIEL_CHECK_LT(completed_depth, game.MaxGameLength());
+  SPIEL_CHECK_GE(value_and_action.second, 0);
+  SPIEL_CHECK_LT(value_and_action.second, game.NumDistinctActions());
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -73,4 +112,6 @@ int main(int argc, char **argv) {
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Win();
   open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_Loss();
+  open_spiel::algorithms::AlphaBetaSearchTest_TicTacToe_MoveOrdering();
+  open_spiel::algorithms::AlphaBetaSearchTimedTest_TicTacToe();
 }
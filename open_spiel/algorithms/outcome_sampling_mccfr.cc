@@ -0,0 +1,167 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/outcome_sampling_mccfr.h"
+
+#include <memory>
+#include <random>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+OutcomeSamplingMCCFRSolver::OutcomeSamplingMCCFRSolver(const Game& game,
+                                                       double epsilon,
+                                                       int seed,
+                                                       bool use_baseline)
+    : game_(game.Clone()),
+      history_independent_states_(game.GetType().history_independent_state),
+      epsilon_(epsilon),
+      use_baseline_(use_baseline),
+      rng_(new std::mt19937(seed)),
+      dist_(0.0, 1.0),
+      uniform_policy_(std::shared_ptr<TabularPolicy>(
+          new TabularPolicy(GetUniformPolicy(game)))) {}
+
+void OutcomeSamplingMCCFRSolver::RunIteration() { RunIteration(rng_.get()); }
+
+void OutcomeSamplingMCCFRSolver::RunIteration(std::mt19937* rng) {
+  for (int p = 0; p < game_->NumPlayers(); ++p) {
+    std::unique_ptr<State> state = NewRootState();
+    SampleEpisode(state.get(), p, rng, 1.0, 1.0, 1.0);
+  }
+}
+
+double OutcomeSamplingMCCFRSolver::SampleEpisode(State* state,
+                                                 int update_player,
+                                                 std::mt19937* rng,
+                                                 double my_reach,
+                                                 double opp_reach,
+                                                 double sample_reach) {
+  if (state->IsTerminal()) {
+    return state->PlayerReturn(update_player);
+  } else if (state->IsChanceNode()) {
+    // Chance is sampled on-policy, so its probability enters the opponent
+    // and sample reaches identically and cancels in the update weights; the
+    // sampled child estimate is already unbiased for the chance node value.
+    const std::pair<Action, double> outcome =
+        state->SampleChanceOutcome(dist_(*rng));
+    const Action action = outcome.first;
+    const double prob = outcome.second;
+    state->ApplyAction(action);
+    return SampleEpisode(state, update_player, rng, my_reach,
+                         prob * opp_reach, prob * sample_reach);
+  } else if (state->IsSimultaneousNode()) {
+    SpielFatalError(
+        "Simultaneous moves not supported. Use "
+        "TurnBasedSimultaneousGame to convert the game first.");
+  }
+
+  const int cur_player = state->CurrentPlayer();
+  const std::string is_key = state->InformationStateKey(cur_player);
+  // The state is mutated below, so the actions are copied rather than
+  // referencing the state's cache.
+  std::vector<Action> legal_actions = state->LegalActions();
+  const int num_actions = legal_actions.size();
+
+  // The insert here only inserts the default value if the key is not found,
+  // otherwise returns the entry in the map.
+  auto iter_and_result = info_states_.insert(
+      {is_key, CFRInfoStateValues(legal_actions, kInitialTableValues)});
+
+  // Work on copies: the recursive call below inserts into the tables, which
+  // can invalidate references into them.
+  CFRInfoStateValues info_state_copy = iter_and_result.first->second;
+  info_state_copy.ApplyRegretMatching();
+  const std::vector<double> policy = info_state_copy.cached_policy;
+
+  std::vector<double> baseline;
+  if (use_baseline_) {
+    Baseline& entry = baselines_[is_key];
+    if (entry.values.empty()) {
+      entry.values.resize(num_actions, 0.0);
+      entry.visits.resize(num_actions, 0);
+    }
+    baseline = entry.values;
+  }
+
+  // Mix in uniform exploration at the update player's nodes only; elsewhere
+  // the trajectory follows the current policy.
+  const bool is_update_node = (cur_player == update_player);
+  const int sampled_aidx =
+      info_state_copy.SampleActionIndex(is_update_node ? epsilon_ : 0.0,
+                                        dist_(*rng));
+  const double sample_prob =
+      is_update_node ? epsilon_ / num_actions +
+                           (1.0 - epsilon_) * policy[sampled_aidx]
+                     : policy[sampled_aidx];
+
+  state->ApplyAction(legal_actions[sampled_aidx]);
+  const double child_value = SampleEpisode(
+      state, update_player, rng,
+      is_update_node ? my_reach * policy[sampled_aidx] : my_reach,
+      is_update_node ? opp_reach : opp_reach * policy[sampled_aidx],
+      sample_reach * sample_prob);
+
+  // Baseline-corrected action value estimates: the baseline for every
+  // action, plus the importance-weighted residual for the sampled one. With
+  // the baseline off this reduces to the standard outcome sampling estimate
+  // child_value / sample_prob for the sampled action and zero otherwise.
+  const double baseline_sampled =
+      use_baseline_ ? baseline[sampled_aidx] : 0.0;
+  const double residual = (child_value - baseline_sampled) / sample_prob;
+  double state_value = policy[sampled_aidx] * residual;
+  if (use_baseline_) {
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      state_value += policy[aidx] * baseline[aidx];
+    }
+  }
+
+  if (is_update_node) {
+    CFRInfoStateValues& is_vals = info_states_[is_key];
+    const double cf_weight = opp_reach / sample_reach;
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      double action_value = use_baseline_ ? baseline[aidx] : 0.0;
+      if (aidx == sampled_aidx) {
+        action_value += residual;
+      }
+      is_vals.cumulative_regrets[aidx] +=
+          cf_weight * (action_value - state_value);
+    }
+
+    // Stochastically-weighted average strategy update (chapter 4 of Lanctot
+    // 2013): the increment is the current policy weighted by the update
+    // player's reach over the probability of having sampled this prefix.
+    const double avg_weight = my_reach / sample_reach;
+    for (int aidx = 0; aidx < num_actions; ++aidx) {
+      is_vals.cumulative_policy[aidx] += avg_weight * policy[aidx];
+    }
+  }
+
+  if (use_baseline_) {
+    // Update the running mean for the sampled action only after it has been
+    // used above, so each update's baseline is independent of its sample.
+    Baseline& entry = baselines_[is_key];
+    int& visits = entry.visits[sampled_aidx];
+    ++visits;
+    entry.values[sampled_aidx] +=
+        (child_value - entry.values[sampled_aidx]) / visits;
+  }
+
+  return state_value;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
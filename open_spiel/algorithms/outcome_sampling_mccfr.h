@@ -0,0 +1,113 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// An implementation of outcome sampling Monte Carlo Counterfactual Regret
+// Minimization (CFR). Unlike external sampling (external_sampling_mccfr.h),
+// which walks the update player's whole subtree, outcome sampling walks a
+// single trajectory per update, so the per-iteration cost is O(depth) rather
+// than O(subtree size). See Lanctot 2009 [0] and Chapter 4 of Lanctot 2013
+// [1] for details, and Schmid et al. 2019 [2] for the baseline-based variance
+// reduction.
+// [0]: http://mlanctot.info/files/papers/nips09mccfr.pdf
+// [1]: http://mlanctot.info/files/papers/PhD_Thesis_MarcLanctot.pdf
+// [2]: https://arxiv.org/abs/1809.03057
+
+namespace open_spiel {
+namespace algorithms {
+
+class OutcomeSamplingMCCFRSolver {
+ public:
+  static constexpr double kInitialTableValues = 0.000001;
+  static constexpr double kDefaultEpsilon = 0.6;
+
+  // Creates a solver. `epsilon` is the amount of uniform exploration mixed
+  // into the sampling policy at the update player's nodes. When
+  // `use_baseline` is set, a per-action baseline (the running mean of the
+  // sampled value estimates for that action, keyed by info state) is
+  // maintained and used as a control variate, which substantially reduces
+  // the variance of the importance-weighted updates; with it off the updates
+  // are plain outcome sampling (a baseline of zero).
+  OutcomeSamplingMCCFRSolver(const Game& game,
+                             double epsilon = kDefaultEpsilon, int seed = 0,
+                             bool use_baseline = false);
+
+  // Performs one iteration of outcome sampling MCCFR: one sampled trajectory
+  // per player, updating that player's regrets and average strategy along
+  // it. This method uses the internal random number generator.
+  void RunIteration();
+
+  // Same as above, but uses the specified random number generator instead.
+  void RunIteration(std::mt19937* rng);
+
+  // Computes the average policy, containing the policy for all players.
+  // The returned policy instance should only be used during the lifetime of
+  // the solver object.
+  std::unique_ptr<Policy> AveragePolicy() const {
+    return std::unique_ptr<Policy>(
+        new CFRAveragePolicy(info_states_, uniform_policy_));
+  }
+
+ private:
+  // Running per-action mean of the sampled child value estimates for one
+  // info state; used as the control variate when use_baseline is set.
+  struct Baseline {
+    std::vector<double> values;
+    std::vector<int> visits;
+  };
+
+  // Walks one sampled trajectory below `state` (which is modified in place),
+  // updating the regrets and average strategy of `update_player` at their
+  // nodes. `my_reach`, `opp_reach` and `sample_reach` are the products of,
+  // respectively, the update player's policy probabilities, everyone else's
+  // (including chance), and the sampling probabilities along the prefix.
+  // Returns an unbiased estimate of the update player's value at `state`.
+  double SampleEpisode(State* state, int update_player, std::mt19937* rng,
+                       double my_reach, double opp_reach, double sample_reach);
+
+  // Creates the root state for a sampled episode. The episodes never read
+  // the history, so tracking is disabled when the game permits it.
+  std::unique_ptr<State> NewRootState() const {
+    std::unique_ptr<State> state = game_->NewInitialState();
+    if (history_independent_states_) state->DisableHistoryTracking();
+    return state;
+  }
+
+  std::unique_ptr<Game> game_;
+  bool history_independent_states_;
+  const double epsilon_;
+  const bool use_baseline_;
+  std::unique_ptr<std::mt19937> rng_;
+  CFRInfoStateValuesTable info_states_;
+  std::unordered_map<std::string, Baseline> baselines_;
+  std::uniform_real_distribution<double> dist_;
+  std::shared_ptr<TabularPolicy> uniform_policy_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OUTCOME_SAMPLING_MCCFR_H_
@@ -0,0 +1,394 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/oware_tablebase.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// File layout, in order. All fields are little-endian.
+//   uint32 magic, uint32 version
+//   uint32 num_houses_per_player, uint32 max_seeds
+//   int8   values[num_positions]    (num_positions follows from the header)
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+constexpr std::size_t kOwareTablebaseHeaderSize = 4 * sizeof(uint32_t);
+
+int SeedsInPlay(const oware::OwareBoard& board) {
+  return std::accumulate(board.seeds.begin(), board.seeds.end(), 0);
+}
+
+// Mirrors OwareState::LegalActions on a bare board; boards without a legal
+// move cannot be wrapped in a state (the game would have ended on them).
+bool HasLegalMove(const oware::OwareBoard& board, int num_houses_per_player) {
+  const int player = board.current_player;
+  const int lower = player * num_houses_per_player;
+  const int upper = lower + num_houses_per_player - 1;
+  const int opponent_lower = (1 - player) * num_houses_per_player;
+  int opponent_seeds = 0;
+  for (int house = opponent_lower;
+       house < opponent_lower + num_houses_per_player; ++house) {
+    opponent_seeds += board.seeds[house];
+  }
+  for (int house = lower; house <= upper; ++house) {
+    if (opponent_seeds == 0) {
+      // Only moves which give the opponent seeds are legal.
+      if (board.seeds[house] - (upper - house) > 0) return true;
+    } else if (board.seeds[house] > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The seeds in the mover's row minus the seeds in the opponent's row: the
+// differential when the game ends here with each player collecting their
+// own row (no legal move, or the repetition residue of a layer).
+int RowDifferential(const oware::OwareBoard& board,
+                    int num_houses_per_player) {
+  int rows[oware::kNumPlayers] = {0, 0};
+  const int num_pits = static_cast<int>(board.seeds.size());
+  for (int house = 0; house < num_pits; ++house) {
+    rows[house / num_houses_per_player] += board.seeds[house];
+  }
+  return rows[board.current_player] - rows[1 - board.current_player];
+}
+
+}  // namespace
+
+OwareTablebase::OwareTablebase(int num_houses_per_player, int max_seeds)
+    : num_houses_per_player_(num_houses_per_player),
+      max_seeds_(max_seeds),
+      num_pits_(oware::kNumPlayers * num_houses_per_player) {
+  SPIEL_CHECK_GE(num_houses_per_player, 1);
+  SPIEL_CHECK_GE(max_seeds, 0);
+  SPIEL_CHECK_LE(max_seeds, 127);  // Differentials are stored as int8.
+  configurations_.resize(num_pits_ + 1,
+                         std::vector<uint64_t>(max_seeds_ + 1, 1));
+  for (int pits = 1; pits <= num_pits_; ++pits) {
+    for (int seeds = 1; seeds <= max_seeds_; ++seeds) {
+      configurations_[pits][seeds] = configurations_[pits][seeds - 1] +
+                                     configurations_[pits - 1][seeds];
+    }
+  }
+  num_positions_ =
+      oware::kNumPlayers * NumConfigurations(num_pits_, max_seeds_);
+  Generate();
+  table_ = values_.data();
+}
+
+OwareTablebase::OwareTablebase(const std::string& filename) {
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    SpielFatalError("Could not open oware tablebase: " + filename);
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    SpielFatalError("Could not stat oware tablebase: " + filename);
+  }
+  size_ = file_stat.st_size;
+  if (size_ < kOwareTablebaseHeaderSize) {
+    SpielFatalError("Oware tablebase too small: " + filename);
+  }
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError("Could not map oware tablebase: " + filename);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  uint32_t magic, version, num_houses, max_seeds;
+  std::memcpy(&magic, data_, sizeof(magic));
+  std::memcpy(&version, data_ + 4, sizeof(version));
+  std::memcpy(&num_houses, data_ + 8, sizeof(num_houses));
+  std::memcpy(&max_seeds, data_ + 12, sizeof(max_seeds));
+  if (magic != kOwareTablebaseMagic) {
+    SpielFatalError("Not an oware tablebase: " + filename);
+  }
+  if (version != kOwareTablebaseVersion) {
+    SpielFatalError("Unsupported oware tablebase version in: " + filename);
+  }
+  num_houses_per_player_ = num_houses;
+  max_seeds_ = max_seeds;
+  num_pits_ = oware::kNumPlayers * num_houses_per_player_;
+  configurations_.resize(num_pits_ + 1,
+                         std::vector<uint64_t>(max_seeds_ + 1, 1));
+  for (int pits = 1; pits <= num_pits_; ++pits) {
+    for (int seeds = 1; seeds <= max_seeds_; ++seeds) {
+      configurations_[pits][seeds] = configurations_[pits][seeds - 1] +
+                                     configurations_[pits - 1][seeds];
+    }
+  }
+  num_positions_ =
+      oware::kNumPlayers * NumConfigurations(num_pits_, max_seeds_);
+  if (size_ != kOwareTablebaseHeaderSize + num_positions_) {
+    SpielFatalError("Oware tablebase has inconsistent size: " + filename);
+  }
+  table_ = reinterpret_cast<const int8_t*>(data_ + kOwareTablebaseHeaderSize);
+}
+
+OwareTablebase::~OwareTablebase() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+uint64_t OwareTablebase::NumConfigurations(int pits, int seeds) const {
+  return configurations_[pits][seeds];
+}
+
+std::size_t OwareTablebase::BoardIndex(const oware::OwareBoard& board) const {
+  // Combinatorial rank of the seed vector among all vectors of at most
+  // max_seeds seeds, in lexicographic order.
+  std::size_t rank = 0;
+  int remaining = max_seeds_;
+  for (int pit = 0; pit < num_pits_; ++pit) {
+    const int count = board.seeds[pit];
+    for (int c = 0; c < count; ++c) {
+      rank += NumConfigurations(num_pits_ - pit - 1, remaining - c);
+    }
+    remaining -= count;
+  }
+  return board.current_player * NumConfigurations(num_pits_, max_seeds_) +
+         rank;
+}
+
+void OwareTablebase::Generate() {
+  values_.assign(num_positions_, 0);
+
+  struct LayerNode {
+    std::size_t index;       // Index into values_.
+    int row_diff;            // The repetition residue value.
+    int max_exact;           // Best edge leaving the layer.
+    std::vector<int> children;  // Layer-local in-layer successors.
+    int lo, hi;
+  };
+  constexpr int kNoEdge = -128;  // Below any differential.
+
+  // Solve layers of increasing seed count; captures and collections only
+  // move downwards, so every out-of-layer successor is already solved.
+  for (int layer_seeds = 0; layer_seeds <= max_seeds_; ++layer_seeds) {
+    // All seed vectors with exactly layer_seeds seeds.
+    std::vector<std::vector<int>> layer_configs;
+    std::vector<int> current(num_pits_, 0);
+    std::function<void(int, int)> enumerate = [&](int pit, int remaining) {
+      if (pit == num_pits_ - 1) {
+        current[pit] = remaining;
+        layer_configs.push_back(current);
+        return;
+      }
+      for (int count = 0; count <= remaining; ++count) {
+        current[pit] = count;
+        enumerate(pit + 1, remaining - count);
+      }
+    };
+    enumerate(0, layer_seeds);
+
+    std::vector<LayerNode> nodes;
+    nodes.reserve(oware::kNumPlayers * layer_configs.size());
+    std::unordered_map<std::size_t, int> local_index;
+    for (int player = 0; player < oware::kNumPlayers; ++player) {
+      for (const std::vector<int>& seeds : layer_configs) {
+        oware::OwareBoard board(player, /*score=*/{0, 0}, seeds);
+        LayerNode node;
+        node.index = BoardIndex(board);
+        node.row_diff = RowDifferential(board, num_houses_per_player_);
+        node.max_exact = kNoEdge;
+        node.lo = -layer_seeds;
+        node.hi = layer_seeds;
+        local_index[node.index] = nodes.size();
+        nodes.push_back(std::move(node));
+      }
+    }
+
+    // Expand each position with the real game logic, so grand slams,
+    // forced feeding and end-of-game collection follow oware.cc exactly.
+    // The starting scores are fixed, so a child's score differential minus
+    // the starting differential is the capture gain.
+    for (int player = 0; player < oware::kNumPlayers; ++player) {
+      for (std::size_t c = 0; c < layer_configs.size(); ++c) {
+        LayerNode& node = nodes[player * layer_configs.size() + c];
+        // With both scores zero, OwareState would deem the tiniest layers
+        // already over (each score equals half of the seeds in play) and
+        // refuse to play on. Unequal scores keep the wrapper mid-game;
+        // the offset cancels out of the capture differential below.
+        oware::OwareBoard board(player, /*score=*/{1, 0}, layer_configs[c]);
+        const int score_offset = player == 0 ? 1 : -1;
+        if (!HasLegalMove(board, num_houses_per_player_)) {
+          // The game ends here with each player collecting their row.
+          node.lo = node.hi = node.row_diff;
+          continue;
+        }
+        oware::OwareState state(board);
+        for (Action action : state.LegalActions()) {
+          oware::OwareState child(state);
+          child.ApplyAction(action);
+          const oware::OwareBoard& child_board = child.Board();
+          const int gain = child_board.score[player] -
+                           child_board.score[1 - player] - score_offset;
+          const int child_seeds = SeedsInPlay(child_board);
+          if (child_seeds == 0) {
+            // Everything is captured or collected; the game is over.
+            node.max_exact = std::max(node.max_exact, gain);
+          } else if (child_seeds < layer_seeds) {
+            // A capture moved us to an already-solved layer.
+            const int child_value = values_[BoardIndex(child_board)];
+            node.max_exact = std::max(node.max_exact, gain - child_value);
+          } else {
+            // A non-capturing move stays in this layer.
+            node.children.push_back(local_index.at(BoardIndex(child_board)));
+          }
+        }
+        if (node.children.empty()) {
+          node.lo = node.hi = node.max_exact;
+        }
+      }
+    }
+
+    // Interval iteration: tighten optimistic and pessimistic bounds to a
+    // fixpoint. Both are monotone and integral, so this terminates.
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (LayerNode& node : nodes) {
+        if (node.lo == node.hi) continue;
+        int new_lo = node.max_exact;
+        int new_hi = node.max_exact;
+        for (int child : node.children) {
+          new_lo = std::max(new_lo, -nodes[child].hi);
+          new_hi = std::max(new_hi, -nodes[child].lo);
+        }
+        new_lo = std::max(node.lo, new_lo);
+        new_hi = std::min(node.hi, new_hi);
+        if (new_lo != node.lo || new_hi != node.hi) {
+          node.lo = new_lo;
+          node.hi = new_hi;
+          changed = true;
+        }
+      }
+    }
+
+    // Positions still undecided are those where optimal play never leaves
+    // the layer; the rules end such play by repetition with each player
+    // collecting their own row, so they get the row differential, kept
+    // within the proven bounds.
+    for (const LayerNode& node : nodes) {
+      const int value =
+          node.lo == node.hi
+              ? node.lo
+              : std::min(node.hi, std::max(node.lo, node.row_diff));
+      SPIEL_CHECK_GE(value, -max_seeds_);
+      SPIEL_CHECK_LE(value, max_seeds_);
+      values_[node.index] = static_cast<int8_t>(value);
+    }
+  }
+}
+
+bool OwareTablebase::Covered(const oware::OwareBoard& board) const {
+  return static_cast<int>(board.seeds.size()) == num_pits_ &&
+         SeedsInPlay(board) <= max_seeds_;
+}
+
+bool OwareTablebase::Covered(const State& state) const {
+  const oware::OwareState* oware_state =
+      dynamic_cast<const oware::OwareState*>(&state);
+  return oware_state != nullptr && Covered(oware_state->Board());
+}
+
+int OwareTablebase::Probe(const oware::OwareBoard& board) const {
+  SPIEL_CHECK_TRUE(Covered(board));
+  return table_[BoardIndex(board)];
+}
+
+double OwareTablebase::Value(const State& state, int player) const {
+  const oware::OwareState* oware_state =
+      dynamic_cast<const oware::OwareState*>(&state);
+  SPIEL_CHECK_TRUE(oware_state != nullptr);
+  const oware::OwareBoard& board = oware_state->Board();
+  const int mover = board.current_player;
+  const int final_differential =
+      board.score[mover] - board.score[1 - mover] + Probe(board);
+  const int sign = (final_differential > 0) - (final_differential < 0);
+  return player == mover ? sign : -sign;
+}
+
+std::function<double(const State&)> OwareTablebase::MakeValueFunction(
+    int maximizing_player) const {
+  return [this, maximizing_player](const State& state) -> double {
+    if (state.IsTerminal()) return state.PlayerReturn(maximizing_player);
+    if (Covered(state)) return Value(state, maximizing_player);
+    // Not in the table: a score-differential heuristic, strictly inside
+    // (-1, 1) so that exact outcomes dominate it.
+    const oware::OwareBoard& board =
+        dynamic_cast<const oware::OwareState&>(state).Board();
+    return (board.score[maximizing_player] -
+            board.score[1 - maximizing_player]) /
+           static_cast<double>(board.TotalSeeds() + 1);
+  };
+}
+
+void OwareTablebase::Save(const std::string& filename) const {
+  std::string buffer;
+  AppendRaw<uint32_t>(kOwareTablebaseMagic, &buffer);
+  AppendRaw<uint32_t>(kOwareTablebaseVersion, &buffer);
+  AppendRaw<uint32_t>(num_houses_per_player_, &buffer);
+  AppendRaw<uint32_t>(max_seeds_, &buffer);
+  buffer.append(reinterpret_cast<const char*>(table_), num_positions_);
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open oware tablebase for writing: " + filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write oware tablebase: " + filename);
+  }
+}
+
+double OwareTablebaseEvaluator::evaluate(const State& state) const {
+  if (!state.IsTerminal() && tablebase_->Covered(state)) {
+    return tablebase_->Value(state, /*player=*/0);
+  }
+  return fallback_->evaluate(state);
+}
+
+ActionsAndProbs OwareTablebaseEvaluator::Prior(const State& state) const {
+  return fallback_->Prior(state);
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
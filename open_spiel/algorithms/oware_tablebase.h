@@ -0,0 +1,150 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OWARE_TABLEBASE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OWARE_TABLEBASE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/games/oware.h"
+#include "open_spiel/spiel.h"
+
+// An endgame tablebase for oware. Positions with few seeds left in play are
+// exactly solvable, and search keeps re-deriving them at the deepest, most
+// expensive plies; the tablebase solves them once by retrograde analysis
+// over layers of decreasing seed count and turns those subtrees into O(1)
+// probes.
+//
+// Each table entry is the optimal future-capture differential for the
+// player to move: the seeds that player will still collect minus the seeds
+// the opponent will, to the end of the game, including the row collection
+// when the game ends. Because oware's rules never read the score houses,
+// this differential depends only on the seeds in play and the player to
+// move, so the table is keyed on the packed pit configuration and one
+// table covers every score situation. Combined with the current scores,
+// the differential decides the game outcome exactly (see Value below).
+//
+// Within a layer, non-capturing moves can cycle. Cycles are resolved by
+// interval iteration (optimistic and pessimistic bounds tightened to a
+// fixpoint); positions still undecided at the fixpoint are those where
+// optimal play never leaves the layer, which the rules end by repetition
+// with each player collecting their own row. Those residual positions get
+// the row differential, clamped into the proven bounds. This matches the
+// repetition rule up to where in the cycle the repetition strikes.
+
+namespace open_spiel {
+namespace algorithms {
+
+constexpr uint32_t kOwareTablebaseMagic = 0x4254534f;  // "OSTB", little-endian.
+constexpr uint32_t kOwareTablebaseVersion = 1;
+
+class OwareTablebase {
+ public:
+  // Generates the table in memory for all positions of the given board
+  // size with at most max_seeds seeds in play. Table size (and generation
+  // cost) grows as C(max_seeds + 2 * num_houses_per_player,
+  // 2 * num_houses_per_player); for the standard board, max_seeds of 8
+  // keeps both modest.
+  OwareTablebase(int num_houses_per_player, int max_seeds);
+
+  // Memory-maps a table previously written by Save, so opening a large
+  // table costs only the mmap call and the pages are shared between
+  // processes probing the same file.
+  explicit OwareTablebase(const std::string& filename);
+
+  ~OwareTablebase();
+  OwareTablebase(const OwareTablebase&) = delete;
+  OwareTablebase& operator=(const OwareTablebase&) = delete;
+
+  int num_houses_per_player() const { return num_houses_per_player_; }
+  int max_seeds() const { return max_seeds_; }
+  std::size_t num_positions() const { return num_positions_; }
+
+  // Whether the board (or state) is in the table: matching board size and
+  // at most max_seeds seeds still in play.
+  bool Covered(const oware::OwareBoard& board) const;
+  bool Covered(const State& state) const;
+
+  // The optimal future-capture differential for the player to move of a
+  // covered board.
+  int Probe(const oware::OwareBoard& board) const;
+
+  // The exact game outcome of a covered, non-terminal state for the given
+  // player: 1 for a win, 0 for a draw, -1 for a loss, folding the current
+  // scores into the probed differential.
+  double Value(const State& state, int player) const;
+
+  // A value function for AlphaBetaSearch, from the view of the maximizing
+  // player: exact outcomes at covered states, and a score-differential
+  // heuristic in (-1, 1) elsewhere so the search may call it anywhere.
+  std::function<double(const State&)> MakeValueFunction(
+      int maximizing_player) const;
+
+  // Writes the table to filename, replacing any existing file, in the
+  // format the memory-mapping constructor reads.
+  void Save(const std::string& filename) const;
+
+ private:
+  // The flat table index of (board.current_player, board.seeds).
+  std::size_t BoardIndex(const oware::OwareBoard& board) const;
+
+  // The number of seed configurations of at most `seeds` seeds in `pits`
+  // pits, C(seeds + pits, pits), from the precomputed table.
+  uint64_t NumConfigurations(int pits, int seeds) const;
+
+  void Generate();
+
+  int num_houses_per_player_;
+  int max_seeds_;
+  int num_pits_;  // 2 * num_houses_per_player_.
+  std::size_t num_positions_;
+
+  // configurations_[p][s] = C(s + p, p), for p <= num_pits_, s <= max_seeds_.
+  std::vector<std::vector<uint64_t>> configurations_;
+
+  // Either the generated table or a pointer into the mapping.
+  std::vector<int8_t> values_;
+  const int8_t* table_ = nullptr;
+
+  // mmap state, only used by the file constructor.
+  int fd_ = -1;
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// An MCTS leaf evaluator that returns exact outcomes from the tablebase at
+// covered states and delegates everything else to a fallback evaluator.
+// Both the tablebase and the fallback must outlive the evaluator.
+class OwareTablebaseEvaluator : public Evaluator {
+ public:
+  OwareTablebaseEvaluator(const OwareTablebase* tablebase,
+                          const Evaluator* fallback)
+      : tablebase_(tablebase), fallback_(fallback) {}
+
+  double evaluate(const State& state) const override;
+  ActionsAndProbs Prior(const State& state) const override;
+
+ private:
+  const OwareTablebase* tablebase_;
+  const Evaluator* fallback_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_OWARE_TABLEBASE_H_
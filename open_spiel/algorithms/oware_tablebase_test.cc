@@ -0,0 +1,146 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/oware_tablebase.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/minimax.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Positions whose value can be read off the rules directly.
+void KnownPositionsTest() {
+  OwareTablebase tablebase(/*num_houses_per_player=*/6, /*max_seeds=*/4);
+
+  // The empty board is a dead draw.
+  oware::OwareBoard empty(0, {0, 0}, std::vector<int>(12, 0));
+  SPIEL_CHECK_EQ(tablebase.Probe(empty), 0);
+
+  // Player 0 is forced to sow house 5, capturing the two seeds in house 6;
+  // player 1 is then left without a move and collects the seed in house 7:
+  // a differential of 2 - 1 = +1 for player 0.
+  oware::OwareBoard forced_capture(
+      0, {0, 0}, {0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0});
+  SPIEL_CHECK_EQ(tablebase.Probe(forced_capture), 1);
+
+  // The mirrored position must probe to the same value for player 1.
+  oware::OwareBoard mirrored(
+      1, {0, 0}, {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1});
+  SPIEL_CHECK_EQ(tablebase.Probe(mirrored), 1);
+
+  // Player 0 has no legal move, so each player collects their own row.
+  oware::OwareBoard no_move(
+      0, {0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0});
+  SPIEL_CHECK_EQ(tablebase.Probe(no_move), -3);
+
+  // Single-seed endgames (regression test: these layers used to crash the
+  // generator). A lone seed short of the mover's last house cannot reach
+  // the opponent, so the game ends with each player collecting their row;
+  // from the last house the mover is forced to feed the seed away.
+  oware::OwareBoard lone_stuck(
+      0, {0, 0}, {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
+  SPIEL_CHECK_EQ(tablebase.Probe(lone_stuck), 1);
+  oware::OwareBoard lone_fed(
+      0, {0, 0}, {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0});
+  SPIEL_CHECK_EQ(tablebase.Probe(lone_fed), -1);
+}
+
+// The probed differential folded into the current scores decides the game.
+void ValueFoldsScoresTest() {
+  OwareTablebase tablebase(/*num_houses_per_player=*/6, /*max_seeds=*/4);
+  const std::vector<int> seeds = {0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0};
+
+  // The +1 differential above loses from 20-22, draws from 21-22 and wins
+  // from 22-20.
+  oware::OwareState losing(oware::OwareBoard(0, {20, 22}, seeds));
+  SPIEL_CHECK_TRUE(tablebase.Covered(losing));
+  SPIEL_CHECK_EQ(tablebase.Value(losing, 0), -1);
+  SPIEL_CHECK_EQ(tablebase.Value(losing, 1), 1);
+
+  oware::OwareState drawing(oware::OwareBoard(0, {21, 22}, seeds));
+  SPIEL_CHECK_EQ(tablebase.Value(drawing, 0), 0);
+
+  oware::OwareState winning(oware::OwareBoard(0, {22, 20}, seeds));
+  SPIEL_CHECK_EQ(tablebase.Value(winning, 0), 1);
+  SPIEL_CHECK_EQ(tablebase.MakeValueFunction(0)(winning), 1);
+}
+
+// Saving and memory-mapping a table must reproduce it exactly.
+void SaveLoadRoundTripTest() {
+  const std::string filename = "/tmp/open_spiel_oware_tablebase_test.tb";
+  OwareTablebase generated(/*num_houses_per_player=*/6, /*max_seeds=*/3);
+  generated.Save(filename);
+
+  OwareTablebase loaded(filename);
+  SPIEL_CHECK_EQ(loaded.num_houses_per_player(), 6);
+  SPIEL_CHECK_EQ(loaded.max_seeds(), 3);
+  SPIEL_CHECK_EQ(loaded.num_positions(), generated.num_positions());
+  for (int player = 0; player < 2; ++player) {
+    for (int house = 0; house < 12; ++house) {
+      for (int count = 0; count <= 3; ++count) {
+        std::vector<int> seeds(12, 0);
+        seeds[house] = count;
+        oware::OwareBoard board(player, {0, 0}, seeds);
+        SPIEL_CHECK_EQ(loaded.Probe(board), generated.Probe(board));
+      }
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+// The value function plugs into AlphaBetaSearch and the evaluator into
+// MCTS; the full game's opening is far outside the table, so both also
+// exercise the fallback paths.
+void SearchIntegrationTest() {
+  OwareTablebase tablebase(/*num_houses_per_player=*/6, /*max_seeds=*/4);
+  std::unique_ptr<Game> game = LoadGame("oware");
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_FALSE(tablebase.Covered(*state));
+
+  std::pair<double, Action> result =
+      AlphaBetaSearch(*game, state.get(), tablebase.MakeValueFunction(0),
+                      /*depth_limit=*/4, /*maximizing_player_id=*/0);
+  SPIEL_CHECK_GE(result.first, -1.0);
+  SPIEL_CHECK_LE(result.first, 1.0);
+  std::vector<Action> legal = state->LegalActions();
+  SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(), result.second) !=
+                   legal.end());
+
+  RandomRolloutEvaluator fallback(/*n_rollouts=*/1);
+  OwareTablebaseEvaluator evaluator(&tablebase, &fallback);
+  MCTSBot bot(*game, /*player=*/0, /*uct_c=*/2.0, /*max_search_nodes=*/30,
+              evaluator);
+  Action action = bot.Step(*state).second;
+  SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(), action) !=
+                   legal.end());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::KnownPositionsTest();
+  open_spiel::algorithms::ValueFoldsScoresTest();
+  open_spiel::algorithms::SaveLoadRoundTripTest();
+  open_spiel::algorithms::SearchIntegrationTest();
+}
@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/playout_policies.h"
+
+#include <random>
+#include <vector>
+
+#include "open_spiel/games/breakthrough.h"
+#include "open_spiel/games/go.h"
+#include "open_spiel/games/go/go_board.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Whether p is an eye-like point for c: every direct neighbour is a stone of
+// c or a border guard. This misreads false eyes, but reading those out is
+// far too expensive for a playout, and the occasional misread move is just
+// an unusual playout, not an error.
+bool IsEyeLike(const go::GoBoard& board, go::GoPoint p, go::GoColor c) {
+  bool eye_like = true;
+  go::Neighbours(p, [&board, c, &eye_like](go::GoPoint n) {
+    const go::GoColor neighbour = board.PointColor(n);
+    if (neighbour != c && neighbour != go::GoColor::kGuard) eye_like = false;
+  });
+  return eye_like;
+}
+
+}  // namespace
+
+Action GoPlayoutPolicy::SamplePlayoutAction(const State& state,
+                                            FastRng* rng) const {
+  const go::GoState* go_state = dynamic_cast<const go::GoState*>(&state);
+  SPIEL_CHECK_TRUE(go_state != nullptr);
+  const go::GoBoard& board = go_state->board();
+  const go::GoColor to_play = static_cast<go::GoColor>(state.CurrentPlayer());
+
+  std::vector<go::GoPoint> urgent;
+  std::vector<go::GoPoint> quiet;
+  for (go::GoPoint p : go::BoardPoints(board.board_size())) {
+    if (!board.IsLegalMove(p, to_play)) continue;
+    if (IsEyeLike(board, p, to_play)) continue;
+    // An empty point next to a chain in atari is that chain's last liberty,
+    // so playing it captures the chain (theirs) or extends it (ours).
+    bool is_urgent = false;
+    go::Neighbours(p, [&board, &is_urgent](go::GoPoint n) {
+      const go::GoColor neighbour = board.PointColor(n);
+      if (neighbour != go::GoColor::kBlack &&
+          neighbour != go::GoColor::kWhite) {
+        return;
+      }
+      if (board.InAtari(n)) is_urgent = true;
+    });
+    (is_urgent ? urgent : quiet).push_back(p);
+  }
+
+  if (!urgent.empty()) {
+    return urgent[std::uniform_int_distribution<int>(
+        0, urgent.size() - 1)(*rng)];
+  }
+  if (!quiet.empty()) {
+    return quiet[std::uniform_int_distribution<int>(
+        0, quiet.size() - 1)(*rng)];
+  }
+  return go::kPass;
+}
+
+Action BreakthroughPlayoutPolicy::SamplePlayoutAction(const State& state,
+                                                      FastRng* rng) const {
+  SPIEL_CHECK_TRUE(dynamic_cast<const breakthrough::BreakthroughState*>(
+                       &state) != nullptr);
+  // Capture actions carry a set low bit in the mixed-base action encoding
+  // (see BreakthroughState::LegalActions).
+  std::vector<Action> captures;
+  for (Action action : state.LegalActions()) {
+    if (action & 1) captures.push_back(action);
+  }
+  if (captures.empty()) return kInvalidAction;
+  return captures[std::uniform_int_distribution<int>(
+      0, captures.size() - 1)(*rng)];
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
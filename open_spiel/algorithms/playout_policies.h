@@ -0,0 +1,56 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PLAYOUT_POLICIES_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PLAYOUT_POLICIES_H_
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Game-specific playout policies for RandomRolloutEvaluator (see the
+// PlayoutPolicy interface in mcts.h). Each policy encodes a couple of cheap
+// domain heuristics; the point is not playing strength per playout but
+// playouts that end sooner and correlate better with the true outcome, so
+// the surrounding search needs fewer of them.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Playout policy for go. Never fills one of its own eye-like points (all
+// four direct neighbours own stones or border), which is what makes random
+// go playouts terminate: once both sides are reduced to eye-filling they
+// pass. Among the remaining legal moves it prefers the tactically urgent
+// ones, played uniformly at random: capturing an adjacent opponent chain in
+// atari or extending an own adjacent chain in atari (both are moves onto
+// that chain's last liberty, read straight off the incremental chain data).
+// Passes only when no non-eye-filling move exists.
+class GoPlayoutPolicy : public PlayoutPolicy {
+ public:
+  Action SamplePlayoutAction(const State& state, FastRng* rng) const override;
+};
+
+// Playout policy for breakthrough: plays a capture, uniformly at random,
+// whenever one is available, and defers to the uniform-random default
+// otherwise. Capture-first playouts resolve the piece-count races that
+// decide the game instead of wandering past them.
+class BreakthroughPlayoutPolicy : public PlayoutPolicy {
+ public:
+  Action SamplePlayoutAction(const State& state, FastRng* rng) const override;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_PLAYOUT_POLICIES_H_
@@ -0,0 +1,134 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/playout_policies.h"
+
+#include <algorithm>
+#include <random>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/games/go.h"
+#include "open_spiel/games/go/go_board.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+bool ActionsContains(const std::vector<Action>& legal_actions, Action action) {
+  return std::find(legal_actions.begin(), legal_actions.end(), action) !=
+         legal_actions.end();
+}
+
+void GoPolicyPlaysLegalMovesTest() {
+  auto game = LoadGame("go", {{"board_size", GameParameter(9)}});
+  std::unique_ptr<State> state = game->NewInitialState();
+  GoPlayoutPolicy policy;
+  FastRng rng(17);
+  for (int i = 0; i < 20; ++i) {
+    Action action = policy.SamplePlayoutAction(*state, &rng);
+    // On an open board there is always a real move to play.
+    SPIEL_CHECK_NE(action, go::kPass);
+    SPIEL_CHECK_TRUE(ActionsContains(state->LegalActions(), action));
+  }
+}
+
+void GoPolicyCapturesAtariChainTest() {
+  auto game = LoadGame("go", {{"board_size", GameParameter(9)}});
+  std::unique_ptr<State> state = game->NewInitialState();
+  GoPlayoutPolicy policy;
+  FastRng rng(17);
+
+  // Black a2, white a1: the lone white stone is in atari with its last
+  // liberty at b1, which is the only urgent point on the board.
+  state->ApplyAction(go::MakePoint("a2"));
+  state->ApplyAction(go::MakePoint("a1"));
+  for (int i = 0; i < 20; ++i) {
+    SPIEL_CHECK_EQ(policy.SamplePlayoutAction(*state, &rng),
+                   go::MakePoint("b1"));
+  }
+}
+
+void GoPolicyAvoidsOwnEyeTest() {
+  auto game = LoadGame("go", {{"board_size", GameParameter(9)}});
+  std::unique_ptr<State> state = game->NewInitialState();
+  GoPlayoutPolicy policy;
+  FastRng rng(17);
+
+  // Black builds an eye at a1 (neighbours a2 and b1); white plays away.
+  state->ApplyAction(go::MakePoint("a2"));
+  state->ApplyAction(go::MakePoint("e5"));
+  state->ApplyAction(go::MakePoint("b1"));
+  state->ApplyAction(go::MakePoint("e6"));
+  SPIEL_CHECK_TRUE(ActionsContains(state->LegalActions(),
+                                   go::MakePoint("a1")));
+  for (int i = 0; i < 50; ++i) {
+    SPIEL_CHECK_NE(policy.SamplePlayoutAction(*state, &rng),
+                   go::MakePoint("a1"));
+  }
+}
+
+void BreakthroughPolicyCaptureFirstTest() {
+  auto game = LoadGame("breakthrough");
+  BreakthroughPlayoutPolicy policy;
+  FastRng rng(17);
+  std::mt19937 game_rng(17);
+
+  // Walk a random game; at every decision the policy must pick a capture
+  // (low bit set in the action encoding) exactly when one is available.
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    std::vector<Action> legal_actions = state->LegalActions();
+    const bool capture_available =
+        std::any_of(legal_actions.begin(), legal_actions.end(),
+                    [](Action action) { return (action & 1) != 0; });
+    Action action = policy.SamplePlayoutAction(*state, &rng);
+    if (capture_available) {
+      SPIEL_CHECK_TRUE((action & 1) != 0);
+      SPIEL_CHECK_TRUE(ActionsContains(legal_actions, action));
+    } else {
+      SPIEL_CHECK_EQ(action, kInvalidAction);
+    }
+    state->ApplyAction(legal_actions[game_rng() % legal_actions.size()]);
+  }
+}
+
+void RolloutEvaluatorWithPolicyTest() {
+  // End to end through RandomRolloutEvaluator: eye-avoiding playouts must
+  // terminate and yield a valid outcome estimate.
+  auto game = LoadGame("go", {{"board_size", GameParameter(5)}});
+  GoPlayoutPolicy policy;
+  RandomRolloutEvaluator evaluator(/*n_rollouts=*/2,
+                                   /*history_independent_states=*/false,
+                                   &policy);
+  std::unique_ptr<State> state = game->NewInitialState();
+  double value = evaluator.evaluate(*state);
+  SPIEL_CHECK_GE(value, game->MinUtility());
+  SPIEL_CHECK_LE(value, game->MaxUtility());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace algorithms = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  algorithms::GoPolicyPlaysLegalMovesTest();
+  algorithms::GoPolicyCapturesAtariChainTest();
+  algorithms::GoPolicyAvoidsOwnEyeTest();
+  algorithms::BreakthroughPolicyCaptureFirstTest();
+  algorithms::RolloutEvaluatorWithPolicyTest();
+}
@@ -0,0 +1,229 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/policy_export.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "open_spiel/policy_file.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+using TableEntry = std::pair<const std::string, CFRInfoStateValues>;
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+double CumulativePolicySum(const CFRInfoStateValues& values) {
+  double sum = 0.0;
+  for (double weight : values.cumulative_policy) sum += weight;
+  return sum;
+}
+
+// The table entries with a nonzero cumulative policy, sorted by key — the
+// only per-table allocation the export makes (one pointer per entry).
+std::vector<const TableEntry*> SortedNonzeroEntries(
+    const CFRInfoStateValuesTable& table) {
+  std::vector<const TableEntry*> entries;
+  entries.reserve(table.size());
+  for (const auto& entry : table) {
+    if (CumulativePolicySum(entry.second) != 0.0) {
+      entries.push_back(&entry);
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const TableEntry* a, const TableEntry* b) {
+              return a->first < b->first;
+            });
+  return entries;
+}
+
+// Encodes the average policy in the policy-file layout (see policy_file.cc),
+// handing the bytes to `emit` whenever the working buffer passes
+// shard_bytes. The file's sections are offset tables and blobs whose sizes
+// are known from entry counts, so each section is produced in its own pass
+// over the sorted entries and nothing but the working buffer is held.
+void EncodeAveragePolicy(const CFRInfoStateValuesTable& table, int shard_bytes,
+                         const std::function<void(std::string)>& emit) {
+  const std::vector<const TableEntry*> entries = SortedNonzeroEntries(table);
+
+  std::string buffer;
+  auto maybe_emit = [&buffer, shard_bytes, &emit]() {
+    if (buffer.size() >= static_cast<std::size_t>(shard_bytes)) {
+      emit(std::move(buffer));
+      buffer.clear();
+    }
+  };
+
+  AppendRaw<uint32_t>(kPolicyFileMagic, &buffer);
+  AppendRaw<uint32_t>(kPolicyFileVersion, &buffer);
+  AppendRaw<uint64_t>(entries.size(), &buffer);
+
+  uint64_t key_offset = 0;
+  for (const TableEntry* entry : entries) {
+    AppendRaw<uint64_t>(key_offset, &buffer);
+    key_offset += entry->first.size();
+    maybe_emit();
+  }
+  AppendRaw<uint64_t>(key_offset, &buffer);
+
+  uint64_t pair_offset = 0;
+  for (const TableEntry* entry : entries) {
+    AppendRaw<uint64_t>(pair_offset, &buffer);
+    pair_offset += entry->second.legal_actions.size();
+    maybe_emit();
+  }
+  AppendRaw<uint64_t>(pair_offset, &buffer);
+
+  for (const TableEntry* entry : entries) {
+    for (Action action : entry->second.legal_actions) {
+      AppendRaw<int64_t>(action, &buffer);
+    }
+    maybe_emit();
+  }
+
+  for (const TableEntry* entry : entries) {
+    // Normalize in place of CFRAveragePolicy, one entry at a time.
+    const double sum = CumulativePolicySum(entry->second);
+    for (double weight : entry->second.cumulative_policy) {
+      AppendRaw<double>(weight / sum, &buffer);
+    }
+    maybe_emit();
+  }
+
+  for (const TableEntry* entry : entries) {
+    buffer.append(entry->first);
+    maybe_emit();
+  }
+
+  if (!buffer.empty()) {
+    emit(std::move(buffer));
+  }
+}
+
+}  // namespace
+
+void WriteAveragePolicyFile(const std::string& filename,
+                            const CFRInfoStateValuesTable& table) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open policy file for writing: " + filename);
+  }
+  EncodeAveragePolicy(table, /*shard_bytes=*/8 * 1024 * 1024,
+                      [&file](std::string bytes) {
+                        file.write(bytes.data(), bytes.size());
+                      });
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write policy file: " + filename);
+  }
+}
+
+AveragePolicySnapshotter::AveragePolicySnapshotter(int shard_bytes)
+    : shard_bytes_(shard_bytes) {
+  SPIEL_CHECK_GT(shard_bytes_, 0);
+  writer_ = std::thread(&AveragePolicySnapshotter::WriterLoop, this);
+}
+
+AveragePolicySnapshotter::~AveragePolicySnapshotter() {
+  Flush();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  writer_.join();
+}
+
+void AveragePolicySnapshotter::RequestSnapshot(
+    const std::string& filename, const CFRInfoStateValuesTable& table) {
+  bool first = true;
+  EncodeAveragePolicy(table, shard_bytes_,
+                      [this, &filename, &first](std::string bytes) {
+                        Enqueue(Chunk{filename, std::move(bytes), first,
+                                      /*last=*/false});
+                        first = false;
+                      });
+  // The closing marker; the worker flushes and closes the file on it.
+  Enqueue(Chunk{filename, std::string(), first, /*last=*/true});
+}
+
+void AveragePolicySnapshotter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cv_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+}
+
+void AveragePolicySnapshotter::Enqueue(Chunk chunk) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(chunk));
+  }
+  queue_cv_.notify_all();
+}
+
+void AveragePolicySnapshotter::WriterLoop() {
+  std::ofstream file;
+  while (true) {
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;  // Stopped after a Flush: nothing pending.
+      chunk = std::move(queue_.front());
+      queue_.pop_front();
+      writing_ = true;
+    }
+
+    if (chunk.first) {
+      file.open(chunk.filename, std::ios::binary | std::ios::trunc);
+      if (!file) {
+        SpielFatalError("Could not open policy file for writing: " +
+                        chunk.filename);
+      }
+    }
+    if (!chunk.bytes.empty()) {
+      file.write(chunk.bytes.data(), chunk.bytes.size());
+    }
+    if (chunk.last) {
+      file.flush();
+      if (!file) {
+        SpielFatalError("Could not write policy file: " + chunk.filename);
+      }
+      file.close();
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      writing_ = false;
+      if (queue_.empty()) {
+        idle_cv_.notify_all();
+      }
+    }
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
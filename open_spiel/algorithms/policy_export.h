@@ -0,0 +1,100 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_EXPORT_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_EXPORT_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "open_spiel/algorithms/cfr.h"
+
+// Streaming export of CFR average policies to the frozen policy-file format
+// (see policy_file.h), without ever materializing a TabularPolicy. Going
+// through AveragePolicy() builds a second full table right at the end of a
+// long run, doubling peak memory exactly when the info state table is at its
+// largest; these writers instead walk the solver's table in sorted-key order
+// and normalize one entry at a time into a bounded shard buffer, so peak
+// memory grows by one shard rather than one table.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Writes the average policy of the table to filename, replacing any existing
+// file; the result is loadable with FrozenTabularPolicy. Entries whose
+// cumulative policy is all zero are omitted (CFRAveragePolicy returns empty
+// for them, as FrozenTabularPolicy does for absent keys). Blocks until the
+// file is written. Calls SpielFatalError if the file cannot be written.
+void WriteAveragePolicyFile(const std::string& filename,
+                            const CFRInfoStateValuesTable& table);
+
+// A background writer for checkpoint-interval policy snapshots. Encoding
+// runs on the calling thread (it reads the live table, so the table must be
+// quiescent for the duration of the call — between solver iterations), but
+// the bytes are handed off to a worker thread in shards as they are
+// produced, so the caller never waits on the disk and never holds more than
+// a few shards in memory.
+class AveragePolicySnapshotter {
+ public:
+  // shard_bytes bounds the size of the chunks handed to the writer thread
+  // (and so the extra peak memory); the default keeps a snapshot's overhead
+  // in the tens of megabytes even when writes are slow.
+  explicit AveragePolicySnapshotter(int shard_bytes = 8 * 1024 * 1024);
+
+  // Flushes pending writes and joins the worker.
+  ~AveragePolicySnapshotter();
+
+  AveragePolicySnapshotter(const AveragePolicySnapshotter&) = delete;
+  AveragePolicySnapshotter& operator=(const AveragePolicySnapshotter&) =
+      delete;
+
+  // Encodes the table's average policy and queues it for writing to
+  // filename, replacing any existing file. Returns once encoding is done;
+  // the write completes in the background. The file is only guaranteed
+  // complete after the next Flush() (or the destructor).
+  void RequestSnapshot(const std::string& filename,
+                       const CFRInfoStateValuesTable& table);
+
+  // Blocks until every queued write has been handed to the filesystem.
+  void Flush();
+
+ private:
+  struct Chunk {
+    std::string filename;
+    std::string bytes;
+    bool first;
+    bool last;
+  };
+
+  void Enqueue(Chunk chunk);
+  void WriterLoop();
+
+  const int shard_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;  // signalled when work arrives or stops.
+  std::condition_variable idle_cv_;   // signalled when the queue drains.
+  std::deque<Chunk> queue_;
+  bool writing_ = false;
+  bool stop_ = false;
+  std::thread writer_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_POLICY_EXPORT_H_
@@ -0,0 +1,111 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/policy_export.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/policy_file.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckMatchesAveragePolicy(const State& state, const Policy& average,
+                               const Policy& frozen) {
+  if (state.IsTerminal()) return;
+  if (!state.IsChanceNode()) {
+    const std::string key = state.InformationStateKey();
+    ActionsAndProbs expected = average.GetStatePolicy(key);
+    ActionsAndProbs actual = frozen.GetStatePolicy(key);
+    SPIEL_CHECK_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+      SPIEL_CHECK_EQ(expected[i].first, actual[i].first);
+      SPIEL_CHECK_FLOAT_EQ(expected[i].second, actual[i].second);
+    }
+  }
+  for (Action action : state.LegalActions()) {
+    CheckMatchesAveragePolicy(*state.Child(action), average, frozen);
+  }
+}
+
+// The streamed file must resolve every infoset to the same probabilities as
+// CFRAveragePolicy over the live table.
+void StreamedFileMatchesAveragePolicyTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  CFRSolver solver(*game);
+  for (int i = 0; i < 100; ++i) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+
+  const std::string filename = "/tmp/open_spiel_policy_export_test.bin";
+  WriteAveragePolicyFile(filename, solver.InfoStateValuesTable());
+  FrozenTabularPolicy frozen(filename);
+  SPIEL_CHECK_GT(frozen.num_entries(), 0);
+
+  std::unique_ptr<Policy> average = solver.AveragePolicy();
+  CheckMatchesAveragePolicy(*game->NewInitialState(), *average, frozen);
+  std::remove(filename.c_str());
+}
+
+std::string ReadWholeFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  SPIEL_CHECK_TRUE(static_cast<bool>(file));
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+// The background writer must produce a file byte-identical to the
+// synchronous writer, even with a tiny shard size forcing many chunks.
+void SnapshotterMatchesSynchronousWriterTest() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  CFRSolver solver(*game);
+  for (int i = 0; i < 10; ++i) {
+    solver.EvaluateAndUpdatePolicy();
+  }
+
+  const std::string sync_filename = "/tmp/open_spiel_policy_export_sync.bin";
+  const std::string async_filename = "/tmp/open_spiel_policy_export_async.bin";
+  WriteAveragePolicyFile(sync_filename, solver.InfoStateValuesTable());
+  {
+    AveragePolicySnapshotter snapshotter(/*shard_bytes=*/64);
+    snapshotter.RequestSnapshot(async_filename,
+                                solver.InfoStateValuesTable());
+    snapshotter.Flush();
+    SPIEL_CHECK_EQ(ReadWholeFile(async_filename),
+                   ReadWholeFile(sync_filename));
+
+    // A second snapshot to the same path replaces the file cleanly.
+    snapshotter.RequestSnapshot(async_filename,
+                                solver.InfoStateValuesTable());
+  }
+  SPIEL_CHECK_EQ(ReadWholeFile(async_filename), ReadWholeFile(sync_filename));
+  std::remove(sync_filename.c_str());
+  std::remove(async_filename.c_str());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::StreamedFileMatchesAveragePolicyTest();
+  open_spiel::algorithms::SnapshotterMatchesSynchronousWriterTest();
+}
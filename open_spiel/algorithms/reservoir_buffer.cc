@@ -0,0 +1,204 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/reservoir_buffer.h"
+
+#include <cstring>
+#include <fstream>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kReservoirBufferMagic = 0x42525354;  // "TSRB".
+constexpr uint32_t kReservoirBufferVersion = 1;
+
+template <typename T>
+void WriteRaw(T value, std::ofstream* file) {
+  file->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(std::ifstream* file) {
+  T value;
+  file->read(reinterpret_cast<char*>(&value), sizeof(T));
+  if (!*file) {
+    SpielFatalError("Reservoir buffer file truncated.");
+  }
+  return value;
+}
+
+}  // namespace
+
+ReservoirBuffer::ReservoirBuffer(int64_t capacity, int num_features,
+                                 int num_targets, int num_shards, int seed)
+    : capacity_(capacity),
+      num_features_(num_features),
+      num_targets_(num_targets),
+      row_width_(num_features + num_targets + 1),
+      num_added_(0) {
+  SPIEL_CHECK_GT(num_features_, 0);
+  SPIEL_CHECK_GE(num_targets_, 0);
+  SPIEL_CHECK_GE(num_shards, 1);
+  SPIEL_CHECK_GE(capacity_, num_shards);
+  shards_.reserve(num_shards);
+  const int64_t base = capacity_ / num_shards;
+  const int64_t remainder = capacity_ % num_shards;
+  for (int s = 0; s < num_shards; ++s) {
+    shards_.emplace_back(new Shard);
+    Shard& shard = *shards_.back();
+    shard.capacity = base + (s < remainder ? 1 : 0);
+    shard.rng.seed(seed + s);
+    shard.rows.reserve(shard.capacity * row_width_);
+  }
+}
+
+void ReservoirBuffer::Add(const double* features, const double* targets,
+                          double weight) {
+  // Round-robin over the shards keeps their stream slices the same size, so
+  // each shard's uniform sub-sample composes into a uniform sample overall.
+  Shard& shard = *shards_[num_added_++ % shards_.size()];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  ++shard.seen;
+  int64_t row;
+  if (shard.size < shard.capacity) {
+    row = shard.size++;
+    shard.rows.resize(shard.size * row_width_);
+  } else {
+    // Classic reservoir rule: keep the newcomer with probability
+    // capacity / seen, evicting a uniformly chosen incumbent.
+    row = std::uniform_int_distribution<int64_t>(0, shard.seen - 1)(shard.rng);
+    if (row >= shard.capacity) return;
+  }
+  double* out = &shard.rows[row * row_width_];
+  std::memcpy(out, features, num_features_ * sizeof(double));
+  std::memcpy(out + num_features_, targets, num_targets_ * sizeof(double));
+  out[num_features_ + num_targets_] = weight;
+}
+
+int64_t ReservoirBuffer::size() const {
+  int64_t total = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    total += shard->size;
+  }
+  return total;
+}
+
+void ReservoirBuffer::SampleBatch(int batch_size, std::mt19937* rng,
+                                  std::vector<double>* features,
+                                  std::vector<double>* targets,
+                                  std::vector<double>* weights) const {
+  const int64_t total = size();
+  SPIEL_CHECK_GT(total, 0);
+  features->resize(batch_size * num_features_);
+  targets->resize(batch_size * num_targets_);
+  if (weights != nullptr) weights->resize(batch_size);
+  std::uniform_int_distribution<int64_t> dist(0, total - 1);
+  for (int b = 0; b < batch_size; ++b) {
+    int64_t index = dist(*rng);
+    // Map the global row index onto a shard.
+    for (const auto& shard : shards_) {
+      if (index >= shard->size) {
+        index -= shard->size;
+        continue;
+      }
+      const double* row = &shard->rows[index * row_width_];
+      std::memcpy(&(*features)[b * num_features_], row,
+                  num_features_ * sizeof(double));
+      std::memcpy(&(*targets)[b * num_targets_], row + num_features_,
+                  num_targets_ * sizeof(double));
+      if (weights != nullptr) {
+        (*weights)[b] = row[num_features_ + num_targets_];
+      }
+      break;
+    }
+  }
+}
+
+void ReservoirBuffer::Clear() {
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->seen = 0;
+    shard->size = 0;
+    shard->rows.clear();
+  }
+  num_added_ = 0;
+}
+
+void ReservoirBuffer::Save(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError(
+        absl::StrCat("Could not open reservoir buffer file for write: ",
+                     filename));
+  }
+  WriteRaw<uint32_t>(kReservoirBufferMagic, &file);
+  WriteRaw<uint32_t>(kReservoirBufferVersion, &file);
+  WriteRaw<int64_t>(capacity_, &file);
+  WriteRaw<uint32_t>(num_features_, &file);
+  WriteRaw<uint32_t>(num_targets_, &file);
+  WriteRaw<uint32_t>(shards_.size(), &file);
+  WriteRaw<int64_t>(num_added_.load(), &file);
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    WriteRaw<int64_t>(shard->seen, &file);
+    WriteRaw<int64_t>(shard->size, &file);
+    file.write(reinterpret_cast<const char*>(shard->rows.data()),
+               shard->rows.size() * sizeof(double));
+  }
+  if (!file) {
+    SpielFatalError(
+        absl::StrCat("Error writing reservoir buffer file: ", filename));
+  }
+}
+
+void ReservoirBuffer::Load(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError(
+        absl::StrCat("Could not open reservoir buffer file: ", filename));
+  }
+  if (ReadRaw<uint32_t>(&file) != kReservoirBufferMagic) {
+    SpielFatalError(absl::StrCat("Not a reservoir buffer file: ", filename));
+  }
+  uint32_t version = ReadRaw<uint32_t>(&file);
+  if (version != kReservoirBufferVersion) {
+    SpielFatalError(
+        absl::StrCat("Unsupported reservoir buffer version: ", version));
+  }
+  SPIEL_CHECK_EQ(ReadRaw<int64_t>(&file), capacity_);
+  SPIEL_CHECK_EQ(ReadRaw<uint32_t>(&file), num_features_);
+  SPIEL_CHECK_EQ(ReadRaw<uint32_t>(&file), num_targets_);
+  SPIEL_CHECK_EQ(ReadRaw<uint32_t>(&file), shards_.size());
+  num_added_ = ReadRaw<int64_t>(&file);
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->seen = ReadRaw<int64_t>(&file);
+    shard->size = ReadRaw<int64_t>(&file);
+    SPIEL_CHECK_LE(shard->size, shard->capacity);
+    shard->rows.resize(shard->size * row_width_);
+    file.read(reinterpret_cast<char*>(shard->rows.data()),
+              shard->rows.size() * sizeof(double));
+    if (!file) {
+      SpielFatalError(
+          absl::StrCat("Reservoir buffer file truncated: ", filename));
+    }
+  }
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
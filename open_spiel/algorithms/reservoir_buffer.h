@@ -0,0 +1,112 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RESERVOIR_BUFFER_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RESERVOIR_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A fixed-capacity reservoir buffer of (features, targets, weight) rows, the
+// training-data structure used by Deep-CFR-style pipelines: sampled MCCFR
+// traversals offer an (infostate vector, per-action regret) sample per visited
+// node, and the buffer keeps a uniform random subset of everything offered.
+//
+// Rows are stored flat (features, then targets, then the weight, all doubles)
+// in preallocated storage, so filling the buffer does no per-sample
+// allocation. The buffer is sharded: adds are spread round-robin over
+// independently locked sub-reservoirs, so concurrent traversal threads only
+// contend on an atomic counter and 1/num_shards of the time on the same
+// shard. Each shard holds a uniform sample of its (evenly sized) slice of the
+// stream, so the union remains a uniform sample of the whole stream.
+class ReservoirBuffer {
+ public:
+  // capacity is the total number of rows retained across all shards;
+  // num_shards must divide into it at least one row per shard. Shard RNGs are
+  // seeded from seed, so the retained set is deterministic for a given
+  // (seed, num_shards) pair and add order.
+  ReservoirBuffer(int64_t capacity, int num_features, int num_targets,
+                  int num_shards = 16, int seed = 0);
+
+  // Offers one sample to the reservoir. Thread-safe. The arrays must hold
+  // num_features and num_targets entries respectively.
+  void Add(const double* features, const double* targets, double weight);
+  void Add(const std::vector<double>& features,
+           const std::vector<double>& targets, double weight) {
+    SPIEL_CHECK_EQ(features.size(), num_features_);
+    SPIEL_CHECK_EQ(targets.size(), num_targets_);
+    Add(features.data(), targets.data(), weight);
+  }
+
+  // Copies batch_size rows drawn uniformly (with replacement) from the
+  // retained samples into contiguous row-major output: features gets
+  // batch_size * num_features entries, targets batch_size * num_targets, and
+  // weights one entry per row. The outputs are resized; pass nullptr for
+  // weights to skip them. Not safe to run concurrently with Add.
+  void SampleBatch(int batch_size, std::mt19937* rng,
+                   std::vector<double>* features, std::vector<double>* targets,
+                   std::vector<double>* weights) const;
+
+  // Number of rows currently retained (at most capacity).
+  int64_t size() const;
+  // Number of samples ever offered via Add.
+  int64_t num_added() const { return num_added_.load(); }
+  int64_t capacity() const { return capacity_; }
+  int num_features() const { return num_features_; }
+  int num_targets() const { return num_targets_; }
+
+  // Discards all retained rows and resets the stream counters.
+  void Clear();
+
+  // Spills the buffer to a binary file, replacing any existing file, and
+  // restores it. Loading requires the buffer to have been constructed with
+  // the same capacity, row shape, and shard count as the saved one, and
+  // replaces its contents. Calls SpielFatalError on I/O errors or mismatch.
+  void Save(const std::string& filename) const;
+  void Load(const std::string& filename);
+
+ private:
+  // An independently locked sub-reservoir over a slice of the stream.
+  struct Shard {
+    std::mutex mutex;
+    std::mt19937 rng;
+    int64_t capacity = 0;
+    int64_t seen = 0;  // Samples offered to this shard so far.
+    int64_t size = 0;  // Rows currently retained, <= capacity.
+    std::vector<double> rows;  // size * row_width, flat row-major.
+  };
+
+  int64_t capacity_;
+  int num_features_;
+  int num_targets_;
+  int row_width_;  // num_features_ + num_targets_ + 1 (weight).
+  std::atomic<int64_t> num_added_;
+  // unique_ptr because std::mutex makes Shard immovable.
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_RESERVOIR_BUFFER_H_
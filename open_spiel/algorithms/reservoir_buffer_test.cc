@@ -0,0 +1,147 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/reservoir_buffer.h"
+
+#include <cstdio>
+#include <thread>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void FillAndSampleTest() {
+  ReservoirBuffer buffer(/*capacity=*/100, /*num_features=*/3,
+                         /*num_targets=*/2, /*num_shards=*/4);
+  // Below capacity, every offered row is retained.
+  for (int i = 0; i < 50; ++i) {
+    std::vector<double> features = {1.0 * i, 2.0 * i, 3.0 * i};
+    std::vector<double> targets = {-1.0 * i, -2.0 * i};
+    buffer.Add(features, targets, /*weight=*/i + 1.0);
+  }
+  SPIEL_CHECK_EQ(buffer.size(), 50);
+  SPIEL_CHECK_EQ(buffer.num_added(), 50);
+
+  // Every sampled row is one of the rows that was offered, with its fields
+  // kept together.
+  std::mt19937 rng(17);
+  std::vector<double> features;
+  std::vector<double> targets;
+  std::vector<double> weights;
+  buffer.SampleBatch(32, &rng, &features, &targets, &weights);
+  SPIEL_CHECK_EQ(features.size(), 32 * 3);
+  SPIEL_CHECK_EQ(targets.size(), 32 * 2);
+  SPIEL_CHECK_EQ(weights.size(), 32);
+  for (int b = 0; b < 32; ++b) {
+    const double i = features[b * 3];
+    SPIEL_CHECK_GE(i, 0);
+    SPIEL_CHECK_LT(i, 50);
+    SPIEL_CHECK_FLOAT_EQ(features[b * 3 + 1], 2.0 * i);
+    SPIEL_CHECK_FLOAT_EQ(features[b * 3 + 2], 3.0 * i);
+    SPIEL_CHECK_FLOAT_EQ(targets[b * 2], -1.0 * i);
+    SPIEL_CHECK_FLOAT_EQ(targets[b * 2 + 1], -2.0 * i);
+    SPIEL_CHECK_FLOAT_EQ(weights[b], i + 1.0);
+  }
+}
+
+void UniformRetentionTest() {
+  const int kCapacity = 200;
+  const int kStream = 20000;
+  ReservoirBuffer buffer(kCapacity, /*num_features=*/1, /*num_targets=*/1,
+                         /*num_shards=*/8);
+  for (int i = 0; i < kStream; ++i) {
+    double feature = i;
+    double target = 0;
+    buffer.Add(&feature, &target, 1.0);
+  }
+  SPIEL_CHECK_EQ(buffer.size(), kCapacity);
+  SPIEL_CHECK_EQ(buffer.num_added(), kStream);
+
+  // The retained rows are a uniform sample of the stream, so their mean
+  // index is near the middle of the stream (loose bound).
+  std::mt19937 rng(99);
+  std::vector<double> features;
+  std::vector<double> targets;
+  buffer.SampleBatch(1000, &rng, &features, &targets, /*weights=*/nullptr);
+  double mean = 0;
+  for (double f : features) mean += f;
+  mean /= features.size();
+  SPIEL_CHECK_GT(mean, 0.35 * kStream);
+  SPIEL_CHECK_LT(mean, 0.65 * kStream);
+}
+
+void ConcurrentAddTest() {
+  const int kThreads = 4;
+  const int kPerThread = 5000;
+  ReservoirBuffer buffer(/*capacity=*/128, /*num_features=*/2,
+                         /*num_targets=*/1, /*num_shards=*/16);
+  std::vector<std::thread> workers;
+  workers.reserve(kThreads);
+  for (int t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&buffer, t]() {
+      for (int i = 0; i < kPerThread; ++i) {
+        double features[2] = {1.0 * t, 1.0 * i};
+        double target = t + i;
+        buffer.Add(features, &target, 1.0);
+      }
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  SPIEL_CHECK_EQ(buffer.num_added(), kThreads * kPerThread);
+  SPIEL_CHECK_EQ(buffer.size(), 128);
+}
+
+void SaveLoadTest() {
+  std::string filename = "/tmp/open_spiel_reservoir_buffer_test";
+  std::remove(filename.c_str());
+
+  ReservoirBuffer buffer(/*capacity=*/64, /*num_features=*/2,
+                         /*num_targets=*/2, /*num_shards=*/4, /*seed=*/1);
+  for (int i = 0; i < 500; ++i) {
+    std::vector<double> features = {1.0 * i, -1.0 * i};
+    std::vector<double> targets = {0.5 * i, 2.0 * i};
+    buffer.Add(features, targets, 1.0);
+  }
+  buffer.Save(filename);
+
+  ReservoirBuffer loaded(/*capacity=*/64, /*num_features=*/2,
+                         /*num_targets=*/2, /*num_shards=*/4, /*seed=*/1);
+  loaded.Load(filename);
+  SPIEL_CHECK_EQ(loaded.size(), buffer.size());
+  SPIEL_CHECK_EQ(loaded.num_added(), buffer.num_added());
+
+  // Identical contents: the same generator draws the same batch from both.
+  std::mt19937 rng_a(7);
+  std::mt19937 rng_b(7);
+  std::vector<double> features_a, targets_a, features_b, targets_b;
+  buffer.SampleBatch(64, &rng_a, &features_a, &targets_a, nullptr);
+  loaded.SampleBatch(64, &rng_b, &features_b, &targets_b, nullptr);
+  SPIEL_CHECK_TRUE(features_a == features_b);
+  SPIEL_CHECK_TRUE(targets_a == targets_b);
+
+  std::remove(filename.c_str());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::FillAndSampleTest();
+  open_spiel::algorithms::UniformRetentionTest();
+  open_spiel::algorithms::ConcurrentAddTest();
+  open_spiel::algorithms::SaveLoadTest();
+}
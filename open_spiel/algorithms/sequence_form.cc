@@ -0,0 +1,179 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+SequenceFormGame::SequenceFormGame(const Game& game)
+    : info_sets_(2), info_set_index_(2), num_sequences_(2, 1) {
+  const GameType& game_type = game.GetType();
+  if (game_type.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("SequenceFormGame: the game must be turn-based.");
+  }
+  if (game_type.utility != GameType::Utility::kZeroSum &&
+      game_type.utility != GameType::Utility::kConstantSum) {
+    SpielFatalError(
+        "SequenceFormGame: the game must have zero- or constant-sum "
+        "utility.");
+  }
+  SPIEL_CHECK_EQ(game.NumPlayers(), 2);
+
+  std::unique_ptr<State> root = game.NewInitialState();
+  Compile(*root, /*chance_reach=*/1.0, kEmptySequence, kEmptySequence);
+
+  // Compress the accumulated triplets into CSC: sort by (column, row), then
+  // merge duplicates — several terminal histories can share a sequence pair
+  // when they differ only in chance outcomes neither player observes.
+  std::sort(triplets_.begin(), triplets_.end(),
+            [](const std::pair<std::pair<int, int>, double>& a,
+               const std::pair<std::pair<int, int>, double>& b) {
+              return std::make_pair(a.first.second, a.first.first) <
+                     std::make_pair(b.first.second, b.first.first);
+            });
+  payoffs_.num_rows = num_sequences_[0];
+  payoffs_.num_cols = num_sequences_[1];
+  payoffs_.col_starts.assign(payoffs_.num_cols + 1, 0);
+  for (std::size_t i = 0; i < triplets_.size(); ++i) {
+    if (i > 0 && triplets_[i - 1].first == triplets_[i].first) {
+      payoffs_.values.back() += triplets_[i].second;
+      continue;
+    }
+    payoffs_.rows.push_back(triplets_[i].first.first);
+    payoffs_.values.push_back(triplets_[i].second);
+    ++payoffs_.col_starts[triplets_[i].first.second + 1];
+  }
+  for (int j = 0; j < payoffs_.num_cols; ++j) {
+    payoffs_.col_starts[j + 1] += payoffs_.col_starts[j];
+  }
+  triplets_.clear();
+  triplets_.shrink_to_fit();
+}
+
+int SequenceFormGame::NumSequences(int player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, 2);
+  return num_sequences_[player];
+}
+
+const std::vector<SequenceFormInfoSet>& SequenceFormGame::InfoSets(
+    int player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, 2);
+  return info_sets_[player];
+}
+
+int SequenceFormGame::InfoSetIndex(const State& state, int parent_sequence) {
+  const int player = state.CurrentPlayer();
+  // Keyed on InformationStateKey so realization plans can look up policies
+  // produced by the tabular solvers, which key their tables the same way.
+  std::string info_state = state.InformationStateKey(player);
+  auto iter = info_set_index_[player].find(info_state);
+  if (iter != info_set_index_[player].end()) {
+    // Perfect recall: every history in the information set shares the
+    // player's sequence.
+    SPIEL_CHECK_EQ(info_sets_[player][iter->second].parent_sequence,
+                   parent_sequence);
+    return iter->second;
+  }
+  const int index = info_sets_[player].size();
+  SequenceFormInfoSet info_set;
+  info_set.info_state = info_state;
+  info_set.parent_sequence = parent_sequence;
+  info_set.first_sequence = num_sequences_[player];
+  info_set.legal_actions = state.LegalActions();
+  num_sequences_[player] += info_set.legal_actions.size();
+  info_sets_[player].push_back(std::move(info_set));
+  info_set_index_[player].emplace(std::move(info_state), index);
+  return index;
+}
+
+void SequenceFormGame::Compile(const State& state, double chance_reach,
+                               int p0_sequence, int p1_sequence) {
+  if (state.IsTerminal()) {
+    triplets_.push_back({{p0_sequence, p1_sequence},
+                         chance_reach * state.PlayerReturn(0)});
+    return;
+  }
+  if (state.IsChanceNode()) {
+    for (const auto& outcome : state.ChanceOutcomes()) {
+      std::unique_ptr<State> child = state.Child(outcome.first);
+      Compile(*child, chance_reach * outcome.second, p0_sequence,
+              p1_sequence);
+    }
+    return;
+  }
+  const int player = state.CurrentPlayer();
+  const int index =
+      InfoSetIndex(state, player == 0 ? p0_sequence : p1_sequence);
+  SPIEL_CHECK_TRUE(info_sets_[player][index].legal_actions ==
+                   state.LegalActions());
+  const int first_sequence = info_sets_[player][index].first_sequence;
+  const std::vector<Action> legal_actions = state.LegalActions();
+  for (std::size_t i = 0; i < legal_actions.size(); ++i) {
+    const int sequence = first_sequence + i;
+    std::unique_ptr<State> child = state.Child(legal_actions[i]);
+    Compile(*child, chance_reach, player == 0 ? sequence : p0_sequence,
+            player == 1 ? sequence : p1_sequence);
+  }
+}
+
+std::vector<double> SequenceFormGame::RealizationPlan(
+    int player, const Policy& policy) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, 2);
+  std::vector<double> plan(num_sequences_[player], 0);
+  plan[kEmptySequence] = 1.0;
+  // Construction order puts parents first, so one forward pass suffices.
+  for (const SequenceFormInfoSet& info_set : info_sets_[player]) {
+    ActionsAndProbs state_policy = policy.GetStatePolicy(info_set.info_state);
+    if (state_policy.empty()) {
+      SpielFatalError(absl::StrCat("InfoState ", info_set.info_state,
+                                   " not found in policy."));
+    }
+    const double reach = plan[info_set.parent_sequence];
+    for (std::size_t i = 0; i < info_set.legal_actions.size(); ++i) {
+      plan[info_set.first_sequence + i] =
+          reach * GetProb(state_policy, info_set.legal_actions[i]);
+    }
+  }
+  return plan;
+}
+
+double SequenceFormGame::Value(const std::vector<double>& p0_plan,
+                               const std::vector<double>& p1_plan) const {
+  SPIEL_CHECK_EQ(p0_plan.size(), payoffs_.num_rows);
+  SPIEL_CHECK_EQ(p1_plan.size(), payoffs_.num_cols);
+  double value = 0;
+  for (int j = 0; j < payoffs_.num_cols; ++j) {
+    if (p1_plan[j] == 0) continue;
+    double column_sum = 0;
+    for (int k = payoffs_.col_starts[j]; k < payoffs_.col_starts[j + 1];
+         ++k) {
+      column_sum += payoffs_.values[k] * p0_plan[payoffs_.rows[k]];
+    }
+    value += column_sum * p1_plan[j];
+  }
+  return value;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,120 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// A sequence-form compiler for two-player zero-sum (or constant-sum)
+// turn-based games. The sequence form (Koller, Megiddo & von Stengel 1996)
+// represents each player's strategy space by realization plans over
+// "sequences" — one variable per (information set, action) pair plus one for
+// the empty sequence — so equilibrium computation becomes a linear program
+// whose size is linear in the game tree rather than exponential as in the
+// normal form. This module builds the realization-plan index space and the
+// sparse payoff matrix from one walk of the game tree; LP and gradient
+// solvers consume the result directly through the in-memory structures below.
+
+namespace open_spiel {
+namespace algorithms {
+
+// One information set in the sequence-form index space. A player's sequences
+// are numbered contiguously: sequence 0 is the empty sequence, and each
+// information set owns the block [first_sequence, first_sequence +
+// legal_actions.size()), one sequence per action in legal-action order. The
+// realization-plan constraint for the information set is
+//   sum of the block's variables == the parent_sequence variable.
+struct SequenceFormInfoSet {
+  // The information set's InformationStateKey — the same key the tabular
+  // solvers and TabularPolicy use, so it can probe their policies directly.
+  std::string info_state;
+  // The player's last sequence on the path to this information set; the
+  // empty sequence (0) if the player has not acted yet. Well-defined by
+  // perfect recall.
+  int parent_sequence;
+  int first_sequence;
+  std::vector<Action> legal_actions;
+};
+
+// A sparse matrix in compressed sparse column layout: the nonzeros of column
+// j are values[k] at row rows[k] for k in [col_starts[j], col_starts[j + 1]),
+// sorted by row within each column.
+struct CscMatrix {
+  int num_rows = 0;
+  int num_cols = 0;
+  std::vector<int> col_starts;  // Size num_cols + 1.
+  std::vector<int> rows;
+  std::vector<double> values;
+};
+
+class SequenceFormGame {
+ public:
+  static constexpr int kEmptySequence = 0;
+
+  // Compiles the game. Walks the full tree once; the game must be two-player,
+  // turn-based, and zero- or constant-sum.
+  explicit SequenceFormGame(const Game& game);
+
+  int NumSequences(int player) const;
+
+  // The information sets in construction (depth-first) order, which
+  // guarantees each information set appears after the one owning its parent
+  // sequence. So a single forward pass over this vector can propagate
+  // realization weights top-down (as RealizationPlan does).
+  const std::vector<SequenceFormInfoSet>& InfoSets(int player) const;
+
+  // Player 0's payoff matrix: rows are player 0 sequences, columns are
+  // player 1 sequences, and the entry for a pair of terminal sequences is
+  // player 0's return summed over the terminal histories consistent with the
+  // pair, weighted by chance reach. Player 0's expected return under
+  // realization plans (x, y) is x^T A y; player 1's follows from the
+  // constant sum.
+  const CscMatrix& PayoffMatrix() const { return payoffs_; }
+
+  // Converts a behavioral policy into the player's realization plan: entry s
+  // is the product of the policy's probabilities along sequence s.
+  std::vector<double> RealizationPlan(int player,
+                                      const Policy& policy) const;
+
+  // Evaluates x^T A y, player 0's expected return under the two plans.
+  double Value(const std::vector<double>& p0_plan,
+               const std::vector<double>& p1_plan) const;
+
+ private:
+  // Returns the index of the information set the state belongs to, creating
+  // it (and allocating its block of sequences) on first visit. On revisits,
+  // checks the parent sequence matches — perfect recall guarantees it.
+  int InfoSetIndex(const State& state, int parent_sequence);
+  void Compile(const State& state, double chance_reach, int p0_sequence,
+               int p1_sequence);
+
+  std::vector<std::vector<SequenceFormInfoSet>> info_sets_;
+  std::vector<std::unordered_map<std::string, int>> info_set_index_;
+  std::vector<int> num_sequences_;
+  CscMatrix payoffs_;
+  // (row, col, value) entries accumulated during Compile, compressed into
+  // payoffs_ afterwards; cleared once compiled.
+  std::vector<std::pair<std::pair<int, int>, double>> triplets_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_SEQUENCE_FORM_H_
@@ -0,0 +1,97 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/sequence_form.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/expected_returns.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void KuhnDimensionsTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  SequenceFormGame seq_form(*game);
+  // Each player has 6 information sets (3 cards times 2 betting histories),
+  // each with 2 actions, plus the empty sequence.
+  for (int player = 0; player < 2; ++player) {
+    SPIEL_CHECK_EQ(seq_form.InfoSets(player).size(), 6);
+    SPIEL_CHECK_EQ(seq_form.NumSequences(player), 13);
+  }
+  // 6 deals times 5 terminal betting lines, and no two terminal histories
+  // share a sequence pair (the deals are distinguished by both players'
+  // cards), so every terminal is its own nonzero.
+  const CscMatrix& payoffs = seq_form.PayoffMatrix();
+  SPIEL_CHECK_EQ(payoffs.num_rows, 13);
+  SPIEL_CHECK_EQ(payoffs.num_cols, 13);
+  SPIEL_CHECK_EQ(payoffs.values.size(), 30);
+  SPIEL_CHECK_EQ(payoffs.rows.size(), 30);
+  SPIEL_CHECK_EQ(payoffs.col_starts.size(), 14);
+  SPIEL_CHECK_EQ(payoffs.col_starts.back(), 30);
+}
+
+void RealizationPlanConstraintsTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  SequenceFormGame seq_form(*game);
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  for (int player = 0; player < 2; ++player) {
+    std::vector<double> plan =
+        seq_form.RealizationPlan(player, uniform_policy);
+    SPIEL_CHECK_EQ(plan.size(), seq_form.NumSequences(player));
+    SPIEL_CHECK_FLOAT_EQ(plan[SequenceFormGame::kEmptySequence], 1.0);
+    // Each information set's block sums to its parent sequence's weight.
+    for (const SequenceFormInfoSet& info_set : seq_form.InfoSets(player)) {
+      double block_sum = 0;
+      for (std::size_t i = 0; i < info_set.legal_actions.size(); ++i) {
+        block_sum += plan[info_set.first_sequence + i];
+      }
+      SPIEL_CHECK_FLOAT_EQ(block_sum, plan[info_set.parent_sequence]);
+    }
+  }
+}
+
+// x^T A y under the sequence form must agree with a direct expected-returns
+// tree walk under the same (behavioral) policy.
+void ValueMatchesExpectedReturnsTest(const std::string& game_string) {
+  std::unique_ptr<Game> game = LoadGame(game_string);
+  SequenceFormGame seq_form(*game);
+  TabularPolicy uniform_policy = GetUniformPolicy(*game);
+  std::vector<double> p0_plan =
+      seq_form.RealizationPlan(0, uniform_policy);
+  std::vector<double> p1_plan =
+      seq_form.RealizationPlan(1, uniform_policy);
+  std::unique_ptr<State> root = game->NewInitialState();
+  std::vector<double> expected =
+      ExpectedReturns(*root, uniform_policy, /*depth_limit=*/-1);
+  SPIEL_CHECK_FLOAT_EQ(seq_form.Value(p0_plan, p1_plan), expected[0]);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+namespace algorithms = open_spiel::algorithms;
+
+int main(int argc, char** argv) {
+  algorithms::KuhnDimensionsTest();
+  algorithms::RealizationPlanConstraintsTest();
+  algorithms::ValueMatchesExpectedReturnsTest("kuhn_poker");
+  algorithms::ValueMatchesExpectedReturnsTest("leduc_poker");
+}
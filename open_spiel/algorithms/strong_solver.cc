@@ -0,0 +1,209 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/strong_solver.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// File layout, in order. All fields are little-endian.
+//   uint32 magic, uint32 version, uint64 num_states
+//   uint8  packed[ceil(num_states / 4)]   (2 bits each: 0 loss, 1 draw,
+//                                          2 win, low bits first)
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+constexpr std::size_t kWDLFileHeaderSize = 2 * sizeof(uint32_t) +
+                                           sizeof(uint64_t);
+
+}  // namespace
+
+std::vector<int8_t> StrongSolve(const GameGraph& graph) {
+  SPIEL_CHECK_EQ(graph.num_players, 2);
+  const int num_states = graph.NumStates();
+  const int num_slots = graph.action.size();
+  for (int slot = 0; slot < num_slots; ++slot) {
+    if (graph.outcome_begin[slot + 1] - graph.outcome_begin[slot] != 1) {
+      SpielFatalError("StrongSolve requires a deterministic game.");
+    }
+  }
+
+  // Predecessor edges of every state, CSR-flattened like the graph itself.
+  std::vector<int> pred_begin(num_states + 1, 0);
+  for (int slot = 0; slot < num_slots; ++slot) {
+    ++pred_begin[graph.successor[graph.outcome_begin[slot]] + 1];
+  }
+  for (int id = 0; id < num_states; ++id) {
+    pred_begin[id + 1] += pred_begin[id];
+  }
+  std::vector<int> pred(num_slots);
+  {
+    std::vector<int> cursor(pred_begin.begin(), pred_begin.end() - 1);
+    for (int id = 0; id < num_states; ++id) {
+      for (int slot = graph.action_begin[id]; slot < graph.action_begin[id + 1];
+           ++slot) {
+        pred[cursor[graph.successor[graph.outcome_begin[slot]]]++] = id;
+      }
+    }
+  }
+
+  // Retrograde analysis from the terminals. A state resolves as soon as a
+  // winning child for its player resolves, or once all its children have
+  // resolved; whatever the fixpoint never reaches is a draw by infinite
+  // play (or a cut-off subtree on depth-limited graphs).
+  std::vector<int8_t> values(num_states, kWDLDraw);
+  std::vector<bool> resolved(num_states, false);
+  std::vector<int> pending(num_states, 0);
+  std::vector<int8_t> best(num_states, kWDLDraw);
+  std::vector<int> queue;
+  queue.reserve(num_states);
+  for (int id = 0; id < num_states; ++id) {
+    if (graph.is_terminal[id]) {
+      const double player0_return = graph.Return(id, 0);
+      values[id] = player0_return > 0 ? kWDLWin
+                                      : player0_return < 0 ? kWDLLoss
+                                                           : kWDLDraw;
+      resolved[id] = true;
+      queue.push_back(id);
+    } else {
+      pending[id] = graph.action_begin[id + 1] - graph.action_begin[id];
+      best[id] = graph.player[id] == 0 ? kWDLLoss : kWDLWin;
+    }
+  }
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int child = queue[head];
+    const int8_t child_value = values[child];
+    for (int edge = pred_begin[child]; edge < pred_begin[child + 1]; ++edge) {
+      const int id = pred[edge];
+      if (resolved[id]) continue;
+      const int8_t win = graph.player[id] == 0 ? kWDLWin : kWDLLoss;
+      if (child_value == win) {
+        values[id] = win;
+        resolved[id] = true;
+        queue.push_back(id);
+      } else {
+        best[id] = graph.player[id] == 0 ? std::max(best[id], child_value)
+                                         : std::min(best[id], child_value);
+        if (--pending[id] == 0) {
+          values[id] = best[id];
+          resolved[id] = true;
+          queue.push_back(id);
+        }
+      }
+    }
+  }
+  return values;
+}
+
+std::function<std::string(const State&)> CanonicalKeyFunction() {
+  return [](const State& state) { return state.CanonicalKey(); };
+}
+
+void SaveWDLFile(const std::vector<int8_t>& values,
+                 const std::string& filename) {
+  std::string buffer;
+  AppendRaw<uint32_t>(kWDLFileMagic, &buffer);
+  AppendRaw<uint32_t>(kWDLFileVersion, &buffer);
+  AppendRaw<uint64_t>(values.size(), &buffer);
+  for (std::size_t i = 0; i < values.size(); i += 4) {
+    uint8_t byte = 0;
+    for (std::size_t j = i; j < std::min(i + 4, values.size()); ++j) {
+      SPIEL_CHECK_GE(values[j], kWDLLoss);
+      SPIEL_CHECK_LE(values[j], kWDLWin);
+      byte |= static_cast<uint8_t>(values[j] + 1) << (2 * (j - i));
+    }
+    buffer.push_back(static_cast<char>(byte));
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open WDL file for writing: " + filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write WDL file: " + filename);
+  }
+}
+
+WDLFile::WDLFile(const std::string& filename) {
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    SpielFatalError("Could not open WDL file: " + filename);
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    SpielFatalError("Could not stat WDL file: " + filename);
+  }
+  size_ = file_stat.st_size;
+  if (size_ < kWDLFileHeaderSize) {
+    SpielFatalError("WDL file too small: " + filename);
+  }
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError("Could not map WDL file: " + filename);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  uint32_t magic, version;
+  uint64_t num_states;
+  std::memcpy(&magic, data_, sizeof(magic));
+  std::memcpy(&version, data_ + 4, sizeof(version));
+  std::memcpy(&num_states, data_ + 8, sizeof(num_states));
+  if (magic != kWDLFileMagic) {
+    SpielFatalError("Not a WDL file: " + filename);
+  }
+  if (version != kWDLFileVersion) {
+    SpielFatalError("Unsupported WDL file version in: " + filename);
+  }
+  num_states_ = num_states;
+  if (size_ != kWDLFileHeaderSize + (num_states_ + 3) / 4) {
+    SpielFatalError("WDL file has inconsistent size: " + filename);
+  }
+  packed_ = data_ + kWDLFileHeaderSize;
+}
+
+WDLFile::~WDLFile() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+int8_t WDLFile::Get(std::size_t id) const {
+  SPIEL_CHECK_LT(id, num_states_);
+  return static_cast<int8_t>((packed_[id / 4] >> (2 * (id % 4))) & 3) - 1;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
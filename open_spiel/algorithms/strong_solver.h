@@ -0,0 +1,101 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STRONG_SOLVER_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STRONG_SOLVER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/game_graph.h"
+#include "open_spiel/spiel.h"
+
+// A strong solver for two-player zero-sum deterministic games over a
+// compiled GameGraph: retrograde analysis assigns every state its
+// win/draw/loss (WDL) value under optimal play by both sides. Values
+// propagate backwards from the terminals along predecessor lists, so cyclic
+// state spaces are handled: states from which neither player can force a
+// win are draws by infinite play. On a depth-limited graph the cut-off
+// states count as draws, giving a horizon-limited solve.
+//
+// Solving a game once and probing the stored table replaces search
+// entirely for evaluation baselines. The values pack into 2 bits per state
+// (WDL files) and are probed through a read-only mmap, so even large
+// tables cost no startup time and are shared between processes.
+//
+// To make more games fit, compile the graph with a symmetry-canonicalizing
+// key (CompileGameGraph's canonical_key argument). Games whose type sets
+// provides_canonical_key expose one as State::CanonicalKey (connect_four's
+// mirror, pentago's 8-fold board symmetry); probing then goes through the
+// same key:
+//   wdl.Get(graph.StateId(state.CanonicalKey())).
+
+namespace open_spiel {
+namespace algorithms {
+
+// WDL values, always from player 0's perspective.
+constexpr int8_t kWDLLoss = -1;
+constexpr int8_t kWDLDraw = 0;
+constexpr int8_t kWDLWin = 1;
+
+// Solves the graph by retrograde analysis and returns the WDL value of
+// every state id. The graph must be two-player and deterministic (no
+// chance nodes); terminal values are the sign of player 0's return, so the
+// game must be zero-sum for the values to mean optimal play.
+std::vector<int8_t> StrongSolve(const GameGraph& graph);
+
+// The canonical_key argument for CompileGameGraph that keys states by
+// their CanonicalKey, merging symmetric positions. Only useful for games
+// whose type sets provides_canonical_key; elsewhere it degrades to the
+// plain ToString identity.
+std::function<std::string(const State&)> CanonicalKeyFunction();
+
+constexpr uint32_t kWDLFileMagic = 0x4c44574f;  // "OWDL", little-endian.
+constexpr uint32_t kWDLFileVersion = 1;
+
+// Writes the values as a packed WDL file, 2 bits per state, replacing any
+// existing file.
+void SaveWDLFile(const std::vector<int8_t>& values,
+                 const std::string& filename);
+
+// A memory-mapped packed WDL file. Entries are indexed by the state id of
+// the graph the values were solved on, so the prober must pair the file
+// with the same graph compilation (same game, depth limit and canonical
+// key).
+class WDLFile {
+ public:
+  explicit WDLFile(const std::string& filename);
+  ~WDLFile();
+  WDLFile(const WDLFile&) = delete;
+  WDLFile& operator=(const WDLFile&) = delete;
+
+  std::size_t num_states() const { return num_states_; }
+
+  // The WDL value of a state id, from player 0's perspective.
+  int8_t Get(std::size_t id) const;
+
+ private:
+  std::size_t num_states_ = 0;
+  int fd_ = -1;
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+  const uint8_t* packed_ = nullptr;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_STRONG_SOLVER_H_
@@ -0,0 +1,118 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/strong_solver.h"
+
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// Tic-tac-toe is fully solvable and its values are known.
+void TicTacToeSolveTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameGraph graph = CompileGameGraph(*game);
+  std::vector<int8_t> values = StrongSolve(graph);
+  SPIEL_CHECK_EQ(values.size(), graph.NumStates());
+
+  // Perfect play draws.
+  std::unique_ptr<State> state = game->NewInitialState();
+  SPIEL_CHECK_EQ(values[graph.StateId(state->ToString())], kWDLDraw);
+
+  // x(0) o(3) x(1) o(4): x completes the top row before o's threat lands.
+  for (Action action : {0, 3, 1, 4}) state->ApplyAction(action);
+  SPIEL_CHECK_EQ(values[graph.StateId(state->ToString())], kWDLWin);
+
+  state->ApplyAction(2);
+  SPIEL_CHECK_TRUE(state->IsTerminal());
+  SPIEL_CHECK_EQ(values[graph.StateId(state->ToString())], kWDLWin);
+}
+
+// The mirror canonicalizer merges reflected connect_four states and the
+// reduced graph still solves.
+void ConnectFourMirrorTest() {
+  std::unique_ptr<Game> game = LoadGame("connect_four");
+  GameGraph plain = CompileGameGraph(*game, /*depth_limit=*/5);
+  GameGraph reduced =
+      CompileGameGraph(*game, /*depth_limit=*/5, CanonicalKeyFunction());
+  SPIEL_CHECK_LT(reduced.NumStates(), plain.NumStates());
+
+  // A move in column 0 and its mirror in column 6 share one id.
+  std::unique_ptr<State> left = game->NewInitialState();
+  left->ApplyAction(0);
+  std::unique_ptr<State> right = game->NewInitialState();
+  right->ApplyAction(6);
+  SPIEL_CHECK_EQ(left->CanonicalKey(), right->CanonicalKey());
+  const int id = reduced.StateId(left->CanonicalKey());
+  SPIEL_CHECK_NE(id, -1);
+
+  std::vector<int8_t> values = StrongSolve(reduced);
+  SPIEL_CHECK_EQ(values.size(), reduced.NumStates());
+  SPIEL_CHECK_GE(values[id], kWDLLoss);
+  SPIEL_CHECK_LE(values[id], kWDLWin);
+}
+
+// Pentago's 8-fold symmetry collapses the opening moves.
+void PentagoSymmetryTest() {
+  std::unique_ptr<Game> game = LoadGame("pentago");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::set<std::string> plain_keys;
+  std::set<std::string> canonical_keys;
+  for (Action action : state->LegalActions()) {
+    std::unique_ptr<State> child = state->Child(action);
+    plain_keys.insert(child->ToString());
+    canonical_keys.insert(child->CanonicalKey());
+  }
+  SPIEL_CHECK_LT(canonical_keys.size(), plain_keys.size());
+
+  GameGraph plain = CompileGameGraph(*game, /*depth_limit=*/1);
+  GameGraph reduced =
+      CompileGameGraph(*game, /*depth_limit=*/1, CanonicalKeyFunction());
+  SPIEL_CHECK_LT(reduced.NumStates(), plain.NumStates());
+}
+
+// A solved table survives the round trip through a packed WDL file.
+void WDLFileRoundTripTest() {
+  const std::string filename = "/tmp/open_spiel_strong_solver_test.wdl";
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  GameGraph graph = CompileGameGraph(*game);
+  std::vector<int8_t> values = StrongSolve(graph);
+  SaveWDLFile(values, filename);
+
+  WDLFile wdl(filename);
+  SPIEL_CHECK_EQ(wdl.num_states(), values.size());
+  for (std::size_t id = 0; id < values.size(); ++id) {
+    SPIEL_CHECK_EQ(wdl.Get(id), values[id]);
+  }
+  std::remove(filename.c_str());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::TicTacToeSolveTest();
+  open_spiel::algorithms::ConnectFourMirrorTest();
+  open_spiel::algorithms::PentagoSymmetryTest();
+  open_spiel::algorithms::WDLFileRoundTripTest();
+}
@@ -14,12 +14,17 @@
 
 #include "open_spiel/algorithms/tabular_exploitability.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <deque>
 #include <limits>
+#include <thread>
 #include <unordered_set>
 
 #include "open_spiel/algorithms/expected_returns.h"
 #include "open_spiel/algorithms/history_tree.h"
+#include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -28,55 +33,125 @@ namespace algorithms {
 
 TabularBestResponse::TabularBestResponse(const Game& game,
                                          int best_responder_id,
-                                         const Policy* policy)
+                                         const Policy* policy, int num_threads)
     : best_responder_id_(best_responder_id),
       tabular_policy_container_(),
       policy_(policy),
       tree_(HistoryTree(game.NewInitialState(), best_responder_id_)),
       num_players_(game.NumPlayers()),
-      infosets_(GetAllInfoSets(game.NewInitialState(), best_responder_id,
-                               policy, &tree_)),
-      root_(game.NewInitialState()) {
+      infosets_(
+          GetAllInfoSetsFromTree(&tree_, best_responder_id, policy,
+                                 num_threads)),
+      root_(game.NewInitialState()),
+      num_threads_(num_threads),
+      cache_mutex_(new std::mutex) {
   if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
+  ReserveCaches(game);
+  ResolvePolicyBatch();
 }
 
 TabularBestResponse::TabularBestResponse(
     const Game& game, int best_responder_id,
-    const std::unordered_map<std::string, ActionsAndProbs>& policy_table)
+    const std::unordered_map<std::string, ActionsAndProbs>& policy_table,
+    int num_threads)
     : best_responder_id_(best_responder_id),
       tabular_policy_container_(policy_table),
       policy_(&tabular_policy_container_),
       tree_(HistoryTree(game.NewInitialState(), best_responder_id_)),
       num_players_(game.NumPlayers()),
-      infosets_(GetAllInfoSets(game.NewInitialState(), best_responder_id,
-                               policy_, &tree_)),
-      root_(game.NewInitialState()) {
+      infosets_(
+          GetAllInfoSetsFromTree(&tree_, best_responder_id, policy_,
+                                 num_threads)),
+      root_(game.NewInitialState()),
+      num_threads_(num_threads),
+      cache_mutex_(new std::mutex) {
   if (game.GetType().dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
+  ReserveCaches(game);
+  ResolvePolicyBatch();
+}
+
+void TabularBestResponse::ReserveCaches(const Game& game) {
+  // Sizing the caches from the game's declared counts avoids rehashing them
+  // while the best-response pass fills them. The buckets survive the clear()
+  // in SetPolicy, so repeated evaluations keep the benefit.
+  if (game.ExpectedNumHistories() > 0) {
+    value_cache_.reserve(game.ExpectedNumHistories());
+  }
+  if (game.ExpectedNumInfoStates() > 0) {
+    best_response_actions_.reserve(game.ExpectedNumInfoStates());
+  }
 }
 
 double TabularBestResponse::HandleTerminalCase(const HistoryNode& node) const {
   return node.GetValue();
 }
 
+void TabularBestResponse::ResolvePolicyBatch() {
+  resolved_policy_keys_.clear();
+  resolved_policies_.clear();
+  resolved_policy_keys_.reserve(infosets_.size());
+  for (const auto& infoset : infosets_) {
+    // All histories in an infoset share a type and acting player, so the
+    // first node speaks for the group.
+    HistoryNode* node = infoset.second[0].first;
+    if (node->GetType() != StateType::kDecision) continue;
+    if (node->GetState()->CurrentPlayer() == best_responder_id_) continue;
+    resolved_policy_keys_.push_back(&infoset.first);
+  }
+  std::sort(resolved_policy_keys_.begin(), resolved_policy_keys_.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+  // Querying in sorted key order turns the probes into a sequential merge
+  // when the policy itself is sorted (e.g. FrozenTabularPolicy).
+  resolved_policies_.resize(resolved_policy_keys_.size());
+  for (std::size_t i = 0; i < resolved_policy_keys_.size(); ++i) {
+    policy_->GetStatePolicy(*resolved_policy_keys_[i], &resolved_policies_[i]);
+  }
+}
+
+const SmallActionsAndProbs* TabularBestResponse::FindResolvedPolicy(
+    const std::string& infostate) const {
+  auto iter = std::lower_bound(
+      resolved_policy_keys_.begin(), resolved_policy_keys_.end(), infostate,
+      [](const std::string* key, const std::string& value) {
+        return *key < value;
+      });
+  if (iter == resolved_policy_keys_.end() || **iter != infostate) {
+    return nullptr;
+  }
+  return &resolved_policies_[iter - resolved_policy_keys_.begin()];
+}
+
 double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
   if (node == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
   if (node->GetState()->CurrentPlayer() == best_responder_id_) {
     // If we're playing as the best responder, we look at every child node,
     // and pick the one with the highest expected utility to play.
     Action action = BestResponseAction(node->GetInfoState());
-    HistoryNode* child = node->GetChild(action).second;
-    if (child == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
-    return Value(child->GetHistory());
+    HistoryNode* child = tree_.GetNode(node->GetChild(action).second);
+    return ValueInternal(child->GetHistory());
   }
   // If the other player is playing, then we can recursively compute the
   // expected utility of that node by looking at their policy.
   // We take child probabilities from the policy as that is what we are
   // calculating a best response to.
-  ActionsAndProbs state_policy = policy_->GetStatePolicy(node->GetInfoState());
+  // This is the highest-frequency policy lookup in the best-response pass;
+  // the entry was resolved in the sorted batch phase (ResolvePolicyBatch),
+  // so histories sharing the infoset share one resolution and this lookup
+  // is a binary search rather than a hash probe.
+  SmallActionsAndProbs fallback;
+  const SmallActionsAndProbs* resolved =
+      FindResolvedPolicy(node->GetInfoState());
+  if (resolved == nullptr) {
+    // Should not happen (the batch covers every opponent infoset in the
+    // tree), but a direct probe keeps the behavior identical if it does.
+    policy_->GetStatePolicy(node->GetInfoState(), &fallback);
+    resolved = &fallback;
+  }
+  const SmallActionsAndProbs& state_policy = *resolved;
   if (state_policy.empty())
     SpielFatalError(absl::StrCat("InfoState ", node->GetInfoState(),
                                  " not found in policy."));
@@ -110,14 +185,12 @@ double TabularBestResponse::HandleDecisionCase(HistoryNode* node) {
   for (const auto& action : node->GetState()->LegalActions()) {
     // We discard the probability here that's returned by GetChild as we
     // immediately load the probability for the given child from the policy.
-    HistoryNode* child = node->GetChild(action).second;
-
-    if (child == nullptr) SpielFatalError("HandleDecisionCase: node is null.");
+    HistoryNode* child = tree_.GetNode(node->GetChild(action).second);
 
     // Finally, we update value by the policy weighted value of the child.
     const double prob = GetProb(state_policy, action);
-    SPIEL_CHECK_GE(prob, 0);
-    value += prob * Value(child->GetHistory());
+    SPIEL_DCHECK_GE(prob, 0);
+    value += prob * ValueInternal(child->GetHistory());
   }
   return value;
 }
@@ -126,16 +199,15 @@ double TabularBestResponse::HandleChanceCase(HistoryNode* node) {
   double value = 0;
   double prob_sum = 0;
   for (const auto& action : node->GetChildActions()) {
-    std::pair<double, HistoryNode*> prob_and_child = node->GetChild(action);
+    std::pair<double, int> prob_and_child = node->GetChild(action);
     double prob = prob_and_child.first;
     prob_sum += prob;
-    HistoryNode* child = prob_and_child.second;
-    if (child == nullptr) SpielFatalError("Child is null.");
+    HistoryNode* child = tree_.GetNode(prob_and_child.second);
 
     // Verify that the probability is valid. This should always be true.
-    SPIEL_CHECK_GE(prob, 0.);
-    SPIEL_CHECK_LE(prob, 1.);
-    value += prob * Value(child->GetHistory());
+    SPIEL_DCHECK_GE(prob, 0.);
+    SPIEL_DCHECK_LE(prob, 1.);
+    value += prob * ValueInternal(child->GetHistory());
   }
 
   // Verify that the sum of the probabilities is 1, within tolerance.
@@ -144,8 +216,16 @@ double TabularBestResponse::HandleChanceCase(HistoryNode* node) {
 }
 
 double TabularBestResponse::Value(const std::string& history) {
-  auto it = value_cache_.find(history);
-  if (it != value_cache_.end()) return it->second;
+  if (num_threads_ > 1 && value_cache_.empty()) ParallelPrecompute();
+  return ValueInternal(history);
+}
+
+double TabularBestResponse::ValueInternal(const std::string& history) {
+  {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    auto it = value_cache_.find(history);
+    if (it != value_cache_.end()) return it->second;
+  }
   HistoryNode* node = tree_.GetByHistory(history);
   if (node == nullptr) SpielFatalError("node returned is null.");
   double cache_value = 0;
@@ -163,14 +243,62 @@ double TabularBestResponse::Value(const std::string& history) {
       break;
     }
   }
+  std::lock_guard<std::mutex> lock(*cache_mutex_);
   value_cache_[history] = cache_value;
-  return value_cache_[history];
+  return cache_value;
+}
+
+void TabularBestResponse::ParallelPrecompute() {
+  // Expand breadth-first from the root until there are enough independent
+  // subtrees to keep the workers busy. Splitting is safe anywhere in the
+  // tree: values and best-response actions are deterministic functions of
+  // the (fixed) tree and policy, so overlapping work stores equal results.
+  std::deque<HistoryNode*> queue;
+  std::vector<HistoryNode*> subtrees;
+  queue.push_back(tree_.Root());
+  while (!queue.empty() && queue.size() + subtrees.size() <
+                               static_cast<std::size_t>(4 * num_threads_)) {
+    HistoryNode* node = queue.front();
+    queue.pop_front();
+    if (node->GetType() == StateType::kTerminal) {
+      subtrees.push_back(node);
+      continue;
+    }
+    for (Action action : node->GetChildActions()) {
+      queue.push_back(tree_.GetNode(node->GetChild(action).second));
+    }
+  }
+  subtrees.insert(subtrees.end(), queue.begin(), queue.end());
+
+  // Workers claim subtrees through a shared counter.
+  std::atomic<std::size_t> next_subtree(0);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads_);
+  for (int t = 0; t < num_threads_; ++t) {
+    workers.emplace_back([this, &next_subtree, &subtrees]() {
+      while (true) {
+        std::size_t index = next_subtree++;
+        if (index >= subtrees.size()) return;
+        ValueInternal(subtrees[index]->GetHistory());
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
 }
 
 Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
-  auto it = best_response_actions_.find(infostate);
-  if (it != best_response_actions_.end()) return it->second;
-  std::vector<std::pair<HistoryNode*, double>> infoset = infosets_[infostate];
+  {
+    std::lock_guard<std::mutex> lock(*cache_mutex_);
+    auto it = best_response_actions_.find(infostate);
+    if (it != best_response_actions_.end()) return it->second;
+  }
+  auto infoset_it = infosets_.find(infostate);
+  if (infoset_it == infosets_.end()) {
+    SpielFatalError(
+        absl::StrCat("InfoState ", infostate, " not found in infosets."));
+  }
+  const std::vector<std::pair<HistoryNode*, double>>& infoset =
+      infoset_it->second;
 
   Action best_action = -1;
   double best_value = std::numeric_limits<double>::lowest();
@@ -181,9 +309,9 @@ Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
     // Prob here is the counterfactual reach-weighted probability.
     for (const auto& state_and_prob : infoset) {
       HistoryNode* state_node = state_and_prob.first;
-      HistoryNode* child_node = state_node->GetChild(action).second;
-      SPIEL_CHECK_TRUE(child_node != nullptr);
-      value += state_and_prob.second * Value(child_node->GetHistory());
+      HistoryNode* child_node =
+          tree_.GetNode(state_node->GetChild(action).second);
+      value += state_and_prob.second * ValueInternal(child_node->GetHistory());
     }
     if (value > best_value) {
       best_value = value;
@@ -191,12 +319,53 @@ Action TabularBestResponse::BestResponseAction(const std::string& infostate) {
     }
   }
   if (best_action == -1) SpielFatalError("No action was chosen.");
+  std::lock_guard<std::mutex> lock(*cache_mutex_);
   best_response_actions_[infostate] = best_action;
   return best_action;
 }
 
-double Exploitability(const Game& game, const Policy& policy) {
+namespace {
+
+// Computes each player's best-response value against the policy, one player
+// per thread when num_threads > 1, splitting any remaining threads among the
+// responders for their subtree evaluation.
+std::vector<double> BestResponseValues(const Game& game, const Policy& policy,
+                                       int num_threads) {
+  const int num_players = game.NumPlayers();
+  std::string root_string = game.NewInitialState()->ToString();
+  std::vector<double> values(num_players, 0);
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_players; ++i) {
+      TabularBestResponse best_response(game, i, &policy);
+      values[i] = best_response.Value(root_string);
+    }
+    return values;
+  }
+  int threads_per_responder = std::max(1, num_threads / num_players);
+  std::vector<std::thread> workers;
+  workers.reserve(num_players);
+  for (int i = 0; i < num_players; ++i) {
+    workers.emplace_back(
+        [&game, &policy, &root_string, &values, i, threads_per_responder]() {
+          TabularBestResponse best_response(game, i, &policy,
+                                            threads_per_responder);
+          values[i] = best_response.Value(root_string);
+        });
+  }
+  for (auto& worker : workers) worker.join();
+  return values;
+}
+
+}  // namespace
+
+double Exploitability(const Game& game, const Policy& policy,
+                      int num_threads) {
   GameType game_type = game.GetType();
+  if (game_type.dynamics == GameType::Dynamics::kSimultaneous) {
+    // Evaluate through the turn-based equivalent; see the header comment for
+    // the information-state keys the policy must use.
+    return Exploitability(*ConvertToTurnBased(game), policy, num_threads);
+  }
   if (game_type.dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
@@ -205,12 +374,9 @@ double Exploitability(const Game& game, const Policy& policy) {
     SpielFatalError("The game must have zero- or constant-sum utility.");
   }
 
-  std::unique_ptr<State> root = game.NewInitialState();
+  std::vector<double> values = BestResponseValues(game, policy, num_threads);
   double nash_conv = 0;
-  for (int i = 0; i < game.NumPlayers(); ++i) {
-    TabularBestResponse best_response(game, i, &policy);
-    nash_conv += best_response.Value(root->ToString());
-  }
+  for (double value : values) nash_conv += value;
   return (nash_conv - game.UtilitySum()) / game.NumPlayers();
 }
 
@@ -221,18 +387,18 @@ double Exploitability(
   return Exploitability(game, tabular_policy);
 }
 
-double NashConv(const Game& game, const Policy& policy) {
+double NashConv(const Game& game, const Policy& policy, int num_threads) {
   GameType game_type = game.GetType();
+  if (game_type.dynamics == GameType::Dynamics::kSimultaneous) {
+    return NashConv(*ConvertToTurnBased(game), policy, num_threads);
+  }
   if (game_type.dynamics != GameType::Dynamics::kSequential) {
     SpielFatalError("The game must be turn-based.");
   }
 
   std::unique_ptr<State> root = game.NewInitialState();
-  std::vector<double> best_response_values(game.NumPlayers());
-  for (int i = 0; i < game.NumPlayers(); ++i) {
-    TabularBestResponse best_response(game, i, &policy);
-    best_response_values[i] = best_response.Value(root->ToString());
-  }
+  std::vector<double> best_response_values =
+      BestResponseValues(game, policy, num_threads);
   std::vector<double> on_policy_values = ExpectedReturns(*root, policy, -1);
   SPIEL_CHECK_EQ(best_response_values.size(), on_policy_values.size());
   double nash_conv = 0;
@@ -249,5 +415,77 @@ double NashConv(
   return NashConv(game, tabular_policy);
 }
 
+ExploitabilityEvaluator::ExploitabilityEvaluator(const Game& game,
+                                                 int num_threads)
+    : num_threads_(num_threads) {
+  // Simultaneous-move games are evaluated through their turn-based
+  // equivalent, which the evaluator keeps alive since the responders' trees
+  // hold states created from it.
+  const Game* eval_game = &game;
+  if (game.GetType().dynamics == GameType::Dynamics::kSimultaneous) {
+    owned_game_ = ConvertToTurnBased(game);
+    eval_game = owned_game_.get();
+  }
+  game_type_ = eval_game->GetType();
+  if (game_type_.dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("The game must be turn-based.");
+  }
+  num_players_ = eval_game->NumPlayers();
+  utility_sum_ = eval_game->UtilitySum();
+  root_ = eval_game->NewInitialState();
+  root_string_ = root_->ToString();
+  uniform_policy_ = GetUniformPolicy(*eval_game);
+  int threads_per_responder = std::max(1, num_threads_ / num_players_);
+  responders_.reserve(num_players_);
+  for (int i = 0; i < num_players_; ++i) {
+    responders_.emplace_back(new TabularBestResponse(
+        *eval_game, i, &uniform_policy_, threads_per_responder));
+  }
+}
+
+std::vector<double> ExploitabilityEvaluator::BestResponseValues(
+    const Policy& policy) {
+  std::vector<double> values(num_players_, 0);
+  if (num_threads_ <= 1) {
+    for (int i = 0; i < num_players_; ++i) {
+      responders_[i]->SetPolicy(&policy);
+      values[i] = responders_[i]->Value(root_string_);
+    }
+    return values;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(num_players_);
+  for (int i = 0; i < num_players_; ++i) {
+    workers.emplace_back([this, &policy, &values, i]() {
+      responders_[i]->SetPolicy(&policy);
+      values[i] = responders_[i]->Value(root_string_);
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  return values;
+}
+
+double ExploitabilityEvaluator::Exploitability(const Policy& policy) {
+  if (game_type_.utility != GameType::Utility::kZeroSum &&
+      game_type_.utility != GameType::Utility::kConstantSum) {
+    SpielFatalError("The game must have zero- or constant-sum utility.");
+  }
+  std::vector<double> values = BestResponseValues(policy);
+  double nash_conv = 0;
+  for (double value : values) nash_conv += value;
+  return (nash_conv - utility_sum_) / num_players_;
+}
+
+double ExploitabilityEvaluator::NashConv(const Policy& policy) {
+  std::vector<double> best_response_values = BestResponseValues(policy);
+  std::vector<double> on_policy_values = ExpectedReturns(*root_, policy, -1);
+  SPIEL_CHECK_EQ(best_response_values.size(), on_policy_values.size());
+  double nash_conv = 0;
+  for (int i = 0; i < num_players_; ++i) {
+    nash_conv += best_response_values[i] - on_policy_values[i];
+  }
+  return nash_conv;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
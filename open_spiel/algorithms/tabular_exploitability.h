@@ -17,8 +17,12 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "open_spiel/algorithms/history_tree.h"
 #include "open_spiel/policy.h"
@@ -31,9 +35,16 @@ namespace algorithms {
 // Returns the average utility that a best responder wins when when playing
 // against the opponents' policies, each of which are assumed to be contained
 // within the specified (joint) policy.
-// This only works for zero- or constant-sum sequential games, otherwise raises
-// an error.
-double Exploitability(const Game& game, const Policy& policy);
+// This only works for zero- or constant-sum games, otherwise raises an error.
+// Simultaneous-move games are evaluated through their turn-based equivalent
+// (ConvertToTurnBased); the policy must then be defined over the information
+// states of the converted game, which is what a tabular solver run on the
+// converted game produces.
+// With num_threads > 1, the per-player best responses are computed on
+// separate threads, and the remaining threads are split among them for the
+// subtree evaluation inside each best response.
+double Exploitability(const Game& game, const Policy& policy,
+                      int num_threads = 1);
 
 // Same function provided for easy Python compatibility.
 double Exploitability(
@@ -44,9 +55,13 @@ double Exploitability(
 // by returning the sum of the improvements in the value that each player could
 // obtain by unilaterally changing their strategy while the opposing player
 // maintains their current strategy (which for a Nash equilibrium, this value
-// is 0). This function only works for sequential games. Note: in zero-sum and
-// constant-sum games, exploitability is equal to NashConv / (num. of players).
-double NashConv(const Game& game, const Policy& policy);
+// is 0). This works for any number of players; general-sum games are fine
+// since no utility-sum assumption is needed. Simultaneous-move games are
+// evaluated through their turn-based equivalent, with the same policy-key
+// caveat as Exploitability above. Note: in zero-sum and constant-sum games,
+// exploitability is equal to NashConv / (num. of players).
+// num_threads is split among the players as in Exploitability above.
+double NashConv(const Game& game, const Policy& policy, int num_threads = 1);
 
 // Same function provided for easy Python compatibility.
 double NashConv(const Game& game,
@@ -58,11 +73,16 @@ double NashConv(const Game& game,
 // raises a SpielFatalError if an incompatible game is passed to it.
 class TabularBestResponse {
  public:
+  // With num_threads > 1, the first call to Value seeds the value cache by
+  // evaluating a frontier of subtrees near the root on worker threads; the
+  // policy passed in must then be safe for concurrent GetStatePolicy calls
+  // (true of TabularPolicy and the other policies in policy.h).
   TabularBestResponse(const Game& game, int best_responder_id,
-                      const Policy* policy);
+                      const Policy* policy, int num_threads = 1);
   TabularBestResponse(
       const Game& game, int best_responder_id,
-      const std::unordered_map<std::string, ActionsAndProbs>& policy_table);
+      const std::unordered_map<std::string, ActionsAndProbs>& policy_table,
+      int num_threads = 1);
 
   TabularBestResponse(TabularBestResponse&&) = default;
   TabularBestResponse(const TabularBestResponse&) = default;
@@ -96,10 +116,13 @@ class TabularBestResponse {
     policy_ = policy;
     value_cache_.clear();
     best_response_actions_.clear();
-    // TODO(author1): Replace this with something that traverses the tree
-    // and rebuilds the probabilities.
+    // Only the counter-factual probabilities depend on the policy, so we
+    // rebuild them with a single pass over the existing tree rather than
+    // re-walking the game.
     infosets_ =
-        GetAllInfoSets(root_->Clone(), best_responder_id_, policy_, &tree_);
+        GetAllInfoSetsFromTree(&tree_, best_responder_id_, policy_,
+                               num_threads_);
+    ResolvePolicyBatch();
   }
 
   // Set the policy given a policy table. This stores the table internally.
@@ -110,6 +133,33 @@ class TabularBestResponse {
   }
 
  private:
+  // Reserves the value and best-response caches from the game's declared
+  // table-size hints (Game::ExpectedNumHistories / ExpectedNumInfoStates).
+  void ReserveCaches(const Game& game);
+
+  // Batch policy resolution. The tree walk used to probe the policy once per
+  // history node; instead, the constructors and SetPolicy resolve the policy
+  // once per opponent infoset up front, querying the keys in sorted order so
+  // that a sorted-table policy (e.g. FrozenTabularPolicy) is read as a
+  // sequential merge rather than random probes, and histories sharing an
+  // infoset share the resolved entry.
+  void ResolvePolicyBatch();
+
+  // Binary search over the sorted resolved keys; returns null if the infoset
+  // was not seen by ResolvePolicyBatch.
+  const SmallActionsAndProbs* FindResolvedPolicy(
+      const std::string& infostate) const;
+
+  // The recursive implementation behind Value; shared by the worker threads,
+  // so all cache access inside it goes through cache_mutex_.
+  double ValueInternal(const std::string& history);
+
+  // Seeds the value cache by evaluating a frontier of subtrees near the root
+  // on num_threads_ worker threads. The workers share the caches; two workers
+  // may transiently recompute the same history, in which case they store
+  // identical values.
+  void ParallelPrecompute();
+
   // For chance nodes, we recursively calculate the value of each child node,
   // and weight them by the probability of reaching each child.
   double HandleChanceCase(HistoryNode* node);
@@ -148,12 +198,67 @@ class TabularBestResponse {
   std::unordered_map<std::string, std::vector<std::pair<HistoryNode*, double>>>
       infosets_;
 
+  // The opponent infoset keys (pointing into infosets_, which outlives them)
+  // sorted lexicographically, and the policy entries resolved for them,
+  // aligned by index. Rebuilt by ResolvePolicyBatch.
+  std::vector<const std::string*> resolved_policy_keys_;
+  std::vector<SmallActionsAndProbs> resolved_policies_;
+
   // Caches all best responses calculated so far (for each infostate).
   std::unordered_map<std::string, Action> best_response_actions_;
 
   // Caches all values calculated so far (for each history).
   std::unordered_map<std::string, double> value_cache_;
   std::unique_ptr<State> root_;
+
+  // Number of worker threads used by ParallelPrecompute.
+  int num_threads_;
+
+  // Guards value_cache_ and best_response_actions_ while the workers run.
+  // Held behind a unique_ptr to keep the class movable.
+  std::unique_ptr<std::mutex> cache_mutex_;
+};
+
+// Stateful evaluator for callers that compute exploitability repeatedly as a
+// policy improves, e.g. every N CFR iterations. The per-player history trees
+// are built once, at construction; each evaluation then only re-derives the
+// counter-factual probabilities and values from the new policy in a single
+// pass over the existing trees. This avoids the tree-construction cost, which
+// dominates the one-shot functions above.
+class ExploitabilityEvaluator {
+ public:
+  // Simultaneous-move games are converted with ConvertToTurnBased and the
+  // converted game is kept alive by the evaluator; the policies passed to the
+  // methods below must then use the converted game's information states.
+  // Exploitability() additionally requires zero- or constant-sum utility.
+  // num_threads is split among the players as in the Exploitability function
+  // above.
+  explicit ExploitabilityEvaluator(const Game& game, int num_threads = 1);
+
+  // These match the one-shot functions of the same names. The policy only
+  // needs to remain valid for the duration of the call.
+  double Exploitability(const Policy& policy);
+  double NashConv(const Policy& policy);
+
+ private:
+  // Computes each player's best-response value against the policy.
+  std::vector<double> BestResponseValues(const Policy& policy);
+
+  // Owns the turn-based equivalent when the evaluator was built from a
+  // simultaneous-move game; null otherwise.
+  std::unique_ptr<Game> owned_game_;
+
+  GameType game_type_;
+  int num_players_;
+  double utility_sum_;
+  int num_threads_;
+  std::unique_ptr<State> root_;
+  std::string root_string_;
+
+  // Seeds the responders at construction; replaced by SetPolicy on the first
+  // evaluation.
+  TabularPolicy uniform_policy_;
+  std::vector<std::unique_ptr<TabularBestResponse>> responders_;
 };
 
 }  // namespace algorithms
@@ -22,6 +22,7 @@
 
 #include "open_spiel/algorithms/minimax.h"
 #include "open_spiel/game_parameters.h"
+#include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/games/goofspiel.h"
 #include "open_spiel/games/kuhn_poker.h"
 #include "open_spiel/games/leduc_poker.h"
@@ -514,6 +515,67 @@ void TestNashConv(const std::string& game_name,
   }
 }
 
+// Evaluating successive policies through a single ExploitabilityEvaluator
+// must match the one-shot functions for each policy.
+void TestExploitabilityEvaluatorMatchesOneShot() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  ExploitabilityEvaluator evaluator(*game);
+  TabularPolicy uniform = GetUniformPolicy(*game);
+  TabularPolicy first_action = GetFirstActionPolicy(*game);
+  SPIEL_CHECK_FLOAT_EQ(evaluator.Exploitability(uniform),
+                       Exploitability(*game, uniform));
+  SPIEL_CHECK_FLOAT_EQ(evaluator.Exploitability(first_action),
+                       Exploitability(*game, first_action));
+  SPIEL_CHECK_FLOAT_EQ(evaluator.NashConv(uniform), NashConv(*game, uniform));
+  SPIEL_CHECK_FLOAT_EQ(evaluator.NashConv(first_action),
+                       NashConv(*game, first_action));
+}
+
+// NashConv on a three-player game: uniform play in 3-player Kuhn is not an
+// equilibrium, so the value is strictly positive, and the parallel evaluation
+// matches the serial one.
+void TestThreePlayerNashConv() {
+  std::unique_ptr<Game> game =
+      LoadGame("kuhn_poker", {{"players", GameParameter(3)}});
+  TabularPolicy policy = GetUniformPolicy(*game);
+  double nash_conv = NashConv(*game, policy);
+  SPIEL_CHECK_GT(nash_conv, 0);
+  SPIEL_CHECK_FLOAT_EQ(nash_conv, NashConv(*game, policy, /*num_threads=*/3));
+}
+
+// Simultaneous-move games are evaluated through their turn-based equivalent.
+// Uniform play is the equilibrium of matching pennies, so both metrics are 0;
+// the policy is built from the converted game, whose information states the
+// evaluation uses.
+void TestSimultaneousGameNashConv() {
+  std::unique_ptr<Game> game = LoadGame("matrix_mp");
+  std::unique_ptr<Game> turn_based = ConvertToTurnBased(*game);
+  TabularPolicy policy = GetUniformPolicy(*turn_based);
+  SPIEL_CHECK_TRUE(Near(NashConv(*game, policy), 0.));
+  SPIEL_CHECK_TRUE(Near(Exploitability(*game, policy), 0.));
+
+  // The stateful evaluator converts internally and must agree.
+  ExploitabilityEvaluator evaluator(*game);
+  SPIEL_CHECK_TRUE(Near(evaluator.NashConv(policy), 0.));
+
+  // A non-equilibrium policy is exploitable.
+  TabularPolicy first_action = GetFirstActionPolicy(*turn_based);
+  SPIEL_CHECK_GT(NashConv(*game, first_action), 0);
+}
+
+// The parallel evaluation must produce exactly the same values as the serial
+// one.
+void TestParallelExploitabilityMatchesSerial() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  TabularPolicy policy = GetUniformPolicy(*game);
+  double serial = Exploitability(*game, policy);
+  double parallel = Exploitability(*game, policy, /*num_threads=*/4);
+  SPIEL_CHECK_FLOAT_EQ(serial, parallel);
+  double serial_nash_conv = NashConv(*game, policy);
+  double parallel_nash_conv = NashConv(*game, policy, /*num_threads=*/4);
+  SPIEL_CHECK_FLOAT_EQ(serial_nash_conv, parallel_nash_conv);
+}
+
 }  // namespace
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -570,4 +632,9 @@ int main(int argc, char** argv) {
                                        open_spiel::GetFirstActionPolicy, 2.);
   open_spiel::algorithms::TestNashConv("leduc_poker",
                                        open_spiel::GetFirstActionPolicy, 2.);
+
+  open_spiel::algorithms::TestParallelExploitabilityMatchesSerial();
+  open_spiel::algorithms::TestExploitabilityEvaluatorMatchesOneShot();
+  open_spiel::algorithms::TestThreePlayerNashConv();
+  open_spiel::algorithms::TestSimultaneousGameNashConv();
 }
@@ -14,10 +14,16 @@
 
 #include "open_spiel/algorithms/trajectories.h"
 
+#include "open_spiel/algorithms/trajectory_file.h"
+
 #include <algorithm>
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <cstdint>
+#include <functional>
+#include <mutex>
 #include <random>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -30,8 +36,8 @@ namespace {
 std::string StateKey(const Game& game, const State& state,
                      int player = kInvalidPlayer) {
   if (game.GetType().provides_information_state) {
-    if (player == kInvalidPlayer) return state.InformationState();
-    return state.InformationState(player);
+    if (player == kInvalidPlayer) return state.InformationStateKey();
+    return state.InformationStateKey(player);
   } else if (game.GetType().provides_observation) {
     if (player == kInvalidPlayer) return state.Observation();
     return state.Observation(player);
@@ -43,6 +49,8 @@ std::string StateKey(const Game& game, const State& state,
 // Initializes a BatchedTrajectory of size [batch_size, T].
 BatchedTrajectory::BatchedTrajectory(int batch_size) : batch_size(batch_size) {
   observations.resize(batch_size);
+  observation_indices.resize(batch_size);
+  observation_values.resize(batch_size);
   state_indices.resize(batch_size);
   legal_actions.resize(batch_size);
   actions.resize(batch_size);
@@ -56,24 +64,31 @@ BatchedTrajectory::BatchedTrajectory(int batch_size) : batch_size(batch_size) {
 // Moves a trajectory of size [1, T] into the current trajectory at index.
 void BatchedTrajectory::MoveTrajectory(int index,
                                        BatchedTrajectory* trajectory) {
-  // The passed trajectory must have a batch size of 1.
-  SPIEL_CHECK_EQ(trajectory->batch_size, 1);
   max_trajectory_length =
       std::max(max_trajectory_length, trajectory->max_trajectory_length);
+  MoveTrajectoryFields(index, trajectory);
+}
+
+void BatchedTrajectory::MoveTrajectoryFields(int index,
+                                             BatchedTrajectory* trajectory) {
+  // The passed trajectory must have a batch size of 1.
+  SPIEL_CHECK_EQ(trajectory->batch_size, 1);
   observations[index] = std::move(trajectory->observations[0]);
+  observation_indices[index] = std::move(trajectory->observation_indices[0]);
+  observation_values[index] = std::move(trajectory->observation_values[0]);
   state_indices[index] = std::move(trajectory->state_indices[0]);
   legal_actions[index] = std::move(trajectory->legal_actions[0]);
   actions[index] = std::move(trajectory->actions[0]);
   player_policies[index] = std::move(trajectory->player_policies[0]);
   player_ids[index] = std::move(trajectory->player_ids[0]);
-  rewards[index] = trajectory->rewards[0];
+  rewards[index] = std::move(trajectory->rewards[0]);
   next_is_terminal[index] = std::move(trajectory->next_is_terminal[0]);
   valid[index] = std::move(trajectory->valid[0]);
 }
 
 // Pads fields to make sure that they're all the same shape, i.e. [B, T, N],
 // where N = the size of each field.
-void BatchedTrajectory::ResizeFields(int length) {
+void BatchedTrajectory::ResizeFields(int length, int num_threads) {
   if (length > 0) {
     SPIEL_CHECK_GE(length, max_trajectory_length);
     // We adjust max_trajectory_length as it's no longer correct.
@@ -82,69 +97,214 @@ void BatchedTrajectory::ResizeFields(int length) {
   // Only works for batches with at least one trajectory as otherwise we can't
   // infer the field size.
   SPIEL_CHECK_GT(batch_size, 0);
-  // TODO(author1): Replace this with a multi-threaded version.
-  for (int i = 0; i < batch_size; ++i) {
-    // Each field has shape [B, T, field_size], where N is a parameter that is
-    // fixed for each (game, field) pair. We thus have to get the size of N from
-    // the existing vectors.
-    if (!observations[0].empty()) {
-      observations[i].resize(max_trajectory_length,
-                             std::vector<double>(observations[0][0].size(), 0));
+
+  // Each field has shape [B, T, field_size], where field_size is fixed for
+  // each (game, field) pair. We read the field sizes from the first batch
+  // entry up front, so the workers below never touch entries they don't own.
+  const bool has_observations = !observations[0].empty();
+  const bool has_sparse_observations = !observation_indices[0].empty();
+  const std::size_t observation_size =
+      has_observations ? observations[0][0].size() : 0;
+  const std::size_t num_distinct_actions = legal_actions[0][0].size();
+
+  // Padding prototypes, built once per call instead of once per batch entry;
+  // the workers below only read them.
+  const std::vector<float> observation_padding(observation_size, 0);
+  const std::vector<int> legal_actions_padding(num_distinct_actions, 1);
+  const std::vector<double> policy_padding(num_distinct_actions, 1);
+
+  auto resize_entry = [&](int i) {
+    if (has_observations) {
+      observations[i].resize(max_trajectory_length, observation_padding);
+    }
+    if (has_sparse_observations) {
+      // A padded step is an all-zero observation, i.e. empty sparse rows.
+      observation_indices[i].resize(max_trajectory_length);
+      observation_values[i].resize(max_trajectory_length);
     }
     state_indices[i].resize(max_trajectory_length, 0);
-    legal_actions[i].resize(max_trajectory_length,
-                            std::vector<int>(legal_actions[0][0].size(), 1));
+    legal_actions[i].resize(max_trajectory_length, legal_actions_padding);
 
     // Actions has shape [B, T, 1]
     actions[i].resize(max_trajectory_length, 0);
 
     // legal_actions has shape [B, T, num_distinct_actions], while
     // player_policies[0][0].size() <= num_distinct_actions.
-    player_policies[i].resize(
-        max_trajectory_length,
-        std::vector<double>(legal_actions[0][0].size(), 1));
+    player_policies[i].resize(max_trajectory_length, policy_padding);
     player_ids[i].resize(max_trajectory_length, 0);
     next_is_terminal[i].resize(max_trajectory_length, false);
     valid[i].resize(max_trajectory_length, false);
+  };
+
+  if (num_threads <= 1) {
+    for (int i = 0; i < batch_size; ++i) resize_entry(i);
+    return;
   }
+  std::atomic<int> next_entry(0);
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    workers.emplace_back([&]() {
+      while (true) {
+        int i = next_entry++;
+        if (i >= batch_size) return;
+        resize_entry(i);
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
 }
 
+void BatchedTrajectory::SparsifyObservations() {
+  for (int b = 0; b < batch_size; ++b) {
+    observation_indices[b].resize(observations[b].size());
+    observation_values[b].resize(observations[b].size());
+    for (std::size_t t = 0; t < observations[b].size(); ++t) {
+      const std::vector<float>& dense = observations[b][t];
+      for (std::size_t i = 0; i < dense.size(); ++i) {
+        if (dense[i] != 0) {
+          observation_indices[b][t].push_back(i);
+          observation_values[b][t].push_back(dense[i]);
+        }
+      }
+    }
+    observations[b].clear();
+  }
+}
+
+void BatchedTrajectory::DensifyObservations(int observation_size) {
+  for (int b = 0; b < batch_size; ++b) {
+    observations[b].resize(observation_indices[b].size());
+    for (std::size_t t = 0; t < observation_indices[b].size(); ++t) {
+      std::vector<float>& dense = observations[b][t];
+      dense.assign(observation_size, 0);
+      for (std::size_t i = 0; i < observation_indices[b][t].size(); ++i) {
+        dense[observation_indices[b][t][i]] = observation_values[b][t][i];
+      }
+    }
+    observation_indices[b].clear();
+    observation_values[b].clear();
+  }
+}
+
+namespace {
+
+// Core episode recorder behind the public RecordTrajectory entry points,
+// templated on the generator so the caller's std::mt19937 and the batched
+// recorder's FastRng actors share one implementation.
+template <typename Rng>
+BatchedTrajectory RecordTrajectoryImpl(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index,
+    bool include_full_observations, Rng* rng);
+
+}  // namespace
+
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length) {
+    int max_unroll_length, int num_threads, bool deterministic) {
   SPIEL_CHECK_GT(batch_size, 0);
   if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
   BatchedTrajectory batched_trajectory(batch_size);
-  // TODO(author1): Replace this with a multi-threaded version.
+
+  if (num_threads <= 1) {
+    for (int i = 0; i < batch_size; ++i) {
+      BatchedTrajectory trajectory =
+          RecordTrajectoryImpl(game, policies, initial_state, state_to_index,
+                               include_full_observations, rng_ptr);
+      SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+      batched_trajectory.MoveTrajectory(i, &trajectory);
+    }
+    batched_trajectory.ResizeFields(max_unroll_length);
+    return batched_trajectory;
+  }
+
+  // Actor threads claim episode slots through a shared counter and write
+  // finished trajectories straight into their slots of the preallocated
+  // batch, so the whole episode path is lock-free. Each actor gets its own
+  // generator, seeded from the caller's so that runs stay reproducible for a
+  // fixed seed and thread count. In deterministic mode the generators are
+  // instead seeded per slot, making slot contents a function of the slot
+  // index alone — reproducible for any thread count — at the cost of one
+  // generator construction per episode.
+  std::vector<std::uint32_t> seeds(deterministic ? batch_size : num_threads);
+  for (std::uint32_t& seed : seeds) seed = (*rng_ptr)();
+  std::atomic<int> next_episode(0);
+  std::vector<std::thread> actors;
+  actors.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    actors.emplace_back([&, t]() {
+      FastRng rng(seeds[t % seeds.size()]);
+      while (true) {
+        int i = next_episode++;
+        if (i >= batch_size) return;
+        if (deterministic) rng = FastRng(seeds[i]);
+        BatchedTrajectory trajectory =
+            RecordTrajectoryImpl(game, policies, initial_state, state_to_index,
+                                 include_full_observations, &rng);
+        SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+        batched_trajectory.MoveTrajectoryFields(i, &trajectory);
+      }
+    });
+  }
+  for (auto& actor : actors) actor.join();
+
+  // The per-slot moves skip the max-length bookkeeping, so derive it here.
   for (int i = 0; i < batch_size; ++i) {
-    BatchedTrajectory trajectory =
-        RecordTrajectory(game, policies, initial_state, state_to_index,
-                         include_full_observations, rng_ptr);
-    SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
-    batched_trajectory.MoveTrajectory(i, &trajectory);
+    batched_trajectory.max_trajectory_length =
+        std::max(batched_trajectory.max_trajectory_length,
+                 static_cast<uint64_t>(batched_trajectory.actions[i].size()));
   }
-  batched_trajectory.ResizeFields(max_unroll_length);
+  batched_trajectory.ResizeFields(max_unroll_length, num_threads);
   return batched_trajectory;
 }
 
-BatchedTrajectory RecordTrajectory(
+namespace {
+
+template <typename Rng>
+BatchedTrajectory RecordTrajectoryImpl(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
     const std::unordered_map<std::string, int>& state_to_index,
-    bool include_full_observations, std::mt19937* rng) {
+    bool include_full_observations, Rng* rng) {
+  SPIEL_STATS_INC("trajectories/episodes_recorded");
   if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
   BatchedTrajectory trajectory(/*batch_size=*/1);
-  std::unique_ptr<open_spiel::State> state = initial_state.Clone();
+  // Draw the episode state from the game's pool when the state type supports
+  // recycling, which avoids one heap allocation per episode.
+  std::unique_ptr<open_spiel::State> state;
+  if (initial_state.SupportsCloneInto()) {
+    state = game.NewStateFromPool();
+    initial_state.CloneInto(state.get());
+  } else {
+    state = initial_state.Clone();
+  }
   bool find_index = !state_to_index.empty();
+  const int info_state_vector_size =
+      find_index ? 0 : game.InformationStateNormalizedVectorSize();
+  // Reserve the per-step fields from the declared game length bound, so the
+  // loop below never reallocates mid-episode.
+  const int max_length = game.MaxGameLength();
+  if (find_index) {
+    trajectory.state_indices[0].reserve(max_length);
+  } else {
+    trajectory.observations[0].reserve(max_length);
+  }
+  trajectory.legal_actions[0].reserve(max_length);
+  trajectory.actions[0].reserve(max_length);
+  trajectory.player_policies[0].reserve(max_length);
+  trajectory.player_ids[0].reserve(max_length);
   while (!state->IsTerminal()) {
     Action action = kInvalidAction;
     if (state->IsChanceNode()) {
-      action = open_spiel::SampleChanceOutcome(
-          state->ChanceOutcomes(),
-          std::uniform_real_distribution<double>(0.0, 1.0)(*rng));
+      action = state
+                   ->SampleChanceOutcome(
+                       std::uniform_real_distribution<double>(0.0, 1.0)(*rng))
+                   .first;
     } else if (state->IsSimultaneousNode()) {
       open_spiel::SpielFatalError(
           "We do not support games with simultaneous actions.");
@@ -156,18 +316,23 @@ BatchedTrajectory RecordTrajectory(
         SPIEL_CHECK_TRUE(it != state_to_index.end());
         trajectory.state_indices[0].push_back(it->second);
       } else {
-        trajectory.observations[0].push_back(
-            state->InformationStateAsNormalizedVector());
+        // Write directly into the stored row rather than moving a temporary.
+        trajectory.observations[0].emplace_back(info_state_vector_size);
+        state->InformationStateAsNormalizedVector(
+            state->CurrentPlayer(), trajectory.observations[0].back().data());
       }
       ActionsAndProbs policy = policies.at(state->CurrentPlayer())
-                                   .GetStatePolicy(state->InformationState());
+                                   .GetStatePolicy(
+                                       state->InformationStateKey());
       SPIEL_CHECK_EQ(policy.size(), game.NumDistinctActions());
-      std::vector<double> probs;
+      // Write the probabilities into the stored row directly rather than
+      // building a temporary and copying it in.
+      trajectory.player_policies[0].emplace_back();
+      std::vector<double>& probs = trajectory.player_policies[0].back();
       probs.reserve(policy.size());
       for (const std::pair<Action, double>& pair : policy) {
         probs.push_back(pair.second);
       }
-      trajectory.player_policies[0].push_back(probs);
       trajectory.player_ids[0].push_back(state->CurrentPlayer());
       action = SampleChanceOutcome(
           policy, std::uniform_real_distribution<double>(0.0, 1.0)(*rng));
@@ -185,29 +350,265 @@ BatchedTrajectory RecordTrajectory(
   // We arbitrarily set max_trajectory_length based on the actions field. All
   // the fields should have the same length.
   trajectory.max_trajectory_length = trajectory.actions[0].size();
+  SPIEL_STATS_ADD("trajectories/states_recorded",
+                  trajectory.max_trajectory_length);
+  game.ReleaseStateToPool(std::move(state));
+  return trajectory;
+}
+
+// Rebuilds one episode recorded under seed replay. This mirrors
+// RecordTrajectoryImpl step for step — in particular it consumes the same
+// generator stream, so the chance nodes re-draw exactly the outcomes of the
+// original episode — but applies the stored action at every decision node
+// instead of sampling one.
+BatchedTrajectory ReplayTrajectoryImpl(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    std::uint32_t seed, const std::vector<Action>& episode_actions) {
+  SPIEL_STATS_INC("trajectories/episodes_replayed");
+  BatchedTrajectory trajectory(/*batch_size=*/1);
+  FastRng rng(seed);
+  std::unique_ptr<open_spiel::State> state = game.NewStateFromPool();
+  const int info_state_vector_size =
+      game.InformationStateNormalizedVectorSize();
+  const int max_length = game.MaxGameLength();
+  trajectory.observations[0].reserve(max_length);
+  trajectory.legal_actions[0].reserve(max_length);
+  trajectory.actions[0].reserve(max_length);
+  trajectory.player_policies[0].reserve(max_length);
+  trajectory.player_ids[0].reserve(max_length);
+  std::size_t step = 0;
+  while (!state->IsTerminal()) {
+    Action action = kInvalidAction;
+    if (state->IsChanceNode()) {
+      action = state
+                   ->SampleChanceOutcome(
+                       std::uniform_real_distribution<double>(0.0, 1.0)(rng))
+                   .first;
+    } else {
+      trajectory.legal_actions[0].push_back(state->LegalActionsMask());
+      trajectory.observations[0].emplace_back(info_state_vector_size);
+      state->InformationStateAsNormalizedVector(
+          state->CurrentPlayer(), trajectory.observations[0].back().data());
+      ActionsAndProbs policy = policies.at(state->CurrentPlayer())
+                                   .GetStatePolicy(
+                                       state->InformationStateKey());
+      SPIEL_CHECK_EQ(policy.size(), game.NumDistinctActions());
+      trajectory.player_policies[0].emplace_back();
+      std::vector<double>& probs = trajectory.player_policies[0].back();
+      probs.reserve(policy.size());
+      for (const std::pair<Action, double>& pair : policy) {
+        probs.push_back(pair.second);
+      }
+      trajectory.player_ids[0].push_back(state->CurrentPlayer());
+      // Keep the generator stream aligned with the recording, which drew one
+      // variate here to sample the policy.
+      std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+      SPIEL_CHECK_LT(step, episode_actions.size());
+      action = episode_actions[step];
+      ++step;
+      trajectory.actions[0].push_back(action);
+    }
+    SPIEL_CHECK_NE(action, kInvalidAction);
+    state->ApplyAction(action);
+  }
+  SPIEL_CHECK_EQ(step, episode_actions.size());
+  trajectory.valid[0] = std::vector<int>(trajectory.actions[0].size(), true);
+  trajectory.rewards[0] = state->Returns();
+  trajectory.next_is_terminal[0].resize(trajectory.actions[0].size(), false);
+  trajectory.next_is_terminal[0][trajectory.next_is_terminal[0].size() - 1] =
+      true;
+  trajectory.max_trajectory_length = trajectory.actions[0].size();
+  game.ReleaseStateToPool(std::move(state));
   return trajectory;
 }
 
+}  // namespace
+
+BatchedTrajectory RegenerateBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const TrajectorySeedReplay& replay, int max_unroll_length,
+    int num_threads) {
+  const int batch_size = replay.seeds.size();
+  SPIEL_CHECK_GT(batch_size, 0);
+  SPIEL_CHECK_EQ(replay.actions.size(), replay.seeds.size());
+  BatchedTrajectory batched_trajectory(batch_size);
+  // Episodes are independent given their seeds, so the same actor scheme as
+  // RecordBatchedTrajectory applies.
+  std::atomic<int> next_episode(0);
+  auto replay_episodes = [&]() {
+    while (true) {
+      int i = next_episode++;
+      if (i >= batch_size) return;
+      BatchedTrajectory trajectory = ReplayTrajectoryImpl(
+          game, policies, replay.seeds[i], replay.actions[i]);
+      SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+      batched_trajectory.MoveTrajectoryFields(i, &trajectory);
+    }
+  };
+  if (num_threads <= 1) {
+    replay_episodes();
+  } else {
+    std::vector<std::thread> actors;
+    actors.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      actors.emplace_back(replay_episodes);
+    }
+    for (auto& actor : actors) actor.join();
+  }
+  for (int i = 0; i < batch_size; ++i) {
+    batched_trajectory.max_trajectory_length =
+        std::max(batched_trajectory.max_trajectory_length,
+                 static_cast<uint64_t>(batched_trajectory.actions[i].size()));
+  }
+  batched_trajectory.ResizeFields(max_unroll_length, num_threads);
+  return batched_trajectory;
+}
+
+BatchedTrajectory RecordTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index,
+    bool include_full_observations, std::mt19937* rng) {
+  return RecordTrajectoryImpl(game, policies, initial_state, state_to_index,
+                              include_full_observations, rng);
+}
+
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length) {
+    int max_unroll_length, int num_threads, bool deterministic) {
   if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
   std::unique_ptr<State> state = game.NewInitialState();
   return RecordBatchedTrajectory(game, policies, *state, state_to_index,
                                  batch_size, include_full_observations, rng_ptr,
-                                 max_unroll_length);
+                                 max_unroll_length, num_threads, deterministic);
 }
 
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
-    bool include_full_observations, int seed, int max_unroll_length) {
+    bool include_full_observations, int seed, int max_unroll_length,
+    int num_threads, bool deterministic) {
   std::mt19937 rng(seed);
   return RecordBatchedTrajectory(game, policies, state_to_index, batch_size,
                                  include_full_observations, &rng,
-                                 max_unroll_length);
+                                 max_unroll_length, num_threads, deterministic);
+}
+
+namespace {
+
+// Collection point shared by the RecordTrajectoryChunks actors. Finished
+// [1, T] episodes accumulate in pending_; the actor whose episode fills a
+// chunk swaps the list out under the mutex and assembles the chunk outside
+// it, so the other actors keep recording in the meantime. Delivery runs
+// under its own mutex so the chunk callback never executes concurrently.
+class ChunkCollector {
+ public:
+  ChunkCollector(int chunk_size,
+                 const std::function<void(BatchedTrajectory)>& on_chunk)
+      : chunk_size_(chunk_size), on_chunk_(on_chunk) {
+    pending_.reserve(chunk_size);
+  }
+
+  void Add(BatchedTrajectory trajectory) {
+    std::vector<BatchedTrajectory> full;
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      pending_.push_back(std::move(trajectory));
+      if (static_cast<int>(pending_.size()) < chunk_size_) return;
+      full.swap(pending_);
+      pending_.reserve(chunk_size_);
+    }
+    Ship(std::move(full));
+  }
+
+  // Ships whatever is left as a final partial chunk. Only valid once the
+  // actors have been joined, so no locking on pending_ here.
+  void Flush() {
+    if (!pending_.empty()) Ship(std::move(pending_));
+  }
+
+ private:
+  void Ship(std::vector<BatchedTrajectory> episodes) {
+    BatchedTrajectory chunk(episodes.size());
+    for (int i = 0; i < static_cast<int>(episodes.size()); ++i) {
+      chunk.MoveTrajectory(i, &episodes[i]);
+    }
+    // Default length: pad only to the longest episode of this chunk.
+    chunk.ResizeFields();
+    std::lock_guard<std::mutex> lock(delivery_mutex_);
+    on_chunk_(std::move(chunk));
+  }
+
+  const int chunk_size_;
+  const std::function<void(BatchedTrajectory)>& on_chunk_;
+  std::vector<BatchedTrajectory> pending_;
+  std::mutex pending_mutex_;
+  std::mutex delivery_mutex_;
+};
+
+}  // namespace
+
+void RecordTrajectoryChunks(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index,
+    int num_episodes, int chunk_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int num_threads,
+    const std::function<void(BatchedTrajectory)>& on_chunk) {
+  SPIEL_CHECK_GT(num_episodes, 0);
+  SPIEL_CHECK_GT(chunk_size, 0);
+  SPIEL_CHECK_TRUE(on_chunk != nullptr);
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  ChunkCollector collector(chunk_size, on_chunk);
+
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_episodes; ++i) {
+      BatchedTrajectory trajectory =
+          RecordTrajectoryImpl(game, policies, initial_state, state_to_index,
+                               include_full_observations, rng_ptr);
+      SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+      collector.Add(std::move(trajectory));
+    }
+  } else {
+    // Same actor scheme as RecordBatchedTrajectory — episode numbers claimed
+    // through a shared counter, one seeded generator per actor — except that
+    // the actors hand finished episodes to the collector as they complete
+    // instead of waiting on the slowest episode of a fixed batch.
+    std::vector<std::uint32_t> seeds(num_threads);
+    for (std::uint32_t& seed : seeds) seed = (*rng_ptr)();
+    std::atomic<int> next_episode(0);
+    std::vector<std::thread> actors;
+    actors.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      actors.emplace_back([&, t]() {
+        FastRng rng(seeds[t]);
+        while (next_episode++ < num_episodes) {
+          BatchedTrajectory trajectory = RecordTrajectoryImpl(
+              game, policies, initial_state, state_to_index,
+              include_full_observations, &rng);
+          SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+          collector.Add(std::move(trajectory));
+        }
+      });
+    }
+    for (auto& actor : actors) actor.join();
+  }
+  collector.Flush();
+}
+
+void RecordTrajectoryChunks(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index,
+    int num_episodes, int chunk_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int num_threads,
+    const std::function<void(BatchedTrajectory)>& on_chunk) {
+  if (state_to_index.empty()) SPIEL_CHECK_TRUE(include_full_observations);
+  std::unique_ptr<State> state = game.NewInitialState();
+  RecordTrajectoryChunks(game, policies, *state, state_to_index, num_episodes,
+                         chunk_size, include_full_observations, rng_ptr,
+                         num_threads, on_chunk);
 }
 
 BatchedTrajectory RecordTrajectory(
@@ -220,5 +621,65 @@ BatchedTrajectory RecordTrajectory(
                           include_full_observations, rng_ptr);
 }
 
+BatchedTrajectory TrajectoryRecorder::RecordBatch(
+    const std::vector<TabularPolicy>& policies, int batch_size,
+    int max_unroll_length) {
+  bool include_full_observations = !state_to_index_.empty();
+  std::unique_ptr<State> root = game_->NewInitialState();
+  BatchedTrajectory batch = RecordBatchedTrajectory(
+      *game_, policies, *root, state_to_index_, batch_size,
+      include_full_observations, &rng_, max_unroll_length, num_threads_);
+  if (writer_ != nullptr) writer_->WriteBatch(batch);
+  return batch;
+}
+
+BatchedTrajectory TrajectoryRecorder::RecordBatch(
+    const std::vector<TabularPolicy>& policies, int batch_size,
+    int max_unroll_length, TrajectorySeedReplay* replay) {
+  SPIEL_CHECK_TRUE(replay != nullptr);
+  SPIEL_CHECK_GT(batch_size, 0);
+  // Each episode runs under its own generator, seeded from the recorder's,
+  // so that ReplayTrajectoryImpl can reproduce it in isolation.
+  replay->seeds.resize(batch_size);
+  for (std::uint32_t& seed : replay->seeds) seed = rng_();
+  replay->actions.resize(batch_size);
+  const std::unordered_map<std::string, int> no_state_to_index;
+  std::unique_ptr<State> root = game_->NewInitialState();
+  BatchedTrajectory batch(batch_size);
+  std::atomic<int> next_episode(0);
+  auto record_episodes = [&]() {
+    while (true) {
+      int i = next_episode++;
+      if (i >= batch_size) return;
+      FastRng rng(replay->seeds[i]);
+      BatchedTrajectory trajectory =
+          RecordTrajectoryImpl(*game_, policies, *root, no_state_to_index,
+                               /*include_full_observations=*/true, &rng);
+      SPIEL_CHECK_FALSE(trajectory.rewards[0].empty());
+      // Copy the actions out before the batch is padded.
+      replay->actions[i] = trajectory.actions[0];
+      batch.MoveTrajectoryFields(i, &trajectory);
+    }
+  };
+  if (num_threads_ <= 1) {
+    record_episodes();
+  } else {
+    std::vector<std::thread> actors;
+    actors.reserve(num_threads_);
+    for (int t = 0; t < num_threads_; ++t) {
+      actors.emplace_back(record_episodes);
+    }
+    for (auto& actor : actors) actor.join();
+  }
+  for (int i = 0; i < batch_size; ++i) {
+    batch.max_trajectory_length =
+        std::max(batch.max_trajectory_length,
+                 static_cast<uint64_t>(batch.actions[i].size()));
+  }
+  batch.ResizeFields(max_unroll_length, num_threads_);
+  if (writer_ != nullptr) writer_->WriteBatch(batch);
+  return batch;
+}
+
 }  // namespace algorithms
 }  // namespace open_spiel
@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 #define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORIES_H_
 
+#include <cstdint>
+#include <functional>
 #include <limits>
 #include <random>
 #include <unordered_map>
@@ -27,6 +29,8 @@
 namespace open_spiel {
 namespace algorithms {
 
+class TrajectoryFileWriter;
+
 // The content of a trajectory. The idea is to represent a batch of trajectories
 // of shape [B, T]. Each trajectory will be padded to have the same length,
 // which is equal to the length of the longest episode in the batch.
@@ -37,18 +41,40 @@ struct BatchedTrajectory {
   // Moves the trajectory fields into the current trajectory.
   void MoveTrajectory(int index, BatchedTrajectory* trajectory);
 
+  // As MoveTrajectory, but leaves max_trajectory_length untouched. Safe to
+  // call concurrently for distinct indices, which is what the parallel
+  // RecordBatchedTrajectory does; the caller is then responsible for setting
+  // max_trajectory_length once the moves are done.
+  void MoveTrajectoryFields(int index, BatchedTrajectory* trajectory);
+
   // Pads fields to make sure that they're all the same shape, i.e. [B, T, N],
   // where N = the size of each field. If size is -1, i.e. the default, then
-  // we resize to the max trajectory length in the batch.
-  void ResizeFields(int length = -1);
+  // we resize to the max trajectory length in the batch. The padding of the
+  // batch entries is split among num_threads when it is greater than one.
+  void ResizeFields(int length = -1, int num_threads = 1);
+
+  // Converts the dense observations into the sparse fields above and clears
+  // the dense ones (padded steps become empty rows). DensifyObservations is
+  // the inverse; observation_size is the dense row width to rebuild, i.e.
+  // Game::InformationStateNormalizedVectorSize().
+  void SparsifyObservations();
+  void DensifyObservations(int observation_size);
 
   int batch_size;
 
   // Observations is an optional field that corresponds to the results of
   // calling State::InformationStateAsNormalizedVector. Only one of observations
   // and state_indices will be filled out for any given instance of
-  // BatchedTrajectory.
-  std::vector<std::vector<std::vector<double>>> observations;
+  // BatchedTrajectory. Stored as float32, which is what the neural network
+  // consumers of these batches want, at half the memory traffic of double.
+  std::vector<std::vector<std::vector<float>>> observations;
+
+  // Sparse alternative to observations, filled by SparsifyObservations:
+  // per step, the positions and values of the nonzero observation entries.
+  // For the one-hot-heavy games this cuts observation bandwidth by an order
+  // of magnitude or more.
+  std::vector<std::vector<std::vector<int>>> observation_indices;
+  std::vector<std::vector<std::vector<float>>> observation_values;
 
   // The indices corresponding to the viewed state.
   std::vector<std::vector<int>> state_indices;
@@ -81,12 +107,24 @@ BatchedTrajectory RecordTrajectory(
     const std::unordered_map<std::string, int>& state_to_index,
     bool include_full_observations, std::mt19937* rng_ptr);
 
+// With num_threads > 1, the episodes are generated by actor threads, each
+// with its own RNG (seeded deterministically from *rng_ptr) and a recycled
+// episode state drawn from the game's state pool. Each actor writes finished
+// trajectories straight into its claimed slots of the preallocated batch, so
+// no locking is involved anywhere on the episode path.
+//
+// With deterministic set, the RNGs are seeded per batch slot rather than per
+// actor, so slot i holds the same episode no matter which actor claimed it:
+// the batch is then bit-identical for a given *rng_ptr state regardless of
+// num_threads. The per-actor default only reproduces for a fixed thread
+// count.
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const State& initial_state,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length = -1);
+    int max_unroll_length = -1, int num_threads = 1,
+    bool deterministic = false);
 
 BatchedTrajectory RecordTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
@@ -97,12 +135,72 @@ BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
     bool include_full_observations, std::mt19937* rng_ptr,
-    int max_unroll_length = -1);
+    int max_unroll_length = -1, int num_threads = 1,
+    bool deterministic = false);
 
 BatchedTrajectory RecordBatchedTrajectory(
     const Game& game, const std::vector<TabularPolicy>& policies,
     const std::unordered_map<std::string, int>& state_to_index, int batch_size,
-    bool include_full_observations, int seed, int max_unroll_length = -1);
+    bool include_full_observations, int seed, int max_unroll_length = -1,
+    int num_threads = 1, bool deterministic = false);
+
+// Continuous-batching alternative to RecordBatchedTrajectory for workloads
+// with very uneven episode lengths. RecordBatchedTrajectory pads every
+// episode of the batch to the length of its longest one, so with a 1:4
+// mean/max length ratio most of the produced tensor is padding, and the
+// actors sit idle at the end of the batch while the last stragglers finish.
+// Here episodes instead stream into chunks of chunk_size in the order they
+// complete: the actors claim episode numbers from a shared counter until
+// num_episodes have been recorded (no end-of-batch idle), and each chunk is
+// padded only to the longest episode it happens to contain — episodes of
+// similar length tend to finish together, so the padding bound tracks the
+// chunk, not the global maximum.
+//
+// on_chunk is called once per full chunk plus once for the final partial
+// chunk when num_episodes is not a multiple of chunk_size; the calls are
+// serialized, so the callback does not need its own locking. Chunk order and
+// the episode-to-chunk assignment depend on completion order and so are not
+// deterministic across runs when num_threads > 1.
+void RecordTrajectoryChunks(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const State& initial_state,
+    const std::unordered_map<std::string, int>& state_to_index,
+    int num_episodes, int chunk_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int num_threads,
+    const std::function<void(BatchedTrajectory)>& on_chunk);
+
+void RecordTrajectoryChunks(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const std::unordered_map<std::string, int>& state_to_index,
+    int num_episodes, int chunk_size, bool include_full_observations,
+    std::mt19937* rng_ptr, int num_threads,
+    const std::function<void(BatchedTrajectory)>& on_chunk);
+
+// The replayable skeleton of a batch of episodes: per episode, the RNG seed
+// it was recorded under and the decision-node actions taken. An episode is a
+// deterministic function of (game, policy snapshot, seed) — chance outcomes
+// are re-drawn from the seed rather than stored — so persisting this struct
+// instead of the padded tensors shrinks episode storage by roughly the
+// observation width, and RegenerateBatchedTrajectory rebuilds the full batch
+// on demand.
+struct TrajectorySeedReplay {
+  // One seed per episode; each episode is recorded with its own generator so
+  // it can be replayed in isolation.
+  std::vector<std::uint32_t> seeds;
+  // The decision-node actions of each episode, unpadded.
+  std::vector<std::vector<Action>> actions;
+};
+
+// Rebuilds the full batch for episodes recorded with seed replay (see
+// TrajectoryRecorder::RecordBatch below). The chance outcomes and the policy
+// draws are regenerated from each episode's seed while the stored actions
+// are applied, and the observations are rewritten into the batch rows in
+// place. policies must be the snapshot the episodes were recorded under; the
+// result is then identical to the originally recorded batch.
+BatchedTrajectory RegenerateBatchedTrajectory(
+    const Game& game, const std::vector<TabularPolicy>& policies,
+    const TrajectorySeedReplay& replay, int max_unroll_length = -1,
+    int num_threads = 1);
 
 // Stateful version of RecordTrajectory. There are several optimisations that
 // this allows. Currently, the only optimisation is preventing making multiple
@@ -113,19 +211,29 @@ class TrajectoryRecorder {
  public:
   TrajectoryRecorder(const Game& game,
                      const std::unordered_map<std::string, int>& state_to_index,
-                     int seed)
+                     int seed, int num_threads = 1)
       : game_(game.Clone()),
         state_to_index_(state_to_index),
-        rng_(std::mt19937(seed)) {}
+        rng_(std::mt19937(seed)),
+        num_threads_(num_threads) {}
 
+  // Records a batch; when a writer has been attached with SetWriter, the
+  // batch is also appended to the writer's file.
   BatchedTrajectory RecordBatch(const std::vector<TabularPolicy>& policies,
-                                int batch_size, int max_unroll_length) {
-    bool include_full_observations = !state_to_index_.empty();
-    std::unique_ptr<State> root = game_->NewInitialState();
-    return RecordBatchedTrajectory(*game_, policies, *root, state_to_index_,
-                                   batch_size, include_full_observations, &rng_,
-                                   max_unroll_length);
-  }
+                                int batch_size, int max_unroll_length);
+
+  // As above, but additionally fills *replay with the per-episode
+  // (seed, actions) records that RegenerateBatchedTrajectory needs. Episodes
+  // are seeded per batch slot from the recorder's generator and record full
+  // observations (an index table would defeat regenerating them).
+  BatchedTrajectory RecordBatch(const std::vector<TabularPolicy>& policies,
+                                int batch_size, int max_unroll_length,
+                                TrajectorySeedReplay* replay);
+
+  // Attaches a trajectory file writer (see trajectory_file.h); every batch
+  // recorded afterwards is appended to its file. The writer is not owned and
+  // must outlive the recorder. Pass nullptr to detach.
+  void SetWriter(TrajectoryFileWriter* writer) { writer_ = writer; }
 
  private:
   std::unique_ptr<Game> game_;
@@ -135,6 +243,10 @@ class TrajectoryRecorder {
   std::unordered_map<std::string, int> state_to_index_;
 
   std::mt19937 rng_;
+
+  int num_threads_;
+
+  TrajectoryFileWriter* writer_ = nullptr;
 };
 
 }  // namespace algorithms
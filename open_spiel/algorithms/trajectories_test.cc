@@ -138,6 +138,73 @@ void RecordBatchedTrajectoryEveryFieldHasSameLength(
   SPIEL_CHECK_EQ(batch_size, trajectory.next_is_terminal.size());
 }
 
+void ParallelRecordBatchedTrajectoryIsWellFormed(
+    const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  std::mt19937 rng;
+  BatchedTrajectory trajectory = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, /*rng_ptr=*/&rng,
+      /*max_unroll_length=*/-1, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(trajectory.batch_size, kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    SPIEL_CHECK_EQ(trajectory.actions[i].size(),
+                   trajectory.max_trajectory_length);
+    SPIEL_CHECK_EQ(trajectory.legal_actions[i].size(),
+                   trajectory.max_trajectory_length);
+    SPIEL_CHECK_EQ(trajectory.valid[i].size(),
+                   trajectory.max_trajectory_length);
+    // Every episode must contain at least one real (non-padding) step, and
+    // the rewards must have been filled in.
+    SPIEL_CHECK_TRUE(trajectory.valid[i][0]);
+    SPIEL_CHECK_EQ(trajectory.rewards[i].size(), game->NumPlayers());
+  }
+}
+
+void DeterministicBatchedTrajectoryIsThreadCountInvariant(
+    const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  // Identically-seeded generators, different thread counts: in deterministic
+  // mode every slot must hold the same episode bit for bit.
+  std::mt19937 rng_a(348110958);
+  std::mt19937 rng_b(348110958);
+  BatchedTrajectory trajectory_a = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, &rng_a,
+      /*max_unroll_length=*/-1, /*num_threads=*/2, /*deterministic=*/true);
+  BatchedTrajectory trajectory_b = RecordBatchedTrajectory(
+      *game, policies, states_to_indices, kBatchSize,
+      /*include_full_observations=*/false, &rng_b,
+      /*max_unroll_length=*/-1, /*num_threads=*/5, /*deterministic=*/true);
+  SPIEL_CHECK_TRUE(trajectory_a.actions == trajectory_b.actions);
+  SPIEL_CHECK_TRUE(trajectory_a.valid == trajectory_b.valid);
+  SPIEL_CHECK_TRUE(trajectory_a.rewards == trajectory_b.rewards);
+  SPIEL_CHECK_TRUE(trajectory_a.player_ids == trajectory_b.player_ids);
+}
+
+void SparsifyDensifyObservationsRoundTrips(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::mt19937 rng;
+  BatchedTrajectory trajectory = RecordBatchedTrajectory(
+      *game, policies, /*state_to_index=*/{}, kBatchSize,
+      /*include_full_observations=*/true, &rng);
+  std::vector<std::vector<std::vector<float>>> dense = trajectory.observations;
+  trajectory.SparsifyObservations();
+  for (int b = 0; b < kBatchSize; ++b) {
+    SPIEL_CHECK_TRUE(trajectory.observations[b].empty());
+  }
+  trajectory.DensifyObservations(
+      game->InformationStateNormalizedVectorSize());
+  SPIEL_CHECK_TRUE(trajectory.observations == dense);
+}
+
 void RecordBatchedTrajectoryLegalActionsIsCorrect(
     const std::string& game_name) {
   std::unique_ptr<Game> game = LoadGame(game_name);
@@ -210,6 +277,67 @@ void RecordBatchedTrajectoryPlayerIdsIsCorrect(const std::string& game_name) {
   }
 }
 
+void RecordTrajectoryChunksCoversAllEpisodes(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::unordered_map<std::string, int> states_to_indices =
+      GetStatesToIndices(*game);
+  std::mt19937 rng;
+  const int num_episodes = 3 * kBatchSize + 5;
+  const int chunk_size = kBatchSize;
+  int total_episodes = 0;
+  int num_chunks = 0;
+  RecordTrajectoryChunks(
+      *game, policies, states_to_indices, num_episodes, chunk_size,
+      /*include_full_observations=*/false, &rng, /*num_threads=*/4,
+      [&](BatchedTrajectory chunk) {
+        ++num_chunks;
+        total_episodes += chunk.batch_size;
+        SPIEL_CHECK_LE(chunk.batch_size, chunk_size);
+        for (int b = 0; b < chunk.batch_size; ++b) {
+          // Every episode is padded only to this chunk's own maximum, and
+          // holds at least one real step plus the terminal rewards.
+          SPIEL_CHECK_EQ(chunk.actions[b].size(),
+                         chunk.max_trajectory_length);
+          SPIEL_CHECK_EQ(chunk.valid[b].size(), chunk.max_trajectory_length);
+          SPIEL_CHECK_TRUE(chunk.valid[b][0]);
+          SPIEL_CHECK_EQ(chunk.rewards[b].size(), game->NumPlayers());
+        }
+        SPIEL_CHECK_LE(chunk.max_trajectory_length, game->MaxGameLength());
+      });
+  // 3 full chunks plus the final partial one, covering every episode.
+  SPIEL_CHECK_EQ(num_chunks, 4);
+  SPIEL_CHECK_EQ(total_episodes, num_episodes);
+}
+
+void SeedReplayRegeneratesRecordedBatch(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  TrajectoryRecorder recorder(*game, /*state_to_index=*/{}, /*seed=*/42,
+                              /*num_threads=*/2);
+  TrajectorySeedReplay replay;
+  BatchedTrajectory recorded =
+      recorder.RecordBatch(policies, kBatchSize, /*max_unroll_length=*/-1,
+                           &replay);
+  SPIEL_CHECK_EQ(replay.seeds.size(), kBatchSize);
+  SPIEL_CHECK_EQ(replay.actions.size(), kBatchSize);
+  // The (seed, actions) records plus the recording policies must reproduce
+  // the batch bit for bit, including the regenerated observations.
+  BatchedTrajectory regenerated = RegenerateBatchedTrajectory(
+      *game, policies, replay, /*max_unroll_length=*/-1, /*num_threads=*/2);
+  SPIEL_CHECK_EQ(regenerated.batch_size, recorded.batch_size);
+  SPIEL_CHECK_EQ(regenerated.max_trajectory_length,
+                 recorded.max_trajectory_length);
+  SPIEL_CHECK_TRUE(regenerated.observations == recorded.observations);
+  SPIEL_CHECK_TRUE(regenerated.legal_actions == recorded.legal_actions);
+  SPIEL_CHECK_TRUE(regenerated.actions == recorded.actions);
+  SPIEL_CHECK_TRUE(regenerated.player_policies == recorded.player_policies);
+  SPIEL_CHECK_TRUE(regenerated.player_ids == recorded.player_ids);
+  SPIEL_CHECK_TRUE(regenerated.rewards == recorded.rewards);
+  SPIEL_CHECK_TRUE(regenerated.valid == recorded.valid);
+  SPIEL_CHECK_TRUE(regenerated.next_is_terminal == recorded.next_is_terminal);
+}
+
 void BatchedTrajectoryResizesCorrectly(const std::string& game_name) {
   std::unique_ptr<Game> game = LoadGame(game_name);
   const std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
@@ -272,9 +400,14 @@ int main() {
     alg::RecordTrajectoryPlayerIdsIsCorrect(game_name);
     alg::RecordTrajectoryNextIsTerminalIsCorrect(game_name);
     alg::RecordBatchedTrajectoryEveryFieldHasSameLength(game_name);
+    alg::ParallelRecordBatchedTrajectoryIsWellFormed(game_name);
+    alg::DeterministicBatchedTrajectoryIsThreadCountInvariant(game_name);
+    alg::SparsifyDensifyObservationsRoundTrips(game_name);
     alg::RecordBatchedTrajectoryLegalActionsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryPlayerIdsIsCorrect(game_name);
     alg::RecordBatchedTrajectoryNextIsTerminalIsCorrect(game_name);
+    alg::RecordTrajectoryChunksCoversAllEpisodes(game_name);
+    alg::SeedReplayRegeneratesRecordedBatch(game_name);
     alg::BatchedTrajectoryResizesCorrectly(game_name);
   }
 }
@@ -0,0 +1,300 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr uint32_t kTrajectoryFileMagic = 0x4a54534f;  // "OSTJ", little-endian.
+constexpr uint32_t kTrajectoryFileVersion = 1;
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadRaw(const uint8_t* data, std::size_t size, std::size_t* offset) {
+  if (*offset + sizeof(T) > size) {
+    SpielFatalError("Trajectory record truncated inside a fixed-width field.");
+  }
+  T value;
+  std::memcpy(&value, data + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return value;
+}
+
+// Zero run-length coding for an observation plane: alternating
+// [varint number of zeros][varint number of literals][literal floats] groups
+// until the plane is covered.
+void AppendCompressedObservation(const std::vector<float>& observation,
+                                 std::string* buffer) {
+  std::size_t i = 0;
+  while (i < observation.size()) {
+    std::size_t zero_run = 0;
+    while (i + zero_run < observation.size() &&
+           observation[i + zero_run] == 0.0f) {
+      ++zero_run;
+    }
+    i += zero_run;
+    std::size_t literal_run = 0;
+    while (i + literal_run < observation.size() &&
+           observation[i + literal_run] != 0.0f) {
+      ++literal_run;
+    }
+    AppendVarint(zero_run, buffer);
+    AppendVarint(literal_run, buffer);
+    for (std::size_t j = 0; j < literal_run; ++j) {
+      AppendRaw<float>(observation[i + j], buffer);
+    }
+    i += literal_run;
+  }
+}
+
+std::vector<float> ReadCompressedObservation(const uint8_t* data,
+                                             std::size_t size,
+                                             std::size_t* offset,
+                                             int observation_size) {
+  std::vector<float> observation(observation_size, 0.0f);
+  std::size_t i = 0;
+  while (i < observation.size()) {
+    std::size_t zero_run = ReadVarint(data, size, offset);
+    std::size_t literal_run = ReadVarint(data, size, offset);
+    if (i + zero_run + literal_run > observation.size()) {
+      SpielFatalError("Corrupt observation run in trajectory record.");
+    }
+    i += zero_run;
+    for (std::size_t j = 0; j < literal_run; ++j) {
+      observation[i + j] = ReadRaw<float>(data, size, offset);
+    }
+    i += literal_run;
+  }
+  return observation;
+}
+
+}  // namespace
+
+void AppendTrajectoryRecord(const BatchedTrajectory& batch, int episode,
+                            int observation_size, int num_distinct_actions,
+                            int num_players, bool compress_observations,
+                            std::string* buffer) {
+  const int b = episode;
+  if (batch.observations[b].empty()) {
+    SpielFatalError(
+        "Only batches recorded with full observations can be persisted.");
+  }
+  // Count the real (non-padding) steps.
+  std::size_t length = 0;
+  while (length < batch.valid[b].size() && batch.valid[b][length]) ++length;
+  SPIEL_CHECK_GT(length, 0);
+
+  AppendVarint(length, buffer);
+  SPIEL_CHECK_EQ(batch.rewards[b].size(), num_players);
+  for (double reward : batch.rewards[b]) AppendRaw<double>(reward, buffer);
+
+  for (std::size_t t = 0; t < length; ++t) {
+    SPIEL_CHECK_GE(batch.actions[b][t], 0);
+    AppendVarint(batch.actions[b][t], buffer);
+    SPIEL_CHECK_GE(batch.player_ids[b][t], 0);
+    AppendVarint(batch.player_ids[b][t], buffer);
+
+    // Legal-action mask, one bit per action.
+    const std::vector<int>& mask = batch.legal_actions[b][t];
+    SPIEL_CHECK_EQ(mask.size(), num_distinct_actions);
+    for (int base = 0; base < num_distinct_actions; base += 8) {
+      uint8_t byte = 0;
+      for (int bit = 0; bit < 8 && base + bit < num_distinct_actions; ++bit) {
+        if (mask[base + bit]) byte |= (1 << bit);
+      }
+      buffer->push_back(static_cast<char>(byte));
+    }
+
+    const std::vector<double>& policy = batch.player_policies[b][t];
+    SPIEL_CHECK_EQ(policy.size(), num_distinct_actions);
+    for (double prob : policy) {
+      AppendRaw<float>(static_cast<float>(prob), buffer);
+    }
+
+    const std::vector<float>& observation = batch.observations[b][t];
+    SPIEL_CHECK_EQ(observation.size(), observation_size);
+    if (compress_observations) {
+      AppendCompressedObservation(observation, buffer);
+    } else {
+      for (float value : observation) AppendRaw<float>(value, buffer);
+    }
+  }
+}
+
+void ReadTrajectoryRecord(const uint8_t* data, std::size_t size,
+                          std::size_t* offset, int observation_size,
+                          int num_distinct_actions, int num_players,
+                          bool compress_observations,
+                          BatchedTrajectory* episode) {
+  *episode = BatchedTrajectory(/*batch_size=*/1);
+
+  std::size_t length = ReadVarint(data, size, offset);
+  SPIEL_CHECK_GT(length, 0);
+  episode->rewards[0].reserve(num_players);
+  for (int p = 0; p < num_players; ++p) {
+    episode->rewards[0].push_back(ReadRaw<double>(data, size, offset));
+  }
+
+  for (std::size_t t = 0; t < length; ++t) {
+    episode->actions[0].push_back(ReadVarint(data, size, offset));
+    episode->player_ids[0].push_back(ReadVarint(data, size, offset));
+
+    std::vector<int> mask(num_distinct_actions, 0);
+    for (int base = 0; base < num_distinct_actions; base += 8) {
+      uint8_t byte = ReadRaw<uint8_t>(data, size, offset);
+      for (int bit = 0; bit < 8 && base + bit < num_distinct_actions; ++bit) {
+        mask[base + bit] = (byte >> bit) & 1;
+      }
+    }
+    episode->legal_actions[0].push_back(std::move(mask));
+
+    std::vector<double> policy;
+    policy.reserve(num_distinct_actions);
+    for (int a = 0; a < num_distinct_actions; ++a) {
+      policy.push_back(ReadRaw<float>(data, size, offset));
+    }
+    episode->player_policies[0].push_back(std::move(policy));
+
+    if (compress_observations) {
+      episode->observations[0].push_back(
+          ReadCompressedObservation(data, size, offset, observation_size));
+    } else {
+      std::vector<float> observation;
+      observation.reserve(observation_size);
+      for (int i = 0; i < observation_size; ++i) {
+        observation.push_back(ReadRaw<float>(data, size, offset));
+      }
+      episode->observations[0].push_back(std::move(observation));
+    }
+  }
+
+  episode->valid[0] = std::vector<int>(length, true);
+  episode->next_is_terminal[0].resize(length, false);
+  episode->next_is_terminal[0][length - 1] = true;
+  episode->max_trajectory_length = length;
+}
+
+TrajectoryFileWriter::TrajectoryFileWriter(const std::string& filename,
+                                           int observation_size,
+                                           int num_distinct_actions,
+                                           int num_players,
+                                           bool compress_observations)
+    : observation_size_(observation_size),
+      num_distinct_actions_(num_distinct_actions),
+      num_players_(num_players),
+      compress_observations_(compress_observations) {
+  SPIEL_CHECK_GT(observation_size_, 0);
+  SPIEL_CHECK_GT(num_distinct_actions_, 0);
+  SPIEL_CHECK_GT(num_players_, 0);
+  file_.open(filename, std::ios::binary | std::ios::app);
+  if (!file_) {
+    SpielFatalError(absl::StrCat("Could not open trajectory file for append: ",
+                                 filename));
+  }
+  if (file_.tellp() == std::streampos(0)) {
+    // New or empty file: write the header.
+    AppendRaw<uint32_t>(kTrajectoryFileMagic, &buffer_);
+    AppendRaw<uint32_t>(kTrajectoryFileVersion, &buffer_);
+    AppendRaw<uint32_t>(observation_size_, &buffer_);
+    AppendRaw<uint32_t>(num_distinct_actions_, &buffer_);
+    AppendRaw<uint32_t>(num_players_, &buffer_);
+    AppendRaw<uint8_t>(compress_observations_ ? 1 : 0, &buffer_);
+    file_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+}
+
+void TrajectoryFileWriter::WriteBatch(const BatchedTrajectory& batch) {
+  for (int b = 0; b < batch.batch_size; ++b) {
+    buffer_.clear();
+    AppendTrajectoryRecord(batch, b, observation_size_, num_distinct_actions_,
+                           num_players_, compress_observations_, &buffer_);
+    file_.write(buffer_.data(), buffer_.size());
+    if (!file_) SpielFatalError("Error appending to trajectory file.");
+  }
+}
+
+void TrajectoryFileWriter::Flush() { file_.flush(); }
+
+TrajectoryFileReader::TrajectoryFileReader(const std::string& filename) {
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    SpielFatalError(absl::StrCat("Could not open trajectory file: ",
+                                 filename));
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    SpielFatalError(absl::StrCat("Could not stat trajectory file: ",
+                                 filename));
+  }
+  size_ = file_stat.st_size;
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Could not mmap trajectory file: ",
+                                 filename));
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  offset_ = 0;
+  if (ReadRaw<uint32_t>(data_, size_, &offset_) != kTrajectoryFileMagic) {
+    SpielFatalError(absl::StrCat("Not a trajectory file: ", filename));
+  }
+  uint32_t version = ReadRaw<uint32_t>(data_, size_, &offset_);
+  if (version != kTrajectoryFileVersion) {
+    SpielFatalError(absl::StrCat("Unsupported trajectory file version: ",
+                                 version));
+  }
+  observation_size_ = ReadRaw<uint32_t>(data_, size_, &offset_);
+  num_distinct_actions_ = ReadRaw<uint32_t>(data_, size_, &offset_);
+  num_players_ = ReadRaw<uint32_t>(data_, size_, &offset_);
+  compress_observations_ = ReadRaw<uint8_t>(data_, size_, &offset_) != 0;
+  first_record_offset_ = offset_;
+}
+
+TrajectoryFileReader::~TrajectoryFileReader() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) close(fd_);
+}
+
+void TrajectoryFileReader::Reset() { offset_ = first_record_offset_; }
+
+bool TrajectoryFileReader::NextEpisode(BatchedTrajectory* episode) {
+  if (offset_ >= size_) return false;
+  ReadTrajectoryRecord(data_, size_, &offset_, observation_size_,
+                       num_distinct_actions_, num_players_,
+                       compress_observations_, episode);
+  return true;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,122 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A compact, append-only binary format for persisting trajectories, so that
+// self-play data can be replayed across runs instead of being regenerated.
+//
+// A file is a fixed header (magic, version, observation size, number of
+// distinct actions, number of players, compression flag) followed by one
+// record per episode. Each record stores the episode length as a varint, the
+// per-player terminal rewards, and then per step: the action (varint), the
+// acting player (varint), the legal-action mask (one bit per action), the
+// policy (float32 per action), and the observation (float32). Observations
+// are optionally run-length coded over their zero entries, which is where
+// nearly all the bits live for one-hot-heavy games; this keeps the format
+// free of external compression dependencies while capturing most of the win.
+//
+// Only batches recorded with full observations can be persisted; batches
+// that store state indices refer to an in-memory table that would not
+// survive the round trip.
+
+// Serializes episode `episode` of the batch as one record (with no file
+// header) onto *buffer. This is the unit the file writer appends and the
+// shared-memory ring transport frames.
+void AppendTrajectoryRecord(const BatchedTrajectory& batch, int episode,
+                            int observation_size, int num_distinct_actions,
+                            int num_players, bool compress_observations,
+                            std::string* buffer);
+
+// Decodes the record starting at *offset into a batch-size-1 trajectory,
+// advancing *offset past it.
+void ReadTrajectoryRecord(const uint8_t* data, std::size_t size,
+                          std::size_t* offset, int observation_size,
+                          int num_distinct_actions, int num_players,
+                          bool compress_observations,
+                          BatchedTrajectory* episode);
+
+class TrajectoryFileWriter {
+ public:
+  // Opens filename for appending. The header is written when the file is new
+  // or empty; otherwise it must match the parameters passed here.
+  TrajectoryFileWriter(const std::string& filename, int observation_size,
+                       int num_distinct_actions, int num_players,
+                       bool compress_observations = true);
+
+  // Appends one record per episode in the batch, skipping padded steps.
+  void WriteBatch(const BatchedTrajectory& batch);
+
+  void Flush();
+
+ private:
+  std::ofstream file_;
+  int observation_size_;
+  int num_distinct_actions_;
+  int num_players_;
+  bool compress_observations_;
+
+  // Records are serialized here and appended to the file in one write each.
+  std::string buffer_;
+};
+
+// Memory-mapped reader over a file produced by TrajectoryFileWriter. Records
+// are decoded sequentially; Reset() rewinds to the first record.
+class TrajectoryFileReader {
+ public:
+  explicit TrajectoryFileReader(const std::string& filename);
+  ~TrajectoryFileReader();
+
+  TrajectoryFileReader(const TrajectoryFileReader&) = delete;
+  TrajectoryFileReader& operator=(const TrajectoryFileReader&) = delete;
+
+  // Decodes the next episode into a batch-size-1 BatchedTrajectory. Returns
+  // false when the end of the file has been reached.
+  bool NextEpisode(BatchedTrajectory* episode);
+
+  void Reset();
+
+  int observation_size() const { return observation_size_; }
+  int num_distinct_actions() const { return num_distinct_actions_; }
+  int num_players() const { return num_players_; }
+
+ private:
+  int fd_ = -1;
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t offset_ = 0;
+  std::size_t first_record_offset_ = 0;
+
+  int observation_size_;
+  int num_distinct_actions_;
+  int num_players_;
+  bool compress_observations_;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_FILE_H_
@@ -0,0 +1,100 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_file.h"
+
+#include <cstdio>
+#include <random>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kBatchSize = 32;
+
+void RoundTripTest(const std::string& game_name, bool compress_observations) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  std::mt19937 rng;
+  BatchedTrajectory batch = RecordBatchedTrajectory(
+      *game, policies, /*state_to_index=*/{}, kBatchSize,
+      /*include_full_observations=*/true, &rng);
+
+  std::string filename = absl::StrCat("/tmp/open_spiel_trajectory_file_test_",
+                                      game_name, "_",
+                                      compress_observations ? "rle" : "raw");
+  std::remove(filename.c_str());
+  {
+    TrajectoryFileWriter writer(
+        filename, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers(), compress_observations);
+    writer.WriteBatch(batch);
+    writer.Flush();
+  }
+
+  TrajectoryFileReader reader(filename);
+  SPIEL_CHECK_EQ(reader.observation_size(),
+                 game->InformationStateNormalizedVectorSize());
+  SPIEL_CHECK_EQ(reader.num_distinct_actions(), game->NumDistinctActions());
+  SPIEL_CHECK_EQ(reader.num_players(), game->NumPlayers());
+
+  BatchedTrajectory episode(/*batch_size=*/1);
+  for (int b = 0; b < kBatchSize; ++b) {
+    SPIEL_CHECK_TRUE(reader.NextEpisode(&episode));
+    // The reader returns the unpadded episode; compare against the prefix of
+    // the (padded) batch entry.
+    uint64_t length = episode.max_trajectory_length;
+    SPIEL_CHECK_GT(length, 0);
+    SPIEL_CHECK_EQ(episode.rewards[0], batch.rewards[b]);
+    for (uint64_t t = 0; t < length; ++t) {
+      SPIEL_CHECK_TRUE(batch.valid[b][t]);
+      SPIEL_CHECK_EQ(episode.actions[0][t], batch.actions[b][t]);
+      SPIEL_CHECK_EQ(episode.player_ids[0][t], batch.player_ids[b][t]);
+      SPIEL_CHECK_EQ(episode.legal_actions[0][t], batch.legal_actions[b][t]);
+      SPIEL_CHECK_EQ(episode.observations[0][t], batch.observations[b][t]);
+      for (int a = 0; a < game->NumDistinctActions(); ++a) {
+        SPIEL_CHECK_FLOAT_EQ(episode.player_policies[0][t][a],
+                             batch.player_policies[b][t][a]);
+      }
+    }
+    // The step after the last real one must be padding (or past the end).
+    if (length < batch.valid[b].size()) {
+      SPIEL_CHECK_FALSE(batch.valid[b][length]);
+    }
+    SPIEL_CHECK_TRUE(episode.next_is_terminal[0][length - 1]);
+  }
+  SPIEL_CHECK_FALSE(reader.NextEpisode(&episode));
+
+  // Reset rewinds to the first record.
+  reader.Reset();
+  SPIEL_CHECK_TRUE(reader.NextEpisode(&episode));
+  std::remove(filename.c_str());
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  for (const std::string& game_name : {"kuhn_poker", "leduc_poker"}) {
+    open_spiel::algorithms::RoundTripTest(game_name,
+                                          /*compress_observations=*/true);
+    open_spiel::algorithms::RoundTripTest(game_name,
+                                          /*compress_observations=*/false);
+  }
+}
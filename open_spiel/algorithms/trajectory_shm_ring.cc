@@ -0,0 +1,328 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_shm_ring.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "open_spiel/algorithms/trajectory_file.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// The cursors are free-running byte counts into the modular data area:
+// reserved covers space claimed by producers, published the frames visible
+// to the reader, consumed the space released back to producers. They only
+// ever grow, so reserved - consumed is the number of bytes in flight.
+struct TrajectoryShmRingHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t observation_size;
+  uint32_t num_distinct_actions;
+  uint32_t num_players;
+  uint32_t compress_observations;
+  uint64_t capacity;
+  std::atomic<uint32_t> ready;
+  std::atomic<uint64_t> reserved;
+  std::atomic<uint64_t> published;
+  std::atomic<uint64_t> consumed;
+  // The sequence the next published frame carries. Only the producer whose
+  // claim is at the published cursor touches it, so claim order, sequence
+  // order and publication order all agree.
+  std::atomic<uint64_t> next_sequence;
+};
+
+namespace {
+
+constexpr uint32_t kRingMagic = 0x5254534f;  // "OSTR", little-endian.
+constexpr uint32_t kRingVersion = 1;
+
+// Frame header: uint64 sequence then uint32 payload size.
+constexpr std::size_t kFrameHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+// Copies n bytes into the data area at free-running position pos, wrapping
+// around its end. mask is capacity - 1 (capacity is a power of two).
+void CopyIn(uint8_t* data, uint64_t mask, uint64_t pos, const void* src,
+            std::size_t n) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(src);
+  const uint64_t index = pos & mask;
+  const std::size_t until_end = mask + 1 - index;
+  const std::size_t first = n < until_end ? n : until_end;
+  std::memcpy(data + index, bytes, first);
+  std::memcpy(data, bytes + first, n - first);
+}
+
+void CopyOut(const uint8_t* data, uint64_t mask, uint64_t pos, void* dst,
+             std::size_t n) {
+  uint8_t* bytes = static_cast<uint8_t*>(dst);
+  const uint64_t index = pos & mask;
+  const std::size_t until_end = mask + 1 - index;
+  const std::size_t first = n < until_end ? n : until_end;
+  std::memcpy(bytes, data + index, first);
+  std::memcpy(bytes + first, data, n - first);
+}
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+// Maps the named segment, creating and initializing it when absent. Returns
+// the mapped header; *fd, *data and *map_size are filled in. When create is
+// false the segment must already exist.
+TrajectoryShmRingHeader* AttachRing(const std::string& name, bool create,
+                                    int observation_size,
+                                    int num_distinct_actions, int num_players,
+                                    std::size_t capacity,
+                                    bool compress_observations, int* fd,
+                                    uint8_t** data, std::size_t* map_size) {
+  if (create) {
+    // Try to be the creator; on a race or a pre-existing segment, fall
+    // through to attaching.
+    int creator_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (creator_fd >= 0) {
+      capacity = RoundUpToPowerOfTwo(capacity);
+      *map_size = sizeof(TrajectoryShmRingHeader) + capacity;
+      if (ftruncate(creator_fd, *map_size) != 0) {
+        SpielFatalError(absl::StrCat("Could not size shared-memory ring: ",
+                                     name));
+      }
+      void* mapping = mmap(nullptr, *map_size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, creator_fd, 0);
+      if (mapping == MAP_FAILED) {
+        SpielFatalError(absl::StrCat("Could not mmap shared-memory ring: ",
+                                     name));
+      }
+      TrajectoryShmRingHeader* header =
+          static_cast<TrajectoryShmRingHeader*>(mapping);
+      header->magic = kRingMagic;
+      header->version = kRingVersion;
+      header->observation_size = observation_size;
+      header->num_distinct_actions = num_distinct_actions;
+      header->num_players = num_players;
+      header->compress_observations = compress_observations ? 1 : 0;
+      header->capacity = capacity;
+      header->reserved.store(0, std::memory_order_relaxed);
+      header->published.store(0, std::memory_order_relaxed);
+      header->consumed.store(0, std::memory_order_relaxed);
+      header->next_sequence.store(0, std::memory_order_relaxed);
+      // Attachers spin on this flag, so it must be the last store.
+      header->ready.store(1, std::memory_order_release);
+      *fd = creator_fd;
+      *data = static_cast<uint8_t*>(mapping) +
+              sizeof(TrajectoryShmRingHeader);
+      return header;
+    }
+  }
+
+  *fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (*fd < 0) {
+    SpielFatalError(absl::StrCat("Could not open shared-memory ring: ",
+                                 name));
+  }
+  // The creator sizes the segment before initializing it, so wait for a
+  // non-zero size, map, then wait for the ready flag.
+  struct stat segment_stat;
+  do {
+    if (fstat(*fd, &segment_stat) != 0) {
+      SpielFatalError(absl::StrCat("Could not stat shared-memory ring: ",
+                                   name));
+    }
+    if (segment_stat.st_size == 0) std::this_thread::yield();
+  } while (segment_stat.st_size == 0);
+  *map_size = segment_stat.st_size;
+  if (*map_size < sizeof(TrajectoryShmRingHeader)) {
+    SpielFatalError(absl::StrCat("Shared-memory ring too small: ", name));
+  }
+  void* mapping =
+      mmap(nullptr, *map_size, PROT_READ | PROT_WRITE, MAP_SHARED, *fd, 0);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError(absl::StrCat("Could not mmap shared-memory ring: ",
+                                 name));
+  }
+  TrajectoryShmRingHeader* header =
+      static_cast<TrajectoryShmRingHeader*>(mapping);
+  while (header->ready.load(std::memory_order_acquire) == 0) {
+    std::this_thread::yield();
+  }
+  if (header->magic != kRingMagic) {
+    SpielFatalError(absl::StrCat("Not a trajectory ring segment: ", name));
+  }
+  if (header->version != kRingVersion) {
+    SpielFatalError(absl::StrCat("Unsupported trajectory ring version: ",
+                                 header->version));
+  }
+  *data = static_cast<uint8_t*>(mapping) + sizeof(TrajectoryShmRingHeader);
+  return header;
+}
+
+}  // namespace
+
+TrajectoryShmRingWriter::TrajectoryShmRingWriter(const std::string& name,
+                                                 int observation_size,
+                                                 int num_distinct_actions,
+                                                 int num_players,
+                                                 std::size_t capacity,
+                                                 bool compress_observations)
+    : observation_size_(observation_size),
+      num_distinct_actions_(num_distinct_actions),
+      num_players_(num_players),
+      compress_observations_(compress_observations) {
+  SPIEL_CHECK_GT(observation_size_, 0);
+  SPIEL_CHECK_GT(num_distinct_actions_, 0);
+  SPIEL_CHECK_GT(num_players_, 0);
+  SPIEL_CHECK_GT(capacity, kFrameHeaderSize);
+  header_ = AttachRing(name, /*create=*/true, observation_size_,
+                       num_distinct_actions_, num_players_, capacity,
+                       compress_observations_, &fd_, &data_, &map_size_);
+  SPIEL_CHECK_EQ(header_->observation_size, observation_size_);
+  SPIEL_CHECK_EQ(header_->num_distinct_actions, num_distinct_actions_);
+  SPIEL_CHECK_EQ(header_->num_players, num_players_);
+  SPIEL_CHECK_EQ(header_->compress_observations,
+                 compress_observations_ ? 1 : 0);
+}
+
+TrajectoryShmRingWriter::~TrajectoryShmRingWriter() {
+  if (header_ != nullptr) {
+    munmap(header_, map_size_);
+  }
+  if (fd_ >= 0) close(fd_);
+}
+
+void TrajectoryShmRingWriter::WriteBatch(const BatchedTrajectory& batch) {
+  const uint64_t capacity = header_->capacity;
+  const uint64_t mask = capacity - 1;
+  for (int b = 0; b < batch.batch_size; ++b) {
+    buffer_.clear();
+    AppendTrajectoryRecord(batch, b, observation_size_, num_distinct_actions_,
+                           num_players_, compress_observations_, &buffer_);
+    const uint64_t frame_size = kFrameHeaderSize + buffer_.size();
+    if (frame_size > capacity) {
+      SpielFatalError("Trajectory record larger than the shared-memory ring.");
+    }
+
+    // Claim frame_size bytes, waiting for the reader while the ring is full.
+    uint64_t start = header_->reserved.load(std::memory_order_relaxed);
+    while (true) {
+      if (start + frame_size -
+              header_->consumed.load(std::memory_order_acquire) >
+          capacity) {
+        std::this_thread::yield();
+        start = header_->reserved.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (header_->reserved.compare_exchange_weak(
+              start, start + frame_size, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    const uint32_t payload_size = buffer_.size();
+    CopyIn(data_, mask, start + sizeof(uint64_t), &payload_size,
+           sizeof(payload_size));
+    CopyIn(data_, mask, start + kFrameHeaderSize, buffer_.data(),
+           buffer_.size());
+
+    // Publish in claim order: our turn comes when every earlier claim has
+    // been published, at which point the next sequence number is ours.
+    while (header_->published.load(std::memory_order_acquire) != start) {
+      std::this_thread::yield();
+    }
+    const uint64_t sequence =
+        header_->next_sequence.load(std::memory_order_relaxed);
+    CopyIn(data_, mask, start, &sequence, sizeof(sequence));
+    header_->next_sequence.store(sequence + 1, std::memory_order_relaxed);
+    header_->published.store(start + frame_size, std::memory_order_release);
+    ++episodes_written_;
+  }
+}
+
+TrajectoryShmRingReader::TrajectoryShmRingReader(const std::string& name) {
+  header_ = AttachRing(name, /*create=*/false, /*observation_size=*/0,
+                       /*num_distinct_actions=*/0, /*num_players=*/0,
+                       /*capacity=*/0, /*compress_observations=*/false, &fd_,
+                       &data_, &map_size_);
+  observation_size_ = header_->observation_size;
+  num_distinct_actions_ = header_->num_distinct_actions;
+  num_players_ = header_->num_players;
+  compress_observations_ = header_->compress_observations != 0;
+  read_pos_ = header_->consumed.load(std::memory_order_relaxed);
+}
+
+TrajectoryShmRingReader::~TrajectoryShmRingReader() {
+  if (header_ != nullptr) {
+    munmap(header_, map_size_);
+  }
+  if (fd_ >= 0) close(fd_);
+}
+
+bool TrajectoryShmRingReader::NextEpisode(BatchedTrajectory* episode) {
+  // Frames are published whole, so any advance past read_pos_ means a full
+  // frame is ready.
+  if (header_->published.load(std::memory_order_acquire) == read_pos_) {
+    return false;
+  }
+  const uint64_t capacity = header_->capacity;
+  const uint64_t mask = capacity - 1;
+
+  uint64_t sequence;
+  uint32_t payload_size;
+  CopyOut(data_, mask, read_pos_, &sequence, sizeof(sequence));
+  CopyOut(data_, mask, read_pos_ + sizeof(uint64_t), &payload_size,
+          sizeof(payload_size));
+  if (sequence != static_cast<uint64_t>(episodes_read_)) {
+    SpielFatalError(absl::StrCat("Trajectory ring sequence mismatch: got ",
+                                 sequence, ", want ", episodes_read_));
+  }
+  if (payload_size > capacity - kFrameHeaderSize) {
+    SpielFatalError("Corrupt frame size in trajectory ring.");
+  }
+
+  // Decode straight from the mapping when the payload is contiguous; only a
+  // payload that wraps around the end of the data area needs a copy.
+  const uint64_t payload_index = (read_pos_ + kFrameHeaderSize) & mask;
+  const uint8_t* payload = data_ + payload_index;
+  if (payload_index + payload_size > capacity) {
+    scratch_.resize(payload_size);
+    CopyOut(data_, mask, read_pos_ + kFrameHeaderSize, &scratch_[0],
+            payload_size);
+    payload = reinterpret_cast<const uint8_t*>(scratch_.data());
+  }
+  std::size_t offset = 0;
+  ReadTrajectoryRecord(payload, payload_size, &offset, observation_size_,
+                       num_distinct_actions_, num_players_,
+                       compress_observations_, episode);
+  SPIEL_CHECK_EQ(offset, payload_size);
+
+  read_pos_ += kFrameHeaderSize + payload_size;
+  header_->consumed.store(read_pos_, std::memory_order_release);
+  ++episodes_read_;
+  return true;
+}
+
+void UnlinkTrajectoryShmRing(const std::string& name) {
+  shm_unlink(name.c_str());
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
@@ -0,0 +1,138 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_SHM_RING_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_SHM_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/spiel.h"
+
+namespace open_spiel {
+namespace algorithms {
+
+// A shared-memory ring buffer carrying trajectory records between processes.
+//
+// Actor processes append episodes with TrajectoryShmRingWriter and a learner
+// process drains them with TrajectoryShmRingReader; both map the same POSIX
+// shared-memory segment, so handing over an episode is a memcpy into the
+// mapping with no syscall per episode, where a pipe serializes every byte
+// through the kernel on both sides.
+//
+// The segment is a fixed header (magic, version, the record parameters, the
+// data-area capacity and the producer/consumer cursors) followed by a
+// power-of-two data area addressed modulo its size, so records may wrap
+// around its end. Each record is framed as
+//   [uint64 sequence][uint32 payload size][payload]
+// where the payload is exactly one record in the trajectory_file.h encoding
+// and the sequence numbers episodes from zero. Producers claim space with an
+// atomic fetch-add, serialize their record into the claimed bytes, and
+// publish in claim order; the reader consumes records in sequence and
+// releases the space behind it, checking each frame's sequence number as it
+// goes. Writers block (yielding) while the ring is full; the reader never
+// blocks: NextEpisode simply returns false while no record is ready.
+//
+// Any number of writers may attach to one segment, from any mix of threads
+// and processes; at most one reader may drain it at a time.
+
+struct TrajectoryShmRingHeader;
+
+class TrajectoryShmRingWriter {
+ public:
+  // Attaches to the named segment, creating and initializing it if it does
+  // not exist yet. Names follow shm_open conventions ("/some_name").
+  // capacity is the data-area size in bytes and is rounded up to a power of
+  // two; an existing segment must have been created with the same record
+  // parameters, and every record must fit in the ring whole.
+  TrajectoryShmRingWriter(const std::string& name, int observation_size,
+                          int num_distinct_actions, int num_players,
+                          std::size_t capacity,
+                          bool compress_observations = true);
+  ~TrajectoryShmRingWriter();
+
+  TrajectoryShmRingWriter(const TrajectoryShmRingWriter&) = delete;
+  TrajectoryShmRingWriter& operator=(const TrajectoryShmRingWriter&) = delete;
+
+  // Appends one record per episode in the batch, skipping padded steps.
+  // Blocks while the ring lacks space for the next record.
+  void WriteBatch(const BatchedTrajectory& batch);
+
+  int64_t episodes_written() const { return episodes_written_; }
+
+ private:
+  TrajectoryShmRingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  std::size_t map_size_ = 0;
+  int fd_ = -1;
+
+  int observation_size_;
+  int num_distinct_actions_;
+  int num_players_;
+  bool compress_observations_;
+  int64_t episodes_written_ = 0;
+
+  // Records are serialized here before being copied into the ring.
+  std::string buffer_;
+};
+
+class TrajectoryShmRingReader {
+ public:
+  // Attaches to an existing segment; fails if it has not been created.
+  explicit TrajectoryShmRingReader(const std::string& name);
+  ~TrajectoryShmRingReader();
+
+  TrajectoryShmRingReader(const TrajectoryShmRingReader&) = delete;
+  TrajectoryShmRingReader& operator=(const TrajectoryShmRingReader&) = delete;
+
+  // Decodes the next episode into a batch-size-1 BatchedTrajectory if one
+  // is ready, releasing its ring space. Returns false while the ring is
+  // empty; more episodes may arrive later.
+  bool NextEpisode(BatchedTrajectory* episode);
+
+  int observation_size() const { return observation_size_; }
+  int num_distinct_actions() const { return num_distinct_actions_; }
+  int num_players() const { return num_players_; }
+  int64_t episodes_read() const { return episodes_read_; }
+
+ private:
+  TrajectoryShmRingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  std::size_t map_size_ = 0;
+  int fd_ = -1;
+
+  int observation_size_;
+  int num_distinct_actions_;
+  int num_players_;
+  bool compress_observations_;
+
+  // Free-running byte position of the next unread frame; mirrored into the
+  // header's consumed cursor after each record so writers can reuse space.
+  uint64_t read_pos_ = 0;
+  int64_t episodes_read_ = 0;
+
+  // Scratch for payloads that wrap around the end of the data area.
+  std::string scratch_;
+};
+
+// Removes the named segment from the system. Existing mappings stay valid
+// until unmapped; new attaches will fail or recreate a fresh segment.
+void UnlinkTrajectoryShmRing(const std::string& name);
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TRAJECTORY_SHM_RING_H_
@@ -0,0 +1,189 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/trajectory_shm_ring.h"
+
+#include <random>
+#include <thread>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+constexpr int kBatchSize = 32;
+
+BatchedTrajectory RecordTestBatch(const Game& game, int seed) {
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(game));
+  std::mt19937 rng(seed);
+  return RecordBatchedTrajectory(game, policies, /*state_to_index=*/{},
+                                 kBatchSize,
+                                 /*include_full_observations=*/true, &rng);
+}
+
+void CheckEpisodeMatchesBatch(const BatchedTrajectory& episode,
+                              const BatchedTrajectory& batch, int b,
+                              int num_distinct_actions) {
+  uint64_t length = episode.max_trajectory_length;
+  SPIEL_CHECK_GT(length, 0);
+  SPIEL_CHECK_EQ(episode.rewards[0], batch.rewards[b]);
+  for (uint64_t t = 0; t < length; ++t) {
+    SPIEL_CHECK_TRUE(batch.valid[b][t]);
+    SPIEL_CHECK_EQ(episode.actions[0][t], batch.actions[b][t]);
+    SPIEL_CHECK_EQ(episode.player_ids[0][t], batch.player_ids[b][t]);
+    SPIEL_CHECK_EQ(episode.legal_actions[0][t], batch.legal_actions[b][t]);
+    SPIEL_CHECK_EQ(episode.observations[0][t], batch.observations[b][t]);
+    for (int a = 0; a < num_distinct_actions; ++a) {
+      SPIEL_CHECK_FLOAT_EQ(episode.player_policies[0][t][a],
+                           batch.player_policies[b][t][a]);
+    }
+  }
+  if (length < batch.valid[b].size()) {
+    SPIEL_CHECK_FALSE(batch.valid[b][length]);
+  }
+  SPIEL_CHECK_TRUE(episode.next_is_terminal[0][length - 1]);
+}
+
+void RoundTripTest(const std::string& game_name) {
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  BatchedTrajectory batch = RecordTestBatch(*game, /*seed=*/0);
+
+  const std::string name =
+      absl::StrCat("/open_spiel_trajectory_ring_test_", game_name);
+  UnlinkTrajectoryShmRing(name);
+  {
+    TrajectoryShmRingWriter writer(
+        name, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers(),
+        /*capacity=*/1 << 20);
+    writer.WriteBatch(batch);
+    SPIEL_CHECK_EQ(writer.episodes_written(), kBatchSize);
+
+    TrajectoryShmRingReader reader(name);
+    SPIEL_CHECK_EQ(reader.observation_size(),
+                   game->InformationStateNormalizedVectorSize());
+    SPIEL_CHECK_EQ(reader.num_distinct_actions(), game->NumDistinctActions());
+    SPIEL_CHECK_EQ(reader.num_players(), game->NumPlayers());
+
+    BatchedTrajectory episode(/*batch_size=*/1);
+    for (int b = 0; b < kBatchSize; ++b) {
+      SPIEL_CHECK_TRUE(reader.NextEpisode(&episode));
+      CheckEpisodeMatchesBatch(episode, batch, b,
+                               game->NumDistinctActions());
+    }
+    // The ring is drained, not closed: further polls just return false.
+    SPIEL_CHECK_FALSE(reader.NextEpisode(&episode));
+    SPIEL_CHECK_EQ(reader.episodes_read(), kBatchSize);
+  }
+  UnlinkTrajectoryShmRing(name);
+}
+
+// A ring much smaller than the data forces records to wrap around the end
+// of the data area and the writer to wait for the reader (backpressure),
+// with the writer and reader running concurrently.
+void WrapAndBackpressureTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  BatchedTrajectory batch = RecordTestBatch(*game, /*seed=*/1);
+  constexpr int kNumBatches = 8;
+
+  const std::string name = "/open_spiel_trajectory_ring_test_wrap";
+  UnlinkTrajectoryShmRing(name);
+  {
+    TrajectoryShmRingWriter writer(
+        name, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers(), /*capacity=*/1 << 10);
+
+    std::thread producer([&writer, &batch]() {
+      for (int i = 0; i < kNumBatches; ++i) writer.WriteBatch(batch);
+    });
+
+    TrajectoryShmRingReader reader(name);
+    BatchedTrajectory episode(/*batch_size=*/1);
+    int episodes = 0;
+    while (episodes < kNumBatches * kBatchSize) {
+      if (!reader.NextEpisode(&episode)) {
+        std::this_thread::yield();
+        continue;
+      }
+      CheckEpisodeMatchesBatch(episode, batch, episodes % kBatchSize,
+                               game->NumDistinctActions());
+      ++episodes;
+    }
+    producer.join();
+    SPIEL_CHECK_EQ(writer.episodes_written(), kNumBatches * kBatchSize);
+    SPIEL_CHECK_FALSE(reader.NextEpisode(&episode));
+  }
+  UnlinkTrajectoryShmRing(name);
+}
+
+// Two writers interleave on one ring; the sequence framing keeps the
+// stream consistent and the reader sees every episode exactly once.
+void TwoWritersTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  BatchedTrajectory batch = RecordTestBatch(*game, /*seed=*/2);
+  constexpr int kBatchesPerWriter = 4;
+
+  const std::string name = "/open_spiel_trajectory_ring_test_two";
+  UnlinkTrajectoryShmRing(name);
+  {
+    TrajectoryShmRingWriter writer_a(
+        name, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers(), /*capacity=*/1 << 12);
+    TrajectoryShmRingWriter writer_b(
+        name, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers(), /*capacity=*/1 << 12);
+
+    std::thread producer_a([&writer_a, &batch]() {
+      for (int i = 0; i < kBatchesPerWriter; ++i) writer_a.WriteBatch(batch);
+    });
+    std::thread producer_b([&writer_b, &batch]() {
+      for (int i = 0; i < kBatchesPerWriter; ++i) writer_b.WriteBatch(batch);
+    });
+
+    TrajectoryShmRingReader reader(name);
+    BatchedTrajectory episode(/*batch_size=*/1);
+    const int total = 2 * kBatchesPerWriter * kBatchSize;
+    int episodes = 0;
+    while (episodes < total) {
+      if (!reader.NextEpisode(&episode)) {
+        std::this_thread::yield();
+        continue;
+      }
+      // Writers interleave, so only per-episode integrity can be checked,
+      // not which batch slot an episode came from.
+      SPIEL_CHECK_GT(episode.max_trajectory_length, 0);
+      SPIEL_CHECK_EQ(episode.rewards[0].size(), game->NumPlayers());
+      ++episodes;
+    }
+    producer_a.join();
+    producer_b.join();
+    SPIEL_CHECK_EQ(reader.episodes_read(), total);
+    SPIEL_CHECK_FALSE(reader.NextEpisode(&episode));
+  }
+  UnlinkTrajectoryShmRing(name);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::RoundTripTest("kuhn_poker");
+  open_spiel::algorithms::RoundTripTest("leduc_poker");
+  open_spiel::algorithms::WrapAndBackpressureTest();
+  open_spiel::algorithms::TwoWritersTest();
+}
@@ -0,0 +1,62 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tree_traversal.h"
+
+#include <utility>
+
+namespace open_spiel {
+namespace algorithms {
+
+DepthFirstTraversal::DepthFirstTraversal(std::unique_ptr<State> root,
+                                         int depth_limit)
+    : depth_limit_(depth_limit) {
+  Frame frame;
+  frame.state = std::move(root);
+  stack_.push_back(std::move(frame));
+}
+
+const State* DepthFirstTraversal::Next() {
+  while (!stack_.empty()) {
+    Frame& top = stack_.back();
+    if (!top.visited) {
+      top.visited = true;
+      current_depth_ = top.depth;
+      return top.state.get();
+    }
+    if (!top.expanded) {
+      // Expansion is deferred to the call after the state is produced so
+      // that SkipSubtree can still cancel it.
+      top.expanded = true;
+      if (!skip_subtree_ && !top.state->IsTerminal() &&
+          (depth_limit_ < 0 || top.depth < depth_limit_)) {
+        top.actions = top.state->LegalActions();
+      }
+      skip_subtree_ = false;
+    }
+    if (top.next < top.actions.size()) {
+      Frame child;
+      child.state = top.state->Child(top.actions[top.next++]);
+      child.depth = top.depth + 1;
+      // Invalidates `top`; the loop re-reads the stack top.
+      stack_.push_back(std::move(child));
+      continue;
+    }
+    stack_.pop_back();
+  }
+  return nullptr;
+}
+
+}  // namespace algorithms
+}  // namespace open_spiel
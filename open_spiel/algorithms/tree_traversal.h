@@ -0,0 +1,78 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
+#define THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+
+// An explicit-stack depth-first traversal over game states, replacing native
+// recursion in the tree walks. The call stack is a fixed-size resource that
+// deep games (backgammon, long go) can exhaust, and an explicit stack also
+// makes the traversal a resumable object: callers pull one state at a time
+// and may stop, skip subtrees, or interleave the walk with other work —
+// none of which a recursive walk can do without unwinding. Memory use
+// matches the recursion it replaces: one frame (one state clone plus its
+// action list) per level of the current path.
+
+namespace open_spiel {
+namespace algorithms {
+
+// Pre-order depth-first iteration over the states reachable from a root.
+// States are produced in the order a recursive walk visits them: a state
+// first, then the subtrees of its legal actions (chance outcomes at chance
+// nodes) in action order.
+class DepthFirstTraversal {
+ public:
+  // With depth_limit >= 0, states more than depth_limit moves below the root
+  // are never produced (the root is at depth 0); -1 means no limit.
+  explicit DepthFirstTraversal(std::unique_ptr<State> root,
+                               int depth_limit = -1);
+
+  // Advances to the next state in pre-order and returns it, or nullptr when
+  // the traversal is exhausted. The returned pointer is owned by the
+  // traversal and valid until the next call.
+  const State* Next();
+
+  // Depth of the state returned by the last Next(), in moves from the root.
+  int depth() const { return current_depth_; }
+
+  // Do not descend into the children of the state returned by the last
+  // Next(). Must be called before the following Next().
+  void SkipSubtree() { skip_subtree_ = true; }
+
+ private:
+  // One frame per level of the current root-to-state path.
+  struct Frame {
+    std::unique_ptr<State> state;
+    int depth = 0;
+    bool visited = false;          // State already produced by Next().
+    bool expanded = false;         // Action list already generated.
+    std::vector<Action> actions;   // Children still to descend into.
+    std::size_t next = 0;          // Index of the next action to expand.
+  };
+
+  const int depth_limit_;
+  std::vector<Frame> stack_;
+  int current_depth_ = 0;
+  bool skip_subtree_ = false;
+};
+
+}  // namespace algorithms
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_ALGORITHMS_TREE_TRAVERSAL_H_
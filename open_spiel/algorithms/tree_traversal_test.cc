@@ -0,0 +1,127 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/tree_traversal.h"
+
+#include <string>
+#include <vector>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+// A full walk of Kuhn poker visits every history exactly once, in pre-order:
+// every state after the root extends the history of some state seen earlier.
+void FullWalkKuhnTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  DepthFirstTraversal traversal(game->NewInitialState());
+  int num_states = 0;
+  int max_depth = 0;
+  std::vector<std::vector<Action>> last_history_at_depth;
+  while (const State* state = traversal.Next()) {
+    const int depth = traversal.depth();
+    std::vector<Action> history = state->History();
+    SPIEL_CHECK_EQ(depth, static_cast<int>(history.size()));
+    if (depth > max_depth) max_depth = depth;
+    // Pre-order: the parent must be the most recent state one level up.
+    if (depth > 0) {
+      std::vector<Action> parent_history(history.begin(), history.end() - 1);
+      SPIEL_CHECK_TRUE(parent_history == last_history_at_depth[depth - 1]);
+    }
+    if (depth >= static_cast<int>(last_history_at_depth.size())) {
+      last_history_at_depth.resize(depth + 1);
+    }
+    last_history_at_depth[depth] = std::move(history);
+    ++num_states;
+  }
+  // Kuhn poker has 58 histories: 1 root, 3 + 6 deal prefixes, and 48
+  // histories in the 6 identical betting trees of 8 nodes each.
+  SPIEL_CHECK_EQ(num_states, 58);
+  SPIEL_CHECK_EQ(max_depth, 5);
+  // The traversal is exhausted; further calls keep returning nullptr.
+  SPIEL_CHECK_TRUE(traversal.Next() == nullptr);
+  SPIEL_CHECK_TRUE(traversal.Next() == nullptr);
+}
+
+// With depth_limit = 2, only the root, the 3 first-deal prefixes and the 6
+// completed deals are produced: 1 + 3 + 6 states. The first two levels are
+// chance nodes; at depth 2 both cards are dealt and player 0 is to act.
+void DepthLimitKuhnTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  DepthFirstTraversal traversal(game->NewInitialState(), /*depth_limit=*/2);
+  int num_states = 0;
+  while (const State* state = traversal.Next()) {
+    SPIEL_CHECK_LE(traversal.depth(), 2);
+    if (traversal.depth() < 2) {
+      SPIEL_CHECK_TRUE(state->IsChanceNode());
+    } else {
+      SPIEL_CHECK_EQ(state->CurrentPlayer(), 0);
+    }
+    ++num_states;
+  }
+  SPIEL_CHECK_EQ(num_states, 10);
+}
+
+// SkipSubtree at the root prunes the entire game; below the root it prunes
+// exactly the subtree of the state last returned.
+void SkipSubtreeKuhnTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  {
+    DepthFirstTraversal traversal(game->NewInitialState());
+    SPIEL_CHECK_TRUE(traversal.Next() != nullptr);
+    traversal.SkipSubtree();
+    SPIEL_CHECK_TRUE(traversal.Next() == nullptr);
+  }
+  {
+    // Skipping every depth-1 subtree leaves the root and the three first
+    // deals: 4 states in total.
+    DepthFirstTraversal traversal(game->NewInitialState());
+    int num_states = 0;
+    while (traversal.Next() != nullptr) {
+      if (traversal.depth() == 1) traversal.SkipSubtree();
+      ++num_states;
+    }
+    SPIEL_CHECK_EQ(num_states, 4);
+  }
+}
+
+// The traversal expands children in LegalActions() order (chance outcome
+// order at chance nodes).
+void ActionOrderTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  DepthFirstTraversal traversal(game->NewInitialState(), /*depth_limit=*/1);
+  const State* root = traversal.Next();
+  SPIEL_CHECK_TRUE(root != nullptr);
+  const std::vector<Action> legal_actions = root->LegalActions();
+  for (const Action action : legal_actions) {
+    const State* child = traversal.Next();
+    SPIEL_CHECK_TRUE(child != nullptr);
+    SPIEL_CHECK_EQ(child->History().back(), action);
+  }
+  SPIEL_CHECK_TRUE(traversal.Next() == nullptr);
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::FullWalkKuhnTest();
+  open_spiel::algorithms::DepthLimitKuhnTest();
+  open_spiel::algorithms::SkipSubtreeKuhnTest();
+  open_spiel::algorithms::ActionOrderTest();
+}
@@ -15,116 +15,199 @@
 #include "open_spiel/algorithms/value_iteration.h"
 
 #include <algorithm>
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "open_spiel/algorithms/game_graph.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
 namespace algorithms {
 namespace {
 
-using std::map;
-using std::vector;
-using state_pointer = std::unique_ptr<State>;
-using state_action = std::pair<std::string, Action>;
-using state_prob = std::pair<std::string, double>;
-
-// Adds transitions and transition probability from a given state
-void AddTransition(map<state_action, vector<state_prob>>* transitions,
-                   std::string key, const state_pointer& state) {
-  for (auto action : state->LegalActions()) {
-    auto next_state = state->Clone();
-    next_state->ApplyAction(action);
-    vector<state_prob> possibilities;
-    if (next_state->IsChanceNode()) {
-      // For a chance node, record the transition probabilities
-      for (const auto& actionprob : next_state->ChanceOutcomes()) {
-        auto realized_next_state = next_state->Clone();
-        realized_next_state->ApplyAction(actionprob.first);
-        possibilities.emplace_back(realized_next_state->ToString(),
-                                   actionprob.second);
-      }
-    } else {
-      // A non-chance node is equivalent to transition with probability 1
-      possibilities.emplace_back(next_state->ToString(), 1.0);
+// For both 1-player and 2-player zero sum games, suffices to look at
+// player 0's utility: terminal states start at their return, everything
+// else at zero.
+std::vector<double> InitialValues(const GameGraph& graph) {
+  std::vector<double> values(graph.NumStates(), 0.0);
+  for (int id = 0; id < graph.NumStates(); ++id) {
+    if (graph.is_terminal[id]) values[id] = graph.Return(id, 0);
+  }
+  return values;
+}
+
+// One backup of state `id` against `values`, returning its new value.
+double BackupValue(const GameGraph& graph, int id,
+                   const std::vector<double>& values, double min_utility) {
+  const int player = graph.player[id];
+  // Initialize value to be the minimum utility if current player
+  // is the maximizing player (i.e. player 0), and to maximum utility
+  // if current player is the minimizing player (i.e. player 1).
+  double value = player == 1 ? -min_utility : min_utility;
+  for (int slot = graph.action_begin[id]; slot < graph.action_begin[id + 1];
+       ++slot) {
+    double q_value = 0;
+    for (int o = graph.outcome_begin[slot]; o < graph.outcome_begin[slot + 1];
+         ++o) {
+      q_value += graph.prob[o] * values[graph.successor[o]];
     }
-    (*transitions)[std::make_pair(key, action)] = possibilities;
+    // Player 0 is maximizing the value (which is w.r.t. player 0)
+    // Player 1 is minimizing the value
+    if (player == 0)
+      value = std::max(value, q_value);
+    else
+      value = std::min(value, q_value);
   }
+  return value;
 }
 
-// Initialize transition map and value map
-void InitializeMaps(const map<std::string, state_pointer>& states,
-                    map<std::string, double>* values,
-                    map<state_action, vector<state_prob>>* transitions) {
-  for (const auto& kv : states) {
-    auto key = kv.first;
-    if (kv.second->IsTerminal()) {
-      // For both 1-player and 2-player zero sum games, suffices to look at
-      // player 0's utility
-      (*values)[key] = kv.second->PlayerReturn(0);
-    } else {
-      (*values)[key] = 0;
-      AddTransition(transitions, key, kv.second);
+// Currently only supports 1-player or 2-player zero sum games.
+void CheckGameIsSupported(const Game& game) {
+  SPIEL_CHECK_TRUE(game.NumPlayers() == 1 || game.NumPlayers() == 2);
+  if (game.NumPlayers() == 2) {
+    SPIEL_CHECK_EQ(game.GetType().utility, GameType::Utility::kZeroSum);
+  }
+}
+
+// Gauss-Seidel sweeps in id (i.e. state string) order until the largest
+// update falls below threshold.
+void SweepToConvergence(const GameGraph& graph, double min_utility,
+                        double threshold, std::vector<double>* values) {
+  const int num_states = graph.keys.size();
+  double error;
+  do {
+    error = 0;
+    for (int id = 0; id < num_states; ++id) {
+      if (graph.is_terminal[id]) continue;
+      double value = BackupValue(graph, id, *values, min_utility);
+      error = std::max(std::abs((*values)[id] - value), error);
+      (*values)[id] = value;
     }
+  } while (error > threshold);
+}
+
+std::map<std::string, double> ValuesToMap(const GameGraph& graph,
+                                          const std::vector<double>& values) {
+  std::map<std::string, double> result;
+  for (int id = 0; id < static_cast<int>(graph.keys.size()); ++id) {
+    result.emplace(graph.keys[id], values[id]);
   }
+  return result;
 }
 
 }  // namespace
 
 std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
                                              double threshold) {
-  using state_action = std::pair<std::string, Action>;
-  using state_prob = std::pair<std::string, double>;
+  CheckGameIsSupported(game);
+  const GameGraph graph = CompileGameGraph(game, depth_limit);
+  std::vector<double> values = InitialValues(graph);
+  SweepToConvergence(graph, game.MinUtility(), threshold, &values);
+  return ValuesToMap(graph, values);
+}
 
-  // Currently only supports 1-player or 2-player zero sum games
-  SPIEL_CHECK_TRUE(game.NumPlayers() == 1 || game.NumPlayers() == 2);
-  if (game.NumPlayers() == 2) {
-    SPIEL_CHECK_EQ(game.GetType().utility, GameType::Utility::kZeroSum);
+std::map<std::string, double> PrioritizedValueIteration(const Game& game,
+                                                        int depth_limit,
+                                                        double threshold) {
+  CheckGameIsSupported(game);
+  const GameGraph graph = CompileGameGraph(game, depth_limit);
+  const double min_utility = game.MinUtility();
+  const int num_states = graph.keys.size();
+  std::vector<double> values = InitialValues(graph);
+
+  // The (predecessor, transition probability) edges into each state.
+  std::vector<std::vector<std::pair<int, double>>> predecessors(num_states);
+  for (int id = 0; id < num_states; ++id) {
+    for (int slot = graph.action_begin[id]; slot < graph.action_begin[id + 1];
+         ++slot) {
+      for (int o = graph.outcome_begin[slot];
+           o < graph.outcome_begin[slot + 1]; ++o) {
+        predecessors[graph.successor[o]].emplace_back(id, graph.prob[o]);
+      }
+    }
   }
 
-  auto states = GetAllStates(game, depth_limit, /*include_terminals=*/true,
-                             /*include_chance_states=*/false);
-  std::map<std::string, double> values;
-  std::map<state_action, std::vector<state_prob>> transitions;
+  // Max-heap of (priority, id). Entries are not removed when a priority
+  // grows; an entry is recognized as stale on pop when it no longer matches
+  // priority[id].
+  std::vector<double> priority(num_states, 0.0);
+  std::priority_queue<std::pair<double, int>> queue;
+  for (int id = 0; id < num_states; ++id) {
+    if (graph.is_terminal[id]) continue;
+    const double residual =
+        std::abs(BackupValue(graph, id, values, min_utility) - values[id]);
+    if (residual > threshold) {
+      priority[id] = residual;
+      queue.push({residual, id});
+    }
+  }
 
-  InitializeMaps(states, &values, &transitions);
+  while (!queue.empty()) {
+    const double queued_priority = queue.top().first;
+    const int id = queue.top().second;
+    queue.pop();
+    if (queued_priority != priority[id]) continue;  // Stale entry.
+    priority[id] = 0.0;
+    const double value = BackupValue(graph, id, values, min_utility);
+    const double change = std::abs(value - values[id]);
+    values[id] = value;
+    if (change == 0) continue;
+    for (const auto& pred : predecessors[id]) {
+      // Priority accumulates over changed successors until the state is
+      // backed up again.
+      double& pred_priority = priority[pred.first];
+      pred_priority += pred.second * change;
+      if (pred_priority > threshold) queue.push({pred_priority, pred.first});
+    }
+  }
+
+  // Certify the ValueIteration convergence guarantee; with the queue drained
+  // this normally terminates after a single sweep.
+  SweepToConvergence(graph, min_utility, threshold, &values);
+  return ValuesToMap(graph, values);
+}
 
+std::map<std::string, double> ParallelValueIteration(const Game& game,
+                                                     int depth_limit,
+                                                     double threshold,
+                                                     int num_threads) {
+  CheckGameIsSupported(game);
+  SPIEL_CHECK_GE(num_threads, 1);
+  const GameGraph graph = CompileGameGraph(game, depth_limit);
+  const double min_utility = game.MinUtility();
+  const int num_states = graph.keys.size();
+  std::vector<double> values = InitialValues(graph);
+  // Jacobi iteration: every backup of a sweep reads the previous sweep's
+  // values, so the threads only ever write their own slice of next_values.
+  std::vector<double> next_values = values;
+  std::vector<double> errors(num_threads, 0.0);
   double error;
-  double min_utility = game.MinUtility();
   do {
-    error = 0;
-    for (const auto& kv : states) {
-      auto key = kv.first;
-
-      if (kv.second->IsTerminal()) continue;
-
-      auto player = kv.second->CurrentPlayer();
-
-      // Initialize value to be the minimum utility if current player
-      // is the maximizing player (i.e. player 0), and to maximum utility
-      // if current player is the minimizing player (i.e. player 1).
-      double value = min_utility;
-      if (player == 1) value = -value;
-      for (auto action : kv.second->LegalActions()) {
-        auto possibilities = transitions[std::make_pair(key, action)];
-        double q_value = 0;
-        for (const auto& outcome : possibilities) {
-          q_value += outcome.second * values[outcome.first];
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      const int begin = num_states * t / num_threads;
+      const int end = num_states * (t + 1) / num_threads;
+      threads.emplace_back([t, begin, end, min_utility, &graph, &values,
+                            &next_values, &errors]() {
+        double thread_error = 0;
+        for (int id = begin; id < end; ++id) {
+          if (graph.is_terminal[id]) continue;
+          const double value = BackupValue(graph, id, values, min_utility);
+          thread_error = std::max(std::abs(values[id] - value), thread_error);
+          next_values[id] = value;
         }
-        // Player 0 is maximizing the value (which is w.r.t. player 0)
-        // Player 1 is minimizing the value
-        if (player == 0)
-          value = std::max(value, q_value);
-        else
-          value = std::min(value, q_value);
-      }
-
-      double* stored_value = &values[key];
-      error = std::max(std::abs(*stored_value - value), error);
-      *stored_value = value;
+        errors[t] = thread_error;
+      });
     }
+    for (auto& thread : threads) thread.join();
+    error = *std::max_element(errors.begin(), errors.end());
+    values.swap(next_values);
   } while (error > threshold);
-
-  return values;
+  return ValuesToMap(graph, values);
 }
 
 }  // namespace algorithms
@@ -29,10 +29,33 @@ namespace algorithms {
 //
 // Currently works for sequential 1-player or 2-player zero-sum games,
 // with or without chance nodes.
+//
+// All three variants first compile the reachable states into a GameGraph
+// (see game_graph.h), so no State objects are touched after enumeration;
+// they differ only in how the backups over that graph are ordered.
 
+// In-order Gauss-Seidel sweeps over all states until convergence.
 std::map<std::string, double> ValueIteration(const Game& game, int depth_limit,
                                              double threshold);
 
+// Prioritized sweeping: states are backed up in order of their Bellman
+// residual (largest first), propagating priority to predecessors, which
+// converges with far fewer backups than full sweeps when most of the state
+// space is already settled. Finishes with plain sweeps until the error is
+// below threshold, so the result carries the same guarantee as
+// ValueIteration.
+std::map<std::string, double> PrioritizedValueIteration(const Game& game,
+                                                        int depth_limit,
+                                                        double threshold);
+
+// Jacobi sweeps partitioned over num_threads worker threads: each sweep
+// computes all backups from the previous sweep's values, so the update is
+// deterministic for any thread count.
+std::map<std::string, double> ParallelValueIteration(const Game& game,
+                                                     int depth_limit,
+                                                     double threshold,
+                                                     int num_threads);
+
 }  // namespace algorithms
 }  // namespace open_spiel
 
@@ -0,0 +1,92 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/algorithms/value_iteration.h"
+
+#include <map>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace algorithms {
+namespace {
+
+void CheckTicTacToeValues(const std::map<std::string, double>& solution) {
+  // Tic-tac-toe is a draw under optimal play.
+  SPIEL_CHECK_EQ(solution.at("...\n...\n..."), 0);
+
+  // O plays top-right corner, should lose.
+  SPIEL_CHECK_EQ(solution.at("...\n...\n.ox"), 1);
+
+  // X plays second row first column (and only has x in the corners), should
+  // lose.
+  SPIEL_CHECK_EQ(solution.at("x..\noo.\nxx."), -1);
+}
+
+void ValueIterationTest_TicTacToe() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  CheckTicTacToeValues(ValueIteration(*game, -1, 0.01));
+}
+
+void PrioritizedValueIterationTest_TicTacToe() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  // Tic-tac-toe is deterministic with integer returns, so all variants
+  // converge to exactly the same values.
+  std::map<std::string, double> solution =
+      PrioritizedValueIteration(*game, -1, 0.01);
+  CheckTicTacToeValues(solution);
+  SPIEL_CHECK_TRUE(solution == ValueIteration(*game, -1, 0.01));
+}
+
+void ParallelValueIterationTest_TicTacToe() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::map<std::string, double> solution =
+      ParallelValueIteration(*game, -1, 0.01, /*num_threads=*/4);
+  CheckTicTacToeValues(solution);
+  SPIEL_CHECK_TRUE(solution == ValueIteration(*game, -1, 0.01));
+}
+
+void ValueIterationVariantsAgreeTest_Pig() {
+  // A small game with chance nodes and cycles (rolling a 1 loses the turn
+  // total, revisiting an earlier score state), so the backups genuinely
+  // iterate to a fixed point. The short horizon keeps the enumeration small.
+  std::unique_ptr<Game> game =
+      LoadGame("pig", {{"winscore", GameParameter(6)},
+                       {"horizon", GameParameter(12)},
+                       {"diceoutcomes", GameParameter(2)}});
+  std::map<std::string, double> solution = ValueIteration(*game, -1, 1e-6);
+  std::map<std::string, double> prioritized =
+      PrioritizedValueIteration(*game, -1, 1e-6);
+  std::map<std::string, double> parallel =
+      ParallelValueIteration(*game, -1, 1e-6, /*num_threads=*/4);
+  SPIEL_CHECK_EQ(solution.size(), prioritized.size());
+  SPIEL_CHECK_EQ(solution.size(), parallel.size());
+  for (const auto& kv : solution) {
+    SPIEL_CHECK_FLOAT_NEAR(prioritized.at(kv.first), kv.second, 1e-4);
+    SPIEL_CHECK_FLOAT_NEAR(parallel.at(kv.first), kv.second, 1e-4);
+  }
+}
+
+}  // namespace
+}  // namespace algorithms
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::algorithms::ValueIterationTest_TicTacToe();
+  open_spiel::algorithms::PrioritizedValueIterationTest_TicTacToe();
+  open_spiel::algorithms::ParallelValueIterationTest_TicTacToe();
+  open_spiel::algorithms::ValueIterationVariantsAgreeTest_Pig();
+}
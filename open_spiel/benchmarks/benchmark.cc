@@ -0,0 +1,84 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/benchmarks/benchmark.h"
+
+#include <cstdio>
+#include <iostream>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace benchmarks {
+namespace {
+
+// Benchmark names are plain identifiers, but escape the JSON specials anyway
+// so a stray name cannot corrupt the output.
+std::string JsonEscape(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+std::string FormatDouble(double value) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+  return buffer;
+}
+
+}  // namespace
+
+void BenchmarkSuite::Run(const std::string& name, int64_t iterations,
+                         const std::function<void()>& fn) {
+  WallTimer timer;
+  fn();
+  Report(name, iterations, timer.Seconds());
+}
+
+void BenchmarkSuite::Report(const std::string& name, int64_t iterations,
+                            double seconds) {
+  results_.push_back(BenchmarkResult{name, iterations, seconds});
+  const BenchmarkResult& result = results_.back();
+  // Progress goes to stderr so stdout can stay pure JSON.
+  std::cerr << result.name << ": " << result.iterations << " in "
+            << FormatDouble(result.seconds) << "s ("
+            << FormatDouble(result.PerSecond()) << "/s)" << std::endl;
+}
+
+std::string BenchmarkSuite::ToJson() const {
+  std::string json = "[\n";
+  for (std::size_t i = 0; i < results_.size(); ++i) {
+    const BenchmarkResult& result = results_[i];
+    absl::StrAppend(&json, "  {\"name\": \"", JsonEscape(result.name),
+                    "\", \"iterations\": ", result.iterations,
+                    ", \"seconds\": ", FormatDouble(result.seconds),
+                    ", \"per_second\": ", FormatDouble(result.PerSecond()),
+                    "}", i + 1 < results_.size() ? ",\n" : "\n");
+  }
+  json += "]";
+  return json;
+}
+
+}  // namespace benchmarks
+}  // namespace open_spiel
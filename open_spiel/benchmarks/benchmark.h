@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_BENCHMARKS_BENCHMARK_H_
+#define THIRD_PARTY_OPEN_SPIEL_BENCHMARKS_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// A minimal microbenchmark harness: each benchmark performs a known number
+// of units of work (moves, clones, iterations, ...) under a steady-clock
+// timer, and the suite collects the measurements and renders them as a JSON
+// array so external tooling can track them across revisions. There is
+// deliberately no external benchmark dependency; the workloads themselves
+// dominate the measurement at the iteration counts used.
+
+namespace open_spiel {
+namespace benchmarks {
+
+// One measurement: `iterations` units of work took `seconds` of wall time.
+struct BenchmarkResult {
+  std::string name;
+  int64_t iterations;
+  double seconds;
+
+  double PerSecond() const {
+    return seconds > 0 ? iterations / seconds : 0.0;
+  }
+};
+
+// Measures elapsed wall time from construction (or the last Reset).
+class WallTimer {
+ public:
+  WallTimer() : start_(std::chrono::steady_clock::now()) {}
+
+  void Reset() { start_ = std::chrono::steady_clock::now(); }
+
+  double Seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start_)
+        .count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+class BenchmarkSuite {
+ public:
+  // Times fn, which must perform `iterations` units of work, and records
+  // the result.
+  void Run(const std::string& name, int64_t iterations,
+           const std::function<void()>& fn);
+
+  // Records an externally timed result. Use this when the unit count is only
+  // known after running the workload.
+  void Report(const std::string& name, int64_t iterations, double seconds);
+
+  // The results so far as a JSON array of
+  // {"name": ..., "iterations": ..., "seconds": ..., "per_second": ...}.
+  std::string ToJson() const;
+
+  const std::vector<BenchmarkResult>& results() const { return results_; }
+
+ private:
+  std::vector<BenchmarkResult> results_;
+};
+
+}  // namespace benchmarks
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_BENCHMARKS_BENCHMARK_H_
@@ -0,0 +1,220 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the core hot paths: per-game state operations,
+// chess/go move generation, CFR and MCTS iteration throughput, and
+// trajectory recording. Human-readable progress goes to stderr; the JSON
+// results go to stdout, or to the file given with --json=<path>.
+//
+// All iteration counts scale with --scale (default 1.0), so a CI smoke run
+// can use e.g. --scale=0.01 while perf tracking uses the defaults.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/trajectories.h"
+#include "open_spiel/algorithms/trajectory_file.h"
+#include "open_spiel/benchmarks/benchmark.h"
+#include "open_spiel/games/chess/chess_board.h"
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace benchmarks {
+namespace {
+
+constexpr const char* kTrajectoryFile = "/tmp/open_spiel_benchmark_trajectory";
+
+int64_t Scaled(int64_t iterations, double scale) {
+  return std::max<int64_t>(1, static_cast<int64_t>(iterations * scale));
+}
+
+// Uniformly random playout; chance outcomes are also sampled uniformly,
+// which is fine for a throughput measurement. Returns the number of moves.
+int64_t RandomPlayout(State* state, std::mt19937* rng) {
+  int64_t moves = 0;
+  while (!state->IsTerminal()) {
+    std::vector<Action> legal_actions = state->LegalActions();
+    std::uniform_int_distribution<int> dist(0, legal_actions.size() - 1);
+    state->ApplyAction(legal_actions[dist(*rng)]);
+    ++moves;
+  }
+  return moves;
+}
+
+// Clone / LegalActions / ApplyAction throughput on the given game, measured
+// over the states of random playouts.
+void GameOpBenchmarks(const std::string& game_string, double scale,
+                      BenchmarkSuite* suite) {
+  std::unique_ptr<Game> game = LoadGame(game_string);
+  std::mt19937 rng(1234);
+
+  const int64_t episodes = Scaled(200, scale);
+  int64_t moves = 0;
+  WallTimer timer;
+  for (int64_t episode = 0; episode < episodes; ++episode) {
+    std::unique_ptr<State> state = game->NewInitialState();
+    moves += RandomPlayout(state.get(), &rng);
+  }
+  suite->Report(game_string + "/playout_moves", moves, timer.Seconds());
+
+  // A fixed sample of mid-game states for the per-call measurements.
+  std::vector<std::unique_ptr<State>> states;
+  states.push_back(game->NewInitialState());
+  while (!states.back()->IsTerminal()) {
+    std::unique_ptr<State> next = states.back()->Clone();
+    std::vector<Action> legal_actions = next->LegalActions();
+    std::uniform_int_distribution<int> dist(0, legal_actions.size() - 1);
+    next->ApplyAction(legal_actions[dist(rng)]);
+    states.push_back(std::move(next));
+  }
+
+  const int64_t reps = Scaled(2000, scale);
+  suite->Run(game_string + "/clone", reps * states.size(), [&]() {
+    for (int64_t rep = 0; rep < reps; ++rep) {
+      for (const auto& state : states) {
+        std::unique_ptr<State> clone = state->Clone();
+        SPIEL_CHECK_TRUE(clone != nullptr);
+      }
+    }
+  });
+
+  int64_t legal_calls = 0;
+  timer.Reset();
+  for (int64_t rep = 0; rep < reps; ++rep) {
+    for (const auto& state : states) {
+      if (state->IsTerminal()) continue;
+      std::vector<Action> legal_actions = state->LegalActions();
+      legal_calls += 1;
+      SPIEL_CHECK_GT(legal_actions.size(), 0);
+    }
+  }
+  suite->Report(game_string + "/legal_actions", legal_calls, timer.Seconds());
+}
+
+int64_t Perft(const chess::StandardChessBoard& board, int depth) {
+  if (depth == 0) return 1;
+  int64_t nodes = 0;
+  board.GenerateLegalMoves([&](const chess::Move& move) {
+    chess::StandardChessBoard child = board;
+    child.ApplyMove(move);
+    nodes += Perft(child, depth - 1);
+    return true;
+  });
+  return nodes;
+}
+
+void ChessPerftBenchmark(double scale, BenchmarkSuite* suite) {
+  const int depth = scale < 1.0 ? 3 : 4;
+  chess::StandardChessBoard board = chess::MakeDefaultBoard();
+  WallTimer timer;
+  const int64_t nodes = Perft(board, depth);
+  suite->Report("chess/perft_depth_" + std::to_string(depth), nodes,
+                timer.Seconds());
+}
+
+void CFRBenchmark(const std::string& game_string, int64_t iterations,
+                  double scale, BenchmarkSuite* suite) {
+  std::unique_ptr<Game> game = LoadGame(game_string);
+  algorithms::CFRSolver solver(*game);
+  const int64_t reps = Scaled(iterations, scale);
+  suite->Run(game_string + "/cfr_iteration", reps, [&]() {
+    for (int64_t rep = 0; rep < reps; ++rep) {
+      solver.EvaluateAndUpdatePolicy();
+    }
+  });
+}
+
+void MCTSBenchmark(double scale, BenchmarkSuite* suite) {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  algorithms::RandomRolloutEvaluator evaluator(/*n_rollouts=*/1);
+  constexpr int kMaxSearchNodes = 1000;
+  const int64_t reps = Scaled(20, scale);
+  suite->Run("tic_tac_toe/mcts_simulations",
+             reps * static_cast<int64_t>(kMaxSearchNodes), [&]() {
+               for (int64_t rep = 0; rep < reps; ++rep) {
+                 // A fresh bot each repetition so every search starts from
+                 // an empty tree.
+                 algorithms::MCTSBot bot(*game, /*player=*/0, /*uct_c=*/2,
+                                         kMaxSearchNodes, evaluator);
+                 bot.Step(*state);
+               }
+             });
+}
+
+void TrajectoryBenchmarks(double scale, BenchmarkSuite* suite) {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  std::vector<TabularPolicy> policies(2, GetUniformPolicy(*game));
+  const int64_t batch_size = Scaled(1000, scale);
+
+  algorithms::BatchedTrajectory batch(batch_size);
+  suite->Run("kuhn_poker/record_trajectories", batch_size, [&]() {
+    batch = algorithms::RecordBatchedTrajectory(
+        *game, policies, /*state_to_index=*/{}, batch_size,
+        /*include_full_observations=*/true, /*seed=*/1234);
+  });
+
+  suite->Run("kuhn_poker/write_trajectory_file", batch_size, [&]() {
+    algorithms::TrajectoryFileWriter writer(
+        kTrajectoryFile, game->InformationStateNormalizedVectorSize(),
+        game->NumDistinctActions(), game->NumPlayers());
+    writer.WriteBatch(batch);
+    writer.Flush();
+  });
+  std::remove(kTrajectoryFile);
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  const double scale = std::stod(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "scale", "1.0"));
+  const std::string json_path =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "json", "");
+
+  open_spiel::benchmarks::BenchmarkSuite suite;
+  for (const std::string& game_string :
+       {"tic_tac_toe", "connect_four", "breakthrough", "kuhn_poker",
+        "leduc_poker", "go(board_size=9)", "chess"}) {
+    open_spiel::benchmarks::GameOpBenchmarks(game_string, scale, &suite);
+  }
+  open_spiel::benchmarks::ChessPerftBenchmark(scale, &suite);
+  open_spiel::benchmarks::CFRBenchmark("kuhn_poker", 100, scale, &suite);
+  open_spiel::benchmarks::CFRBenchmark("leduc_poker", 3, scale, &suite);
+  open_spiel::benchmarks::MCTSBenchmark(scale, &suite);
+  open_spiel::benchmarks::TrajectoryBenchmarks(scale, &suite);
+
+  if (json_path.empty()) {
+    std::cout << suite.ToJson() << std::endl;
+  } else {
+    std::ofstream json_file(json_path, std::ios::trunc);
+    if (!json_file) {
+      open_spiel::SpielFatalError("Could not open JSON output file: " +
+                                  json_path);
+    }
+    json_file << suite.ToJson() << std::endl;
+  }
+}
@@ -0,0 +1,269 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Plays many MCTS self-play games concurrently against one shared evaluation
+// service, the actor/evaluator pipeline used by self-play training loops.
+// Each actor thread runs batched MCTS on its own game; the leaves it collects
+// per search round are handed to a service thread that merges pending requests
+// from all actors into larger batches before evaluating them. The queue is
+// bounded, so actors that outrun the evaluator block until it catches up
+// (backpressure) rather than piling up unbounded work.
+//
+// The backend here is the random-rollout evaluator; a real pipeline would put
+// a neural network behind the same interface, where merged batches pay off.
+
+namespace {
+
+using open_spiel::State;
+using open_spiel::algorithms::BatchEvaluator;
+
+// A single service thread that owns the evaluation backend. Actor threads
+// submit their leaf batches through Evaluate() and block until the results
+// come back; the service drains the queue in batches of up to max_batch_size
+// states, so requests from different actors that arrive close together are
+// evaluated in one backend call.
+class EvaluationService {
+ public:
+  // The queue holds at most max_queued_states states across all pending
+  // requests; Evaluate() blocks while it is full.
+  EvaluationService(const BatchEvaluator& backend, int max_batch_size,
+                    int max_queued_states)
+      : backend_(backend),
+        max_batch_size_(max_batch_size),
+        max_queued_states_(max_queued_states),
+        worker_([this]() { Run(); }) {}
+
+  ~EvaluationService() { Stop(); }
+
+  // Evaluates the given states through the service thread. Thread-safe;
+  // blocks until queue space is available and then until the results arrive.
+  std::vector<double> Evaluate(const std::vector<const State*>& states) {
+    Request request;
+    request.states = &states;
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_cv_.wait(lock, [this, &states]() {
+      return queued_states_ + static_cast<int>(states.size()) <=
+                 max_queued_states_ ||
+             queue_.empty();
+    });
+    queue_.push_back(&request);
+    queued_states_ += states.size();
+    queue_cv_.notify_one();
+    done_cv_.wait(lock, [&request]() { return request.done; });
+    return std::move(request.results);
+  }
+
+  // Drains remaining requests and joins the service thread. Called by the
+  // destructor; safe to call more than once.
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stop_) return;
+      stop_ = true;
+    }
+    queue_cv_.notify_one();
+    worker_.join();
+  }
+
+  int64_t num_batches() const { return num_batches_; }
+  int64_t num_states_evaluated() const { return num_states_evaluated_; }
+  int largest_batch() const { return largest_batch_; }
+
+ private:
+  struct Request {
+    const std::vector<const State*>* states;
+    std::vector<double> results;
+    bool done = false;
+  };
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        if (stop_) return;
+        continue;
+      }
+      // Merge queued requests into one backend batch. A request is taken
+      // whole or not at all, so every actor's round completes in one call.
+      std::vector<Request*> taken;
+      std::vector<const State*> batch;
+      while (!queue_.empty() &&
+             (batch.empty() ||
+              batch.size() + queue_.front()->states->size() <=
+                  static_cast<size_t>(max_batch_size_))) {
+        Request* request = queue_.front();
+        queue_.pop_front();
+        queued_states_ -= request->states->size();
+        taken.push_back(request);
+        batch.insert(batch.end(), request->states->begin(),
+                     request->states->end());
+      }
+      space_cv_.notify_all();
+      lock.unlock();
+      std::vector<double> values = backend_.evaluate(batch);
+      lock.lock();
+      ++num_batches_;
+      num_states_evaluated_ += batch.size();
+      largest_batch_ = std::max<int>(largest_batch_, batch.size());
+      // Scatter the merged results back to their requests.
+      auto value = values.begin();
+      for (Request* request : taken) {
+        request->results.assign(value, value + request->states->size());
+        value += request->states->size();
+        request->done = true;
+      }
+      done_cv_.notify_all();
+    }
+  }
+
+  const BatchEvaluator& backend_;
+  const int max_batch_size_;
+  const int max_queued_states_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;  // Signals the service thread.
+  std::condition_variable space_cv_;  // Signals actors waiting for space.
+  std::condition_variable done_cv_;   // Signals actors waiting for results.
+  std::deque<Request*> queue_;
+  int queued_states_ = 0;
+  bool stop_ = false;
+
+  int64_t num_batches_ = 0;
+  int64_t num_states_evaluated_ = 0;
+  int largest_batch_ = 0;
+
+  std::thread worker_;
+};
+
+// The evaluator handed to each actor's search: forwards its leaf batches to
+// the shared service.
+class ServiceBatchEvaluator : public BatchEvaluator {
+ public:
+  explicit ServiceBatchEvaluator(EvaluationService* service)
+      : service_(service) {}
+
+  std::vector<double> evaluate(
+      const std::vector<const State*>& states) const override {
+    return service_->Evaluate(states);
+  }
+
+ private:
+  EvaluationService* service_;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string game_name =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "game", "tic_tac_toe");
+  int num_games = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "num_games", "8"));
+  int num_actors = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "num_actors", "4"));
+  int max_search_nodes = std::stoi(open_spiel::ParseCmdLineArgDefault(
+      argc, argv, "max_search_nodes", "1000"));
+  int batch_size = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "batch_size", "8"));
+  int rollout_count = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "rollout_count", "10"));
+
+  // Exploration parameter for UCT
+  const double uct_c = 2;
+
+  std::unique_ptr<open_spiel::Game> game = open_spiel::LoadGame(game_name);
+
+  // Check that the game satisfies conditions for the implemented MCTS
+  // algorithm.
+  SPIEL_CHECK_TRUE(game->NumPlayers() == 1 || game->NumPlayers() == 2);
+  if (game->NumPlayers() == 2) {
+    SPIEL_CHECK_EQ(game->GetType().utility,
+                   open_spiel::GameType::Utility::kZeroSum);
+  }
+  SPIEL_CHECK_TRUE(game->GetType().dynamics ==
+                   open_spiel::GameType::Dynamics::kSequential);
+
+  // The rollout evaluator stands in for a learned network; states merged into
+  // one batch are still rolled out one by one behind it.
+  open_spiel::algorithms::RandomRolloutEvaluator rollout(
+      rollout_count, game->GetType().history_independent_state);
+  open_spiel::algorithms::SingleStateBatchEvaluator backend(rollout);
+
+  // Bound the queue so the actors can keep at most one round of leaves each
+  // in flight ahead of the evaluator.
+  EvaluationService service(backend, batch_size,
+                            /*max_queued_states=*/num_actors * batch_size);
+  ServiceBatchEvaluator evaluator(&service);
+
+  // Per-game returns to player 0, filled in by the actors.
+  std::vector<double> results(num_games, 0);
+  std::mutex results_mutex;
+
+  // Each actor plays its share of the games to completion, running batched
+  // MCTS for whichever player is to move (self-play).
+  std::vector<std::thread> actors;
+  actors.reserve(num_actors);
+  for (int actor = 0; actor < num_actors; ++actor) {
+    actors.emplace_back([&, actor]() {
+      std::mt19937 rng(actor);
+      for (int game_num = actor; game_num < num_games;
+           game_num += num_actors) {
+        std::unique_ptr<State> state = game->NewInitialState();
+        while (!state->IsTerminal()) {
+          if (state->IsChanceNode()) {
+            open_spiel::Action action = open_spiel::SampleChanceOutcome(
+                state->ChanceOutcomes(),
+                std::uniform_real_distribution<double>(0.0, 1.0)(rng));
+            state->ApplyAction(action);
+          } else {
+            open_spiel::Action action = open_spiel::algorithms::
+                MCTSearchBatched(*state, uct_c, max_search_nodes, evaluator,
+                                 batch_size);
+            state->ApplyAction(action);
+          }
+        }
+        std::lock_guard<std::mutex> lock(results_mutex);
+        results[game_num] = state->Returns()[0];
+      }
+    });
+  }
+  for (std::thread& actor : actors) actor.join();
+  service.Stop();
+
+  for (int game_num = 0; game_num < num_games; ++game_num) {
+    std::cerr << "Game " << game_num << " return to player 0: "
+              << results[game_num] << std::endl;
+  }
+  std::cerr << "Evaluated " << service.num_states_evaluated() << " states in "
+            << service.num_batches() << " batches (mean "
+            << static_cast<double>(service.num_states_evaluated()) /
+                   std::max<int64_t>(service.num_batches(), 1)
+            << " states/batch, largest " << service.largest_batch() << ")."
+            << std::endl;
+}
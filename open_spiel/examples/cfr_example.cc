@@ -12,33 +12,203 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/get_legal_actions_map.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/policy.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
 
-// Example code for using CFR+ to solve Kuhn Poker.
+// A driver for comparing CFR variants at fixed cost: runs a chosen solver
+// for a fixed number of iterations or a fixed wall-clock budget, and
+// periodically evaluates exploitability of the average policy on a background
+// thread so evaluation overlaps solving. Each evaluation is logged to stderr
+// and, with --csv, appended as a time-stamped row to a CSV file.
+//
+// The solver's table cannot be read while an iteration is running, so the
+// main loop snapshots the average policy into a TabularPolicy between
+// iterations and hands the snapshot to the evaluation thread. If solving
+// outpaces evaluation, a newer snapshot replaces the waiting one, so the
+// evaluator always measures the freshest available policy and never stalls
+// the solver.
+
+namespace {
+
+using open_spiel::TabularPolicy;
+
+// A pending average-policy snapshot, tagged with where the solver was when
+// it was taken.
+struct Snapshot {
+  std::unique_ptr<TabularPolicy> policy;
+  int iteration;
+  double seconds;
+};
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+}  // namespace
+
 int main(int argc, char** argv) {
-  std::unique_ptr<open_spiel::Game> game = open_spiel::LoadGame("kuhn_poker");
-  open_spiel::algorithms::CFRPlusSolver solver(*game);
-  std::cerr << "Starting CFR and CFR+ on kuhn_poker..." << std::endl;
+  std::string game_name =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "game", "kuhn_poker");
+  std::string solver_name =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "solver", "cfrplus");
+  int num_threads = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "num_threads", "4"));
+  int iterations = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "iterations", "1000"));
+  // Wall-clock budget in seconds; when positive it replaces the iteration
+  // count as the stopping rule.
+  double time_budget = std::stod(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "time_budget", "0"));
+  int eval_every = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "eval_every", "100"));
+  std::string csv_filename =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "csv", "");
+
+  std::unique_ptr<open_spiel::Game> game = open_spiel::LoadGame(game_name);
 
-  constexpr int iterations = 1000;
-  for (int i = 0; i < iterations; i++) {
-    if (i % 100 == 0) {
-      double exploitability = open_spiel::algorithms::Exploitability(
-          *game, *solver.AveragePolicy());
+  // The solver variants do not share a base class, so the loop drives them
+  // through these two closures.
+  std::unique_ptr<open_spiel::algorithms::CFRSolverBase> solver;
+  std::unique_ptr<open_spiel::algorithms::CFRParallelSolver> parallel_solver;
+  std::function<void()> step;
+  std::function<std::unique_ptr<open_spiel::Policy>()> average_policy;
+  if (solver_name == "cfr") {
+    solver.reset(new open_spiel::algorithms::CFRSolver(*game));
+  } else if (solver_name == "cfrplus") {
+    solver.reset(new open_spiel::algorithms::CFRPlusSolver(*game));
+  } else if (solver_name == "parallel") {
+    parallel_solver.reset(
+        new open_spiel::algorithms::CFRParallelSolver(*game, num_threads));
+  } else {
+    open_spiel::SpielFatalError(
+        absl::StrCat("Unknown solver (want cfr, cfrplus, or parallel): ",
+                     solver_name));
+  }
+  if (solver != nullptr) {
+    step = [&solver]() { solver->EvaluateAndUpdatePolicy(); };
+    average_policy = [&solver]() { return solver->AveragePolicy(); };
+  } else {
+    step = [&parallel_solver]() { parallel_solver->EvaluateAndUpdatePolicy(); };
+    average_policy = [&parallel_solver]() {
+      return parallel_solver->AveragePolicy();
+    };
+  }
 
-      std::cerr << "Iteration " << i << " exploitability=" << exploitability
+  // The information states, gathered once so snapshots are a table lookup
+  // per state rather than a game traversal.
+  std::unordered_map<std::string, std::vector<open_spiel::Action>>
+      legal_actions_map = open_spiel::algorithms::GetLegalActionsMap(
+          *game, /*depth_limit=*/-1, open_spiel::kInvalidPlayer);
+  auto take_snapshot = [&]() {
+    std::unique_ptr<open_spiel::Policy> policy = average_policy();
+    std::unique_ptr<TabularPolicy> snapshot(new TabularPolicy);
+    for (const auto& entry : legal_actions_map) {
+      snapshot->PolicyTable()[entry.first] =
+          policy->GetStatePolicy(entry.first);
+    }
+    return snapshot;
+  };
+
+  std::ofstream csv;
+  if (!csv_filename.empty()) {
+    csv.open(csv_filename, std::ios::trunc);
+    if (!csv) {
+      open_spiel::SpielFatalError(
+          absl::StrCat("Could not open csv file for write: ", csv_filename));
+    }
+    csv << "seconds,iteration,exploitability\n";
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // The evaluation thread: waits for a snapshot, measures it, logs the
+  // result. Holds its own ExploitabilityEvaluator so the best-response data
+  // structures are reused across evaluations.
+  std::mutex mutex;
+  std::condition_variable snapshot_cv;
+  Snapshot pending;  // pending.policy == nullptr means nothing is waiting.
+  bool done = false;
+  double last_exploitability = -1;
+  std::thread evaluator_thread([&]() {
+    open_spiel::algorithms::ExploitabilityEvaluator evaluator(*game);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      snapshot_cv.wait(
+          lock, [&]() { return done || pending.policy != nullptr; });
+      if (pending.policy == nullptr) return;  // Done, nothing left to measure.
+      Snapshot snapshot = std::move(pending);
+      pending.policy = nullptr;
+      lock.unlock();
+      double exploitability = evaluator.Exploitability(*snapshot.policy);
+      lock.lock();
+      last_exploitability = exploitability;
+      std::cerr << "t=" << snapshot.seconds << "s iteration "
+                << snapshot.iteration << " exploitability=" << exploitability
                 << std::endl;
+      if (csv.is_open()) {
+        csv << snapshot.seconds << "," << snapshot.iteration << ","
+            << exploitability << "\n";
+        csv.flush();
+      }
     }
-    solver.EvaluateAndUpdatePolicy();
+  });
+
+  auto post_snapshot = [&](int iteration) {
+    Snapshot snapshot;
+    snapshot.policy = take_snapshot();
+    snapshot.iteration = iteration;
+    snapshot.seconds = SecondsSince(start);
+    std::lock_guard<std::mutex> lock(mutex);
+    // Replacing an unconsumed snapshot drops the stale measurement rather
+    // than queueing behind it.
+    pending = std::move(snapshot);
+    snapshot_cv.notify_one();
+  };
+
+  std::cerr << "Running " << solver_name << " on " << game_name << " for ";
+  if (time_budget > 0) {
+    std::cerr << time_budget << " seconds..." << std::endl;
+  } else {
+    std::cerr << iterations << " iterations..." << std::endl;
+  }
+
+  int iteration = 0;
+  while (time_budget > 0 ? SecondsSince(start) < time_budget
+                         : iteration < iterations) {
+    if (iteration % eval_every == 0) post_snapshot(iteration);
+    step();
+    ++iteration;
+  }
+  double solve_seconds = SecondsSince(start);
+
+  // Final measurement: post the finished policy, then let the evaluator
+  // drain it before joining.
+  post_snapshot(iteration);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
   }
-  double exploitability =
-      open_spiel::algorithms::Exploitability(*game, *solver.AveragePolicy());
+  snapshot_cv.notify_one();
+  evaluator_thread.join();
 
-  std::cerr << "Exploitability of " << exploitability << " reached after "
-            << iterations << " iterations." << std::endl;
+  std::cerr << "Exploitability of " << last_exploitability << " reached after "
+            << iteration << " iterations in " << solve_seconds << " seconds."
+            << std::endl;
 }
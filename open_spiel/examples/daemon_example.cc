@@ -0,0 +1,532 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A daemon-style example server. Shelling out to a fresh binary per request
+// re-pays game registration, lazy table construction (Zobrist keys, legal
+// move caches) and solver warm-up on every invocation; this server pays them
+// once at startup for the games named in --games and then answers requests
+// over a Unix-domain stream socket (--socket). Per-game state persists
+// between requests: the CFR solver behind `evaluate` resumes from its
+// accumulated tables, the ExploitabilityEvaluator keeps its game tree, and
+// the MCTS bots behind `search` keep their search trees.
+//
+// The wire protocol is binary and host-endian (the socket never leaves the
+// machine). Each message is a uint32 payload size followed by the payload.
+// Request payloads are:
+//   uint8 opcode, uint8 name_len, name_len bytes of game name, then:
+//     opcode 1 (simulate): uint32 seed
+//         -> uint8 0, uint32 num_players, num_players doubles (returns of a
+//            uniform-random playout).
+//     opcode 2 (evaluate): uint32 iterations
+//         -> uint8 0, uint32 total_iterations, double nash_conv. Runs the
+//            given number of additional CFR iterations on the persistent
+//            solver. Turn-based games only.
+//     opcode 3 (search): uint32 max_search_nodes, uint32 num_actions,
+//                        num_actions int64 actions
+//         -> uint8 0, int64 best action from the state reached by applying
+//            the actions from the initial state. 1- and 2-player zero-sum
+//            turn-based games only.
+//     opcode 0 (shutdown): no arguments and no game name (name_len 0)
+//         -> uint8 0; the server exits once the connection closes.
+// On failure the response payload is uint8 1 followed by a message.
+//
+// --selftest starts the server on a background thread, exercises every
+// opcode through a client connection, and exits; it expects tic_tac_toe and
+// kuhn_poker in --games. The server handles one connection at a time.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/algorithms/mcts.h"
+#include "open_spiel/algorithms/tabular_exploitability.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace {
+
+using open_spiel::Action;
+using open_spiel::Game;
+using open_spiel::State;
+
+constexpr std::uint8_t kOpShutdown = 0;
+constexpr std::uint8_t kOpSimulate = 1;
+constexpr std::uint8_t kOpEvaluate = 2;
+constexpr std::uint8_t kOpSearch = 3;
+
+constexpr std::uint8_t kStatusOk = 0;
+constexpr std::uint8_t kStatusError = 1;
+
+constexpr double kUctC = 2;
+constexpr int kRolloutCount = 10;
+
+// Everything kept warm for one preloaded game.
+struct LoadedGame {
+  std::unique_ptr<Game> game;
+  // Lazily created on the first evaluate request, then persistent: later
+  // requests resume from the accumulated regret and policy tables.
+  std::unique_ptr<open_spiel::algorithms::CFRSolver> cfr;
+  int cfr_iterations = 0;
+  // Keeps the best-response tree between evaluate requests.
+  std::unique_ptr<open_spiel::algorithms::ExploitabilityEvaluator>
+      exploitability;
+  // Shared by the MCTS bots below; bots keep their search trees between
+  // search requests and re-root them when the requested state extends the
+  // previous one.
+  std::unique_ptr<open_spiel::algorithms::RandomRolloutEvaluator> rollouts;
+  std::map<int, std::unique_ptr<open_spiel::algorithms::MCTSBot>> bots;
+};
+
+std::vector<std::string> SplitCsv(const std::string& list) {
+  std::vector<std::string> items;
+  std::string::size_type start = 0;
+  while (start <= list.size()) {
+    std::string::size_type comma = list.find(',', start);
+    if (comma == std::string::npos) comma = list.size();
+    if (comma > start) items.push_back(list.substr(start, comma - start));
+    start = comma + 1;
+  }
+  return items;
+}
+
+// Loads each game and runs one throwaway playout so that lazily initialized
+// tables (Zobrist keys, cached legal actions) are built before the first
+// request arrives.
+std::map<std::string, LoadedGame> PreloadGames(
+    const std::vector<std::string>& game_names) {
+  std::map<std::string, LoadedGame> games;
+  for (const std::string& name : game_names) {
+    auto start = std::chrono::steady_clock::now();
+    LoadedGame& entry = games[name];
+    entry.game = open_spiel::LoadGame(name);
+    std::mt19937 rng(0);
+    std::unique_ptr<State> state = entry.game->NewInitialState();
+    while (!state->IsTerminal()) {
+      if (state->IsChanceNode()) {
+        state->ApplyAction(open_spiel::SampleChanceOutcome(
+            state->ChanceOutcomes(),
+            std::uniform_real_distribution<double>(0.0, 1.0)(rng)));
+      } else {
+        std::vector<Action> actions = state->LegalActions();
+        state->ApplyAction(actions[std::uniform_int_distribution<int>(
+            0, actions.size() - 1)(rng)]);
+      }
+    }
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Preloaded " << name << " in " << seconds << " seconds"
+              << std::endl;
+  }
+  return games;
+}
+
+// ---------------------------------------------------------------------------
+// Wire helpers. All fields are fixed-size and host-endian; a frame is a
+// uint32 payload size followed by the payload bytes.
+
+bool ReadFull(int fd, void* data, std::size_t size) {
+  char* out = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, out, size);
+    if (n <= 0) return false;
+    out += n;
+    size -= n;
+  }
+  return true;
+}
+
+bool WriteFull(int fd, const void* data, std::size_t size) {
+  const char* in = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, in, size);
+    if (n <= 0) return false;
+    in += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Returns false on a closed connection.
+bool ReadFrame(int fd, std::string* payload) {
+  std::uint32_t size;
+  if (!ReadFull(fd, &size, sizeof(size))) return false;
+  payload->resize(size);
+  return size == 0 || ReadFull(fd, &(*payload)[0], size);
+}
+
+bool WriteFrame(int fd, const std::string& payload) {
+  std::uint32_t size = payload.size();
+  return WriteFull(fd, &size, sizeof(size)) &&
+         WriteFull(fd, payload.data(), payload.size());
+}
+
+template <typename T>
+void Append(std::string* buffer, T value) {
+  buffer->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool Parse(const std::string& buffer, std::size_t* offset, T* value) {
+  if (*offset + sizeof(T) > buffer.size()) return false;
+  std::memcpy(value, buffer.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return true;
+}
+
+std::string ErrorResponse(const std::string& message) {
+  std::string response;
+  Append(&response, kStatusError);
+  response += message;
+  return response;
+}
+
+// ---------------------------------------------------------------------------
+// Request handlers.
+
+std::string HandleSimulate(LoadedGame* entry, std::uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::unique_ptr<State> state = entry->game->NewInitialState();
+  while (!state->IsTerminal()) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(open_spiel::SampleChanceOutcome(
+          state->ChanceOutcomes(),
+          std::uniform_real_distribution<double>(0.0, 1.0)(rng)));
+    } else {
+      std::vector<Action> actions = state->LegalActions();
+      state->ApplyAction(actions[std::uniform_int_distribution<int>(
+          0, actions.size() - 1)(rng)]);
+    }
+  }
+  std::vector<double> returns = state->Returns();
+  std::string response;
+  Append(&response, kStatusOk);
+  Append(&response, static_cast<std::uint32_t>(returns.size()));
+  for (double value : returns) Append(&response, value);
+  return response;
+}
+
+std::string HandleEvaluate(LoadedGame* entry, std::uint32_t iterations) {
+  const Game& game = *entry->game;
+  if (game.GetType().dynamics != open_spiel::GameType::Dynamics::kSequential) {
+    return ErrorResponse("evaluate requires a turn-based game");
+  }
+  if (entry->cfr == nullptr) {
+    entry->cfr.reset(new open_spiel::algorithms::CFRSolver(game));
+    entry->exploitability.reset(
+        new open_spiel::algorithms::ExploitabilityEvaluator(game));
+  }
+  for (std::uint32_t i = 0; i < iterations; ++i) {
+    entry->cfr->EvaluateAndUpdatePolicy();
+  }
+  entry->cfr_iterations += iterations;
+  const double nash_conv =
+      entry->exploitability->NashConv(*entry->cfr->AveragePolicy());
+  std::string response;
+  Append(&response, kStatusOk);
+  Append(&response, static_cast<std::uint32_t>(entry->cfr_iterations));
+  Append(&response, nash_conv);
+  return response;
+}
+
+std::string HandleSearch(LoadedGame* entry, std::uint32_t max_search_nodes,
+                         const std::vector<Action>& actions) {
+  const Game& game = *entry->game;
+  if (game.NumPlayers() > 2 ||
+      (game.NumPlayers() == 2 &&
+       game.GetType().utility != open_spiel::GameType::Utility::kZeroSum)) {
+    return ErrorResponse("search requires a 1- or 2-player zero-sum game");
+  }
+  std::unique_ptr<State> state = game.NewInitialState();
+  for (Action action : actions) {
+    std::vector<Action> legal = state->LegalActions();
+    if (std::find(legal.begin(), legal.end(), action) == legal.end()) {
+      return ErrorResponse("illegal action in search request");
+    }
+    state->ApplyAction(action);
+  }
+  if (state->IsTerminal() || state->IsChanceNode()) {
+    return ErrorResponse("search requires a decision node");
+  }
+  const int player = state->CurrentPlayer();
+  if (entry->rollouts == nullptr) {
+    entry->rollouts.reset(new open_spiel::algorithms::RandomRolloutEvaluator(
+        kRolloutCount, game.GetType().history_independent_state));
+  }
+  std::unique_ptr<open_spiel::algorithms::MCTSBot>& bot = entry->bots[player];
+  if (bot == nullptr) {
+    bot.reset(new open_spiel::algorithms::MCTSBot(
+        game, player, kUctC, max_search_nodes, *entry->rollouts));
+  }
+  const Action best_action = bot->Step(*state).second;
+  std::string response;
+  Append(&response, kStatusOk);
+  Append(&response, static_cast<std::int64_t>(best_action));
+  return response;
+}
+
+// Dispatches one request payload; sets *shutdown on a shutdown request.
+std::string HandleRequest(const std::string& payload,
+                          std::map<std::string, LoadedGame>* games,
+                          bool* shutdown) {
+  std::size_t offset = 0;
+  std::uint8_t opcode, name_len;
+  if (!Parse(payload, &offset, &opcode) || !Parse(payload, &offset, &name_len))
+    return ErrorResponse("truncated request header");
+  if (offset + name_len > payload.size())
+    return ErrorResponse("truncated game name");
+  const std::string name = payload.substr(offset, name_len);
+  offset += name_len;
+
+  if (opcode == kOpShutdown) {
+    *shutdown = true;
+    std::string response;
+    Append(&response, kStatusOk);
+    return response;
+  }
+
+  auto it = games->find(name);
+  if (it == games->end()) return ErrorResponse("game not preloaded: " + name);
+  LoadedGame* entry = &it->second;
+
+  switch (opcode) {
+    case kOpSimulate: {
+      std::uint32_t seed;
+      if (!Parse(payload, &offset, &seed))
+        return ErrorResponse("truncated simulate request");
+      return HandleSimulate(entry, seed);
+    }
+    case kOpEvaluate: {
+      std::uint32_t iterations;
+      if (!Parse(payload, &offset, &iterations))
+        return ErrorResponse("truncated evaluate request");
+      return HandleEvaluate(entry, iterations);
+    }
+    case kOpSearch: {
+      std::uint32_t max_search_nodes, num_actions;
+      if (!Parse(payload, &offset, &max_search_nodes) ||
+          !Parse(payload, &offset, &num_actions))
+        return ErrorResponse("truncated search request");
+      std::vector<Action> actions(num_actions);
+      for (std::uint32_t i = 0; i < num_actions; ++i) {
+        std::int64_t action;
+        if (!Parse(payload, &offset, &action))
+          return ErrorResponse("truncated search request");
+        actions[i] = action;
+      }
+      return HandleSearch(entry, max_search_nodes, actions);
+    }
+    default:
+      return ErrorResponse("unknown opcode");
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Server and self-test client.
+
+int ListenOn(const std::string& socket_path) {
+  int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) open_spiel::SpielFatalError("socket() failed");
+  unlink(socket_path.c_str());
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(addr.sun_path)) {
+    open_spiel::SpielFatalError("Socket path too long: " + socket_path);
+  }
+  std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    open_spiel::SpielFatalError("bind() failed for " + socket_path);
+  }
+  if (listen(listen_fd, 1) != 0) {
+    open_spiel::SpielFatalError("listen() failed for " + socket_path);
+  }
+  return listen_fd;
+}
+
+// Accepts connections one at a time and answers requests until a shutdown
+// request is received and its connection closes.
+void ServeForever(int listen_fd, std::map<std::string, LoadedGame>* games) {
+  bool shutdown = false;
+  while (!shutdown) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) continue;
+    std::string payload;
+    while (ReadFrame(fd, &payload)) {
+      if (!WriteFrame(fd, HandleRequest(payload, games, &shutdown))) break;
+    }
+    close(fd);
+  }
+  close(listen_fd);
+}
+
+// Sends one request frame and returns the response payload.
+std::string RoundTrip(int fd, const std::string& request) {
+  if (!WriteFrame(fd, request)) {
+    open_spiel::SpielFatalError("Self-test write failed");
+  }
+  std::string response;
+  if (!ReadFrame(fd, &response)) {
+    open_spiel::SpielFatalError("Self-test read failed");
+  }
+  return response;
+}
+
+std::string RequestHeader(std::uint8_t opcode, const std::string& game_name) {
+  std::string request;
+  Append(&request, opcode);
+  Append(&request, static_cast<std::uint8_t>(game_name.size()));
+  request += game_name;
+  return request;
+}
+
+// Exercises every opcode against a server on the given socket; fatal on any
+// mismatch.
+void RunSelfTest(const std::string& socket_path) {
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  SPIEL_CHECK_GE(fd, 0);
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+  SPIEL_CHECK_EQ(
+      connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+
+  // Simulate: a tic_tac_toe playout returns two opposite-signed (or zero)
+  // returns.
+  {
+    std::string request = RequestHeader(kOpSimulate, "tic_tac_toe");
+    Append(&request, static_cast<std::uint32_t>(42));
+    std::string response = RoundTrip(fd, request);
+    std::size_t offset = 0;
+    std::uint8_t status;
+    std::uint32_t num_players;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &status));
+    SPIEL_CHECK_EQ(status, kStatusOk);
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &num_players));
+    SPIEL_CHECK_EQ(num_players, 2);
+    double p0, p1;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &p0));
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &p1));
+    SPIEL_CHECK_EQ(p0, -p1);
+  }
+
+  // Evaluate: two requests accumulate iterations on the same solver and
+  // NashConv keeps falling.
+  double first_nash_conv = 0;
+  for (int round = 1; round <= 2; ++round) {
+    std::string request = RequestHeader(kOpEvaluate, "kuhn_poker");
+    Append(&request, static_cast<std::uint32_t>(20));
+    std::string response = RoundTrip(fd, request);
+    std::size_t offset = 0;
+    std::uint8_t status;
+    std::uint32_t total_iterations;
+    double nash_conv;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &status));
+    SPIEL_CHECK_EQ(status, kStatusOk);
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &total_iterations));
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &nash_conv));
+    SPIEL_CHECK_EQ(total_iterations, 20 * round);
+    SPIEL_CHECK_GT(nash_conv, 0);
+    if (round == 1) {
+      first_nash_conv = nash_conv;
+    } else {
+      SPIEL_CHECK_LT(nash_conv, first_nash_conv);
+    }
+  }
+
+  // Search: from the empty board every cell is playable; the chosen action
+  // must be one of them.
+  {
+    std::string request = RequestHeader(kOpSearch, "tic_tac_toe");
+    Append(&request, static_cast<std::uint32_t>(1000));
+    Append(&request, static_cast<std::uint32_t>(0));
+    std::string response = RoundTrip(fd, request);
+    std::size_t offset = 0;
+    std::uint8_t status;
+    std::int64_t best_action;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &status));
+    SPIEL_CHECK_EQ(status, kStatusOk);
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &best_action));
+    SPIEL_CHECK_GE(best_action, 0);
+    SPIEL_CHECK_LT(best_action, 9);
+  }
+
+  // An unknown game is refused without killing the connection.
+  {
+    std::string request = RequestHeader(kOpSimulate, "no_such_game");
+    Append(&request, static_cast<std::uint32_t>(0));
+    std::string response = RoundTrip(fd, request);
+    std::size_t offset = 0;
+    std::uint8_t status;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &status));
+    SPIEL_CHECK_EQ(status, kStatusError);
+  }
+
+  // Shutdown.
+  {
+    std::string response = RoundTrip(fd, RequestHeader(kOpShutdown, ""));
+    std::size_t offset = 0;
+    std::uint8_t status;
+    SPIEL_CHECK_TRUE(Parse(response, &offset, &status));
+    SPIEL_CHECK_EQ(status, kStatusOk);
+  }
+  close(fd);
+  std::cerr << "Self-test passed" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string games_arg = open_spiel::ParseCmdLineArgDefault(
+      argc, argv, "games", "tic_tac_toe,kuhn_poker");
+  const std::string socket_path = open_spiel::ParseCmdLineArgDefault(
+      argc, argv, "socket", "/tmp/open_spiel_daemon.sock");
+  const bool selftest =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "selftest", "false") ==
+      "true";
+
+  std::map<std::string, LoadedGame> games =
+      PreloadGames(SplitCsv(games_arg));
+  if (games.empty()) {
+    open_spiel::SpielFatalError("No games given in --games");
+  }
+
+  // Bind before serving (and before the self-test client connects).
+  int listen_fd = ListenOn(socket_path);
+  std::cerr << "Serving " << games.size() << " game(s) on " << socket_path
+            << std::endl;
+
+  if (selftest) {
+    std::thread server(
+        [listen_fd, &games]() { ServeForever(listen_fd, &games); });
+    RunSelfTest(socket_path);
+    server.join();
+  } else {
+    ServeForever(listen_fd, &games);
+  }
+  unlink(socket_path.c_str());
+}
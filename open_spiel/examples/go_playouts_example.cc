@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Playout-counting driver for the go board: runs uniformly random playouts
+// directly on GoBoard (no State wrapper) and reports playouts and moves per
+// second. This measures the legality checking and stone/chain bookkeeping
+// that dominate go move generation, the counterpart of the chess perft
+// driver for movegen optimization work.
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "open_spiel/games/go/go_board.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace {
+
+using open_spiel::go::BoardPoints;
+using open_spiel::go::GoBoard;
+using open_spiel::go::GoColor;
+using open_spiel::go::GoPoint;
+using open_spiel::go::OppColor;
+
+// One random playout: each turn plays a uniformly random legal point, or
+// passes when none is legal. Ends after two consecutive passes or when the
+// move cap (twice the number of points) is reached, as in the go game
+// wrapper. Returns the number of moves played.
+int64_t RandomPlayout(GoBoard* board, int board_size, std::mt19937* rng) {
+  const std::vector<GoPoint>& points = BoardPoints(board_size);
+  const int64_t max_moves = 2 * board_size * board_size;
+  GoColor to_play = GoColor::kBlack;
+  int consecutive_passes = 0;
+  int64_t moves = 0;
+  std::vector<GoPoint> candidates;
+  while (consecutive_passes < 2 && moves < max_moves) {
+    candidates.clear();
+    for (GoPoint p : points) {
+      if (board->IsLegalMove(p, to_play)) candidates.push_back(p);
+    }
+    if (candidates.empty()) {
+      ++consecutive_passes;
+    } else {
+      consecutive_passes = 0;
+      std::uniform_int_distribution<int> dist(0, candidates.size() - 1);
+      board->PlayMove(candidates[dist(*rng)], to_play);
+    }
+    ++moves;
+    to_play = OppColor(to_play);
+  }
+  return moves;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int board_size = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "board_size", "9"));
+  const int64_t playouts = std::stoll(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "playouts", "1000"));
+  const int seed = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "seed", "1234"));
+
+  std::mt19937 rng(seed);
+  GoBoard board(board_size);
+  int64_t moves = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t playout = 0; playout < playouts; ++playout) {
+    board.Clear();
+    moves += RandomPlayout(&board, board_size, &rng);
+  }
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  std::cout << playouts << " playouts, " << moves << " moves in " << seconds
+            << "s" << std::endl;
+  if (seconds > 0) {
+    std::cout << static_cast<int64_t>(playouts / seconds) << " playouts/sec, "
+              << static_cast<int64_t>(moves / seconds) << " moves/sec"
+              << std::endl;
+  }
+}
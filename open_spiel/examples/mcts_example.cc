@@ -50,7 +50,8 @@ int main(int argc, char** argv) {
   }
 
   // Create MCTS Bot
-  open_spiel::algorithms::RandomRolloutEvaluator evaluator(rollout_count);
+  open_spiel::algorithms::RandomRolloutEvaluator evaluator(
+      rollout_count, game->GetType().history_independent_state);
   open_spiel::algorithms::MCTSBot mcts_bot(*game, mcts_player, uct_c,
                                            max_search_nodes, evaluator);
 
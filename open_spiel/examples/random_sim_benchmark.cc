@@ -0,0 +1,58 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+
+// Soak-tests and benchmarks a game with parallel random simulations.
+// --mode=full runs the per-step invariant checks (a correctness soak);
+// --mode=fast applies sampled actions only, giving a stable
+// simulation-speed number for the game. --coverage=true additionally
+// estimates how many distinct states and information states the run
+// touched, showing how much of the budget revisits known positions.
+int main(int argc, char** argv) {
+  std::string game_name =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "game", "tic_tac_toe");
+  int num_sims = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "num_sims", "1000"));
+  int num_threads = std::stoi(
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "num_threads", "4"));
+  std::string mode =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "mode", "full");
+  int seed =
+      std::stoi(open_spiel::ParseCmdLineArgDefault(argc, argv, "seed", "0"));
+  bool track_coverage =
+      open_spiel::ParseCmdLineArgDefault(argc, argv, "coverage", "false") ==
+      "true";
+
+  open_spiel::testing::SimCheckMode check_mode;
+  if (mode == "full") {
+    check_mode = open_spiel::testing::SimCheckMode::kFullChecks;
+  } else if (mode == "fast") {
+    check_mode = open_spiel::testing::SimCheckMode::kFastSim;
+  } else {
+    open_spiel::SpielFatalError(
+        absl::StrCat("Unknown mode (want full or fast): ", mode));
+  }
+
+  std::unique_ptr<open_spiel::Game> game = open_spiel::LoadGame(game_name);
+  open_spiel::testing::SimCoverageTracker coverage;
+  open_spiel::testing::ParallelRandomSimTest(
+      *game, num_sims, num_threads, check_mode, seed,
+      track_coverage ? &coverage : nullptr);
+}
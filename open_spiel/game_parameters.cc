@@ -23,7 +23,8 @@ std::string GameParameter::ToReprString() const {
     case Type::kInt:
       return absl::StrCat("GameParameter(int_value=", int_value(), ")");
     case Type::kDouble:
-      return absl::StrCat("GameParameter(double_value=", double_value(), ")");
+      return absl::StrCat("GameParameter(double_value=",
+                          FormatDouble(double_value()), ")");
     case Type::kString:
       return absl::StrCat("GameParameter(string_value='", string_value(), "')");
     case Type::kBool:
@@ -45,7 +46,9 @@ std::string GameParameter::ToString() const {
     case Type::kInt:
       return absl::StrCat(int_value());
     case Type::kDouble:
-      return absl::StrCat(double_value());
+      // Shortest round-trip form, so a double parameter survives the
+      // ToString / GameParametersFromString round trip exactly.
+      return FormatDouble(double_value());
     case Type::kString:
       return string_value();
     case Type::kBool:
@@ -78,6 +81,94 @@ inline std::string GameParametersToString(const GameParameters& game_params) {
   return str;
 }
 
+bool operator==(const GameParameter& a, const GameParameter& b) {
+  if (a.type() != b.type()) return false;
+  switch (a.type()) {
+    case GameParameter::Type::kUnset:
+      return true;
+    case GameParameter::Type::kInt:
+      return a.int_value() == b.int_value();
+    case GameParameter::Type::kDouble:
+      return a.double_value() == b.double_value();
+    case GameParameter::Type::kString:
+      return a.string_value() == b.string_value();
+    case GameParameter::Type::kBool:
+      return a.bool_value() == b.bool_value();
+    case GameParameter::Type::kGame:
+      return a.game_value() == b.game_value();
+    default:
+      SpielFatalError("Unknown type.");
+      return false;
+  }
+}
+
+namespace {
+
+// 64-bit FNV-1a, streamed over the parameter contents.
+constexpr uint64_t kDigestOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kDigestPrime = 0x100000001b3ULL;
+
+uint64_t DigestBytes(const void* data, std::size_t size, uint64_t digest) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    digest = (digest ^ bytes[i]) * kDigestPrime;
+  }
+  return digest;
+}
+
+uint64_t DigestString(const std::string& value, uint64_t digest) {
+  // Length first, so adjacent strings cannot alias each other's bytes.
+  const uint64_t length = value.size();
+  digest = DigestBytes(&length, sizeof(length), digest);
+  return DigestBytes(value.data(), value.size(), digest);
+}
+
+uint64_t DigestParameters(const GameParameters& params, uint64_t digest);
+
+uint64_t DigestParameter(const GameParameter& param, uint64_t digest) {
+  const char type = static_cast<char>(param.type());
+  digest = DigestBytes(&type, sizeof(type), digest);
+  switch (param.type()) {
+    case GameParameter::Type::kUnset:
+      return digest;
+    case GameParameter::Type::kInt: {
+      const int value = param.int_value();
+      return DigestBytes(&value, sizeof(value), digest);
+    }
+    case GameParameter::Type::kDouble: {
+      const double value = param.double_value();
+      return DigestBytes(&value, sizeof(value), digest);
+    }
+    case GameParameter::Type::kString:
+      return DigestString(param.string_value(), digest);
+    case GameParameter::Type::kBool: {
+      const char value = param.bool_value() ? 1 : 0;
+      return DigestBytes(&value, sizeof(value), digest);
+    }
+    case GameParameter::Type::kGame:
+      return DigestParameters(param.game_value(), digest);
+    default:
+      SpielFatalError("Unknown type.");
+      return digest;
+  }
+}
+
+uint64_t DigestParameters(const GameParameters& params, uint64_t digest) {
+  const uint64_t size = params.size();
+  digest = DigestBytes(&size, sizeof(size), digest);
+  for (const auto& key_val : params) {
+    digest = DigestString(key_val.first, digest);
+    digest = DigestParameter(key_val.second, digest);
+  }
+  return digest;
+}
+
+}  // namespace
+
+uint64_t GameParametersDigest(const GameParameters& params) {
+  return DigestParameters(params, kDigestOffsetBasis);
+}
+
 GameParameter GameParameterFromString(const std::string& str) {
   if (str == "True" || str == "true")
     return GameParameter(true);
@@ -85,7 +176,10 @@ GameParameter GameParameterFromString(const std::string& str) {
     return GameParameter(false);
   else if (str.find_first_not_of("+-0123456789") == std::string::npos)
     return GameParameter(stoi(str));
-  else if (str.find_first_not_of("+-0123456789.") == std::string::npos)
+  else if (str.find_first_not_of("+-0123456789.eE") == std::string::npos &&
+           str.find_first_of("0123456789") != std::string::npos)
+    // The exponent characters admit the scientific forms that the shortest
+    // round-trip formatting in GameParameter::ToString can produce.
     return GameParameter(stod(str));
   else if (str.back() == ')')
     return GameParameter(GameParametersFromString(str));
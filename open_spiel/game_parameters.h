@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAME_PARAMETERS_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAME_PARAMETERS_H_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -28,6 +29,11 @@ using GameParameters = std::map<std::string, GameParameter>;
 std::string GameParametersToString(const GameParameters& game_params);
 GameParameters GameParametersFromString(const std::string& game_string);
 
+// Parses one parameter value as produced by GameParameter::ToString:
+// booleans, ints, doubles (including the scientific forms of shortest
+// round-trip formatting), nested game strings, and otherwise strings.
+GameParameter GameParameterFromString(const std::string& str);
+
 class GameParameter {
  public:
   enum class Type { kUnset = -1, kInt, kDouble, kString, kBool, kGame };
@@ -96,6 +102,19 @@ class GameParameter {
   Type type_;
 };
 
+// Type-aware equality: two parameters are equal when they hold the same
+// type and the same value of that type.
+bool operator==(const GameParameter& a, const GameParameter& b);
+inline bool operator!=(const GameParameter& a, const GameParameter& b) {
+  return !(a == b);
+}
+
+// A 64-bit digest of a parameter map, covering the keys, the parameter
+// types, and the values (recursively for game-valued parameters). The map
+// is sorted, so equal maps always digest equally without first building
+// the canonical parameter string; LoadGameCached keys its cache on this.
+uint64_t GameParametersDigest(const GameParameters& params);
+
 inline bool IsParameterSpecified(const GameParameters& table,
                                  const std::string& key) {
   return table.find(key) != table.end();
@@ -40,6 +40,10 @@ class WrappedState : public State {
     return state_->LegalActions();
   }
 
+  const std::vector<Action>* StaticLegalActions() const override {
+    return state_->StaticLegalActions();
+  }
+
   std::string ActionToString(int player, Action action_id) const override {
     return state_->ActionToString(player, action_id);
   }
@@ -70,6 +74,11 @@ class WrappedState : public State {
     state_->ObservationAsNormalizedVector(player, values);
   }
 
+  // StepOutputs is deliberately not forwarded to the wrapped state: the
+  // base default dispatches through Rewards() and the observation methods,
+  // which individual wrappers override (misere negates rewards), so the
+  // fused call stays consistent with the wrapper's view of the game.
+
   virtual std::unique_ptr<State> Clone() const = 0;
 
   virtual void UndoAction(int player, Action action) {
@@ -0,0 +1,152 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/game_transforms/infostate_abstraction.h"
+
+#include <unordered_set>
+#include <utility>
+
+namespace open_spiel {
+namespace {
+
+// Placeholder for game registration; the instantiated game carries the
+// wrapped game's actual type. Registration exists so that serialized
+// abstracted games can be reloaded: a bucketing function cannot be
+// expressed as a string parameter, so LoadGame("abstracted(game=...)")
+// yields the identity abstraction (every information state is its own
+// bucket). Real abstractions are built with MakeAbstractedGame.
+const GameType kGameType{
+    /*short_name=*/"abstracted",
+    /*long_name=*/"Abstracted Version of a Game",
+    GameType::Dynamics::kSequential,
+    GameType::ChanceMode::kSampledStochastic,
+    GameType::Information::kImperfectInformation,
+    GameType::Utility::kGeneralSum,
+    GameType::RewardModel::kRewards,
+    /*max_num_players=*/100,
+    /*min_num_players=*/1,
+    /*provides_information_state=*/true,
+    /*provides_information_state_as_normalized_vector=*/false,
+    /*provides_observation=*/true,
+    /*provides_observation_as_normalized_vector=*/true,
+    /*parameter_specification=*/
+    {{"game", {GameParameter::Type::kGame, true}}}};
+
+std::unique_ptr<Game> Factory(const GameParameters& params) {
+  InfoStateBucketer identity = [](int player, const std::string& info_state) {
+    return info_state;
+  };
+  // The identity mapping needs no precomputed table.
+  return MakeAbstractedGame(LoadGame(params.at("game").game_value()),
+                            std::move(identity),
+                            /*precompute_table=*/false);
+}
+
+REGISTER_SPIEL_GAME(kGameType, Factory);
+
+GameType AbstractedGameType(GameType game_type) {
+  game_type.short_name = "abstracted";
+  game_type.long_name = absl::StrCat("Abstracted ", game_type.long_name);
+  // Bucketed sets merge states a player could previously tell apart.
+  game_type.information = GameType::Information::kImperfectInformation;
+  game_type.provides_information_state = true;
+  game_type.provides_information_state_as_normalized_vector = false;
+  game_type.provides_undo = false;
+  game_type.provides_hash_value = false;
+  game_type.history_independent_state = false;
+  game_type.provides_quick_evaluate = false;
+  game_type.provides_canonical_key = false;
+  game_type.state_independent_actions = false;
+  return game_type;
+}
+
+}  // namespace
+
+AbstractedState::AbstractedState(
+    std::unique_ptr<State> state,
+    std::shared_ptr<const InfoStateBucketTable> table,
+    std::shared_ptr<const InfoStateBucketer> bucketer)
+    : WrappedState(std::move(state)),
+      table_(std::move(table)),
+      bucketer_(std::move(bucketer)) {}
+
+std::string AbstractedState::InformationState(int player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  const std::string raw = state_->InformationState(player);
+  if (table_ != nullptr) {
+    auto iter = (*table_)[player].find(raw);
+    if (iter != (*table_)[player].end()) return iter->second;
+  }
+  return (*bucketer_)(player, raw);
+}
+
+std::unique_ptr<State> AbstractedState::Clone() const {
+  return std::unique_ptr<State>(new AbstractedState(*this));
+}
+
+AbstractedGame::AbstractedGame(std::unique_ptr<Game> game, GameType game_type,
+                               GameParameters game_parameters,
+                               InfoStateBucketer bucketer,
+                               bool precompute_table)
+    : WrappedGame(std::move(game), game_type, game_parameters),
+      bucketer_(
+          std::make_shared<const InfoStateBucketer>(std::move(bucketer))) {
+  if (precompute_table) PrecomputeBucketTable();
+}
+
+void AbstractedGame::PrecomputeBucketTable() {
+  auto table = std::make_shared<InfoStateBucketTable>(game_->NumPlayers());
+  std::unordered_set<std::string> visited;
+  std::vector<std::unique_ptr<State>> to_visit;
+  to_visit.push_back(game_->NewInitialState());
+  while (!to_visit.empty()) {
+    std::unique_ptr<State> state = std::move(to_visit.back());
+    to_visit.pop_back();
+    if (state->IsTerminal()) continue;
+    if (!visited.insert(state->ToString()).second) continue;
+    if (!state->IsChanceNode()) {
+      const int player = state->CurrentPlayer();
+      const std::string raw = state->InformationState(player);
+      auto& player_table = (*table)[player];
+      if (player_table.find(raw) == player_table.end()) {
+        player_table.emplace(raw, (*bucketer_)(player, raw));
+      }
+    }
+    for (Action action : state->LegalActions()) {
+      to_visit.push_back(state->Child(action));
+    }
+  }
+  table_ = std::move(table);
+}
+
+std::unique_ptr<Game> MakeAbstractedGame(std::unique_ptr<Game> game,
+                                         InfoStateBucketer bucketer,
+                                         bool precompute_table) {
+  if (game->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("MakeAbstractedGame requires a sequential game.");
+  }
+  GameType game_type = AbstractedGameType(game->GetType());
+  // Record the wrapped game so Game::ToString() round-trips through
+  // LoadGame (e.g. via SerializeGameAndState); see the registration note
+  // above on what reloading restores.
+  GameParameters wrapped_params = game->GetParameters();
+  wrapped_params["name"] = GameParameter(game->GetType().short_name);
+  GameParameters params{{"game", GameParameter{wrapped_params}}};
+  return std::unique_ptr<Game>(
+      new AbstractedGame(std::move(game), game_type, params,
+                         std::move(bucketer), precompute_table));
+}
+
+}  // namespace open_spiel
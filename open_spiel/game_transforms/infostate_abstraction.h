@@ -0,0 +1,126 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_INFOSTATE_ABSTRACTION_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_INFOSTATE_ABSTRACTION_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/game_transforms/game_wrapper.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Information-state abstraction as a game transform: InformationState() is
+// mapped through a user-supplied bucketing function, so states the bucketer
+// merges become one information set. Tabular solvers run on the wrapped game
+// then operate on the bucketed sets — CFR on a card-abstracted poker game
+// solves a fraction of the original infoset count — without any
+// solver-side support. The abstraction is in general imperfect recall;
+// bucketed sets must still agree on their legal actions, which the bucketer
+// is responsible for (merging sets with different action sets corrupts any
+// tabular solver's entries).
+//
+// By default the bucketer is evaluated once per reachable information state
+// at construction and the mapping is served from a precomputed hash table,
+// so per-lookup cost is one probe regardless of how expensive the bucketing
+// is. Build instances with MakeAbstractedGame: a bucketing function cannot
+// be expressed as a string parameter, so the "abstracted" LoadGame
+// registration (which exists so serialized games round-trip through
+// DeserializeGameAndState) reconstructs the game and state but with the
+// identity bucketing only.
+//
+// The normalized information state vector is not provided: there is no
+// generic tensor for a bucketed string. The transformed game type reports
+// provides_information_state_as_normalized_vector = false.
+
+namespace open_spiel {
+
+// Maps a player's raw information state string to its bucket. Must be
+// deterministic.
+using InfoStateBucketer =
+    std::function<std::string(int player, const std::string& info_state)>;
+
+// One table per player, raw information state -> bucket.
+using InfoStateBucketTable =
+    std::vector<std::unordered_map<std::string, std::string>>;
+
+class AbstractedState : public WrappedState {
+ public:
+  AbstractedState(std::unique_ptr<State> state,
+                  std::shared_ptr<const InfoStateBucketTable> table,
+                  std::shared_ptr<const InfoStateBucketer> bucketer);
+  AbstractedState(const AbstractedState& other) = default;
+
+  // The bucket of the wrapped information state: a table probe when the
+  // state was covered by the precomputed table, a bucketer call otherwise.
+  std::string InformationState(int player) const override;
+
+  void InformationStateAsNormalizedVector(
+      int player, std::vector<double>* values) const override {
+    SpielFatalError(
+        "InformationStateAsNormalizedVector is not supported for "
+        "abstracted games; use the string form.");
+  }
+
+  std::unique_ptr<State> Clone() const override;
+
+ private:
+  std::shared_ptr<const InfoStateBucketTable> table_;  // May be null.
+  std::shared_ptr<const InfoStateBucketer> bucketer_;
+};
+
+class AbstractedGame : public WrappedGame {
+ public:
+  AbstractedGame(std::unique_ptr<Game> game, GameType game_type,
+                 GameParameters game_parameters, InfoStateBucketer bucketer,
+                 bool precompute_table);
+  AbstractedGame(const AbstractedGame& other) = default;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    return std::unique_ptr<State>(
+        new AbstractedState(game_->NewInitialState(), table_, bucketer_));
+  }
+
+  std::unique_ptr<Game> Clone() const override {
+    return std::unique_ptr<Game>(new AbstractedGame(*this));
+  }
+
+  double MinUtility() const override { return game_->MinUtility(); }
+  double MaxUtility() const override { return game_->MaxUtility(); }
+
+ private:
+  // Walks every reachable state once and buckets each decision state's
+  // information state, filling table_.
+  void PrecomputeBucketTable();
+
+  std::shared_ptr<const InfoStateBucketer> bucketer_;
+  std::shared_ptr<const InfoStateBucketTable> table_;  // Null if disabled.
+};
+
+// Wraps the game with the bucketing function. With precompute_table set
+// (the default), the whole game tree is walked once at construction to
+// build the lookup table — suited to games small enough for tabular
+// solving, which is the transform's use case; disable it to call the
+// bucketer lazily on games too big to enumerate.
+std::unique_ptr<Game> MakeAbstractedGame(std::unique_ptr<Game> game,
+                                         InfoStateBucketer bucketer,
+                                         bool precompute_table = true);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_INFOSTATE_ABSTRACTION_H_
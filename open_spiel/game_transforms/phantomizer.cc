@@ -0,0 +1,215 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/game_transforms/phantomizer.h"
+
+#include <memory>
+#include <utility>
+
+namespace open_spiel {
+namespace {
+
+// These parameters describe the transformed game; the information is
+// imperfect by construction regardless of the wrapped game.
+const GameType kGameType{
+    /*short_name=*/"phantom",
+    /*long_name=*/"Phantom Version of a Perfect-Information Game",
+    GameType::Dynamics::kSequential,
+    GameType::ChanceMode::kDeterministic,
+    GameType::Information::kImperfectInformation,
+    GameType::Utility::kGeneralSum,
+    GameType::RewardModel::kTerminal,
+    /*max_num_players=*/100,
+    /*min_num_players=*/1,
+    /*provides_information_state=*/true,
+    /*provides_information_state_as_normalized_vector=*/true,
+    /*provides_observation=*/true,
+    /*provides_observation_as_normalized_vector=*/true,
+    /*parameter_specification=*/
+    {{"game", {GameParameter::Type::kGame, true}},
+     {"obstype", {GameParameter::Type::kString, false}}}};
+
+GameType PhantomizedGameType(GameType game_type) {
+  game_type.short_name = kGameType.short_name;
+  game_type.long_name = absl::StrCat("Phantom ", game_type.long_name);
+  game_type.information = GameType::Information::kImperfectInformation;
+  game_type.provides_information_state = true;
+  game_type.provides_information_state_as_normalized_vector = true;
+  // The wrapper does not implement undo, and the wrapped game's remaining
+  // capabilities do not carry over to the transformed tree.
+  game_type.provides_undo = false;
+  game_type.provides_hash_value = false;
+  game_type.history_independent_state = false;
+  game_type.provides_quick_evaluate = false;
+  game_type.provides_canonical_key = false;
+  game_type.state_independent_actions = false;
+  return game_type;
+}
+
+std::unique_ptr<Game> Factory(const GameParameters& params) {
+  std::unique_ptr<Game> game = LoadGame(params.at("game").game_value());
+  const GameType& type = game->GetType();
+  if (type.dynamics != GameType::Dynamics::kSequential ||
+      type.chance_mode != GameType::ChanceMode::kDeterministic ||
+      type.information != GameType::Information::kPerfectInformation) {
+    SpielFatalError(
+        "phantom requires a sequential, deterministic, perfect-information "
+        "game.");
+  }
+
+  const std::string obs_type_str = params.count("obstype") > 0
+                                       ? params.at("obstype").string_value()
+                                       : "reveal-nothing";
+  PhantomObservationType obs_type;
+  if (obs_type_str == "reveal-nothing") {
+    obs_type = PhantomObservationType::kRevealNothing;
+  } else if (obs_type_str == "reveal-numturns") {
+    obs_type = PhantomObservationType::kRevealNumTurns;
+  } else {
+    SpielFatalError(
+        absl::StrCat("Unrecognized observation type: ", obs_type_str));
+  }
+
+  GameType game_type = PhantomizedGameType(game->GetType());
+  return std::unique_ptr<Game>(
+      new PhantomizedGame(std::move(game), game_type, params, obs_type));
+}
+
+REGISTER_SPIEL_GAME(kGameType, Factory);
+
+}  // namespace
+
+PhantomizedState::PhantomizedState(
+    std::unique_ptr<State> state,
+    std::shared_ptr<const std::vector<Action>> candidates,
+    PhantomObservationType obs_type, int max_attempts)
+    : WrappedState(std::move(state)),
+      candidates_(std::move(candidates)),
+      obs_type_(obs_type),
+      max_attempts_(max_attempts),
+      known_mask_(num_players_, std::vector<int>(num_distinct_actions_, 0)) {
+  RebuildRealLegalMask();
+}
+
+void PhantomizedState::RebuildRealLegalMask() {
+  real_legal_mask_ = state_->LegalActionsMask();
+}
+
+void PhantomizedState::DoApplyAction(Action action) {
+  const int mover = state_->CurrentPlayer();
+  std::vector<int>& known = known_mask_[mover];
+  if (real_legal_mask_[action] == 1) {
+    state_->ApplyAction(action);
+    known[action] = 1;
+    RebuildRealLegalMask();
+    sequence_.push_back({mover, action, /*success=*/true});
+  } else {
+    // The referee rejects the move; the mover learns this and stays on
+    // move. A known action is only offered while it would succeed, so a
+    // rejected one cannot have been marked already.
+    SPIEL_CHECK_EQ(known[action], 0);
+    known[action] = 1;
+    sequence_.push_back({mover, action, /*success=*/false});
+  }
+}
+
+std::vector<Action> PhantomizedState::LegalActions() const {
+  if (IsTerminal()) return {};
+  const std::vector<int>& known = known_mask_[state_->CurrentPlayer()];
+  std::vector<Action> actions;
+  actions.reserve(candidates_->size());
+  for (Action action : *candidates_) {
+    if (known[action] == 0 || real_legal_mask_[action] == 1) {
+      actions.push_back(action);
+    }
+  }
+  return actions;
+}
+
+std::string PhantomizedState::ToString() const {
+  std::string str = state_->ToString();
+  // The trailing failures all belong to the player currently on move.
+  size_t turn_start = sequence_.size();
+  while (turn_start > 0 && !sequence_[turn_start - 1].success) --turn_start;
+  if (turn_start < sequence_.size()) {
+    absl::StrAppend(&str, "\nFailed attempts:");
+    for (size_t i = turn_start; i < sequence_.size(); ++i) {
+      absl::StrAppend(&str, " ", sequence_[i].action);
+    }
+  }
+  return str;
+}
+
+std::string PhantomizedState::InformationState(int player) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  std::string str;
+  for (const Attempt& attempt : sequence_) {
+    if (attempt.player == player) {
+      absl::StrAppend(&str, attempt.player, ",", attempt.action);
+      if (!attempt.success) absl::StrAppend(&str, ",f");
+      str.push_back(' ');
+    } else if (obs_type_ == PhantomObservationType::kRevealNumTurns) {
+      absl::StrAppend(&str, attempt.player, ",? ");
+    }
+  }
+  return str;
+}
+
+void PhantomizedState::InformationStateAsNormalizedVector(
+    int player, std::vector<double>* values) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  // One row per visible attempt: the acting player, a failure bit, and a
+  // one-hot action with a trailing "unknown" slot for hidden opponent
+  // moves. Hidden attempts under reveal-nothing occupy no row, so the
+  // encoding reveals exactly what the string form does.
+  const int bits_per_attempt = 2 + num_distinct_actions_ + 1;
+  values->assign(bits_per_attempt * max_attempts_, 0.);
+  int offset = 0;
+  for (const Attempt& attempt : sequence_) {
+    if (attempt.player == player) {
+      (*values)[offset] = attempt.player;
+      (*values)[offset + 1] = attempt.success ? 0.0 : 1.0;
+      (*values)[offset + 2 + attempt.action] = 1.0;
+    } else if (obs_type_ == PhantomObservationType::kRevealNumTurns) {
+      (*values)[offset] = attempt.player;
+      (*values)[offset + 2 + num_distinct_actions_] = 1.0;  // Unknown.
+    } else {
+      continue;  // Hidden attempt: no row.
+    }
+    offset += bits_per_attempt;
+  }
+}
+
+std::unique_ptr<State> PhantomizedState::Clone() const {
+  return std::unique_ptr<State>(new PhantomizedState(*this));
+}
+
+PhantomizedGame::PhantomizedGame(std::unique_ptr<Game> game,
+                                 GameType game_type,
+                                 GameParameters game_parameters,
+                                 PhantomObservationType obs_type)
+    : WrappedGame(std::move(game), game_type, game_parameters),
+      obs_type_(obs_type),
+      candidates_(std::make_shared<const std::vector<Action>>(
+          game_->PossibleDistinctActions())) {}
+
+std::vector<int> PhantomizedGame::InformationStateNormalizedVectorShape()
+    const {
+  return {1, MaxGameLength() * (2 + NumDistinctActions() + 1)};
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,152 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_PHANTOMIZER_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_PHANTOMIZER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/game_transforms/game_wrapper.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Transforms a perfect-information game into its phantom version: players do
+// not observe each other's moves, and only a referee (the wrapped state)
+// knows the full position. On their turn a player may try any action they
+// have not already tried this turn; if it is illegal in the true state the
+// referee announces the failure to the mover, who stays on move and tries
+// again. This is the construction behind Kriegspiel and phantom go (see
+// games/phantom_ttt.h for the hand-written tic-tac-toe instance), applied
+// generically: a player's view is their own attempt stream with
+// success/failure marks, maintained in O(1) per move rather than derived
+// from a per-game board model.
+//
+// The wrapped game must be sequential, deterministic and perfect
+// information. As in phantom_ttt, Observation() forwards to the wrapped
+// state and is therefore the referee's view; use InformationState() for the
+// players' imperfect views.
+//
+// Parameters:
+//   "game"     game     The perfect-information game to phantomize (required)
+//   "obstype"  string   "reveal-nothing" (default) or "reveal-numturns"
+
+namespace open_spiel {
+
+enum class PhantomObservationType {
+  kRevealNothing,
+  kRevealNumTurns,
+};
+
+class PhantomizedState : public WrappedState {
+ public:
+  // max_attempts is the transformed game's MaxGameLength, which sizes the
+  // normalized information state vector.
+  PhantomizedState(std::unique_ptr<State> state,
+                   std::shared_ptr<const std::vector<Action>> candidates,
+                   PhantomObservationType obs_type, int max_attempts);
+  PhantomizedState(const PhantomizedState& other) = default;
+
+  // Any candidate action whose outcome the mover does not already know:
+  // their own past moves and the referee's rejections are excluded, as in
+  // phantom_ttt's per-player views. A known action is offered again once it
+  // is legal in the true state (it would then simply succeed), so games
+  // where a move can become playable again are not starved of it.
+  std::vector<Action> LegalActions() const override;
+  std::vector<Action> LegalActions(int player) const {
+    if (player == state_->CurrentPlayer()) return LegalActions();
+    return {};
+  }
+
+  // The referee's view plus the current turn's failed attempts.
+  std::string ToString() const override;
+
+  // The observing player's attempt stream: their own actions with
+  // success/failure marks and, with reveal-numturns, a placeholder per
+  // opponent move.
+  std::string InformationState(int player) const override;
+  void InformationStateAsNormalizedVector(
+      int player, std::vector<double>* values) const override;
+
+  std::unique_ptr<State> Clone() const override;
+
+ protected:
+  void DoApplyAction(Action action) override;
+
+ private:
+  // One attempted move: who tried what, and whether the referee let it
+  // stand.
+  struct Attempt {
+    int player;
+    Action action;
+    bool success;
+  };
+
+  // Recomputes the wrapped state's legal-action mask; called whenever the
+  // wrapped state advances so attempt legality is an O(1) lookup.
+  void RebuildRealLegalMask();
+
+  std::shared_ptr<const std::vector<Action>> candidates_;
+  PhantomObservationType obs_type_;
+  int max_attempts_;
+  std::vector<Attempt> sequence_;
+  std::vector<int> real_legal_mask_;
+  // Per player, the actions whose outcome that player has observed (own
+  // successes and referee rejections); updated in O(1) per attempt.
+  std::vector<std::vector<int>> known_mask_;
+};
+
+class PhantomizedGame : public WrappedGame {
+ public:
+  PhantomizedGame(std::unique_ptr<Game> game, GameType game_type,
+                  GameParameters game_parameters,
+                  PhantomObservationType obs_type);
+  PhantomizedGame(const PhantomizedGame& other) = default;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    return std::unique_ptr<State>(new PhantomizedState(
+        game_->NewInitialState(), candidates_, obs_type_, MaxGameLength()));
+  }
+
+  std::unique_ptr<Game> Clone() const override {
+    return std::unique_ptr<Game>(new PhantomizedGame(*this));
+  }
+
+  // The wrapper does not flip utilities (the WrappedGame defaults exist for
+  // misere).
+  double MinUtility() const override { return game_->MinUtility(); }
+  double MaxUtility() const override { return game_->MaxUtility(); }
+
+  // One row of 2 + NumDistinctActions() + 1 slots per attempt: the acting
+  // player, a failure bit, and a one-hot action with an extra "unknown" slot
+  // for hidden opponent moves under reveal-numturns.
+  std::vector<int> InformationStateNormalizedVectorShape() const override;
+
+  // A rejection marks the (player, action) pair as known, and a known
+  // action is only offered again when it would succeed, so each pair is
+  // rejected at most once over the whole game.
+  int MaxGameLength() const override {
+    return game_->MaxGameLength() +
+           game_->NumPlayers() * static_cast<int>(candidates_->size());
+  }
+
+ private:
+  PhantomObservationType obs_type_;
+  std::shared_ptr<const std::vector<Action>> candidates_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_PHANTOMIZER_H_
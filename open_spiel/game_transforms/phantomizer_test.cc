@@ -0,0 +1,86 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/game_transforms/phantomizer.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "open_spiel/spiel.h"
+#include "open_spiel/tests/basic_tests.h"
+
+namespace open_spiel {
+namespace {
+
+namespace testing = open_spiel::testing;
+
+void BasicPhantomTests() {
+  testing::LoadGameTest("phantom(game=tic_tac_toe())");
+  testing::RandomSimTest(*LoadGame("phantom(game=tic_tac_toe())"), 20);
+  testing::RandomSimTest(
+      *LoadGame("phantom(game=tic_tac_toe(),obstype=reveal-numturns)"), 20);
+  // The point of the transform: phantom variants of games with no
+  // hand-written phantom implementation.
+  testing::RandomSimTest(
+      *LoadGame("phantom(game=breakthrough(rows=6,columns=6))"), 2);
+  testing::RandomSimTest(*LoadGame("phantom(game=hex(board_size=4))"), 2);
+}
+
+// A rejected move keeps the mover on move, removes the action for the rest
+// of the turn, and is revealed only to the mover.
+void FailedMoveTest() {
+  std::unique_ptr<Game> game = LoadGame("phantom(game=tic_tac_toe())");
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  state->ApplyAction(4);  // x takes the centre.
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), 1);
+  SPIEL_CHECK_EQ(state->LegalActions().size(), 9);
+
+  state->ApplyAction(4);  // o tries the centre; the referee rejects it.
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), 1);
+  std::vector<Action> legal = state->LegalActions();
+  SPIEL_CHECK_EQ(legal.size(), 8);
+  SPIEL_CHECK_TRUE(std::find(legal.begin(), legal.end(), 4) == legal.end());
+
+  // o's view records the failure; x's view shows nothing of o's attempt.
+  SPIEL_CHECK_TRUE(state->InformationState(1).find("1,4,f") !=
+                   std::string::npos);
+  SPIEL_CHECK_TRUE(state->InformationState(0).find("1,") ==
+                   std::string::npos);
+
+  state->ApplyAction(0);  // o succeeds elsewhere; x is back on move.
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), 0);
+  SPIEL_CHECK_EQ(state->LegalActions().size(), 8);
+}
+
+// reveal-numturns shows opponents a placeholder per attempt.
+void RevealNumTurnsTest() {
+  std::unique_ptr<Game> game =
+      LoadGame("phantom(game=tic_tac_toe(),obstype=reveal-numturns)");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(4);
+  state->ApplyAction(4);  // Fails.
+  SPIEL_CHECK_TRUE(state->InformationState(0).find("1,?") !=
+                   std::string::npos);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::BasicPhantomTests();
+  open_spiel::FailedMoveTest();
+  open_spiel::RevealNumTurnsTest();
+}
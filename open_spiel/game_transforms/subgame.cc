@@ -0,0 +1,245 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/game_transforms/subgame.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
+
+namespace open_spiel {
+namespace {
+
+// Placeholder for game registration; the instantiated game carries the
+// wrapped game's actual type. Registration lets serialized subgames reload
+// through LoadGame (e.g. via DeserializeGameAndState); a coordinator can
+// also ship a whole subgame to a worker as the one-line game string.
+const GameType kGameType{
+    /*short_name=*/"subgame",
+    /*long_name=*/"Subgame of a Game",
+    GameType::Dynamics::kSequential,
+    GameType::ChanceMode::kExplicitStochastic,
+    GameType::Information::kImperfectInformation,
+    GameType::Utility::kGeneralSum,
+    GameType::RewardModel::kRewards,
+    /*max_num_players=*/100,
+    /*min_num_players=*/1,
+    /*provides_information_state=*/true,
+    /*provides_information_state_as_normalized_vector=*/true,
+    /*provides_observation=*/true,
+    /*provides_observation_as_normalized_vector=*/true,
+    /*parameter_specification=*/
+    {{"game", {GameParameter::Type::kGame, true}},
+     {"roots", {GameParameter::Type::kString, true}}}};
+
+// One "<prob>:<action> <action> ..." entry per root, ';'-separated. The
+// probabilities use FormatDouble's shortest round-trip form so that
+// encode(decode(s)) == s and game strings compare byte-for-byte.
+std::string EncodeRoots(const std::vector<SubgameRoot>& roots) {
+  std::string str;
+  for (const SubgameRoot& root : roots) {
+    if (!str.empty()) str.push_back(';');
+    absl::StrAppend(&str, FormatDouble(root.probability), ":");
+    std::vector<std::string> actions =
+        absl::StrSplit(root.serialized_state, '\n', absl::SkipEmpty());
+    absl::StrAppend(&str, absl::StrJoin(actions, " "));
+  }
+  return str;
+}
+
+std::vector<SubgameRoot> DecodeRoots(const std::string& str) {
+  std::vector<SubgameRoot> roots;
+  for (absl::string_view entry :
+       absl::StrSplit(str, ';', absl::SkipEmpty())) {
+    std::pair<absl::string_view, absl::string_view> parts =
+        absl::StrSplit(entry, absl::MaxSplits(':', 1));
+    SubgameRoot root;
+    if (!absl::SimpleAtod(parts.first, &root.probability)) {
+      SpielFatalError(
+          absl::StrCat("Malformed subgame root probability: ", entry));
+    }
+    std::vector<std::string> actions =
+        absl::StrSplit(parts.second, ' ', absl::SkipEmpty());
+    root.serialized_state = absl::StrJoin(actions, "\n");
+    roots.push_back(root);
+  }
+  return roots;
+}
+
+std::unique_ptr<Game> Factory(const GameParameters& params) {
+  return ExtractSubgame(LoadGame(params.at("game").game_value()),
+                        DecodeRoots(params.at("roots").string_value()));
+}
+
+REGISTER_SPIEL_GAME(kGameType, Factory);
+
+GameType SubgameGameType(GameType game_type) {
+  game_type.short_name = "subgame";
+  game_type.long_name = absl::StrCat("Subgame of ", game_type.long_name);
+  // The root is a chance node even when the base game has no chance.
+  if (game_type.chance_mode == GameType::ChanceMode::kDeterministic) {
+    game_type.chance_mode = GameType::ChanceMode::kExplicitStochastic;
+  }
+  game_type.provides_undo = false;
+  game_type.provides_hash_value = false;
+  game_type.history_independent_state = false;
+  game_type.provides_quick_evaluate = false;
+  game_type.provides_canonical_key = false;
+  game_type.state_independent_actions = false;
+  return game_type;
+}
+
+}  // namespace
+
+SubgameState::SubgameState(
+    std::shared_ptr<const std::vector<std::unique_ptr<State>>> roots,
+    std::shared_ptr<const std::vector<double>> root_probs,
+    int num_distinct_actions, int num_players)
+    : State(num_distinct_actions, num_players),
+      roots_(std::move(roots)),
+      root_probs_(std::move(root_probs)) {}
+
+SubgameState::SubgameState(const SubgameState& other)
+    : State(other),
+      roots_(other.roots_),
+      root_probs_(other.root_probs_),
+      state_(other.state_ == nullptr ? nullptr : other.state_->Clone()) {}
+
+int SubgameState::CurrentPlayer() const {
+  return state_ == nullptr ? kChancePlayerId : state_->CurrentPlayer();
+}
+
+std::vector<Action> SubgameState::LegalActions() const {
+  if (state_ != nullptr) return state_->LegalActions();
+  std::vector<Action> outcomes(roots_->size());
+  for (int i = 0; i < static_cast<int>(roots_->size()); ++i) outcomes[i] = i;
+  return outcomes;
+}
+
+ActionsAndProbs SubgameState::ChanceOutcomes() const {
+  if (state_ != nullptr) return state_->ChanceOutcomes();
+  ActionsAndProbs outcomes;
+  outcomes.reserve(root_probs_->size());
+  for (int i = 0; i < static_cast<int>(root_probs_->size()); ++i) {
+    outcomes.push_back({i, (*root_probs_)[i]});
+  }
+  return outcomes;
+}
+
+void SubgameState::DoApplyAction(Action action_id) {
+  if (state_ == nullptr) {
+    SPIEL_CHECK_GE(action_id, 0);
+    SPIEL_CHECK_LT(action_id, roots_->size());
+    state_ = (*roots_)[action_id]->Clone();
+  } else {
+    state_->ApplyAction(action_id);
+  }
+}
+
+std::string SubgameState::ActionToString(int player, Action action_id) const {
+  if (state_ == nullptr) return absl::StrCat("Root ", action_id);
+  return state_->ActionToString(player, action_id);
+}
+
+std::string SubgameState::ToString() const {
+  return state_ == nullptr ? "Subgame root" : state_->ToString();
+}
+
+bool SubgameState::IsTerminal() const {
+  return state_ != nullptr && state_->IsTerminal();
+}
+
+std::vector<double> SubgameState::Rewards() const {
+  if (state_ == nullptr) return std::vector<double>(num_players_, 0.0);
+  return state_->Rewards();
+}
+
+std::vector<double> SubgameState::Returns() const {
+  if (state_ == nullptr) return std::vector<double>(num_players_, 0.0);
+  return state_->Returns();
+}
+
+std::string SubgameState::InformationState(int player) const {
+  if (state_ == nullptr) return "Subgame root";
+  return state_->InformationState(player);
+}
+
+void SubgameState::InformationStateAsNormalizedVector(
+    int player, std::vector<double>* values) const {
+  SPIEL_CHECK_TRUE(state_ != nullptr);
+  state_->InformationStateAsNormalizedVector(player, values);
+}
+
+std::string SubgameState::Observation(int player) const {
+  if (state_ == nullptr) return "Subgame root";
+  return state_->Observation(player);
+}
+
+void SubgameState::ObservationAsNormalizedVector(
+    int player, std::vector<double>* values) const {
+  SPIEL_CHECK_TRUE(state_ != nullptr);
+  state_->ObservationAsNormalizedVector(player, values);
+}
+
+std::unique_ptr<State> SubgameState::Clone() const {
+  return std::unique_ptr<State>(new SubgameState(*this));
+}
+
+SubgameGame::SubgameGame(std::unique_ptr<Game> game, GameType game_type,
+                         GameParameters game_parameters,
+                         const std::vector<SubgameRoot>& roots)
+    : WrappedGame(std::move(game), game_type, std::move(game_parameters)) {
+  SPIEL_CHECK_GT(roots.size(), 0);
+  auto states = std::make_shared<std::vector<std::unique_ptr<State>>>();
+  auto probs = std::make_shared<std::vector<double>>();
+  states->reserve(roots.size());
+  probs->reserve(roots.size());
+  double sum = 0;
+  for (const SubgameRoot& root : roots) {
+    SPIEL_CHECK_GT(root.probability, 0);
+    states->push_back(game_->DeserializeState(root.serialized_state));
+    probs->push_back(root.probability);
+    sum += root.probability;
+  }
+  SPIEL_CHECK_LT(std::abs(sum - 1.0), 1e-9);
+  roots_ = std::move(states);
+  root_probs_ = std::move(probs);
+}
+
+int SubgameGame::MaxChanceOutcomes() const {
+  return std::max(game_->MaxChanceOutcomes(),
+                  static_cast<int>(roots_->size()));
+}
+
+std::unique_ptr<Game> ExtractSubgame(std::unique_ptr<Game> game,
+                                     const std::vector<SubgameRoot>& roots) {
+  if (game->GetType().dynamics != GameType::Dynamics::kSequential) {
+    SpielFatalError("ExtractSubgame requires a sequential game.");
+  }
+  GameType game_type = SubgameGameType(game->GetType());
+  // Record the wrapped game and the roots so Game::ToString() round-trips
+  // through LoadGame.
+  GameParameters wrapped_params = game->GetParameters();
+  wrapped_params["name"] = GameParameter(game->GetType().short_name);
+  GameParameters params{{"game", GameParameter{wrapped_params}},
+                        {"roots", GameParameter(EncodeRoots(roots))}};
+  return std::unique_ptr<Game>(
+      new SubgameGame(std::move(game), game_type, std::move(params), roots));
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,122 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_SUBGAME_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_SUBGAME_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "open_spiel/game_transforms/game_wrapper.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+// Carves a subgame out of a base game for distributed solving: the subgame's
+// initial state is a chance node that picks one of the caller-provided root
+// histories with the given probabilities, and play then continues in the
+// base game. Workers solve disjoint subgames concurrently — each rooted at
+// one frontier history, or at a whole information set with the roots
+// weighted by their reach probabilities (the standard subgame-decomposition
+// construction) — and a coordinator stitches the policies by information
+// state. Computing sound root weights is the caller's job; the transform
+// only realizes the rooted game.
+//
+// Roots are passed in serialized form (Game::SerializeState), which is how
+// a coordinator ships them to workers. The transform is registered with
+// LoadGame as "subgame", with the roots packed into a string parameter
+// ("<prob>:<action> <action> ...", one entry per root, ';'-separated), so
+// instances round-trip through Game::ToString and the serialization
+// helpers; ExtractSubgame remains the convenient way to build one.
+
+namespace open_spiel {
+
+// One subgame root: a state serialized by the base game, and the
+// probability of starting there. Probabilities must sum to one.
+struct SubgameRoot {
+  std::string serialized_state;
+  double probability;
+};
+
+class SubgameState : public State {
+ public:
+  // Before the root chance move, state_ is null and this is a chance node
+  // over the roots; afterwards everything forwards to the chosen state.
+  SubgameState(
+      std::shared_ptr<const std::vector<std::unique_ptr<State>>> roots,
+      std::shared_ptr<const std::vector<double>> root_probs,
+      int num_distinct_actions, int num_players);
+  SubgameState(const SubgameState& other);
+
+  int CurrentPlayer() const override;
+  std::vector<Action> LegalActions() const override;
+  std::string ActionToString(int player, Action action_id) const override;
+  std::string ToString() const override;
+  bool IsTerminal() const override;
+  std::vector<double> Rewards() const override;
+  std::vector<double> Returns() const override;
+  std::string InformationState(int player) const override;
+  void InformationStateAsNormalizedVector(
+      int player, std::vector<double>* values) const override;
+  std::string Observation(int player) const override;
+  void ObservationAsNormalizedVector(
+      int player, std::vector<double>* values) const override;
+  ActionsAndProbs ChanceOutcomes() const override;
+  std::unique_ptr<State> Clone() const override;
+
+ protected:
+  void DoApplyAction(Action action_id) override;
+
+ private:
+  std::shared_ptr<const std::vector<std::unique_ptr<State>>> roots_;
+  std::shared_ptr<const std::vector<double>> root_probs_;
+  std::unique_ptr<State> state_;  // Null until the root chance move.
+};
+
+class SubgameGame : public WrappedGame {
+ public:
+  SubgameGame(std::unique_ptr<Game> game, GameType game_type,
+              GameParameters game_parameters,
+              const std::vector<SubgameRoot>& roots);
+  SubgameGame(const SubgameGame& other) = default;
+
+  std::unique_ptr<State> NewInitialState() const override {
+    return std::unique_ptr<State>(
+        new SubgameState(roots_, root_probs_, NumDistinctActions(),
+                         NumPlayers()));
+  }
+
+  std::unique_ptr<Game> Clone() const override {
+    return std::unique_ptr<Game>(new SubgameGame(*this));
+  }
+
+  double MinUtility() const override { return game_->MinUtility(); }
+  double MaxUtility() const override { return game_->MaxUtility(); }
+
+  int MaxChanceOutcomes() const override;
+  int MaxGameLength() const override { return game_->MaxGameLength(); }
+
+ private:
+  std::shared_ptr<const std::vector<std::unique_ptr<State>>> roots_;
+  std::shared_ptr<const std::vector<double>> root_probs_;
+};
+
+// Builds the subgame of `game` rooted at the given serialized states. The
+// probabilities must be positive and sum to one.
+std::unique_ptr<Game> ExtractSubgame(std::unique_ptr<Game> game,
+                                     const std::vector<SubgameRoot>& roots);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAME_TRANSFORMS_SUBGAME_H_
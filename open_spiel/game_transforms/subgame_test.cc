@@ -0,0 +1,94 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/game_transforms/subgame.h"
+
+#include <memory>
+#include <vector>
+
+#include "open_spiel/algorithms/cfr.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+#include "open_spiel/tests/basic_tests.h"
+
+namespace open_spiel {
+namespace {
+
+namespace testing = open_spiel::testing;
+
+// A two-root kuhn subgame: the chance root weights the deals, and play
+// below each root is the base game.
+void KuhnSubgameTest() {
+  std::unique_ptr<Game> base = LoadGame("kuhn_poker");
+  std::unique_ptr<State> deal_a = base->NewInitialState();
+  deal_a->ApplyAction(0);
+  deal_a->ApplyAction(1);
+  std::unique_ptr<State> deal_b = base->NewInitialState();
+  deal_b->ApplyAction(2);
+  deal_b->ApplyAction(1);
+
+  std::vector<SubgameRoot> roots = {
+      {base->SerializeState(*deal_a), 0.25},
+      {base->SerializeState(*deal_b), 0.75}};
+  std::unique_ptr<Game> subgame =
+      ExtractSubgame(LoadGame("kuhn_poker"), roots);
+
+  std::unique_ptr<State> root = subgame->NewInitialState();
+  SPIEL_CHECK_TRUE(root->IsChanceNode());
+  SPIEL_CHECK_EQ(root->ChanceOutcomes().size(), 2);
+  SPIEL_CHECK_FLOAT_EQ(root->ChanceOutcomes()[1].second, 0.75);
+
+  std::unique_ptr<State> child = root->Child(0);
+  SPIEL_CHECK_EQ(child->ToString(), deal_a->ToString());
+  SPIEL_CHECK_EQ(child->CurrentPlayer(), 0);
+  SPIEL_CHECK_EQ(child->InformationState(0), deal_a->InformationState(0));
+
+  testing::RandomSimTest(*subgame, 20);
+
+  // A worker can run a tabular solver directly on the carved game.
+  algorithms::CFRSolver solver(*subgame);
+  for (int i = 0; i < 5; ++i) solver.EvaluateAndUpdatePolicy();
+  SPIEL_CHECK_GT(solver.InfoStateValuesTable().size(), 0);
+}
+
+// A single-root subgame of a deterministic game: one forced chance move,
+// then the position plays out as in the base game.
+void SingleRootSubgameTest() {
+  std::unique_ptr<Game> base = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> position = base->NewInitialState();
+  position->ApplyAction(4);
+  position->ApplyAction(0);
+
+  std::vector<SubgameRoot> roots = {{base->SerializeState(*position), 1.0}};
+  std::unique_ptr<Game> subgame =
+      ExtractSubgame(LoadGame("tic_tac_toe"), roots);
+  SPIEL_CHECK_EQ(subgame->GetType().chance_mode,
+                 GameType::ChanceMode::kExplicitStochastic);
+
+  std::unique_ptr<State> root = subgame->NewInitialState();
+  SPIEL_CHECK_TRUE(root->IsChanceNode());
+  root->ApplyAction(0);
+  SPIEL_CHECK_EQ(root->ToString(), position->ToString());
+  SPIEL_CHECK_EQ(root->CurrentPlayer(), position->CurrentPlayer());
+
+  testing::RandomSimTest(*subgame, 10);
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  open_spiel::KuhnSubgameTest();
+  open_spiel::SingleRootSubgameTest();
+}
@@ -68,13 +68,19 @@ int TurnBasedSimultaneousState::CurrentPlayer() const {
 void TurnBasedSimultaneousState::DetermineWhoseTurn() {
   if (state_->CurrentPlayer() == kSimultaneousPlayerId) {
     // When the underlying game's node is at a simultaneous move node, they get
-    // rolled out as turn-based, starting with player 0.
+    // rolled out as turn-based, starting with player 0. Cache every player's
+    // legal actions now; they cannot change until the joint action is applied.
     current_player_ = 0;
     rollout_mode_ = true;
+    legal_actions_cache_.resize(num_players_);
+    for (int p = 0; p < num_players_; ++p) {
+      legal_actions_cache_[p] = state_->LegalActions(p);
+    }
   } else {
     // Otherwise, just execute it normally.
     current_player_ = state_->CurrentPlayer();
     rollout_mode_ = false;
+    legal_actions_cache_.clear();
   }
 }
 
@@ -83,31 +89,39 @@ void TurnBasedSimultaneousState::RolloutModeIncrementCurrentPlayer() {
 
   // Make sure to skip over the players that do not have legal actions.
   while (current_player_ < num_players_ &&
-         state_->LegalActions(current_player_).empty()) {
+         legal_actions_cache_[current_player_].empty()) {
     // Unnecessary to set an action here, but leads to a nicer ToString.
     action_vector_[current_player_] = 0;
     current_player_++;
   }
 }
 
+void TurnBasedSimultaneousState::DetachWrappedState() {
+  if (state_.use_count() > 1) state_ = state_->Clone();
+}
+
 void TurnBasedSimultaneousState::DoApplyAction(Action action_id) {
   if (state_->IsChanceNode()) {
     SPIEL_CHECK_FALSE(rollout_mode_);
+    DetachWrappedState();
     state_->ApplyAction(action_id);
     DetermineWhoseTurn();
   } else {
     if (rollout_mode_) {
       // If we are currently rolling out a simultaneous move node, then simply
-      // buffer the action in the action vector.
+      // buffer the action in the action vector; the wrapped state is not
+      // touched (and so stays shared) until every player has moved.
       action_vector_[current_player_] = action_id;
       RolloutModeIncrementCurrentPlayer();
       // Check if we then need to apply it.
       if (current_player_ == num_players_) {
+        DetachWrappedState();
         state_->ApplyActions(action_vector_);
         DetermineWhoseTurn();
       }
     } else {
       SPIEL_CHECK_NE(state_->CurrentPlayer(), kSimultaneousPlayerId);
+      DetachWrappedState();
       state_->ApplyAction(action_id);
       DetermineWhoseTurn();
     }
@@ -120,6 +134,7 @@ TurnBasedSimultaneousState::ChanceOutcomes() const {
 }
 
 std::vector<Action> TurnBasedSimultaneousState::LegalActions() const {
+  if (rollout_mode_) return legal_actions_cache_[current_player_];
   return state_->LegalActions(CurrentPlayer());
 }
 
@@ -200,8 +215,9 @@ void TurnBasedSimultaneousState::InformationStateAsNormalizedVector(
 TurnBasedSimultaneousState::TurnBasedSimultaneousState(
     const TurnBasedSimultaneousState& other)
     : State(other),
-      state_(other.state_->Clone()),
+      state_(other.state_),  // Shared; cloned only when one side mutates it.
       action_vector_(other.action_vector_),
+      legal_actions_cache_(other.legal_actions_cache_),
       current_player_(other.current_player_),
       rollout_mode_(other.rollout_mode_) {}
 
@@ -55,14 +55,25 @@ class TurnBasedSimultaneousState : public State {
  private:
   void DetermineWhoseTurn();
   void RolloutModeIncrementCurrentPlayer();
+  void DetachWrappedState();
 
-  std::unique_ptr<State> state_;
+  // The wrapped state, shared copy-on-write between clones: during the
+  // rollout of a simultaneous move node only the action buffer changes, so
+  // the n intermediate turn-based states can all point at the same wrapped
+  // state. It is cloned lazily, just before it is actually mutated.
+  std::shared_ptr<State> state_;
 
   // A vector of actions that is used primarily to store the intermediate
   // actions taken by the players when extending the simultaneous move nodes
   // to be turn-based.
   std::vector<Action> action_vector_;
 
+  // Each player's legal actions at the simultaneous move node currently
+  // being rolled out, cached when the rollout starts so the repeated
+  // LegalActions() calls made by tree-walking algorithms do not re-query the
+  // wrapped state once per turn.
+  std::vector<std::vector<Action>> legal_actions_cache_;
+
   // The current player (which will never be kSimultaneousPlayerId).
   int current_player_;
 
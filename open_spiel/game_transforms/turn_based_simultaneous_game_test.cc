@@ -118,9 +118,34 @@ void BasicTurnBasedSimultaneousTests() {
   }
 }
 
+void CloneDuringRolloutTest() {
+  // Clones taken in the middle of a rollout share the wrapped state
+  // copy-on-write; diverging after the clone must not corrupt either side.
+  std::unique_ptr<Game> game = ConvertToTurnBased(*LoadGame("goofspiel"));
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  // Player 0 moves, leaving the rollout half-finished.
+  state->ApplyAction(state->LegalActions()[0]);
+  std::unique_ptr<State> clone = state->Clone();
+  SPIEL_CHECK_EQ(state->ToString(), clone->ToString());
+
+  // Complete the joint action differently on each side.
+  state->ApplyAction(state->LegalActions()[0]);
+  clone->ApplyAction(clone->LegalActions()[1]);
+  SPIEL_CHECK_TRUE(state->ToString() != clone->ToString());
+
+  // A clone left untouched while the original advances keeps its old view.
+  std::unique_ptr<State> snapshot = state->Clone();
+  std::string snapshot_string = snapshot->ToString();
+  state->ApplyAction(state->LegalActions()[0]);
+  state->ApplyAction(state->LegalActions()[0]);
+  SPIEL_CHECK_EQ(snapshot->ToString(), snapshot_string);
+}
+
 }  // namespace
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::BasicTurnBasedSimultaneousTests();
+  open_spiel::CloneDuringRolloutTest();
 }
@@ -16,7 +16,6 @@
 
 #include <algorithm>
 #include <cstdlib>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -72,7 +71,12 @@ const GameType kGameType{
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
     /*parameter_specification=*/
-    {{"scoring_type", {GameParameter::Type::kString, false}}}};
+    {{"scoring_type", {GameParameter::Type::kString, false}},
+     {"halfmoves", {GameParameter::Type::kBool, false}}},
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/false,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/true};
 
 static std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new BackgammonGame(params));
@@ -111,6 +115,10 @@ std::string BackgammonState::ActionToString(int player, Action move_id) const {
     return absl::StrCat("chance outcome ", move_id,
                         " (roll: ", kChanceOutcomeValues[move_id][0],
                         kChanceOutcomeValues[move_id][1], ")");
+  } else if (halfmoves_) {
+    CheckerMove cmove = HalfMoveActionToCheckerMove(move_id);
+    return absl::StrCat(move_id, " (", PositionToString(cmove.pos), "-",
+                        cmove.num, ")");
   } else {
     std::vector<CheckerMove> cmoves = SpielMoveToCheckerMoves(player, move_id);
     return absl::StrCat(move_id, " (", PositionToString(cmoves[0].pos), "-",
@@ -157,9 +165,10 @@ void BackgammonState::InformationStateAsNormalizedVector(
 }
 
 BackgammonState::BackgammonState(int num_distinct_actions, int num_players,
-                                 ScoringType scoring_type)
+                                 ScoringType scoring_type, bool halfmoves)
     : State(num_distinct_actions, num_players),
       scoring_type_(scoring_type),
+      halfmoves_(halfmoves),
       cur_player_(kChancePlayerId),
       prev_player_(kChancePlayerId),
       turns_(-1),
@@ -273,6 +282,30 @@ void BackgammonState::DoApplyAction(Action move) {
     }
   }
 
+  if (halfmoves_) {
+    // Half-move action: one checker move. Hits are detected by
+    // ApplyCheckerMove and recorded for Undo.
+    CheckerMove cmove = HalfMoveActionToCheckerMove(move);
+    // Snapshot the dice before ApplyCheckerMove marks the consumed die
+    // used, so UndoAction's dice restore rolls back the marker too.
+    turn_history_info_.push_back(TurnHistoryInfo(cur_player_, prev_player_,
+                                                 dice_, move, double_turn_,
+                                                 false, false));
+    bool move_hit = ApplyCheckerMove(cur_player_, cmove);
+    turn_history_info_.back().first_move_hit = move_hit;
+
+    // The turn continues (same player, no reroll) while a checker move
+    // remains for the unused dice.
+    CheckerMove remaining[kMaxSingleCheckerMoves];
+    if (cmove.pos != kPassPos &&
+        LegalCheckerMoves(cur_player_, remaining) > 0) {
+      turn_history_info_.back().turn_completed = false;
+      return;
+    }
+    EndPlayerTurn();
+    return;
+  }
+
   // Normal move action.
   std::vector<CheckerMove> moves = SpielMoveToCheckerMoves(cur_player_, move);
   bool first_move_hit = ApplyCheckerMove(cur_player_, moves[0]);
@@ -282,6 +315,10 @@ void BackgammonState::DoApplyAction(Action move) {
       TurnHistoryInfo(cur_player_, prev_player_, dice_, move, double_turn_,
                       first_move_hit, second_move_hit));
 
+  EndPlayerTurn();
+}
+
+void BackgammonState::EndPlayerTurn() {
   if (!double_turn_) {
     turns_++;
     if (cur_player_ == kXPlayerId) {
@@ -331,7 +368,25 @@ void BackgammonState::UndoAction(int player, Action action) {
     prev_player_ = thi.prev_player;
     dice_ = thi.dice;
     double_turn_ = thi.double_turn;
-    if (player != kChancePlayerId) {
+    if (player != kChancePlayerId && halfmoves_) {
+      CheckerMove cmove = HalfMoveActionToCheckerMove(action);
+      cmove.hit = thi.first_move_hit;
+      UndoCheckerMove(player, cmove);
+      // UndoCheckerMove unmarked a die against the already-restored dice,
+      // which on the second half of a doubles turn strips the used marker
+      // off the wrong die; the snapshot alone is authoritative.
+      dice_ = thi.dice;
+      if (thi.turn_completed) {
+        turns_--;
+        if (!double_turn_) {
+          if (player == kXPlayerId) {
+            x_turns_--;
+          } else if (player == kOPlayerId) {
+            o_turns_--;
+          }
+        }
+      }
+    } else if (player != kChancePlayerId) {
       std::vector<CheckerMove> moves = SpielMoveToCheckerMoves(player, action);
       SPIEL_CHECK_EQ(moves.size(), 2);
       moves[0].hit = thi.first_move_hit;
@@ -460,6 +515,34 @@ std::vector<CheckerMove> BackgammonState::SpielMoveToCheckerMoves(
   return cmoves;
 }
 
+Action BackgammonState::CheckerMoveToHalfMoveAction(
+    const CheckerMove& move) const {
+  int digit;
+  int num;
+  if (move.pos == kPassPos) {
+    digit = EncodedPassMove();
+    num = 1;
+  } else {
+    digit = (move.pos == kBarPos ? EncodedBarMove() : move.pos);
+    num = move.num;
+  }
+  Action action = digit * 6 + (num - 1);
+  SPIEL_CHECK_GE(action, 0);
+  SPIEL_CHECK_LT(action, kNumHalfMoveActions);
+  return action;
+}
+
+CheckerMove BackgammonState::HalfMoveActionToCheckerMove(Action action) const {
+  SPIEL_CHECK_GE(action, 0);
+  SPIEL_CHECK_LT(action, kNumHalfMoveActions);
+  int digit = action / 6;
+  int num = action % 6 + 1;
+  if (digit == EncodedPassMove()) {
+    return CheckerMove(kPassPos, -1, false);
+  }
+  return CheckerMove(digit == EncodedBarMove() ? kBarPos : digit, num, false);
+}
+
 bool BackgammonState::IsPosInHome(int player, int pos) const {
   switch (player) {
     case kXPlayerId:
@@ -721,56 +804,65 @@ int BackgammonState::IsBackgammoned(int player) const {
   return false;
 }
 
-std::set<CheckerMove> BackgammonState::LegalCheckerMoves(int player) const {
-  std::set<CheckerMove> moves;
+int BackgammonState::LegalCheckerMoves(int player, CheckerMove* moves) const {
+  // Collect the usable dice, collapsing doubles to a single value so that
+  // identical moves are not generated (and later searched) twice.
+  int outcomes[2];
+  int num_outcomes = 0;
+  for (int i = 0; i < dice_.size(); ++i) {
+    if (UsableDiceOutcome(dice_[i]) &&
+        (num_outcomes == 0 || outcomes[0] != dice_[i])) {
+      outcomes[num_outcomes++] = dice_[i];
+    }
+  }
 
+  int num_moves = 0;
   if (bar_[player] > 0) {
     // If there are any checkers are the bar, must move them out first.
-    for (int outcome : dice_) {
-      if (UsableDiceOutcome(outcome)) {
-        int pos = PositionFromBar(player, outcome);
-        if (NumOppCheckers(player, pos) <= 1) {
-          bool hit = NumOppCheckers(player, pos) == 1;
-          moves.insert(CheckerMove(kBarPos, outcome, hit));
-        }
+    for (int i = 0; i < num_outcomes; ++i) {
+      int outcome = outcomes[i];
+      int pos = PositionFromBar(player, outcome);
+      if (NumOppCheckers(player, pos) <= 1) {
+        bool hit = NumOppCheckers(player, pos) == 1;
+        moves[num_moves++] = CheckerMove(kBarPos, outcome, hit);
       }
     }
-    return moves;
+    return num_moves;
   }
 
   // Regular board moves.
   bool all_in_home = AllInHome(player);
   for (int i = 0; i < kNumPoints; ++i) {
     if (board_[player][i] > 0) {
-      for (int outcome : dice_) {
-        if (UsableDiceOutcome(outcome)) {
-          int pos = PositionFrom(player, i, outcome);
-          if (pos == kScorePos && all_in_home) {
-            // Check whether a bear off move is legal.
-
-            // It is ok to bear off if all the checkers are at home and the
-            // point being used to move from exactly matches the distance from
-            // just stepping off the board.
-            if ((player == kXPlayerId && i + outcome == 24) ||
-                (player == kOPlayerId && i - outcome == -1)) {
-              moves.insert(CheckerMove(i, outcome, false));
-            } else {
-              // Otherwise, a die can only be used to move a checker off if
-              // there are no checkers further than it in the player's home.
-              if (i == FurthestCheckerInHome(player)) {
-                moves.insert(CheckerMove(i, outcome, false));
-              }
+      for (int j = 0; j < num_outcomes; ++j) {
+        int outcome = outcomes[j];
+        int pos = PositionFrom(player, i, outcome);
+        if (pos == kScorePos && all_in_home) {
+          // Check whether a bear off move is legal.
+
+          // It is ok to bear off if all the checkers are at home and the
+          // point being used to move from exactly matches the distance from
+          // just stepping off the board.
+          if ((player == kXPlayerId && i + outcome == 24) ||
+              (player == kOPlayerId && i - outcome == -1)) {
+            moves[num_moves++] = CheckerMove(i, outcome, false);
+          } else {
+            // Otherwise, a die can only be used to move a checker off if
+            // there are no checkers further than it in the player's home.
+            if (i == FurthestCheckerInHome(player)) {
+              moves[num_moves++] = CheckerMove(i, outcome, false);
             }
-          } else if (pos != kScorePos && NumOppCheckers(player, pos) <= 1) {
-            // Regular move.
-            bool hit = NumOppCheckers(player, pos) == 1;
-            moves.insert(CheckerMove(i, outcome, hit));
           }
+        } else if (pos != kScorePos && NumOppCheckers(player, pos) <= 1) {
+          // Regular move.
+          bool hit = NumOppCheckers(player, pos) == 1;
+          moves[num_moves++] = CheckerMove(i, outcome, hit);
         }
       }
     }
   }
-  return moves;
+  SPIEL_CHECK_LE(num_moves, kMaxSingleCheckerMoves);
+  return num_moves;
 }
 
 bool BackgammonState::ApplyCheckerMove(int player, const CheckerMove& move) {
@@ -865,41 +957,78 @@ void BackgammonState::UndoCheckerMove(int player, const CheckerMove& move) {
   }
 }
 
-// Returns the maximum move size (2, 1, or 0)
-int BackgammonState::RecLegalMoves(
-    std::vector<CheckerMove> moveseq,
-    std::set<std::vector<CheckerMove>>* movelist) {
-  if (moveseq.size() == 2) {
-    movelist->insert(moveseq);
-    return moveseq.size();
-  }
-
-  std::set<CheckerMove> moves_here = LegalCheckerMoves(cur_player_);
+std::vector<Action> BackgammonState::HalfMoveLegalActions() const {
+  // As in LegalActions, the lookahead makes and unmakes checker moves on
+  // this state directly, leaving it unchanged on return.
+  auto* self = const_cast<BackgammonState*>(this);
 
-  if (moves_here.empty()) {
-    movelist->insert(moveseq);
-    return moveseq.size();
+  CheckerMove moves[kMaxSingleCheckerMoves];
+  int num_moves = LegalCheckerMoves(cur_player_, moves);
+  if (num_moves == 0) {
+    // No move with either die: the turn is lost, pass.
+    return {CheckerMoveToHalfMoveAction(CheckerMove(kPassPos, -1, false))};
   }
 
-  int max_moves = -1;
-  for (const auto& move : moves_here) {
-    moveseq.push_back(move);
-    ApplyCheckerMove(cur_player_, move);
-    int child_max = RecLegalMoves(moveseq, movelist);
-    UndoCheckerMove(cur_player_, move);
-    max_moves = std::max(child_max, max_moves);
-    moveseq.pop_back();
+  std::vector<Action> legal_actions;
+  if (UsableDiceOutcome(dice_[0]) && UsableDiceOutcome(dice_[1])) {
+    // First half of the turn: rule 2 in Movement of Checkers (see
+    // LegalActions) applies. A half-move that leaves the other die playable
+    // is preferred; when none does, only one number can be played and it
+    // must be the largest playable one.
+    CheckerMove second[kMaxSingleCheckerMoves];
+    bool has_completion[kMaxSingleCheckerMoves];
+    bool any_full_sequence = false;
+    for (int i = 0; i < num_moves; ++i) {
+      self->ApplyCheckerMove(cur_player_, moves[i]);
+      has_completion[i] = LegalCheckerMoves(cur_player_, second) > 0;
+      self->UndoCheckerMove(cur_player_, moves[i]);
+      any_full_sequence = any_full_sequence || has_completion[i];
+    }
+    if (any_full_sequence) {
+      for (int i = 0; i < num_moves; ++i) {
+        if (has_completion[i]) {
+          legal_actions.push_back(CheckerMoveToHalfMoveAction(moves[i]));
+        }
+      }
+    } else {
+      int max_roll = -1;
+      for (int i = 0; i < num_moves; ++i) {
+        max_roll = std::max(max_roll, moves[i].num);
+      }
+      for (int i = 0; i < num_moves; ++i) {
+        if (moves[i].num == max_roll) {
+          legal_actions.push_back(CheckerMoveToHalfMoveAction(moves[i]));
+        }
+      }
+    }
+  } else {
+    // Second half of the turn: any move with the remaining die.
+    for (int i = 0; i < num_moves; ++i) {
+      legal_actions.push_back(CheckerMoveToHalfMoveAction(moves[i]));
+    }
   }
 
-  return max_moves;
+  SPIEL_CHECK_FALSE(legal_actions.empty());
+  std::sort(legal_actions.begin(), legal_actions.end());
+  return legal_actions;
 }
 
-std::vector<Action> BackgammonState::ProcessLegalMoves(
-    int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const {
-  if (max_moves == 0) {
-    SPIEL_CHECK_EQ(movelist.size(), 1);
-    SPIEL_CHECK_TRUE(movelist.begin()->empty());
+std::vector<Action> BackgammonState::LegalActions() const {
+  if (IsChanceNode()) return LegalChanceOutcomes();
+
+  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
+
+  if (halfmoves_) return HalfMoveLegalActions();
+
+  // The two-ply enumeration makes and unmakes checker moves on this state
+  // directly; every move is undone before returning, so the state is unchanged
+  // and this function remains logically const.
+  auto* self = const_cast<BackgammonState*>(this);
 
+  CheckerMove first_moves[kMaxSingleCheckerMoves];
+  int num_first = LegalCheckerMoves(cur_player_, first_moves);
+  if (num_first == 0) {
     // Passing is always a legal move!
     return {CheckerMovesToSpielMove(
         {{kPassPos, -1, false}, {kPassPos, -1, false}})};
@@ -913,45 +1042,34 @@ std::vector<Action> BackgammonState::ProcessLegalMoves(
   // the player loses his turn. In the case of doubles, when all four numbers
   // cannot be played, the player must play as many numbers as he can.
   std::vector<Action> legal_actions;
-  int max_roll = -1;
-  for (const auto& move : movelist) {
-    if (max_moves == 2) {
-      // Only add moves that are size 2.
-      if (move.size() == 2) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
-      }
-    } else if (max_moves == 1) {
-      // We are just finding the maximum roll.
-      max_roll = std::max(max_roll, move[0].num);
+  CheckerMove second_moves[kMaxSingleCheckerMoves];
+  bool any_full_sequence = false;
+  for (int i = 0; i < num_first; ++i) {
+    self->ApplyCheckerMove(cur_player_, first_moves[i]);
+    int num_second = LegalCheckerMoves(cur_player_, second_moves);
+    for (int j = 0; j < num_second; ++j) {
+      legal_actions.push_back(
+          CheckerMovesToSpielMove({first_moves[i], second_moves[j]}));
     }
+    any_full_sequence = any_full_sequence || num_second > 0;
+    self->UndoCheckerMove(cur_player_, first_moves[i]);
   }
 
-  if (max_moves == 1) {
-    // Another round to add those that have the max die roll.
-    for (const auto& move : movelist) {
-      if (move[0].num == max_roll) {
-        legal_actions.push_back(CheckerMovesToSpielMove(move));
+  if (!any_full_sequence) {
+    // Only one checker move can be played, so it must use the largest
+    // playable die.
+    int max_roll = -1;
+    for (int i = 0; i < num_first; ++i) {
+      max_roll = std::max(max_roll, first_moves[i].num);
+    }
+    for (int i = 0; i < num_first; ++i) {
+      if (first_moves[i].num == max_roll) {
+        legal_actions.push_back(CheckerMovesToSpielMove({first_moves[i]}));
       }
     }
   }
 
   SPIEL_CHECK_FALSE(legal_actions.empty());
-  return legal_actions;
-}
-
-std::vector<Action> BackgammonState::LegalActions() const {
-  if (IsChanceNode()) return LegalChanceOutcomes();
-
-  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
-  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
-
-  std::unique_ptr<State> cstate = this->Clone();
-  BackgammonState* state = dynamic_cast<BackgammonState*>(cstate.get());
-  std::set<std::vector<CheckerMove>> movelist;
-  int max_moves = state->RecLegalMoves({}, &movelist);
-  SPIEL_CHECK_GE(max_moves, 0);
-  SPIEL_CHECK_LE(max_moves, 2);
-  std::vector<Action> legal_actions = ProcessLegalMoves(max_moves, movelist);
   std::sort(legal_actions.begin(), legal_actions.end());
   return legal_actions;
 }
@@ -961,6 +1079,27 @@ std::vector<std::pair<Action, double>> BackgammonState::ChanceOutcomes() const {
   return kChanceOutcomes;
 }
 
+const ActionsAndProbs* BackgammonState::StaticChanceOutcomes() const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // The roll distribution is the same at every chance node.
+  return &kChanceOutcomes;
+}
+
+std::pair<Action, double> BackgammonState::SampleChanceOutcome(
+    double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // Outcomes 0-14 are the mixed rolls (two orderings each, 2/36), outcomes
+  // 15-20 are the doubles (1/36). Map a uniform draw over the 36 ordered
+  // rolls onto them directly.
+  int roll = static_cast<int>(z * 36);
+  if (roll >= 36) roll = 35;
+  if (roll < 30) {
+    return std::make_pair(roll / 2, 1.0 / 18);
+  } else {
+    return std::make_pair(15 + (roll - 30), 1.0 / 36);
+  }
+}
+
 std::string BackgammonState::ToString() const {
   std::vector<std::string> board_array = {
       "+------|------+", "|......|......|", "|......|......|",
@@ -1071,6 +1210,23 @@ std::unique_ptr<State> BackgammonState::Clone() const {
   return std::unique_ptr<State>(new BackgammonState(*this));
 }
 
+double BackgammonState::QuickEvaluate() const {
+  // Pip counts: the total distance each side's checkers still have to
+  // travel, counting 25 for a checker on the bar. The normalized difference
+  // is positive when X (player 0) is ahead in the race.
+  int pips[2] = {0, 0};
+  for (int pos = 0; pos < kNumPoints; ++pos) {
+    pips[kXPlayerId] += board_[kXPlayerId][pos] * (kNumPoints - pos);
+    pips[kOPlayerId] += board_[kOPlayerId][pos] * (pos + 1);
+  }
+  pips[kXPlayerId] += bar_[kXPlayerId] * (kNumPoints + 1);
+  pips[kOPlayerId] += bar_[kOPlayerId] * (kNumPoints + 1);
+  const int total_pips = pips[kXPlayerId] + pips[kOPlayerId];
+  if (total_pips == 0) return 0;
+  return static_cast<double>(pips[kOPlayerId] - pips[kXPlayerId]) /
+         total_pips;
+}
+
 void BackgammonState::SetState(int cur_player, bool double_turn,
                                const std::vector<int>& dice,
                                const std::vector<int>& bar,
@@ -1087,10 +1243,75 @@ void BackgammonState::SetState(int cur_player, bool double_turn,
   SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
 }
 
+namespace {
+
+// Zig-zag wrappers around the varint helpers for the few signed fields in
+// the snapshot (the current/previous player and the turn counter can be -1).
+void AppendSignedVarint(int64_t value, std::string* buffer) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               buffer);
+}
+
+int64_t ReadSignedVarint(const uint8_t* data, std::size_t size,
+                         std::size_t* offset) {
+  uint64_t coded = ReadVarint(data, size, offset);
+  return static_cast<int64_t>(coded >> 1) ^ -static_cast<int64_t>(coded & 1);
+}
+
+}  // namespace
+
+void BackgammonState::SerializeBinary(std::string* buffer) const {
+  AppendSignedVarint(cur_player_, buffer);
+  AppendSignedVarint(prev_player_, buffer);
+  AppendSignedVarint(turns_, buffer);
+  AppendVarint(x_turns_, buffer);
+  AppendVarint(o_turns_, buffer);
+  AppendVarint(double_turn_ ? 1 : 0, buffer);
+  AppendVarint(dice_.size(), buffer);
+  for (int die : dice_) {
+    AppendVarint(die, buffer);
+  }
+  for (int player : {kXPlayerId, kOPlayerId}) {
+    AppendVarint(bar_[player], buffer);
+    AppendVarint(scores_[player], buffer);
+    for (int pos = 0; pos < kNumPoints; ++pos) {
+      AppendVarint(board_[player][pos], buffer);
+    }
+  }
+}
+
+void BackgammonState::DeserializeBinary(const std::string& buffer) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  std::size_t size = buffer.size();
+  std::size_t offset = 0;
+  cur_player_ = ReadSignedVarint(data, size, &offset);
+  prev_player_ = ReadSignedVarint(data, size, &offset);
+  turns_ = ReadSignedVarint(data, size, &offset);
+  x_turns_ = ReadVarint(data, size, &offset);
+  o_turns_ = ReadVarint(data, size, &offset);
+  double_turn_ = ReadVarint(data, size, &offset) != 0;
+  dice_.resize(ReadVarint(data, size, &offset));
+  for (int i = 0; i < dice_.size(); ++i) {
+    dice_[i] = ReadVarint(data, size, &offset);
+  }
+  for (int player : {kXPlayerId, kOPlayerId}) {
+    bar_[player] = ReadVarint(data, size, &offset);
+    scores_[player] = ReadVarint(data, size, &offset);
+    for (int pos = 0; pos < kNumPoints; ++pos) {
+      board_[player][pos] = ReadVarint(data, size, &offset);
+    }
+  }
+  SPIEL_CHECK_EQ(offset, size);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kXPlayerId), kNumCheckersPerPlayer);
+  SPIEL_CHECK_EQ(CountTotalCheckers(kOPlayerId), kNumCheckersPerPlayer);
+}
+
 BackgammonGame::BackgammonGame(const GameParameters& params)
     : Game(kGameType, params),
       scoring_type_(ParseScoringType(
-          ParameterValue<std::string>("scoring_type", kDefaultScoringType))) {}
+          ParameterValue<std::string>("scoring_type", kDefaultScoringType))),
+      halfmoves_(ParameterValue<bool>("halfmoves", false)) {}
 
 double BackgammonGame::MaxUtility() const {
   switch (scoring_type_) {
@@ -1105,5 +1326,22 @@ double BackgammonGame::MaxUtility() const {
   }
 }
 
+std::string BackgammonGame::SerializeStateBinary(const State& state) const {
+  auto bstate = dynamic_cast<const BackgammonState*>(&state);
+  SPIEL_CHECK_TRUE(bstate != nullptr);
+  std::string str;
+  bstate->SerializeBinary(&str);
+  return str;
+}
+
+std::unique_ptr<State> BackgammonGame::DeserializeStateBinary(
+    const std::string& str) const {
+  std::unique_ptr<State> state = NewInitialState();
+  auto bstate = dynamic_cast<BackgammonState*>(state.get());
+  SPIEL_CHECK_TRUE(bstate != nullptr);
+  bstate->DeserializeBinary(str);
+  return state;
+}
+
 }  // namespace backgammon
 }  // namespace open_spiel
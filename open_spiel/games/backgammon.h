@@ -17,7 +17,6 @@
 
 #include <array>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -34,6 +33,14 @@
 // Parameters:
 //   "scoring_type"    string  Type of scoring for the game: "winloss_scoring"
 //                             (default), "enable_gammons", or "full_scoring"
+//   "halfmoves"       bool    Whether each action moves a single checker
+//                             (with the turn's dice consumption tracked in
+//                             the state) instead of encoding the whole
+//                             checker-move sequence of a turn. The game
+//                             played is identical; the branching factor per
+//                             node drops from the hundreds to ~20, which is
+//                             much cheaper for search algorithms that expand
+//                             every action. (default: false)
 
 namespace open_spiel {
 namespace backgammon {
@@ -56,11 +63,21 @@ constexpr const int kPassPos = -1;
 // number is encoded as a 2-digit number in base 26.
 constexpr const int kNumDistinctActions = 1352;
 
+// In half-move mode an action is one checker move: a source digit in
+// {0, ..., 23, kBarPos, Pass} (the same base-26 digits as above) times the
+// die value, encoded as digit * 6 + (num - 1). Pass is encoded with num = 1.
+constexpr const int kNumHalfMoveActions = 156;
+
 // See InformationStateNormalizedVectorShape for details.
 constexpr const int kBoardEncodingSize = 4 * kNumPoints * kNumPlayers;
 constexpr const int kStateEncodingSize = 3 * kNumPlayers + kBoardEncodingSize;
 constexpr const char* kDefaultScoringType = "winloss_scoring";
 
+// Upper bound on the number of distinct single-checker moves available with
+// the dice of one turn: each point can be the source of at most one move per
+// distinct die value, and a roll has at most two distinct values.
+constexpr const int kMaxSingleCheckerMoves = 2 * kNumPoints;
+
 // Game scoring type, whether to score gammons/backgammons specially.
 enum class ScoringType {
   kWinLossScoring,  // "winloss_scoring": Score only 1 point per player win.
@@ -74,6 +91,7 @@ struct CheckerMove {
   int pos;  // 0-24  (0-23 for locations on the board and kBarPos)
   int num;  // 1-6
   bool hit;
+  CheckerMove() : pos(kPassPos), num(-1), hit(false) {}
   CheckerMove(int _pos, int _num, bool _hit)
       : pos(_pos), num(_num), hit(_hit) {}
   bool operator<(const CheckerMove& rhs) const {
@@ -91,6 +109,10 @@ struct TurnHistoryInfo {
   bool double_turn;
   bool first_move_hit;
   bool second_move_hit;
+  // Half-move mode only: whether this action ended the player's turn (and
+  // so whether the turn counters were advanced). Always true in full-move
+  // mode.
+  bool turn_completed = true;
   TurnHistoryInfo(int _player, int _prev_player, std::vector<int> _dice,
                   int _action, bool _double_turn, bool fmh, bool smh)
       : player(_player),
@@ -108,13 +130,15 @@ class BackgammonState : public State {
  public:
   BackgammonState(const BackgammonState&) = default;
   BackgammonState(int num_distinct_actions, int num_players,
-                  ScoringType scoring_type);
+                  ScoringType scoring_type, bool halfmoves);
 
   int CurrentPlayer() const override;
   void UndoAction(int player, Action action) override;
   std::vector<Action> LegalActions() const override;
   std::string ActionToString(int player, Action move_id) const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  const ActionsAndProbs* StaticChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(double z) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
@@ -122,6 +146,7 @@ class BackgammonState : public State {
   void InformationStateAsNormalizedVector(
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  double QuickEvaluate() const override;
 
   // Setter function used for debugging and tests. Note: this does not set the
   // historical information properly, so Undo likely will not work on states
@@ -130,6 +155,13 @@ class BackgammonState : public State {
                 const std::vector<int>& bar, const std::vector<int>& scores,
                 const std::vector<std::vector<int>>& board);
 
+  // Writes / restores a direct binary snapshot of the state, used by
+  // BackgammonGame::SerializeStateBinary to avoid replaying the history when
+  // deserializing. As with SetState, the historical information is not part
+  // of the snapshot, so Undo will not work on a restored state.
+  void SerializeBinary(std::string* buffer) const;
+  void DeserializeBinary(const std::string& buffer);
+
   // Returns the opponent of the specified player.
   int Opponent(int player) const;
 
@@ -178,6 +210,11 @@ class BackgammonState : public State {
                                                    Action spiel_move) const;
   Action TranslateAction(int from1, int from2, bool use_high_die_first) const;
 
+  // The half-move counterparts: one checker move per action. The decoded
+  // move's hit flag is always false; ApplyCheckerMove detects hits itself.
+  Action CheckerMoveToHalfMoveAction(const CheckerMove& move) const;
+  CheckerMove HalfMoveActionToCheckerMove(Action action) const;
+
  protected:
   void DoApplyAction(Action move_id) override;
 
@@ -205,13 +242,23 @@ class BackgammonState : public State {
 
   bool ApplyCheckerMove(int player, const CheckerMove& move);
   void UndoCheckerMove(int player, const CheckerMove& move);
-  std::set<CheckerMove> LegalCheckerMoves(int player) const;
-  int RecLegalMoves(std::vector<CheckerMove> moveseq,
-                    std::set<std::vector<CheckerMove>>* movelist);
-  std::vector<Action> ProcessLegalMoves(
-      int max_moves, const std::set<std::vector<CheckerMove>>& movelist) const;
+
+  // The half-move branch of LegalActions.
+  std::vector<Action> HalfMoveLegalActions() const;
+
+  // The bookkeeping shared by the end of a full-move action and of a
+  // completed half-move turn: advances the turn counters and either grants
+  // the doubles extra turn or hands over to the chance player.
+  void EndPlayerTurn();
+
+  // Writes all distinct legal single-checker moves for the usable dice into
+  // the caller-provided buffer, which must hold at least
+  // kMaxSingleCheckerMoves entries, and returns how many were written.
+  // Identical dice (doubles) are collapsed and generate each move only once.
+  int LegalCheckerMoves(int player, CheckerMove* moves) const;
 
   ScoringType scoring_type_;  // Which rules apply when scoring the game.
+  bool halfmoves_;            // One checker move per action when set.
 
   int cur_player_;
   int prev_player_;
@@ -230,17 +277,20 @@ class BackgammonGame : public Game {
  public:
   explicit BackgammonGame(const GameParameters& params);
 
-  int NumDistinctActions() const override { return kNumDistinctActions; }
+  int NumDistinctActions() const override {
+    return halfmoves_ ? kNumHalfMoveActions : kNumDistinctActions;
+  }
 
   std::unique_ptr<State> NewInitialState() const override {
-    return std::unique_ptr<State>(
-        new BackgammonState(NumDistinctActions(), kNumPlayers, scoring_type_));
+    return std::unique_ptr<State>(new BackgammonState(
+        NumDistinctActions(), kNumPlayers, scoring_type_, halfmoves_));
   }
 
   int MaxChanceOutcomes() const override { return kNumChanceOutcomes; }
 
-  // There is arbitrarily chosen number to ensure the game is finite.
-  int MaxGameLength() const override { return 1000; }
+  // There is arbitrarily chosen number to ensure the game is finite. Each
+  // half-move turn takes up to two actions where a full-move turn takes one.
+  int MaxGameLength() const override { return halfmoves_ ? 2000 : 1000; }
 
   int NumPlayers() const override { return 2; }
   double MinUtility() const override { return -MaxUtility(); }
@@ -250,6 +300,12 @@ class BackgammonGame : public Game {
     return std::unique_ptr<Game>(new BackgammonGame(*this));
   }
 
+  // Binary serialization snapshots the state directly instead of replaying
+  // the (often several-hundred-move) history.
+  std::string SerializeStateBinary(const State& state) const override;
+  std::unique_ptr<State> DeserializeStateBinary(
+      const std::string& str) const override;
+
   std::vector<int> InformationStateNormalizedVectorShape() const override {
     // Encode each point on the board as four doubles:
     // - One double for whether there is one checker or not (1 or 0).
@@ -273,6 +329,7 @@ class BackgammonGame : public Game {
 
  private:
   ScoringType scoring_type_;  // Which rules apply when scoring the game.
+  bool halfmoves_;            // One checker move per action when set.
 };
 
 }  // namespace backgammon
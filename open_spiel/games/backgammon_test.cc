@@ -62,6 +62,51 @@ void BasicBackgammonTestsDoNotStartWithDoubles() {
   }
 }
 
+// Binary serialization snapshots the state directly rather than replaying
+// the history, so the restored state must match field for field.
+void BinarySerializationTest() {
+  std::mt19937 rng(2387);
+  std::unique_ptr<Game> game = LoadGame("backgammon");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (int i = 0; i < 60 && !state->IsTerminal(); ++i) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(
+          state
+              ->SampleChanceOutcome(
+                  std::uniform_real_distribution<double>(0.0, 1.0)(rng))
+              .first);
+    } else {
+      std::vector<Action> legal_actions = state->LegalActions();
+      state->ApplyAction(legal_actions[rng() % legal_actions.size()]);
+    }
+  }
+  std::unique_ptr<State> restored =
+      game->DeserializeStateBinary(game->SerializeStateBinary(*state));
+  SPIEL_CHECK_EQ(restored->ToString(), state->ToString());
+  SPIEL_CHECK_EQ(restored->CurrentPlayer(), state->CurrentPlayer());
+  if (!state->IsTerminal()) {
+    SPIEL_CHECK_TRUE(restored->LegalActions() == state->LegalActions());
+  }
+}
+
+void QuickEvaluatePipCountTest() {
+  std::unique_ptr<Game> game = LoadGame("backgammon");
+  std::unique_ptr<State> state = game->NewInitialState();
+  BackgammonState* bstate = static_cast<BackgammonState*>(state.get());
+  // The starting position is symmetric: 167 pips on each side.
+  SPIEL_CHECK_FLOAT_EQ(bstate->QuickEvaluate(), 0.0);
+
+  // O has borne off more than half its checkers (the board from
+  // NormalBearOffSituation below), so O leads the race and the value, from
+  // X's (player 0's) perspective, is negative.
+  bstate->SetState(
+      kXPlayerId, false, {1, 6}, {0, 0}, {0, 8},
+      {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 2, 2, 1, 9},
+       {7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}});
+  SPIEL_CHECK_LT(bstate->QuickEvaluate(), 0.0);
+}
+
 // Must bear-off furthest checker first.
 // Should have exactly one legal move here (since double moves are
 // two separate turns): 1-5, 0-5
@@ -273,6 +318,62 @@ void BearOffOutsideHome() {
       bstate->CheckerMovesToSpielMove({{17, 1, false}, {18, 6, false}})));
 }
 
+void BasicHalfMoveModeTests() {
+  auto game = LoadGame("backgammon", {{"halfmoves", GameParameter(true)}});
+  SPIEL_CHECK_EQ(game->NumDistinctActions(), kNumHalfMoveActions);
+  testing::RandomSimTestWithUndo(*game, 10);
+  testing::RandomSimTest(*game, 10);
+}
+
+// Same position as NormalBearOffSituation, but in half-move mode: the legal
+// actions are the distinct first checker moves of the full sequences there,
+// and a move that would strand the other die (19-6) is filtered out.
+void HalfMoveNormalBearOffSituation() {
+  auto game = LoadGame("backgammon", {{"halfmoves", GameParameter(true)}});
+  std::unique_ptr<State> state = game->NewInitialState();
+  BackgammonState* bstate = static_cast<BackgammonState*>(state.get());
+  bstate->SetState(
+      kXPlayerId, false, {1, 6}, {0, 0}, {0, 8},
+      {{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 2, 2, 1, 9},
+       {7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}});
+  std::cout << bstate->ToString();
+
+  std::vector<Action> legal_actions = bstate->LegalActions();
+  std::cout << "Legal half-move actions:" << std::endl;
+  for (Action action : legal_actions) {
+    std::cout << bstate->ActionToString(kXPlayerId, action) << std::endl;
+  }
+
+  // First half of the turn: 18-1, 18-6, 20-1, 21-1, 22-1, 23-1.
+  SPIEL_CHECK_EQ(legal_actions.size(), 6);
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({18, 1, false})));
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({18, 6, false})));
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({20, 1, false})));
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({21, 1, false})));
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({22, 1, false})));
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({23, 1, false})));
+
+  // Play 18-6; the same player must finish the turn with the 1.
+  bstate->ApplyAction(bstate->CheckerMoveToHalfMoveAction({18, 6, false}));
+  SPIEL_CHECK_EQ(bstate->CurrentPlayer(), kXPlayerId);
+  legal_actions = bstate->LegalActions();
+  SPIEL_CHECK_TRUE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({20, 1, false})));
+  SPIEL_CHECK_FALSE(ActionsContains(
+      legal_actions, bstate->CheckerMoveToHalfMoveAction({19, 6, false})));
+
+  // Finishing the turn hands over to the chance node for the next roll.
+  bstate->ApplyAction(bstate->CheckerMoveToHalfMoveAction({23, 1, false}));
+  SPIEL_CHECK_EQ(bstate->CurrentPlayer(), kChancePlayerId);
+}
+
 // +------|------+
 // |o...x.|xxxxox|
 // |....x.|xxxxox|
@@ -340,10 +441,14 @@ void DoublesBearOffOutsideHome() {
 int main(int argc, char** argv) {
   open_spiel::testing::LoadGameTest("backgammon");
   open_spiel::backgammon::BasicBackgammonTestsDoNotStartWithDoubles();
+  open_spiel::backgammon::BinarySerializationTest();
+  open_spiel::backgammon::QuickEvaluatePipCountTest();
   open_spiel::backgammon::BearOffFurthestFirstTest();
   open_spiel::backgammon::NormalBearOffSituation();
   open_spiel::backgammon::NormalBearOffSituation2();
   open_spiel::backgammon::BearOffOutsideHome();
   open_spiel::backgammon::DoublesBearOffOutsideHome();
   open_spiel::backgammon::BasicBackgammonTestsVaryScoring();
+  open_spiel::backgammon::BasicHalfMoveModeTests();
+  open_spiel::backgammon::HalfMoveNormalBearOffSituation();
 }
@@ -0,0 +1,61 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_BOARD_GEOMETRY_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_BOARD_GEOMETRY_H_
+
+#include <memory>
+#include <vector>
+
+// Memoized per-board-size geometry tables, shared by the board games
+// (hex, y, havannah). Neighbor lists and edge/corner classifications depend
+// only on the board size, so they are generated once per size and shared by
+// every Game and State of that size; states index the shared tables from
+// their innermost loops instead of recomputing geometry per call.
+//
+// Usage, from a game's translation unit:
+//
+//   const Geometry& GetGeometry(int board_size) {
+//     static BoardGeometryCache<Geometry> cache;
+//     return cache.Get(board_size, GenGeometry);
+//   }
+//
+// where Geometry is whatever table struct the game needs and GenGeometry
+// computes it for a given size.
+
+namespace open_spiel {
+
+template <typename Table>
+class BoardGeometryCache {
+ public:
+  // Returns the table for this board size, generating it on first use.
+  // The returned reference stays valid for the lifetime of the process.
+  template <typename Generator>
+  const Table& Get(int board_size, Generator generate) {
+    if (board_size >= tables_.size()) {
+      tables_.resize(board_size + 1);
+    }
+    if (tables_[board_size] == nullptr) {
+      tables_[board_size].reset(new Table(generate(board_size)));
+    }
+    return *tables_[board_size];
+  }
+
+ private:
+  std::vector<std::unique_ptr<Table>> tables_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_BOARD_GEOMETRY_H_
@@ -19,6 +19,9 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/zobrist.h"
+#include "open_spiel/spiel_scratch.h"
+
 namespace open_spiel {
 namespace breakthrough {
 namespace {
@@ -53,7 +56,11 @@ const GameType kGameType{
     /*provides_observation_as_normalized_vector=*/false,
     /*parameter_specification=*/
     {{"rows", {GameParameter::Type::kInt, false}},
-     {"columns", {GameParameter::Type::kInt, false}}}};
+     {"columns", {GameParameter::Type::kInt, false}}},
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new BreakthroughGame(params));
@@ -100,6 +107,18 @@ CellState OpponentState(CellState state) {
   return PlayerToState(1 - StateToPlayer(state));
 }
 
+// Returns the index of the lowest set bit, for walking the pieces of a
+// bitboard plane. Uses a De Bruijn sequence instead of compiler intrinsics
+// for portability.
+int LowestBitIndex(uint64_t b) {
+  static const int kIndex64[64] = {
+      0,  47, 1,  56, 48, 27, 2,  60, 57, 49, 41, 37, 28, 16, 3,  61,
+      54, 58, 35, 52, 50, 42, 21, 44, 38, 32, 29, 23, 17, 11, 4,  62,
+      46, 55, 26, 59, 40, 36, 15, 53, 34, 51, 20, 43, 31, 22, 10, 45,
+      25, 39, 14, 33, 19, 30, 9,  24, 13, 18, 8,  12, 7,  6,  5,  63};
+  return kIndex64[((b ^ (b - 1)) * uint64_t{0x03f79d71b4cb0a89}) >> 58];
+}
+
 std::string RowLabel(int rows, int row) {
   std::string label = "";
   label += static_cast<char>('1' + (rows - 1 - row));
@@ -119,8 +138,9 @@ BreakthroughState::BreakthroughState(int num_distinct_actions, int rows,
     : State(num_distinct_actions, kNumPlayers), rows_(rows), cols_(cols) {
   SPIEL_CHECK_GT(rows_, 1);
   SPIEL_CHECK_GT(cols_, 1);
+  // The board is stored as one 64-bit plane per player.
+  SPIEL_CHECK_LE(rows_ * cols_, 64);
 
-  board_ = std::vector<CellState>(rows_ * cols_, CellState::kEmpty);
   for (int r = 0; r < rows_; r++) {
     for (int c = 0; c < cols_; c++) {
       // Only use two rows if there are at least 6 rows.
@@ -148,12 +168,16 @@ int BreakthroughState::CurrentPlayer() const {
 }
 
 void BreakthroughState::DoApplyAction(Action action) {
-  std::vector<int> values(4, -1);
-  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
-  int r1 = values[0];
-  int c1 = values[1];
-  int dir = values[2];
-  bool capture = values[3] == 1;
+  // Per-thread scratch (see spiel_scratch.h): the digit buffer is reused
+  // across calls instead of allocated per action.
+  ScratchVector<int> values;
+  values->assign(4, -1);
+  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2},
+                        values.get());
+  int r1 = (*values)[0];
+  int c1 = (*values)[1];
+  int dir = (*values)[2];
+  bool capture = (*values)[3] == 1;
   int r2 = r1 + kDirRowOffsets[dir];
   int c2 = c1 + kDirColOffsets[dir];
 
@@ -178,11 +202,13 @@ void BreakthroughState::DoApplyAction(Action action) {
   SetBoard(r2, c2, board(r1, c1));
   SetBoard(r1, c1, CellState::kEmpty);
 
-  // Check for winner.
+  // Check for winner: reaching the home row or capturing the last piece.
   if (cur_player_ == 0 && r2 == (rows_ - 1)) {
     winner_ = 0;
   } else if (cur_player_ == 1 && r2 == 0) {
     winner_ = 1;
+  } else if (pieces_[1 - cur_player_] == 0) {
+    winner_ = cur_player_;
   }
 
   cur_player_ = NextPlayerRoundRobin(cur_player_, kNumPlayers);
@@ -214,35 +240,30 @@ std::string BreakthroughState::ActionToString(int player, Action action) const {
 std::vector<Action> BreakthroughState::LegalActions() const {
   std::vector<Action> movelist;
   const int player = CurrentPlayer();
-  CellState mystate = PlayerToState(player);
-  std::vector<int> action_bases = {rows_, cols_, kNumDirections, 2};
-  std::vector<int> action_values = {0, 0, 0, 0};
-
-  for (int r = 0; r < rows_; r++) {
-    for (int c = 0; c < cols_; c++) {
-      if (board(r, c) == mystate) {
-        for (int o = 0; o < kNumDirections / 2; o++) {
-          int dir = player * kNumDirections / 2 + o;
-          int rp = r + kDirRowOffsets[dir];
-          int cp = c + kDirColOffsets[dir];
-
-          if (InBounds(rp, cp)) {
-            action_values[0] = r;
-            action_values[1] = c;
-            action_values[2] = dir;
-            if (board(rp, cp) == CellState::kEmpty) {
-              // Regular move.
-              action_values[3] = 0;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
-            } else if ((o == 0 || o == 2) &&
-                       board(rp, cp) == OpponentState(mystate)) {
-              // Capture move (can only capture diagonally)
-              action_values[3] = 1;
-              movelist.push_back(
-                  RankActionMixedBase(action_bases, action_values));
-            }
-          }
+  const uint64_t occupied = board_[0] | board_[1];
+  const uint64_t opponent = board_[1 - player];
+
+  // Walk the set bits of the player's plane instead of scanning every cell.
+  // Bits are visited in increasing index order, which matches the previous
+  // (row, col) iteration order, and actions are ranked with the same mixed
+  // base {rows_, cols_, kNumDirections, 2} as before.
+  for (uint64_t pieces = board_[player]; pieces != 0; pieces &= pieces - 1) {
+    int cell = LowestBitIndex(pieces);
+    int r = cell / cols_;
+    int c = cell % cols_;
+    for (int o = 0; o < kNumDirections / 2; o++) {
+      int dir = player * kNumDirections / 2 + o;
+      int rp = r + kDirRowOffsets[dir];
+      int cp = c + kDirColOffsets[dir];
+
+      if (InBounds(rp, cp)) {
+        uint64_t to_mask = uint64_t{1} << (rp * cols_ + cp);
+        if (!(occupied & to_mask)) {
+          // Regular move.
+          movelist.push_back((cell * kNumDirections + dir) * 2);
+        } else if ((o == 0 || o == 2) && (opponent & to_mask)) {
+          // Capture move (can only capture diagonally)
+          movelist.push_back((cell * kNumDirections + dir) * 2 + 1);
         }
       }
     }
@@ -255,25 +276,27 @@ bool BreakthroughState::InBounds(int r, int c) const {
   return (r >= 0 && r < rows_ && c >= 0 && c < cols_);
 }
 
-std::string BreakthroughState::ToString() const {
-  std::string result = "";
-
+void BreakthroughState::AppendToString(std::string* str) const {
   for (int r = 0; r < rows_; r++) {
-    absl::StrAppend(&result, RowLabel(rows_, r));
+    absl::StrAppend(str, RowLabel(rows_, r));
 
     for (int c = 0; c < cols_; c++) {
-      absl::StrAppend(&result, CellToString(board(r, c)));
+      absl::StrAppend(str, CellToString(board(r, c)));
     }
 
-    result.append("\n");
+    str->append("\n");
   }
 
-  absl::StrAppend(&result, " ");
+  absl::StrAppend(str, " ");
   for (int c = 0; c < cols_; c++) {
-    absl::StrAppend(&result, ColLabel(c));
+    absl::StrAppend(str, ColLabel(c));
   }
-  absl::StrAppend(&result, "\n");
+  absl::StrAppend(str, "\n");
+}
 
+std::string BreakthroughState::ToString() const {
+  std::string result;
+  AppendToString(&result);
   return result;
 }
 
@@ -299,14 +322,14 @@ int BreakthroughState::observation_plane(int r, int c) const {
   return plane;
 }
 
-bool BreakthroughState::IsTerminal() const {
-  return (winner_ >= 0 || (pieces_[0] == 0 || pieces_[1] == 0));
-}
+// winner_ is folded in at move-application time (home row reached or last
+// piece captured), so terminality is a single stored flag.
+bool BreakthroughState::IsTerminal() const { return winner_ >= 0; }
 
 std::vector<double> BreakthroughState::Returns() const {
-  if (winner_ == 0 || pieces_[1] == 0) {
+  if (winner_ == 0) {
     return {1.0, -1.0};
-  } else if (winner_ == 1 || pieces_[0] == 0) {
+  } else if (winner_ == 1) {
     return {-1.0, 1.0};
   } else {
     return {0.0, 0.0};
@@ -338,12 +361,15 @@ void BreakthroughState::InformationStateAsNormalizedVector(
 }
 
 void BreakthroughState::UndoAction(int player, Action action) {
-  std::vector<int> values(4, -1);
-  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2}, &values);
-  int r1 = values[0];
-  int c1 = values[1];
-  int dir = values[2];
-  bool capture = values[3] == 1;
+  // As in DoApplyAction, the digit buffer is per-thread scratch.
+  ScratchVector<int> values;
+  values->assign(4, -1);
+  UnrankActionMixedBase(action, {rows_, cols_, kNumDirections, 2},
+                        values.get());
+  int r1 = (*values)[0];
+  int c1 = (*values)[1];
+  int dir = (*values)[2];
+  bool capture = (*values)[3] == 1;
   int r2 = r1 + kDirRowOffsets[dir];
   int c2 = c1 + kDirColOffsets[dir];
 
@@ -371,6 +397,24 @@ void BreakthroughState::UndoAction(int player, Action action) {
   history_.pop_back();
 }
 
+uint64_t BreakthroughState::HashValue() const {
+  // Unlike connect four, the board alone does not determine whose turn it
+  // is (captures break the piece-count parity), so the mover is mixed in.
+  constexpr uint64_t kHashSeed = 0x51ba97c2d3e6408fULL;
+  return zobrist::MixHash(
+      zobrist::MixHash(zobrist::MixHash(kHashSeed, board_[0]), board_[1]),
+      cur_player_);
+}
+
+double BreakthroughState::QuickEvaluate() const {
+  // Normalized piece-count difference: +1 when black (player 0) has the only
+  // pieces left, 0 when material is even. The side that wins the capture
+  // races almost always wins the game, so this is a good stand-in for a
+  // playout outcome.
+  return static_cast<double>(pieces_[0] - pieces_[1]) /
+         (pieces_[0] + pieces_[1]);
+}
+
 std::unique_ptr<State> BreakthroughState::Clone() const {
   return std::unique_ptr<State>(new BreakthroughState(*this));
 }
@@ -431,6 +475,18 @@ std::unique_ptr<State> BreakthroughGame::DeserializeState(
     }
   }
 
+  // Recover the cached winner from the reconstructed board, mirroring the
+  // checks DoApplyAction makes at move-application time.
+  for (int c = 0; c < cols_; c++) {
+    if (bstate->board(rows_ - 1, c) == CellState::kBlack) bstate->SetWinner(0);
+    if (bstate->board(0, c) == CellState::kWhite) bstate->SetWinner(1);
+  }
+  if (bstate->pieces(0) == 0) {
+    bstate->SetWinner(1);
+  } else if (bstate->pieces(1) == 0) {
+    bstate->SetWinner(0);
+  }
+
   return state;
 }
 
@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_BREAKTHROUGH_H_
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +27,9 @@
 // Breakthrough, a game used in the general game-play competition
 // http://en.wikipedia.org/wiki/Breakthrough_%28board_game%29
 //
+// The board is stored as one bitboard plane per player, so boards with up to
+// 64 cells are supported.
+//
 // Parameters:
 //       "columns"    int     number of columns on the board   (default = 8)
 //       "rows"       int     number of rows on the board      (default = 8)
@@ -53,6 +57,7 @@ class BreakthroughState : public State {
   int CurrentPlayer() const override;
   std::string ActionToString(int player, Action action) const override;
   std::string ToString() const override;
+  void AppendToString(std::string* str) const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(int player) const override;
@@ -60,11 +65,28 @@ class BreakthroughState : public State {
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(int player, Action action) override;
+  uint64_t HashValue() const override;
+  double QuickEvaluate() const override;
 
   bool InBounds(int r, int c) const;
-  void SetBoard(int r, int c, CellState cs) { board_[r * cols_ + c] = cs; }
+  void SetBoard(int r, int c, CellState cs) {
+    uint64_t mask = uint64_t{1} << (r * cols_ + c);
+    board_[0] &= ~mask;
+    board_[1] &= ~mask;
+    if (cs == CellState::kBlack) {
+      board_[0] |= mask;
+    } else if (cs == CellState::kWhite) {
+      board_[1] |= mask;
+    }
+  }
   void SetPieces(int idx, int value) { pieces_[idx] = value; }
-  CellState board(int row, int col) const { return board_[row * cols_ + col]; }
+  void SetWinner(int winner) { winner_ = winner; }
+  CellState board(int row, int col) const {
+    uint64_t mask = uint64_t{1} << (row * cols_ + col);
+    if (board_[0] & mask) return CellState::kBlack;
+    if (board_[1] & mask) return CellState::kWhite;
+    return CellState::kEmpty;
+  }
   int pieces(int idx) const { return pieces_[idx]; }
   int rows() const { return rows_; }
   int cols() const { return cols_; }
@@ -83,7 +105,9 @@ class BreakthroughState : public State {
   std::array<int, 2> pieces_;
   int rows_ = -1;
   int cols_ = -1;
-  std::vector<CellState> board_;  // for (row,col) we use row*cols_ + col.
+  // One bitboard plane per player: bit (row * cols_ + col) of plane p is set
+  // iff player p has a piece at (row, col).
+  std::array<uint64_t, kNumPlayers> board_ = {{0, 0}};
 };
 
 class BreakthroughGame : public Game {
@@ -31,6 +31,18 @@ void BasicSerializationTest() {
   SPIEL_CHECK_EQ(state->ToString(), state2->ToString());
 }
 
+void QuickEvaluateTest() {
+  BreakthroughGame game({});
+  std::unique_ptr<State> state = game.NewInitialState();
+  BreakthroughState* bstate = static_cast<BreakthroughState*>(state.get());
+  // The starting position has even material.
+  SPIEL_CHECK_FLOAT_EQ(bstate->QuickEvaluate(), 0.0);
+  // 10 black pieces against 5 white: (10 - 5) / 15.
+  bstate->SetPieces(0, 10);
+  bstate->SetPieces(1, 5);
+  SPIEL_CHECK_FLOAT_EQ(bstate->QuickEvaluate(), 1.0 / 3.0);
+}
+
 void BasicBreakthroughTests() {
   testing::LoadGameTest("breakthrough");
   testing::NoChanceOutcomesTest(*LoadGame("breakthrough"));
@@ -43,5 +55,6 @@ void BasicBreakthroughTests() {
 
 int main(int argc, char** argv) {
   open_spiel::breakthrough::BasicSerializationTest();
+  open_spiel::breakthrough::QuickEvaluateTest();
   open_spiel::breakthrough::BasicBreakthroughTests();
 }
@@ -41,12 +41,27 @@ void DeserializeStateTest() {
   SPIEL_CHECK_EQ(state->ToString(), "AKQJ.543.QJ8.T92 97532.A2.9.QJ853 ");
 }
 
+void ScoreCacheTest() {
+  // Scoring the same layouts twice (same deal, same redeal seed) is served
+  // from the memoized double-dummy tables the second time and must give
+  // identical results.
+  const std::string deal = "AKQJ.543.QJ8.T92 97532.A2.9.QJ853 2N-Pass";
+  auto game1 = LoadGame("bridge_uncontested_bidding(rng_seed=42)");
+  auto state1 = game1->DeserializeState(deal);
+  auto game2 = LoadGame("bridge_uncontested_bidding(rng_seed=42)");
+  auto state2 = game2->DeserializeState(deal);
+  SPIEL_CHECK_TRUE(state1->IsTerminal());
+  SPIEL_CHECK_EQ(state1->ToString(), state2->ToString());
+  SPIEL_CHECK_EQ(state1->Returns()[0], state2->Returns()[0]);
+}
+
 }  // namespace
 }  // namespace bridge
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::bridge::DeserializeStateTest();
+  open_spiel::bridge::ScoreCacheTest();
   open_spiel::bridge::ScoringTests();
   open_spiel::bridge::BasicGameTests();
 }
@@ -15,6 +15,8 @@
 #include "open_spiel/games/bridge_uncontested_bidding.h"
 
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #include "open_spiel/games/bridge/double_dummy_solver/include/dll.h"
 #include "open_spiel/games/bridge/bridge_scoring.h"
@@ -78,6 +80,71 @@ bool Is2NTDeal(const Deal& deal) {
 }
 bool NoFilter(const Deal& deal) { return true; }
 
+// Double-dummy analysis dominates the cost of scoring a deal. The heavy
+// lifting (alpha-beta over tricks with transposition tables and quick-trick
+// shortcuts) happens in the DDS solver behind CalcDDtable; what large
+// bidding-policy evaluations expose is that the same layout is re-analysed
+// for every terminal auction reached on a deal. The trick tables are
+// therefore memoized, keyed on the remaining-card bitsets of the four hands.
+
+struct DealLayout {
+  std::array<unsigned int, kNumHands * kNumSuits> holdings;
+  bool operator==(const DealLayout& other) const {
+    return holdings == other.holdings;
+  }
+};
+
+struct DealLayoutHash {
+  std::size_t operator()(const DealLayout& layout) const {
+    // SplitMix64-style mixing over the 16 suit bitsets.
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for (unsigned int holding : layout.holdings) {
+      h ^= holding;
+      h *= 0xbf58476d1ce4e5b9ULL;
+      h ^= h >> 31;
+    }
+    return static_cast<std::size_t>(h);
+  }
+};
+
+// Bounded so that runs over millions of distinct deals cannot grow without
+// limit; eviction simply starts the cache afresh.
+constexpr int kMaxDealCacheEntries = 1 << 18;
+
+ddTableResults AnalyzeDeal(const ddTableDeal& dd_table_deal) {
+  static std::once_flag dds_init;
+  static std::mutex cache_mutex;
+  static std::unordered_map<DealLayout, ddTableResults, DealLayoutHash> cache;
+
+  DealLayout layout;
+  for (int hand = 0; hand < kNumHands; ++hand) {
+    for (int suit = 0; suit < kNumSuits; ++suit) {
+      layout.holdings[hand * kNumSuits + suit] = dd_table_deal.cards[hand][suit];
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto iter = cache.find(layout);
+    if (iter != cache.end()) return iter->second;
+  }
+
+  std::call_once(dds_init, []() { DDS_EXTERNAL(SetMaxThreads)(0); });
+  ddTableResults results;
+  const int return_code = DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &results);
+  if (return_code != RETURN_NO_FAULT) {
+    char error_message[80];
+    DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
+    SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache.size() >= kMaxDealCacheEntries) cache.clear();
+    cache.emplace(layout, results);
+  }
+  return results;
+}
+
 }  // namespace
 
 int UncontestedBiddingState::CurrentPlayer() const {
@@ -262,17 +329,8 @@ void UncontestedBiddingState::ScoreDeal() {
       }
     }
 
-    // Analyze the deal.
-    DDS_EXTERNAL(SetMaxThreads)(0);
-    struct ddTableResults results;
-    const int return_code = DDS_EXTERNAL(CalcDDtable)(dd_table_deal, &results);
-
-    // Check for errors.
-    if (return_code != RETURN_NO_FAULT) {
-      char error_message[80];
-      DDS_EXTERNAL(ErrorMessage)(return_code, error_message);
-      SpielFatalError(absl::StrCat("double_dummy_solver:", error_message));
-    }
+    // Analyze the deal (memoized; see AnalyzeDeal above).
+    const ddTableResults results = AnalyzeDeal(dd_table_deal);
 
     // Compute the score and update the total.
     if (!passed_out) {
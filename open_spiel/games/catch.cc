@@ -40,7 +40,16 @@ const GameType kGameType{
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
     {{"rows", {GameParameter::Type::kInt, false}},
-     {"columns", {GameParameter::Type::kInt, false}}}};
+     {"columns", {GameParameter::Type::kInt, false}}},
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/false,
+    /*history_independent_state=*/false,
+    /*provides_quick_evaluate=*/false,
+    /*provides_canonical_key=*/false,
+    /*state_independent_actions=*/true};
+
+// The fixed paddle action set (see State::StaticLegalActions).
+const std::vector<Action> kPaddleActions = {0, 1, 2};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new CatchGame(params));
@@ -67,7 +76,8 @@ std::string StateToString(CellState state) {
 CatchState::CatchState(const CatchGame& game)
     : State(/*num_distinct_actions=*/kNumActions,
             /*num_players=*/kNumPlayers),
-      game_(game) {}
+      game_(game),
+      observation_plane_(game.NumRows() * game.NumColumns(), 0.) {}
 
 int CatchState::CurrentPlayer() const {
   if (!initialized_) return kChancePlayerId;
@@ -86,6 +96,12 @@ std::vector<Action> CatchState::LegalActions() const {
   return moves;
 }
 
+const std::vector<Action>* CatchState::StaticLegalActions() const {
+  // Left, stay and right are always legal once the ball is in play.
+  if (!initialized_ || IsTerminal()) return nullptr;
+  return &kPaddleActions;
+}
+
 ActionsAndProbs CatchState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(!initialized_);
   ActionsAndProbs action_and_probs;
@@ -158,13 +174,26 @@ std::string CatchState::Observation(int player) const {
 void CatchState::ObservationAsNormalizedVector(
     int player, std::vector<double>* values) const {
   SPIEL_CHECK_EQ(player, 0);
+  *values = observation_plane_;
+}
 
-  values->resize(game_.NumRows() * game_.NumColumns());
-  std::fill(values->begin(), values->end(), 0.);
-  if (initialized_) {
-    (*values)[ball_row_ * game_.NumColumns() + ball_col_] = 1.0;
-    (*values)[(game_.NumRows() - 1) * game_.NumColumns() + paddle_col_] = 1.0;
-  }
+void CatchState::ObservationAsNormalizedVector(int player,
+                                               double* buffer) const {
+  SPIEL_CHECK_EQ(player, 0);
+  std::copy(observation_plane_.begin(), observation_plane_.end(), buffer);
+}
+
+void CatchState::StepOutputs(int player, StepView* out) const {
+  SPIEL_CHECK_EQ(player, 0);
+  const bool done = IsTerminal();
+  out->done = done;
+  std::copy(observation_plane_.begin(), observation_plane_.end(),
+            out->observation);
+  // Left, stay and right are the only actions, so the mask is one constant
+  // word while the ball is in play (and zero at the chance node and at
+  // terminals, matching LegalActionsBitset).
+  out->legal_mask[0] = (!initialized_ || done) ? 0 : 0x7;
+  out->rewards[0] = !done ? 0.0 : (ball_col_ == paddle_col_ ? 1.0 : -1.0);
 }
 
 void CatchState::InformationStateAsNormalizedVector(
@@ -183,7 +212,15 @@ void CatchState::InformationStateAsNormalizedVector(
   }
 }
 
+void CatchState::SetObservationCells(double value) {
+  if (!initialized_) return;
+  observation_plane_[ball_row_ * game_.NumColumns() + ball_col_] = value;
+  observation_plane_[(game_.NumRows() - 1) * game_.NumColumns() +
+                     paddle_col_] = value;
+}
+
 void CatchState::UndoAction(int player, Action move) {
+  SetObservationCells(0.);
   if (player == kChancePlayerId) {
     initialized_ = false;
     return;
@@ -193,6 +230,7 @@ void CatchState::UndoAction(int player, Action move) {
       std::min(std::max(paddle_col_ - direction, 0), game_.NumColumns() - 1);
   --ball_row_;
   history_.pop_back();
+  SetObservationCells(1.);
 }
 
 std::unique_ptr<State> CatchState::Clone() const {
@@ -200,6 +238,9 @@ std::unique_ptr<State> CatchState::Clone() const {
 }
 
 void CatchState::DoApplyAction(Action move) {
+  // Patch the observation plane around the move: only the ball and paddle
+  // cells change, so the board is never rebuilt.
+  SetObservationCells(0.);
   if (!initialized_) {
     initialized_ = true;
     ball_col_ = move;
@@ -211,6 +252,7 @@ void CatchState::DoApplyAction(Action move) {
     paddle_col_ =
         std::min(std::max(paddle_col_ + direction, 0), game_.NumColumns() - 1);
   }
+  SetObservationCells(1.);
 }
 
 CatchGame::CatchGame(const GameParameters& params)
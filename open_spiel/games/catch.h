@@ -73,11 +73,24 @@ class CatchState : public State {
   std::string Observation(int player) const override;
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
+  void ObservationAsNormalizedVector(int player,
+                                     double* buffer) const override;
   void InformationStateAsNormalizedVector(
       int player, std::vector<double>* values) const override;
+  void StepOutputs(int player, StepView* out) const override;
+
+  // Const view of the normalized observation plane. The state maintains this
+  // buffer incrementally — a move patches the ball and paddle cells rather
+  // than rebuilding the board — so reading it here is free of both the
+  // rebuild and the copy that ObservationAsNormalizedVector makes. The view
+  // is invalidated by the next (Do)ApplyAction or UndoAction.
+  const std::vector<double>& ObservationPlane() const {
+    return observation_plane_;
+  }
   std::unique_ptr<State> Clone() const override;
   void UndoAction(int player, Action move) override;
   std::vector<Action> LegalActions() const override;
+  const std::vector<Action>* StaticLegalActions() const override;
   ActionsAndProbs ChanceOutcomes() const override;
   CellState BoardAt(int row, int column) const;
 
@@ -85,12 +98,20 @@ class CatchState : public State {
   void DoApplyAction(Action move) override;
 
  private:
+  // Writes `value` at the ball and paddle cells of the observation plane.
+  // Every mutation is bracketed by a clear (0) before and a set (1) after.
+  void SetObservationCells(double value);
+
   const CatchGame& game_;
 
   bool initialized_ = false;
   int ball_row_ = -1;
   int ball_col_ = -1;
   int paddle_col_ = -1;
+
+  // Incrementally maintained normalized observation plane; all zero until
+  // the chance node initializes the ball.
+  std::vector<double> observation_plane_;
 };
 
 // Game object.
@@ -85,6 +85,68 @@ void PlayAndWinTest() {
   SPIEL_CHECK_EQ(state->PlayerReturn(0), 1);
 }
 
+void ObservationPlaneUndoTest() {
+  // The observation plane is patched incrementally on both apply and undo;
+  // check that undo restores it exactly. (GetAllStatesTest above already
+  // cross-checks the plane against the string representation on the apply
+  // path, for every reachable state.)
+  CatchGame game({});
+  CatchState state(game);
+  state.ApplyAction(1);
+  std::vector<double> after_chance = state.ObservationPlane();
+  state.ApplyAction(2);  // Right.
+  std::vector<double> obs;
+  state.ObservationAsNormalizedVector(0, &obs);
+  SPIEL_CHECK_TRUE(state.ObservationPlane() == obs);
+  state.UndoAction(0, 2);
+  SPIEL_CHECK_TRUE(state.ObservationPlane() == after_chance);
+  state.UndoAction(kChancePlayerId, 1);
+  SPIEL_CHECK_TRUE(state.ObservationPlane() ==
+                   std::vector<double>(after_chance.size(), 0.));
+}
+
+void StaticLegalActionsTest() {
+  CatchGame game({});
+  SPIEL_CHECK_TRUE(game.GetType().state_independent_actions);
+  auto state = game.NewInitialState();
+  // The initialization chance node has no fixed table.
+  SPIEL_CHECK_TRUE(state->StaticLegalActions() == nullptr);
+  state->ApplyAction(3);
+  while (!state->IsTerminal()) {
+    const std::vector<Action>* fixed = state->StaticLegalActions();
+    SPIEL_CHECK_TRUE(fixed != nullptr);
+    SPIEL_CHECK_TRUE(*fixed == state->LegalActions());
+    state->ApplyAction(1);  // Stay.
+  }
+  SPIEL_CHECK_TRUE(state->StaticLegalActions() == nullptr);
+}
+
+void StepOutputsTest() {
+  // The fused StepOutputs override must agree with the four individual
+  // calls at every step of an episode.
+  CatchGame game({});
+  auto state = game.NewInitialState();
+  state->ApplyAction(2);
+  std::vector<double> observation(game.ObservationNormalizedVectorSize());
+  std::vector<uint64_t> mask(state->LegalActionsBitsetWords());
+  std::vector<double> rewards(game.NumPlayers());
+  StepView view;
+  view.observation = observation.data();
+  view.legal_mask = mask.data();
+  view.rewards = rewards.data();
+  while (true) {
+    state->StepOutputs(0, &view);
+    SPIEL_CHECK_EQ(view.done, state->IsTerminal());
+    SPIEL_CHECK_TRUE(observation == state->ObservationAsNormalizedVector(0));
+    std::vector<uint64_t> expected_mask(mask.size());
+    state->LegalActionsBitset(expected_mask.data());
+    SPIEL_CHECK_TRUE(mask == expected_mask);
+    SPIEL_CHECK_TRUE(rewards == state->Rewards());
+    if (view.done) break;
+    state->ApplyAction(1);  // Stay.
+  }
+}
+
 void ToStringTest() {
   CatchGame game({});
   auto state = game.NewInitialState();
@@ -110,5 +172,8 @@ int main(int argc, char** argv) {
   open_spiel::catch_::BasicCatchTests();
   open_spiel::catch_::GetAllStatesTest();
   open_spiel::catch_::PlayAndWinTest();
+  open_spiel::catch_::ObservationPlaneUndoTest();
+  open_spiel::catch_::StaticLegalActionsTest();
+  open_spiel::catch_::StepOutputsTest();
   open_spiel::catch_::ToStringTest();
 }
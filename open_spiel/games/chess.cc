@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -39,7 +42,11 @@ const GameType kGameType{
     /*provides_information_state_as_normalized_vector=*/true,
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
+    /*parameter_specification=*/{},  // no parameters
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/true,
 };
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
@@ -48,20 +55,17 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
-// Adds a plane to the information state vector corresponding to the presence
-// and absence of the given piece type and colour at each square.
-void AddPieceTypePlane(Color color, PieceType piece_type,
-                       const StandardChessBoard& board,
-                       std::vector<double>* values) {
-  for (int8_t y = 0; y < BoardSize(); ++y) {
-    for (int8_t x = 0; x < BoardSize(); ++x) {
-      Piece piece_on_board = board.at(Square{x, y});
-      values->push_back(piece_on_board.color == color &&
-                                piece_on_board.type == piece_type
-                            ? 1.0
-                            : 0.0);
-    }
-  }
+// Number of piece-configuration planes: a white and a black plane per piece
+// type, plus the empty plane.
+constexpr int kNumPiecePlanes = 13;
+
+// Index of the plane that is 1 at this piece's square: white and black
+// planes alternate in kPieceTypes order, and the empty plane comes last.
+int PiecePlaneIndex(const Piece& piece) {
+  if (piece.type == PieceType::kEmpty) return kNumPiecePlanes - 1;
+  // PieceType enumerators are 1-based and in kPieceTypes order.
+  return 2 * (static_cast<int>(piece.type) - 1) +
+         (piece.color == Color::kBlack ? 1 : 0);
 }
 
 // Adds a uniform scalar plane scaled with min and max.
@@ -81,7 +85,8 @@ ChessState::ChessState()
     : State(chess::NumDistinctActions(), chess::NumPlayers()),
       start_board_(MakeDefaultBoard()),
       current_board_(start_board_) {
-  repetitions_[current_board_.HashValue()] = 1;
+  hash_history_.push_back(current_board_.HashValue());
+  InitPiecePlanes();
 }
 
 ChessState::ChessState(const std::string& fen)
@@ -90,14 +95,58 @@ ChessState::ChessState(const std::string& fen)
   SPIEL_CHECK_TRUE(maybe_board);
   start_board_ = *maybe_board;
   current_board_ = start_board_;
-  repetitions_[current_board_.HashValue()] = 1;
+  hash_history_.push_back(current_board_.HashValue());
+  InitPiecePlanes();
+}
+
+void ChessState::InitPiecePlanes() {
+  piece_planes_.assign(kNumPiecePlanes * BoardSize() * BoardSize(), 0.0);
+  for (int8_t y = 0; y < BoardSize(); ++y) {
+    for (int8_t x = 0; x < BoardSize(); ++x) {
+      PatchPiecePlanes(Square{x, y});
+    }
+  }
+}
+
+void ChessState::PatchPiecePlanes(const Square& sq) {
+  const int square_index = sq.y * BoardSize() + sq.x;
+  const int num_squares = BoardSize() * BoardSize();
+  for (int plane = 0; plane < kNumPiecePlanes; ++plane) {
+    piece_planes_[plane * num_squares + square_index] = 0.0;
+  }
+  piece_planes_[PiecePlaneIndex(Board().at(sq)) * num_squares + square_index] =
+      1.0;
+}
+
+void ChessState::PatchMoveSquares(const Move& move) {
+  PatchPiecePlanes(move.from);
+  PatchPiecePlanes(move.to);
+  // A pawn capturing en passant removes a pawn from a third square. Any
+  // file-changing move patches that square unconditionally: a patch just
+  // re-reads the board, so patching a square the move did not touch is
+  // harmless, and this avoids re-deriving the en passant conditions here.
+  if (move.from.x != move.to.x) {
+    PatchPiecePlanes(Square{move.to.x, move.from.y});
+  }
+  if (move.is_castling) {
+    // The rook's source and destination; move.to carries the rank and
+    // distinguishes the left from the right castle.
+    if (move.to.x == 2) {
+      PatchPiecePlanes(Square{0, move.to.y});
+      PatchPiecePlanes(Square{3, move.to.y});
+    } else {
+      PatchPiecePlanes(Square{7, move.to.y});
+      PatchPiecePlanes(Square{5, move.to.y});
+    }
+  }
 }
 
 void ChessState::DoApplyAction(Action action) {
   Move move = ActionToMove(action);
   moves_history_.push_back(move);
-  Board().ApplyMove(move);
-  ++repetitions_[current_board_.HashValue()];
+  Board().MakeMove(move);
+  hash_history_.push_back(current_board_.HashValue());
+  PatchMoveSquares(move);
 }
 
 std::vector<Action> ChessState::LegalActions() const {
@@ -110,6 +159,12 @@ std::vector<Action> ChessState::LegalActions() const {
   return actions;
 }
 
+void ChessState::ForEachLegalAction(
+    const std::function<bool(Action)>& yield) const {
+  Board().GenerateLegalMoves(
+      [&yield](const Move& move) -> bool { return yield(MoveToAction(move)); });
+}
+
 std::string ChessState::ActionToString(int player, Action action) const {
   Move move = ActionToMove(action);
   return move.ToSAN(Board());
@@ -142,20 +197,12 @@ void ChessState::InformationStateAsNormalizedVector(
   values->resize(0);
   values->reserve(vector_size);
 
-  // Piece cconfiguration.
-  for (const auto& piece_type : kPieceTypes) {
-    AddPieceTypePlane(Color::kWhite, piece_type, Board(), values);
-    AddPieceTypePlane(Color::kBlack, piece_type, Board(), values);
-  }
-
-  AddPieceTypePlane(Color::kEmpty, PieceType::kEmpty, Board(), values);
-
-  const auto entry = repetitions_.find(Board().HashValue());
-  SPIEL_CHECK_FALSE(entry == repetitions_.end());
-  int repetitions = entry->second;
+  // Piece configuration, straight from the incrementally maintained planes
+  // (callers that can use a view read PiecePlanes() and skip this copy).
+  values->insert(values->end(), piece_planes_.begin(), piece_planes_.end());
 
   // Num repetitions for the current board.
-  AddScalarPlane(repetitions, 1, 3, values);
+  AddScalarPlane(RepetitionCount(), 1, 3, values);
 
   // Side to play.
   AddScalarPlane(ColorToPlayer(Board().ToPlay()), 0, 1, values);
@@ -181,22 +228,58 @@ std::unique_ptr<State> ChessState::Clone() const {
   return std::unique_ptr<State>(new ChessState(*this));
 }
 
+double ChessState::QuickEvaluate() const {
+  // Normalized material difference using the standard piece values (kings
+  // ignored): +1 when black (player 0) has the only material left, 0 when
+  // material is even.
+  static constexpr int kPieceValues[] = {/*king=*/0,   /*queen=*/9,
+                                         /*rook=*/5,   /*bishop=*/3,
+                                         /*knight=*/3, /*pawn=*/1};
+  int material[2] = {0, 0};
+  for (int i = 0; i < kPieceTypes.size(); ++i) {
+    for (Color color : {Color::kBlack, Color::kWhite}) {
+      uint64_t pieces = Board().piece_bitboard(color, kPieceTypes[i]);
+      for (; pieces != 0; pieces &= pieces - 1) {
+        material[ColorToPlayer(color)] += kPieceValues[i];
+      }
+    }
+  }
+  const int total_material = material[0] + material[1];
+  if (total_material == 0) return 0;
+  return static_cast<double>(material[0] - material[1]) / total_material;
+}
+
 void ChessState::UndoAction(int player, Action action) {
-  // TODO: Make this fast by storing undo info in another stack.
   SPIEL_CHECK_GE(moves_history_.size(), 1);
-  --repetitions_[current_board_.HashValue()];
+  const Move move = moves_history_.back();
+  hash_history_.pop_back();
   moves_history_.pop_back();
   history_.pop_back();
-  current_board_ = start_board_;
-  for (const Move& move : moves_history_) {
-    current_board_.ApplyMove(move);
-  }
+  // Moves are applied with MakeMove, so the board can reverse the last one
+  // directly instead of replaying the whole game.
+  current_board_.UndoMove();
+  // The undone move touched the same squares it touched on the way in.
+  PatchMoveSquares(move);
 }
 
 bool ChessState::IsRepetitionDraw() const {
-  const auto entry = repetitions_.find(Board().HashValue());
-  SPIEL_CHECK_FALSE(entry == repetitions_.end());
-  return entry->second >= kNumRepetitionsToDraw;
+  return RepetitionCount() >= kNumRepetitionsToDraw;
+}
+
+int ChessState::RepetitionCount() const {
+  int current = static_cast<int>(hash_history_.size()) - 1;
+  // Nothing before the last capture or pawn move can repeat, so we only scan
+  // back that far. The irreversible move counter can exceed the stored
+  // history when the game started from a FEN position mid-game.
+  int first = std::max(0, current - Board().IrreversibleMoveCounter());
+  uint64_t current_hash = hash_history_[current];
+  int count = 0;
+  // Positions with different side to move hash differently, so we only look
+  // at every other entry.
+  for (int i = current; i >= first; i -= 2) {
+    if (hash_history_[i] == current_hash) ++count;
+  }
+  return count;
 }
 
 Optional<std::vector<double>> ChessState::MaybeFinalReturns() const {
@@ -239,5 +322,39 @@ Optional<std::vector<double>> ChessState::MaybeFinalReturns() const {
 
 ChessGame::ChessGame(const GameParameters& params) : Game(kGameType, params) {}
 
+std::vector<Action> ChessGame::PossibleDistinctActions() const {
+  std::vector<Action> actions;
+  for (int8_t y1 = 0; y1 < BoardSize(); ++y1) {
+    for (int8_t x1 = 0; x1 < BoardSize(); ++x1) {
+      const Square from{x1, y1};
+      for (int8_t y2 = 0; y2 < BoardSize(); ++y2) {
+        for (int8_t x2 = 0; x2 < BoardSize(); ++x2) {
+          if (x1 == x2 && y1 == y2) continue;
+          const int dx = std::abs(x2 - x1);
+          const int dy = std::abs(y2 - y1);
+          const bool queen_move = x1 == x2 || y1 == y2 || dx == dy;
+          const bool knight_move =
+              (dx == 1 && dy == 2) || (dx == 2 && dy == 1);
+          if (!queen_move && !knight_move) continue;
+          const Square to{x2, y2};
+          actions.push_back(MoveToAction(Move(from, to)));
+          // One rank forward (straight or capturing diagonally) onto the
+          // last rank of either colour can additionally be a promotion.
+          if (dx <= 1 && dy == 1 &&
+              ((y1 == 6 && y2 == 7) || (y1 == 1 && y2 == 0))) {
+            for (PieceType promotion_type :
+                 {PieceType::kQueen, PieceType::kRook, PieceType::kBishop,
+                  PieceType::kKnight}) {
+              actions.push_back(MoveToAction(Move(from, to, promotion_type)));
+            }
+          }
+        }
+      }
+    }
+  }
+  std::sort(actions.begin(), actions.end());
+  return actions;
+}
+
 }  // namespace chess
 }  // namespace open_spiel
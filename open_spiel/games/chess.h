@@ -182,6 +182,12 @@ class ChessState : public State {
     return IsTerminal() ? kTerminalPlayerId : ColorToPlayer(Board().ToPlay());
   }
   std::vector<Action> LegalActions() const override;
+  // Yields actions straight out of move generation (in generation order, not
+  // the sorted LegalActions() order); when yield returns false the remaining
+  // moves are never generated, up to ChessBoard::MoveYieldFn's best-effort
+  // guarantee.
+  void ForEachLegalAction(
+      const std::function<bool(Action)>& yield) const override;
   std::string ActionToString(int player, Action action) const override;
   std::string ToString() const override;
 
@@ -197,10 +203,24 @@ class ChessState : public State {
   std::unique_ptr<State> Clone() const override;
   void UndoAction(int player, Action action) override;
 
+  uint64_t HashValue() const override { return Board().HashValue(); }
+  double QuickEvaluate() const override;
+
   // Current board.
   StandardChessBoard& Board() { return current_board_; }
   const StandardChessBoard& Board() const { return current_board_; }
 
+  // Const view of the 13 piece-configuration planes of the information
+  // state tensor (a white and a black plane per piece type, then the empty
+  // plane), in the layout InformationStateAsNormalizedVector serves them.
+  // The state maintains this buffer incrementally — each move patches only
+  // the squares it touches (from, to, the en passant capture square, the
+  // castling rook squares) instead of rescanning the board — so reading it
+  // here is free of both the rebuild and the copy. The view tracks moves
+  // made through ApplyAction/UndoAction and is invalidated by them; it does
+  // not see moves made directly on Board().
+  const std::vector<double>& PiecePlanes() const { return piece_planes_; }
+
  protected:
   void DoApplyAction(Action action) override;
 
@@ -209,8 +229,25 @@ class ChessState : public State {
   // board position has already appeared twice in the history).
   bool IsRepetitionDraw() const;
 
+  // How many times the current position has appeared in the game, including
+  // the current occurrence. Only positions since the last irreversible move
+  // (capture or pawn move) are scanned, since nothing before it can repeat;
+  // the board's irreversible move counter tells us how far back that is.
+  int RepetitionCount() const;
+
   Optional<std::vector<double>> MaybeFinalReturns() const;
 
+  // Rebuilds piece_planes_ from the current board (used once per
+  // construction; moves are patched in afterwards).
+  void InitPiecePlanes();
+
+  // Re-derives the 13 plane entries for one square from the current board.
+  void PatchPiecePlanes(const Square& sq);
+
+  // Patches every square `move` can have touched. Safe to call with the
+  // board on either side of the move, so apply and undo share it.
+  void PatchMoveSquares(const Move& move);
+
   // We have to store every move made to check for repetitions and to implement
   // undo. We store the current board position as an optimization.
   std::vector<Move> moves_history_;
@@ -220,18 +257,12 @@ class ChessState : public State {
   // We store the current board position as an optimization.
   StandardChessBoard current_board_;
 
-  // RepetitionTable records how many times the given hash exists in the history
-  // stack (including the current board).
-  // We are already indexing by board hash, so there is no need to hash that
-  // hash again, so we use a custom passthrough hasher.
-  class PassthroughHash {
-   public:
-    std::size_t operator()(uint64_t x) const {
-      return static_cast<std::size_t>(x);
-    }
-  };
-  using RepetitionTable = std::unordered_map<uint64_t, int, PassthroughHash>;
-  RepetitionTable repetitions_;
+  // Board hash after every move made so far, including the start position.
+  // Repetition checks scan the tail of this stack.
+  std::vector<uint64_t> hash_history_;
+
+  // Incrementally maintained piece-configuration planes; see PiecePlanes().
+  std::vector<double> piece_planes_;
 };
 
 // Game object.
@@ -241,6 +272,9 @@ class ChessGame : public Game {
   int NumDistinctActions() const override {
     return chess::NumDistinctActions();
   }
+  // The 15-bit from/to/promotion encoding leaves most ids unused; only
+  // geometrically possible moves are listed here.
+  std::vector<Action> PossibleDistinctActions() const override;
   std::unique_ptr<State> NewInitialState() const override {
     return std::unique_ptr<State>(new ChessState());
   }
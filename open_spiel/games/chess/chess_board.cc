@@ -14,8 +14,10 @@
 
 #include "open_spiel/games/chess/chess_board.h"
 
+#include <algorithm>
 #include <cctype>
 #include <iostream>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +26,198 @@
 
 namespace open_spiel {
 namespace chess {
+namespace {
+
+// Bitboard machinery for the standard 8x8 board, used for sliding-piece move
+// generation and attack tests. Bit index = y * 8 + x, matching the bitboards
+// maintained by ChessBoard::set_square.
+using Bitboard = uint64_t;
+
+inline int SquareToBitIndex(const Square &sq) { return sq.y * 8 + sq.x; }
+
+inline Square BitIndexToSquare(int index) {
+  return Square{static_cast<int8_t>(index % 8), static_cast<int8_t>(index / 8)};
+}
+
+inline Bitboard SquareMask(const Square &sq) {
+  return static_cast<Bitboard>(1) << SquareToBitIndex(sq);
+}
+
+inline int PopCount(Bitboard b) {
+  b = b - ((b >> 1) & 0x5555555555555555ULL);
+  b = (b & 0x3333333333333333ULL) + ((b >> 2) & 0x3333333333333333ULL);
+  b = (b + (b >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<int>((b * 0x0101010101010101ULL) >> 56);
+}
+
+// Index of the lowest set bit, via De Bruijn multiplication (we avoid
+// compiler intrinsics for portability). b must be non-zero.
+inline int LowestBitIndex(Bitboard b) {
+  static const int kIndex64[64] = {
+      0,  47, 1,  56, 48, 27, 2,  60, 57, 49, 41, 37, 28, 16, 3,  61,
+      54, 58, 35, 52, 50, 42, 21, 44, 38, 32, 29, 23, 17, 11, 4,  62,
+      46, 55, 26, 59, 40, 36, 15, 53, 34, 51, 20, 43, 31, 22, 10, 45,
+      25, 39, 14, 33, 19, 30, 9,  24, 13, 18, 8,  12, 7,  6,  5,  63};
+  return kIndex64[((b ^ (b - 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+// Returns the index of the lowest set bit and clears it.
+inline int PopLowestBit(Bitboard *b) {
+  int index = LowestBitIndex(*b);
+  *b &= *b - 1;
+  return index;
+}
+
+constexpr std::array<Offset, 4> kRookDirections = {
+    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+constexpr std::array<Offset, 4> kBishopDirections = {
+    {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}}};
+
+// Ray-walking attack computation. Only used to build the magic tables below;
+// move generation uses the tables.
+Bitboard SlidingAttacks(int square, Bitboard occupancy,
+                        const std::array<Offset, 4> &directions) {
+  Bitboard attacks = 0;
+  Square from = BitIndexToSquare(square);
+  for (const Offset &direction : directions) {
+    for (Square to = from + direction; StandardChessBoard::InBoardArea(to);
+         to += direction) {
+      attacks |= SquareMask(to);
+      if ((occupancy & SquareMask(to)) != 0) break;
+    }
+  }
+  return attacks;
+}
+
+// Magic-bitboard attack table for one square. The attack set for an occupancy
+// occ is attacks[((occ & mask) * magic) >> shift].
+struct MagicEntry {
+  Bitboard mask;
+  Bitboard magic;
+  int shift;
+  std::vector<Bitboard> attacks;
+};
+
+// Fills in the magic entry for one square by finding a collision-free magic
+// multiplier by trial and error (a few dozen attempts per square; this is how
+// most engines build their tables at startup, and avoids a large blob of
+// hard-coded constants).
+void InitMagicEntry(int square, const std::array<Offset, 4> &directions,
+                    std::mt19937_64 *rng, MagicEntry *entry) {
+  Square from = BitIndexToSquare(square);
+
+  // Relevant occupancy mask: every ray square except the last one on each
+  // ray; a piece on the board edge can never change the attack set.
+  entry->mask = 0;
+  for (const Offset &direction : directions) {
+    for (Square to = from + direction;
+         StandardChessBoard::InBoardArea(to + direction); to += direction) {
+      entry->mask |= SquareMask(to);
+    }
+  }
+  int bits = PopCount(entry->mask);
+  entry->shift = 64 - bits;
+
+  // Enumerate every subset of the mask (Carry-Rippler) along with its
+  // reference attack set.
+  std::vector<Bitboard> occupancies;
+  std::vector<Bitboard> reference;
+  Bitboard occupancy = 0;
+  do {
+    occupancies.push_back(occupancy);
+    reference.push_back(SlidingAttacks(square, occupancy, directions));
+    occupancy = (occupancy - entry->mask) & entry->mask;
+  } while (occupancy != 0);
+
+  std::uniform_int_distribution<Bitboard> dist;
+  entry->attacks.resize(static_cast<std::size_t>(1) << bits);
+  std::vector<bool> used(entry->attacks.size());
+  while (true) {
+    // Sparse random candidates work much better than uniform ones.
+    Bitboard magic = dist(*rng) & dist(*rng) & dist(*rng);
+    if (PopCount((entry->mask * magic) >> 56) < 6) continue;
+    std::fill(used.begin(), used.end(), false);
+    bool collision = false;
+    for (std::size_t i = 0; i < occupancies.size(); ++i) {
+      std::size_t index = (occupancies[i] * magic) >> entry->shift;
+      if (used[index] && entry->attacks[index] != reference[i]) {
+        collision = true;
+        break;
+      }
+      used[index] = true;
+      entry->attacks[index] = reference[i];
+    }
+    if (!collision) {
+      entry->magic = magic;
+      return;
+    }
+  }
+}
+
+struct AttackTables {
+  std::array<MagicEntry, 64> rook_magics;
+  std::array<MagicEntry, 64> bishop_magics;
+  std::array<Bitboard, 64> king_attacks;
+  std::array<Bitboard, 64> knight_attacks;
+  // Squares attacked by a pawn of the given color, indexed by ToInt(color).
+  std::array<std::array<Bitboard, 64>, 2> pawn_attacks;
+};
+
+const AttackTables &GetAttackTables() {
+  static const AttackTables *tables = []() {
+    AttackTables *t = new AttackTables();
+    std::mt19937_64 rng(/*seed=*/398287);  // Deterministic construction.
+    static const std::array<Offset, 8> kKingOffsets = {{{1, 0},
+                                                        {1, 1},
+                                                        {1, -1},
+                                                        {0, 1},
+                                                        {0, -1},
+                                                        {-1, 1},
+                                                        {-1, 0},
+                                                        {-1, -1}}};
+    for (int square = 0; square < 64; ++square) {
+      InitMagicEntry(square, kRookDirections, &rng, &t->rook_magics[square]);
+      InitMagicEntry(square, kBishopDirections, &rng,
+                     &t->bishop_magics[square]);
+
+      Square from = BitIndexToSquare(square);
+      t->king_attacks[square] = 0;
+      for (const Offset &offset : kKingOffsets) {
+        Square to = from + offset;
+        if (StandardChessBoard::InBoardArea(to)) {
+          t->king_attacks[square] |= SquareMask(to);
+        }
+      }
+      t->knight_attacks[square] = 0;
+      for (const Offset &offset : kKnightOffsets) {
+        Square to = from + offset;
+        if (StandardChessBoard::InBoardArea(to)) {
+          t->knight_attacks[square] |= SquareMask(to);
+        }
+      }
+      for (Color color : {Color::kBlack, Color::kWhite}) {
+        int8_t y_direction = color == Color::kWhite ? 1 : -1;
+        Bitboard attacks = 0;
+        for (int8_t x_direction : {int8_t{1}, int8_t{-1}}) {
+          Square to = from + Offset{x_direction, y_direction};
+          if (StandardChessBoard::InBoardArea(to)) {
+            attacks |= SquareMask(to);
+          }
+        }
+        t->pawn_attacks[ToInt(color)][square] = attacks;
+      }
+    }
+    return t;
+  }();
+  return *tables;
+}
+
+inline Bitboard MagicAttacks(const MagicEntry &entry, Bitboard occupancy) {
+  return entry.attacks[((occupancy & entry.mask) * entry.magic) >>
+                       entry.shift];
+}
+
+}  // namespace
 
 bool IsMoveCharacter(char c) {
   return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
@@ -310,7 +504,9 @@ std::string Move::ToSAN(const StandardChessBoard &board) const {
 
 template <uint32_t kBoardSize>
 ChessBoard<kBoardSize>::ChessBoard()
-    : to_play_(Color::kWhite),
+    : piece_bitboards_{},
+      color_bitboards_{},
+      to_play_(Color::kWhite),
       ep_square_(InvalidSquare()),
       irreversible_move_counter_(0),
       move_number_(1),
@@ -435,38 +631,51 @@ ChessBoard<kBoardSize>::BoardFromFEN(const std::string &fen) {
 
 template <uint32_t kBoardSize>
 Square ChessBoard<kBoardSize>::find(const Piece &piece) const {
-  for (int8_t y = 0; y < kBoardSize; ++y) {
-    for (int8_t x = 0; x < kBoardSize; ++x) {
-      Square sq{x, y};
-      if (at(sq) == piece) {
-        return sq;
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  if (piece.type == PieceType::kEmpty) {
+    for (int8_t y = 0; y < kBoardSize; ++y) {
+      for (int8_t x = 0; x < kBoardSize; ++x) {
+        Square sq{x, y};
+        if (at(sq) == piece) {
+          return sq;
+        }
       }
     }
+    return InvalidSquare();
   }
 
-  return InvalidSquare();
+  Bitboard pieces = piece_bitboard(piece.color, piece.type);
+  if (pieces == 0) {
+    return InvalidSquare();
+  }
+  return BitIndexToSquare(LowestBitIndex(pieces));
 }
 
 template <uint32_t kBoardSize>
 void ChessBoard<kBoardSize>::GenerateLegalMoves(
     const MoveYieldFn &yield) const {
   auto king_square = find(Piece{to_play_, PieceType::kKing});
-
-  GeneratePseudoLegalMoves([this, &king_square, &yield](const Move &move) {
-    // See if the move is legal by applying, checking whether the king is
-    // under attack, and undoing the move.
-    // TODO: Optimize this.
-    auto board_copy = *this;
-    board_copy.ApplyMove(move);
-
-    auto ks = at(move.from).type == PieceType::kKing ? move.to : king_square;
-
-    if (board_copy.UnderAttack(ks, to_play_)) {
-      return true;
-    } else {
-      return yield(move);
-    }
-  });
+  Color us = to_play_;
+
+  // We test each pseudo-legal move for legality by making it on this board,
+  // checking whether the king is under attack, and unmaking it, instead of
+  // copying the whole board per move. The board is always restored before
+  // yield is called.
+  auto *self = const_cast<ChessBoard<kBoardSize> *>(this);
+  GeneratePseudoLegalMoves(
+      [this, self, us, &king_square, &yield](const Move &move) {
+        auto ks = at(move.from).type == PieceType::kKing ? move.to
+                                                         : king_square;
+        self->MakeMove(move);
+        bool in_check = UnderAttack(ks, us);
+        self->UndoMove();
+
+        if (in_check) {
+          return true;
+        } else {
+          return yield(move);
+        }
+      });
 }
 
 template <uint32_t kBoardSize>
@@ -907,7 +1116,7 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
   // Special cases that require adjustment -
   // 1. Castling
   if (move.is_castling) {
-    SPIEL_CHECK_EQ(moving_piece.type, PieceType::kKing);
+    SPIEL_DCHECK_EQ(moving_piece.type, PieceType::kKing);
     // We can tell which side we are castling to using "to" square.
     if (to_play_ == Color::kWhite) {
       if (move.to == Square{2, 0}) {
@@ -959,8 +1168,8 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
     } else {
       ++captured_pawn_square.y;
     }
-    SPIEL_CHECK_EQ(at(captured_pawn_square),
-                   (Piece{OppColor(to_play_), PieceType::kPawn}));
+    SPIEL_DCHECK_EQ(at(captured_pawn_square),
+                    (Piece{OppColor(to_play_), PieceType::kPawn}));
     set_square(captured_pawn_square, kEmptyPiece);
   }
 
@@ -985,6 +1194,81 @@ void ChessBoard<kBoardSize>::ApplyMove(const Move &move) {
   SetToPlay(OppColor(to_play_));
 }
 
+template <uint32_t kBoardSize>
+void ChessBoard<kBoardSize>::MakeMove(const Move &move) {
+  UndoInfo undo;
+  undo.move = move;
+  undo.moved_piece = at(move.from);
+  undo.captured_square = move.to;
+  undo.captured_piece = at(move.to);
+  // For en passant the captured pawn is not on the destination square.
+  if (undo.moved_piece.type == PieceType::kPawn && move.from.x != move.to.x &&
+      undo.captured_piece.type == PieceType::kEmpty) {
+    undo.captured_square.y += to_play_ == Color::kWhite ? -1 : 1;
+    undo.captured_piece = at(undo.captured_square);
+  }
+  undo.ep_square = EpSquare();
+  for (Color color : {Color::kBlack, Color::kWhite}) {
+    for (CastlingDirection direction :
+         {CastlingDirection::kLeft, CastlingDirection::kRight}) {
+      undo.castling_rights[ToInt(color)][ToInt(direction)] =
+          CastlingRight(color, direction);
+    }
+  }
+  undo.irreversible_move_counter = IrreversibleMoveCounter();
+  undo.move_number = MoveNumber();
+  undo_stack_.push_back(undo);
+
+  ApplyMove(move);
+}
+
+template <uint32_t kBoardSize>
+void ChessBoard<kBoardSize>::UndoMove() {
+  SPIEL_CHECK_FALSE(undo_stack_.empty());
+  const UndoInfo &undo = undo_stack_.back();
+  const Move &move = undo.move;
+  Color mover = undo.moved_piece.color;
+
+  // Restore the piece configuration. Everything goes through set_square and
+  // the Set* functions below, so the Zobrist hash is restored exactly (each
+  // component is XORed back out).
+  if (move.is_castling) {
+    // ApplyMove only supports standard-chess castling, where the rook comes
+    // from the corner on the castling side.
+    static_assert(kBoardSize == 8,
+                  "This is not boardsize-independent! What does castling "
+                  "mean for other boardsizes?");
+    int8_t rook_from_x = move.to.x == 2 ? 0 : 7;
+    int8_t rook_final_x = move.to.x == 2 ? 3 : 5;
+    set_square(Square{rook_final_x, move.to.y}, kEmptyPiece);
+    set_square(move.to, kEmptyPiece);
+    set_square(Square{rook_from_x, move.from.y},
+               Piece{mover, PieceType::kRook});
+    set_square(move.from, undo.moved_piece);
+  } else {
+    set_square(move.to, kEmptyPiece);
+    if (undo.captured_piece.type != PieceType::kEmpty) {
+      set_square(undo.captured_square, undo.captured_piece);
+    }
+    // This also reverses promotions, since we restore the original pawn.
+    set_square(move.from, undo.moved_piece);
+  }
+
+  SetEpSquare(undo.ep_square);
+  for (Color color : {Color::kBlack, Color::kWhite}) {
+    for (CastlingDirection direction :
+         {CastlingDirection::kLeft, CastlingDirection::kRight}) {
+      SetCastlingRight(color, direction,
+                       undo.castling_rights[ToInt(color)][ToInt(direction)]);
+    }
+  }
+  SetIrreversibleMoveCounter(undo.irreversible_move_counter);
+  SetMoveNumber(undo.move_number);
+  SetToPlay(mover);
+
+  undo_stack_.pop_back();
+}
+
 template <uint32_t kBoardSize>
 bool ChessBoard<kBoardSize>::TestApplyMove(const Move &move) {
   Color color = to_play_;
@@ -995,76 +1279,51 @@ bool ChessBoard<kBoardSize>::TestApplyMove(const Move &move) {
 template <uint32_t kBoardSize>
 bool ChessBoard<kBoardSize>::UnderAttack(const Square &sq,
                                          Color our_color) const {
-  SPIEL_CHECK_NE(sq, InvalidSquare());
-
-  bool under_attack = false;
-  Color opponent_color = OppColor(our_color);
-
-  // We do this by pretending we are a piece of different types, and seeing if
-  // we can attack opponent pieces. Eg. if we pretend we are a knight, and can
-  // attack an opponent knight, that means the knight can also attack us.
-
-  // King moves (this is possible because we use this function for checking
+  // Hot path: this runs once per legality test in move generation.
+  SPIEL_DCHECK_NE(sq, InvalidSquare());
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+
+  // We do this by pretending we are a piece of different types on sq, and
+  // seeing if we can attack opponent pieces of those types. Eg. if a knight
+  // on sq attacks an opponent knight, that knight also attacks us. Each test
+  // is a single magic (or precomputed) table lookup intersected with the
+  // opponent's piece bitboards.
+  const AttackTables &tables = GetAttackTables();
+  const int index = SquareToBitIndex(sq);
+  const Color opponent_color = OppColor(our_color);
+  const Bitboard occupancy = color_bitboards_[0] | color_bitboards_[1];
+
+  // King attacks (this is possible because we use this function for checking
   // whether we are moving into check, and we can be trying to move the king
   // into a square attacked by opponent king).
-  GenerateKingDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kKing}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
-    return true;
-  }
-
-  // Rook moves (for rooks and queens)
-  GenerateRookDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if ((at(to) == Piece{opponent_color, PieceType::kRook}) ||
-            (at(to) == Piece{opponent_color, PieceType::kQueen})) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
+  if ((tables.king_attacks[index] &
+       piece_bitboard(opponent_color, PieceType::kKing)) != 0) {
     return true;
   }
 
-  // Bishop moves (for bishops and queens)
-  GenerateBishopDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if ((at(to) == Piece{opponent_color, PieceType::kBishop}) ||
-            (at(to) == Piece{opponent_color, PieceType::kQueen})) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
+  // Rook attacks (for rooks and queens).
+  if ((MagicAttacks(tables.rook_magics[index], occupancy) &
+       (piece_bitboard(opponent_color, PieceType::kRook) |
+        piece_bitboard(opponent_color, PieceType::kQueen))) != 0) {
     return true;
   }
 
-  // Knight moves
-  GenerateKnightDestinations_(
-      sq, our_color, [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kKnight}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
+  // Bishop attacks (for bishops and queens).
+  if ((MagicAttacks(tables.bishop_magics[index], occupancy) &
+       (piece_bitboard(opponent_color, PieceType::kBishop) |
+        piece_bitboard(opponent_color, PieceType::kQueen))) != 0) {
     return true;
   }
 
-  // Pawn captures.
-  GeneratePawnCaptureDestinations_(
-      sq, our_color, false /* no ep */,
-      [this, &under_attack, &opponent_color](const Square &to) {
-        if (at(to) == Piece{opponent_color, PieceType::kPawn}) {
-          under_attack = true;
-        }
-      });
-  if (under_attack) {
+  // Knight attacks.
+  if ((tables.knight_attacks[index] &
+       piece_bitboard(opponent_color, PieceType::kKnight)) != 0) {
     return true;
   }
 
-  return false;
+  // Pawn attacks (no en passant; ep can never capture on the tested square).
+  return (tables.pawn_attacks[ToInt(our_color)][index] &
+          piece_bitboard(opponent_color, PieceType::kPawn)) != 0;
 }
 
 template <uint32_t kBoardSize>
@@ -1118,14 +1377,11 @@ template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateKingDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  static const std::array<Offset, 8> kOffsets = {
-      {{1, 0}, {1, 1}, {1, -1}, {0, 1}, {0, -1}, {-1, 1}, {-1, 0}, {-1, -1}}};
-
-  for (const auto &offset : kOffsets) {
-    Square dest = sq + offset;
-    if (InBoardArea(dest) && IsEmptyOrEnemy(dest, color)) {
-      yield(dest);
-    }
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  Bitboard destinations = GetAttackTables().king_attacks[SquareToBitIndex(sq)] &
+                          ~color_bitboards_[ToInt(color)];
+  while (destinations != 0) {
+    yield(BitIndexToSquare(PopLowestBit(&destinations)));
   }
 }
 
@@ -1264,31 +1520,42 @@ template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateRookDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  GenerateRayDestinations_(sq, color, {1, 0}, yield);
-  GenerateRayDestinations_(sq, color, {-1, 0}, yield);
-  GenerateRayDestinations_(sq, color, {0, 1}, yield);
-  GenerateRayDestinations_(sq, color, {0, -1}, yield);
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  Bitboard occupancy = color_bitboards_[0] | color_bitboards_[1];
+  Bitboard destinations =
+      MagicAttacks(GetAttackTables().rook_magics[SquareToBitIndex(sq)],
+                   occupancy) &
+      ~color_bitboards_[ToInt(color)];
+  while (destinations != 0) {
+    yield(BitIndexToSquare(PopLowestBit(&destinations)));
+  }
 }
 
 template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateBishopDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  GenerateRayDestinations_(sq, color, {1, 1}, yield);
-  GenerateRayDestinations_(sq, color, {-1, 1}, yield);
-  GenerateRayDestinations_(sq, color, {1, -1}, yield);
-  GenerateRayDestinations_(sq, color, {-1, -1}, yield);
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  Bitboard occupancy = color_bitboards_[0] | color_bitboards_[1];
+  Bitboard destinations =
+      MagicAttacks(GetAttackTables().bishop_magics[SquareToBitIndex(sq)],
+                   occupancy) &
+      ~color_bitboards_[ToInt(color)];
+  while (destinations != 0) {
+    yield(BitIndexToSquare(PopLowestBit(&destinations)));
+  }
 }
 
 template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GenerateKnightDestinations_(
     Square sq, Color color, const YieldFn &yield) const {
-  for (const auto &offset : kKnightOffsets) {
-    Square dest = sq + offset;
-    if (InBoardArea(dest) && IsEmptyOrEnemy(dest, color)) {
-      yield(dest);
-    }
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  Bitboard destinations =
+      GetAttackTables().knight_attacks[SquareToBitIndex(sq)] &
+      ~color_bitboards_[ToInt(color)];
+  while (destinations != 0) {
+    yield(BitIndexToSquare(PopLowestBit(&destinations)));
   }
 }
 
@@ -1317,34 +1584,16 @@ template <uint32_t kBoardSize>
 template <typename YieldFn>
 void ChessBoard<kBoardSize>::GeneratePawnCaptureDestinations_(
     Square sq, Color color, bool include_ep, const YieldFn &yield) const {
-  int8_t y_direction = color == Color::kWhite ? 1 : -1;
-  Square dest = sq + Offset{1, y_direction};
-  if (InBoardArea(dest) &&
-      (IsEnemy(dest, color) || (include_ep && dest == EpSquare()))) {
-    yield(dest);
+  static_assert(kBoardSize == 8, "Bitboards assume an 8x8 board.");
+  Bitboard capturable = color_bitboards_[ToInt(OppColor(color))];
+  if (include_ep && EpSquare() != InvalidSquare()) {
+    capturable |= SquareMask(EpSquare());
   }
-
-  dest = sq + Offset{-1, y_direction};
-  if (InBoardArea(dest) &&
-      (IsEnemy(dest, color) || (include_ep && dest == EpSquare()))) {
-    yield(dest);
-  }
-}
-
-template <uint32_t kBoardSize>
-template <typename YieldFn>
-void ChessBoard<kBoardSize>::GenerateRayDestinations_(
-    Square sq, Color color, Offset offset_step, const YieldFn &yield) const {
-  for (Square dest = sq + offset_step; InBoardArea(dest); dest += offset_step) {
-    if (IsEmpty(dest)) {
-      yield(dest);
-    } else if (IsEnemy(dest, color)) {
-      yield(dest);
-      break;
-    } else {
-      // We have a friendly piece.
-      break;
-    }
+  Bitboard destinations =
+      GetAttackTables().pawn_attacks[ToInt(color)][SquareToBitIndex(sq)] &
+      capturable;
+  while (destinations != 0) {
+    yield(BitIndexToSquare(PopLowestBit(&destinations)));
   }
 }
 
@@ -1431,6 +1680,8 @@ std::string ChessBoard<kBoardSize>::ToFEN() const {
 
 template <uint32_t kBoardSize>
 void ChessBoard<kBoardSize>::set_square(Square sq, Piece piece) {
+  static_assert(kBoardSize * kBoardSize <= 64,
+                "Bitboards only support up to 64 squares.");
   static const ZobristTableU64<kBoardSize * kBoardSize, 3, 7> kZobristValues(
       /*seed=*/2765481);
 
@@ -1445,6 +1696,19 @@ void ChessBoard<kBoardSize>::set_square(Square sq, Piece piece) {
   zobrist_hash_ ^= kZobristValues[position][static_cast<int>(piece.color)]
                                  [static_cast<int>(piece.type)];
 
+  // Keep the bitboards in sync with the mailbox.
+  uint64_t square_mask = static_cast<uint64_t>(1) << position;
+  if (current_piece.color != Color::kEmpty) {
+    piece_bitboards_[ToInt(current_piece.color)]
+                    [static_cast<int>(current_piece.type) - 1] &= ~square_mask;
+    color_bitboards_[ToInt(current_piece.color)] &= ~square_mask;
+  }
+  if (piece.color != Color::kEmpty) {
+    piece_bitboards_[ToInt(piece.color)][static_cast<int>(piece.type) - 1] |=
+        square_mask;
+    color_bitboards_[ToInt(piece.color)] |= square_mask;
+  }
+
   board_[position] = piece;
 }
 
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "open_spiel/games/chess/chess_common.h"
+#include "open_spiel/games/zobrist.h"
 #include "open_spiel/spiel_optional.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -36,7 +37,7 @@ using chess_common::Square;
 using chess_common::SquareToString;
 
 template <std::size_t... Dims>
-using ZobristTableU64 = chess_common::ZobristTable<uint64_t, Dims...>;
+using ZobristTableU64 = zobrist::ZobristTable<uint64_t, Dims...>;
 
 enum class Color : int8_t { kBlack = 0, kWhite = 1, kEmpty = 2 };
 
@@ -235,6 +236,14 @@ class ChessBoard {
     return board_;
   }
 
+  // One bit per square (bit index = y * kBoardSize + x) for each piece set.
+  // Kept in sync with board_ by set_square, and used for magic-bitboard
+  // sliding attacks, attack tests, find(), and material counts. Only
+  // well-defined for boards of up to 64 squares.
+  uint64_t piece_bitboard(Color color, PieceType type) const {
+    return piece_bitboards_[ToInt(color)][static_cast<int>(type) - 1];
+  }
+
   Color ToPlay() const { return to_play_; }
   void SetToPlay(Color c);
 
@@ -300,6 +309,17 @@ class ChessBoard {
 
   void ApplyMove(const Move& move);
 
+  // Applies a move like ApplyMove, but first pushes everything required to
+  // reverse it (moved and captured piece, castling rights, en passant square,
+  // move counters) onto an internal undo stack. Search code that makes and
+  // unmakes moves with these walks millions of nodes on a single board
+  // instance instead of copying the whole board per node.
+  void MakeMove(const Move& move);
+
+  // Reverses the last move made with MakeMove, restoring the position and the
+  // Zobrist hash exactly.
+  void UndoMove();
+
   // Applies a pseudo-legal move and returns whether it's legal. This avoids
   // applying and copying the whole board once for legality testing, and once
   // for actually applying the move.
@@ -418,15 +438,27 @@ class ChessBoard {
   void GeneratePawnCaptureDestinations_(Square sq, Color color, bool include_ep,
                                         const YieldFn& yield) const;
 
-  // Helper function.
-  template <typename YieldFn>
-  void GenerateRayDestinations_(Square sq, Color color, Offset offset_step,
-                                const YieldFn& yield) const;
-
   void SetIrreversibleMoveCounter(int c);
   void SetMoveNumber(int move_number);
 
+  // Everything needed to reverse one MakeMove.
+  struct UndoInfo {
+    Move move;
+    Piece moved_piece;
+    Piece captured_piece;
+    Square captured_square;  // Differs from move.to for en passant captures.
+    Square ep_square;
+    bool castling_rights[2][2];  // [ToInt(color)][ToInt(direction)].
+    int32_t irreversible_move_counter;
+    int32_t move_number;
+  };
+
   std::array<Piece, kBoardSize * kBoardSize> board_;
+
+  // Indexed by ToInt(color) and (piece type - 1); color_bitboards_ aggregates
+  // all piece types of one color.
+  uint64_t piece_bitboards_[2][6];
+  uint64_t color_bitboards_[2];
   Color to_play_;
   Square ep_square_;
   int32_t irreversible_move_counter_;
@@ -441,6 +473,9 @@ class ChessBoard {
   } castling_rights_[2];
 
   uint64_t zobrist_hash_;
+
+  // Moves made with MakeMove that have not been undone yet.
+  std::vector<UndoInfo> undo_stack_;
 };
 
 template <uint32_t kBoardSize>
@@ -14,6 +14,9 @@
 
 #include "open_spiel/games/chess.h"
 
+#include <algorithm>
+#include <random>
+
 #include "open_spiel/games/chess/chess_board.h"
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_utils.h"
@@ -64,6 +67,39 @@ void MoveGenerationTests() {
   SPIEL_CHECK_EQ(CountNumLegalMoves(start_pos), 20);
 }
 
+void ForEachLegalActionTests() {
+  ChessState state;
+  // A full lazy enumeration yields exactly the LegalActions() set (in
+  // generation order rather than sorted order).
+  std::vector<Action> yielded;
+  state.ForEachLegalAction([&yielded](Action action) {
+    yielded.push_back(action);
+    return true;
+  });
+  std::sort(yielded.begin(), yielded.end());
+  SPIEL_CHECK_TRUE(yielded == state.LegalActions());
+
+  // Early exit stops generation; the stop is best-effort, so only check that
+  // it yields at least one action and clearly fewer than the full set.
+  int num_yielded = 0;
+  state.ForEachLegalAction([&num_yielded](Action) {
+    ++num_yielded;
+    return false;
+  });
+  SPIEL_CHECK_GE(num_yielded, 1);
+  SPIEL_CHECK_LT(num_yielded, 20);
+}
+
+void QuickEvaluateTests() {
+  ChessState initial_state;
+  SPIEL_CHECK_FLOAT_EQ(initial_state.QuickEvaluate(), 0.0);
+
+  // White is missing both rooks, so black (player 0) is ahead on material.
+  ChessState no_rooks_state(
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/1NBQKBN1 w kq -");
+  SPIEL_CHECK_GT(no_rooks_state.QuickEvaluate(), 0.0);
+}
+
 void TerminalReturnTests() {
   ChessState checkmate_state(
       "rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq -");
@@ -107,6 +143,28 @@ void UndoTests() {
             "rnbqkbnr/pppp1p1p/6P1/4p3/8/8/PPPPP1PP/RNBQKBNR b KQkq - 0 2");
 }
 
+void MakeUndoMoveTests() {
+  // MakeMove/UndoMove must restore the position and the Zobrist hash exactly,
+  // including after captures, castling, and promotion.
+  StandardChessBoard board = MakeDefaultBoard();
+  std::vector<std::string> fens;
+  std::vector<uint64_t> hashes;
+  for (const char* san : {"e4", "d5", "exd5", "Nf6", "Bb5+", "c6", "dxc6",
+                          "Qb6", "cxb7", "Qxb5", "bxa8=Q", "Qa4", "Nf3",
+                          "Qb4", "O-O"}) {
+    auto maybe_move = board.ParseSANMove(san);
+    SPIEL_CHECK_TRUE(maybe_move);
+    fens.push_back(board.ToFEN());
+    hashes.push_back(board.HashValue());
+    board.MakeMove(*maybe_move);
+  }
+  for (int i = fens.size() - 1; i >= 0; --i) {
+    board.UndoMove();
+    SPIEL_CHECK_EQ(board.ToFEN(), fens[i]);
+    SPIEL_CHECK_EQ(board.HashValue(), hashes[i]);
+  }
+}
+
 double ValueAt(const std::vector<double>& v, const std::vector<int>& shape,
                int plane, int x, int y) {
   return v[plane * shape[1] * shape[2] + y * shape[2] + x];
@@ -210,6 +268,89 @@ void InformationStateVectorTests() {
   SPIEL_CHECK_EQ(ValueAt(v, shape, 19, 3, 3), 1.0);
 }
 
+// Checks the incrementally maintained piece planes against a fresh scan of
+// the board, square by square, in the serving order (white and black planes
+// per piece type, empty plane last).
+void CheckPiecePlanes(const ChessState& state) {
+  const std::vector<double>& planes = state.PiecePlanes();
+  const int num_squares = BoardSize() * BoardSize();
+  SPIEL_CHECK_EQ(planes.size(), 13 * num_squares);
+  int plane = 0;
+  auto check_plane = [&planes, &state, num_squares, &plane](Color color,
+                                                           PieceType type) {
+    for (int8_t y = 0; y < BoardSize(); ++y) {
+      for (int8_t x = 0; x < BoardSize(); ++x) {
+        Piece piece = state.Board().at(Square{x, y});
+        double expected =
+            (piece.color == color && piece.type == type) ? 1.0 : 0.0;
+        // Indexed outside the check: SPIEL_CHECK_EQ introduces locals named
+        // x and y that would shadow the loop variables.
+        const double actual =
+            planes[plane * num_squares + y * BoardSize() + x];
+        SPIEL_CHECK_EQ(actual, expected);
+      }
+    }
+    ++plane;
+  };
+  for (PieceType type : kPieceTypes) {
+    check_plane(Color::kWhite, type);
+    check_plane(Color::kBlack, type);
+  }
+  check_plane(Color::kEmpty, PieceType::kEmpty);
+}
+
+void PiecePlanesTests() {
+  // Lines of play covering the moves with extra touched squares: both
+  // castles, an en passant capture, and a promotion with capture.
+  {
+    ChessState state;
+    for (const char* san : {"e4", "d5", "exd5", "Nf6", "Nf3", "Nxd5", "g3",
+                            "g6", "Bg2", "Bg7", "O-O", "O-O"}) {
+      ApplySANMove(san, &state);
+      CheckPiecePlanes(state);
+    }
+  }
+  {
+    ChessState state;
+    for (const char* san : {"d4", "d5", "Nc3", "Nc6", "Bf4", "Bf5", "Qd2",
+                            "Qd7", "O-O-O", "O-O-O"}) {
+      ApplySANMove(san, &state);
+      CheckPiecePlanes(state);
+    }
+  }
+  {
+    ChessState state("rnbqkbnr/pppp1p1p/8/4pPp1/8/8/PPPPP1PP/RNBQKBNR w "
+                     "KQkq g6 0 2");
+    CheckPiecePlanes(state);
+    ApplySANMove("fxg6", &state);  // En passant.
+    CheckPiecePlanes(state);
+  }
+  {
+    ChessState state("r1bqkbnr/pPpppppp/8/6n1/6p1/8/PPPPP1PP/RNBQKBNR w "
+                     "KQkq - 0 1");
+    ApplySANMove("bxa8=Q", &state);  // Promotion with capture.
+    CheckPiecePlanes(state);
+  }
+
+  // Random playouts, re-checking the planes after every apply and after
+  // every undo/re-apply round trip.
+  std::mt19937 rng(913);
+  for (int episode = 0; episode < 3; ++episode) {
+    ChessState state;
+    for (int ply = 0; ply < 80 && !state.IsTerminal(); ++ply) {
+      std::vector<Action> actions = state.LegalActions();
+      Action action = actions[std::uniform_int_distribution<int>(
+          0, actions.size() - 1)(rng)];
+      int player = state.CurrentPlayer();
+      state.ApplyAction(action);
+      CheckPiecePlanes(state);
+      state.UndoAction(player, action);
+      CheckPiecePlanes(state);
+      state.ApplyAction(action);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace chess
 }  // namespace open_spiel
@@ -217,7 +358,11 @@ void InformationStateVectorTests() {
 int main(int argc, char** argv) {
   open_spiel::chess::BasicChessTests();
   open_spiel::chess::MoveGenerationTests();
+  open_spiel::chess::ForEachLegalActionTests();
   open_spiel::chess::UndoTests();
+  open_spiel::chess::MakeUndoMoveTests();
+  open_spiel::chess::QuickEvaluateTests();
   open_spiel::chess::TerminalReturnTests();
   open_spiel::chess::InformationStateVectorTests();
+  open_spiel::chess::PiecePlanesTests();
 }
@@ -107,10 +107,6 @@ enum MovementType { kUp = 0, kDown = 1, kLeft = 2, kRight = 3, kStand = 4 };
 constexpr std::array<Location, 5> offsets = {
     {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {0, 0}}};
 
-Location operator+(const Location& a, const Location& b) {
-  return {a.first + b.first, a.second + b.second};
-}
-
 std::set<int> RangeAsSet(int n) {
   std::set<int> result;
   for (int i = 0; i < n; i++) {
@@ -220,23 +216,10 @@ std::string CoinState::Observation(int player) const {
   return out.str();
 }
 
-bool CoinState::InBounds(Location loc) const {
-  return (loc.first >= 0 && loc.second >= 0 && loc.first < game_.NumRows() &&
-          loc.second < game_.NumColumns());
-}
-
-void CoinState::SetField(Location loc, char symbol) {
-  field_[loc.first * game_.NumColumns() + loc.second] = symbol;
-}
-
 char CoinState::GetField(Location loc) const {
   return field_[loc.first * game_.NumColumns() + loc.second];
 }
 
-Location CoinState::LocationFromIndex(int index) const {
-  return {index / game_.NumColumns(), index % game_.NumColumns()};
-}
-
 void CoinState::ApplyAssignPreferenceAction(Action coin_color) {
   SPIEL_CHECK_LT(coin_color, game_.NumCoinColors());
   player_preferences_[setup_.num_players_assigned_preference] = coin_color;
@@ -248,7 +231,7 @@ void CoinState::ApplyDeployPlayersAction(Action index) {
   SPIEL_CHECK_LT(index, field_.size());
   SPIEL_CHECK_TRUE(GetSymbolType(field_[index]) == SymbolType::kEmpty);
   field_[index] = PlayerSymbol(setup_.num_players_on_field);
-  player_location_[setup_.num_players_on_field] = LocationFromIndex(index);
+  player_location_[setup_.num_players_on_field] = index;
   ++setup_.num_players_on_field;
   setup_.available_positions_.erase(index);
 }
@@ -273,20 +256,22 @@ void CoinState::ApplyDeployCoinsAction(Action index) {
 void CoinState::ApplyPlayAction(Action move) {
   ++total_moves_;
 
-  Location old_loc = player_location_[cur_player_];
-  SPIEL_CHECK_EQ(GetField(old_loc), PlayerSymbol(cur_player_));
+  const int old_index = player_location_[cur_player_];
+  SPIEL_CHECK_EQ(field_[old_index], PlayerSymbol(cur_player_));
 
-  Location new_loc = old_loc + offsets[move];
-  if (InBounds(new_loc)) {
-    char target = GetField(new_loc);
+  // One table read resolves the move and its bounds check at once; moves
+  // off the board map back to the source square (like standing still).
+  const int new_index = game_.MoveDest(old_index, move);
+  if (new_index != old_index) {
+    char target = field_[new_index];
     SymbolType target_type = GetSymbolType(target);
     if (target_type == SymbolType::kCoin) {
       IncPlayerCoinCount(cur_player_, CoinId(target));
     }
     if (target_type == SymbolType::kCoin || target_type == SymbolType::kEmpty) {
-      player_location_[cur_player_] = new_loc;
-      SetField(old_loc, kEmptySymbol);
-      SetField(new_loc, PlayerSymbol(cur_player_));
+      player_location_[cur_player_] = new_index;
+      field_[old_index] = kEmptySymbol;
+      field_[new_index] = PlayerSymbol(cur_player_);
     }
   }
   cur_player_ = (cur_player_ + 1) % num_players_;
@@ -453,6 +438,22 @@ CoinGame::CoinGame(const GameParameters& params)
           ParameterValue<int>("num_coins_per_color", kDefaultCoinsPerColor)) {
   int total_items = num_players_ + num_coin_colors_ * num_coins_per_color_;
   SPIEL_CHECK_LE(total_items, num_rows_ * num_columns_);
+
+  // Move-destination table: one entry per (square, move), with off-board
+  // moves folded back onto the source square.
+  move_dest_.resize(num_rows_ * num_columns_);
+  for (int r = 0; r < num_rows_; r++) {
+    for (int c = 0; c < num_columns_; c++) {
+      const int index = r * num_columns_ + c;
+      for (int move = 0; move < static_cast<int>(offsets.size()); move++) {
+        const int nr = r + offsets[move].first;
+        const int nc = c + offsets[move].second;
+        const bool in_bounds =
+            nr >= 0 && nc >= 0 && nr < num_rows_ && nc < num_columns_;
+        move_dest_[index][move] = in_bounds ? nr * num_columns_ + nc : index;
+      }
+    }
+  }
 }
 
 int CoinGame::MaxGameLength() const { return (episode_length_); }
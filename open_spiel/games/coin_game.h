@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_COIN_GAME_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_COIN_GAME_H_
 
+#include <array>
 #include <set>
 
 #include "open_spiel/spiel.h"
@@ -86,10 +87,7 @@ class CoinState : public State {
 
  private:
   GamePhase GetPhase() const;
-  Location LocationFromIndex(int index) const;
   char GetField(Location loc) const;
-  void SetField(Location loc, char symbol);
-  bool InBounds(Location loc) const;
   int GetPlayerCoinCount(int player, int coin_color) const;
   void IncPlayerCoinCount(int player, int coin_color);
 
@@ -108,7 +106,8 @@ class CoinState : public State {
   int cur_player_ = kChancePlayerId;  // Chance player for setting up the game.
   int total_moves_ = 0;
   std::vector<int> player_preferences_;
-  std::vector<Location> player_location_;
+  // Flat field index of each player's square.
+  std::vector<int> player_location_;
   // num_rows x num_columns representation of playing field.
   std::vector<char> field_;
   // num_players x num_coin_colors representation of how many coins each player
@@ -135,6 +134,12 @@ class CoinGame : public Game {
   int NumCoinsPerColor() const { return num_coins_per_color_; }
   int TotalCoins() const { return num_coin_colors_ * num_coins_per_color_; }
 
+  // Destination of the given move from the given flat field index; moves
+  // leading off the board map back to the source index. Built once at
+  // construction so the play phase resolves a move with one table read
+  // instead of offset arithmetic and bounds checks.
+  int MoveDest(int index, int move) const { return move_dest_[index][move]; }
+
  private:
   int num_players_;
   int num_rows_;
@@ -142,6 +147,7 @@ class CoinGame : public Game {
   int episode_length_;
   int num_coin_colors_;
   int num_coins_per_color_;
+  std::vector<std::array<int, 5>> move_dest_;
 };
 
 }  // namespace coin_game
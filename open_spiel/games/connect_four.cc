@@ -18,6 +18,8 @@
 #include <memory>
 #include <utility>
 
+#include "open_spiel/games/zobrist.h"
+
 namespace open_spiel {
 namespace connect_four {
 namespace {
@@ -37,7 +39,12 @@ const GameType kGameType{
     /*provides_information_state_as_normalized_vector=*/true,
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
+    /*parameter_specification=*/{},  // no parameters
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/false,
+    /*provides_canonical_key=*/true,
 };
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
@@ -70,14 +77,38 @@ std::string StateToString(CellState state) {
       return "This will never return.";
   }
 }
-}  // namespace
 
-CellState& ConnectFourState::CellAt(int row, int col) {
-  return board_[row * kCols + col];
+// Rows in the bitboard planes are kCols + 1 bits wide; the extra guard column
+// is never set, so shifted copies of a plane cannot wrap across rows.
+constexpr int kRowBits = kCols + 1;
+static_assert(kRows * kRowBits <= 64, "Board must fit in a 64-bit bitboard.");
+
+constexpr uint64_t CellMask(int row, int col) {
+  return uint64_t{1} << (row * kRowBits + col);
 }
+}  // namespace
 
 CellState ConnectFourState::CellAt(int row, int col) const {
-  return board_[row * kCols + col];
+  uint64_t mask = CellMask(row, col);
+  if (board_[0] & mask) return CellState::kCross;
+  if (board_[1] & mask) return CellState::kNought;
+  return CellState::kEmpty;
+}
+
+void ConnectFourState::SetCellAt(int row, int col, CellState state) {
+  uint64_t mask = CellMask(row, col);
+  board_[0] &= ~mask;
+  board_[1] &= ~mask;
+  switch (state) {
+    case CellState::kCross:
+      board_[0] |= mask;
+      break;
+    case CellState::kNought:
+      board_[1] |= mask;
+      break;
+    case CellState::kEmpty:
+      break;
+  }
 }
 
 int ConnectFourState::CurrentPlayer() const {
@@ -90,9 +121,15 @@ int ConnectFourState::CurrentPlayer() const {
 
 void ConnectFourState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(CellAt(kRows - 1, move), CellState::kEmpty);
+  uint64_t occupied = board_[0] | board_[1];
   int row = 0;
-  while (CellAt(row, move) != CellState::kEmpty) ++row;
-  CellAt(row, move) = PlayerToState(CurrentPlayer());
+  while (occupied & CellMask(row, move)) ++row;
+  SetCellAt(row, move, PlayerToState(CurrentPlayer()));
+  if (HasLine(current_player_)) {
+    outcome_ = static_cast<Outcome>(current_player_);
+  } else if (IsFull()) {
+    outcome_ = Outcome::kDraw;
+  }
   current_player_ = 1 - current_player_;
 }
 
@@ -105,71 +142,85 @@ std::vector<Action> ConnectFourState::LegalActions() const {
   return moves;
 }
 
+void ConnectFourState::LegalActionsBitset(uint64_t* out) const {
+  // A column is playable iff its top cell is free in both bitboard planes,
+  // so the whole mask is one shift and an invert of the top row. Note the
+  // mask has NumDistinctActions() = kNumCells bit positions, but only the
+  // column bits 0..kCols-1 can ever be set, matching LegalActions().
+  uint64_t bits = 0;
+  if (!IsTerminal()) {
+    const uint64_t top_row =
+        (board_[0] | board_[1]) >> ((kRows - 1) * kRowBits);
+    bits = ~top_row & ((uint64_t{1} << kCols) - 1);
+  }
+  out[0] = bits;
+}
+
 std::string ConnectFourState::ActionToString(int player,
                                              Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), action_id);
 }
 
-bool ConnectFourState::HasLineFrom(int player, int row, int col) const {
-  return HasLineFromInDirection(player, row, col, 0, 1) ||
-         HasLineFromInDirection(player, row, col, -1, -1) ||
-         HasLineFromInDirection(player, row, col, -1, 0) ||
-         HasLineFromInDirection(player, row, col, -1, 1);
-}
-
-bool ConnectFourState::HasLineFromInDirection(int player, int row, int col,
-                                              int drow, int dcol) const {
-  if (row + 3 * drow >= kRows || col + 3 * dcol >= kCols ||
-      row + 3 * drow < 0 || col + 3 * dcol < 0)
-    return false;
-  CellState c = PlayerToState(player);
-  for (int i = 0; i < 4; ++i) {
-    if (CellAt(row, col) != c) return false;
-    row += drow;
-    col += dcol;
-  }
-  return true;
-}
-
 bool ConnectFourState::HasLine(int player) const {
-  CellState c = PlayerToState(player);
-  for (int col = 0; col < kCols; ++col) {
-    for (int row = 0; row < kRows; ++row) {
-      if (CellAt(row, col) == c && HasLineFrom(player, row, col)) return true;
-    }
+  uint64_t plane = board_[player];
+  // A line is four set bits at a fixed stride: 1 for horizontal, kRowBits for
+  // vertical, and kRowBits -/+ 1 for the diagonals. Two shift-and-AND rounds
+  // test every possible start square of a direction at once.
+  for (int stride : {1, kRowBits - 1, kRowBits, kRowBits + 1}) {
+    uint64_t pairs = plane & (plane >> stride);
+    if (pairs & (pairs >> (2 * stride))) return true;
   }
   return false;
 }
 
 bool ConnectFourState::IsFull() const {
+  uint64_t occupied = board_[0] | board_[1];
   for (int col = 0; col < kCols; ++col) {
-    if (CellAt(kRows - 1, col) == CellState::kEmpty) return false;
+    if (!(occupied & CellMask(kRows - 1, col))) return false;
   }
   return true;
 }
 
 ConnectFourState::ConnectFourState(int num_distinct_actions)
     : State(num_distinct_actions, kNumPlayers) {
-  std::fill(begin(board_), end(board_), CellState::kEmpty);
+  board_.fill(0);
 }
 
-std::string ConnectFourState::ToString() const {
-  std::string str;
+void ConnectFourState::AppendToString(std::string* str) const {
   for (int row = kRows - 1; row >= 0; --row) {
     for (int col = 0; col < kCols; ++col) {
-      str.append(StateToString(CellAt(row, col)));
+      str->append(StateToString(CellAt(row, col)));
     }
-    str.append("\n");
+    str->append("\n");
   }
+}
+
+std::string ConnectFourState::ToString() const {
+  std::string str;
+  AppendToString(&str);
   return str;
 }
+
+std::string ConnectFourState::CanonicalKey() const {
+  // The board's only symmetry is the left-right mirror; the player to move
+  // follows from the cell counts, so the lexicographically smaller of the
+  // board and its mirror image identifies the state up to symmetry.
+  std::string key = ToString();
+  std::string mirrored = key;
+  for (int row = 0; row < kRows; ++row) {
+    const int begin = row * (kCols + 1);  // Rows are kCols cells plus '\n'.
+    std::reverse(mirrored.begin() + begin,
+                 mirrored.begin() + begin + kCols);
+  }
+  return std::min(key, mirrored);
+}
 bool ConnectFourState::IsTerminal() const {
-  return HasLine(0) || HasLine(1) || IsFull();
+  return outcome_ != Outcome::kUnknown;
 }
 
 std::vector<double> ConnectFourState::Returns() const {
-  if (HasLine(0)) return {1.0, -1.0};
-  if (HasLine(1)) return {-1.0, 1.0};
+  if (outcome_ == Outcome::kPlayer1) return {1.0, -1.0};
+  if (outcome_ == Outcome::kPlayer2) return {-1.0, 1.0};
   return {0.0, 0.0};
 }
 
@@ -187,16 +238,26 @@ void ConnectFourState::InformationStateAsNormalizedVector(
   values->resize(kNumCells * kCellStates);
   std::fill(values->begin(), values->end(), 0.);
   for (int cell = 0; cell < kNumCells; ++cell) {
-    (*values)[kNumCells * static_cast<int>(board_[cell]) + cell] = 1.0;
+    CellState state = CellAt(cell / kCols, cell % kCols);
+    (*values)[kNumCells * static_cast<int>(state) + cell] = 1.0;
   }
 }
 
 void ConnectFourState::UndoAction(int player, Action move) {
-  board_[move] = CellState::kEmpty;
+  SetCellAt(move / kCols, move % kCols, CellState::kEmpty);
   current_player_ = player;
+  // Only the move being undone can have ended the game.
+  outcome_ = Outcome::kUnknown;
   history_.pop_back();
 }
 
+uint64_t ConnectFourState::HashValue() const {
+  // The two bitboard planes determine the position (including whose turn it
+  // is), so mixing them gives the whole key.
+  constexpr uint64_t kHashSeed = 0x27c41aa9db23f56bULL;
+  return zobrist::MixHash(zobrist::MixHash(kHashSeed, board_[0]), board_[1]);
+}
+
 std::unique_ptr<State> ConnectFourState::Clone() const {
   return std::unique_ptr<State>(new ConnectFourState(*this));
 }
@@ -217,6 +278,7 @@ std::unique_ptr<State> ConnectFourGame::DeserializeState(
 ConnectFourState::ConnectFourState(int num_distinct_actions,
                                    const std::string& str)
     : State(num_distinct_actions, kNumPlayers) {
+  board_.fill(0);
   int xs = 0;
   int os = 0;
   int r = 5;
@@ -224,15 +286,14 @@ ConnectFourState::ConnectFourState(int num_distinct_actions,
   for (const char ch : str) {
     switch (ch) {
       case '.':
-        CellAt(r, c) = CellState::kEmpty;
         break;
       case 'x':
         ++xs;
-        CellAt(r, c) = CellState::kCross;
+        SetCellAt(r, c, CellState::kCross);
         break;
       case 'o':
         ++os;
-        CellAt(r, c) = CellState::kNought;
+        SetCellAt(r, c, CellState::kNought);
         break;
     }
     if (ch == '.' || ch == 'x' || ch == 'o') {
@@ -248,6 +309,14 @@ ConnectFourState::ConnectFourState(int num_distinct_actions,
   SPIEL_CHECK_TRUE(c == 0 &&
                    ("Problem parsing state (column value should be 0)"));
   current_player_ = (xs == os) ? 0 : 1;
+  // Recover the cached outcome from the reconstructed board.
+  if (HasLine(0)) {
+    outcome_ = Outcome::kPlayer1;
+  } else if (HasLine(1)) {
+    outcome_ = Outcome::kPlayer2;
+  } else if (IsFull()) {
+    outcome_ = Outcome::kDraw;
+  }
 }
 
 }  // namespace connect_four
@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_CONNECT_FOUR_H_
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -50,6 +51,14 @@ enum class CellState {
   kCross,
 };
 
+// Outcome of the game, maintained incrementally by DoApplyAction.
+enum class Outcome {
+  kPlayer1 = 0,
+  kPlayer2 = 1,
+  kUnknown,
+  kDraw,
+};
+
 // State of an in-play game.
 class ConnectFourState : public State {
  public:
@@ -59,8 +68,10 @@ class ConnectFourState : public State {
 
   int CurrentPlayer() const override;
   std::vector<Action> LegalActions() const override;
+  void LegalActionsBitset(uint64_t* out) const override;
   std::string ActionToString(int player, Action action_id) const override;
   std::string ToString() const override;
+  void AppendToString(std::string* str) const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(int player) const override;
@@ -68,20 +79,25 @@ class ConnectFourState : public State {
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
   void UndoAction(int player, Action move) override;
+  uint64_t HashValue() const override;
+  std::string CanonicalKey() const override;
 
  protected:
   void DoApplyAction(Action move) override;
 
  private:
-  CellState& CellAt(int row, int col);
   CellState CellAt(int row, int col) const;
+  void SetCellAt(int row, int col, CellState state);
   bool HasLine(int player) const;  // Does this player have a line?
-  bool HasLineFrom(int player, int row, int col) const;
-  bool HasLineFromInDirection(int player, int row, int col, int drow,
-                              int dcol) const;
-  bool IsFull() const;      // Is the board full?
-  int current_player_ = 0;  // Player zero goes first
-  std::array<CellState, kNumCells> board_;
+  bool IsFull() const;             // Is the board full?
+  int current_player_ = 0;         // Player zero goes first
+  // Set at move-application time, so IsTerminal() and Returns() are plain
+  // loads instead of re-running the shift-and-AND line checks.
+  Outcome outcome_ = Outcome::kUnknown;
+  // One bitboard plane per player: bit (row * (kCols + 1) + col) is set iff
+  // that player has a checker at (row, col). The unused guard column keeps
+  // the shift-and-AND win check from wrapping across rows.
+  std::array<uint64_t, kNumPlayers> board_;
 };
 
 // Game object.
@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/coop_box_pushing.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -158,6 +159,19 @@ CoopBoxPushingState::CoopBoxPushingState(int horizon)
           {ActionStatusType::kUnresolved, ActionStatusType::kUnresolved}) {
   field_.resize(kRows * kCols, '.');
 
+  // Coordinates must be valid (and distinct from every cell) before the
+  // first SetPlayer: SetField classifies orientation characters by them.
+  player_coords_[0] = {-1, -1};
+  player_coords_[1] = {-1, -1};
+
+  // Every cell starts empty, i.e. in plane 0; from here on SetField keeps
+  // the planes in sync with the field.
+  for (int p = 0; p < kNumPlayers; ++p) {
+    info_state_planes_[p].assign(kCellStates * kRows * kCols, 0.0);
+    std::fill(info_state_planes_[p].begin(),
+              info_state_planes_[p].begin() + kRows * kCols, 1.0);
+  }
+
   // Small boxes.
   SetField({3, 1}, 'b');
   SetField({3, 6}, 'b');
@@ -177,14 +191,31 @@ std::string CoopBoxPushingState::ActionToString(int player,
 }
 
 void CoopBoxPushingState::SetField(std::pair<int, int> coord, char v) {
-  field_[coord.first * kCols + coord.second] = v;
+  // Patch the per-player observation planes in place: a cell change touches
+  // exactly two entries per player, the old character's plane and the new
+  // character's plane.
+  const int cell = coord.first * kCols + coord.second;
+  const int plane_size = kRows * kCols;
+  for (int p = 0; p < kNumPlayers; ++p) {
+    info_state_planes_[p][ObservationPlane(coord, p) * plane_size + cell] =
+        0.0;
+  }
+  field_[cell] = v;
+  for (int p = 0; p < kNumPlayers; ++p) {
+    info_state_planes_[p][ObservationPlane(coord, p) * plane_size + cell] =
+        1.0;
+  }
 }
 
 void CoopBoxPushingState::SetPlayer(std::pair<int, int> coord, int player,
                                     OrientationType orientation) {
-  SetField(coord, ToCharacter(orientation));
+  // Coordinates are updated before the field so that SetField attributes the
+  // orientation character to the arriving player when patching the planes.
+  // (Callers clear the player's previous cell before SetPlayer, while the
+  // coordinates still point at it.)
   player_coords_[player] = coord;
   player_orient_[player] = orientation;
+  SetField(coord, ToCharacter(orientation));
 }
 
 void CoopBoxPushingState::SetPlayer(std::pair<int, int> coord, int player) {
@@ -323,7 +354,13 @@ void CoopBoxPushingState::ResolveMoves() {
 }
 
 void CoopBoxPushingState::DoApplyAction(Action action) {
-  if (IsSimultaneousNode()) ApplyFlatJointAction(action);
+  if (IsSimultaneousNode()) {
+    // A flat joint action only queues the two moves; without this return it
+    // would fall through and be re-read as a chance action (ids 2 and 3
+    // resolve moves whose success was never determined).
+    ApplyFlatJointAction(action);
+    return;
+  }
 
   if (action == kChanceSuccess) {
     // Success.
@@ -450,16 +487,17 @@ int CoopBoxPushingState::ObservationPlane(std::pair<int, int> coord,
 
 void CoopBoxPushingState::InformationStateAsNormalizedVector(
     int player, std::vector<double>* values) const {
-  values->resize(kCellStates * kRows * kCols);
-  int plane_size = kRows * kCols;
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  *values = info_state_planes_[player];
+}
 
-  for (int r = 0; r < kRows; r++) {
-    for (int c = 0; c < kCols; c++) {
-      int plane = ObservationPlane({r, c}, player);
-      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
-      (*values)[plane * plane_size + r * kCols + c] = 1.0;
-    }
-  }
+void CoopBoxPushingState::InformationStateAsNormalizedVector(
+    int player, double* buffer) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  std::copy(info_state_planes_[player].begin(),
+            info_state_planes_[player].end(), buffer);
 }
 
 std::unique_ptr<State> CoopBoxPushingState::Clone() const {
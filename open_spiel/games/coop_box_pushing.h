@@ -67,6 +67,20 @@ class CoopBoxPushingState : public SimMoveState {
   }
   void InformationStateAsNormalizedVector(int player,
                                           std::vector<double>* values) const;
+  void InformationStateAsNormalizedVector(int player, double* buffer) const;
+
+  // Const view of `player`'s normalized observation planes, laid out as
+  // InformationStateNormalizedVectorShape(). The planes are maintained
+  // incrementally — SetField patches the entries a cell change touches — so
+  // reading them here avoids both the per-step rebuild and the copy made by
+  // InformationStateAsNormalizedVector. The view is invalidated by the next
+  // ApplyAction(s).
+  const std::vector<double>& InformationStatePlanes(int player) const {
+    SPIEL_CHECK_GE(player, 0);
+    SPIEL_CHECK_LT(player, num_players_);
+    return info_state_planes_[player];
+  }
+
   int CurrentPlayer() const override {
     return IsTerminal() ? kTerminalPlayerId : cur_player_;
   }
@@ -114,6 +128,10 @@ class CoopBoxPushingState : public SimMoveState {
   std::array<ActionStatusType, 2> action_status_;
   // Actual field used by the players.
   std::vector<char> field_;
+  // Incrementally maintained normalized observation planes, one buffer per
+  // player (the same cell maps to different planes depending on which player
+  // stands on it); patched in place by SetField().
+  std::array<std::vector<double>, 2> info_state_planes_;
 };
 
 class CoopBoxPushingGame : public SimMoveGame {
@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/coop_box_pushing.h"
 
+#include <random>
+
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -29,10 +31,82 @@ void BasicCoopBoxPushingTests() {
   testing::RandomSimTest(*LoadGame("coop_box_pushing"), 100);
 }
 
+void IncrementalPlanesMatchBoardTest() {
+  // The per-player observation planes are patched incrementally by SetField
+  // rather than rebuilt per query; check along a random playout that they
+  // stay one-hot per cell and consistent with the board.
+  std::unique_ptr<Game> game = LoadGame("coop_box_pushing");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<int> shape = game->InformationStateNormalizedVectorShape();
+  const int num_planes = shape[0];
+  const int rows = shape[1];
+  const int cols = shape[2];
+  const int plane_size = rows * cols;
+  std::mt19937 rng(5601);
+  for (int step = 0; step < 300 && !state->IsTerminal(); ++step) {
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[rng() % actions.size()]);
+    const auto& box_state = static_cast<const CoopBoxPushingState&>(*state);
+    // The board rows follow three header lines of the string representation.
+    std::string str = state->ToString();
+    std::size_t board_start = 0;
+    for (int line = 0; line < 3; ++line) {
+      board_start = str.find('\n', board_start) + 1;
+    }
+    for (int player = 0; player < 2; ++player) {
+      const std::vector<double>& planes =
+          box_state.InformationStatePlanes(player);
+      // The patched planes must equal the copy the API hands out..
+      SPIEL_CHECK_TRUE(planes ==
+                       state->InformationStateAsNormalizedVector(player));
+      // ..and stay one-hot per cell, in a plane consistent with the cell's
+      // character. '.', 'b' and 'B' map to fixed planes; an orientation
+      // character maps to its self plane for the player standing on it and
+      // to the matching other plane for the other player.
+      for (int cell = 0; cell < plane_size; ++cell) {
+        char v = str[board_start + (cell / cols) * (cols + 1) + cell % cols];
+        int plane = -1;
+        for (int p = 0; p < num_planes; ++p) {
+          if (planes[p * plane_size + cell] == 1.0) {
+            SPIEL_CHECK_EQ(plane, -1);
+            plane = p;
+          }
+        }
+        switch (v) {
+          case '.':
+            SPIEL_CHECK_EQ(plane, 0);
+            break;
+          case 'b':
+            SPIEL_CHECK_EQ(plane, 1);
+            break;
+          case 'B':
+            SPIEL_CHECK_EQ(plane, 2);
+            break;
+          case '<':
+            SPIEL_CHECK_TRUE(plane == 3 || plane == 4);
+            break;
+          case '>':
+            SPIEL_CHECK_TRUE(plane == 5 || plane == 6);
+            break;
+          case '^':
+            SPIEL_CHECK_TRUE(plane == 7 || plane == 8);
+            break;
+          case 'v':
+            SPIEL_CHECK_TRUE(plane == 9 || plane == 10);
+            break;
+          default:
+            SpielFatalError("Invalid character on field");
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace coop_box_pushing
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::coop_box_pushing::BasicCoopBoxPushingTests();
+  open_spiel::coop_box_pushing::IncrementalPlanesMatchBoardTest();
 }
@@ -41,6 +41,7 @@ const GameType kGameType{
     {
         {"players", {GameParameter::Type::kInt, false}},
         {"max_value", {GameParameter::Type::kInt, false}},
+        {"combineddeal", {GameParameter::Type::kBool, false}},
     }};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
@@ -53,11 +54,59 @@ REGISTER_SPIEL_GAME(kGameType, Factory);
 FPSBAGame::FPSBAGame(const GameParameters& params)
     : Game(kGameType, params),
       num_players_(ParameterValue<int>("players", kDefaultPlayers)),
-      max_value_(ParameterValue<int>("max_value", kDefaultMaxValue)) {}
+      max_value_(ParameterValue<int>("max_value", kDefaultMaxValue)) {
+  valuation_outcomes_.reserve(max_value_);
+  for (int i = 1; i <= max_value_; i++) {
+    valuation_outcomes_.push_back(std::make_pair(i, 1. / max_value_));
+  }
 
-FPSBAState::FPSBAState(int num_distinct_actions, int num_players)
+  // Tie-break resolution tables: entry m is the uniform distribution over
+  // the players whose bit is set in m, i.e. the players sharing the highest
+  // bid. Built for every subset once so the bid-resolution chance node reads
+  // a fixed table instead of recounting the bids.
+  tie_break_outcomes_.resize(std::size_t{1} << num_players_);
+  for (std::size_t mask = 1; mask < tie_break_outcomes_.size(); mask++) {
+    int num_tie = 0;
+    for (int player = 0; player < num_players_; player++) {
+      num_tie += (mask >> player) & 1;
+    }
+    for (int player = 0; player < num_players_; player++) {
+      if ((mask >> player) & 1) {
+        tie_break_outcomes_[mask].push_back(
+            std::make_pair(player, 1. / num_tie));
+      }
+    }
+  }
+
+  // With a combined deal, precompute the joint valuation table once: one
+  // outcome per assignment of valuations to the players, each equally
+  // likely. Outcome ids encode player p's valuation minus one in digit p of
+  // a base-max_value_ number.
+  combined_deal_ = ParameterValue<bool>("combineddeal", false);
+  if (combined_deal_) {
+    // The table is enumerated explicitly, so it must stay a reasonable size.
+    int64_t num_deals = 1;
+    for (int player = 0; player < num_players_; player++) {
+      num_deals *= max_value_;
+      SPIEL_CHECK_LE(num_deals, 1000000);
+    }
+    combined_outcomes_.reserve(num_deals);
+    for (Action id = 0; id < num_deals; id++) {
+      combined_outcomes_.push_back(std::make_pair(id, 1. / num_deals));
+    }
+  }
+}
+
+FPSBAState::FPSBAState(
+    int num_distinct_actions, int num_players,
+    const ActionsAndProbs* valuation_outcomes,
+    const ActionsAndProbs* combined_outcomes,
+    const std::vector<ActionsAndProbs>* tie_break_outcomes)
     : State(num_distinct_actions, num_players),
-      max_value_(num_distinct_actions) {}
+      max_value_(num_distinct_actions),
+      valuation_outcomes_(valuation_outcomes),
+      combined_outcomes_(combined_outcomes),
+      tie_break_outcomes_(tie_break_outcomes) {}
 
 int FPSBAState::CurrentPlayer() const {
   if (valuations_.size() < num_players_) return kChancePlayerId;
@@ -77,8 +126,29 @@ std::vector<Action> FPSBAState::EligibleWinners() const {
   return eligibles;
 }
 
+int FPSBAState::MaxBidderMask() const {
+  int max_bid = -1;
+  int mask = 0;
+  for (int player = 0; player < num_players_; player++) {
+    if (bids_[player] > max_bid) {
+      max_bid = bids_[player];
+      mask = 1 << player;
+    } else if (bids_[player] == max_bid) {
+      mask |= 1 << player;
+    }
+  }
+  return mask;
+}
+
 std::vector<Action> FPSBAState::LegalActions() const {
   if (valuations_.size() < num_players_) {
+    // With a combined deal the single chance node covers every joint
+    // assignment of valuations.
+    if (combined_outcomes_ != nullptr) {
+      std::vector<Action> deals(combined_outcomes_->size());
+      std::iota(deals.begin(), deals.end(), 0);
+      return deals;
+    }
     std::vector<Action> values(max_value_);
     std::iota(values.begin(), values.end(), 1);
     return values;
@@ -98,6 +168,16 @@ std::string FPSBAState::ActionToString(int player, Action action_id) const {
   if (player != kChancePlayerId) {
     return absl::StrCat("Player ", player, " bid: ", action_id);
   } else if (valuations_.size() < num_players_) {
+    if (combined_outcomes_ != nullptr) {
+      std::vector<int> values;
+      values.reserve(num_players_);
+      Action remaining = action_id;
+      for (int p = 0; p < num_players_; p++) {
+        values.push_back(remaining % max_value_ + 1);
+        remaining /= max_value_;
+      }
+      return absl::StrCat("Values: ", absl::StrJoin(values, ","));
+    }
     return absl::StrCat("Player ", valuations_.size(), " value: ", action_id);
   } else {
     return absl::StrCat("Chose winner ", action_id);
@@ -126,7 +206,17 @@ std::unique_ptr<State> FPSBAState::Clone() const {
 
 void FPSBAState::DoApplyAction(Action action_id) {
   if (valuations_.size() < num_players_) {
-    valuations_.push_back(action_id);
+    if (combined_outcomes_ != nullptr) {
+      // Decode the joint deal: digit p of the base-max_value_ outcome id is
+      // player p's valuation minus one.
+      Action remaining = action_id;
+      for (int p = 0; p < num_players_; p++) {
+        valuations_.push_back(remaining % max_value_ + 1);
+        remaining /= max_value_;
+      }
+    } else {
+      valuations_.push_back(action_id);
+    }
   } else if (bids_.size() < num_players_) {
     bids_.push_back(action_id);
   } else if (winner_ == kInvalidPlayer) {
@@ -186,23 +276,29 @@ void FPSBAState::ObservationAsNormalizedVector(
 }
 
 ActionsAndProbs FPSBAState::ChanceOutcomes() const {
-  ActionsAndProbs valuesAndProbs;
   if (valuations_.size() < num_players_) {
-    for (int i = 1; i <= max_value_; i++) {
-      valuesAndProbs.push_back(std::make_pair(i, 1. / max_value_));
-    }
+    if (combined_outcomes_ != nullptr) return *combined_outcomes_;
+    return *valuation_outcomes_;
   } else if (bids_.size() == num_players_ && winner_ == kInvalidPlayer) {
-    int max_bid = *std::max_element(bids_.begin(), bids_.end());
-    int num_tie = std::count(bids_.begin(), bids_.end(), max_bid);
-    for (int player = 0; player < num_players_; player++) {
-      if (bids_[player] == max_bid) {
-        valuesAndProbs.push_back(std::make_pair(player, 1. / num_tie));
-      }
-    }
+    return (*tie_break_outcomes_)[MaxBidderMask()];
   } else {
     SpielFatalError("This isn't a chance node");
+    return {};
+  }
+}
+
+const ActionsAndProbs* FPSBAState::StaticChanceOutcomes() const {
+  // Every chance node reads a table owned by the game: the (joint or
+  // per-player) valuation deal, or the tie-break distribution for the set
+  // of players sharing the highest bid.
+  if (valuations_.size() < num_players_) {
+    return combined_outcomes_ != nullptr ? combined_outcomes_
+                                         : valuation_outcomes_;
+  }
+  if (bids_.size() == num_players_ && winner_ == kInvalidPlayer) {
+    return &(*tie_break_outcomes_)[MaxBidderMask()];
   }
-  return valuesAndProbs;
+  return nullptr;
 }
 
 }  // namespace first_sealed_auction
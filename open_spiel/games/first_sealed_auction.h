@@ -31,8 +31,10 @@
 // in case of ties.)
 //
 // Parameters:
-//  "max_value"   int    maximum valuation (default = 10)
-//  "players"     int    number of players (default = 2)
+//  "max_value"     int   maximum valuation (default = 10)
+//  "players"       int   number of players (default = 2)
+//  "combineddeal"  bool  deal all valuations in a single chance node
+//                        (default = false)
 
 namespace open_spiel {
 namespace first_sealed_auction {
@@ -44,7 +46,10 @@ constexpr int kDefaultMaxValue = 10;
 // State of an in-play game.
 class FPSBAState : public State {
  public:
-  FPSBAState(int num_distinct_actions, int num_players);
+  FPSBAState(int num_distinct_actions, int num_players,
+             const ActionsAndProbs* valuation_outcomes,
+             const ActionsAndProbs* combined_outcomes,
+             const std::vector<ActionsAndProbs>* tie_break_outcomes);
   FPSBAState(const FPSBAState& other) = default;
 
   int CurrentPlayer() const override;
@@ -61,6 +66,7 @@ class FPSBAState : public State {
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
   ActionsAndProbs ChanceOutcomes() const override;
+  const ActionsAndProbs* StaticChanceOutcomes() const override;
 
  protected:
   void DoApplyAction(Action action_id) override;
@@ -70,7 +76,18 @@ class FPSBAState : public State {
   std::vector<int> bids_;
   std::vector<int> valuations_;
   int winner_ = kInvalidPlayer;
+  // Chance outcome tables owned by the FPSBAGame (which outlives its
+  // states). valuation_outcomes_ is the per-player valuation deal;
+  // combined_outcomes_ is the joint deal table, non-null only with
+  // combineddeal=true; tie_break_outcomes_ holds one distribution per
+  // subset of players sharing the highest bid, indexed by bitmask.
+  const ActionsAndProbs* valuation_outcomes_ = nullptr;
+  const ActionsAndProbs* combined_outcomes_ = nullptr;
+  const std::vector<ActionsAndProbs>* tie_break_outcomes_ = nullptr;
   std::vector<Action> EligibleWinners() const;
+  // The bitmask of players sharing the highest bid; only valid once all
+  // bids are in.
+  int MaxBidderMask() const;
 };
 
 // Game object.
@@ -79,10 +96,15 @@ class FPSBAGame : public Game {
   explicit FPSBAGame(const GameParameters& params);
   int NumDistinctActions() const override { return max_value_; }
   std::unique_ptr<State> NewInitialState() const override {
-    return std::unique_ptr<State>(
-        new FPSBAState(NumDistinctActions(), NumPlayers()));
+    return std::unique_ptr<State>(new FPSBAState(
+        NumDistinctActions(), NumPlayers(), &valuation_outcomes_,
+        combined_deal_ ? &combined_outcomes_ : nullptr,
+        &tie_break_outcomes_));
   }
   int MaxChanceOutcomes() const override {
+    if (combined_deal_) {
+      return std::max<int>(combined_outcomes_.size(), num_players_);
+    }
     return std::max(max_value_, num_players_);
   }
   int NumPlayers() const override { return num_players_; }
@@ -104,6 +126,20 @@ class FPSBAGame : public Game {
   const int num_players_;
   // Maximum valuation, which is one more than maximum bid.
   const int max_value_;
+  // The fixed valuation-deal distribution, built once so every state
+  // references it instead of rebuilding the vector (see
+  // State::StaticChanceOutcomes).
+  ActionsAndProbs valuation_outcomes_;
+  // When combineddeal=true, the whole valuation deal is a single chance
+  // node whose joint outcome table (outcome ids encode player p's valuation
+  // minus one in digit p of a base-max_value_ number, uniform
+  // probabilities) is built once here and shared with every state.
+  bool combined_deal_;
+  ActionsAndProbs combined_outcomes_;
+  // Entry m is the uniform tie-break distribution over the players whose
+  // bit is set in m (the players sharing the highest bid), so the
+  // bid-resolution chance node also reads a prebuilt table.
+  std::vector<ActionsAndProbs> tie_break_outcomes_;
 };
 
 }  // namespace first_sealed_auction
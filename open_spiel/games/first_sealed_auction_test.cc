@@ -53,6 +53,57 @@ void TieBreak() {
   SPIEL_CHECK_TRUE(state->IsTerminal());
   SPIEL_CHECK_EQ(state->Returns(), std::vector<double>({0, 0, 2}));
 }
+
+// Each joint outcome must produce the same post-deal state as dealing the
+// valuations one chance node at a time.
+void CombinedDealMatchesSequentialDeal() {
+  std::unique_ptr<Game> seq_game =
+      LoadGame("first_sealed_auction", {{"max_value", GameParameter(4)}});
+  std::unique_ptr<Game> comb_game =
+      LoadGame("first_sealed_auction", {{"max_value", GameParameter(4)},
+                                        {"combineddeal", GameParameter(true)}});
+
+  std::unique_ptr<State> comb_root = comb_game->NewInitialState();
+  auto outcomes = comb_root->ChanceOutcomes();
+  SPIEL_CHECK_EQ(outcomes.size(), 16);
+
+  for (const auto& outcome : outcomes) {
+    std::unique_ptr<State> comb_state = comb_root->Child(outcome.first);
+
+    // Player 0's valuation minus one is the low digit of the joint outcome
+    // in base max_value.
+    std::unique_ptr<State> seq_state = seq_game->NewInitialState();
+    seq_state->ApplyAction(outcome.first % 4 + 1);
+    seq_state->ApplyAction(outcome.first / 4 + 1);
+
+    SPIEL_CHECK_EQ(comb_state->ToString(), seq_state->ToString());
+    for (int p = 0; p < 2; p++) {
+      SPIEL_CHECK_EQ(comb_state->InformationState(p),
+                     seq_state->InformationState(p));
+    }
+  }
+}
+
+// The tie-break chance node now serves a table owned by the game; check it
+// against ChanceOutcomes.
+void TieBreakStaticOutcomes() {
+  FPSBAGame game({{"players", open_spiel::GameParameter(3)},
+                  {"max_value", open_spiel::GameParameter(5)}});
+  auto state = game.NewInitialState();
+  state->ApplyAction(5);
+  state->ApplyAction(2);
+  state->ApplyAction(5);
+  state->ApplyAction(3);  // Player 0 bids 3.
+  state->ApplyAction(1);  // Player 1 bids 1.
+  state->ApplyAction(3);  // Player 2 bids 3.
+  SPIEL_CHECK_TRUE(state->IsChanceNode());
+  const ActionsAndProbs* static_outcomes = state->StaticChanceOutcomes();
+  SPIEL_CHECK_TRUE(static_outcomes != nullptr);
+  SPIEL_CHECK_TRUE(*static_outcomes == state->ChanceOutcomes());
+  SPIEL_CHECK_EQ(static_outcomes->size(), 2);
+  SPIEL_CHECK_EQ((*static_outcomes)[0].first, 0);
+  SPIEL_CHECK_EQ((*static_outcomes)[1].first, 2);
+}
 }  // namespace
 }  // namespace first_sealed_auction
 }  // namespace open_spiel
@@ -68,5 +119,13 @@ int main(int argc, char** argv) {
   open_spiel::first_sealed_auction::BasicFPSBATests(
       {{"players", open_spiel::GameParameter(2)},
        {"max_value", open_spiel::GameParameter(40)}});
+  open_spiel::first_sealed_auction::BasicFPSBATests(
+      {{"combineddeal", open_spiel::GameParameter(true)}});
+  open_spiel::first_sealed_auction::BasicFPSBATests(
+      {{"players", open_spiel::GameParameter(3)},
+       {"max_value", open_spiel::GameParameter(4)},
+       {"combineddeal", open_spiel::GameParameter(true)}});
   open_spiel::first_sealed_auction::TieBreak();
+  open_spiel::first_sealed_auction::CombinedDealMatchesSequentialDeal();
+  open_spiel::first_sealed_auction::TieBreakStaticOutcomes();
 }
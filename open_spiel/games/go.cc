@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/go.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "open_spiel/games/go/go_board.h"
@@ -45,6 +46,10 @@ const GameType kGameType{
         {"board_size",
          GameType::ParameterSpec{GameParameter::Type::kInt, false}},
     },
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/false,
+    /*provides_quick_evaluate=*/true,
 };
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
@@ -77,9 +82,41 @@ std::vector<GoPoint> HandicapStones(int num_handicap) {
 
 }  // namespace
 
+PositionHashSet::PositionHashSet(int max_entries) {
+  // Table capacity is the smallest power of two holding max_entries at a load
+  // factor of at most 1/2, so probe sequences stay short.
+  std::size_t capacity = 2;
+  while (capacity < 2 * static_cast<std::size_t>(max_entries)) capacity *= 2;
+  table_.resize(capacity, 0);
+  mask_ = capacity - 1;
+  contains_zero_ = false;
+}
+
+bool PositionHashSet::insert(uint64_t hash) {
+  if (hash == 0) {
+    bool was_inserted = !contains_zero_;
+    contains_zero_ = true;
+    return was_inserted;
+  }
+  std::size_t i = hash & mask_;
+  while (table_[i] != 0) {
+    if (table_[i] == hash) return false;
+    i = (i + 1) & mask_;
+  }
+  table_[i] = hash;
+  return true;
+}
+
+void PositionHashSet::clear() {
+  std::fill(table_.begin(), table_.end(), 0);
+  contains_zero_ = false;
+}
+
 GoState::GoState(int board_size, float komi, int handicap)
     : State(go::NumDistinctActions(board_size), go::NumPlayers()),
       board_(board_size),
+      // One hash per move, plus the start position.
+      repetitions_(MaxGameLength(board_size) + 1),
       komi_(komi),
       handicap_(handicap),
       to_play_(GoColor::kBlack) {
@@ -180,6 +217,16 @@ std::unique_ptr<State> GoState::Clone() const {
   return std::unique_ptr<State>(new GoState(*this));
 }
 
+double GoState::QuickEvaluate() const {
+  // Tromp-Taylor score (a single board scan) from black's (player 0's)
+  // perspective, normalized by the number of points on the board and clamped
+  // so the komi cannot push it outside [-1, 1].
+  const int num_points =
+      board_.board_size() * board_.board_size();
+  const double score = TrompTaylorScore(board_, komi_, handicap_);
+  return std::max(-1.0, std::min(1.0, score / num_points));
+}
+
 void GoState::UndoAction(int player, Action action) {
   // We don't have direct undo functionality, but copying the board and
   // replaying all actions is still pretty fast (> 1 million undos/second).
@@ -194,7 +241,7 @@ void GoState::DoApplyAction(Action action) {
   SPIEL_CHECK_TRUE(board_.PlayMove(action, to_play_));
   to_play_ = OppColor(to_play_);
 
-  bool was_inserted = repetitions_.insert(board_.HashValue()).second;
+  bool was_inserted = repetitions_.insert(board_.HashValue());
   if (!was_inserted && action != kPass) {
     // We have encountered this position before.
     superko_ = true;
@@ -19,7 +19,6 @@
 #include <cstring>
 #include <map>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 #include "open_spiel/games/go/go_board.h"
@@ -58,6 +57,29 @@ inline int MaxGameLength(int board_size) { return board_size * board_size * 2; }
 
 inline int ColorToPlayer(GoColor c) { return static_cast<int>(c); }
 
+// Fixed-capacity open-addressing hash set of Zobrist hash snapshots, used to
+// answer "have we seen this position before?" (positional superko) with a
+// short linear probe and no per-insert allocation. The hashes are already
+// uniformly distributed, so they are used directly as probe start points.
+class PositionHashSet {
+ public:
+  // max_entries is the maximum number of distinct hashes that will ever be
+  // inserted; the table is sized to keep the load factor at or below 1/2.
+  explicit PositionHashSet(int max_entries);
+
+  // Inserts the hash and returns whether it was newly inserted.
+  bool insert(uint64_t hash);
+
+  void clear();
+
+ private:
+  std::vector<uint64_t> table_;
+  uint64_t mask_;
+  // Zero is the empty-slot marker (and also the empty board's hash), so it is
+  // tracked separately.
+  bool contains_zero_;
+};
+
 // State of an in-play game.
 class GoState : public State {
  public:
@@ -86,6 +108,9 @@ class GoState : public State {
   std::unique_ptr<State> Clone() const override;
   void UndoAction(int player, Action action) override;
 
+  uint64_t HashValue() const override { return board_.HashValue(); }
+  double QuickEvaluate() const override;
+
   const GoBoard& board() const { return board_; }
 
  protected:
@@ -96,17 +121,8 @@ class GoState : public State {
 
   GoBoard board_;
 
-  // RepetitionTable records which positions we have already encountered.
-  // We are already indexing by board hash, so there is no need to hash that
-  // hash again, so we use a custom passthrough hasher.
-  class PassthroughHash {
-   public:
-    std::size_t operator()(uint64_t x) const {
-      return static_cast<std::size_t>(x);
-    }
-  };
-  using RepetitionTable = std::unordered_set<uint64_t, PassthroughHash>;
-  RepetitionTable repetitions_;
+  // Positions we have already encountered, for superko detection.
+  PositionHashSet repetitions_;
 
   const float komi_;
   const int handicap_;
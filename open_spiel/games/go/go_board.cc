@@ -16,7 +16,7 @@
 
 #include <iomanip>
 
-#include "open_spiel/games/chess/chess_common.h"
+#include "open_spiel/games/zobrist.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
@@ -24,17 +24,6 @@ namespace go {
 
 namespace {
 
-// Calls f for all 4 direct neighbours of p.
-// f should have type void f(GoPoint n), but is passed as a template so we can
-// elide the function call overhead.
-template <typename F>
-void Neighbours(GoPoint p, const F& f) {
-  f(p + kVirtualBoardSize);
-  f(p + 1);
-  f(p - 1);
-  f(p - kVirtualBoardSize);
-}
-
 std::vector<GoPoint> MakeBoardPoints(int board_size) {
   std::vector<GoPoint> points;
   points.reserve(board_size * board_size);
@@ -260,7 +249,7 @@ bool GoBoard::PlayMove(GoPoint p, GoColor c) {
 }
 
 void GoBoard::SetStone(GoPoint p, GoColor c) {
-  static const chess_common::ZobristTable<uint64_t, kVirtualBoardPoints, 2>
+  static const zobrist::ZobristTable<uint64_t, kVirtualBoardPoints, 2>
       zobrist_values(
           /*seed=*/2765481);
 
@@ -270,6 +259,19 @@ void GoBoard::SetStone(GoPoint p, GoColor c) {
   board_[p].color = c;
 }
 
+GoPoint GoBoard::FindChainHead(GoPoint p) {
+  GoPoint head = board_[p].chain_head;
+  while (board_[head].chain_head != head) head = board_[head].chain_head;
+
+  // Path compression: point everything we walked over directly at the root.
+  while (board_[p].chain_head != head) {
+    GoPoint next = board_[p].chain_head;
+    board_[p].chain_head = head;
+    p = next;
+  }
+  return head;
+}
+
 // Combines the groups around the newly placed stone at vertex. If no groups
 // are available for joining, the new stone is placed as a new group.
 void GoBoard::JoinChainsAround(GoPoint p, GoColor c) {
@@ -280,7 +282,7 @@ void GoBoard::JoinChainsAround(GoPoint p, GoColor c) {
       Chain& c = chain(n);
       if (c.num_stones > largest_chain_size) {
         largest_chain_size = c.num_stones;
-        largest_chain_head = ChainHead(n);
+        largest_chain_head = FindChainHead(n);
       }
     }
   });
@@ -291,17 +293,14 @@ void GoBoard::JoinChainsAround(GoPoint p, GoColor c) {
 
   Neighbours(p, [this, c, &largest_chain_head](GoPoint n) {
     if (PointColor(n) == c) {
-      GoPoint chain_head = ChainHead(n);
+      GoPoint chain_head = FindChainHead(n);
       if (chain_head != largest_chain_head) {
-        chain(largest_chain_head).merge(chain(n));
+        chains_[largest_chain_head].merge(chains_[chain_head]);
 
-        // Set all stones in the smaller string to be part of the larger
-        // chain.
-        GoPoint cur = n;
-        do {
-          board_[cur].chain_head = largest_chain_head;
-          cur = board_[cur].chain_next;
-        } while (cur != n);
+        // Union-find merge: the smaller chain's root now points at the
+        // larger chain's root, instead of relabelling every stone of the
+        // smaller chain.
+        board_[chain_head].chain_head = largest_chain_head;
 
         // Connect the 2 linked lists representing the stones in the two
         // chains.
@@ -345,7 +344,7 @@ int GoBoard::CaptureDeadChains(GoPoint p, GoColor c) {
 }
 
 void GoBoard::RemoveChain(GoPoint p) {
-  GoPoint this_chain_head = ChainHead(p);
+  GoColor dying_color = PointColor(p);
   GoPoint cur = p;
   do {
     GoPoint next = board_[cur].chain_next;
@@ -353,8 +352,14 @@ void GoBoard::RemoveChain(GoPoint p) {
     SetStone(cur, GoColor::kEmpty);
     InitNewChain(cur);
 
-    Neighbours(cur, [this, this_chain_head, cur](GoPoint n) {
-      if (ChainHead(n) != this_chain_head || IsEmpty(n)) {
+    // Adjacent stones of the dying colour are always part of the dying chain
+    // (same-coloured neighbours are joined on placement), and they gain their
+    // liberties when they are removed themselves. Everything else - other
+    // chains, empty vertices, and already-removed stones - gains a liberty
+    // now. We test the colour rather than the chain head because parent
+    // pointers within the dying chain are being reset as we walk it.
+    Neighbours(cur, [this, dying_color, cur](GoPoint n) {
+      if (PointColor(n) != dying_color) {
         chain(n).add_liberty(cur);
       }
     });
@@ -61,6 +61,17 @@ GoPoint GoPointFrom2DPoint(std::pair<int, int> row_col);
 // of the specified size.
 const std::vector<GoPoint> &BoardPoints(int board_size);
 
+// Calls f for all 4 direct neighbours of p.
+// f should have type void f(GoPoint n), but is passed as a template so we can
+// elide the function call overhead.
+template <typename F>
+void Neighbours(GoPoint p, const F &f) {
+  f(p + kVirtualBoardSize);
+  f(p + 1);
+  f(p - 1);
+  f(p - kVirtualBoardSize);
+}
+
 // Simple Go board that is optimized for speed.
 // It only implements the minimum of functionality necessary to support the
 // search and is optimized for speed and size. Importantly, it fits on the
@@ -114,7 +125,14 @@ class GoBoard {
 
   // Head of a chain; each chain has exactly one head that can be used to
   // uniquely identify it. Chain heads may change over successive playMove()s.
-  inline GoPoint ChainHead(GoPoint p) const { return board_[p].chain_head; }
+  // Chains form a union-find structure: each stone stores a parent pointer
+  // and the head is the root, so merging two chains is a single pointer
+  // update instead of relabelling every stone.
+  inline GoPoint ChainHead(GoPoint p) const {
+    GoPoint head = board_[p].chain_head;
+    while (board_[head].chain_head != head) head = board_[head].chain_head;
+    return head;
+  }
 
   class GroupIter {
    public:
@@ -156,6 +174,10 @@ class GoBoard {
   }
 
  private:
+  // Finds the chain head like ChainHead, but also applies union-find path
+  // compression so that later lookups are cheaper.
+  GoPoint FindChainHead(GoPoint p);
+
   void JoinChainsAround(GoPoint p, GoColor c);
   void SetStone(GoPoint p, GoColor c);
   void RemoveLibertyFromNeighbouringChains(GoPoint p);
@@ -164,6 +186,7 @@ class GoBoard {
   void InitNewChain(GoPoint p);
 
   struct Vertex {
+    // Union-find parent pointer; the chain head is the root of the tree.
     GoPoint chain_head;
     GoPoint chain_next;
     GoColor color;
@@ -189,7 +212,7 @@ class GoBoard {
     void remove_liberty(GoPoint p);
   };
 
-  Chain &chain(GoPoint p) { return chains_[ChainHead(p)]; }
+  Chain &chain(GoPoint p) { return chains_[FindChainHead(p)]; }
   const Chain &chain(GoPoint p) const { return chains_[ChainHead(p)]; }
 
   std::array<Vertex, kVirtualBoardPoints> board_;
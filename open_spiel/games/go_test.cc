@@ -38,6 +38,17 @@ void BasicGoTests() {
   testing::RandomSimTestWithUndo(*LoadGame("go", params), 3);
 }
 
+void QuickEvaluateTest() {
+  // Empty board: all territory is neutral, so only the komi counts.
+  GoState state(kBoardSize, kKomi, 0);
+  SPIEL_CHECK_LT(state.QuickEvaluate(), 0.0);
+
+  // With only the black handicap stones on the board, every empty point is
+  // black territory under Tromp-Taylor scoring.
+  GoState handicap_state(kBoardSize, kKomi, 2);
+  SPIEL_CHECK_GT(handicap_state.QuickEvaluate(), 0.9);
+}
+
 void HandicapTest() {
   GoState state(kBoardSize, kKomi, 2);
   SPIEL_CHECK_EQ(state.CurrentPlayer(), ColorToPlayer(GoColor::kWhite));
@@ -51,5 +62,6 @@ void HandicapTest() {
 
 int main(int argc, char** argv) {
   open_spiel::go::BasicGoTests();
+  open_spiel::go::QuickEvaluateTest();
   open_spiel::go::HandicapTest();
 }
@@ -50,6 +50,11 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Bit c of a hand or deck mask stands for the card numbered c + 1.
+uint32_t FullDeckMask(int num_cards) {
+  return num_cards == 32 ? ~uint32_t{0} : (uint32_t{1} << num_cards) - 1;
+}
+
 PointsOrder ParsePointsOrder(const std::string& po_str) {
   if (po_str == "random") {
     return PointsOrder::kRandom;
@@ -74,31 +79,22 @@ GoofspielState::GoofspielState(int num_distinct_actions, int num_players,
       current_player_(kInvalidPlayer),
       winners_({}),
       turns_(0),
-      point_card_index_(-1) {
-  // Points and point-card deck.
+      point_card_(kInvalidCard) {
+  // Points, point-card deck and player hands.
   points_.resize(num_players_);
   std::fill(points_.begin(), points_.end(), 0);
-  point_deck_.resize(num_cards_);
-  for (int point_value = 1; point_value <= num_cards_; ++point_value) {
-    point_deck_[point_value - 1] = point_value;
-  }
-
-  // Player hands.
-  player_hands_.clear();
-  for (int p = 0; p < num_players_; ++p) {
-    std::vector<bool> hand(num_cards_, true);
-    player_hands_.push_back(hand);
-  }
+  point_deck_ = FullDeckMask(num_cards_);
+  player_hands_.assign(num_players_, FullDeckMask(num_cards_));
 
-  // Set the points card index.
+  // Set the first point card.
   if (points_order_ == PointsOrder::kRandom) {
-    point_card_index_ = -1;
+    point_card_ = kInvalidCard;
     current_player_ = kChancePlayerId;
   } else if (points_order_ == PointsOrder::kAscending) {
-    point_card_index_ = 0;
+    point_card_ = 1;
     current_player_ = kSimultaneousPlayerId;
   } else if (points_order_ == PointsOrder::kDescending) {
-    point_card_index_ = num_cards - 1;
+    point_card_ = num_cards;
     current_player_ = kSimultaneousPlayerId;
   }
 
@@ -120,7 +116,12 @@ void GoofspielState::DoApplyAction(Action action_id) {
     return;
   }
   SPIEL_CHECK_TRUE(IsChanceNode());
-  point_card_index_ = action_id;
+  // Outcome i reveals the i-th smallest card left in the deck, i.e. the
+  // i-th lowest set bit, preserving the pre-bitmask outcome numbering.
+  uint32_t deck = point_deck_;
+  for (int i = 0; i < action_id; ++i) deck &= deck - 1;
+  SPIEL_CHECK_NE(deck, 0);
+  point_card_ = __builtin_ctz(deck) + 1;
   current_player_ = kSimultaneousPlayerId;
 }
 
@@ -131,7 +132,7 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
     const int action = actions[p];
     SPIEL_CHECK_GE(action, 0);
     SPIEL_CHECK_LT(action, num_cards_);
-    SPIEL_CHECK_TRUE(player_hands_[p][action]);
+    SPIEL_CHECK_NE(player_hands_[p] & (uint32_t{1} << action), 0);
   }
 
   // Find the highest bid
@@ -151,7 +152,7 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
 
   if (num_max_bids == 1) {
     // Winner takes the point card.
-    points_[max_bidder] += point_deck_[point_card_index_];
+    points_[max_bidder] += point_card_;
     win_sequence_.push_back(max_bidder);
   } else {
     // Tied among several players: discarded.
@@ -163,18 +164,18 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
 
   // Remove the cards from the player's hands.
   for (int p = 0; p < num_players_; ++p) {
-    player_hands_[p][actions[p]] = false;
+    player_hands_[p] &= ~(uint32_t{1} << actions[p]);
   }
 
   // Next player's turn.
   if (points_order_ == PointsOrder::kRandom) {
     current_player_ = kChancePlayerId;
-    point_deck_.erase(point_deck_.begin() + point_card_index_);
-    point_card_index_ = -1;
+    point_deck_ &= ~(uint32_t{1} << (point_card_ - 1));
+    point_card_ = kInvalidCard;
   } else if (points_order_ == PointsOrder::kAscending) {
-    point_card_index_++;
+    point_card_++;
   } else if (points_order_ == PointsOrder::kDescending) {
-    point_card_index_--;
+    point_card_--;
   }
 
   turns_++;
@@ -215,9 +216,10 @@ void GoofspielState::DoApplyActions(const std::vector<Action>& actions) {
 
 std::vector<std::pair<Action, double>> GoofspielState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes(point_deck_.size());
-  for (int i = 0; i < point_deck_.size(); i++) {
-    outcomes[i] = std::pair<Action, double>(i, 1.0 / point_deck_.size());
+  const int deck_size = __builtin_popcount(point_deck_);
+  std::vector<std::pair<Action, double>> outcomes(deck_size);
+  for (int i = 0; i < deck_size; i++) {
+    outcomes[i] = std::pair<Action, double>(i, 1.0 / deck_size);
   }
   return outcomes;
 }
@@ -230,10 +232,9 @@ std::vector<Action> GoofspielState::LegalActions(int player) const {
   SPIEL_CHECK_LT(player, num_players_);
 
   std::vector<Action> movelist;
-  for (int bid = 0; bid < player_hands_[player].size(); ++bid) {
-    if (player_hands_[player][bid]) {
-      movelist.push_back(bid);
-    }
+  movelist.reserve(__builtin_popcount(player_hands_[player]));
+  for (uint32_t hand = player_hands_[player]; hand != 0; hand &= hand - 1) {
+    movelist.push_back(__builtin_ctz(hand));
   }
   return movelist;
 }
@@ -258,11 +259,9 @@ std::string GoofspielState::ToString() const {
     absl::StrAppend(&result, "P");
     absl::StrAppend(&result, p);
     absl::StrAppend(&result, " hand: ");
-    for (int c = 0; c < num_cards_; ++c) {
-      if (player_hands_[p][c]) {
-        absl::StrAppend(&result, c + 1);
-        absl::StrAppend(&result, " ");
-      }
+    for (uint32_t hand = player_hands_[p]; hand != 0; hand &= hand - 1) {
+      absl::StrAppend(&result, __builtin_ctz(hand) + 1);
+      absl::StrAppend(&result, " ");
     }
     absl::StrAppend(&result, "\n");
   }
@@ -279,9 +278,9 @@ std::string GoofspielState::ToString() const {
     }
   }
 
-  if (point_card_index_ >= 0) {
+  if (point_card_ != kInvalidCard) {
     absl::StrAppend(&result, "Point card: ");
-    absl::StrAppend(&result, point_deck_[point_card_index_]);
+    absl::StrAppend(&result, point_card_);
     absl::StrAppend(&result, "\n");
   }
   return result + points_line + "\n";
@@ -331,11 +330,9 @@ std::string GoofspielState::InformationState(int player) const {
         absl::StrAppend(&result, "P");
         absl::StrAppend(&result, p);
         absl::StrAppend(&result, " hand: ");
-        for (int c = 0; c < num_cards_; ++c) {
-          if (player_hands_[p][c]) {
-            absl::StrAppend(&result, c + 1);
-            absl::StrAppend(&result, " ");
-          }
+        for (uint32_t hand = player_hands_[p]; hand != 0; hand &= hand - 1) {
+          absl::StrAppend(&result, __builtin_ctz(hand) + 1);
+          absl::StrAppend(&result, " ");
         }
         absl::StrAppend(&result, "\n");
 
@@ -358,9 +355,9 @@ std::string GoofspielState::InformationState(int player) const {
       win_sequence.push_back(' ');
     }
 
-    if (point_card_index_ >= 0) {
+    if (point_card_ != kInvalidCard) {
       absl::StrAppend(&result, "Point card: ");
-      absl::StrAppend(&result, point_deck_[point_card_index_]);
+      absl::StrAppend(&result, point_card_);
       absl::StrAppend(&result, "\n");
     }
     return result + win_sequence + "\n" + points_line + "\n";
@@ -394,7 +391,7 @@ void GoofspielState::InformationStateAsNormalizedVector(
   if (impinfo_) {
     // Bit vector of observing player's hand.
     for (int c = 0; c < num_cards_; ++c) {
-      values->push_back(player_hands_[player][c] ? 1 : 0);
+      values->push_back((player_hands_[player] >> c) & 1);
     }
 
     // Sequence of who won each trick.
@@ -422,7 +419,7 @@ void GoofspielState::InformationStateAsNormalizedVector(
     // Bit vectors encoding all players' hands.
     for (int p = 0; p < num_players_; ++p) {
       for (int c = 0; c < num_cards_; ++c) {
-        values->push_back(player_hands_[p][c] ? 1 : 0);
+        values->push_back((player_hands_[p] >> c) & 1);
       }
     }
   }
@@ -438,7 +435,11 @@ GoofspielGame::GoofspielGame(const GameParameters& params)
       num_players_(ParameterValue<int>("players", kDefaultNumPlayers)),
       points_order_(ParsePointsOrder(
           ParameterValue<std::string>("points_order", kDefaultPointsOrder))),
-      impinfo_(ParameterValue<bool>("imp_info", kDefaultImpInfo)) {}
+      impinfo_(ParameterValue<bool>("imp_info", kDefaultImpInfo)) {
+  // Hands and the point deck are single-word bitmasks.
+  SPIEL_CHECK_GE(num_cards_, 1);
+  SPIEL_CHECK_LE(num_cards_, 32);
+}
 
 std::unique_ptr<State> GoofspielGame::NewInitialState() const {
   return std::unique_ptr<State>(new GoofspielState(
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_GOOFSPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_GOOFSPIEL_H_
 
+#include <cstdint>
 #include <set>
 #include <string>
 #include <vector>
@@ -39,7 +40,8 @@
 //
 // Parameters:
 //   "imp_info"      bool     Enable the imperfect info variant (default: false)
-//   "num_cards"     int      The highest bid card, and point card (default: 13)
+//   "num_cards"     int      The highest bid card, and point card; at most 32
+//                            (hands are bitmask-backed) (default: 13)
 //   "players"       int      number of players (default: 2)
 //   "points_order"  string   "random" (default), "descending", or "ascending"
 
@@ -91,10 +93,13 @@ class GoofspielState : public SimMoveState {
   int current_player_;
   std::set<int> winners_;
   int turns_;
-  int point_card_index_;
+  int point_card_;  // Value of the revealed point card, or kInvalidCard.
   std::vector<int> points_;
-  std::vector<int> point_deck_;                  // Current point deck.
-  std::vector<std::vector<bool>> player_hands_;  // true if card is in hand.
+  // Bit c stands for the card numbered c + 1 (the card played by action c),
+  // so hands and the face-down point deck each fit in one word up to 32
+  // cards and legal-action generation is bit iteration instead of a scan.
+  uint32_t point_deck_;                // Point cards not yet revealed.
+  std::vector<uint32_t> player_hands_;  // Bid cards still in each hand.
   std::vector<int> win_sequence_;
   std::vector<std::vector<Action>> actions_history_;
 };
@@ -15,10 +15,14 @@
 #include "open_spiel/games/havannah.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/board_geometry.h"
+#include "open_spiel/games/zobrist.h"
+
 namespace open_spiel {
 namespace havannah {
 namespace {
@@ -44,7 +48,10 @@ const GameType kGameType{
          GameType::ParameterSpec{GameParameter::Type::kInt, false}},
         {"ansi_color_output",
          GameType::ParameterSpec{GameParameter::Type::kBool, false}},
-    }};
+    },
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new HavannahGame(params));
@@ -70,33 +77,39 @@ constexpr std::array<Move, kMaxNeighbors> neighbor_offsets = {
     Move(0, 1, kMoveOffset),   Move(-1, 0, kMoveOffset),
 };
 
-// Precomputed list of neighbors per board_size: [board_size][cell][direction]
-std::vector<NeighborList> neighbor_list;
+// Geometry shared by all games of one board size: the list of neighbors per
+// cell and direction, plus the corner and edge classification each cell is
+// initialized from.
+struct Geometry {
+  NeighborList neighbors;
+  std::vector<uint8_t> corner_mask;  // [cell] bitset, see Move::Corner.
+  std::vector<uint8_t> edge_mask;    // [cell] bitset, see Move::Edge.
+};
 
-NeighborList gen_neighbors(int board_size) {
+Geometry gen_geometry(int board_size) {
   int diameter = board_size * 2 - 1;
-  NeighborList out;
-  out.resize(diameter * diameter);
+  Geometry out;
+  out.neighbors.resize(diameter * diameter);
+  out.corner_mask.resize(diameter * diameter);
+  out.edge_mask.resize(diameter * diameter);
   for (int y = 0; y < diameter; y++) {
     for (int x = 0; x < diameter; x++) {
       int xy = x + y * diameter;  // Don't use Move.xy so it works off-board.
       for (int dir = 0; dir < neighbor_offsets.size(); dir++) {
         Move offset = neighbor_offsets[dir];
-        out[xy][dir] = Move(x + offset.x, y + offset.y, board_size);
+        out.neighbors[xy][dir] = Move(x + offset.x, y + offset.y, board_size);
       }
+      Move m(x, y, board_size);
+      out.corner_mask[xy] = m.Corner(board_size);
+      out.edge_mask[xy] = m.Edge(board_size);
     }
   }
   return out;
 }
 
-const NeighborList& get_neighbors(int board_size) {
-  if (board_size >= neighbor_list.size()) {
-    neighbor_list.resize(board_size + 1);
-  }
-  if (neighbor_list[board_size].empty()) {
-    neighbor_list[board_size] = gen_neighbors(board_size);
-  }
-  return neighbor_list[board_size];
+const Geometry& get_geometry(int board_size) {
+  static BoardGeometryCache<Geometry> cache;
+  return cache.Get(board_size, gen_geometry);
 }
 
 // Number of set bits in each 6-bit integer.
@@ -157,14 +170,27 @@ HavannahState::HavannahState(int board_size, bool ansi_color_output)
       board_diameter_(board_size * 2 - 1),
       valid_cells_((board_size * 2 - 1) * (board_size * 2 - 1) -
                    board_size * (board_size - 1)),  // diameter^2 - corners
-      neighbors(get_neighbors(board_size)),
+      neighbors(get_geometry(board_size).neighbors),
       ansi_color_output_(ansi_color_output) {
+  ResetBoard();
+}
+
+void HavannahState::ResetBoard() {
+  const Geometry& geometry = get_geometry(board_size_);
   board_.resize(board_diameter_ * board_diameter_);
+  free_cells_.assign((board_.size() + 63) / 64, 0);
   for (int i = 0; i < board_.size(); i++) {
     Move m = ActionToMove(i);
     board_[i] = Cell((m.OnBoard() ? kPlayerNone : kPlayerInvalid), i,
-                     m.Corner(board_size), m.Edge(board_size));
+                     geometry.corner_mask[i], geometry.edge_mask[i]);
+    if (m.OnBoard()) {
+      free_cells_[i / 64] |= uint64_t{1} << (i % 64);
+    }
   }
+  current_player_ = kPlayer1;
+  outcome_ = kPlayerNone;
+  moves_made_ = 0;
+  last_move_ = kMoveNone;
 }
 
 Move HavannahState::ActionToMove(Action action_id) const {
@@ -173,12 +199,16 @@ Move HavannahState::ActionToMove(Action action_id) const {
 }
 
 std::vector<Action> HavannahState::LegalActions() const {
-  // Can move in any empty cell.
+  // Can move in any empty cell. Walking the set bits of the free-cell
+  // bitset keeps the cost proportional to the number of empty cells (and
+  // they come out in ascending order, as required).
   std::vector<Action> moves;
-  moves.reserve(board_.size() - moves_made_);
-  for (int cell = 0; cell < board_.size(); ++cell) {
-    if (board_[cell].player == kPlayerNone) {
-      moves.push_back(cell);
+  moves.reserve(valid_cells_ - moves_made_);
+  for (int word = 0; word < static_cast<int>(free_cells_.size()); ++word) {
+    uint64_t bits = free_cells_[word];
+    while (bits != 0) {
+      moves.push_back(word * 64 + __builtin_ctzll(bits));
+      bits &= bits - 1;  // Clear the lowest set bit.
     }
   }
   return moves;
@@ -303,6 +333,7 @@ void HavannahState::DoApplyAction(Action action) {
 
   last_move_ = move;
   board_[move.xy].player = current_player_;
+  free_cells_[move.xy / 64] &= ~(uint64_t{1} << (move.xy % 64));
   moves_made_++;
 
   bool alreadyjoined = false;  // Useful for finding rings.
@@ -312,7 +343,7 @@ void HavannahState::DoApplyAction(Action action) {
       skip = false;
     } else if (m.OnBoard()) {
       if (current_player_ == board_[m.xy].player) {
-        alreadyjoined |= JoinGroups(move.xy, m.xy);
+        alreadyjoined |= JoinGroups(&board_, move.xy, m.xy);
 
         // Skip the next one. If it is the same group, it is already connected
         // and forms a sharp corner, which we can ignore.
@@ -321,7 +352,7 @@ void HavannahState::DoApplyAction(Action action) {
     }
   }
 
-  const Cell& group = board_[FindGroupLeader(move.xy)];
+  const Cell& group = board_[FindGroupLeader(&board_, move.xy)];
   if (group.NumEdges() >= 3 || group.NumCorners() >= 2 ||
       (alreadyjoined && CheckRingDFS(move, 0, 3))) {
     outcome_ = current_player_;
@@ -332,39 +363,6 @@ void HavannahState::DoApplyAction(Action action) {
   current_player_ = (current_player_ == kPlayer1 ? kPlayer2 : kPlayer1);
 }
 
-int HavannahState::FindGroupLeader(int cell) {
-  int parent = board_[cell].parent;
-  if (parent != cell) {
-    do {  // Follow the parent chain up to the group leader.
-      parent = board_[parent].parent;
-    } while (parent != board_[parent].parent);
-    // Do path compression, but only the current one to avoid recursion.
-    board_[cell].parent = parent;
-  }
-  return parent;
-}
-
-bool HavannahState::JoinGroups(int cell_a, int cell_b) {
-  int leader_a = FindGroupLeader(cell_a);
-  int leader_b = FindGroupLeader(cell_b);
-
-  if (leader_a == leader_b)  // Already the same group.
-    return true;
-
-  if (board_[leader_a].size < board_[leader_b].size) {
-    // Force group a's subtree to be bigger.
-    std::swap(leader_a, leader_b);
-  }
-
-  // Group b joins group a.
-  board_[leader_b].parent = leader_a;
-  board_[leader_a].size += board_[leader_b].size;
-  board_[leader_a].corner |= board_[leader_b].corner;
-  board_[leader_a].edge |= board_[leader_b].edge;
-
-  return false;
-}
-
 bool HavannahState::CheckRingDFS(const Move& move, int left, int right) {
   if (!move.OnBoard()) return false;
 
@@ -386,6 +384,30 @@ std::unique_ptr<State> HavannahState::Clone() const {
   return std::unique_ptr<State>(new HavannahState(*this));
 }
 
+void HavannahState::UndoAction(int player, Action action) {
+  // The union-find group structure can't be unwound incrementally (joins lose
+  // the pre-merge leaders), so as in go we reset the board and replay the
+  // remaining history, which is still fast in practice.
+  history_.pop_back();
+  ResetBoard();
+  for (Action a : history_) {
+    DoApplyAction(a);
+  }
+}
+
+uint64_t HavannahState::HashValue() const {
+  // Only the stones matter: moves alternate and nothing is ever removed, so
+  // the mover is implied by the stone counts.
+  constexpr uint64_t kHashSeed = 0x3f84d21c79ab60e7ULL;
+  uint64_t hash = 0;
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    if (board_[cell].player == kPlayer1 || board_[cell].player == kPlayer2) {
+      hash ^= zobrist::ZobristValue(kHashSeed, cell * 2 + board_[cell].player);
+    }
+  }
+  return hash;
+}
+
 HavannahGame::HavannahGame(const GameParameters& params)
     : Game(kGameType, params),
       board_size_(ParameterValue<int>("board_size", kDefaultBoardSize)),
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/games/union_find.h"
 #include "open_spiel/spiel.h"
 
 // https://en.wikipedia.org/wiki/Havannah
@@ -92,12 +93,12 @@ typedef std::vector<std::array<Move, kMaxNeighbors>> NeighborList;
 
 // State of an in-play game.
 class HavannahState : public State {
-  // Represents a single cell on the board, as well as the structures needed for
-  // groups of cells. Groups of cells are defined by a union-find structure
-  // embedded in the array of cells. Following the `parent` indices will lead to
-  // the group leader which has the up to date size, corner and edge
-  // connectivity of that group. Size, corner and edge are not valid for any
-  // cell that is not a group leader.
+  // Represents a single cell on the board, as well as the structures needed
+  // for groups of cells, which are maintained with the shared union-find in
+  // games/union_find.h. Following the `parent` indices will lead to the group
+  // leader which has the up to date size, corner and edge connectivity of
+  // that group. Size, corner and edge are not valid for any cell that is not
+  // a group leader.
   struct Cell {
     // Who controls this cell.
     Player player;
@@ -125,6 +126,11 @@ class HavannahState : public State {
           corner(corner_),
           edge(edge_) {}
 
+    void MergeGroupConnectivity(const Cell& other) {
+      corner |= other.corner;
+      edge |= other.edge;
+    }
+
     // How many corner or edges this group of cell is connected to. Only defined
     // if called on the group leader.
     int NumCorners() const;
@@ -148,17 +154,15 @@ class HavannahState : public State {
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  void UndoAction(int player, Action action) override;
+  uint64_t HashValue() const override;
   std::vector<Action> LegalActions() const override;
 
  protected:
   void DoApplyAction(Action action) override;
 
-  // Find the leader of the group. Not const due to union-find path compression.
-  int FindGroupLeader(int cell);
-
-  // Join the groups of two positions, propagating group size, and edge/corner
-  // connections. Returns true if they were already the same group.
-  bool JoinGroups(int cell_a, int cell_b);
+  // Reset the board back to the empty initial position.
+  void ResetBoard();
 
   // Do a depth first search for a ring starting at `move`.
   // `left` and `right give the direction bounds for the search. A valid ring
@@ -174,6 +178,10 @@ class HavannahState : public State {
 
  private:
   std::vector<Cell> board_;
+  // One bit per board_ index, set while the cell is empty and on the board.
+  // Kept in step with board_ by DoApplyAction/ResetBoard so that legal-move
+  // generation walks set bits instead of scanning every cell.
+  std::vector<uint64_t> free_cells_;
   Player current_player_ = kPlayer1;
   Player outcome_ = kPlayerNone;
   const int board_size_;
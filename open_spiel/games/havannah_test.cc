@@ -27,6 +27,7 @@ void BasicHavannahTests() {
   testing::NoChanceOutcomesTest(*LoadGame("havannah(board_size=4)"));
 
   testing::RandomSimTest(*LoadGame("havannah"), 10);
+  testing::RandomSimTestWithUndo(*LoadGame("havannah(board_size=4)"), 10);
 
   // All the sizes we care about.
   for (int i = 3; i <= 13; i++) {
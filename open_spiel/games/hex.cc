@@ -19,6 +19,10 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/board_geometry.h"
+#include "open_spiel/games/zobrist.h"
+#include "open_spiel/spiel_scratch.h"
+
 namespace open_spiel {
 namespace hex {
 namespace {
@@ -42,7 +46,10 @@ const GameType kGameType{
     {
         {"board_size",
          GameType::ParameterSpec{GameParameter::Type::kInt, false}},
-    }};
+    },
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new HexGame(params));
@@ -50,6 +57,34 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+NeighbourList GenNeighbours(int board_size) {
+  NeighbourList out;
+  out.resize(board_size * board_size);
+  for (int cell = 0; cell < board_size * board_size; ++cell) {
+    const std::array<int, kMaxNeighbours> candidates = {
+        cell - board_size, cell - board_size + 1, cell - 1,
+        cell + 1,          cell + board_size - 1, cell + board_size};
+    int n = 0;
+    for (int candidate : candidates) {
+      if (candidate >= 0 && candidate < board_size * board_size &&
+          !(candidate % board_size == 0 &&
+            cell % board_size == board_size - 1) &&
+          !(candidate % board_size == board_size - 1 &&
+            cell % board_size == 0)) {
+        out[cell][n++] = candidate;
+      }
+    }
+    while (n < kMaxNeighbours) out[cell][n++] = -1;
+  }
+  return out;
+}
+
+// Neighbour tables are shared by all games of one board size.
+const NeighbourList& GetNeighbours(int board_size) {
+  static BoardGeometryCache<NeighbourList> cache;
+  return cache.Get(board_size, GenNeighbours);
+}
+
 }  // namespace
 
 CellState HexState::PlayerAndActionToState(int player, Action move) const {
@@ -72,7 +107,8 @@ CellState HexState::PlayerAndActionToState(int player, Action move) const {
       } else if (move >= board_size_ * (board_size_ - 1)) {  // Last row
         south_connected = true;
       }
-      for (int neighbour : AdjacentCells(move)) {
+      for (int neighbour : neighbours_[move]) {
+        if (neighbour < 0) break;
         if (board_[neighbour] == CellState::kBlackNorth) {
           north_connected = true;
         } else if (board_[neighbour] == CellState::kBlackSouth) {
@@ -97,7 +133,8 @@ CellState HexState::PlayerAndActionToState(int player, Action move) const {
       } else if (move % board_size_ == board_size_ - 1) {  // Last column
         east_connected = true;
       }
-      for (int neighbour : AdjacentCells(move)) {
+      for (int neighbour : neighbours_[move]) {
+        if (neighbour < 0) break;
         if (board_[neighbour] == CellState::kWhiteWest) {
           west_connected = true;
         } else if (board_[neighbour] == CellState::kWhiteEast) {
@@ -149,6 +186,9 @@ std::string StateToString(CellState state) {
 void HexState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
   CellState move_cell_state = PlayerAndActionToState(CurrentPlayer(), move);
+  board_diffs_.emplace_back();
+  std::vector<std::pair<int, CellState>>& diff = board_diffs_.back();
+  diff.emplace_back(move, CellState::kEmpty);
   board_[move] = move_cell_state;
 
   if (move_cell_state == CellState::kBlackWin) {
@@ -164,18 +204,23 @@ void HexState::DoApplyAction(Action move) {
     // connected to an edge to be changed by the flood-fill.
     CellState cell_state_to_change =
         (current_player_ == 0 ? CellState::kBlack : CellState::kWhite);
-    // We assume that move can safely be cast to int
-    std::vector<int> flood_stack = {static_cast<int>(move)};
+    // We assume that move can safely be cast to int.
+    // The stack is per-thread scratch (see spiel_scratch.h), so its
+    // capacity is grown once per thread rather than allocated per move.
+    ScratchVector<int> flood_stack;
+    flood_stack->push_back(static_cast<int>(move));
     int latest_cell;
-    while (!flood_stack.empty()) {
-      latest_cell = flood_stack.back();
-      flood_stack.pop_back();
-      for (int neighbour : AdjacentCells(latest_cell)) {
+    while (!flood_stack->empty()) {
+      latest_cell = flood_stack->back();
+      flood_stack->pop_back();
+      for (int neighbour : neighbours_[latest_cell]) {
+        if (neighbour < 0) break;
         if (board_[neighbour] == cell_state_to_change) {
           // We make the change before putting the cell on the queue to avoid
           // putting the same cell on the queue multiple times
+          diff.emplace_back(neighbour, board_[neighbour]);
           board_[neighbour] = move_cell_state;
-          flood_stack.push_back(neighbour);
+          flood_stack->push_back(neighbour);
         }
       }
     }
@@ -202,26 +247,10 @@ std::string HexState::ActionToString(int player, Action action_id) const {
                       action_id / board_size_, ")");
 }
 
-std::vector<int> HexState::AdjacentCells(int cell) const {
-  std::vector<int> neighbours = {
-      cell - board_size_, cell - board_size_ + 1, cell - 1,
-      cell + 1,           cell + board_size_ - 1, cell + board_size_};
-  for (int i = kMaxNeighbours - 1; i >= 0; i--) {
-    // Check for invalid neighbours and remove
-    // Iterating in reverse to avoid changing the index of a candidate neighbour
-    if (neighbours[i] < 0 || (neighbours[i] >= board_size_ * board_size_) ||
-        (neighbours[i] % board_size_ == 0 &&
-         cell % board_size_ == board_size_ - 1) ||
-        (neighbours[i] % board_size_ == board_size_ - 1 &&
-         cell % board_size_ == 0)) {
-      neighbours.erase(neighbours.begin() + i);
-    }
-  }
-  return neighbours;
-}
-
 HexState::HexState(int board_size)
-    : State(board_size * board_size, kNumPlayers), board_size_(board_size) {
+    : State(board_size * board_size, kNumPlayers),
+      board_size_(board_size),
+      neighbours_(GetNeighbours(board_size)) {
   board_.resize(board_size * board_size, CellState::kEmpty);
 }
 
@@ -278,6 +307,36 @@ std::unique_ptr<State> HexState::Clone() const {
   return std::unique_ptr<State>(new HexState(*this));
 }
 
+void HexState::UndoAction(int player, Action move) {
+  SPIEL_CHECK_FALSE(board_diffs_.empty());
+  const std::vector<std::pair<int, CellState>>& diff = board_diffs_.back();
+  // Restore the cells changed by the move, in reverse application order.
+  for (auto it = diff.rbegin(); it != diff.rend(); ++it) {
+    board_[it->first] = it->second;
+  }
+  board_diffs_.pop_back();
+  // A move can only be applied in a non-terminal state, so the game was not
+  // yet decided before the move being undone.
+  result_black_perspective_ = 0;
+  current_player_ = player;
+  history_.pop_back();
+}
+
+uint64_t HexState::HashValue() const {
+  // Cells carry their connectivity annotations, which are a function of the
+  // stones on the board, so hashing the annotated values stays consistent
+  // across move orders. CellState values run from -4 to 4.
+  constexpr uint64_t kHashSeed = 0x6d09f2a47be318c5ULL;
+  uint64_t hash = 0;
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    if (board_[cell] != CellState::kEmpty) {
+      hash ^= zobrist::ZobristValue(
+          kHashSeed, cell * 9 + (static_cast<int>(board_[cell]) + 4));
+    }
+  }
+  return hash;
+}
+
 HexGame::HexGame(const GameParameters& params)
     : Game(kGameType, params),
       board_size_(ParameterValue<int>("board_size", kDefaultBoardSize)) {}
@@ -36,6 +36,10 @@ constexpr int kNumPlayers = 2;
 constexpr int kDefaultBoardSize = 11;
 constexpr int kMaxNeighbours = 6;  // Maximum number of neighbours for a cell
 constexpr int kCellStates = 1 + 4 * kNumPlayers;
+
+// List of neighbours of a cell: [cell][direction]. Cells with fewer than
+// kMaxNeighbours neighbours (edges and corners) are padded with -1.
+typedef std::vector<std::array<int, kMaxNeighbours>> NeighbourList;
 constexpr int kMinValueCellState = -4;
 // State of a cell.
 // Describes if a cell is
@@ -77,6 +81,8 @@ class HexState : public State {
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  void UndoAction(int player, Action move) override;
+  uint64_t HashValue() const override;
   std::vector<Action> LegalActions() const override;
   CellState BoardAt(int cell) const { return board_[cell]; }
 
@@ -88,8 +94,13 @@ class HexState : public State {
   CellState PlayerAndActionToState(int player, Action move) const;
   int current_player_ = 0;                         // Player zero goes first
   double result_black_perspective_ = 0;            // 1 if Black (player 0) wins
-  std::vector<int> AdjacentCells(int cell) const;  // Cells adjacent to cell
+  // One entry per move made, holding the (cell, previous state) pairs changed
+  // by that move (the played cell plus any cells recolored by the flood-fill),
+  // so that UndoAction can restore the board incrementally.
+  std::vector<std::vector<std::pair<int, CellState>>> board_diffs_;
   const int board_size_;
+  // Precomputed neighbour table shared among all states of this board size.
+  const NeighbourList& neighbours_;
 };
 
 // Game object.
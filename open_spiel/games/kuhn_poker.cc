@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <numeric>
 #include <string>
 #include <utility>
 
@@ -45,7 +46,9 @@ const GameType kGameType{
     /*provides_observation=*/true,
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
-    {{"players", {GameParameter::Type::kInt, false}}}};
+    {{"players", {GameParameter::Type::kInt, false}},
+     {"combineddeal", {GameParameter::Type::kBool, false}}},
+    /*provides_undo=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new KuhnGame(params));
@@ -54,30 +57,49 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 REGISTER_SPIEL_GAME(kGameType, Factory);
 }  // namespace
 
-KuhnState::KuhnState(int num_distinct_actions, int num_players)
+KuhnState::KuhnState(
+    int num_distinct_actions, int num_players,
+    std::shared_ptr<const std::vector<std::pair<Action, double>>>
+        combined_outcomes)
     : State(num_distinct_actions, num_players),
       first_bettor_(kInvalidPlayer),
       card_dealt_(num_players + 1, kInvalidPlayer),
+      cards_(num_players, -1),
       winner_(kInvalidPlayer),
       pot_(kAnte * num_players),
       // How much each player has contributed to the pot, indexed by pid.
-      ante_(num_players, kAnte) {}
+      ante_(num_players, kAnte),
+      combined_outcomes_(std::move(combined_outcomes)) {}
 
 int KuhnState::CurrentPlayer() const {
   if (IsTerminal()) {
     return kTerminalPlayerId;
   } else {
-    return (history_.size() < num_players_) ? kChancePlayerId
-                                            : history_.size() % num_players_;
+    return (history_.size() < DealLength())
+               ? kChancePlayerId
+               : (history_.size() - DealLength()) % num_players_;
   }
 }
 
 void KuhnState::DoApplyAction(Action move) {
   // Additional book-keeping
-  if (history_.size() < num_players_) {
-    // Give card `move` to player `history_.size()` (CurrentPlayer will return
-    // kChancePlayerId, so we use that instead).
-    card_dealt_[move] = history_.size();
+  if (history_.size() < DealLength()) {
+    if (combined_outcomes_ != nullptr) {
+      // The whole deal is one joint outcome, encoding each player's card in
+      // base (num_players_ + 1): player 0's card is the lowest digit.
+      Action code = move;
+      for (int p = 0; p < num_players_; ++p) {
+        cards_[p] = code % (num_players_ + 1);
+        code /= num_players_ + 1;
+        SPIEL_CHECK_EQ(card_dealt_[cards_[p]], kInvalidPlayer);
+        card_dealt_[cards_[p]] = p;
+      }
+    } else {
+      // Give card `move` to player `history_.size()` (CurrentPlayer will
+      // return kChancePlayerId, so we use that instead).
+      card_dealt_[move] = history_.size();
+      cards_[history_.size()] = move;
+    }
   } else if (move == ActionType::kBet) {
     if (first_bettor_ == kInvalidPlayer) first_bettor_ = CurrentPlayer();
     pot_ += 1;
@@ -89,7 +111,7 @@ void KuhnState::DoApplyAction(Action move) {
   history_.push_back(move);
 
   // Check for the game being over.
-  const int num_actions = history_.size() - num_players_;
+  const int num_actions = history_.size() - DealLength();
   if (first_bettor_ == kInvalidPlayer && num_actions == num_players_) {
     // Nobody bet; the winner is the person with the highest card dealt,
     // which is either the highest or the next-highest card.
@@ -116,6 +138,14 @@ void KuhnState::DoApplyAction(Action move) {
 std::vector<Action> KuhnState::LegalActions() const {
   if (IsTerminal()) return {};
   if (IsChanceNode()) {
+    // With a combined deal the single chance node covers every card.
+    if (combined_outcomes_ != nullptr) {
+      std::vector<Action> actions(combined_outcomes_->size());
+      for (int i = 0; i < actions.size(); ++i) {
+        actions[i] = (*combined_outcomes_)[i].first;
+      }
+      return actions;
+    }
     std::vector<Action> actions;
     for (int card = 0; card < card_dealt_.size(); ++card) {
       if (card_dealt_[card] == kInvalidPlayer) actions.push_back(card);
@@ -138,14 +168,14 @@ std::string KuhnState::ActionToString(int player, Action move) const {
 std::string KuhnState::ToString() const {
   // The deal: space separated card per player
   std::string str;
-  for (int i = 0; i < history_.size() && i < num_players_; ++i) {
+  for (int p = 0; p < num_players_ && cards_[p] >= 0; ++p) {
     if (!str.empty()) str.push_back(' ');
-    absl::StrAppend(&str, history_[i]);
+    absl::StrAppend(&str, cards_[p]);
   }
 
   // The betting history: p for Pass, b for Bet
-  if (history_.size() > num_players_) str.push_back(' ');
-  for (int i = num_players_; i < history_.size(); ++i) {
+  if (history_.size() > DealLength()) str.push_back(' ');
+  for (int i = DealLength(); i < history_.size(); ++i) {
     str.push_back(history_[i] ? 'b' : 'p');
   }
 
@@ -155,16 +185,26 @@ std::string KuhnState::ToString() const {
 bool KuhnState::IsTerminal() const { return winner_ != kInvalidPlayer; }
 
 std::vector<double> KuhnState::Returns() const {
+  std::vector<double> returns;
+  ReturnsTo(&returns);
+  return returns;
+}
+
+void KuhnState::ReturnsTo(std::vector<double>* returns) const {
   if (!IsTerminal()) {
-    return {0.0, 0.0};
+    returns->assign(num_players_, 0.0);
+    return;
   }
-
-  std::vector<double> returns(num_players_);
+  returns->resize(num_players_);
   for (int player = 0; player < num_players_; ++player) {
-    const int bet = DidBet(player) ? 2 : 1;
-    returns[player] = (player == winner_) ? (pot_ - bet) : -bet;
+    (*returns)[player] = PlayerReturn(player);
   }
-  return returns;
+}
+
+double KuhnState::PlayerReturn(int player) const {
+  if (!IsTerminal()) return 0.0;
+  const int bet = DidBet(player) ? 2 : 1;
+  return (player == winner_) ? (pot_ - bet) : -bet;
 }
 
 // Information state is card then bets, e.g. 1pb
@@ -172,9 +212,9 @@ std::string KuhnState::InformationState(int player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  if (history_.size() <= player) return "";
-  std::string str = std::to_string(history_[player]);
-  for (int i = num_players_; i < history_.size(); ++i)
+  if (cards_[player] < 0) return "";
+  std::string str = std::to_string(cards_[player]);
+  for (int i = DealLength(); i < history_.size(); ++i)
     str.push_back(history_[i] ? 'b' : 'p');
   return str;
 }
@@ -184,8 +224,8 @@ std::string KuhnState::Observation(int player) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  if (history_.size() <= player) return "";
-  std::string str = std::to_string(history_[player]);
+  if (cards_[player] < 0) return "";
+  std::string str = std::to_string(cards_[player]);
 
   // Adding the contribution of each players to the pot. These values are not
   // between 0 and 1.
@@ -208,11 +248,13 @@ void KuhnState::InformationStateAsNormalizedVector(
   (*values)[player] = 1;
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (cards_[player] >= 0) (*values)[num_players_ + cards_[player]] = 1;
 
-  // Betting sequence.
-  for (int i = num_players_; i < history_.size(); ++i) {
-    (*values)[1 + 2 * i + history_[i]] = 1;
+  // Betting sequence. The layout is the same in both deal modes: bet b
+  // occupies the bits the sequential deal would put at history index
+  // num_players_ + b.
+  for (int b = 0; DealLength() + b < history_.size(); ++b) {
+    (*values)[1 + 2 * (num_players_ + b) + history_[DealLength() + b]] = 1;
   }
 }
 
@@ -232,7 +274,7 @@ void KuhnState::ObservationAsNormalizedVector(
   (*values)[player] = 1;
 
   // The player's card, if one has been dealt.
-  if (history_.size() > player) (*values)[num_players_ + history_[player]] = 1;
+  if (cards_[player] >= 0) (*values)[num_players_ + cards_[player]] = 1;
 
   int offset = 2 * num_players_ + 1;
   // Adding the contribution of each players to the pot. These values are not
@@ -247,9 +289,15 @@ std::unique_ptr<State> KuhnState::Clone() const {
 }
 
 void KuhnState::UndoAction(int player, Action move) {
-  if (history_.size() <= num_players_) {
+  if (history_.size() <= DealLength()) {
     // Undoing a deal move.
-    card_dealt_[move] = kInvalidPlayer;
+    if (combined_outcomes_ != nullptr) {
+      std::fill(card_dealt_.begin(), card_dealt_.end(), kInvalidPlayer);
+      std::fill(cards_.begin(), cards_.end(), -1);
+    } else {
+      card_dealt_[move] = kInvalidPlayer;
+      cards_[history_.size() - 1] = -1;
+    }
   } else {
     // Undoing a bet / pass.
     if (move == ActionType::kBet) {
@@ -263,6 +311,10 @@ void KuhnState::UndoAction(int player, Action move) {
 
 std::vector<std::pair<Action, double>> KuhnState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
+  // With a combined deal, return the joint table built by the game.
+  if (combined_outcomes_ != nullptr) {
+    return *combined_outcomes_;
+  }
   std::vector<std::pair<Action, double>> outcomes;
   const double p = 1.0 / (num_players_ + 1 - history_.size());
   for (int card = 0; card < card_dealt_.size(); ++card) {
@@ -277,9 +329,9 @@ bool KuhnState::DidBet(int player) const {
   } else if (player == first_bettor_) {
     return true;
   } else if (player > first_bettor_) {
-    return history_[num_players_ + player] == ActionType::kBet;
+    return history_[DealLength() + player] == ActionType::kBet;
   } else {
-    return history_[num_players_ * 2 + player] == ActionType::kBet;
+    return history_[DealLength() + num_players_ + player] == ActionType::kBet;
   }
 }
 
@@ -288,11 +340,62 @@ KuhnGame::KuhnGame(const GameParameters& params)
       num_players_(ParameterValue<int>("players", kDefaultPlayers)) {
   SPIEL_CHECK_GE(num_players_, kGameType.min_num_players);
   SPIEL_CHECK_LE(num_players_, kGameType.max_num_players);
+
+  // With a combined deal, precompute the joint outcome table once: one
+  // outcome per assignment of distinct cards to the players, each equally
+  // likely. Outcome ids encode each player's card in base (num_players_ + 1),
+  // player 0's card in the lowest digit.
+  combined_deal_ = ParameterValue<bool>("combineddeal", false);
+  if (combined_deal_) {
+    // There are (num_players_ + 1)! assignments (the left-out card is
+    // determined by the others); the table is enumerated explicitly, so it
+    // must stay a reasonable size.
+    int64_t num_deals = 1;
+    for (int i = 2; i <= num_players_ + 1; ++i) {
+      num_deals *= i;
+      SPIEL_CHECK_LE(num_deals, 1000000);
+    }
+
+    std::vector<Action> ids;
+    ids.reserve(num_deals);
+    std::vector<int> perm(num_players_ + 1);
+    std::iota(perm.begin(), perm.end(), 0);
+    do {
+      // perm[p] is the card dealt to player p; perm.back() stays in the deck.
+      Action id = 0;
+      for (int p = num_players_ - 1; p >= 0; --p) {
+        id = id * (num_players_ + 1) + perm[p];
+      }
+      ids.push_back(id);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<std::pair<Action, double>> outcomes;
+    outcomes.reserve(ids.size());
+    const double prob = 1.0 / ids.size();
+    for (Action id : ids) {
+      outcomes.emplace_back(id, prob);
+    }
+    combined_outcomes_ = std::make_shared<
+        const std::vector<std::pair<Action, double>>>(std::move(outcomes));
+  }
 }
 
 std::unique_ptr<State> KuhnGame::NewInitialState() const {
   return std::unique_ptr<State>(
-      new KuhnState(NumDistinctActions(), num_players_));
+      new KuhnState(NumDistinctActions(), num_players_, combined_outcomes_));
+}
+
+int KuhnGame::MaxChanceOutcomes() const {
+  if (combined_deal_) {
+    // Outcome ids are sparse in base (num_players_ + 1).
+    int max_outcomes = 1;
+    for (int p = 0; p < num_players_; ++p) {
+      max_outcomes *= num_players_ + 1;
+    }
+    return max_outcomes;
+  }
+  return num_players_ + 1;
 }
 
 std::vector<int> KuhnGame::InformationStateNormalizedVectorShape() const {
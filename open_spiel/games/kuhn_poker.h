@@ -18,6 +18,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -33,6 +34,8 @@
 //
 // Parameters:
 //     "players"       int    number of players               (default = 2)
+//     "combineddeal"  bool   deal all private cards in one
+//                            joint chance node               (default = false)
 
 namespace open_spiel {
 namespace kuhn_poker {
@@ -46,7 +49,10 @@ class KuhnGame;
 
 class KuhnState : public State {
  public:
-  explicit KuhnState(int num_distinct_actions, int num_players);
+  explicit KuhnState(
+      int num_distinct_actions, int num_players,
+      std::shared_ptr<const std::vector<std::pair<Action, double>>>
+          combined_outcomes);
   KuhnState(const KuhnState&) = default;
 
   int CurrentPlayer() const override;
@@ -55,6 +61,8 @@ class KuhnState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void ReturnsTo(std::vector<double>* returns) const override;
+  double PlayerReturn(int player) const override;
   std::string InformationState(int player) const override;
   std::string Observation(int player) const override;
   void InformationStateAsNormalizedVector(
@@ -74,6 +82,12 @@ class KuhnState : public State {
   // Whether the specified player made a bet
   bool DidBet(int player) const;
 
+  // Number of history entries occupied by the deal: one joint chance node
+  // with a combined deal, one node per player otherwise.
+  int DealLength() const {
+    return combined_outcomes_ != nullptr ? 1 : num_players_;
+  }
+
   // The move history and number of players are sufficient information to
   // specify the state of the game. We keep track of more information to make
   // extracting legal actions and utilities easier.
@@ -81,11 +95,17 @@ class KuhnState : public State {
   // UndoAction() functions.
   int first_bettor_;             // the player (if any) who was first to bet
   std::vector<int> card_dealt_;  // the player (if any) who has each card
+  std::vector<int> cards_;       // the card each player holds (-1 if none yet)
   int winner_;                   // winning player, or kInvalidPlayer if the
                                  // game isn't over yet.
   int pot_;                      // the size of the pot
   // How much each player has contributed to the pot, indexed by pid.
   std::vector<int> ante_;
+
+  // Precomputed joint deal outcomes, shared with the game. Null when cards
+  // are dealt one chance node at a time.
+  std::shared_ptr<const std::vector<std::pair<Action, double>>>
+      combined_outcomes_;
 };
 
 class KuhnGame : public Game {
@@ -93,7 +113,7 @@ class KuhnGame : public Game {
   explicit KuhnGame(const GameParameters& params);
   int NumDistinctActions() const override { return 2; }
   std::unique_ptr<State> NewInitialState() const override;
-  int MaxChanceOutcomes() const override { return num_players_ + 1; }
+  int MaxChanceOutcomes() const override;
   int NumPlayers() const override { return num_players_; }
   double MinUtility() const override;
   double MaxUtility() const override;
@@ -105,9 +125,30 @@ class KuhnGame : public Game {
   std::vector<int> ObservationNormalizedVectorShape() const override;
   int MaxGameLength() const override { return num_players_ * 2 - 1; }
 
+  // Measured table sizes for the two-player game (see
+  // algorithms/game_stats.h): each player acts in six information sets
+  // (three cards times two betting contexts), and the tree has nine betting
+  // histories per deal plus the chance nodes — one root with a combined
+  // deal, one per dealt card otherwise. Unknown for more players.
+  int64_t ExpectedNumInfoStates() const override {
+    return num_players_ == 2 ? 12 : -1;
+  }
+  int64_t ExpectedNumHistories() const override {
+    if (num_players_ != 2) return -1;
+    return combined_deal_ ? 55 : 58;
+  }
+
  private:
   // Number of players.
   int num_players_;
+
+  // When combineddeal=true, the whole deal is a single chance node whose
+  // outcome table (one entry per assignment of distinct cards to the
+  // players, uniform probabilities) is built once here at game construction
+  // and shared with every state.
+  bool combined_deal_;
+  std::shared_ptr<const std::vector<std::pair<Action, double>>>
+      combined_outcomes_;
 };
 
 }  // namespace kuhn_poker
@@ -34,6 +34,38 @@ void BasicKuhnTests() {
   }
 }
 
+void CombinedDealKuhnTests() {
+  testing::LoadGameTest("kuhn_poker(combineddeal=true)");
+  testing::ChanceOutcomesTest(*LoadGame("kuhn_poker(combineddeal=true)"));
+  testing::RandomSimTest(*LoadGame("kuhn_poker(combineddeal=true)"), 100);
+}
+
+// Each joint outcome must produce the same post-deal state as dealing the
+// corresponding cards one chance node at a time.
+void CombinedDealMatchesSequentialDeal() {
+  std::unique_ptr<Game> seq_game = LoadGame("kuhn_poker");
+  std::unique_ptr<Game> comb_game = LoadGame("kuhn_poker(combineddeal=true)");
+
+  std::unique_ptr<State> comb_root = comb_game->NewInitialState();
+  auto outcomes = comb_root->ChanceOutcomes();
+  SPIEL_CHECK_EQ(outcomes.size(), 6);
+
+  for (const auto& outcome : outcomes) {
+    std::unique_ptr<State> comb_state = comb_root->Child(outcome.first);
+
+    // Player 0's card is the low digit of the joint outcome in base 3.
+    std::unique_ptr<State> seq_state = seq_game->NewInitialState();
+    seq_state->ApplyAction(outcome.first % 3);
+    seq_state->ApplyAction(outcome.first / 3);
+
+    SPIEL_CHECK_EQ(comb_state->ToString(), seq_state->ToString());
+    for (int p = 0; p < 2; p++) {
+      SPIEL_CHECK_EQ(comb_state->InformationState(p),
+                     seq_state->InformationState(p));
+    }
+  }
+}
+
 void CountStates() {
   KuhnGame game({});
   auto states = algorithms::GetAllStates(game, /*depth_limit=*/-1,
@@ -43,13 +75,34 @@ void CountStates() {
   SPIEL_CHECK_EQ(states.size(), 54);
 }
 
+void ReturnsConsistencyTest() {
+  KuhnGame game({});
+  auto states = algorithms::GetAllStates(game, /*depth_limit=*/-1,
+                                         /*include_terminals=*/true,
+                                         /*include_chance_states=*/false);
+  // The allocation-free accessors agree with Returns() everywhere, reusing
+  // one buffer across all states.
+  std::vector<double> returns;
+  for (const auto& entry : states) {
+    const std::vector<double> expected = entry.second->Returns();
+    entry.second->ReturnsTo(&returns);
+    SPIEL_CHECK_TRUE(returns == expected);
+    for (int p = 0; p < game.NumPlayers(); ++p) {
+      SPIEL_CHECK_FLOAT_EQ(entry.second->PlayerReturn(p), expected[p]);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace kuhn_poker
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::kuhn_poker::BasicKuhnTests();
+  open_spiel::kuhn_poker::CombinedDealKuhnTests();
+  open_spiel::kuhn_poker::CombinedDealMatchesSequentialDeal();
   open_spiel::kuhn_poker::CountStates();
+  open_spiel::kuhn_poker::ReturnsConsistencyTest();
   open_spiel::testing::CheckChanceOutcomes(open_spiel::kuhn_poker::KuhnGame(
       {{"players", open_spiel::GameParameter(3)}}));
   open_spiel::testing::RandomSimTest(open_spiel::kuhn_poker::KuhnGame({}),
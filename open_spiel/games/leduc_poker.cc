@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <numeric>
 #include <utility>
 
@@ -44,7 +45,8 @@ const GameType kGameType{
     /*provides_observation=*/true,
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
-    {{"players", {GameParameter::Type::kInt, false}}}};
+    {{"players", {GameParameter::Type::kInt, false}},
+     {"combineddeal", {GameParameter::Type::kBool, false}}}};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new LeducGame(params));
@@ -52,6 +54,25 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
+// Enumerates every assignment of distinct cards to the players, appending
+// the id of each: player p's card is digit p of the id in base num_cards,
+// lowest digit first.
+void EnumerateDeals(int num_cards, int num_players, int player, Action weight,
+                    Action id, std::vector<bool>* used,
+                    std::vector<Action>* ids) {
+  if (player == num_players) {
+    ids->push_back(id);
+    return;
+  }
+  for (int card = 0; card < num_cards; ++card) {
+    if ((*used)[card]) continue;
+    (*used)[card] = true;
+    EnumerateDeals(num_cards, num_players, player + 1, weight * num_cards,
+                   id + weight * card, used, ids);
+    (*used)[card] = false;
+  }
+}
+
 }  // namespace
 LeducState::LeducState(int num_players, const LeducGame& parent)
     : State(parent.NumDistinctActions(), num_players),
@@ -100,6 +121,25 @@ int LeducState::CurrentPlayer() const {
 // On a player node, it should be ActionType::{kFold, kCall, kRaise}
 void LeducState::DoApplyAction(Action move) {
   if (IsChanceNode()) {
+    if (IsCombinedDealNode()) {
+      // One joint outcome deals every private card: player p's card is
+      // digit p of `move` in base deck size, lowest digit first.
+      const int num_cards = deck_.size();
+      Action code = move;
+      for (int p = 0; p < num_players_; ++p) {
+        int card = code % num_cards;
+        code /= num_cards;
+        SPIEL_CHECK_NE(deck_[card], kInvalidCard);
+        private_cards_[p] = deck_[card];
+        deck_[card] = kInvalidCard;
+        deck_size_--;
+        private_cards_dealt_++;
+      }
+      // When all private cards are dealt, move to player 0.
+      cur_player_ = 0;
+      return;
+    }
+
     SPIEL_CHECK_GE(move, 0);
     SPIEL_CHECK_LT(move, deck_.size());
     SPIEL_CHECK_NE(deck_[move], kInvalidCard);
@@ -196,6 +236,16 @@ std::vector<Action> LeducState::LegalActions() const {
   if (IsTerminal()) return {};
   std::vector<Action> movelist;
   if (IsChanceNode()) {
+    // With a combined deal the single chance node covers every private card.
+    if (IsCombinedDealNode()) {
+      const std::vector<std::pair<Action, double>>& outcomes =
+          parent_game_.combined_deal_outcomes();
+      movelist.reserve(outcomes.size());
+      for (const auto& outcome : outcomes) {
+        movelist.push_back(outcome.first);
+      }
+      return movelist;
+    }
     for (int card = 0; card < deck_.size(); card++) {
       if (deck_[card] != kInvalidCard) movelist.push_back(card);
     }
@@ -262,17 +312,26 @@ bool LeducState::IsTerminal() const {
 }
 
 std::vector<double> LeducState::Returns() const {
+  std::vector<double> returns;
+  ReturnsTo(&returns);
+  return returns;
+}
+
+void LeducState::ReturnsTo(std::vector<double>* returns) const {
   if (!IsTerminal()) {
-    return std::vector<double>(num_players_, 0.0);
+    returns->assign(num_players_, 0.0);
+    return;
   }
-
-  std::vector<double> returns(num_players_);
+  returns->resize(num_players_);
   for (int player = 0; player < num_players_; ++player) {
-    // Money vs money at start.
-    returns[player] = money_[player] - kStartingMoney;
+    (*returns)[player] = PlayerReturn(player);
   }
+}
 
-  return returns;
+double LeducState::PlayerReturn(int player) const {
+  if (!IsTerminal()) return 0.0;
+  // Money vs money at start.
+  return money_[player] - kStartingMoney;
 }
 
 // Information state is card then bets.
@@ -411,6 +470,10 @@ std::unique_ptr<State> LeducState::Clone() const {
 
 std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
+  // With a combined deal, return the joint table built by the game.
+  if (IsCombinedDealNode()) {
+    return parent_game_.combined_deal_outcomes();
+  }
   std::vector<std::pair<Action, double>> outcomes;
 
   const double p = 1.0 / deck_size_;
@@ -421,6 +484,35 @@ std::vector<std::pair<Action, double>> LeducState::ChanceOutcomes() const {
   return outcomes;
 }
 
+std::pair<Action, double> LeducState::SampleChanceOutcome(double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  SPIEL_CHECK_GT(deck_size_, 0);
+  // With a combined deal, one sample draws the whole deal from the joint
+  // table (all outcomes are equally likely).
+  if (IsCombinedDealNode()) {
+    const std::vector<std::pair<Action, double>>& outcomes =
+        parent_game_.combined_deal_outcomes();
+    int k = static_cast<int>(z * outcomes.size());
+    if (k >= outcomes.size()) k = outcomes.size() - 1;
+    return outcomes[k];
+  }
+  // Deals are uniform over the cards still in the deck; walk the deck to the
+  // sampled card instead of building the outcome vector.
+  int k = static_cast<int>(z * deck_size_);
+  if (k >= deck_size_) k = deck_size_ - 1;
+  for (int card = 0; card < deck_.size(); card++) {
+    if (deck_[card] != kInvalidCard && k-- == 0) {
+      return std::make_pair(card, 1.0 / deck_size_);
+    }
+  }
+  SpielFatalError("SampleChanceOutcome: deck out of sync with deck_size_.");
+}
+
+bool LeducState::IsCombinedDealNode() const {
+  return parent_game_.combined_deal() && round_ == 1 &&
+         private_cards_dealt_ == 0;
+}
+
 int LeducState::NextPlayer() const {
   // If we are on a chance node, it is the first player to play
   int current_real_player;
@@ -562,15 +654,53 @@ std::vector<int> LeducState::padded_betting_sequence() const {
 LeducGame::LeducGame(const GameParameters& params)
     : Game(kGameType, params),
       num_players_(ParameterValue<int>("players", kDefaultPlayers)),
-      total_cards_((num_players_ + 1) * kNumSuits) {
+      total_cards_((num_players_ + 1) * kNumSuits),
+      combined_deal_(ParameterValue<bool>("combineddeal", false)) {
   SPIEL_CHECK_GE(num_players_, kGameType.min_num_players);
   SPIEL_CHECK_LE(num_players_, kGameType.max_num_players);
+
+  // With a combined deal, precompute the joint outcome table once: one
+  // outcome per assignment of distinct private cards to the players, each
+  // equally likely.
+  if (combined_deal_) {
+    // The table is enumerated explicitly, so it must stay a reasonable size.
+    int64_t num_deals = 1;
+    for (int p = 0; p < num_players_; ++p) {
+      num_deals *= total_cards_ - p;
+      SPIEL_CHECK_LE(num_deals, 1000000);
+    }
+
+    std::vector<Action> ids;
+    ids.reserve(num_deals);
+    std::vector<bool> used(total_cards_, false);
+    EnumerateDeals(total_cards_, num_players_, /*player=*/0, /*weight=*/1,
+                   /*id=*/0, &used, &ids);
+    std::sort(ids.begin(), ids.end());
+
+    combined_deal_outcomes_.reserve(ids.size());
+    const double prob = 1.0 / ids.size();
+    for (Action id : ids) {
+      combined_deal_outcomes_.emplace_back(id, prob);
+    }
+  }
 }
 
 std::unique_ptr<State> LeducGame::NewInitialState() const {
   return std::unique_ptr<State>(new LeducState(num_players_, *this));
 }
 
+int LeducGame::MaxChanceOutcomes() const {
+  if (combined_deal_) {
+    // Joint deal ids are sparse in base total_cards_.
+    int max_outcomes = 1;
+    for (int p = 0; p < num_players_; ++p) {
+      max_outcomes *= total_cards_;
+    }
+    return max_outcomes;
+  }
+  return total_cards_;
+}
+
 std::vector<int> LeducGame::InformationStateNormalizedVectorShape() const {
   // One-hot encoding for player number (who is to play).
   // 2 slots of cards (total_cards_ bits each): private card, public card
@@ -26,6 +26,8 @@
 // private card player 0, private card player 1, [bets], public card, [bets]
 // Parameters:
 //     "players"       int    number of players               (default = 2)
+//     "combineddeal"  bool   deal all private cards in one
+//                            joint chance node               (default = false)
 
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_LEDUC_POKER_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_LEDUC_POKER_H_
@@ -33,6 +35,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -67,6 +70,8 @@ class LeducState : public State {
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
+  void ReturnsTo(std::vector<double>* returns) const override;
+  double PlayerReturn(int player) const override;
   std::string InformationState(int player) const override;
   std::string Observation(int player) const override;
   void InformationStateAsNormalizedVector(
@@ -76,6 +81,7 @@ class LeducState : public State {
   std::unique_ptr<State> Clone() const override;
   // The probability of taking each possible action in a particular info state.
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(double z) const override;
 
   // Additional methods
   int round() const { return round_; }
@@ -110,6 +116,9 @@ class LeducState : public State {
 
  private:
   int NextPlayer() const;
+  // Whether this is the single joint chance node that deals every private
+  // card (only ever true with combineddeal=true, before any card is dealt).
+  bool IsCombinedDealNode() const;
   void ResolveWinner();
   bool ReadyForNextRound() const;
   void NewRound();
@@ -157,7 +166,7 @@ class LeducGame : public Game {
 
   int NumDistinctActions() const override { return 3; }
   std::unique_ptr<State> NewInitialState() const override;
-  int MaxChanceOutcomes() const override { return total_cards_; }
+  int MaxChanceOutcomes() const override;
   int NumPlayers() const override { return num_players_; }
   double MinUtility() const override;
   double MaxUtility() const override;
@@ -174,9 +183,20 @@ class LeducGame : public Game {
     return 2 * (2 + (num_players_ - 1) * 2 + (num_players_ - 2));
   }
 
+  // Whether the initial private deal is one joint chance node, and its
+  // outcome table (one entry per assignment of distinct cards to the
+  // players, uniform probabilities), built once at game construction.
+  bool combined_deal() const { return combined_deal_; }
+  const std::vector<std::pair<Action, double>>& combined_deal_outcomes()
+      const {
+    return combined_deal_outcomes_;
+  }
+
  private:
   int num_players_;  // Number of players.
   int total_cards_;  // Number of cards total cards in the game.
+  bool combined_deal_;
+  std::vector<std::pair<Action, double>> combined_deal_outcomes_;
 };
 
 }  // namespace leduc_poker
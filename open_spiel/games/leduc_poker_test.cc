@@ -12,7 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <string>
+
+#include "open_spiel/algorithms/get_all_states.h"
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -31,8 +36,67 @@ void BasicLeducTests() {
   }
 }
 
+void CombinedDealLeducTests() {
+  testing::LoadGameTest("leduc_poker(combineddeal=true)");
+  testing::ChanceOutcomesTest(*LoadGame("leduc_poker(combineddeal=true)"));
+  testing::RandomSimTest(*LoadGame("leduc_poker(combineddeal=true)"), 100);
+}
+
+// Each joint outcome must produce the same post-deal state as dealing the
+// private cards one chance node at a time.
+void CombinedDealMatchesSequentialDeal() {
+  std::unique_ptr<Game> seq_game = LoadGame("leduc_poker");
+  std::unique_ptr<Game> comb_game = LoadGame("leduc_poker(combineddeal=true)");
+
+  std::unique_ptr<State> comb_root = comb_game->NewInitialState();
+  auto outcomes = comb_root->ChanceOutcomes();
+  // 6 * 5 ordered pairs of distinct cards.
+  SPIEL_CHECK_EQ(outcomes.size(), 30);
+
+  for (const auto& outcome : outcomes) {
+    std::unique_ptr<State> comb_state = comb_root->Child(outcome.first);
+
+    // Player 0's card is the low digit of the joint outcome in base 6.
+    std::unique_ptr<State> seq_state = seq_game->NewInitialState();
+    seq_state->ApplyAction(outcome.first % 6);
+    seq_state->ApplyAction(outcome.first / 6);
+
+    SPIEL_CHECK_EQ(comb_state->ToString(), seq_state->ToString());
+    for (int p = 0; p < 2; p++) {
+      SPIEL_CHECK_EQ(comb_state->InformationState(p),
+                     seq_state->InformationState(p));
+    }
+  }
+}
+
+// InformationStateKey must equal the InformationState string byte for
+// byte: consumers such as HistoryTree and the trajectory state indices
+// build tables from one and probe them with the other. (Regression test:
+// a packed key encoding broke that interchangeability, and also collided
+// at terminal states, where the settled money reveals the showdown
+// outcome without being a function of the cards and betting sequences.)
+void InformationStateKeyMatchesStringTest() {
+  std::unique_ptr<Game> game = LoadGame("leduc_poker");
+  auto states =
+      algorithms::GetAllStates(*game, /*depth_limit=*/-1,
+                               /*include_terminals=*/true,
+                               /*include_chance_states=*/false);
+  SPIEL_CHECK_GT(states.size(), 0);
+  for (const auto& entry : states) {
+    for (int p = 0; p < game->NumPlayers(); ++p) {
+      SPIEL_CHECK_EQ(entry.second->InformationStateKey(p),
+                     entry.second->InformationState(p));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace leduc_poker
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::leduc_poker::BasicLeducTests(); }
+int main(int argc, char** argv) {
+  open_spiel::leduc_poker::BasicLeducTests();
+  open_spiel::leduc_poker::CombinedDealLeducTests();
+  open_spiel::leduc_poker::CombinedDealMatchesSequentialDeal();
+  open_spiel::leduc_poker::InformationStateKeyMatchesStringTest();
+}
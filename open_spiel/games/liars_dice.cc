@@ -45,7 +45,8 @@ const GameType kGameType{
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
     /*parameter_specification=*/
-    {{"players", {GameParameter::Type::kInt, false}}}};
+    {{"players", {GameParameter::Type::kInt, false}},
+     {"combineddeal", {GameParameter::Type::kBool, false}}}};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new LiarsDiceGame(params));
@@ -54,9 +55,11 @@ std::unique_ptr<Game> Factory(const GameParameters& params) {
 
 REGISTER_SPIEL_GAME(kGameType, Factory);
 
-LiarsDiceState::LiarsDiceState(int num_distinct_actions, int num_players,
-                               int total_num_dice, int max_dice_per_player,
-                               const std::vector<int>& num_dice)
+LiarsDiceState::LiarsDiceState(
+    int num_distinct_actions, int num_players, int total_num_dice,
+    int max_dice_per_player, const std::vector<int>& num_dice,
+    std::shared_ptr<const std::vector<std::pair<Action, double>>>
+        combined_outcomes)
     : State(num_distinct_actions, num_players),
       cur_player_(kChancePlayerId),  // chance starts
       cur_roller_(0),                // first player starts rolling
@@ -74,7 +77,8 @@ LiarsDiceState::LiarsDiceState(int num_distinct_actions, int num_players,
       num_dice_rolled_(num_players, 0),
 
       bidseq_(),
-      bidseq_str_() {
+      bidseq_str_(),
+      combined_outcomes_(std::move(combined_outcomes)) {
   for (int const& num_dices : num_dice_) {
     std::vector<int> initial_outcomes(num_dices, kInvalidOutcome);
     dice_outcomes_.push_back(initial_outcomes);
@@ -130,6 +134,26 @@ void LiarsDiceState::ResolveWinner() {
 
 void LiarsDiceState::DoApplyAction(Action action) {
   if (IsChanceNode()) {
+    if (combined_outcomes_ != nullptr) {
+      // The whole deal is one joint outcome, encoding every die in the game
+      // in base kDiceSides: player 0's dice occupy the lowest digits, then
+      // player 1's, and so on. Decoding in the same player/die order as the
+      // sequential dealer (and sorting afterwards) leaves the information
+      // states identical to the one-die-per-node game.
+      Action code = action;
+      for (int p = 0; p < num_players_; p++) {
+        for (int d = 0; d < num_dice_[p]; d++) {
+          dice_outcomes_[p][d] = 1 + code % kDiceSides;
+          code /= kDiceSides;
+          num_dice_rolled_[p]++;
+        }
+        std::sort(dice_outcomes_[p].begin(), dice_outcomes_[p].end());
+      }
+      cur_roller_ = num_players_;
+      cur_player_ = 0;
+      return;
+    }
+
     // Fill the next die roll for the current roller.
     SPIEL_CHECK_GE(cur_roller_, 0);
     SPIEL_CHECK_LT(cur_roller_, num_players_);
@@ -173,8 +197,17 @@ void LiarsDiceState::DoApplyAction(Action action) {
 
 std::vector<Action> LiarsDiceState::LegalActions() const {
   if (IsTerminal()) return {};
-  // A chance node is a single die roll.
   if (IsChanceNode()) {
+    // With a combined deal the single chance node covers every die.
+    if (combined_outcomes_ != nullptr) {
+      std::vector<Action> outcomes(combined_outcomes_->size());
+      for (int i = 0; i < outcomes.size(); i++) {
+        outcomes[i] = (*combined_outcomes_)[i].first;
+      }
+      return outcomes;
+    }
+
+    // A chance node is a single die roll.
     std::vector<Action> outcomes(kDiceSides);
     for (int i = 0; i < kDiceSides; i++) {
       outcomes[i] = 1 + i;
@@ -200,6 +233,11 @@ std::vector<Action> LiarsDiceState::LegalActions() const {
 std::vector<std::pair<Action, double>> LiarsDiceState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
 
+  // With a combined deal, return the joint table built by the game.
+  if (combined_outcomes_ != nullptr) {
+    return *combined_outcomes_;
+  }
+
   std::vector<std::pair<Action, double>> outcomes;
 
   // A chance node is a single die roll.
@@ -343,6 +381,27 @@ LiarsDiceGame::LiarsDiceGame(const GameParameters& params)
       max_dice_per_player_ = nd;
     }
   }
+
+  // With a combined deal, precompute the joint outcome table once: one
+  // outcome per assignment of faces to all the dice, each equally likely.
+  combined_deal_ = ParameterValue<bool>("combineddeal", false);
+  if (combined_deal_) {
+    int64_t num_outcomes = 1;
+    for (int d = 0; d < total_num_dice_; d++) {
+      num_outcomes *= kDiceSides;
+      // The joint table is enumerated explicitly, so it must stay a
+      // reasonable size.
+      SPIEL_CHECK_LE(num_outcomes, 1000000);
+    }
+    std::vector<std::pair<Action, double>> outcomes;
+    outcomes.reserve(num_outcomes);
+    const double prob = 1.0 / num_outcomes;
+    for (Action a = 0; a < num_outcomes; a++) {
+      outcomes.emplace_back(a, prob);
+    }
+    combined_outcomes_ = std::make_shared<
+        const std::vector<std::pair<Action, double>>>(std::move(outcomes));
+  }
 }
 
 int LiarsDiceGame::NumDistinctActions() const {
@@ -355,12 +414,18 @@ std::unique_ptr<State> LiarsDiceGame::NewInitialState() const {
                          /*num_players=*/num_players_,
                          /*total_num_dice=*/total_num_dice_,
                          /*max_dice_per_player=*/max_dice_per_player_,
-                         /*num_dice=*/num_dice_));
+                         /*num_dice=*/num_dice_,
+                         /*combined_outcomes=*/combined_outcomes_));
 
   return state;
 }
 
-int LiarsDiceGame::MaxChanceOutcomes() const { return kDiceSides; }
+int LiarsDiceGame::MaxChanceOutcomes() const {
+  if (combined_deal_) {
+    return combined_outcomes_->size();
+  }
+  return kDiceSides;
+}
 
 int LiarsDiceGame::MaxGameLength() const {
   // A bet for each side and number of total dice, plus "liar" action.
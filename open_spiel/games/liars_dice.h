@@ -18,6 +18,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "open_spiel/spiel.h"
@@ -28,9 +29,12 @@
 // Currently only supports a single round and two players.
 //
 // Parameters:
-//   "players"     int    number of players                      (default = 2)
-//   "numdice"     int    number of dice per player              (default = 1)
-//   "numdiceX"    int    overridden number of dice for player X (default = 1)
+//   "players"      int    number of players                      (default = 2)
+//   "numdice"      int    number of dice per player              (default = 1)
+//   "numdiceX"     int    overridden number of dice for player X (default = 1)
+//   "combineddeal" bool   deal every die in one joint chance
+//                         node instead of one node per die       (default =
+//                         false)
 
 namespace open_spiel {
 namespace liars_dice {
@@ -39,9 +43,11 @@ class LiarsDiceGame;
 
 class LiarsDiceState : public State {
  public:
-  explicit LiarsDiceState(int num_distinct_actions, int num_players,
-                          int total_num_dice, int max_dice_per_player,
-                          const std::vector<int>& num_dice);
+  explicit LiarsDiceState(
+      int num_distinct_actions, int num_players, int total_num_dice,
+      int max_dice_per_player, const std::vector<int>& num_dice,
+      std::shared_ptr<const std::vector<std::pair<Action, double>>>
+          combined_outcomes);
   LiarsDiceState(const LiarsDiceState&) = default;
 
   void Reset(const GameParameters& params);
@@ -83,6 +89,11 @@ class LiarsDiceState : public State {
   // Used to encode the information state.
   std::vector<int> bidseq_;
   std::string bidseq_str_;
+
+  // Precomputed joint deal outcomes, shared with the game. Null when dice are
+  // rolled one chance node at a time.
+  std::shared_ptr<const std::vector<std::pair<Action, double>>>
+      combined_outcomes_;
 };
 
 class LiarsDiceGame : public Game {
@@ -121,6 +132,14 @@ class LiarsDiceGame : public Game {
 
   std::vector<int> num_dice_;  // How many dice each player has.
   int max_dice_per_player_;    // Maximum value in num_dice_ vector.
+
+  // When combineddeal=true, the whole roll is a single chance node whose
+  // outcome table (one entry per assignment of faces to all the dice, each
+  // with probability (1/6)^total_num_dice_) is built once here at game
+  // construction and shared with every state.
+  bool combined_deal_;
+  std::shared_ptr<const std::vector<std::pair<Action, double>>>
+      combined_outcomes_;
 };
 
 }  // namespace liars_dice
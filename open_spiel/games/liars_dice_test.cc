@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+
 #include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
 namespace open_spiel {
@@ -27,10 +30,45 @@ void BasicLiarsDiceTests() {
   testing::RandomSimTest(*LoadGame("liars_dice"), 100);
 }
 
+void CombinedDealLiarsDiceTests() {
+  testing::LoadGameTest("liars_dice(combineddeal=true)");
+  testing::ChanceOutcomesTest(*LoadGame("liars_dice(combineddeal=true)"));
+  testing::RandomSimTest(*LoadGame("liars_dice(combineddeal=true)"), 100);
+}
+
+// Each joint outcome must produce the same post-deal state as dealing the
+// corresponding faces one die at a time.
+void CombinedDealMatchesSequentialDeal() {
+  std::unique_ptr<Game> seq_game = LoadGame("liars_dice");
+  std::unique_ptr<Game> comb_game = LoadGame("liars_dice(combineddeal=true)");
+
+  std::unique_ptr<State> comb_root = comb_game->NewInitialState();
+  auto outcomes = comb_root->ChanceOutcomes();
+  SPIEL_CHECK_EQ(outcomes.size(), 36);
+
+  for (const auto& outcome : outcomes) {
+    std::unique_ptr<State> comb_state = comb_root->Child(outcome.first);
+
+    // Player 0's die is the low digit of the joint outcome, player 1's the
+    // high digit.
+    std::unique_ptr<State> seq_state = seq_game->NewInitialState();
+    seq_state->ApplyAction(1 + outcome.first % 6);
+    seq_state->ApplyAction(1 + outcome.first / 6);
+
+    SPIEL_CHECK_EQ(comb_state->ToString(), seq_state->ToString());
+    for (int p = 0; p < 2; p++) {
+      SPIEL_CHECK_EQ(comb_state->InformationState(p),
+                     seq_state->InformationState(p));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace liars_dice
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::liars_dice::BasicLiarsDiceTests();
+  open_spiel::liars_dice::CombinedDealLiarsDiceTests();
+  open_spiel::liars_dice::CombinedDealMatchesSequentialDeal();
 }
@@ -14,6 +14,7 @@
 
 #include "open_spiel/games/markov_soccer.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -70,6 +71,49 @@ constexpr std::array<int, 5> col_offsets = {{0, 0, -1, 1, 0}};
 
 // Default parameters.
 constexpr int kDefaultHorizon = 1000;
+
+// Packed position word layout (see pos_ in the header).
+constexpr int kNumCells = kRows * kCols;
+constexpr int kBallShift = 10;
+constexpr int kCarryShift = 15;
+constexpr uint64_t kCellMask = 31;
+constexpr int kOffField = 31;
+
+// Destination table sentinels: leaving the field through a goal mouth.
+constexpr int8_t kDestGoalA = -2;  // off the right edge (A's target goal)
+constexpr int8_t kDestGoalB = -3;  // off the left edge (B's target goal)
+
+// kDest[cell][move] is the destination cell of the move, the source cell
+// itself when the move bumps a wall (indistinguishable from standing), or
+// one of the goal sentinels. One lookup replaces the bounds and goal-mouth
+// coordinate checks in the hot move-resolution path.
+struct DestTable {
+  int8_t dest[kNumCells][5];
+};
+
+DestTable BuildDestTable() {
+  DestTable table;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    const int r = cell / kCols;
+    const int c = cell % kCols;
+    for (int move = 0; move < 5; ++move) {
+      const int nr = r + row_offsets[move];
+      const int nc = c + col_offsets[move];
+      if (nr >= 0 && nc >= 0 && nr < kRows && nc < kCols) {
+        table.dest[cell][move] = nr * kCols + nc;
+      } else if ((nr == 1 || nr == 2) && nc == kCols) {
+        table.dest[cell][move] = kDestGoalA;
+      } else if ((nr == 1 || nr == 2) && nc == -1) {
+        table.dest[cell][move] = kDestGoalB;
+      } else {
+        table.dest[cell][move] = cell;
+      }
+    }
+  }
+  return table;
+}
+
+const DestTable kDest = BuildDestTable();
 }  // namespace
 
 MarkovSoccerState::MarkovSoccerState(const MarkovSoccerGame& parent_game)
@@ -112,20 +156,12 @@ std::string MarkovSoccerState::ActionToString(int player,
 }
 
 void MarkovSoccerState::SetField(int r, int c, char v) {
-  field_[r * kCols + c] = v;
-
-  if (v == 'a' || v == 'A') {
-    player_row_[0] = r;
-    player_col_[0] = c;
-  } else if (v == 'b' || v == 'B') {
-    player_row_[1] = r;
-    player_col_[1] = c;
-  }
-
-  if (v == 'O' || v == 'A' || v == 'B') {
-    ball_row_ = r;
-    ball_col_ = c;
-  }
+  // Patch the observation planes in place: a cell change touches exactly two
+  // entries, the old character's plane and the new character's plane.
+  const int cell = r * kCols + c;
+  info_state_plane_[observation_plane(r, c) * kRows * kCols + cell] = 0.0;
+  field_[cell] = v;
+  info_state_plane_[observation_plane(r, c) * kRows * kCols + cell] = 1.0;
 }
 
 char MarkovSoccerState::field(int r, int c) const {
@@ -136,8 +172,20 @@ void MarkovSoccerState::Reset(int horizon) {
   horizon_ = horizon;
   field_.resize(kRows * kCols, '.');
 
+  // Every cell starts empty; from here on SetField keeps the planes in sync
+  // with the field.
+  info_state_plane_.assign(kCellStates * kRows * kCols, 0.0);
+  for (int r = 0; r < kRows; r++) {
+    for (int c = 0; c < kCols; c++) {
+      info_state_plane_[observation_plane(r, c) * kRows * kCols +
+                        r * kCols + c] = 1.0;
+    }
+  }
+
   SetField(2, 1, 'a');
   SetField(1, 3, 'b');
+  pos_ = uint64_t(2 * kCols + 1) | (uint64_t(1 * kCols + 3) << 5) |
+         (uint64_t{kOffField} << kBallShift);
 
   cur_player_ = kChancePlayerId;
   winner_ = kInvalidPlayer;
@@ -154,72 +202,78 @@ void MarkovSoccerState::DoApplyActions(const std::vector<Action>& moves) {
   cur_player_ = kChancePlayerId;
 }
 
-bool MarkovSoccerState::InBounds(int r, int c) const {
-  return (r >= 0 && c >= 0 && r < kRows && c < kCols);
-}
-
 void MarkovSoccerState::ResolveMove(int player, int move) {
-  int old_row = player_row_[player - 1];
-  int old_col = player_col_[player - 1];
-  int new_row = old_row + row_offsets[move];
-  int new_col = old_col + col_offsets[move];
-
-  char from_piece = field(old_row, old_col);
-
-  if (!InBounds(new_row, new_col)) {
-    // Check, this is a goal? If so, set the winner.
-    if (from_piece == 'A' && (new_row == 1 || new_row == 2) &&
-        (new_col == kCols)) {
-      SetField(old_row, old_col, '.');
-      winner_ = 0;
-    } else if (from_piece == 'B' && (new_row == 1 || new_row == 2) &&
-               (new_col == -1)) {
-      SetField(old_row, old_col, '.');
-      winner_ = 1;
+  // The whole resolution runs on the packed position word: one table
+  // lookup for the destination, cell comparisons for collisions, and bit
+  // twiddles for possession. field_ (and with it the observation planes)
+  // is patched only for the cells that actually change.
+  const int p = player - 1;
+  const int me_shift = 5 * p;
+  const int me_cell = (pos_ >> me_shift) & kCellMask;
+  const int dest = kDest.dest[me_cell][move];
+  if (dest == me_cell) return;  // Stood still, or bumped a wall.
+  const bool carrying = (pos_ >> (kCarryShift + p)) & 1;
+
+  if (dest < 0) {
+    // Off the field through a goal mouth; only a ball carrier aiming at
+    // the opponent's goal scores, anything else bounces.
+    if (carrying && dest == (p == 0 ? kDestGoalA : kDestGoalB)) {
+      SetField(me_cell / kCols, me_cell % kCols, '.');
+      pos_ = (pos_ & ~(kCellMask << me_shift)) |
+             (uint64_t{kOffField} << me_shift);
+      pos_ &= ~(uint64_t{1} << (kCarryShift + p));
+      pos_ = (pos_ & ~(kCellMask << kBallShift)) |
+             (uint64_t{kOffField} << kBallShift);
+      winner_ = p;
     }
-
-    // Otherwise, nothing happens.
     return;
   }
 
-  // The move was in bounds!
-  char to_piece = field(new_row, new_col);
-
-  // Stand?
-  if (old_row == new_row && old_col == new_col) {
+  const int other_shift = 5 * (1 - p);
+  const int other_cell = (pos_ >> other_shift) & kCellMask;
+  if (dest == other_cell) {
+    // Walked into the other player: the mover stays, and a carried ball
+    // passes to the defender.
+    if (carrying) {
+      pos_ &= ~(uint64_t{1} << (kCarryShift + p));
+      pos_ |= uint64_t{1} << (kCarryShift + (1 - p));
+      pos_ = (pos_ & ~(kCellMask << kBallShift)) |
+             (uint64_t(other_cell) << kBallShift);
+      SetField(me_cell / kCols, me_cell % kCols, p == 0 ? 'a' : 'b');
+      SetField(other_cell / kCols, other_cell % kCols, p == 0 ? 'B' : 'A');
+    }
     return;
   }
 
-  // Otherwise: something interesting.
-  if (to_piece == '.') {
-    // open field, move'em!
-    SetField(new_row, new_col, field(old_row, old_col));
-    SetField(old_row, old_col, '.');
-  } else if (to_piece == 'O') {
-    // Nice! .. got the ball, way to go; a -> A or b -> B.
-    SPIEL_CHECK_TRUE(from_piece == 'a' || from_piece == 'b');
-
-    if (from_piece == 'a') {
-      SetField(old_row, old_col, '.');
-      SetField(new_row, new_col, 'A');
-    } else if (from_piece == 'b') {
-      SetField(old_row, old_col, '.');
-      SetField(new_row, new_col, 'B');
-    }
-  } else if (from_piece == 'A' && to_piece == 'b') {
-    // Lost of possession to defender.
-    SetField(old_row, old_col, 'a');
-    SetField(new_row, new_col, 'B');
-  } else if (from_piece == 'B' && to_piece == 'a') {
-    // Lost of possession to defender.
-    SetField(old_row, old_col, 'b');
-    SetField(new_row, new_col, 'A');
+  const int ball_cell = (pos_ >> kBallShift) & kCellMask;
+  if (dest == ball_cell && !carrying) {
+    // Picked up the loose ball (a carried ball is always under a player,
+    // so reaching this cell means the ball is loose).
+    pos_ |= uint64_t{1} << (kCarryShift + p);
+  }
+  pos_ = (pos_ & ~(kCellMask << me_shift)) | (uint64_t(dest) << me_shift);
+  if ((pos_ >> (kCarryShift + p)) & 1) {
+    // The ball travels with its carrier.
+    pos_ = (pos_ & ~(kCellMask << kBallShift)) |
+           (uint64_t(dest) << kBallShift);
+    SetField(dest / kCols, dest % kCols, p == 0 ? 'A' : 'B');
+  } else {
+    SetField(dest / kCols, dest % kCols, p == 0 ? 'a' : 'b');
   }
+  SetField(me_cell / kCols, me_cell % kCols, '.');
 }
 
 void MarkovSoccerState::DoApplyAction(Action action_id) {
   if (IsSimultaneousNode()) {
-    ApplyFlatJointAction(action_id);
+    // Both players always have the same five moves, so the flat joint
+    // action decodes arithmetically (player 0 is the low digit, matching
+    // FlatJointActionToActions) without building per-player legal-action
+    // vectors.
+    SPIEL_CHECK_GE(action_id, 0);
+    SPIEL_CHECK_LT(action_id, 25);
+    moves_[0] = action_id % 5;
+    moves_[1] = action_id / 5;
+    cur_player_ = kChancePlayerId;
     return;
   }
   SPIEL_CHECK_TRUE(IsChanceNode());
@@ -228,8 +282,12 @@ void MarkovSoccerState::DoApplyAction(Action action_id) {
 
   if (action_id == 0) {
     SetField(1, 2, 'O');
+    pos_ = (pos_ & ~(kCellMask << kBallShift)) |
+           (uint64_t(1 * kCols + 2) << kBallShift);
   } else if (action_id == 1) {
     SetField(2, 2, 'O');
+    pos_ = (pos_ & ~(kCellMask << kBallShift)) |
+           (uint64_t(2 * kCols + 2) << kBallShift);
   } else if (action_id == 2) {
     ResolveMove(1, moves_[0]);
     ResolveMove(2, moves_[1]);
@@ -331,18 +389,14 @@ void MarkovSoccerState::InformationStateAsNormalizedVector(
     int player, std::vector<double>* values) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
+  *values = info_state_plane_;
+}
 
-  values->resize(parent_game_.InformationStateNormalizedVectorSize());
-  std::fill(values->begin(), values->end(), 0.);
-  int plane_size = kRows * kCols;
-
-  for (int r = 0; r < kRows; r++) {
-    for (int c = 0; c < kCols; c++) {
-      int plane = observation_plane(r, c);
-      SPIEL_CHECK_TRUE(plane >= 0 && plane < kCellStates);
-      (*values)[plane * plane_size + r * kCols + c] = 1.0;
-    }
-  }
+void MarkovSoccerState::InformationStateAsNormalizedVector(
+    int player, double* buffer) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+  std::copy(info_state_plane_.begin(), info_state_plane_.end(), buffer);
 }
 
 std::unique_ptr<State> MarkovSoccerState::Clone() const {
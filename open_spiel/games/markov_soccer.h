@@ -16,6 +16,7 @@
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_MARKOV_SOCCER_H_
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,18 @@ class MarkovSoccerState : public SimMoveState {
   }
   void InformationStateAsNormalizedVector(int player,
                                           std::vector<double>* values) const;
+  void InformationStateAsNormalizedVector(int player, double* buffer) const;
+
+  // Const view of the normalized observation planes, laid out as
+  // InformationStateNormalizedVectorShape(). The planes are maintained
+  // incrementally — SetField patches the two entries a cell change touches —
+  // so reading them here avoids both the per-step rebuild and the copy made
+  // by InformationStateAsNormalizedVector. Both players see the same planes.
+  // The view is invalidated by the next ApplyAction(s).
+  const std::vector<double>& InformationStatePlanes() const {
+    return info_state_plane_;
+  }
+
   int CurrentPlayer() const override {
     return IsTerminal() ? kTerminalPlayerId : cur_player_;
   }
@@ -68,7 +81,6 @@ class MarkovSoccerState : public SimMoveState {
   void SetField(int r, int c, char v);
   char field(int r, int c) const;
   void ResolveMove(int player, int move);
-  bool InBounds(int r, int c) const;
   int observation_plane(int r, int c) const;
 
   const MarkovSoccerGame& parent_game_;
@@ -78,12 +90,18 @@ class MarkovSoccerState : public SimMoveState {
   int cur_player_ = -1;  // Could be chance's turn.
   int total_moves_ = -1;
   int horizon_ = -1;
-  std::array<int, 2> player_row_ = {{-1, -1}};  // Players' rows.
-  std::array<int, 2> player_col_ = {{-1, -1}};  // Players' cols.
-  int ball_row_ = -1;
-  int ball_col_ = -1;
+  // All piece positions in one packed word: bits 0-4 hold A's cell, bits
+  // 5-9 B's cell, bits 10-14 the ball's cell (cell = row * kCols + col, or
+  // 31 for "not on the field"), and bits 15/16 are set while A/B carries
+  // the ball. ResolveMove runs entirely on this word — a table lookup for
+  // the destination and cell comparisons for collisions — and mirrors the
+  // outcome into field_ for the observation encodings.
+  uint64_t pos_ = 0;
   std::array<int, 2> moves_ = {{-1, -1}};  // Moves taken.
   std::vector<char> field_;
+  // Incrementally maintained normalized observation planes; initialized by
+  // Reset() and patched in place by SetField().
+  std::vector<double> info_state_plane_;
 };
 
 class MarkovSoccerGame : public SimMoveGame {
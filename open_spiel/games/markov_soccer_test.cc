@@ -14,6 +14,8 @@
 
 #include "open_spiel/games/markov_soccer.h"
 
+#include <random>
+
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -29,10 +31,65 @@ void BasicMarkovSoccerTests() {
   testing::RandomSimTest(*LoadGame("markov_soccer"), 100);
 }
 
+int CharToPlane(char v) {
+  switch (v) {
+    case 'a':
+      return 0;
+    case 'A':
+      return 1;
+    case 'b':
+      return 2;
+    case 'B':
+      return 3;
+    case 'O':
+      return 4;
+    case '.':
+      return 5;
+    default:
+      SpielFatalError("Invalid character on field");
+      return -1;
+  }
+}
+
+void IncrementalPlanesMatchBoardTest() {
+  // The observation planes are patched incrementally by SetField rather than
+  // rebuilt per query; check along a random playout that they stay in exact
+  // sync with the board.
+  std::unique_ptr<Game> game = LoadGame("markov_soccer");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<int> shape = game->InformationStateNormalizedVectorShape();
+  const int num_planes = shape[0];
+  const int rows = shape[1];
+  const int cols = shape[2];
+  const int plane_size = rows * cols;
+  std::mt19937 rng(2384);
+  for (int step = 0; step < 200 && !state->IsTerminal(); ++step) {
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(actions[rng() % actions.size()]);
+    const std::vector<double>& planes =
+        static_cast<const MarkovSoccerState&>(*state).InformationStatePlanes();
+    // The patched planes must equal the copy the API hands out..
+    SPIEL_CHECK_TRUE(planes == state->InformationStateAsNormalizedVector(0));
+    // ..and encode exactly the board: one plane set per cell, the one the
+    // cell's character maps to.
+    std::string board = state->ToString();
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        int expected = CharToPlane(board[r * (cols + 1) + c]);
+        for (int p = 0; p < num_planes; ++p) {
+          SPIEL_CHECK_EQ(planes[p * plane_size + r * cols + c],
+                         p == expected ? 1.0 : 0.0);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace markov_soccer
 }  // namespace open_spiel
 
 int main(int argc, char **argv) {
   open_spiel::markov_soccer::BasicMarkovSoccerTests();
+  open_spiel::markov_soccer::IncrementalPlanesMatchBoardTest();
 }
@@ -38,7 +38,9 @@ const GameType kGameType{
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
     {{"num_houses_per_player", {GameParameter::Type::kInt, false}},
-     {"num_seeds_per_house", {GameParameter::Type::kInt, false}}}};
+     {"num_seeds_per_house", {GameParameter::Type::kInt, false}}},
+    /*provides_undo=*/false,
+    /*provides_hash_value=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new OwareGame(params));
@@ -238,6 +240,9 @@ int OwareState::DoCaptureFrom(int house) {
 
 void OwareState::DoApplyAction(Action action) {
   SPIEL_CHECK_LT(history_.size(), kMaxGameLength);
+  // On a terminal state CurrentPlayer() is kTerminalPlayerId, which below
+  // would silently index a house outside the board.
+  SPIEL_CHECK_FALSE(IsTerminal());
 
   int last_house = DistributeSeeds(ActionToHouse(CurrentPlayer(), action));
 
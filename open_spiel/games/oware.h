@@ -67,6 +67,9 @@ class OwareState : public State {
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::unique_ptr<State> Clone() const override;
+  // The board holds the player to move, scores and seeds, so its hash keys
+  // the whole state (bar the repetition history, as in chess).
+  uint64_t HashValue() const override { return board_.HashValue(); }
   const OwareBoard& Board() const { return board_; }
   std::string Observation(int player) const override;
 
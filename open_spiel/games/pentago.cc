@@ -19,6 +19,8 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/spiel_utils.h"
+
 namespace open_spiel {
 namespace pentago {
 namespace {
@@ -42,7 +44,12 @@ const GameType kGameType{
     {
         {"ansi_color_output",
          GameType::ParameterSpec{GameParameter::Type::kBool, false}},
-    }};
+    },
+    /*provides_undo=*/false,
+    /*provides_hash_value=*/false,
+    /*history_independent_state=*/false,
+    /*provides_quick_evaluate=*/false,
+    /*provides_canonical_key=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new PentagoGame(params));
@@ -210,6 +217,22 @@ std::string PentagoState::ToString() const {
   return out.str();
 }
 
+std::string PentagoState::CanonicalKey() const {
+  // Rotating or reflecting the whole board maps quadrants onto quadrants
+  // and rotation moves onto rotation moves, so positions equal up to the 8
+  // board symmetries have equivalent continuations. The player to move and
+  // the outcome both follow from the stones.
+  std::string grid(kBoardPositions, '.');
+  for (int i = 0; i < kBoardPositions; i++) {
+    if (get(i) == kPlayer1) {
+      grid[i] = 'x';
+    } else if (get(i) == kPlayer2) {
+      grid[i] = 'o';
+    }
+  }
+  return CanonicalSquareBoardKey(grid, kBoardSize);
+}
+
 Player PentagoState::get(int i) const {
   return (board_[0] & xy_bit_mask[i]
               ? kPlayer1
@@ -59,6 +59,7 @@ class PentagoState : public State {
   }
   std::string ActionToString(int player, Action action_id) const override;
   std::string ToString() const override;
+  std::string CanonicalKey() const override;
   bool IsTerminal() const override { return outcome_ != kPlayerNone; }
   std::vector<double> Returns() const override;
   std::string InformationState(int player) const override;
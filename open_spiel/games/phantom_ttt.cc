@@ -51,7 +51,8 @@ const GameType kGameType{
     /*provides_observation=*/true,
     /*provides_observation_as_normalized_vector=*/true,
     /*parameter_specification=*/
-    {{"obstype", {GameParameter::Type::kString, false}}}};
+    {{"obstype", {GameParameter::Type::kString, false}}},
+    /*provides_undo=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new PhantomTTTGame(params));
@@ -18,6 +18,8 @@
 
 #include <utility>
 
+#include "open_spiel/games/zobrist.h"
+
 namespace open_spiel {
 namespace pig {
 
@@ -35,6 +37,9 @@ constexpr int kDefaultHorizon = 1000;
 constexpr int kDefaultPlayers = 2;
 constexpr int kDefaultWinScore = 100;
 
+// The fixed decision-node action set (see State::StaticLegalActions).
+const std::vector<Action> kDecisionActions = {kRoll, kStop};
+
 // Facts about the game
 const GameType kGameType{
     /*short_name=*/"pig",
@@ -56,7 +61,13 @@ const GameType kGameType{
         {"horizon", {GameParameter::Type::kInt, false}},
         {"winscore", {GameParameter::Type::kInt, false}},
         {"diceoutcomes", {GameParameter::Type::kInt, false}},
-    }};
+    },
+    /*provides_undo=*/false,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/false,
+    /*provides_canonical_key=*/false,
+    /*state_independent_actions=*/true};
 
 static std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new PigGame(params));
@@ -90,7 +101,7 @@ bool PigState::IsTerminal() const {
 
 std::vector<double> PigState::Returns() const {
   if (!IsTerminal()) {
-    return std::vector<double>(0.0, num_players_);
+    return std::vector<double>(num_players_, 0.0);
   }
 
   // For (n>2)-player games, must keep it zero-sum.
@@ -104,7 +115,7 @@ std::vector<double> PigState::Returns() const {
   }
 
   // Nobody has won? (e.g. over horizon length.) Then everyone gets 0.
-  return std::vector<double>(0.0, num_players_);
+  return std::vector<double>(num_players_, 0.0);
 }
 
 std::string PigState::InformationState(int player) const {
@@ -165,11 +176,13 @@ void PigState::InformationStateAsNormalizedVector(
 }
 
 PigState::PigState(int num_distinct_actions, int num_players, int dice_outcomes,
-                   int horizon, int win_score)
+                   int horizon, int win_score,
+                   const ActionsAndProbs* chance_outcomes)
     : State(num_distinct_actions, num_players),
       dice_outcomes_(dice_outcomes),
       horizon_(horizon),
-      win_score_(win_score) {
+      win_score_(win_score),
+      chance_outcomes_(chance_outcomes) {
   total_moves_ = 0;
   cur_player_ = 0;
   turn_player_ = 0;
@@ -220,17 +233,29 @@ std::vector<Action> PigState::LegalActions() const {
     return {kRoll, kStop};
 }
 
+const std::vector<Action>* PigState::StaticLegalActions() const {
+  // Every decision node offers the same two actions: roll or stop.
+  if (IsChanceNode() || IsTerminal()) return nullptr;
+  return &kDecisionActions;
+}
+
 std::vector<std::pair<Action, double>> PigState::ChanceOutcomes() const {
   SPIEL_CHECK_TRUE(IsChanceNode());
-  std::vector<std::pair<Action, double>> outcomes;
+  return *chance_outcomes_;
+}
 
-  // All the chance outcomes come after roll and stop.
-  outcomes.reserve(dice_outcomes_);
-  for (int i = 0; i < dice_outcomes_; i++) {
-    outcomes.push_back(std::make_pair(i + 1, 1.0 / dice_outcomes_));
-  }
+const ActionsAndProbs* PigState::StaticChanceOutcomes() const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // The roll distribution is the same at every chance node.
+  return chance_outcomes_;
+}
 
-  return outcomes;
+std::pair<Action, double> PigState::SampleChanceOutcome(double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // The roll is uniform over dice_outcomes_ sides, so sample it directly.
+  int roll = static_cast<int>(z * dice_outcomes_);
+  if (roll >= dice_outcomes_) roll = dice_outcomes_ - 1;
+  return std::make_pair(roll + 1, 1.0 / dice_outcomes_);
 }
 
 std::string PigState::ToString() const {
@@ -244,12 +269,28 @@ std::unique_ptr<State> PigState::Clone() const {
   return std::unique_ptr<State>(new PigState(*this));
 }
 
+uint64_t PigState::HashValue() const {
+  // The whole state is a handful of counters; chain them into one key.
+  uint64_t hash = 0x90b2f3c7a85d41e9ULL;
+  for (int score : scores_) {
+    hash = zobrist::MixHash(hash, score);
+  }
+  hash = zobrist::MixHash(hash, turn_total_);
+  return zobrist::MixHash(hash, cur_player_);
+}
+
 PigGame::PigGame(const GameParameters& params)
     : Game(kGameType, params),
       dice_outcomes_(ParameterValue<int>("diceoutcomes", kDefaultDiceOutcomes)),
       horizon_(ParameterValue<int>("horizon", kDefaultHorizon)),
       num_players_(ParameterValue<int>("players", kDefaultPlayers)),
-      win_score_(ParameterValue<int>("winscore", kDefaultWinScore)) {}
+      win_score_(ParameterValue<int>("winscore", kDefaultWinScore)) {
+  // All the chance outcomes come after roll and stop.
+  chance_outcomes_.reserve(dice_outcomes_);
+  for (int i = 0; i < dice_outcomes_; i++) {
+    chance_outcomes_.push_back(std::make_pair(i + 1, 1.0 / dice_outcomes_));
+  }
+}
 
 }  // namespace pig
 }  // namespace open_spiel
@@ -39,11 +39,13 @@ class PigState : public State {
  public:
   PigState(const PigState&) = default;
   PigState(int num_distinct_actions, int num_players, int dice_outcomes,
-           int horizon, int win_score);
+           int horizon, int win_score, const ActionsAndProbs* chance_outcomes);
 
   int CurrentPlayer() const override;
   std::string ActionToString(int player, Action move_id) const override;
   std::vector<std::pair<Action, double>> ChanceOutcomes() const override;
+  const ActionsAndProbs* StaticChanceOutcomes() const override;
+  std::pair<Action, double> SampleChanceOutcome(double z) const override;
   std::string ToString() const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
@@ -52,9 +54,11 @@ class PigState : public State {
       int player, std::vector<double>* values) const override;
 
   std::unique_ptr<State> Clone() const override;
+  uint64_t HashValue() const override;
 
   int dice_outcomes() const { return dice_outcomes_; }
   std::vector<Action> LegalActions() const override;
+  const std::vector<Action>* StaticLegalActions() const override;
 
  protected:
   void DoApplyAction(Action move_id) override;
@@ -73,6 +77,10 @@ class PigState : public State {
                           // cur_player will be the chance player's id.)
   std::vector<int> scores_;  // Score for each player.
   int turn_total_ = -1;
+
+  // The fixed roll distribution, owned by the PigGame (which outlives its
+  // states).
+  const ActionsAndProbs* chance_outcomes_ = nullptr;
 };
 
 class PigGame : public Game {
@@ -81,9 +89,9 @@ class PigGame : public Game {
 
   int NumDistinctActions() const override { return 6; }
   std::unique_ptr<State> NewInitialState() const override {
-    return std::unique_ptr<State>(new PigState(NumDistinctActions(),
-                                               num_players_, dice_outcomes_,
-                                               horizon_, win_score_));
+    return std::unique_ptr<State>(
+        new PigState(NumDistinctActions(), num_players_, dice_outcomes_,
+                     horizon_, win_score_, &chance_outcomes_));
   }
   int MaxChanceOutcomes() const override { return dice_outcomes_; }
 
@@ -111,6 +119,10 @@ class PigGame : public Game {
 
   // The amount needed to win.
   int win_score_;
+
+  // The fixed roll distribution, built once so every state references it
+  // instead of rebuilding the vector (see State::StaticChanceOutcomes).
+  ActionsAndProbs chance_outcomes_;
 };
 
 }  // namespace pig
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <random>
+
 #include "open_spiel/spiel.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -31,8 +33,52 @@ void BasicPigTests() {
   }
 }
 
+void StaticLegalActionsTest() {
+  std::unique_ptr<Game> game = LoadGame("pig");
+  SPIEL_CHECK_TRUE(game->GetType().state_independent_actions);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::mt19937 rng(37);
+  while (!state->IsTerminal()) {
+    const std::vector<Action>* fixed = state->StaticLegalActions();
+    if (state->IsChanceNode()) {
+      SPIEL_CHECK_TRUE(fixed == nullptr);
+    } else {
+      // Every decision node serves the same table, equal to LegalActions().
+      SPIEL_CHECK_TRUE(fixed != nullptr);
+      SPIEL_CHECK_TRUE(*fixed == state->LegalActions());
+    }
+    std::vector<Action> actions = state->LegalActions();
+    state->ApplyAction(
+        actions[std::uniform_int_distribution<int>(0, actions.size() - 1)(
+            rng)]);
+  }
+  SPIEL_CHECK_TRUE(state->StaticLegalActions() == nullptr);
+}
+
+void HorizonReturnsTest() {
+  // A game cut off by the horizon with no winner is a draw: everyone gets
+  // a return of zero, one per player. (Regression test: these returns were
+  // once built with swapped vector-constructor arguments, producing an
+  // empty vector that crashed downstream consumers.)
+  std::unique_ptr<Game> game = LoadGame(
+      "pig", {{"horizon", GameParameter(4)}, {"winscore", GameParameter(100)}});
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (!state->IsTerminal()) {
+    // Keep rolling (action 0); with winscore 100 the short horizon always
+    // ends it.
+    state->ApplyAction(state->IsChanceNode() ? 2 : 0);
+  }
+  std::vector<double> returns = state->Returns();
+  SPIEL_CHECK_EQ(returns.size(), game->NumPlayers());
+  for (double value : returns) SPIEL_CHECK_EQ(value, 0.0);
+}
+
 }  // namespace
 }  // namespace pig
 }  // namespace open_spiel
 
-int main(int argc, char** argv) { open_spiel::pig::BasicPigTests(); }
+int main(int argc, char** argv) {
+  open_spiel::pig::BasicPigTests();
+  open_spiel::pig::StaticLegalActionsTest();
+  open_spiel::pig::HorizonReturnsTest();
+}
@@ -114,14 +114,24 @@ std::vector<Action> QuoridorState::LegalActions() const {
 
   // Wall placements.
   if (wall_count_[current_player_] > 0) {
+    // Find one path to the end zone per player up front. A candidate wall
+    // that doesn't cross either path cannot cut anyone off (the found path
+    // certifies a connection that avoids it), so the per-wall searches in
+    // IsValidWall are only needed for the few walls that block a path.
+    std::array<std::vector<bool>, kNumPlayers> path_crossings;
+    for (int p = 0; p < kNumPlayers; ++p) {
+      path_crossings[p].resize(board_.size(), false);
+      SPIEL_CHECK_TRUE(
+          MarkPathCrossings(static_cast<Player>(p), &path_crossings[p]));
+    }
     for (int y = 0; y < board_diameter_ - 2; y += 2) {
       for (int x = 0; x < board_diameter_ - 2; x += 2) {
         Move h = GetMove(x, y + 1);
-        if (IsValidWall(h)) {
+        if (IsValidWall(h, path_crossings)) {
           moves.push_back(h.xy);
         }
         Move v = GetMove(x + 1, y);
-        if (IsValidWall(v)) {
+        if (IsValidWall(v, path_crossings)) {
           moves.push_back(v.xy);
         }
       }
@@ -167,7 +177,9 @@ void QuoridorState::AddActions(Move cur, Offset offset,
   }
 }
 
-bool QuoridorState::IsValidWall(Move m) const {
+bool QuoridorState::IsValidWall(
+    Move m,
+    const std::array<std::vector<bool>, kNumPlayers>& path_crossings) const {
   Offset offset = (m.IsHorizontalWall() ? Offset(1, 0) : Offset(0, 1));
 
   if (IsWall(m + offset * 0) ||
@@ -195,9 +207,58 @@ bool QuoridorState::IsValidWall(Move m) const {
   if (count <= 1)
     return true;
 
-  // Do a full search to verify both players can get to their respective goals.
-  return (SearchEndZone(kPlayer1, m, m + offset * 2) &&
-          SearchEndZone(kPlayer2, m, m + offset * 2));
+  // Only the wall's two end segments can block pawn movement (the middle
+  // segment sits between wall slots). A player whose known path crosses
+  // neither segment certainly still has a path; only search for the others.
+  Move far = m + offset * 2;
+  for (int p = 0; p < kNumPlayers; ++p) {
+    if (path_crossings[p][m.xy] || path_crossings[p][far.xy]) {
+      if (!SearchEndZone(static_cast<Player>(p), m, far)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool QuoridorState::MarkPathCrossings(Player p,
+                                      std::vector<bool>* crossings) const {
+  // Same search as SearchEndZone, but with a parent link per cell so the
+  // found path can be walked back to mark the wall cells it crosses.
+  std::vector<int> parent(board_.size(), -1);
+  Offset dir(1, 0);  // Direction is arbitrary. Queue will make it fast.
+  int goal = end_zone_[p];
+  int goal_dir = (goal == 0 ? 1 : -1);  // Sort for shortest dist in a max-heap.
+  Move start = player_loc_[p];
+  parent[start.xy] = start.xy;
+  std::priority_queue<std::pair<int, Move>> queue;  // <distance to goal, move>
+  queue.push(std::make_pair(0, start));
+  while (!queue.empty()) {
+    // Ignore the distance. It is only for sorting.
+    Move c = queue.top().second;
+    queue.pop();
+    for (int i = 0; i < 4; i++) {
+      Move wall = c + dir;
+      Move move = c + dir * 2;
+      if (!IsWall(wall) && parent[move.xy] == -1) {
+        parent[move.xy] = c.xy;
+        if (move.y == goal) {
+          // Walk the path back to the start. Adjacent cells on the path are
+          // two apart, so the wall cell crossed is the one between them.
+          int cur = move.xy;
+          while (cur != start.xy) {
+            (*crossings)[(cur + parent[cur]) / 2] = true;
+            cur = parent[cur];
+          }
+          return true;
+        }
+        queue.push(std::make_pair(goal_dir * (goal - move.y), move));
+      }
+      dir = dir.rotate_left();
+    }
+  }
+
+  return false;
 }
 
 bool QuoridorState::SearchEndZone(Player p, Move wall1, Move wall2) const {
@@ -15,6 +15,7 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_QUORIDOR_H_
 #define THIRD_PARTY_OPEN_SPIEL_GAMES_QUORIDOR_H_
 
+#include <array>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -109,7 +110,17 @@ class QuoridorState : public State {
   void DoApplyAction(Action action) override;
 
   void AddActions(Move cur, Offset offset, std::vector<Action> *moves) const;
-  bool IsValidWall(Move m) const;
+
+  // Finds a path from player p's position to their end zone and marks every
+  // wall cell it crosses in `crossings`. Returns whether a path was found.
+  bool MarkPathCrossings(Player p, std::vector<bool>* crossings) const;
+
+  // Whether the wall can be placed. `path_crossings` holds, per player, the
+  // wall cells crossed by a known path to their end zone; a candidate wall
+  // only needs a full search for the players whose path it blocks.
+  bool IsValidWall(
+      Move m,
+      const std::array<std::vector<bool>, kNumPlayers>& path_crossings) const;
   bool SearchEndZone(Player p, Move wall1, Move wall2) const;
 
   // Turn an action id into a `Move`.
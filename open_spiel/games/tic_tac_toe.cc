@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/zobrist.h"
 #include "open_spiel/spiel_utils.h"
 
 namespace open_spiel {
@@ -40,7 +41,12 @@ const GameType kGameType{
     /*provides_information_state_as_normalized_vector=*/false,
     /*provides_observation=*/true,
     /*provides_observation_as_normalized_vector=*/true,
-    /*parameter_specification=*/{}  // no parameters
+    /*parameter_specification=*/{},  // no parameters
+    /*provides_undo=*/true,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true,
+    /*provides_quick_evaluate=*/false,
+    /*provides_canonical_key=*/true,
 };
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
@@ -80,6 +86,10 @@ std::string StateToString(CellState state) {
 void TicTacToeState::DoApplyAction(Action move) {
   SPIEL_CHECK_EQ(board_[move], CellState::kEmpty);
   board_[move] = PlayerToState(CurrentPlayer());
+  if (HasLine(current_player_)) {
+    winner_ = current_player_;
+  }
+  ++num_moves_;
   current_player_ = 1 - current_player_;
 }
 
@@ -94,6 +104,17 @@ std::vector<Action> TicTacToeState::LegalActions() const {
   return moves;
 }
 
+void TicTacToeState::LegalActionsBitset(uint64_t* out) const {
+  // One word covers all nine cells: set the bit of every empty cell.
+  uint64_t bits = 0;
+  if (!IsTerminal()) {
+    for (int cell = 0; cell < kNumCells; ++cell) {
+      if (board_[cell] == CellState::kEmpty) bits |= uint64_t{1} << cell;
+    }
+  }
+  out[0] = bits;
+}
+
 std::string TicTacToeState::ActionToString(int player, Action action_id) const {
   return absl::StrCat(StateToString(PlayerToState(player)), "(",
                       action_id % kNumCols, ",", action_id / kNumCols, ")");
@@ -111,39 +132,38 @@ bool TicTacToeState::HasLine(int player) const {
          (board_[2] == c && board_[4] == c && board_[6] == c);
 }
 
-bool TicTacToeState::IsFull() const {
-  for (int cell = 0; cell < kNumCells; ++cell) {
-    if (board_[cell] == CellState::kEmpty) return false;
-  }
-  return true;
-}
+bool TicTacToeState::IsFull() const { return num_moves_ == kNumCells; }
 
 TicTacToeState::TicTacToeState(int num_distinct_actions)
     : State(num_distinct_actions, kNumPlayers) {
   std::fill(begin(board_), end(board_), CellState::kEmpty);
 }
 
-std::string TicTacToeState::ToString() const {
-  std::string str;
+void TicTacToeState::AppendToString(std::string* str) const {
   for (int r = 0; r < kNumRows; ++r) {
     for (int c = 0; c < kNumCols; ++c) {
-      absl::StrAppend(&str, StateToString(BoardAt(r, c)));
+      absl::StrAppend(str, StateToString(BoardAt(r, c)));
     }
     if (r < (kNumRows - 1)) {
-      absl::StrAppend(&str, "\n");
+      absl::StrAppend(str, "\n");
     }
   }
+}
+
+std::string TicTacToeState::ToString() const {
+  std::string str;
+  AppendToString(&str);
   return str;
 }
 
 bool TicTacToeState::IsTerminal() const {
-  return HasLine(0) || HasLine(1) || IsFull();
+  return winner_ != kInvalidPlayer || IsFull();
 }
 
 std::vector<double> TicTacToeState::Returns() const {
-  if (HasLine(0)) {
+  if (winner_ == 0) {
     return {1.0, -1.0};
-  } else if (HasLine(1)) {
+  } else if (winner_ == 1) {
     return {-1.0, 1.0};
   } else {
     return {0.0, 0.0};
@@ -162,22 +182,67 @@ std::string TicTacToeState::Observation(int player) const {
 
 void TicTacToeState::ObservationAsNormalizedVector(
     int player, std::vector<double>* values) const {
+  values->resize(kNumCells * kCellStates);
+  ObservationAsNormalizedVector(player, values->data());
+}
+
+void TicTacToeState::ObservationAsNormalizedVector(int player,
+                                                   double* buffer) const {
   SPIEL_CHECK_GE(player, 0);
   SPIEL_CHECK_LT(player, num_players_);
 
-  values->resize(kNumCells * kCellStates);
-  std::fill(values->begin(), values->end(), 0.);
+  std::fill(buffer, buffer + kNumCells * kCellStates, 0.);
   for (int cell = 0; cell < kNumCells; ++cell) {
-    (*values)[kNumCells * static_cast<int>(board_[cell]) + cell] = 1.0;
+    buffer[kNumCells * static_cast<int>(board_[cell]) + cell] = 1.0;
+  }
+}
+
+void TicTacToeState::ObservationAsNormalizedVector(int player,
+                                                   float* buffer) const {
+  SPIEL_CHECK_GE(player, 0);
+  SPIEL_CHECK_LT(player, num_players_);
+
+  std::fill(buffer, buffer + kNumCells * kCellStates, 0.f);
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    buffer[kNumCells * static_cast<int>(board_[cell]) + cell] = 1.0f;
   }
 }
 
 void TicTacToeState::UndoAction(int player, Action move) {
   board_[move] = CellState::kEmpty;
   current_player_ = player;
+  // Only the move being undone can have completed a line.
+  winner_ = kInvalidPlayer;
+  --num_moves_;
   history_.pop_back();
 }
 
+uint64_t TicTacToeState::HashValue() const {
+  constexpr uint64_t kHashSeed = 0x8b72e1aa346bdb23ULL;
+  uint64_t hash = 0;
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (board_[cell] != CellState::kEmpty) {
+      hash ^= zobrist::ZobristValue(
+          kHashSeed, cell * 3 + static_cast<int>(board_[cell]));
+    }
+  }
+  return hash;
+}
+
+std::string TicTacToeState::CanonicalKey() const {
+  // The player to move follows from the cell counts, so the board alone
+  // identifies the state; minimize it over the 8 board symmetries.
+  std::string grid(kNumCells, '.');
+  for (int cell = 0; cell < kNumCells; ++cell) {
+    if (board_[cell] == CellState::kCross) {
+      grid[cell] = 'x';
+    } else if (board_[cell] == CellState::kNought) {
+      grid[cell] = 'o';
+    }
+  }
+  return CanonicalSquareBoardKey(grid, kNumRows);
+}
+
 std::unique_ptr<State> TicTacToeState::Clone() const {
   return std::unique_ptr<State>(new TicTacToeState(*this));
 }
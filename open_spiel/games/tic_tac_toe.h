@@ -60,15 +60,27 @@ class TicTacToeState : public State {
   }
   std::string ActionToString(int player, Action action_id) const override;
   std::string ToString() const override;
+  void AppendToString(std::string* str) const override;
   bool IsTerminal() const override;
   std::vector<double> Returns() const override;
   std::string InformationState(int player) const override;
   std::string Observation(int player) const override;
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
+  void ObservationAsNormalizedVector(int player,
+                                     double* buffer) const override;
+  void ObservationAsNormalizedVector(int player,
+                                     float* buffer) const override;
   std::unique_ptr<State> Clone() const override;
+  void CloneInto(State* state) const override {
+    *static_cast<TicTacToeState*>(state) = *this;
+  }
+  bool SupportsCloneInto() const override { return true; }
   void UndoAction(int player, Action move) override;
+  uint64_t HashValue() const override;
+  std::string CanonicalKey() const override;
   std::vector<Action> LegalActions() const override;
+  void LegalActionsBitset(uint64_t* out) const override;
   CellState BoardAt(int cell) const { return board_[cell]; }
   CellState BoardAt(int row, int column) const {
     return board_[row * kNumCols + column];
@@ -82,6 +94,10 @@ class TicTacToeState : public State {
   bool HasLine(int player) const;  // Does this player have a line?
   bool IsFull() const;             // Is the board full?
   int current_player_ = 0;         // Player zero goes first
+  // Maintained by DoApplyAction so that IsTerminal() and Returns() are
+  // plain loads instead of re-running the line checks.
+  int winner_ = kInvalidPlayer;
+  int num_moves_ = 0;
 };
 
 // Game object.
@@ -27,10 +27,23 @@ void BasicTicTacToeTests() {
   testing::RandomSimTest(*LoadGame("tic_tac_toe"), 100);
 }
 
+void CanonicalKeyTest() {
+  // All four opening corner moves are the same position up to symmetry;
+  // the center move is a different one.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::string corner = state->Child(0)->CanonicalKey();
+  for (Action action : {2, 6, 8}) {
+    SPIEL_CHECK_EQ(state->Child(action)->CanonicalKey(), corner);
+  }
+  SPIEL_CHECK_NE(state->Child(4)->CanonicalKey(), corner);
+}
+
 }  // namespace
 }  // namespace tic_tac_toe
 }  // namespace open_spiel
 
 int main(int argc, char** argv) {
   open_spiel::tic_tac_toe::BasicTicTacToeTests();
+  open_spiel::tic_tac_toe::CanonicalKeyTest();
 }
@@ -94,7 +94,8 @@ const GameType kGameType2p{
     /*provides_information_state_as_normalized_vector=*/false,
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
+    /*parameter_specification=*/{},  // no parameters
+    /*provides_undo=*/true,
 };
 
 const GameType kGameType4p{
@@ -111,7 +112,8 @@ const GameType kGameType4p{
     /*provides_information_state_as_normalized_vector=*/false,
     /*provides_observation=*/false,
     /*provides_observation_as_normalized_vector=*/false,
-    /*parameter_specification=*/{}  // no parameters
+    /*parameter_specification=*/{},  // no parameters
+    /*provides_undo=*/true,
 };
 
 // Game for the play of the cards. We don't register this - it is for internal
@@ -138,7 +140,8 @@ const GameType kGameTypePlay{
         {"hand_N", {GameParameter::Type::kString, true}},
         {"hand_E", {GameParameter::Type::kString, true}},
         {"hand_S", {GameParameter::Type::kString, true}},
-    }};
+    },
+    /*provides_undo=*/true};
 
 std::unique_ptr<Game> Factory2p(const GameParameters& params) {
   return std::unique_ptr<Game>(new TinyBridgeGame2p(params));
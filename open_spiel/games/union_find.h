@@ -0,0 +1,76 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_UNION_FIND_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_UNION_FIND_H_
+
+#include <utility>
+#include <vector>
+
+// Union-find over groups of board cells, shared by the connection games
+// (y, havannah). The groups are stored in a union-find structure embedded
+// in the game's array of cells: following the `parent` indices leads to the
+// group leader, which has the up to date size and connectivity of that group.
+//
+// The cell type must provide:
+//   uint16_t parent;  // Index of the parent cell; the leader is its own
+//                     // parent.
+//   uint16_t size;    // Size of the group. Only valid for the leader.
+//   void MergeGroupConnectivity(const Cell& other);
+//                     // Combines `other`'s group connectivity (e.g. edge and
+//                     // corner bitsets) into this cell's. Both cells are
+//                     // group leaders when this is called.
+
+namespace open_spiel {
+
+// Find the leader of the group. Not const due to path compression.
+template <class Cell>
+int FindGroupLeader(std::vector<Cell>* board, int cell) {
+  int parent = (*board)[cell].parent;
+  if (parent != cell) {
+    do {  // Follow the parent chain up to the group leader.
+      parent = (*board)[parent].parent;
+    } while (parent != (*board)[parent].parent);
+    // Do path compression, but only the current one to avoid recursion.
+    (*board)[cell].parent = parent;
+  }
+  return parent;
+}
+
+// Join the groups of two positions, propagating group size and connectivity.
+// Returns true if they were already the same group.
+template <class Cell>
+bool JoinGroups(std::vector<Cell>* board, int cell_a, int cell_b) {
+  int leader_a = FindGroupLeader(board, cell_a);
+  int leader_b = FindGroupLeader(board, cell_b);
+
+  if (leader_a == leader_b)  // Already the same group.
+    return true;
+
+  if ((*board)[leader_a].size < (*board)[leader_b].size) {
+    // Force group a's subtree to be bigger.
+    std::swap(leader_a, leader_b);
+  }
+
+  // Group b joins group a.
+  (*board)[leader_b].parent = leader_a;
+  (*board)[leader_a].size += (*board)[leader_b].size;
+  (*board)[leader_a].MergeGroupConnectivity((*board)[leader_b]);
+
+  return false;
+}
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_UNION_FIND_H_
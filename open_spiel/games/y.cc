@@ -16,9 +16,13 @@
 
 #include <algorithm>
 #include <memory>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
+#include "open_spiel/games/board_geometry.h"
+#include "open_spiel/games/zobrist.h"
+
 namespace open_spiel {
 namespace y_game {
 namespace {
@@ -44,7 +48,10 @@ const GameType kGameType{
          GameType::ParameterSpec{GameParameter::Type::kInt, false}},
         {"ansi_color_output",
          GameType::ParameterSpec{GameParameter::Type::kBool, false}},
-    }};
+    },
+    /*provides_undo=*/false,
+    /*provides_hash_value=*/true,
+    /*history_independent_state=*/true};
 
 std::unique_ptr<Game> Factory(const GameParameters& params) {
   return std::unique_ptr<Game>(new YGame(params));
@@ -70,32 +77,34 @@ constexpr std::array<Move, kMaxNeighbors> neighbor_offsets = {
     Move(-1, 1, kMoveOffset), Move(-1, 0, kMoveOffset),
 };
 
-// Precomputed list of neighbors per board_size: [board_size][cell][direction]
-std::vector<NeighborList> neighbor_list;
+// Geometry shared by all games of one board size: the list of neighbors per
+// cell and direction, plus the edge classification each cell is initialized
+// from.
+struct Geometry {
+  NeighborList neighbors;
+  std::vector<uint8_t> edge_mask;  // [cell] bitset, see Move::Edge.
+};
 
-NeighborList gen_neighbors(int board_size) {
-  NeighborList out;
-  out.resize(board_size * board_size);
+Geometry gen_geometry(int board_size) {
+  Geometry out;
+  out.neighbors.resize(board_size * board_size);
+  out.edge_mask.resize(board_size * board_size);
   for (int y = 0; y < board_size; y++) {
     for (int x = 0; x < board_size; x++) {
       int xy = x + y * board_size;  // Don't use Move.xy so it works off-board.
       for (int dir = 0; dir < neighbor_offsets.size(); dir++) {
         Move offset = neighbor_offsets[dir];
-        out[xy][dir] = Move(x + offset.x, y + offset.y, board_size);
+        out.neighbors[xy][dir] = Move(x + offset.x, y + offset.y, board_size);
       }
+      out.edge_mask[xy] = Move(x, y, board_size).Edge(board_size);
     }
   }
   return out;
 }
 
-const NeighborList& get_neighbors(int board_size) {
-  if (board_size >= neighbor_list.size()) {
-    neighbor_list.resize(board_size + 1);
-  }
-  if (neighbor_list[board_size].empty()) {
-    neighbor_list[board_size] = gen_neighbors(board_size);
-  }
-  return neighbor_list[board_size];
+const Geometry& get_geometry(int board_size) {
+  static BoardGeometryCache<Geometry> cache;
+  return cache.Get(board_size, gen_geometry);
 }
 
 }  // namespace
@@ -116,13 +125,14 @@ std::string Move::ToString() const {
 YState::YState(int board_size, bool ansi_color_output)
     : State(board_size * board_size, kNumPlayers),
       board_size_(board_size),
-      neighbors(get_neighbors(board_size)),
+      neighbors(get_geometry(board_size).neighbors),
       ansi_color_output_(ansi_color_output) {
+  const Geometry& geometry = get_geometry(board_size);
   board_.resize(board_size * board_size);
   for (int i = 0; i < board_.size(); i++) {
     Move m = ActionToMove(i);
     board_[i] = Cell((m.OnBoard() ? kPlayerNone : kPlayerInvalid), i,
-                     m.Edge(board_size));
+                     geometry.edge_mask[i]);
   }
 }
 
@@ -261,51 +271,32 @@ void YState::DoApplyAction(Action action) {
 
   for (const Move& m : neighbors[move.xy]) {
     if (m.OnBoard() && current_player_ == board_[m.xy].player) {
-      JoinGroups(move.xy, m.xy);
+      JoinGroups(&board_, move.xy, m.xy);
     }
   }
 
-  if (board_[FindGroupLeader(move.xy)].edge == 0x7) {  // ie all 3 edges.
+  if (board_[FindGroupLeader(&board_, move.xy)].edge == 0x7) {  // All 3 edges.
     outcome_ = current_player_;
   }
 
   current_player_ = (current_player_ == kPlayer1 ? kPlayer2 : kPlayer1);
 }
 
-int YState::FindGroupLeader(int cell) {
-  int parent = board_[cell].parent;
-  if (parent != cell) {
-    do {  // Follow the parent chain up to the group leader.
-      parent = board_[parent].parent;
-    } while (parent != board_[parent].parent);
-    // Do path compression, but only the current one to avoid recursion.
-    board_[cell].parent = parent;
-  }
-  return parent;
+std::unique_ptr<State> YState::Clone() const {
+  return std::unique_ptr<State>(new YState(*this));
 }
 
-bool YState::JoinGroups(int cell_a, int cell_b) {
-  int leader_a = FindGroupLeader(cell_a);
-  int leader_b = FindGroupLeader(cell_b);
-
-  if (leader_a == leader_b)  // Already the same group.
-    return true;
-
-  if (board_[leader_a].size < board_[leader_b].size) {
-    // Force group a's subtree to be bigger.
-    std::swap(leader_a, leader_b);
+uint64_t YState::HashValue() const {
+  // Only the stones matter: moves alternate and nothing is ever removed, so
+  // the mover is implied by the stone counts.
+  constexpr uint64_t kHashSeed = 0xa1c583f9d0427e6bULL;
+  uint64_t hash = 0;
+  for (int cell = 0; cell < board_.size(); ++cell) {
+    if (board_[cell].player == kPlayer1 || board_[cell].player == kPlayer2) {
+      hash ^= zobrist::ZobristValue(kHashSeed, cell * 2 + board_[cell].player);
+    }
   }
-
-  // Group b joins group a.
-  board_[leader_b].parent = leader_a;
-  board_[leader_a].size += board_[leader_b].size;
-  board_[leader_a].edge |= board_[leader_b].edge;
-
-  return false;
-}
-
-std::unique_ptr<State> YState::Clone() const {
-  return std::unique_ptr<State>(new YState(*this));
+  return hash;
 }
 
 YGame::YGame(const GameParameters& params)
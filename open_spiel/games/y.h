@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "open_spiel/games/union_find.h"
 #include "open_spiel/spiel.h"
 
 // https://en.wikipedia.org/wiki/Y_(game)
@@ -89,12 +90,11 @@ typedef std::vector<std::array<Move, kMaxNeighbors>> NeighborList;
 
 // State of an in-play game.
 class YState : public State {
-  // Represents a single cell on the board, as well as the structures needed for
-  // groups of cells. Groups of cells are defined by a union-find structure
-  // embedded in the array of cells. Following the `parent` indices will lead to
-  // the group leader which has the up to date size and edge
-  // connectivity of that group. Size and edge are not valid for any
-  // cell that is not a group leader.
+  // Represents a single cell on the board, as well as the structures needed
+  // for groups of cells, which are maintained with the shared union-find in
+  // games/union_find.h. Following the `parent` indices will lead to the group
+  // leader which has the up to date size and edge connectivity of that group.
+  // Size and edge are not valid for any cell that is not a group leader.
   struct Cell {
     // Who controls this cell.
     Player player;
@@ -104,13 +104,15 @@ class YState : public State {
     // from a direct parent to the leader.
     uint16_t parent;
 
-    // These three are only defined for the group leader's cell.
+    // These two are only defined for the group leader's cell.
     uint16_t size;  // Size of this group of cells.
     uint8_t edge;   // A bitset of which edges this group is connected to.
 
     Cell() {}
     Cell(Player player_, int parent_, int edge_)
         : player(player_), parent(parent_), size(1), edge(edge_) {}
+
+    void MergeGroupConnectivity(const Cell& other) { edge |= other.edge; }
   };
 
  public:
@@ -130,18 +132,12 @@ class YState : public State {
   void ObservationAsNormalizedVector(
       int player, std::vector<double>* values) const override;
   std::unique_ptr<State> Clone() const override;
+  uint64_t HashValue() const override;
   std::vector<Action> LegalActions() const override;
 
  protected:
   void DoApplyAction(Action action) override;
 
-  // Find the leader of the group. Not const due to union-find path compression.
-  int FindGroupLeader(int cell);
-
-  // Join the groups of two positions, propagating group size, and edge
-  // connections. Returns true if they were already the same group.
-  bool JoinGroups(int cell_a, int cell_b);
-
   // Turn an action id into a `Move` with an x,y.
   Move ActionToMove(Action action_id) const;
 
@@ -0,0 +1,114 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_GAMES_ZOBRIST_H_
+#define THIRD_PARTY_OPEN_SPIEL_GAMES_ZOBRIST_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace open_spiel {
+namespace zobrist {
+
+// Fixed-shape n-dimensional tables of pseudorandom numbers for Zobrist
+// hashing, shared by the games that hash their positions (chess, go).
+// Example:
+//   ZobristTable<uint64_t, 3, 4, 5> table(/*seed=*/12345);
+//
+//   table[a][b][c] is a random uint64_t where a < 3, b < 4, c < 5.
+//
+// The dimensions are part of the type, so the whole table is one contiguous
+// block of std::array storage: building it runs a SplitMix64 step per entry
+// and allocates nothing, unlike the former per-game tables of nested vectors
+// filled from a std::mt19937_64. Tables are typically function-local statics,
+// built on first use.
+
+// One SplitMix64 draw; advances *state.
+inline uint64_t SplitMix64(uint64_t* state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// A stateless draw: the Zobrist value for flat index `index` under `seed`,
+// computed on demand. Games whose board size is a runtime parameter use this
+// instead of a fixed-shape table.
+inline uint64_t ZobristValue(uint64_t seed, uint64_t index) {
+  uint64_t state = seed ^ (index * 0xff51afd7ed558ccdULL);
+  return SplitMix64(&state);
+}
+
+// Mixes a 64-bit word into a hash, for states kept as a few machine words
+// (bitboards, score counters) rather than per-cell contents.
+inline uint64_t MixHash(uint64_t hash, uint64_t value) {
+  uint64_t state = hash ^ (value * 0xc4ceb9fe1a85ec53ULL);
+  return SplitMix64(&state);
+}
+
+template <typename T, std::size_t InnerDim, std::size_t... OtherDims>
+class ZobristTable {
+ public:
+  using NestedTable = ZobristTable<T, OtherDims...>;
+
+  explicit ZobristTable(uint64_t seed) {
+    uint64_t state = seed;
+    Fill(&state);
+  }
+
+  const NestedTable& operator[](std::size_t index) const {
+    return data_[index];
+  }
+
+  // The nested-construction path: the enclosing dimension default-constructs
+  // its inner tables as std::array elements and fills them in one pass. The
+  // seeded constructor above is the entry point; a default-constructed table
+  // holds no random numbers until Fill runs.
+  ZobristTable() {}
+
+  void Fill(uint64_t* state) {
+    for (NestedTable& nested : data_) nested.Fill(state);
+  }
+
+ private:
+  std::array<NestedTable, InnerDim> data_;
+};
+
+// The innermost dimension holds the numbers themselves.
+template <typename T, std::size_t InnerDim>
+class ZobristTable<T, InnerDim> {
+ public:
+  explicit ZobristTable(uint64_t seed) {
+    uint64_t state = seed;
+    Fill(&state);
+  }
+
+  T operator[](std::size_t index) const { return data_[index]; }
+
+  // See the primary template: public for nested construction only.
+  ZobristTable() {}
+
+  void Fill(uint64_t* state) {
+    for (T& value : data_) value = static_cast<T>(SplitMix64(state));
+  }
+
+ private:
+  std::array<T, InnerDim> data_;
+};
+
+}  // namespace zobrist
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_GAMES_ZOBRIST_H_
@@ -91,6 +91,74 @@ std::unique_ptr<State> MatrixGame::NewInitialState() const {
   return std::unique_ptr<State>(new MatrixState(*this));
 }
 
+double MatrixGame::ExpectedUtility(
+    int player, const std::vector<double>& row_strategy,
+    const std::vector<double>& col_strategy) const {
+  SPIEL_CHECK_TRUE(player == 0 || player == 1);
+  SPIEL_CHECK_EQ(row_strategy.size(), NumRows());
+  SPIEL_CHECK_EQ(col_strategy.size(), NumCols());
+  const double* utilities = player == 0 ? row_data_ : col_data_;
+  const int num_cols = NumCols();
+  double value = 0;
+  for (int r = 0; r < NumRows(); ++r) {
+    const double row_weight = row_strategy[r];
+    if (row_weight == 0) continue;
+    const double* row = utilities + r * num_cols;
+    double row_value = 0;
+    for (int c = 0; c < num_cols; ++c) {
+      row_value += row[c] * col_strategy[c];
+    }
+    value += row_weight * row_value;
+  }
+  return value;
+}
+
+std::vector<double> MatrixGame::PureStrategyUtilities(
+    int player, const std::vector<double>& opponent_strategy) const {
+  SPIEL_CHECK_TRUE(player == 0 || player == 1);
+  const int num_rows = NumRows();
+  const int num_cols = NumCols();
+  if (player == 0) {
+    SPIEL_CHECK_EQ(opponent_strategy.size(), num_cols);
+    std::vector<double> values(num_rows, 0);
+    for (int r = 0; r < num_rows; ++r) {
+      const double* row = row_data_ + r * num_cols;
+      double row_value = 0;
+      for (int c = 0; c < num_cols; ++c) {
+        row_value += row[c] * opponent_strategy[c];
+      }
+      values[r] = row_value;
+    }
+    return values;
+  }
+  SPIEL_CHECK_EQ(opponent_strategy.size(), num_rows);
+  // x^T B accumulated row by row, so the inner loop still walks contiguous
+  // memory instead of striding down a column.
+  std::vector<double> values(num_cols, 0);
+  for (int r = 0; r < num_rows; ++r) {
+    const double row_weight = opponent_strategy[r];
+    if (row_weight == 0) continue;
+    const double* row = col_data_ + r * num_cols;
+    for (int c = 0; c < num_cols; ++c) {
+      values[c] += row_weight * row[c];
+    }
+  }
+  return values;
+}
+
+std::vector<double> MatrixGame::BatchExpectedUtility(
+    int player, const std::vector<std::vector<double>>& row_strategies,
+    const std::vector<std::vector<double>>& col_strategies) const {
+  SPIEL_CHECK_EQ(row_strategies.size(), col_strategies.size());
+  std::vector<double> values;
+  values.reserve(row_strategies.size());
+  for (int i = 0; i < row_strategies.size(); ++i) {
+    values.push_back(
+        ExpectedUtility(player, row_strategies[i], col_strategies[i]));
+  }
+  return values;
+}
+
 std::vector<double> FlattenMatrix(
     const std::vector<std::vector<double>>& matrix_rows) {
   std::vector<double> utilities;
@@ -46,7 +46,9 @@ class MatrixGame : public NormalFormGame {
         row_action_names_(row_action_names),
         col_action_names_(col_action_names),
         row_utilities_(row_utilities),
-        col_utilities_(col_utilities) {}
+        col_utilities_(col_utilities),
+        row_data_(row_utilities_.data()),
+        col_data_(col_utilities_.data()) {}
 
   MatrixGame(GameType game_type, GameParameters game_parameters,
              std::vector<std::string> row_action_names,
@@ -57,7 +59,39 @@ class MatrixGame : public NormalFormGame {
         row_action_names_(row_action_names),
         col_action_names_(col_action_names),
         row_utilities_(FlattenMatrix(row_utilities)),
-        col_utilities_(FlattenMatrix(col_utilities)) {}
+        col_utilities_(FlattenMatrix(col_utilities)),
+        row_data_(row_utilities_.data()),
+        col_data_(col_utilities_.data()) {}
+
+  // A game over externally owned row-major payoff tables (e.g. a
+  // memory-mapped file): nothing is copied, and the caller guarantees the
+  // storage outlives the game and every clone of it.
+  MatrixGame(GameType game_type, GameParameters game_parameters,
+             std::vector<std::string> row_action_names,
+             std::vector<std::string> col_action_names,
+             const double* row_utilities, const double* col_utilities)
+      : NormalFormGame(game_type, game_parameters),
+        row_action_names_(row_action_names),
+        col_action_names_(col_action_names),
+        row_data_(row_utilities),
+        col_data_(col_utilities) {}
+
+  // The data pointers follow the utility vectors when the game owns its
+  // payoffs, so copies cannot default to pointing into the source's storage.
+  MatrixGame(const MatrixGame& other)
+      : NormalFormGame(other),
+        row_action_names_(other.row_action_names_),
+        col_action_names_(other.col_action_names_),
+        row_utilities_(other.row_utilities_),
+        col_utilities_(other.col_utilities_),
+        row_data_(row_utilities_.empty() ? other.row_data_
+                                         : row_utilities_.data()),
+        col_data_(col_utilities_.empty() ? other.col_data_
+                                         : col_utilities_.data()) {}
+
+  // The implicit assignment would copy the raw pointers; games are shared via
+  // Clone() everywhere, so just forbid it.
+  MatrixGame& operator=(const MatrixGame&) = delete;
 
   // Implemwentation of Game interface
   int NumDistinctActions() const override {
@@ -69,15 +103,24 @@ class MatrixGame : public NormalFormGame {
   int NumPlayers() const override { return 2; }
 
   double MinUtility() const override {
-    return std::min(
-        *std::min_element(begin(row_utilities_), end(row_utilities_)),
-        *std::min_element(begin(col_utilities_), end(col_utilities_)));
+    const int size = NumRows() * NumCols();
+    return std::min(*std::min_element(row_data_, row_data_ + size),
+                    *std::min_element(col_data_, col_data_ + size));
   }
 
   double MaxUtility() const override {
-    return std::max(
-        *std::max_element(begin(row_utilities_), end(row_utilities_)),
-        *std::max_element(begin(col_utilities_), end(col_utilities_)));
+    const int size = NumRows() * NumCols();
+    return std::max(*std::max_element(row_data_, row_data_ + size),
+                    *std::max_element(col_data_, col_data_ + size));
+  }
+
+  double UtilitySum() const override {
+    if (GetType().utility == GameType::Utility::kZeroSum) return 0;
+    if (GetType().utility == GameType::Utility::kConstantSum) {
+      // Constant-sum: any cell gives the constant.
+      return row_data_[0] + col_data_[0];
+    }
+    return Game::UtilitySum();
   }
 
   std::unique_ptr<Game> Clone() const override {
@@ -88,16 +131,43 @@ class MatrixGame : public NormalFormGame {
   int NumRows() const { return row_action_names_.size(); }
   int NumCols() const { return col_action_names_.size(); }
   double RowUtility(int row, int col) const {
-    return row_utilities_[Index(row, col)];
+    return row_data_[Index(row, col)];
   }
   double ColUtility(int row, int col) const {
-    return col_utilities_[Index(row, col)];
+    return col_data_[Index(row, col)];
   }
   double PlayerUtility(int player, int row, int col) {
     SPIEL_CHECK_TRUE(player == 0 || player == 1);
-    return (player == 0 ? row_utilities_[Index(row, col)]
-                        : col_utilities_[Index(row, col)]);
+    return (player == 0 ? row_data_[Index(row, col)]
+                        : col_data_[Index(row, col)]);
   }
+  // The raw row-major payoff matrices (NumRows() * NumCols() entries each),
+  // for callers that run their own kernels over the contiguous storage.
+  const double* RowUtilities() const { return row_data_; }
+  const double* ColUtilities() const { return col_data_; }
+
+  // Expected utility of a mixed-strategy profile, u = x^T A y, where x and
+  // y are distributions over the rows and columns. The inner product walks
+  // one contiguous row of the payoff matrix at a time and skips rows with
+  // zero weight, so evaluating a profile is a few vectorizable passes rather
+  // than a double loop of scalar PlayerUtility calls.
+  double ExpectedUtility(int player, const std::vector<double>& row_strategy,
+                         const std::vector<double>& col_strategy) const;
+
+  // The expected utility of each of a player's pure strategies against a
+  // mixed opponent: A y for the row player, x^T B for the column player.
+  // Sweeps that evaluate many candidate mixtures against one opponent should
+  // compute this once; each candidate then costs a single dot product.
+  std::vector<double> PureStrategyUtilities(
+      int player, const std::vector<double>& opponent_strategy) const;
+
+  // Evaluates a batch of profiles in one call: profile i pairs
+  // row_strategies[i] with col_strategies[i] (the two vectors must have the
+  // same length), returning one expected utility per profile.
+  std::vector<double> BatchExpectedUtility(
+      int player, const std::vector<std::vector<double>>& row_strategies,
+      const std::vector<std::vector<double>>& col_strategies) const;
+
   const std::string& RowActionName(int row) const {
     return row_action_names_[row];
   }
@@ -109,8 +179,13 @@ class MatrixGame : public NormalFormGame {
   int Index(int row, int col) const { return row * NumCols() + col; }
   std::vector<std::string> row_action_names_;
   std::vector<std::string> col_action_names_;
+  // Owning storage; empty when the game wraps external payoff tables.
   std::vector<double> row_utilities_;
   std::vector<double> col_utilities_;
+  // All reads go through these; they point into the vectors above or into
+  // caller-owned (e.g. memory-mapped) storage.
+  const double* row_data_;
+  const double* col_data_;
 };
 
 class MatrixState : public NFGState {
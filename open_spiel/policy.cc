@@ -30,6 +30,15 @@ double GetProb(const ActionsAndProbs& action_and_probs, Action action) {
   return -1.0;
 }
 
+double GetProb(const SmallActionsAndProbs& action_and_probs, Action action) {
+  for (const auto& action_and_prob : action_and_probs) {
+    if (action_and_prob.first == action) {
+      return action_and_prob.second;
+    }
+  }
+  return -1.0;
+}
+
 TabularPolicy::TabularPolicy(const Game& game)
     : TabularPolicy(GetRandomPolicy(game)) {}
 
@@ -39,6 +48,11 @@ TabularPolicy GetEmptyTabularPolicy(const Game& game) {
     SpielFatalError("Game is not sequential.");
     return TabularPolicy(policy);
   }
+  // Size the table up front when the game declares its info state count,
+  // avoiding rehashes while it fills.
+  if (game.ExpectedNumInfoStates() > 0) {
+    policy.reserve(game.ExpectedNumInfoStates());
+  }
   std::list<std::unique_ptr<State>> to_visit;
   to_visit.push_back(game.NewInitialState());
   while (!to_visit.empty()) {
@@ -63,7 +77,7 @@ TabularPolicy GetEmptyTabularPolicy(const Game& game) {
       if (infostate_policy.empty()) {
         SpielFatalError("State has zero legal actions.");
       }
-      policy.insert({state->InformationState(), infostate_policy});
+      policy.insert({state->InformationStateKey(), infostate_policy});
     }
   }
   return TabularPolicy(policy);
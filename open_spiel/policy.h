@@ -73,7 +73,7 @@ class Policy {
   // Returns a list of (action, prob) pairs for the policy at this state.
   // If the policy is not available at the state, returns and empty list.
   virtual ActionsAndProbs GetStatePolicy(const State& state) const {
-    return GetStatePolicy(state.InformationState());
+    return GetStatePolicy(state.InformationStateKey());
   }
 
   // Returns a list of (action, prob) pairs for the policy at this info state.
@@ -83,6 +83,23 @@ class Policy {
   virtual ActionsAndProbs GetStatePolicy(const std::string& info_state) const {
     SpielFatalError("GetStatePolicy(const std::string&) unimplemented.");
   }
+
+  // Allocation-free variants: fill *out (clearing it first) instead of
+  // returning a freshly allocated vector, so a caller-owned buffer can be
+  // reused across lookups. The defaults go through the allocating overloads
+  // above; subclasses with direct table access should override the
+  // info-state form to copy straight into *out.
+  virtual void GetStatePolicy(const State& state,
+                              SmallActionsAndProbs* out) const {
+    GetStatePolicy(state.InformationStateKey(), out);
+  }
+  virtual void GetStatePolicy(const std::string& info_state,
+                              SmallActionsAndProbs* out) const {
+    out->clear();
+    for (const std::pair<Action, double>& pair : GetStatePolicy(info_state)) {
+      out->push_back(pair);
+    }
+  }
 };
 
 // A tabular policy represented internally as a map. Note that this
@@ -108,6 +125,17 @@ class TabularPolicy : public Policy {
     }
   }
 
+  // Copies straight from the table without constructing a temporary vector.
+  void GetStatePolicy(const std::string& info_state,
+                      SmallActionsAndProbs* out) const override {
+    out->clear();
+    auto iter = policy_table_.find(info_state);
+    if (iter == policy_table_.end()) return;
+    for (const std::pair<Action, double>& pair : iter->second) {
+      out->push_back(pair);
+    }
+  }
+
   std::unordered_map<std::string, ActionsAndProbs>& PolicyTable() {
     return policy_table_;
   }
@@ -118,6 +146,7 @@ class TabularPolicy : public Policy {
 
 // Returns the probability for the specified action, or -1 if not found.
 double GetProb(const ActionsAndProbs& action_and_probs, Action action);
+double GetProb(const SmallActionsAndProbs& action_and_probs, Action action);
 
 // Helper functions that generate policies for testing.
 TabularPolicy GetEmptyTabularPolicy(const Game& game);
@@ -0,0 +1,318 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/policy_compaction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+// Record format, one record per entry, all integers varints:
+//   header: (num_actions << 2) | mode
+//   actions: num_actions zigzag deltas from the previous action (from 0 for
+//            the first), so sorted action lists cost about a byte each.
+//   then, by mode:
+//     kDeterministic: index of the probability-one action.
+//     kUniform: nothing; every action has probability 1/num_actions.
+//     kNearUniform: count k, then k times (index, fixed 8-byte probability).
+//            The remaining actions have probability 1/num_actions, which is
+//            what classification certified them to be (up to tolerance).
+//     kExplicit: num_actions fixed 8-byte probabilities.
+enum RecordMode {
+  kDeterministic = 0,
+  kUniform = 1,
+  kNearUniform = 2,
+  kExplicit = 3,
+};
+
+uint64_t ZigzagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigzagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Fixed 8-byte little-endian IEEE encoding; varints would not round-trip
+// doubles.
+void AppendFixedDouble(double value, std::string* buffer) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    buffer->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+double ReadFixedDouble(const uint8_t* data, std::size_t size,
+                       std::size_t* offset) {
+  SPIEL_CHECK_LE(*offset + 8, size);
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; ++i) {
+    bits |= static_cast<uint64_t>(data[*offset + i]) << (8 * i);
+  }
+  *offset += 8;
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void EncodeEntry(const ActionsAndProbs& entry, double tolerance,
+                 std::string* records) {
+  const int num_actions = entry.size();
+  const double uniform_prob = 1.0 / num_actions;
+
+  // Classify: a single near-one probability is deterministic; all
+  // probabilities near 1/n is uniform; otherwise count the deviations from
+  // uniform and store them as deltas when that is cheaper than storing
+  // everything.
+  int one_index = -1;
+  bool is_uniform = true;
+  std::vector<int> deviating;
+  for (int i = 0; i < num_actions; ++i) {
+    const double prob = entry[i].second;
+    if (std::fabs(prob - 1.0) <= tolerance) one_index = i;
+    if (std::fabs(prob - uniform_prob) > tolerance) {
+      is_uniform = false;
+      deviating.push_back(i);
+    }
+  }
+
+  int mode;
+  if (one_index >= 0 && num_actions > 1) {
+    mode = kDeterministic;
+  } else if (is_uniform) {
+    mode = kUniform;
+  } else if (static_cast<int>(deviating.size()) * 10 < num_actions * 8) {
+    // A delta costs up to ~10 bytes (index varint plus probability) against
+    // 8 for an explicit probability.
+    mode = kNearUniform;
+  } else {
+    mode = kExplicit;
+  }
+
+  AppendVarint((static_cast<uint64_t>(num_actions) << 2) | mode, records);
+  Action previous = 0;
+  for (const std::pair<Action, double>& pair : entry) {
+    AppendVarint(ZigzagEncode(pair.first - previous), records);
+    previous = pair.first;
+  }
+  switch (mode) {
+    case kDeterministic:
+      AppendVarint(one_index, records);
+      break;
+    case kUniform:
+      break;
+    case kNearUniform:
+      AppendVarint(deviating.size(), records);
+      for (int index : deviating) {
+        AppendVarint(index, records);
+        AppendFixedDouble(entry[index].second, records);
+      }
+      break;
+    default:
+      for (const std::pair<Action, double>& pair : entry) {
+        AppendFixedDouble(pair.second, records);
+      }
+      break;
+  }
+}
+
+ActionsAndProbs DecodeEntry(const uint8_t* data, std::size_t size,
+                            std::size_t offset) {
+  const uint64_t header = ReadVarint(data, size, &offset);
+  const int num_actions = header >> 2;
+  const int mode = header & 3;
+
+  ActionsAndProbs entry;
+  entry.reserve(num_actions);
+  Action previous = 0;
+  for (int i = 0; i < num_actions; ++i) {
+    previous += ZigzagDecode(ReadVarint(data, size, &offset));
+    entry.push_back({previous, 0.0});
+  }
+  switch (mode) {
+    case kDeterministic: {
+      const int one_index = ReadVarint(data, size, &offset);
+      SPIEL_CHECK_LT(one_index, num_actions);
+      entry[one_index].second = 1.0;
+      break;
+    }
+    case kUniform: {
+      const double uniform_prob = 1.0 / num_actions;
+      for (int i = 0; i < num_actions; ++i) entry[i].second = uniform_prob;
+      break;
+    }
+    case kNearUniform: {
+      const double uniform_prob = 1.0 / num_actions;
+      for (int i = 0; i < num_actions; ++i) entry[i].second = uniform_prob;
+      const int num_deviating = ReadVarint(data, size, &offset);
+      SPIEL_CHECK_LT(num_deviating, num_actions);
+      for (int d = 0; d < num_deviating; ++d) {
+        const int index = ReadVarint(data, size, &offset);
+        SPIEL_CHECK_LT(index, num_actions);
+        entry[index].second = ReadFixedDouble(data, size, &offset);
+      }
+      break;
+    }
+    default:
+      for (int i = 0; i < num_actions; ++i) {
+        entry[i].second = ReadFixedDouble(data, size, &offset);
+      }
+      break;
+  }
+  return entry;
+}
+
+}  // namespace
+
+CompactTabularPolicy::CompactTabularPolicy(
+    const std::unordered_map<std::string, ActionsAndProbs>& table,
+    double tolerance) {
+  SPIEL_CHECK_GE(tolerance, 0);
+  std::vector<const std::string*> keys;
+  keys.reserve(table.size());
+  for (const auto& entry : table) {
+    keys.push_back(&entry.first);
+  }
+  std::sort(keys.begin(), keys.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  key_offsets_.reserve(keys.size() + 1);
+  record_offsets_.reserve(keys.size() + 1);
+  for (const std::string* key : keys) {
+    key_offsets_.push_back(keys_.size());
+    record_offsets_.push_back(records_.size());
+    keys_.append(*key);
+    EncodeEntry(table.at(*key), tolerance, &records_);
+  }
+  key_offsets_.push_back(keys_.size());
+  record_offsets_.push_back(records_.size());
+}
+
+CompactTabularPolicy::CompactTabularPolicy(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    SpielFatalError("Could not open compact policy file: " + filename);
+  }
+  std::string buffer((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer.data());
+  const std::size_t size = buffer.size();
+  if (size < 2 * sizeof(uint32_t)) {
+    SpielFatalError("Compact policy file too small: " + filename);
+  }
+  uint32_t magic, version;
+  std::memcpy(&magic, data, sizeof(magic));
+  std::memcpy(&version, data + sizeof(magic), sizeof(version));
+  if (magic != kCompactPolicyFileMagic) {
+    SpielFatalError("Not a compact policy file: " + filename);
+  }
+  if (version != kCompactPolicyFileVersion) {
+    SpielFatalError("Unsupported compact policy file version in: " + filename);
+  }
+
+  // The offset tables are stored as varint-coded lengths; the cumulative
+  // sums are rebuilt here.
+  std::size_t offset = 2 * sizeof(uint32_t);
+  const uint64_t num_entries = ReadVarint(data, size, &offset);
+  key_offsets_.reserve(num_entries + 1);
+  record_offsets_.reserve(num_entries + 1);
+  uint64_t key_offset = 0;
+  uint64_t record_offset = 0;
+  key_offsets_.push_back(0);
+  record_offsets_.push_back(0);
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    key_offset += ReadVarint(data, size, &offset);
+    record_offset += ReadVarint(data, size, &offset);
+    key_offsets_.push_back(key_offset);
+    record_offsets_.push_back(record_offset);
+  }
+  if (offset + record_offset + key_offset != size) {
+    SpielFatalError("Compact policy file has inconsistent sizes: " + filename);
+  }
+  records_.assign(buffer, offset, record_offset);
+  keys_.assign(buffer, offset + record_offset, key_offset);
+}
+
+void CompactTabularPolicy::Save(const std::string& filename) const {
+  std::string buffer;
+  char header[2 * sizeof(uint32_t)];
+  std::memcpy(header, &kCompactPolicyFileMagic, sizeof(uint32_t));
+  std::memcpy(header + sizeof(uint32_t), &kCompactPolicyFileVersion,
+              sizeof(uint32_t));
+  buffer.append(header, sizeof(header));
+  AppendVarint(num_entries(), &buffer);
+  for (std::size_t i = 0; i < num_entries(); ++i) {
+    AppendVarint(key_offsets_[i + 1] - key_offsets_[i], &buffer);
+    AppendVarint(record_offsets_[i + 1] - record_offsets_[i], &buffer);
+  }
+  buffer.append(records_);
+  buffer.append(keys_);
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open compact policy file for writing: " +
+                    filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write compact policy file: " + filename);
+  }
+}
+
+int CompactTabularPolicy::FindEntry(const std::string& info_state) const {
+  // Binary search over the sorted key blob, as in FrozenTabularPolicy.
+  std::size_t lo = 0;
+  std::size_t hi = num_entries();
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const char* key = keys_.data() + key_offsets_[mid];
+    const std::size_t key_size = key_offsets_[mid + 1] - key_offsets_[mid];
+    const int cmp = std::memcmp(key, info_state.data(),
+                                std::min<std::size_t>(key_size,
+                                                      info_state.size()));
+    if (cmp < 0 || (cmp == 0 && key_size < info_state.size())) {
+      lo = mid + 1;
+    } else if (cmp > 0 || key_size > info_state.size()) {
+      hi = mid;
+    } else {
+      return mid;
+    }
+  }
+  return -1;
+}
+
+ActionsAndProbs CompactTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  const int index = FindEntry(info_state);
+  if (index < 0) return {};
+  return DecodeEntry(reinterpret_cast<const uint8_t*>(records_.data()),
+                     records_.size(), record_offsets_[index]);
+}
+
+std::size_t CompactTabularPolicy::ApproxBytes() const {
+  return keys_.size() + records_.size() +
+         (key_offsets_.size() + record_offsets_.size()) * sizeof(uint64_t);
+}
+
+}  // namespace open_spiel
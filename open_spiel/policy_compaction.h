@@ -0,0 +1,96 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_POLICY_COMPACTION_H_
+#define THIRD_PARTY_OPEN_SPIEL_POLICY_COMPACTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// A compacted, read-only representation of a tabular policy. Solved policies
+// are mostly boring: at the vast majority of information states the average
+// policy has collapsed to a single action or stayed (near-)uniform, yet a
+// TabularPolicy (and the frozen policy file, see policy_file.h) spends a
+// full probability per action on every one of them. The compaction pass
+// classifies each entry and encodes it accordingly:
+//   - deterministic: one action holds all the probability; only the action
+//     list and the chosen index are stored.
+//   - uniform: every action within `tolerance` of 1/n; only the action list
+//     is stored.
+//   - near-uniform: a few actions deviate from 1/n by more than `tolerance`;
+//     the deviating probabilities are stored as (index, value) deltas and
+//     the rest come back as exactly 1/n.
+//   - explicit: anything else, stored in full.
+// Action lists are delta-coded varints, so consecutive action ids cost one
+// byte each. Entries a lookup must reconstruct exactly (up to `tolerance`
+// per probability) are decoded on the fly; keys are resolved by binary
+// search over a sorted key blob, as in FrozenTabularPolicy.
+//
+// With tolerance = 0 the compaction is lossless. A small tolerance (e.g.
+// 1e-6) additionally snaps the near-converged entries of a CFR average
+// policy onto the deterministic and uniform classes, which is where the
+// large size reductions come from; the induced policy differs from the
+// source by at most the tolerance per probability.
+
+namespace open_spiel {
+
+constexpr uint32_t kCompactPolicyFileMagic = 0x4350534f;  // "OSPC", LE.
+constexpr uint32_t kCompactPolicyFileVersion = 1;
+
+class CompactTabularPolicy : public Policy {
+ public:
+  // Compacts `table` with the classification above.
+  explicit CompactTabularPolicy(
+      const std::unordered_map<std::string, ActionsAndProbs>& table,
+      double tolerance = 0);
+
+  // Loads a policy written by Save. Calls SpielFatalError if the file cannot
+  // be read or is not a compact policy file.
+  explicit CompactTabularPolicy(const std::string& filename);
+
+  // Writes the policy to filename, replacing any existing file. Calls
+  // SpielFatalError if the file cannot be written.
+  void Save(const std::string& filename) const;
+
+  // Returns the entry for the info state, or an empty list if not present.
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+
+  std::size_t num_entries() const { return key_offsets_.size() - 1; }
+
+  // Bytes held by the encoded representation (keys, records and offset
+  // tables); the basis of the size-reduction numbers.
+  std::size_t ApproxBytes() const;
+
+ private:
+  // Index of the entry for the key, or -1 if not present.
+  int FindEntry(const std::string& info_state) const;
+
+  // Offset tables have num_entries() + 1 elements; entry i's key occupies
+  // keys_[key_offsets_[i], key_offsets_[i+1]) and its record
+  // records_[record_offsets_[i], record_offsets_[i+1]).
+  std::vector<uint64_t> key_offsets_;
+  std::vector<uint64_t> record_offsets_;
+  std::string keys_;     // Sorted, concatenated.
+  std::string records_;  // Encoded entries, see the .cc for the format.
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_POLICY_COMPACTION_H_
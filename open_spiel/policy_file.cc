@@ -0,0 +1,192 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/policy_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+// File layout, in order. All fields are little-endian and every 8-byte field
+// is 8-byte aligned (the header is 16 bytes and both offset tables and blobs
+// have 8-byte elements; the byte-aligned keys come last).
+//   uint32 magic, uint32 version, uint64 num_entries
+//   uint64 key_offsets[num_entries + 1]    (into the key blob)
+//   uint64 pair_offsets[num_entries + 1]   (into the action/prob blobs)
+//   int64  actions[total_pairs]
+//   double probs[total_pairs]
+//   char   keys[]                          (sorted, concatenated)
+
+template <typename T>
+void AppendRaw(T value, std::string* buffer) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  buffer->append(bytes, sizeof(T));
+}
+
+}  // namespace
+
+void WritePolicyFile(
+    const std::string& filename,
+    const std::unordered_map<std::string, ActionsAndProbs>& table) {
+  std::vector<const std::string*> keys;
+  keys.reserve(table.size());
+  for (const auto& entry : table) {
+    keys.push_back(&entry.first);
+  }
+  std::sort(keys.begin(), keys.end(),
+            [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  std::string buffer;
+  AppendRaw<uint32_t>(kPolicyFileMagic, &buffer);
+  AppendRaw<uint32_t>(kPolicyFileVersion, &buffer);
+  AppendRaw<uint64_t>(keys.size(), &buffer);
+
+  uint64_t key_offset = 0;
+  for (const std::string* key : keys) {
+    AppendRaw<uint64_t>(key_offset, &buffer);
+    key_offset += key->size();
+  }
+  AppendRaw<uint64_t>(key_offset, &buffer);
+
+  uint64_t pair_offset = 0;
+  for (const std::string* key : keys) {
+    AppendRaw<uint64_t>(pair_offset, &buffer);
+    pair_offset += table.at(*key).size();
+  }
+  AppendRaw<uint64_t>(pair_offset, &buffer);
+
+  for (const std::string* key : keys) {
+    for (const auto& action_and_prob : table.at(*key)) {
+      AppendRaw<int64_t>(action_and_prob.first, &buffer);
+    }
+  }
+  for (const std::string* key : keys) {
+    for (const auto& action_and_prob : table.at(*key)) {
+      AppendRaw<double>(action_and_prob.second, &buffer);
+    }
+  }
+  for (const std::string* key : keys) {
+    buffer.append(*key);
+  }
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    SpielFatalError("Could not open policy file for writing: " + filename);
+  }
+  file.write(buffer.data(), buffer.size());
+  file.flush();
+  if (!file) {
+    SpielFatalError("Could not write policy file: " + filename);
+  }
+}
+
+FrozenTabularPolicy::FrozenTabularPolicy(const std::string& filename) {
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    SpielFatalError("Could not open policy file: " + filename);
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    SpielFatalError("Could not stat policy file: " + filename);
+  }
+  size_ = file_stat.st_size;
+  if (size_ < 2 * sizeof(uint32_t) + sizeof(uint64_t)) {
+    SpielFatalError("Policy file too small: " + filename);
+  }
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    SpielFatalError("Could not map policy file: " + filename);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+
+  uint32_t magic, version;
+  std::memcpy(&magic, data_, sizeof(magic));
+  std::memcpy(&version, data_ + sizeof(magic), sizeof(version));
+  if (magic != kPolicyFileMagic) {
+    SpielFatalError("Not a policy file: " + filename);
+  }
+  if (version != kPolicyFileVersion) {
+    SpielFatalError("Unsupported policy file version in: " + filename);
+  }
+  uint64_t num_entries;
+  std::memcpy(&num_entries, data_ + 2 * sizeof(uint32_t), sizeof(num_entries));
+  num_entries_ = num_entries;
+
+  const uint8_t* cursor = data_ + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+  key_offsets_ = reinterpret_cast<const uint64_t*>(cursor);
+  cursor += (num_entries_ + 1) * sizeof(uint64_t);
+  pair_offsets_ = reinterpret_cast<const uint64_t*>(cursor);
+  cursor += (num_entries_ + 1) * sizeof(uint64_t);
+  actions_ = reinterpret_cast<const Action*>(cursor);
+  cursor += pair_offsets_[num_entries_] * sizeof(int64_t);
+  probs_ = reinterpret_cast<const double*>(cursor);
+  cursor += pair_offsets_[num_entries_] * sizeof(double);
+  keys_ = reinterpret_cast<const char*>(cursor);
+  if (cursor + key_offsets_[num_entries_] != data_ + size_) {
+    SpielFatalError("Policy file has inconsistent sizes: " + filename);
+  }
+}
+
+FrozenTabularPolicy::~FrozenTabularPolicy() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+ActionsAndProbs FrozenTabularPolicy::GetStatePolicy(
+    const std::string& info_state) const {
+  // Binary search over the sorted key blob.
+  std::size_t lo = 0;
+  std::size_t hi = num_entries_;
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    const char* key = keys_ + key_offsets_[mid];
+    const std::size_t key_size = key_offsets_[mid + 1] - key_offsets_[mid];
+    const int cmp = std::memcmp(key, info_state.data(),
+                                std::min<std::size_t>(key_size,
+                                                      info_state.size()));
+    if (cmp < 0 || (cmp == 0 && key_size < info_state.size())) {
+      lo = mid + 1;
+    } else if (cmp > 0 || key_size > info_state.size()) {
+      hi = mid;
+    } else {
+      ActionsAndProbs actions_and_probs;
+      const uint64_t begin = pair_offsets_[mid];
+      const uint64_t end = pair_offsets_[mid + 1];
+      actions_and_probs.reserve(end - begin);
+      for (uint64_t i = begin; i < end; ++i) {
+        actions_and_probs.push_back({actions_[i], probs_[i]});
+      }
+      return actions_and_probs;
+    }
+  }
+  return {};
+}
+
+}  // namespace open_spiel
@@ -0,0 +1,84 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_POLICY_FILE_H_
+#define THIRD_PARTY_OPEN_SPIEL_POLICY_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "open_spiel/policy.h"
+#include "open_spiel/spiel.h"
+
+// A frozen, read-only file representation of a tabular policy. A TabularPolicy
+// holds an unordered_map built in process, which for very large solved
+// policies takes minutes to load and as much memory again as the file.
+// The policy file instead lays the whole table out so lookups can run
+// directly on the mapped bytes: a fixed header, then the entry boundaries
+// (offsets into the key and action/probability blobs), then the actions and
+// probabilities of all entries as two contiguous arrays, then the keys,
+// sorted, concatenated. A FrozenTabularPolicy memory-maps the file and
+// resolves an info state with a binary search over the sorted keys, so
+// opening a multi-gigabyte policy costs only the mmap call, and the pages
+// are shared between processes using the same file.
+
+namespace open_spiel {
+
+// Shared with the streaming writers (see algorithms/policy_export.h), which
+// must emit byte-identical headers.
+constexpr uint32_t kPolicyFileMagic = 0x4c50534f;  // "OSPL", little-endian.
+constexpr uint32_t kPolicyFileVersion = 1;
+
+// Writes the table to filename in the format above, replacing any existing
+// file. Calls SpielFatalError if the file cannot be written.
+void WritePolicyFile(
+    const std::string& filename,
+    const std::unordered_map<std::string, ActionsAndProbs>& table);
+
+// A read-only Policy backed by a memory-mapped policy file. Lookups copy
+// only the entry they return; the table itself is never loaded.
+class FrozenTabularPolicy : public Policy {
+ public:
+  // Maps filename. Calls SpielFatalError if the file cannot be opened or is
+  // not a policy file.
+  explicit FrozenTabularPolicy(const std::string& filename);
+  ~FrozenTabularPolicy() override;
+
+  FrozenTabularPolicy(const FrozenTabularPolicy&) = delete;
+  FrozenTabularPolicy& operator=(const FrozenTabularPolicy&) = delete;
+
+  // Returns the entry for the info state, or an empty list if not present.
+  ActionsAndProbs GetStatePolicy(const std::string& info_state) const override;
+
+  std::size_t num_entries() const { return num_entries_; }
+
+ private:
+  int fd_ = -1;
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+
+  // Pointers into the mapping, set once in the constructor.
+  std::size_t num_entries_ = 0;
+  const uint64_t* key_offsets_ = nullptr;   // num_entries_ + 1 entries.
+  const uint64_t* pair_offsets_ = nullptr;  // num_entries_ + 1 entries.
+  const Action* actions_ = nullptr;
+  const double* probs_ = nullptr;
+  const char* keys_ = nullptr;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_POLICY_FILE_H_
@@ -12,8 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
+#include "open_spiel/algorithms/batched_simulator.h"
 #include "open_spiel/algorithms/evaluate_bots.h"
 #include "open_spiel/algorithms/matrix_game_utils.h"
 #include "open_spiel/algorithms/tabular_exploitability.h"
@@ -25,6 +29,7 @@
 #include "open_spiel/spiel.h"
 #include "open_spiel/spiel_bots.h"
 #include "open_spiel/spiel_utils.h"
+#include "pybind11/include/pybind11/numpy.h"
 #include "pybind11/include/pybind11/pybind11.h"
 #include "pybind11/include/pybind11/stl.h"
 
@@ -36,8 +41,59 @@ using ::open_spiel::algorithms::NashConv;
 using ::open_spiel::algorithms::TabularBestResponse;
 using ::open_spiel::matrix_game::MatrixGame;
 
+
 namespace py = ::pybind11;
 
+// Copies a rectangular [B][T] nested vector into a numpy array in a single
+// C++ pass, instead of marshalling nested Python lists element by element.
+// Call resize_fields on the trajectory first so the rows really are
+// rectangular.
+template <typename Out, typename T>
+py::array_t<Out> ToArray2D(const std::vector<std::vector<T>>& data) {
+  const py::ssize_t b = data.size();
+  const py::ssize_t t = b > 0 ? data[0].size() : 0;
+  py::array_t<Out> out(std::vector<py::ssize_t>{b, t});
+  Out* dst = out.mutable_data();
+  for (const std::vector<T>& row : data) {
+    for (std::size_t i = 0; i < row.size(); ++i) {
+      *dst++ = static_cast<Out>(row[i]);
+    }
+  }
+  return out;
+}
+
+// Moves a C++ vector into a numpy array that takes ownership of it, so the
+// binding hands the data across without a per-element conversion or copy.
+template <typename T>
+py::array_t<T> MoveToArray(std::vector<T>&& values) {
+  auto* held = new std::vector<T>(std::move(values));
+  py::capsule base(held, [](void* p) {
+    delete reinterpret_cast<std::vector<T>*>(p);
+  });
+  return py::array_t<T>(
+      std::vector<py::ssize_t>{static_cast<py::ssize_t>(held->size())},
+      held->data(), base);
+}
+
+// As above, for [B][T][N] nested vectors.
+template <typename Out, typename T>
+py::array_t<Out> ToArray3D(
+    const std::vector<std::vector<std::vector<T>>>& data) {
+  const py::ssize_t b = data.size();
+  const py::ssize_t t = b > 0 ? data[0].size() : 0;
+  const py::ssize_t n = t > 0 ? data[0][0].size() : 0;
+  py::array_t<Out> out(std::vector<py::ssize_t>{b, t, n});
+  Out* dst = out.mutable_data();
+  for (const auto& rows : data) {
+    for (const std::vector<T>& row : rows) {
+      for (std::size_t i = 0; i < row.size(); ++i) {
+        *dst++ = static_cast<Out>(row[i]);
+      }
+    }
+  }
+  return out;
+}
+
 // This exception class is used to forward errors from Spiel to Python.
 // Do not create exceptions of this type directly! Instead, call
 // SpielFatalError, which will raise a Python exception when called from
@@ -217,6 +273,73 @@ PYBIND11_MODULE(pyspiel, m) {
       .def("observation_as_normalized_vector",
            (std::vector<double>(State::*)() const) &
                State::ObservationAsNormalizedVector)
+      // Numpy variants of the observation accessors: the data is computed
+      // into a C++ vector whose ownership moves to the returned array, so
+      // nothing is converted element by element. The *_vector(player, out)
+      // overloads write into a preallocated 1-d float64 (or int32 for the
+      // mask) array instead, which must have at least the size reported by
+      // the game; nothing is allocated on that path.
+      .def("observation_as_normalized_array",
+           [](const State& state, int player) {
+             return MoveToArray<double>(
+                 state.ObservationAsNormalizedVector(player));
+           })
+      .def("observation_as_normalized_array",
+           [](const State& state) {
+             return MoveToArray<double>(
+                 state.ObservationAsNormalizedVector());
+           })
+      .def("information_state_as_normalized_array",
+           [](const State& state, int player) {
+             return MoveToArray<double>(
+                 state.InformationStateAsNormalizedVector(player));
+           })
+      .def("information_state_as_normalized_array",
+           [](const State& state) {
+             return MoveToArray<double>(
+                 state.InformationStateAsNormalizedVector());
+           })
+      .def("legal_actions_mask_array",
+           [](const State& state, int player) {
+             return MoveToArray<int>(state.LegalActionsMask(player));
+           })
+      .def("legal_actions_mask_array",
+           [](const State& state) {
+             // Current-player masks go through the bitset fast path, which
+             // games with bitboard move legality fill without generating a
+             // move list. The bitset does not cover flattened joint
+             // actions, so simultaneous nodes keep the old path.
+             if (state.IsSimultaneousNode()) {
+               return MoveToArray<int>(state.LegalActionsMask());
+             }
+             std::vector<uint64_t> words(state.LegalActionsBitsetWords());
+             state.LegalActionsBitset(words.data());
+             std::vector<int> mask(state.NumDistinctActions());
+             for (int a = 0; a < mask.size(); ++a) {
+               mask[a] = (words[a / 64] >> (a % 64)) & 1;
+             }
+             return MoveToArray<int>(std::move(mask));
+           })
+      .def("observation_as_normalized_vector",
+           [](const State& state, int player,
+              py::array_t<double, py::array::c_style> out) {
+             state.ObservationAsNormalizedVector(player, out.mutable_data());
+           })
+      .def("information_state_as_normalized_vector",
+           [](const State& state, int player,
+              py::array_t<double, py::array::c_style> out) {
+             state.InformationStateAsNormalizedVector(player,
+                                                      out.mutable_data());
+           })
+      .def("legal_actions_mask",
+           [](const State& state, int player,
+              py::array_t<int, py::array::c_style> out) {
+             int* data = out.mutable_data();
+             std::fill(data, data + out.size(), 0);
+             for (open_spiel::Action action : state.LegalActions(player)) {
+               data[action] = 1;
+             }
+           })
       .def("clone", &State::Clone)
       .def("child", &State::Child)
       .def("undo_action", &State::UndoAction)
@@ -317,7 +440,8 @@ PYBIND11_MODULE(pyspiel, m) {
       .def(py::init<const Game&, const std::unordered_map<std::string, int>&,
                     int>())
       .def("record_batch",
-           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch);
+           &open_spiel::algorithms::TrajectoryRecorder::RecordBatch,
+           py::call_guard<py::gil_scoped_release>());
 
   m.def("create_matrix_game",
         (std::unique_ptr<MatrixGame>(*)(
@@ -452,15 +576,164 @@ PYBIND11_MODULE(pyspiel, m) {
           "max_trajectory_length",
           &open_spiel::algorithms::BatchedTrajectory::max_trajectory_length)
       .def("resize_fields",
-           &open_spiel::algorithms::BatchedTrajectory::ResizeFields);
+           &open_spiel::algorithms::BatchedTrajectory::ResizeFields)
+      // One-pass numpy exports of the padded fields. Call resize_fields
+      // first; these copy in C++ instead of building nested Python lists.
+      .def("observations_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray3D<float>(t.observations);
+           })
+      .def("legal_actions_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray3D<int>(t.legal_actions);
+           })
+      .def("actions_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<std::int64_t>(t.actions);
+           })
+      .def("player_policies_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray3D<double>(t.player_policies);
+           })
+      .def("player_ids_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<int>(t.player_ids);
+           })
+      .def("state_indices_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<int>(t.state_indices);
+           })
+      .def("rewards_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<double>(t.rewards);
+           })
+      .def("valid_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<bool>(t.valid);
+           })
+      .def("next_is_terminal_array",
+           [](const open_spiel::algorithms::BatchedTrajectory& t) {
+             return ToArray2D<bool>(t.next_is_terminal);
+           });
 
   m.def("record_batched_trajectories",
         (open_spiel::algorithms::BatchedTrajectory(*)(
             const Game&, const std::vector<open_spiel::TabularPolicy>&,
-            const std::unordered_map<std::string, int>&, int, bool, int,
-            int))open_spiel::algorithms::RecordBatchedTrajectory,
+            const std::unordered_map<std::string, int>&, int, bool, int, int,
+            int, bool))open_spiel::algorithms::RecordBatchedTrajectory,
+        py::call_guard<py::gil_scoped_release>(),
         "Records a batch of trajectories.");
 
+  // The batch of environments advances fully inside C++ with the GIL
+  // released; the buffer accessors return numpy views of the simulator's
+  // flat arrays without copying.
+  py::class_<open_spiel::algorithms::BatchedSimulator>(m, "BatchedSimulator")
+      .def(py::init<const Game&, int, int>(), py::arg("game"),
+           py::arg("batch_size"), py::arg("seed") = 0,
+           py::keep_alive<1, 2>())
+      .def("batch_size", &open_spiel::algorithms::BatchedSimulator::batch_size)
+      .def("observation_size",
+           &open_spiel::algorithms::BatchedSimulator::observation_size)
+      .def("num_distinct_actions",
+           &open_spiel::algorithms::BatchedSimulator::num_distinct_actions)
+      .def("reset", &open_spiel::algorithms::BatchedSimulator::Reset,
+           py::call_guard<py::gil_scoped_release>())
+      .def("step_all", &open_spiel::algorithms::BatchedSimulator::StepAll,
+           py::call_guard<py::gil_scoped_release>())
+      .def("observations",
+           [](py::object self) {
+             auto& sim =
+                 self.cast<open_spiel::algorithms::BatchedSimulator&>();
+             return py::array_t<double>(
+                 std::vector<py::ssize_t>{sim.batch_size(),
+                                          sim.observation_size()},
+                 sim.observations().data(), self);
+           })
+      .def("legal_masks",
+           [](py::object self) {
+             auto& sim =
+                 self.cast<open_spiel::algorithms::BatchedSimulator&>();
+             return py::array_t<int>(
+                 std::vector<py::ssize_t>{sim.batch_size(),
+                                          sim.num_distinct_actions()},
+                 sim.legal_masks().data(), self);
+           })
+      .def("current_players",
+           [](py::object self) {
+             auto& sim =
+                 self.cast<open_spiel::algorithms::BatchedSimulator&>();
+             return py::array_t<int>(
+                 std::vector<py::ssize_t>{sim.batch_size()},
+                 sim.current_players().data(), self);
+           })
+      .def("rewards",
+           [](py::object self) {
+             auto& sim =
+                 self.cast<open_spiel::algorithms::BatchedSimulator&>();
+             return py::array_t<double>(
+                 std::vector<py::ssize_t>{
+                     sim.batch_size(),
+                     static_cast<py::ssize_t>(sim.rewards().size()) /
+                         sim.batch_size()},
+                 sim.rewards().data(), self);
+           })
+      .def("episode_ended",
+           &open_spiel::algorithms::BatchedSimulator::episode_ended)
+      .def("state", &open_spiel::algorithms::BatchedSimulator::state,
+           py::return_value_policy::reference_internal);
+
+  m.def("batch_observation_normalized_vectors",
+        [](const Game& game, const std::vector<const State*>& states) {
+          py::array_t<double> out(std::vector<py::ssize_t>{
+              static_cast<py::ssize_t>(states.size()),
+              game.ObservationNormalizedVectorSize()});
+          {
+            py::gil_scoped_release release;
+            game.BatchObservationNormalizedVectors(states,
+                                                   out.mutable_data());
+          }
+          return out;
+        },
+        "Fills one [num_states, observation_size] numpy array with the "
+        "normalized observations of the given states, with the GIL "
+        "released.");
+
+  m.def("batch_information_state_normalized_vectors",
+        [](const Game& game, const std::vector<const State*>& states) {
+          py::array_t<double> out(std::vector<py::ssize_t>{
+              static_cast<py::ssize_t>(states.size()),
+              game.InformationStateNormalizedVectorSize()});
+          {
+            py::gil_scoped_release release;
+            game.BatchInformationStateNormalizedVectors(states,
+                                                        out.mutable_data());
+          }
+          return out;
+        },
+        "Fills one [num_states, information_state_size] numpy array with "
+        "the normalized information states of the given states, with the "
+        "GIL released.");
+
+  m.def("batch_legal_actions_masks",
+        [](const Game& game, const std::vector<const State*>& states) {
+          const py::ssize_t num_actions = game.NumDistinctActions();
+          py::array_t<int> out(std::vector<py::ssize_t>{
+              static_cast<py::ssize_t>(states.size()), num_actions});
+          int* data = out.mutable_data();
+          {
+            py::gil_scoped_release release;
+            std::fill(data, data + states.size() * num_actions, 0);
+            for (std::size_t i = 0; i < states.size(); ++i) {
+              for (open_spiel::Action action : states[i]->LegalActions()) {
+                data[i * num_actions + action] = 1;
+              }
+            }
+          }
+          return out;
+        },
+        "Fills one [num_states, num_distinct_actions] 0/1 numpy mask of the "
+        "legal actions of the given states, with the GIL released.");
+
   // Set an error handler that will raise exceptions. These exceptions are for
   // the Python interface only. When used from C++, OpenSpiel will never raise
   // exceptions - the process will be terminated instead.
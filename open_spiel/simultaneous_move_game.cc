@@ -39,7 +39,16 @@ void SimMoveState::ApplyFlatJointAction(Action flat_action) {
   ApplyActions(FlatJointActionToActions(flat_action));
 }
 
-std::vector<Action> SimMoveState::LegalFlatJointActions() const {
+std::vector<std::vector<Action>> SimMoveState::LegalActionsByPlayer() const {
+  std::vector<std::vector<Action>> legal_actions;
+  legal_actions.reserve(num_players_);
+  for (int player = 0; player < num_players_; ++player) {
+    legal_actions.push_back(LegalActions(player));
+  }
+  return legal_actions;
+}
+
+int SimMoveState::NumFlatJointActions() const {
   // Compute the number of possible joint actions = \prod #actions(i)
   // over all players with any legal actions available.
   int number_joint_actions = 1;
@@ -47,9 +56,48 @@ std::vector<Action> SimMoveState::LegalFlatJointActions() const {
     int num_actions = LegalActions(player).size();
     if (num_actions > 1) number_joint_actions *= num_actions;
   }
+  return number_joint_actions;
+}
+
+void SimMoveState::ForEachJointAction(
+    const std::function<void(Action flat_action,
+                             const std::vector<Action>& actions)>& func) const {
+  const std::vector<std::vector<Action>> legal_actions = LegalActionsByPlayer();
+  // An odometer over per-player action indices, with player 0 as the
+  // least-significant digit, so the flat ids count up in the same order as
+  // the numbering described above. Players with zero or one legal action
+  // never contribute a digit, matching FlatJointActionToActions.
+  std::vector<int> indices(num_players_, 0);
+  std::vector<Action> actions(num_players_, kInvalidAction);
+  for (int player = 0; player < num_players_; ++player) {
+    if (!legal_actions[player].empty()) {
+      actions[player] = legal_actions[player][0];
+    }
+  }
+  Action flat_action = 0;
+  while (true) {
+    func(flat_action, actions);
+    ++flat_action;
+    int player = 0;
+    while (player < num_players_) {
+      if (legal_actions[player].size() > 1) {
+        if (++indices[player] < legal_actions[player].size()) {
+          actions[player] = legal_actions[player][indices[player]];
+          break;
+        }
+        indices[player] = 0;
+        actions[player] = legal_actions[player][0];
+      }
+      ++player;
+    }
+    if (player == num_players_) return;
+  }
+}
+
+std::vector<Action> SimMoveState::LegalFlatJointActions() const {
   // The possible joint actions are just numbered 0, 1, 2, ....
   // So build a vector of the right size containing consecutive integers.
-  std::vector<Action> joint_actions(number_joint_actions);
+  std::vector<Action> joint_actions(NumFlatJointActions());
   std::iota(joint_actions.begin(), joint_actions.end(), 0);
   return joint_actions;
 }
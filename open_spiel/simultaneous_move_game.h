@@ -15,6 +15,8 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_SIMULTANEOUS_MOVE_GAME_H_
 #define THIRD_PARTY_OPEN_SPIEL_SIMULTANEOUS_MOVE_GAME_H_
 
+#include <functional>
+
 #include "open_spiel/spiel.h"
 
 // This is the generic superclass for simultaneous move games. A simultaneous
@@ -51,6 +53,25 @@ class SimMoveState : public State {
   // Convert a flat joint action to a list of actions.
   std::vector<Action> FlatJointActionToActions(Action flat_action) const;
 
+  // Every player's legal action list, gathered in one pass. Callers that
+  // expand many joint actions at one node should fetch these once and index
+  // into them, rather than calling LegalActions(player) per joint action.
+  std::vector<std::vector<Action>> LegalActionsByPlayer() const;
+
+  // The number of legal flat joint actions (the size of the list that
+  // LegalFlatJointActions() would return), without materializing it.
+  int NumFlatJointActions() const;
+
+  // Calls func once per legal joint action with its flat id and the
+  // corresponding per-player actions, in flat-id order. The actions vector is
+  // reused between calls, so copy it if it must outlive the callback. Unlike
+  // iterating LegalActions() and expanding each flat id, nothing proportional
+  // to the product of the action-set sizes is ever allocated.
+  void ForEachJointAction(
+      const std::function<void(Action flat_action,
+                               const std::vector<Action>& actions)>& func)
+      const;
+
  protected:
   // To make the implementation of algorithms which traverse the whole game
   // tree easier, we support the mapping of joint actions (one per player)
@@ -19,11 +19,15 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <numeric>
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 
+#include "open_spiel/abseil-cpp/absl/strings/numbers.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_cat.h"
 #include "open_spiel/abseil-cpp/absl/strings/str_join.h"
+#include "open_spiel/abseil-cpp/absl/strings/str_split.h"
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel_utils.h"
 
@@ -110,8 +114,9 @@ std::unique_ptr<Game> GameRegisterer::CreateByName(
                                  absl::StrJoin(RegisteredNames(), "\n")));
 
   } else {
-    ValidateParams(params, iter->second.first.parameter_specification);
-    return (iter->second.second)(params);
+    const Registration& registration = registrations()[iter->second];
+    ValidateParams(params, registration.game_type->parameter_specification);
+    return (registration.creator)(params);
   }
 }
 
@@ -126,7 +131,7 @@ std::vector<std::string> GameRegisterer::RegisteredNames() {
 std::vector<GameType> GameRegisterer::RegisteredGames() {
   std::vector<GameType> games;
   for (const auto& key_val : factories()) {
-    games.push_back(key_val.second.first);
+    games.push_back(*registrations()[key_val.second].game_type);
   }
   return games;
 }
@@ -137,7 +142,17 @@ bool GameRegisterer::IsValidName(const std::string& short_name) {
 
 void GameRegisterer::RegisterGame(const GameType& game_info,
                                   GameRegisterer::CreateFunc creator) {
-  factories()[game_info.short_name] = std::make_pair(game_info, creator);
+  registrations().push_back(Registration{&game_info, std::move(creator)});
+}
+
+const std::map<std::string, int>& GameRegisterer::factories() {
+  static std::map<std::string, int> impl;
+  static std::size_t num_folded = 0;
+  const std::vector<Registration>& registered = registrations();
+  for (; num_folded < registered.size(); ++num_folded) {
+    impl[registered[num_folded].game_type->short_name] = num_folded;
+  }
+  return impl;
 }
 
 bool IsGameRegistered(const std::string& short_name) {
@@ -181,6 +196,50 @@ std::unique_ptr<Game> LoadGame(GameParameters params) {
   return result;
 }
 
+std::shared_ptr<const Game> LoadGameCached(const std::string& game_string) {
+  return LoadGameCached(GameParametersFromString(game_string));
+}
+
+std::shared_ptr<const Game> LoadGameCached(const std::string& short_name,
+                                           const GameParameters& params) {
+  GameParameters params_with_name = params;
+  params_with_name["name"] = GameParameter(short_name);
+  return LoadGameCached(std::move(params_with_name));
+}
+
+std::shared_ptr<const Game> LoadGameCached(GameParameters params) {
+  // The cache is keyed by the parameter digest rather than the canonical
+  // parameter string, so a hit builds no strings at all; the stored
+  // parameter maps disambiguate the (unlikely) digest collisions.
+  struct CacheEntry {
+    GameParameters params;
+    std::shared_ptr<const Game> game;
+  };
+  static std::mutex cache_mutex;
+  static std::unordered_map<uint64_t, std::vector<CacheEntry>> cache;
+  const uint64_t digest = GameParametersDigest(params);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto iter = cache.find(digest);
+    if (iter != cache.end()) {
+      for (const CacheEntry& entry : iter->second) {
+        if (entry.params == params) return entry.game;
+      }
+    }
+  }
+  // Construct outside the lock (LoadGame consumes its copy), and re-check
+  // afterwards so a racing load of the same game keeps a single instance.
+  GameParameters params_copy = params;
+  std::shared_ptr<const Game> game = LoadGame(std::move(params_copy));
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::vector<CacheEntry>& chain = cache[digest];
+  for (const CacheEntry& entry : chain) {
+    if (entry.params == params) return entry.game;
+  }
+  chain.push_back(CacheEntry{std::move(params), std::move(game)});
+  return chain.back().game;
+}
+
 template <>
 int Game::ParameterValue<int>(const std::string& key) const {
   return game_parameters_.at(key).int_value();
@@ -211,7 +270,10 @@ template <>
 int Game::ParameterValue<int>(const std::string& key, int default_value) const {
   auto iter = game_parameters_.find(key);
   if (iter == game_parameters_.end()) {
-    defaulted_parameters_[key] = GameParameter(default_value);
+    {
+      std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+      defaulted_parameters_[key] = GameParameter(default_value);
+    }
     return default_value;
   } else {
     return iter->second.int_value();
@@ -223,7 +285,10 @@ double Game::ParameterValue<double>(const std::string& key,
                                     double default_value) const {
   auto iter = game_parameters_.find(key);
   if (iter == game_parameters_.end()) {
-    defaulted_parameters_[key] = GameParameter(default_value);
+    {
+      std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+      defaulted_parameters_[key] = GameParameter(default_value);
+    }
     return default_value;
   } else {
     return iter->second.double_value();
@@ -235,7 +300,10 @@ std::string Game::ParameterValue<std::string>(const std::string& key,
                                               std::string default_value) const {
   auto iter = game_parameters_.find(key);
   if (iter == game_parameters_.end()) {
-    defaulted_parameters_[key] = GameParameter(default_value);
+    {
+      std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+      defaulted_parameters_[key] = GameParameter(default_value);
+    }
     return default_value;
   } else {
     return iter->second.string_value();
@@ -247,7 +315,10 @@ bool Game::ParameterValue<bool>(const std::string& key,
                                 bool default_value) const {
   auto iter = game_parameters_.find(key);
   if (iter == game_parameters_.end()) {
-    defaulted_parameters_[key] = GameParameter(default_value);
+    {
+      std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
+      defaulted_parameters_[key] = GameParameter(default_value);
+    }
     return default_value;
   } else {
     return iter->second.bool_value();
@@ -286,6 +357,94 @@ Action SampleChanceOutcome(const ActionsAndProbs& outcomes, double z) {
       absl::StrCat("Internal error: failed to sample an outcome; z=", z));
 }
 
+std::pair<Action, double> State::SampleChanceOutcome(double z) const {
+  SPIEL_CHECK_TRUE(IsChanceNode());
+  // Walk a fixed outcome table in place when the game exposes one; only
+  // state-dependent distributions need a fresh vector.
+  ActionsAndProbs local_outcomes;
+  const ActionsAndProbs* outcomes_ptr = StaticChanceOutcomes();
+  if (outcomes_ptr == nullptr) {
+    local_outcomes = ChanceOutcomes();
+    outcomes_ptr = &local_outcomes;
+  }
+  double sum = 0;
+  for (const std::pair<Action, double>& outcome : *outcomes_ptr) {
+    if (sum <= z && z < sum + outcome.second) return outcome;
+    sum += outcome.second;
+  }
+  SpielFatalError(
+      absl::StrCat("Internal error: failed to sample an outcome; z=", z));
+}
+
+std::vector<Action> Game::PossibleDistinctActions() const {
+  std::vector<Action> actions(NumDistinctActions());
+  std::iota(actions.begin(), actions.end(), 0);
+  return actions;
+}
+
+std::unique_ptr<State> Game::NewStateFromPool() const {
+  std::unique_ptr<State> state;
+  {
+    std::lock_guard<std::mutex> lock(state_pool_mutex_);
+    if (state_pool_.empty()) {
+      return NewInitialState();
+    }
+    state = std::move(state_pool_.back());
+    state_pool_.pop_back();
+    if (initial_state_template_ == nullptr) {
+      initial_state_template_ = NewInitialState();
+    }
+  }
+  // Reset the recycled object back to the initial state. The template is only
+  // ever written once (under the lock above), so reading it here is safe.
+  initial_state_template_->CloneInto(state.get());
+  return state;
+}
+
+void Game::ReleaseStateToPool(std::unique_ptr<State> state) const {
+  // States without the CloneInto fast path cannot be reset for reuse, so
+  // letting them be deallocated here is the best we can do.
+  if (state == nullptr || !state->SupportsCloneInto()) return;
+  std::lock_guard<std::mutex> lock(state_pool_mutex_);
+  state_pool_.push_back(std::move(state));
+}
+
+void Game::BatchInformationStateNormalizedVectors(
+    const std::vector<const State*>& states, double* buffer) const {
+  const int size = InformationStateNormalizedVectorSize();
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->InformationStateAsNormalizedVector(states[i]->CurrentPlayer(),
+                                                  buffer + i * size);
+  }
+}
+
+void Game::BatchInformationStateNormalizedVectors(
+    const std::vector<const State*>& states, float* buffer) const {
+  const int size = InformationStateNormalizedVectorSize();
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->InformationStateAsNormalizedVector(states[i]->CurrentPlayer(),
+                                                  buffer + i * size);
+  }
+}
+
+void Game::BatchObservationNormalizedVectors(
+    const std::vector<const State*>& states, double* buffer) const {
+  const int size = ObservationNormalizedVectorSize();
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->ObservationAsNormalizedVector(states[i]->CurrentPlayer(),
+                                             buffer + i * size);
+  }
+}
+
+void Game::BatchObservationNormalizedVectors(
+    const std::vector<const State*>& states, float* buffer) const {
+  const int size = ObservationNormalizedVectorSize();
+  for (int i = 0; i < states.size(); ++i) {
+    states[i]->ObservationAsNormalizedVector(states[i]->CurrentPlayer(),
+                                             buffer + i * size);
+  }
+}
+
 std::string Game::SerializeState(const State& state) const {
   // This simple serialization doesn't work for games with sampled chance
   // nodes, since the history doesn't give us enough information to reconstruct
@@ -293,7 +452,12 @@ std::string Game::SerializeState(const State& state) const {
   // implement custom serialization and deserialization for the state.
   SPIEL_CHECK_NE(game_type_.chance_mode,
                  GameType::ChanceMode::kSampledStochastic);
-  return absl::StrCat(absl::StrJoin(state.History(), "\n"), "\n");
+  std::string str;
+  for (Action action : state.HistoryView()) {
+    AppendInt(action, &str);
+    str.push_back('\n');
+  }
+  return str;
 }
 
 std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
@@ -308,26 +472,74 @@ std::unique_ptr<State> Game::DeserializeState(const std::string& str) const {
   if (str.length() == 0) {
     return state;
   }
-  std::vector<std::string> lines = absl::StrSplit(str, '\n');
+  // SerializeState emits one action per line with a trailing newline, so
+  // skip blank lines rather than feeding them to the number parser. A
+  // malformed line is a fatal error, not an uncaught std::stol exception.
+  std::vector<std::string> lines =
+      absl::StrSplit(str, '\n', absl::SkipEmpty());
   for (int i = 0; i < lines.size(); ++i) {
     if (state->IsSimultaneousNode()) {
       std::vector<Action> actions;
       for (int p = 0; p < state->NumPlayers(); ++p, ++i) {
         SPIEL_CHECK_LT(i, lines.size());
-        Action action = static_cast<Action>(std::stol(lines[i]));
+        Action action;
+        SPIEL_CHECK_TRUE(absl::SimpleAtoi(lines[i], &action));
         actions.push_back(action);
       }
       state->ApplyActions(actions);
       // Must decrement i here, otherwise it is incremented too many times.
       --i;
     } else {
-      Action action = static_cast<Action>(std::stol(lines[i]));
+      Action action;
+      SPIEL_CHECK_TRUE(absl::SimpleAtoi(lines[i], &action));
       state->ApplyAction(action);
     }
   }
   return state;
 }
 
+std::string Game::SerializeStateBinary(const State& state) const {
+  // As with SerializeState, the history is not enough to reconstruct states
+  // of games with sampled chance nodes; such games must override the pair.
+  SPIEL_CHECK_NE(game_type_.chance_mode,
+                 GameType::ChanceMode::kSampledStochastic);
+  std::vector<Action> history = state.History();
+  std::string str;
+  AppendVarint(history.size(), &str);
+  for (Action action : history) {
+    SPIEL_CHECK_GE(action, 0);
+    AppendVarint(static_cast<uint64_t>(action), &str);
+  }
+  return str;
+}
+
+std::unique_ptr<State> Game::DeserializeStateBinary(
+    const std::string& str) const {
+  SPIEL_CHECK_NE(game_type_.chance_mode,
+                 GameType::ChanceMode::kSampledStochastic);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
+  std::size_t size = str.size();
+  std::size_t offset = 0;
+  std::size_t num_actions = ReadVarint(data, size, &offset);
+  std::unique_ptr<State> state = NewInitialState();
+  for (std::size_t i = 0; i < num_actions;) {
+    if (state->IsSimultaneousNode()) {
+      std::vector<Action> actions;
+      for (int p = 0; p < state->NumPlayers(); ++p, ++i) {
+        SPIEL_CHECK_LT(i, num_actions);
+        actions.push_back(
+            static_cast<Action>(ReadVarint(data, size, &offset)));
+      }
+      state->ApplyActions(actions);
+    } else {
+      state->ApplyAction(static_cast<Action>(ReadVarint(data, size, &offset)));
+      ++i;
+    }
+  }
+  SPIEL_CHECK_EQ(offset, size);
+  return state;
+}
+
 std::string SerializeGameAndState(const Game& game, const State& state) {
   std::string str = "";
 
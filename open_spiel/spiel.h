@@ -15,10 +15,13 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_H_
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
@@ -134,6 +137,51 @@ struct GameType {
   };
   std::map<std::string, ParameterSpec> parameter_specification;
   bool ContainsRequiredParameters() const;
+
+  // Whether every state of this game implements UndoAction. Algorithms such
+  // as AlphaBetaSearch use this to walk the game tree with a single state
+  // object instead of cloning at every node. Games that do not list this
+  // field in their GameType definition get the value-initialized default of
+  // false.
+  bool provides_undo;
+
+  // Whether State::HashValue is overridden with a game-specific hash of the
+  // position. The default (hashing the string representation) is always
+  // available but slow; algorithms that can key their tables on either
+  // strings or 8-byte hashes use this bit to pick. As with provides_undo,
+  // games that do not list this field get false.
+  bool provides_hash_value;
+
+  // Whether the game's state logic is independent of the framework-kept
+  // history: history_ is never read outside of UndoAction. When true,
+  // State::DisableHistoryTracking() can produce lightweight rollout states
+  // that skip the history append on every action. Games such as kuhn_poker
+  // (current player), go (consecutive passes) or catch (observations) derive
+  // behaviour from the history and must leave this false. As with
+  // provides_undo, games that do not list this field get false.
+  bool history_independent_state;
+
+  // Whether State::QuickEvaluate is overridden with a cheap static
+  // evaluation of the position. Depth-capped rollouts use this bit to decide
+  // whether a playout can be cut short and scored in place. As with
+  // provides_undo, games that do not list this field get false.
+  bool provides_quick_evaluate;
+
+  // Whether State::CanonicalKey is overridden to collapse the game's board
+  // symmetries (rotations and reflections, card permutations). Enumeration
+  // and solving passes use this bit to decide whether keying on
+  // CanonicalKey buys anything over ToString. As with provides_undo, games
+  // that do not list this field get false.
+  bool provides_canonical_key;
+
+  // Whether the current player's action set is the same fixed set at every
+  // decision node of the game (chance and terminal nodes excepted). Games
+  // setting this bit serve that set through State::StaticLegalActions, so
+  // per-step callers read a prebuilt table instead of running move
+  // generation; simultaneous-move games must leave this false (their flat
+  // joint action space is not a per-player action set). As with
+  // provides_undo, games that do not list this field get false.
+  bool state_independent_actions;
 };
 
 enum class StateType {
@@ -151,7 +199,96 @@ std::ostream& operator<<(std::ostream& stream, GameType::Utility value);
 // The probability of taking each possible action in a particular info state.
 using ActionsAndProbs = std::vector<std::pair<Action, double>>;
 
+// A variant of ActionsAndProbs with a small inline buffer: up to
+// kInlineCapacity pairs live inside the object itself and only larger
+// policies touch the allocator. High-frequency lookup paths (trajectory
+// sampling, best response) fill a reusable instance through the
+// out-parameter overloads of Policy::GetStatePolicy rather than receiving
+// a freshly allocated vector per call.
+class SmallActionsAndProbs {
+ public:
+  using value_type = std::pair<Action, double>;
+  static constexpr int kInlineCapacity = 8;
+
+  SmallActionsAndProbs()
+      : data_(inline_), size_(0), capacity_(kInlineCapacity) {}
+  SmallActionsAndProbs(const SmallActionsAndProbs& other)
+      : SmallActionsAndProbs() {
+    *this = other;
+  }
+  SmallActionsAndProbs& operator=(const SmallActionsAndProbs& other) {
+    if (this == &other) return *this;
+    clear();
+    Reserve(other.size_);
+    std::copy(other.data_, other.data_ + other.size_, data_);
+    size_ = other.size_;
+    return *this;
+  }
+  ~SmallActionsAndProbs() {
+    if (data_ != inline_) delete[] data_;
+  }
+
+  void push_back(const value_type& pair) {
+    if (size_ == capacity_) Reserve(2 * capacity_);
+    data_[size_++] = pair;
+  }
+  // Keeps any heap buffer for reuse by the next fill.
+  void clear() { size_ = 0; }
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const value_type& operator[](int i) const { return data_[i]; }
+  value_type& operator[](int i) { return data_[i]; }
+  const value_type* begin() const { return data_; }
+  const value_type* end() const { return data_ + size_; }
+
+ private:
+  void Reserve(int capacity) {
+    if (capacity <= capacity_) return;
+    value_type* new_data = new value_type[capacity];
+    std::copy(data_, data_ + size_, new_data);
+    if (data_ != inline_) delete[] data_;
+    data_ = new_data;
+    capacity_ = capacity;
+  }
+
+  value_type inline_[kInlineCapacity];
+  value_type* data_;
+  int size_;
+  int capacity_;
+};
+
 // An abstract class that represents a state of the game.
+//
+// One environment step's worth of outputs, filled in a single call by
+// State::StepOutputs. The caller owns every buffer, sizes them once from
+// the Game, and reuses them across steps (and across environments in a
+// batched RL loop); nothing here allocates.
+struct StepView {
+  // Normalized observation for the stepped player; must hold
+  // Game::ObservationNormalizedVectorSize() entries.
+  double* observation = nullptr;
+  // Legal-actions bitset; must hold State::LegalActionsBitsetWords() words,
+  // encoded as in State::LegalActionsBitset.
+  uint64_t* legal_mask = nullptr;
+  // Per-player rewards since the previous decision; must hold
+  // Game::NumPlayers() entries.
+  double* rewards = nullptr;
+  // Set if the state is terminal.
+  bool done = false;
+};
+
+// Thread safety: distinct State objects are fully independent and need no
+// synchronization. On a single shared State, all const accessors — including
+// the memoizing LegalActionsCached() and InformationStateKeyCached(), whose
+// caches are internally synchronized — may be called concurrently from any
+// number of threads. Mutations (ApplyAction, ApplyActions, UndoAction) are
+// not synchronized: callers must guarantee exclusive access for the duration
+// of a mutation and establish a happens-before edge (a join, a mutex, a
+// barrier) between the mutation and any subsequent concurrent reads. Games
+// implementing State must keep their own const methods free of
+// unsynchronized mutable data for this contract to hold;
+// tests/concurrency_test.cc exercises these patterns and is intended to be
+// run under ThreadSanitizer.
 class State {
  public:
   virtual ~State() = default;
@@ -178,10 +315,13 @@ class State {
   //
   // Games should implement DoApplyAction.
   virtual void ApplyAction(Action action_id) {
+    SPIEL_STATS_INC("State::ApplyAction");
     // history_ needs to be modified *after* DoApplyAction which could
     // be using it.
     DoApplyAction(action_id);
-    history_.push_back(action_id);
+    if (track_history_) history_.push_back(action_id);
+    legal_actions_cache_.cached_epoch.store(0, std::memory_order_relaxed);
+    info_state_key_cache_.valid.clear();
   }
 
   // `LegalActions(int player)` is valid for all nodes in all games, returning
@@ -214,14 +354,101 @@ class State {
   // is added.
   virtual std::vector<Action> LegalActions() const = 0;
 
+  // Lazy counterpart of LegalActions(): calls `yield` once per legal action
+  // of the current player and stops generating when yield returns false.
+  // Callers that only need the first few actions (an alpha-beta search that
+  // cuts after one or two children, an any-legal-move test) avoid paying for
+  // the rest of the list.
+  //
+  // As with ChessBoard::MoveYieldFn, the early exit is an optimization, not
+  // a guarantee: an implementation may call yield a few more times after it
+  // returns false, so callbacks must tolerate further calls. The enumeration
+  // order is implementation-defined — the default follows LegalActions(),
+  // but games that override this to generate natively may yield in their
+  // cheapest generation order rather than ascending order.
+  virtual void ForEachLegalAction(
+      const std::function<bool(Action)>& yield) const {
+    for (Action action : LegalActions()) {
+      if (!yield(action)) return;
+    }
+  }
+
+  // Returns a reference to LegalActions() memoized for this node. The first
+  // call runs the game's move generation; further calls at the same node
+  // return the stored vector without recomputing or allocating. Algorithms
+  // that consult the legal actions of one node several times (e.g. once for
+  // the actions and once for the mask) should prefer this accessor.
+  //
+  // The cache is invalidated by ApplyAction/ApplyActions, and a cache written
+  // at a different history length (e.g. before an UndoAction) is never
+  // reused, so no cooperation is needed from the games. The returned
+  // reference is only valid until the state next changes.
+  //
+  // Safe to call concurrently with other const accessors (see the class
+  // comment): cache hits are lock-free, and readers racing to fill a cold
+  // cache serialize on a spin lock only for the duration of the fill.
+  const std::vector<Action>& LegalActionsCached() const {
+    // The epoch is the history length + 1, so that 0 can mean "empty"; an
+    // entry written at a different history length never matches and is
+    // refilled. A reader that sees the current epoch takes no lock: the
+    // release store below is what published the filled vector, and nothing
+    // can touch the vector again before a mutation — which the caller must
+    // already serialize against.
+    const size_t epoch = history_.size() + 1;
+    if (legal_actions_cache_.cached_epoch.load(std::memory_order_acquire) !=
+        epoch) {
+      while (legal_actions_cache_.fill_lock.test_and_set(
+          std::memory_order_acquire)) {
+      }
+      if (legal_actions_cache_.cached_epoch.load(std::memory_order_relaxed) !=
+          epoch) {
+        SPIEL_STATS_INC("State::LegalActionsCached misses");
+        legal_actions_cache_.actions = LegalActions();
+        legal_actions_cache_.cached_epoch.store(epoch,
+                                                std::memory_order_release);
+      }
+      legal_actions_cache_.fill_lock.clear(std::memory_order_release);
+    }
+    return legal_actions_cache_.actions;
+  }
+
+  // Returns a pointer to a fixed action table equal to LegalActions() when
+  // the action set at this decision node does not depend on the state, or
+  // nullptr otherwise (including at chance and terminal nodes). Games whose
+  // GameType sets state_independent_actions return their table at every
+  // decision node. The table must outlive the states referencing it; games
+  // keep it in static storage or in the Game object. This is the
+  // legal-action analogue of StaticChanceOutcomes below.
+  virtual const std::vector<Action>* StaticLegalActions() const {
+    return nullptr;
+  }
+
+  // The legal actions as a Span, for interfaces that should not commit to
+  // the storage behind them. Served from the game's fixed table when
+  // StaticLegalActions() provides one — no move generation, no allocation —
+  // and from LegalActionsCached() otherwise; either way the view is valid
+  // only until the state next changes.
+  Span<Action> LegalActionsView() const {
+    const std::vector<Action>* fixed = StaticLegalActions();
+    if (fixed != nullptr) return *fixed;
+    return LegalActionsCached();
+  }
+
   // Returns a vector of length `game.NumDistinctActions()` containing 1 for
   // legal actions and 0 for illegal actions.
   std::vector<int> LegalActionsMask(int player) const {
     std::vector<int> mask(num_distinct_actions_, 0);
-    std::vector<Action> legal_actions = LegalActions(player);
-
-    for (auto const& value : legal_actions) {
-      mask[value] = 1;
+    if (!IsTerminal() && player == CurrentPlayer() && !IsSimultaneousNode()) {
+      // For the player to act, LegalActions(player) is LegalActions(), so the
+      // memoized copy can be shared with callers of either.
+      for (auto const& value : LegalActionsCached()) {
+        mask[value] = 1;
+      }
+    } else {
+      std::vector<Action> legal_actions = LegalActions(player);
+      for (auto const& value : legal_actions) {
+        mask[value] = 1;
+      }
     }
     return mask;
   }
@@ -231,6 +458,33 @@ class State {
     return LegalActionsMask(CurrentPlayer());
   }
 
+  // Number of uint64_t words needed by LegalActionsBitset below.
+  int LegalActionsBitsetWords() const {
+    return (num_distinct_actions_ + 63) / 64;
+  }
+
+  // Writes the current player's legal-actions mask as a bitset into `out`,
+  // which must hold at least LegalActionsBitsetWords() words: bit
+  // (a % 64) of word (a / 64) is set iff action a is legal; all other bits
+  // (including padding up to the word boundary) are cleared. At terminal
+  // and simultaneous-move nodes the bitset is all zero (flattened joint
+  // actions do not fit the per-player action space; use
+  // LegalActionsMask(player) there).
+  //
+  // This is the allocation-free counterpart of LegalActionsMask() for
+  // callers that emit masks in bulk (one per step per environment in an RL
+  // stack). The default builds the bitset from the memoized legal actions;
+  // games whose internal representation already encodes move legality as
+  // occupancy bits (e.g. board games with bitboards) can override it and
+  // fill the words directly, skipping move generation entirely.
+  virtual void LegalActionsBitset(uint64_t* out) const {
+    std::fill(out, out + LegalActionsBitsetWords(), uint64_t{0});
+    if (IsTerminal() || IsSimultaneousNode()) return;
+    for (const Action action : LegalActionsCached()) {
+      out[action / 64] |= uint64_t{1} << (action % 64);
+    }
+  }
+
   // Returns a string representation of the specified action for the player.
   // The representation may depend on the current state of the game, e.g.
   // for chess the string "Nf3" would correspond to different starting squares
@@ -242,6 +496,50 @@ class State {
   // semantics and is targeting debugging code.
   virtual std::string ToString() const = 0;
 
+  // Writer-based variants of the two methods above: append the rendering to
+  // *str instead of returning a fresh string, so callers building many keys
+  // or log lines in a loop can reuse one buffer. The defaults append what
+  // the plain methods return; games whose string building shows up in
+  // profiles override these and implement the plain methods on top.
+  virtual void AppendActionToString(std::string* str, int player,
+                                    Action action_id) const {
+    str->append(ActionToString(player, action_id));
+  }
+  virtual void AppendToString(std::string* str) const {
+    str->append(ToString());
+  }
+
+  // Returns a hash of this state, suitable for keying the transposition
+  // tables used by the search algorithms. Games that maintain an incremental
+  // board hash (e.g. Zobrist hashing in chess and go) or can hash their
+  // position cheaply should override this and set provides_hash_value in
+  // their GameType; the default hashes the string representation, which is
+  // correct but slow.
+  virtual uint64_t HashValue() const {
+    return std::hash<std::string>()(ToString());
+  }
+
+  // A key identifying this state up to the game's board symmetries: every
+  // state of one symmetry class returns the same key, and states of
+  // different classes return different keys. State enumeration,
+  // transposition tables and the retrograde solver can key on this instead
+  // of ToString to collapse symmetric positions (pentago's 8-fold symmetry
+  // alone cuts the state count by nearly that factor). Games with
+  // symmetries should override this and set provides_canonical_key in
+  // their GameType; the default is ToString, which collapses nothing.
+  virtual std::string CanonicalKey() const { return ToString(); }
+
+  // A cheap static evaluation of this state from player 0's perspective, in
+  // [-1, 1], positive when player 0 stands better: material difference,
+  // pip count and the like. It is a playout-quality signal, not a utility:
+  // depth-capped rollouts (see RandomRolloutEvaluator) score a cut-short
+  // playout with it instead of playing the game out. Games that can score a
+  // position in (at most) one board scan should override this and set
+  // provides_quick_evaluate in their GameType; the default fails.
+  virtual double QuickEvaluate() const {
+    SpielFatalError("QuickEvaluate is not implemented.");
+  }
+
   // Is this a terminal state? (i.e. has the game ended?)
   virtual bool IsTerminal() const = 0;
 
@@ -287,6 +585,17 @@ class State {
     return returns[player];
   }
 
+  // Writes the per-player returns into caller-provided storage, resizing it
+  // to the number of players. The default delegates to Returns(); games with
+  // cheaply computed per-player returns should override this to write in
+  // place, so callers that reuse one vector across many terminals pay no
+  // allocation per call. Such games should usually also override
+  // PlayerReturn, which algorithms that only need one player's value (e.g.
+  // sampled traversals of two-player zero-sum games) call per terminal.
+  virtual void ReturnsTo(std::vector<double>* returns) const {
+    *returns = Returns();
+  }
+
   // Is this state a chance node? Chance nodes are "states" whose actions
   // represent stochastic outcomes. "Chance" or "Nature" is thought of as a
   // player with a fixed (randomized) policy.
@@ -302,12 +611,33 @@ class State {
   // A string representation for the history. There should be a one to one
   // mapping between an history (i.e. a sequence of actions for all players,
   // including chance) and the `State` objects.
-  virtual std::vector<Action> History() const { return history_; }
+  virtual std::vector<Action> History() const {
+    SPIEL_CHECK_TRUE(track_history_);
+    return history_.ToVector();
+  }
+
+  // The history as a view over the state's own storage, for callers that
+  // only read it; History() copies every action into a fresh vector per
+  // call. The chunked ActionHistory is not contiguous, so the view is the
+  // container itself rather than a Span; it supports size(), indexing and
+  // range-for. Valid only until the state next changes.
+  const ActionHistory& HistoryView() const {
+    SPIEL_CHECK_TRUE(track_history_);
+    return history_;
+  }
 
   virtual std::string HistoryString() const {
+    SPIEL_CHECK_TRUE(track_history_);
     return absl::StrJoin(history_, " ");
   }
 
+  // Stops recording applied actions into this state's history; clones made
+  // from it inherit the setting. Only valid for games whose type sets
+  // history_independent_state, and History(), HistoryString() and UndoAction
+  // must not be used afterwards. Rollout and sampling loops that only ever
+  // step states forward use this to skip the per-action history append.
+  void DisableHistoryTracking() { track_history_ = false; }
+
   // For imperfect information games. Returns an identifier for the current
   // information state for the specified player.
   // Different ground states can yield the same information state for a player
@@ -343,6 +673,63 @@ class State {
     return InformationState(CurrentPlayer());
   }
 
+  // Returns a compact key identifying the current information state for the
+  // specified player, suitable for keying the hash maps used by the tabular
+  // algorithms (CFR, best response, tabular policies). Consumers mix the two
+  // freely -- e.g. HistoryTree and the trajectory state indices build tables
+  // from InformationState strings and probe them with keys -- so the key
+  // must be byte-identical to InformationState. The override hook exists for
+  // games that can assemble that same string more cheaply than their general
+  // InformationState path; the default simply returns InformationState.
+  virtual std::string InformationStateKey(int player) const {
+    return InformationState(player);
+  }
+
+  virtual std::string InformationStateKey() const {
+    return InformationStateKey(CurrentPlayer());
+  }
+
+  // Returns a reference to InformationStateKey(player) memoized for this
+  // node. Tabular solvers ask for the same state's key several times — once
+  // per player at simultaneous nodes, and again across the regret and policy
+  // phases of an iteration — and each call formats a fresh string; the first
+  // call per player builds the key and further calls at the same node return
+  // the stored copy. The cache is invalidated by ApplyAction/ApplyActions
+  // and, like LegalActionsCached(), a cache written at a different history
+  // length is never reused. The returned reference is only valid until the
+  // state next changes.
+  //
+  // Safe to call concurrently with other const accessors (see the class
+  // comment). Unlike LegalActionsCached() there is no lock-free hit path:
+  // with one validity bit per player a reader cannot check freshness in a
+  // single atomic load, so every call takes the cache's spin lock —
+  // uncontended in single-threaded use. Returning the reference after
+  // unlocking is safe because, until the next mutation, the keys vector is
+  // never resized; only missing entries are filled in.
+  const std::string& InformationStateKeyCached(int player) const {
+    while (info_state_key_cache_.lock.test_and_set(
+        std::memory_order_acquire)) {
+    }
+    if (info_state_key_cache_.history_size != history_.size() ||
+        info_state_key_cache_.valid.empty()) {
+      info_state_key_cache_.keys.resize(num_players_);
+      info_state_key_cache_.valid.assign(num_players_, false);
+      info_state_key_cache_.history_size = history_.size();
+    }
+    if (!info_state_key_cache_.valid[player]) {
+      SPIEL_STATS_INC("State::InformationStateKeyCached misses");
+      info_state_key_cache_.keys[player] = InformationStateKey(player);
+      info_state_key_cache_.valid[player] = true;
+    }
+    const std::string& key = info_state_key_cache_.keys[player];
+    info_state_key_cache_.lock.clear(std::memory_order_release);
+    return key;
+  }
+
+  const std::string& InformationStateKeyCached() const {
+    return InformationStateKeyCached(CurrentPlayer());
+  }
+
   // Vector form, useful for neural-net function approximation approaches.
   // The size of the vector must match Game::InformationStateShape()
   // with values in lexicographic order. E.g. for 2x4x3, order would be:
@@ -369,6 +756,52 @@ class State {
     return normalized_info_state;
   }
 
+  // Same as above, but writes the values directly into `buffer`, which the
+  // caller owns and must have room for at least
+  // Game::InformationStateNormalizedVectorSize() entries. The default goes
+  // through a temporary vector; games for which this path is hot should
+  // override it to fill the buffer in place.
+  virtual void InformationStateAsNormalizedVector(int player,
+                                                  double* buffer) const {
+    std::vector<double> values;
+    InformationStateAsNormalizedVector(player, &values);
+    std::copy(values.begin(), values.end(), buffer);
+  }
+
+  // Float32 variant, for consumers (typically neural network input
+  // pipelines) that want float tensors directly. The default converts from
+  // the double-precision path; games can override it to write float32 in
+  // place and skip the conversion pass.
+  virtual void InformationStateAsNormalizedVector(int player,
+                                                  float* buffer) const {
+    std::vector<double> values;
+    InformationStateAsNormalizedVector(player, &values);
+    for (int i = 0; i < values.size(); ++i) {
+      buffer[i] = static_cast<float>(values[i]);
+    }
+  }
+
+  // Sparse encoding of the normalized vector: writes the positions and
+  // values of its nonzero entries. For the one-hot-heavy encodings most
+  // games produce, this is many times smaller than the dense vector, which
+  // matters when observations are shipped over the wire or stored in bulk.
+  // The default derives the sparse form from the dense one; games for which
+  // this path is hot can override it to emit the nonzeros directly.
+  virtual void InformationStateAsSparseNormalizedVector(
+      int player, std::vector<int>* indices,
+      std::vector<double>* values) const {
+    std::vector<double> dense;
+    InformationStateAsNormalizedVector(player, &dense);
+    indices->clear();
+    values->clear();
+    for (int i = 0; i < dense.size(); ++i) {
+      if (dense[i] != 0) {
+        indices->push_back(i);
+        values->push_back(dense[i]);
+      }
+    }
+  }
+
   // We have functions for observations which are parallel to those for
   // information states. An observation should have the following properties:
   //  - It has at most the same information content as the information state
@@ -406,9 +839,77 @@ class State {
     return normalized_observation;
   }
 
+  // Same as above, but writes the values directly into `buffer`, which the
+  // caller owns and must have room for at least
+  // Game::ObservationNormalizedVectorSize() entries.
+  virtual void ObservationAsNormalizedVector(int player, double* buffer) const {
+    std::vector<double> values;
+    ObservationAsNormalizedVector(player, &values);
+    std::copy(values.begin(), values.end(), buffer);
+  }
+
+  // Float32 variant; see the InformationState counterpart above.
+  virtual void ObservationAsNormalizedVector(int player, float* buffer) const {
+    std::vector<double> values;
+    ObservationAsNormalizedVector(player, &values);
+    for (int i = 0; i < values.size(); ++i) {
+      buffer[i] = static_cast<float>(values[i]);
+    }
+  }
+
+  // Sparse variant; see the InformationState counterpart above.
+  virtual void ObservationAsSparseNormalizedVector(
+      int player, std::vector<int>* indices,
+      std::vector<double>* values) const {
+    std::vector<double> dense;
+    ObservationAsNormalizedVector(player, &dense);
+    indices->clear();
+    values->clear();
+    for (int i = 0; i < dense.size(); ++i) {
+      if (dense[i] != 0) {
+        indices->push_back(i);
+        values->push_back(dense[i]);
+      }
+    }
+  }
+
+  // Fills every field of `out` for the current state in one call: the
+  // normalized observation for `player`, the legal-actions bitset, the
+  // rewards, and the terminal flag — the four quantities an RL step needs,
+  // for the price of one virtual dispatch. Must not be called at chance
+  // nodes (Rewards() is undefined there). The default forwards to the four
+  // underlying methods; games whose observation derives from a small
+  // internal state can override it and fill all the buffers in one pass.
+  virtual void StepOutputs(int player, StepView* out) const {
+    out->done = IsTerminal();
+    ObservationAsNormalizedVector(player, out->observation);
+    LegalActionsBitset(out->legal_mask);
+    const std::vector<double> rewards = Rewards();
+    std::copy(rewards.begin(), rewards.end(), out->rewards);
+  }
+
+  // Convenience function for turn-based games.
+  void StepOutputs(StepView* out) const {
+    StepOutputs(CurrentPlayer(), out);
+  }
+
   // Return a copy of this state.
   virtual std::unique_ptr<State> Clone() const = 0;
 
+  // Copies this state into `state`, which must be a state of the same
+  // underlying type, previously obtained from the same game. This is a fast
+  // path used by Game::NewStateFromPool to recycle state objects instead of
+  // heap-allocating a fresh one per clone. Games that wish to support pooling
+  // should override this (usually in terms of the derived copy assignment
+  // operator) together with SupportsCloneInto below.
+  virtual void CloneInto(State* state) const {
+    SpielFatalError("CloneInto is not implemented.");
+  }
+
+  // Whether CloneInto is overridden for this state type. Only states that
+  // return true here are recycled by Game::NewStateFromPool.
+  virtual bool SupportsCloneInto() const { return false; }
+
   // Creates the child from State corresponding to action.
   std::unique_ptr<State> Child(Action action) const {
     std::unique_ptr<State> child = Clone();
@@ -435,8 +936,11 @@ class State {
     // history_ needs to be modified *after* DoApplyActions which could
     // be using it.
     DoApplyActions(actions);
-    history_.reserve(history_.size() + actions.size());
-    history_.insert(history_.end(), actions.begin(), actions.end());
+    if (track_history_) {
+      for (Action action : actions) history_.push_back(action);
+    }
+    legal_actions_cache_.cached_epoch.store(0, std::memory_order_relaxed);
+    info_state_key_cache_.valid.clear();
   }
 
   // The size of the action space. See `Game` for a full description.
@@ -461,6 +965,25 @@ class State {
     SpielFatalError("ChanceOutcomes unimplemented!");
   }
 
+  // Returns a pointer to a fixed outcome table equal to ChanceOutcomes()
+  // when the chance distribution at this state does not depend on the state
+  // (dice rolls, uniform deals), or nullptr when it does. Hot callers (the
+  // default SampleChanceOutcome, the CFR chance-node loops) read the table
+  // in place rather than materializing a fresh vector on every visit. The
+  // table must outlive the states referencing it; games keep it in static
+  // storage or in the Game object.
+  virtual const ActionsAndProbs* StaticChanceOutcomes() const {
+    return nullptr;
+  }
+
+  // Samples an outcome at a chance node from a uniform draw z in [0, 1).
+  // Returns the sampled action and its probability. Equivalent to sampling
+  // from ChanceOutcomes(), but games whose chance distributions have a direct
+  // form (dice rolls, card deals) override it to avoid materializing the
+  // outcome vector on every visit; chance nodes are a large share of all
+  // nodes visited in the stochastic games.
+  virtual std::pair<Action, double> SampleChanceOutcome(double z) const;
+
   // Lists the valid chance outcomes at the current state.
   // Derived classes may substitute this with a more efficient implementation.
   virtual std::vector<Action> LegalChanceOutcomes() const {
@@ -480,7 +1003,12 @@ class State {
  protected:
   int num_distinct_actions_;
   int num_players_;
-  std::vector<Action> history_;  // The list of actions leading to the state.
+  // The list of actions leading to the state. Copy-on-write: clones share
+  // the underlying chunks until either side appends (see ActionHistory), so
+  // cloning a deep state does not copy its whole history.
+  ActionHistory history_;
+  // Set to false by DisableHistoryTracking(); see its comment.
+  bool track_history_ = true;
 
   // See ApplyAction.
   virtual void DoApplyAction(Action action_id) {
@@ -490,10 +1018,62 @@ class State {
   virtual void DoApplyActions(const std::vector<Action>& actions) {
     SpielFatalError("DoApplyActions is not implemented.");
   }
+
+ private:
+  // Storage for LegalActionsCached(). A copied state represents the same node
+  // so the cache would still apply, but the overwhelmingly common reason to
+  // copy a state is Clone()-then-ApplyAction (see Child()), where copying the
+  // vector would be an allocation immediately thrown away. The copy
+  // operations therefore leave the destination cache empty instead.
+  //
+  // cached_epoch is the history length + 1 at the time of the fill, or 0
+  // when empty; folding validity and freshness into one word is what lets
+  // LegalActionsCached() validate the cache with a single acquire load.
+  // fill_lock serializes racing fillers.
+  struct LegalActionsCache {
+    std::vector<Action> actions;
+    std::atomic<size_t> cached_epoch{0};
+    std::atomic_flag fill_lock = ATOMIC_FLAG_INIT;
+
+    LegalActionsCache() = default;
+    LegalActionsCache(const LegalActionsCache&) {}
+    LegalActionsCache& operator=(const LegalActionsCache&) {
+      actions.clear();
+      cached_epoch.store(0, std::memory_order_relaxed);
+      return *this;
+    }
+  };
+  mutable LegalActionsCache legal_actions_cache_;
+
+  // Storage for InformationStateKeyCached(), with the same copy semantics as
+  // LegalActionsCache: copies start empty rather than duplicating strings
+  // that Clone()-then-ApplyAction would immediately invalidate.
+  struct InformationStateKeyCache {
+    std::vector<std::string> keys;
+    std::vector<bool> valid;
+    size_t history_size = 0;
+    // All concurrent access goes through this lock; see
+    // InformationStateKeyCached().
+    std::atomic_flag lock = ATOMIC_FLAG_INIT;
+
+    InformationStateKeyCache() = default;
+    InformationStateKeyCache(const InformationStateKeyCache&) {}
+    InformationStateKeyCache& operator=(const InformationStateKeyCache&) {
+      keys.clear();
+      valid.clear();
+      return *this;
+    }
+  };
+  mutable InformationStateKeyCache info_state_key_cache_;
 };
 
 // A class that refers to a particular game instantiation, for example
 // Breakthrough(8x8).
+//
+// Thread safety: a Game is logically immutable once constructed, and all of
+// its methods may be called concurrently from any number of threads. The
+// only mutable members — the state pool and the record of defaulted
+// parameters — are guarded by internal mutexes.
 class Game {
  public:
   virtual ~Game() = default;
@@ -510,9 +1090,32 @@ class Game {
   // learning which move to play.
   virtual int NumDistinctActions() const = 0;
 
+  // The action ids in [0, NumDistinctActions()) that can be legal in at
+  // least one state of the game, in ascending order. Games whose encoding
+  // packs move components into bitfields (e.g. chess's from/to/promotion
+  // scheme) leave most ids unused; overriding this lets algorithms compact
+  // per-action arrays to the reachable ids (see
+  // algorithms/dense_action_map.h). The default assumes every id is
+  // reachable.
+  virtual std::vector<Action> PossibleDistinctActions() const;
+
   // Returns a newly allocated initial state.
   virtual std::unique_ptr<State> NewInitialState() const = 0;
 
+  // Returns an initial state, reusing the memory of a state previously handed
+  // back via ReleaseStateToPool when one is available, and falling back to
+  // NewInitialState() when the pool is empty. Recycling requires the game's
+  // states to implement CloneInto; for all other games these two methods
+  // behave exactly like NewInitialState() and plain destruction. Both methods
+  // are safe to call from multiple threads.
+  std::unique_ptr<State> NewStateFromPool() const;
+
+  // Hands a state obtained from this game back to the pool so that its memory
+  // can be reused by a later NewStateFromPool call. It is safe to release any
+  // state of this game; states that do not support CloneInto are simply
+  // deallocated.
+  void ReleaseStateToPool(std::unique_ptr<State> state) const;
+
   // Maximum number of chance outcomes for each chance node.
   virtual int MaxChanceOutcomes() const { return 0; }
 
@@ -520,6 +1123,7 @@ class Game {
   // values, including defaulted values. Returns empty parameters otherwise.
   GameParameters GetParameters() const {
     GameParameters params = game_parameters_;
+    std::lock_guard<std::mutex> lock(defaulted_parameters_mutex_);
     params.insert(defaulted_parameters_.begin(), defaulted_parameters_.end());
     return params;
   }
@@ -587,6 +1191,26 @@ class Game {
                                            std::multiplies<double>());
   }
 
+  // Writes the normalized information state vectors of `states`, each from
+  // the perspective of its current player, contiguously into `buffer` as a
+  // [states.size(), InformationStateNormalizedVectorShape()] tensor in
+  // row-major order. The buffer is owned by the caller (e.g. a slab of a
+  // learner's input tensor) and must hold at least
+  // states.size() * InformationStateNormalizedVectorSize() entries. No
+  // intermediate per-state vectors are allocated for games that override
+  // State::InformationStateAsNormalizedVector(int, double*).
+  void BatchInformationStateNormalizedVectors(
+      const std::vector<const State*>& states, double* buffer) const;
+  void BatchInformationStateNormalizedVectors(
+      const std::vector<const State*>& states, float* buffer) const;
+
+  // Same as above for the normalized observation vectors; the buffer must
+  // hold at least states.size() * ObservationNormalizedVectorSize() entries.
+  void BatchObservationNormalizedVectors(
+      const std::vector<const State*>& states, double* buffer) const;
+  void BatchObservationNormalizedVectors(
+      const std::vector<const State*>& states, float* buffer) const;
+
   // Serializes a state into a string.
   //
   // The default implementation writes out a sequence of actions, one per line,
@@ -610,6 +1234,20 @@ class Game {
   // Game::SerializeState (i.e. it should also be overridden).
   virtual std::unique_ptr<State> DeserializeState(const std::string& str) const;
 
+  // Binary counterparts of SerializeState / DeserializeState, intended for
+  // checkpointing and for shipping states between workers, where parsing the
+  // text form is too slow.
+  //
+  // The default implementation writes the history as a varint-coded action
+  // sequence and deserializes by replaying it, so it shares SerializeState's
+  // kSampledStochastic restriction. Games can override the pair with a direct
+  // snapshot of their state to avoid the replay entirely (see backgammon);
+  // deserialized snapshots then start with an empty history, as with the
+  // overrides of SerializeState.
+  virtual std::string SerializeStateBinary(const State& state) const;
+  virtual std::unique_ptr<State> DeserializeStateBinary(
+      const std::string& str) const;
+
   // Maximum length of any one game (in terms of number of decision nodes
   // visited in the game tree). For a simultaneous action game, this is the
   // maximum number of joint decisions. In a turn-based game, this is the
@@ -617,6 +1255,17 @@ class Game {
   // of chance nodes are not included in this length.
   virtual int MaxGameLength() const = 0;
 
+  // Preallocation hints for tabular algorithms: the expected number of
+  // distinct information states (summed over players) and of distinct
+  // histories, or -1 when unknown. Unlike MaxGameLength and
+  // NumDistinctActions these are not bounds; they are sizing hints, ideally
+  // taken from measured counts (see algorithms/game_stats.h), that let
+  // solvers reserve their hash tables up front instead of rehashing — and
+  // transiently doubling — a large table as it fills. Consumers must accept
+  // any hint value, including -1.
+  virtual int64_t ExpectedNumInfoStates() const { return -1; }
+  virtual int64_t ExpectedNumHistories() const { return -1; }
+
   // A string representation of the game, which can be passed to LoadGame.
   std::string ToString() const;
 
@@ -624,6 +1273,14 @@ class Game {
   Game(GameType game_type, GameParameters game_parameters)
       : game_type_(game_type), game_parameters_(game_parameters) {}
 
+  // Games are copyable (e.g. in Game::Clone implementations), but the state
+  // pool is deliberately per-instance and is not copied along.
+  Game(const Game& other)
+      : game_type_(other.game_type_), game_parameters_(other.game_parameters_) {
+    std::lock_guard<std::mutex> lock(other.defaulted_parameters_mutex_);
+    defaulted_parameters_ = other.defaulted_parameters_;
+  }
+
   // Access to game parameters.
   template <typename T>
   T ParameterValue(const std::string& key) const;
@@ -640,8 +1297,18 @@ class Game {
   GameParameters game_parameters_;
 
   // Track the parameters for which a default value has been used. This
-  // enables us to report the actual value used for every parameter.
+  // enables us to report the actual value used for every parameter. Guarded
+  // by the mutex since ParameterValue is const and so may, in principle, run
+  // on a game already shared between threads.
   mutable GameParameters defaulted_parameters_;
+  mutable std::mutex defaulted_parameters_mutex_;
+
+ private:
+  // State pool; see NewStateFromPool. These are mutable since drawing a state
+  // from the pool does not conceptually modify the game.
+  mutable std::mutex state_pool_mutex_;
+  mutable std::vector<std::unique_ptr<State>> state_pool_;
+  mutable std::unique_ptr<State> initial_state_template_;
 };
 
 #define CONCAT_(x, y) x##y
@@ -662,17 +1329,33 @@ class GameRegisterer {
   static std::vector<std::string> RegisteredNames();
   static std::vector<GameType> RegisteredGames();
   static bool IsValidName(const std::string& short_name);
+
+  // Registers a game. The GameType is held by reference rather than copied,
+  // so it must outlive the registry; every caller passes the game's static
+  // kGameType.
   static void RegisterGame(const GameType& game_type, CreateFunc creator);
 
  private:
-  // Returns a "global" map of registrations (i.e. an object that lives from
+  struct Registration {
+    const GameType* game_type;
+    CreateFunc creator;
+  };
+
+  // Returns a "global" list of registrations (i.e. an object that lives from
   // initialization to the end of the program). Note that we do not just use
-  // a static data member, as we want the map to be initialized before first
-  // use.
-  static std::map<std::string, std::pair<GameType, CreateFunc>>& factories() {
-    static std::map<std::string, std::pair<GameType, CreateFunc>> impl;
+  // a static data member, as we want the list to be initialized before first
+  // use. Registering appends here at static-initialization time; the name
+  // lookup map is only built on first use (see factories() in spiel.cc), so
+  // linking a game into a binary costs an append at startup rather than a
+  // map insertion and a copy of the game's metadata.
+  static std::vector<Registration>& registrations() {
+    static std::vector<Registration> impl;
     return impl;
   }
+
+  // Returns the map from short name to index into registrations(), folding
+  // in any registrations made since the last call.
+  static const std::map<std::string, int>& factories();
 };
 
 // Returns true if the game is registered, false otherwise.
@@ -697,6 +1380,20 @@ std::unique_ptr<Game> LoadGame(const std::string& short_name,
 // implementation).
 std::unique_ptr<Game> LoadGame(GameParameters params);
 
+// As LoadGame, but interns the loaded games: repeated calls with the same
+// canonical parameter string return the same shared instance, so callers
+// that load per episode or per match pay a map lookup instead of a game
+// construction, and big per-game precomputations happen once per process.
+// Game is immutable after construction, so sharing an instance is safe.
+// Cached games live for the rest of the process. Note that the key is the
+// parameter map itself (looked up via its digest, see
+// GameParametersDigest), so loads that spell a default parameter out
+// explicitly get their own (equivalent) instance.
+std::shared_ptr<const Game> LoadGameCached(const std::string& game_string);
+std::shared_ptr<const Game> LoadGameCached(const std::string& short_name,
+                                           const GameParameters& params);
+std::shared_ptr<const Game> LoadGameCached(GameParameters params);
+
 // Used to sample a policy. Can also sample from chance outcomes.
 // Probabilities of the actions must sum to 1.
 // The parameter z should be a sample from a uniform distribution on the range
@@ -45,6 +45,16 @@ class Bot {
   // new bot.
   virtual void Restart(const State& state) {}
 
+  // Optional snapshot support, used to migrate a bot between processes.
+  // Serialize appends a binary snapshot of the bot's internal state (search
+  // trees, accumulated statistics) to *buffer; Restore rebuilds that state
+  // from a snapshot taken by an identically configured bot on the same
+  // game, and should fail fatally on a corrupt or mismatched snapshot.
+  // Bots without internal state worth keeping need not override these; the
+  // defaults write and restore nothing.
+  virtual void Serialize(std::string* buffer) const {}
+  virtual void Restore(const std::string& buffer) {}
+
  protected:
   const Game& game_;
   int player_id_;
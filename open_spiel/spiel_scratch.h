@@ -0,0 +1,85 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_SPIEL_SCRATCH_H_
+#define THIRD_PARTY_OPEN_SPIEL_SPIEL_SCRATCH_H_
+
+#include <utility>
+#include <vector>
+
+// Per-thread scratch buffers for hot State methods. Several games need a
+// temporary container inside DoApplyAction or LegalActions (move lists,
+// flood-fill stacks, digit buffers for action unranking); allocating it per
+// call puts the allocator on the hottest paths in the library. A
+// ScratchVector instead borrows a buffer from a pool owned by the calling
+// thread and returns it on destruction, so across calls the buffer keeps
+// its grown capacity and the steady-state cost is a clear().
+//
+// The pool is thread-local: no synchronization is involved, and concurrent
+// searches on different threads get distinct buffers. Nested uses with the
+// same element type also get distinct buffers, since each live
+// ScratchVector holds its buffer out of the pool. A handle must not
+// outlive the scope that created it or be handed to another thread.
+//
+// Usage:
+//   ScratchVector<int> stack;
+//   stack->push_back(root);
+//   while (!stack->empty()) { ... }
+
+namespace open_spiel {
+
+namespace internal {
+
+// The calling thread's pool of idle scratch buffers of element type T.
+template <typename T>
+std::vector<std::vector<T>>& ScratchPool() {
+  static thread_local std::vector<std::vector<T>> pool;
+  return pool;
+}
+
+}  // namespace internal
+
+template <typename T>
+class ScratchVector {
+ public:
+  // Borrows a buffer from the thread's pool (empty, but with whatever
+  // capacity it grew on earlier borrows), or starts a fresh one if every
+  // buffer is currently in use.
+  ScratchVector() {
+    std::vector<std::vector<T>>& pool = internal::ScratchPool<T>();
+    if (!pool.empty()) {
+      buffer_ = std::move(pool.back());
+      pool.pop_back();
+      buffer_.clear();
+    }
+  }
+
+  ~ScratchVector() {
+    internal::ScratchPool<T>().push_back(std::move(buffer_));
+  }
+
+  ScratchVector(const ScratchVector&) = delete;
+  ScratchVector& operator=(const ScratchVector&) = delete;
+
+  std::vector<T>& operator*() { return buffer_; }
+  std::vector<T>* operator->() { return &buffer_; }
+  std::vector<T>* get() { return &buffer_; }
+
+ private:
+  std::vector<T> buffer_;
+};
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_SPIEL_SCRATCH_H_
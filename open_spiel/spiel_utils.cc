@@ -14,8 +14,15 @@
 
 #include "open_spiel/spiel_utils.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace open_spiel {
 
@@ -36,6 +43,131 @@ int PreviousPlayerRoundRobin(int player, int nplayers) {
   }
 }
 
+void AppendVarint(uint64_t value, std::string* buffer) {
+  do {
+    uint8_t byte = value & 0x7f;
+    value >>= 7;
+    if (value != 0) byte |= 0x80;
+    buffer->push_back(static_cast<char>(byte));
+  } while (value != 0);
+}
+
+uint64_t ReadVarint(const uint8_t* data, std::size_t size,
+                    std::size_t* offset) {
+  uint64_t value = 0;
+  int shift = 0;
+  while (true) {
+    if (*offset >= size) {
+      SpielFatalError("Buffer truncated inside a varint.");
+    }
+    uint8_t byte = data[(*offset)++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+    shift += 7;
+  }
+}
+
+void AppendInt(int64_t value, std::string* out) {
+  // Digits are produced in reverse into a local buffer; the negation goes
+  // through uint64_t so that INT64_MIN does not overflow.
+  char buffer[20];
+  char* cursor = buffer + sizeof(buffer);
+  uint64_t magnitude =
+      value < 0 ? -static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  do {
+    *--cursor = '0' + static_cast<char>(magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (value < 0) *--cursor = '-';
+  out->append(cursor, buffer + sizeof(buffer) - cursor);
+}
+
+void AppendDouble(double value, std::string* out) {
+  // 15 significant digits suffice for most doubles and 17 always round-trip;
+  // try the short forms first and verify by parsing back, so the output is
+  // both compact and lossless.
+  char buffer[32];
+  for (int precision = 15; precision <= 17; ++precision) {
+    int length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision,
+                               value);
+    if (precision == 17 || std::strtod(buffer, nullptr) == value) {
+      out->append(buffer, length);
+      return;
+    }
+  }
+}
+
+std::string FormatDouble(double value) {
+  std::string out;
+  AppendDouble(value, &out);
+  return out;
+}
+
+void SymmetryTransformCell(int transform, int rows, int cols, int row,
+                           int col, int* trow, int* tcol) {
+  SPIEL_CHECK_GE(transform, 0);
+  SPIEL_CHECK_LT(transform, kNumBoardSymmetries);
+  if (transform % 2 == 1) SPIEL_CHECK_EQ(rows, cols);
+  switch (transform) {
+    case 0: *trow = row; *tcol = col; break;               // Identity.
+    case 1: *trow = col; *tcol = rows - 1 - row; break;    // 90 degrees.
+    case 2: *trow = rows - 1 - row; *tcol = cols - 1 - col; break;  // 180.
+    case 3: *trow = cols - 1 - col; *tcol = row; break;    // 270 degrees.
+    case 4: *trow = row; *tcol = cols - 1 - col; break;    // Mirror.
+    case 5: *trow = col; *tcol = row; break;               // Transpose.
+    case 6: *trow = rows - 1 - row; *tcol = col; break;    // Flip.
+    default: *trow = cols - 1 - col; *tcol = rows - 1 - row; break;
+  }
+}
+
+std::string CanonicalSquareBoardKey(const std::string& grid, int size) {
+  SPIEL_CHECK_EQ(static_cast<int>(grid.size()), size * size);
+  std::string best = grid;
+  std::string transformed(grid.size(), '\0');
+  for (int t = 1; t < kNumBoardSymmetries; ++t) {
+    for (int row = 0; row < size; ++row) {
+      for (int col = 0; col < size; ++col) {
+        int trow, tcol;
+        SymmetryTransformCell(t, size, size, row, col, &trow, &tcol);
+        transformed[trow * size + tcol] = grid[row * size + col];
+      }
+    }
+    if (transformed < best) best = transformed;
+  }
+  return best;
+}
+
+std::vector<int> SymmetryCellPermutation(int rows, int cols, int transform) {
+  std::vector<int> permutation(rows * cols);
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      int trow, tcol;
+      SymmetryTransformCell(transform, rows, cols, row, col, &trow, &tcol);
+      permutation[row * cols + col] = trow * cols + tcol;
+    }
+  }
+  return permutation;
+}
+
+void SymmetryTransformPlanes(const std::vector<int>& shape, int transform,
+                             const double* input, double* output) {
+  SPIEL_CHECK_EQ(static_cast<int>(shape.size()), 3);
+  const int planes = shape[0];
+  const int rows = shape[1];
+  const int cols = shape[2];
+  const int plane_size = rows * cols;
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      int trow, tcol;
+      SymmetryTransformCell(transform, rows, cols, row, col, &trow, &tcol);
+      for (int plane = 0; plane < planes; ++plane) {
+        output[plane * plane_size + trow * cols + tcol] =
+            input[plane * plane_size + row * cols + col];
+      }
+    }
+  }
+}
+
 std::pair<bool, std::string> ParseCmdLineArg(int argc, char** argv,
                                              const std::string& name) {
   std::string prefix = "--" + name + "=";
@@ -61,6 +193,16 @@ std::string ParseCmdLineArgDefault(int argc, char** argv,
   }
 }
 
+std::ostream& operator<<(std::ostream& stream, const FastRng& rng) {
+  return stream << rng.state_[0] << " " << rng.state_[1] << " "
+                << rng.state_[2] << " " << rng.state_[3];
+}
+
+std::istream& operator>>(std::istream& stream, FastRng& rng) {
+  return stream >> rng.state_[0] >> rng.state_[1] >> rng.state_[2] >>
+         rng.state_[3];
+}
+
 // Used to convert actions represented as integers in mixed bases.
 Action RankActionMixedBase(const std::vector<int>& bases,
                            const std::vector<int>& digits) {
@@ -110,4 +252,176 @@ void SpielFatalError(const std::string& error_msg) {
   std::exit(1);
 }
 
+namespace stats {
+namespace {
+
+// Registration takes the mutex; the hot path only touches the atomics in
+// the returned entries. std::map nodes are stable, so the references handed
+// out stay valid as the registry grows.
+struct StatsRegistry {
+  std::mutex mutex;
+  std::map<std::string, Counter> counters;
+  std::map<std::string, Gauge> gauges;
+  std::map<std::string, TimerStat> timers;
+};
+
+StatsRegistry& Registry() {
+  static StatsRegistry* registry = new StatsRegistry();
+  return *registry;
+}
+
+// Appends `s` as a JSON string, quotes included. Stat names are plain
+// identifiers in practice, but the escaping keeps the output well-formed
+// for any name.
+void AppendJsonString(std::string* out, const std::string& s) {
+  out->push_back('"');
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        absl::StrAppend(out, "\\\"");
+        break;
+      case '\\':
+        absl::StrAppend(out, "\\\\");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+          absl::StrAppend(out, buf);
+        } else {
+          out->push_back(c);
+        }
+    }
+  }
+  out->push_back('"');
+}
+
+}  // namespace
+
+Counter& GetCounter(const std::string& name) {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.counters[name];
+}
+
+TimerStat& GetTimer(const std::string& name) {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.timers[name];
+}
+
+Gauge& GetGauge(const std::string& name) {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.gauges[name];
+}
+
+std::string DumpStats() {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::string report;
+  for (const auto& name_and_counter : registry.counters) {
+    absl::StrAppend(&report, name_and_counter.first, ": ",
+                    name_and_counter.second.value.load(), "\n");
+  }
+  for (const auto& name_and_gauge : registry.gauges) {
+    absl::StrAppend(&report, name_and_gauge.first, ": ",
+                    name_and_gauge.second.value.load(), "\n");
+  }
+  for (const auto& name_and_timer : registry.timers) {
+    const int64_t count = name_and_timer.second.count.load();
+    const double seconds = name_and_timer.second.nanos.load() * 1e-9;
+    char line[64];
+    std::snprintf(line, sizeof(line), "%.6fs over %lld calls",
+                  seconds, static_cast<long long>(count));
+    absl::StrAppend(&report, name_and_timer.first, ": ", line, "\n");
+  }
+  return report;
+}
+
+std::string StatsAsJsonLine() {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const int64_t time_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  std::string line = absl::StrCat("{\"time_ms\":", time_ms, ",\"counters\":{");
+  bool first = true;
+  for (const auto& name_and_counter : registry.counters) {
+    if (!first) line.push_back(',');
+    first = false;
+    AppendJsonString(&line, name_and_counter.first);
+    absl::StrAppend(&line, ":", name_and_counter.second.value.load());
+  }
+  absl::StrAppend(&line, "},\"gauges\":{");
+  first = true;
+  for (const auto& name_and_gauge : registry.gauges) {
+    if (!first) line.push_back(',');
+    first = false;
+    AppendJsonString(&line, name_and_gauge.first);
+    absl::StrAppend(&line, ":", name_and_gauge.second.value.load());
+  }
+  absl::StrAppend(&line, "},\"timers\":{");
+  first = true;
+  for (const auto& name_and_timer : registry.timers) {
+    if (!first) line.push_back(',');
+    first = false;
+    AppendJsonString(&line, name_and_timer.first);
+    // FormatDouble always yields a valid JSON number.
+    absl::StrAppend(&line, ":{\"seconds\":",
+                    FormatDouble(name_and_timer.second.nanos.load() * 1e-9),
+                    ",\"count\":", name_and_timer.second.count.load(), "}");
+  }
+  absl::StrAppend(&line, "}}");
+  return line;
+}
+
+void ResetStats() {
+  StatsRegistry& registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& name_and_counter : registry.counters) {
+    name_and_counter.second.value.store(0);
+  }
+  for (auto& name_and_gauge : registry.gauges) {
+    name_and_gauge.second.value.store(0);
+  }
+  for (auto& name_and_timer : registry.timers) {
+    name_and_timer.second.nanos.store(0);
+    name_and_timer.second.count.store(0);
+  }
+}
+
+JsonlStatsWriter::JsonlStatsWriter(const std::string& filename, int period_ms)
+    : filename_(filename), period_ms_(period_ms) {
+  SPIEL_CHECK_GT(period_ms, 0);
+  thread_ = std::thread(&JsonlStatsWriter::Loop, this);
+}
+
+JsonlStatsWriter::~JsonlStatsWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stop_cv_.notify_one();
+  thread_.join();
+}
+
+void JsonlStatsWriter::Loop() {
+  std::ofstream file(filename_, std::ios::app);
+  if (!file.is_open()) {
+    SpielFatalError("JsonlStatsWriter: cannot open " + filename_);
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  // The final iteration — after stop_ is set — writes one last snapshot, so
+  // the file always ends with the run's closing totals.
+  bool done = false;
+  while (!done) {
+    done = stop_cv_.wait_for(lock, std::chrono::milliseconds(period_ms_),
+                             [this] { return stop_; });
+    file << StatsAsJsonLine() << "\n" << std::flush;
+  }
+}
+
+}  // namespace stats
 }  // namespace open_spiel
@@ -16,11 +16,20 @@
 #define THIRD_PARTY_OPEN_SPIEL_SPIEL_UTILS_H_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <locale>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -33,6 +42,28 @@
 
 // Code that is not part of the API, but is widely useful in implementations
 
+// Portable branch hints and prefetch requests. All of these are advisory.
+// SPIEL_LIKELY/SPIEL_UNLIKELY mark a condition as almost always true resp.
+// false, steering code layout so the common path falls through.
+// SPIEL_PREFETCH(addr) / SPIEL_PREFETCH_WRITE(addr) request the cache line
+// holding `addr` ahead of a read resp. write, hiding the memory latency of
+// a probe whose address is known early — the next slot of a table walk, the
+// next child of a node — behind the work on the current one. On compilers
+// without the builtins they compile to nothing and change nothing. Reserve
+// them for loops where a profile shows the stall or mispredict: a wrong
+// hint is worse than none.
+#if defined(__GNUC__) || defined(__clang__)
+#define SPIEL_LIKELY(x) __builtin_expect(!!(x), 1)
+#define SPIEL_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define SPIEL_PREFETCH(addr) __builtin_prefetch((addr), /*rw=*/0)
+#define SPIEL_PREFETCH_WRITE(addr) __builtin_prefetch((addr), /*rw=*/1)
+#else
+#define SPIEL_LIKELY(x) (x)
+#define SPIEL_UNLIKELY(x) (x)
+#define SPIEL_PREFETCH(addr) ((void)(addr))
+#define SPIEL_PREFETCH_WRITE(addr) ((void)(addr))
+#endif
+
 namespace open_spiel {
 
 // Generic ostream operator<< overloads for std:: containers. They have to be
@@ -83,6 +114,130 @@ std::string SpielStrCat(Args&&... args) {
 
 using Action = int64_t;
 
+// A copy-on-write action sequence, used by State for its history. The
+// actions are stored in fixed-size chunks that copies share, so copying the
+// history (e.g. in State::Clone) duplicates one pointer per kChunkSize
+// actions instead of the actions themselves; a chunk is only deep-copied
+// when a holder appends over a slot it still shares with another copy. The
+// interface is the subset of std::vector that history users rely on.
+class ActionHistory {
+ public:
+  static constexpr int kChunkSize = 64;
+
+  ActionHistory() = default;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  Action operator[](size_t index) const {
+    return (*chunks_[index / kChunkSize])[index % kChunkSize];
+  }
+  Action back() const { return (*this)[size_ - 1]; }
+
+  void push_back(Action action) {
+    const size_t chunk = size_ / kChunkSize;
+    if (chunk == chunks_.size()) {
+      chunks_.push_back(std::make_shared<Chunk>());
+    } else if (chunks_[chunk].use_count() > 1) {
+      // Detach from the copies still sharing this chunk before writing.
+      chunks_[chunk] = std::make_shared<Chunk>(*chunks_[chunk]);
+    }
+    (*chunks_[chunk])[size_ % kChunkSize] = action;
+    ++size_;
+  }
+
+  // Removes the last action. The vacated slot is only overwritten by a later
+  // push_back, which detaches from any copy still sharing the chunk first.
+  void pop_back() {
+    --size_;
+    if (size_ % kChunkSize == 0) chunks_.pop_back();
+  }
+
+  void clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+  std::vector<Action> ToVector() const {
+    std::vector<Action> actions;
+    actions.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) actions.push_back((*this)[i]);
+    return actions;
+  }
+
+  // An input iterator over the actions: enough for range-for loops and
+  // absl::StrJoin, which is all the history users need.
+  class const_iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Action;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Action*;
+    using reference = Action;
+
+    const_iterator(const ActionHistory* history, size_t index)
+        : history_(history), index_(index) {}
+    Action operator*() const { return (*history_)[index_]; }
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const ActionHistory* history_;
+    size_t index_;
+  };
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+ private:
+  using Chunk = std::array<Action, kChunkSize>;
+
+  // Invariant: chunks_.size() * kChunkSize is the smallest multiple of
+  // kChunkSize that covers size_ actions.
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  size_t size_ = 0;
+};
+
+// A non-owning, read-only view of a contiguous sequence of T: a pre-C++20
+// stand-in for std::span<const T>. Accessors whose data already lives inside
+// the callee return one of these instead of a freshly copied std::vector;
+// the view is cheap to copy, intended to be passed by value, and valid only
+// as long as the storage it points into (for State accessors, until the
+// state next changes).
+template <typename T>
+class Span {
+ public:
+  Span() : data_(nullptr), size_(0) {}
+  Span(const T* data, std::size_t size) : data_(data), size_(size) {}
+  // Deliberately implicit, so functions taking a Span<T> accept a vector.
+  Span(const std::vector<T>& v) : data_(v.data()), size_(v.size()) {}
+  template <std::size_t N>
+  Span(const std::array<T, N>& a) : data_(a.data()), size_(N) {}
+
+  const T* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const T& operator[](std::size_t index) const { return data_[index]; }
+  const T& front() const { return data_[0]; }
+  const T& back() const { return data_[size_ - 1]; }
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+
+  // Materializes an owned copy, for the callers that do need one.
+  std::vector<T> ToVector() const { return std::vector<T>(begin(), end()); }
+
+ private:
+  const T* data_;
+  std::size_t size_;
+};
+
 // Floating point comparisons use this as a multiplier on the larger of the two
 // numbers as the threshold.
 constexpr float FloatingPointDefaultThresholdRatio() { return 1e-5; }
@@ -101,6 +256,143 @@ std::string ParseCmdLineArgDefault(int argc, char** argv,
                                    const std::string& name,
                                    const std::string& default_value);
 
+// A small, fast uniform random bit generator (xoshiro256++), usable with
+// the <random> distributions anywhere reproducibility against std::mt19937
+// is not required. Compared to mt19937 it advances in a handful of cycles
+// and its state is 32 bytes rather than ~2.5KB, which matters when every
+// rollout, actor or search worker keeps a generator of its own.
+class FastRng {
+ public:
+  using result_type = uint64_t;
+
+  // Seeds are expanded through SplitMix64, so nearby seeds (thread ids,
+  // episode counters) still give unrelated streams.
+  explicit FastRng(uint64_t seed = 0) {
+    for (int i = 0; i < 4; ++i) {
+      seed += 0x9e3779b97f4a7c15ULL;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      state_[i] = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type(0); }
+
+  result_type operator()() {
+    const uint64_t result = Rotl(state_[0] + state_[3], 23) + state_[0];
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = Rotl(state_[3], 45);
+    return result;
+  }
+
+  // Stream the state in and out, as the standard engines do, so generators
+  // can be checkpointed.
+  friend std::ostream& operator<<(std::ostream& stream, const FastRng& rng);
+  friend std::istream& operator>>(std::istream& stream, FastRng& rng);
+
+ private:
+  static uint64_t Rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  uint64_t state_[4];
+};
+
+std::ostream& operator<<(std::ostream& stream, const FastRng& rng);
+std::istream& operator>>(std::istream& stream, FastRng& rng);
+
+// Unsigned LEB128 varint coding, used for compact binary serialization of
+// non-negative integers. ReadVarint advances *offset past the bytes it
+// consumed and fails fatally if the buffer ends inside a varint.
+void AppendVarint(uint64_t value, std::string* buffer);
+uint64_t ReadVarint(const uint8_t* data, std::size_t size,
+                    std::size_t* offset);
+
+// Fast decimal number formatting for the text serialization and ToString
+// paths, which would otherwise go through iostreams (which lock a shared
+// locale) or lose precision. AppendInt writes the digits directly.
+// AppendDouble writes the shortest fixed-or-scientific decimal form that
+// strtod parses back to exactly the same double — most doubles need far
+// fewer than the 17 significant digits that always round-trip — so
+// serializing a probability through it is lossless.
+void AppendInt(int64_t value, std::string* out);
+void AppendDouble(double value, std::string* out);
+std::string FormatDouble(double value);
+
+// Board symmetry transforms, numbered 0..7: 0 identity, 1/2/3 rotations by
+// 90/180/270 degrees, 4 left-right mirror, 5 transpose, 6 top-bottom flip,
+// 7 anti-transpose. The odd-numbered transforms swap rows and columns and
+// are only valid on square boards.
+constexpr int kNumBoardSymmetries = 8;
+
+// Maps the cell (row, col) of a rows x cols board to its position under
+// the transform.
+void SymmetryTransformCell(int transform, int rows, int cols, int row,
+                           int col, int* trow, int* tcol);
+
+// The cell permutation of a transform: entry row * cols + col is the
+// transformed cell index. Games whose action ids index board cells use
+// this to permute action policies alongside transformed observations.
+std::vector<int> SymmetryCellPermutation(int rows, int cols, int transform);
+
+// Applies the transform to a plane-major observation tensor of the given
+// {planes, rows, cols} shape, transforming every plane's board layout in
+// one pass. input and output must not alias and both hold
+// planes * rows * cols entries.
+void SymmetryTransformPlanes(const std::vector<int>& shape, int transform,
+                             const double* input, double* output);
+
+// The lexicographic minimum of a square board grid (row-major, size * size
+// entries, one char per cell) over its 8 rotations and reflections. Games
+// on square boards use this to implement State::CanonicalKey.
+std::string CanonicalSquareBoardKey(const std::string& grid, int size);
+
+// An amortized wall-clock budget for search loops. Expired() consults the
+// clock only once every check_interval calls, so it is cheap enough to call
+// per node or per simulation, and it latches: once the deadline has passed
+// it stays expired. A non-positive max_seconds means no limit.
+class SearchDeadline {
+ public:
+  explicit SearchDeadline(double max_seconds, int check_interval = 64)
+      : unlimited_(max_seconds <= 0),
+        countdown_(check_interval),
+        check_interval_(check_interval) {
+    if (!unlimited_) {
+      deadline_ = std::chrono::steady_clock::now() +
+                  std::chrono::duration_cast<
+                      std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(max_seconds));
+    }
+  }
+
+  bool Expired() {
+    if (expired_) return true;
+    if (unlimited_) return false;
+    if (--countdown_ > 0) return false;
+    countdown_ = check_interval_;
+    expired_ = std::chrono::steady_clock::now() >= deadline_;
+    return expired_;
+  }
+
+  // Whether a previous call to Expired() hit the deadline; does not consult
+  // the clock.
+  bool HasExpired() const { return expired_; }
+
+ private:
+  std::chrono::steady_clock::time_point deadline_;
+  bool unlimited_;
+  bool expired_ = false;
+  int countdown_;
+  int check_interval_;
+};
+
 // Helpers used to convert actions represented as integers in mixed bases.
 // E.g. RankActionMixedBase({2, 3, 6}, {1, 1, 1}) = 1*18 + 1*6 + 1 = 25,
 // and UnrankActioMixedBase(25, {2, 3, 6}, &digits) sets digits to {1, 1, 1}.
@@ -138,12 +430,45 @@ bool Near(T a, T b, T epsilon) {
 
 // Macros to check for error conditions.
 // These trigger SpielFatalError if the condition is violated.
+//
+// The checks compile at one of three levels, selected by defining
+// SPIEL_CHECK_LEVEL (the OPEN_SPIEL_CHECK_LEVEL CMake variable sets it for
+// the whole build; target_compile_definitions can set it per target):
+//   2 (debug):        SPIEL_CHECK_* and SPIEL_DCHECK_* are both active.
+//   1 (standard):     SPIEL_CHECK_* is active and SPIEL_DCHECK_* compiles
+//                     to nothing. This is the default and matches the
+//                     historical behavior.
+//   0 (release-fast): both families compile to nothing. Validation done
+//                     with explicit SpielFatalError calls — the checks at
+//                     API entry points — is unaffected and fires at every
+//                     level.
+// A compiled-out check does not evaluate its arguments, so check
+// expressions must be free of side effects.
+//
+// Use SPIEL_DCHECK_* for validation inside hot inner loops (move
+// generation, per-action or per-child bookkeeping) where the comparison
+// itself shows up in profiles; use SPIEL_CHECK_* everywhere else.
+
+#ifndef SPIEL_CHECK_LEVEL
+#define SPIEL_CHECK_LEVEL 1
+#endif
+
+// Body of a disabled comparison check. The (void)(false && ...) form
+// compiles the expressions (so a disabled check cannot silently rot, and
+// variables only used in checks stay used) without evaluating them, and
+// generates no code.
+#define SPIEL_CHECK_OP_DISABLED(x_exp, op, y_exp) \
+  do {                                            \
+    (void)(false && ((x_exp)op(y_exp)));          \
+  } while (false)
+
+#if SPIEL_CHECK_LEVEL >= 1
 
 #define SPIEL_CHECK_OP(x_exp, op, y_exp)                             \
   do {                                                               \
     auto x = x_exp;                                                  \
     auto y = y_exp;                                                  \
-    if (!((x)op(y)))                                                 \
+    if (SPIEL_UNLIKELY(!((x)op(y))))                                 \
       open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat( \
           __FILE__, ":", __LINE__, " ", #x_exp " " #op " " #y_exp,   \
           "\n" #x_exp, " = ", x, ", " #y_exp " = ", y));             \
@@ -153,7 +478,7 @@ bool Near(T a, T b, T epsilon) {
   do {                                                                    \
     auto x = x_exp;                                                       \
     auto y = y_exp;                                                       \
-    if (!fn(x, y))                                                        \
+    if (SPIEL_UNLIKELY(!fn(x, y)))                                        \
       open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat(      \
           __FILE__, ":", __LINE__, " ", #fn "(" #x_exp ", " #y_exp ")\n", \
           #x_exp " = ", x, ", " #y_exp " = ", y));                        \
@@ -164,13 +489,30 @@ bool Near(T a, T b, T epsilon) {
     auto x = x_exp;                                                      \
     auto y = y_exp;                                                      \
     auto z = z_exp;                                                      \
-    if (!fn(x, y, z))                                                    \
+    if (SPIEL_UNLIKELY(!fn(x, y, z)))                                    \
       open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat(     \
           __FILE__, ":", __LINE__, " ",                                  \
           #fn "(" #x_exp ", " #y_exp ", " #z_exp ")\n", #x_exp " = ", x, \
           ", " #y_exp " = ", y, ", " #z_exp " = ", z));                  \
   } while (false)
 
+#else  // SPIEL_CHECK_LEVEL == 0
+
+#define SPIEL_CHECK_OP(x_exp, op, y_exp) \
+  SPIEL_CHECK_OP_DISABLED(x_exp, op, y_exp)
+
+#define SPIEL_CHECK_FN2(x_exp, y_exp, fn) \
+  do {                                    \
+    (void)(false && fn(x_exp, y_exp));    \
+  } while (false)
+
+#define SPIEL_CHECK_FN3(x_exp, y_exp, z_exp, fn) \
+  do {                                           \
+    (void)(false && fn(x_exp, y_exp, z_exp));    \
+  } while (false)
+
+#endif  // SPIEL_CHECK_LEVEL >= 1
+
 #define SPIEL_CHECK_GE(x, y) SPIEL_CHECK_OP(x, >=, y)
 #define SPIEL_CHECK_GT(x, y) SPIEL_CHECK_OP(x, >, y)
 #define SPIEL_CHECK_LE(x, y) SPIEL_CHECK_OP(x, <=, y)
@@ -186,16 +528,72 @@ bool Near(T a, T b, T epsilon) {
 #define SPIEL_CHECK_FLOAT_NEAR(x, y, epsilon) \
   SPIEL_CHECK_FN3(x, y, epsilon, Near)
 
+#if SPIEL_CHECK_LEVEL >= 1
+
 #define SPIEL_CHECK_TRUE(x)                                      \
-  while (!(x))                                                   \
+  while (SPIEL_UNLIKELY(!(x)))                                   \
   open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat( \
       __FILE__, ":", __LINE__, " CHECK_TRUE(", #x, ")"))
 
 #define SPIEL_CHECK_FALSE(x)                                     \
-  while (x)                                                      \
+  while (SPIEL_UNLIKELY(x))                                      \
   open_spiel::SpielFatalError(open_spiel::internal::SpielStrCat( \
       __FILE__, ":", __LINE__, " CHECK_FALSE(", #x, ")"))
 
+#else  // SPIEL_CHECK_LEVEL == 0
+
+#define SPIEL_CHECK_TRUE(x) \
+  do {                      \
+    (void)(false && (x));   \
+  } while (false)
+
+#define SPIEL_CHECK_FALSE(x) \
+  do {                       \
+    (void)(false && (x));    \
+  } while (false)
+
+#endif  // SPIEL_CHECK_LEVEL >= 1
+
+// The debug-level family, for hot-path validation; see the level comment
+// above. Each forwards to its SPIEL_CHECK_* counterpart at level 2 and
+// compiles to nothing below it.
+#if SPIEL_CHECK_LEVEL >= 2
+#define SPIEL_DCHECK_GE(x, y) SPIEL_CHECK_GE(x, y)
+#define SPIEL_DCHECK_GT(x, y) SPIEL_CHECK_GT(x, y)
+#define SPIEL_DCHECK_LE(x, y) SPIEL_CHECK_LE(x, y)
+#define SPIEL_DCHECK_LT(x, y) SPIEL_CHECK_LT(x, y)
+#define SPIEL_DCHECK_EQ(x, y) SPIEL_CHECK_EQ(x, y)
+#define SPIEL_DCHECK_NE(x, y) SPIEL_CHECK_NE(x, y)
+#define SPIEL_DCHECK_FLOAT_EQ(x, y) SPIEL_CHECK_FLOAT_EQ(x, y)
+#define SPIEL_DCHECK_FLOAT_NEAR(x, y, epsilon) \
+  SPIEL_CHECK_FLOAT_NEAR(x, y, epsilon)
+#define SPIEL_DCHECK_TRUE(x) SPIEL_CHECK_TRUE(x)
+#define SPIEL_DCHECK_FALSE(x) SPIEL_CHECK_FALSE(x)
+#else
+#define SPIEL_DCHECK_GE(x, y) SPIEL_CHECK_OP_DISABLED(x, >=, y)
+#define SPIEL_DCHECK_GT(x, y) SPIEL_CHECK_OP_DISABLED(x, >, y)
+#define SPIEL_DCHECK_LE(x, y) SPIEL_CHECK_OP_DISABLED(x, <=, y)
+#define SPIEL_DCHECK_LT(x, y) SPIEL_CHECK_OP_DISABLED(x, <, y)
+#define SPIEL_DCHECK_EQ(x, y) SPIEL_CHECK_OP_DISABLED(x, ==, y)
+#define SPIEL_DCHECK_NE(x, y) SPIEL_CHECK_OP_DISABLED(x, !=, y)
+#define SPIEL_DCHECK_FLOAT_EQ(x, y)     \
+  do {                                  \
+    (void)(false && Near((x), (y)));    \
+  } while (false)
+#define SPIEL_DCHECK_FLOAT_NEAR(x, y, epsilon)    \
+  do {                                            \
+    (void)(false && Near((x), (y), (epsilon)));   \
+  } while (false)
+#define SPIEL_DCHECK_TRUE(x) \
+  do {                       \
+    (void)(false && (x));    \
+  } while (false)
+#define SPIEL_DCHECK_FALSE(x) \
+  do {                        \
+    (void)(false && (x));     \
+  } while (false)
+#endif  // SPIEL_CHECK_LEVEL >= 2
+
 // When an error is encountered, OpenSpiel code should call SpielFatalError()
 // which will forward the message to the current error handler.
 // The default error handler outputs the error message to stderr, and exits
@@ -211,6 +609,144 @@ bool Near(T a, T b, T epsilon) {
 using ErrorHandler = void (*)(const std::string&);
 void SetErrorHandler(ErrorHandler error_handler);
 
+// Optional lightweight instrumentation. Call sites use the SPIEL_STATS_*
+// macros below; unless OPEN_SPIEL_ENABLE_STATS is defined at build time
+// (e.g. -DOPEN_SPIEL_ENABLE_STATS), the macros compile away to nothing.
+// When enabled, each call site resolves its counter or timer once (a
+// function-local static) and then pays one relaxed atomic add per event, so
+// the instrumented binary stays usable for performance work.
+namespace stats {
+
+struct Counter {
+  std::atomic<int64_t> value{0};
+};
+
+struct TimerStat {
+  std::atomic<int64_t> nanos{0};
+  std::atomic<int64_t> count{0};
+};
+
+// A gauge records the most recent value of some quantity that both grows
+// and shrinks (table sizes, arena bytes), where a running total would be
+// meaningless.
+struct Gauge {
+  std::atomic<int64_t> value{0};
+};
+
+// Return the counter, timer or gauge registered under this name, creating
+// it on first use. The returned reference stays valid for the process
+// lifetime, which is what lets call sites cache it in a static.
+Counter& GetCounter(const std::string& name);
+TimerStat& GetTimer(const std::string& name);
+Gauge& GetGauge(const std::string& name);
+
+// Adds the wall time between construction and destruction to the timer.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(TimerStat& timer)
+      : timer_(timer), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    timer_.nanos.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_)
+            .count(),
+        std::memory_order_relaxed);
+    timer_.count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  TimerStat& timer_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// A readable table of every counter, gauge and timer recorded so far, in
+// name order. Empty when nothing has been recorded (in particular, in
+// builds without OPEN_SPIEL_ENABLE_STATS).
+std::string DumpStats();
+
+// A snapshot of every stat as one line of JSON, without the trailing
+// newline:
+//   {"time_ms":<wall clock, ms since epoch>,
+//    "counters":{"name":N,...},"gauges":{...},
+//    "timers":{"name":{"seconds":S,"count":C},...}}
+// Counters are running totals since the last ResetStats, so consumers
+// derive rates (iterations/sec, nodes/sec) by differencing consecutive
+// lines; gauges are point-in-time values and stand on their own.
+std::string StatsAsJsonLine();
+
+// Zeroes all counters, gauges and timers (they stay registered).
+void ResetStats();
+
+// Appends a StatsAsJsonLine snapshot to `filename` every `period_ms`
+// milliseconds from a background thread, plus one final snapshot when the
+// writer is destroyed, so the file tails the run and still ends with a
+// complete picture after a short one. Construct one around the long-running
+// call and point any JSONL-speaking dashboard at the file.
+class JsonlStatsWriter {
+ public:
+  JsonlStatsWriter(const std::string& filename, int period_ms);
+  ~JsonlStatsWriter();
+
+  JsonlStatsWriter(const JsonlStatsWriter&) = delete;
+  JsonlStatsWriter& operator=(const JsonlStatsWriter&) = delete;
+
+ private:
+  void Loop();
+
+  const std::string filename_;
+  const int period_ms_;
+  bool stop_ = false;  // Guarded by mutex_.
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  std::thread thread_;
+};
+
+}  // namespace stats
+
+#ifdef OPEN_SPIEL_ENABLE_STATS
+
+#define SPIEL_STATS_CONCAT_(x, y) x##y
+#define SPIEL_STATS_CONCAT(x, y) SPIEL_STATS_CONCAT_(x, y)
+
+// Increments the counter `name` (a string literal) by one / by `amount`.
+#define SPIEL_STATS_INC(name) SPIEL_STATS_ADD(name, 1)
+#define SPIEL_STATS_ADD(name, amount)                            \
+  do {                                                           \
+    static open_spiel::stats::Counter& spiel_stats_counter =     \
+        open_spiel::stats::GetCounter(name);                     \
+    spiel_stats_counter.value.fetch_add((amount),                \
+                                        std::memory_order_relaxed); \
+  } while (false)
+
+// Sets the gauge `name` (a string literal) to `amount`.
+#define SPIEL_STATS_SET_GAUGE(name, amount)                     \
+  do {                                                          \
+    static open_spiel::stats::Gauge& spiel_stats_gauge =        \
+        open_spiel::stats::GetGauge(name);                      \
+    spiel_stats_gauge.value.store(                              \
+        static_cast<int64_t>(amount), std::memory_order_relaxed); \
+  } while (false)
+
+// Adds the wall time of the enclosing scope to the timer `name`.
+#define SPIEL_STATS_TIMER(name)                                            \
+  static open_spiel::stats::TimerStat& SPIEL_STATS_CONCAT(                 \
+      spiel_stats_timer_, __LINE__) = open_spiel::stats::GetTimer(name);   \
+  open_spiel::stats::ScopedTimer SPIEL_STATS_CONCAT(spiel_stats_scope_,    \
+                                                    __LINE__)(             \
+      SPIEL_STATS_CONCAT(spiel_stats_timer_, __LINE__))
+
+#else  // OPEN_SPIEL_ENABLE_STATS
+
+#define SPIEL_STATS_INC(name) ((void)0)
+#define SPIEL_STATS_ADD(name, amount) ((void)0)
+#define SPIEL_STATS_SET_GAUGE(name, amount) ((void)0)
+#define SPIEL_STATS_TIMER(name) ((void)0)
+
+#endif  // OPEN_SPIEL_ENABLE_STATS
+
 }  // namespace open_spiel
 
 #endif  // THIRD_PARTY_OPEN_SPIEL_SPIEL_UTILS_H_
@@ -14,10 +14,15 @@
 
 #include "open_spiel/tests/basic_tests.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 
 #include "open_spiel/game_transforms/turn_based_simultaneous_game.h"
 #include "open_spiel/spiel.h"
@@ -131,11 +136,110 @@ void LegalActionsMaskTest(const Game& game, const State& state,
   }
 
   SPIEL_CHECK_EQ(num_ones, legal_actions.size());
+
+  // The bitset variant must agree with the mask bit-for-bit, padding bits
+  // included, so overrides built from a game's internal representation are
+  // checked against its move generation here.
+  if (!state.IsSimultaneousNode()) {
+    std::vector<uint64_t> words(state.LegalActionsBitsetWords());
+    state.LegalActionsBitset(words.data());
+    for (int i = 0; i < game.NumDistinctActions(); ++i) {
+      SPIEL_CHECK_EQ((words[i / 64] >> (i % 64)) & 1, legal_actions_mask[i]);
+    }
+    for (int i = game.NumDistinctActions();
+         i < state.LegalActionsBitsetWords() * 64; ++i) {
+      SPIEL_CHECK_EQ((words[i / 64] >> (i % 64)) & 1, 0);
+    }
+  }
 }
 
 bool IsPowerOfTwo(int n) { return n == 0 || (n & (n - 1)) == 0; }
 
+// Finalizer of the SplitMix64 generator. The sketches split a hash into a
+// register index and a leading-zero count, so a weakly-mixed HashValue()
+// (e.g. one built from small integers) is spread over all 64 bits first.
+uint64_t MixHash(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
 }  // namespace
+
+SimCoverageTracker::HyperLogLog::HyperLogLog(int precision_bits)
+    : precision_bits_(precision_bits),
+      registers_(uint64_t{1} << precision_bits, 0) {
+  SPIEL_CHECK_GE(precision_bits, 4);
+  SPIEL_CHECK_LE(precision_bits, 18);
+}
+
+void SimCoverageTracker::HyperLogLog::Add(uint64_t hash) {
+  hash = MixHash(hash);
+  const uint64_t index = hash >> (64 - precision_bits_);
+  const uint64_t rest = hash << precision_bits_;
+  const uint8_t rank =
+      rest == 0 ? 64 - precision_bits_ + 1 : __builtin_clzll(rest) + 1;
+  if (rank > registers_[index]) registers_[index] = rank;
+}
+
+void SimCoverageTracker::HyperLogLog::Merge(const HyperLogLog& other) {
+  SPIEL_CHECK_EQ(precision_bits_, other.precision_bits_);
+  for (int i = 0; i < registers_.size(); ++i) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+double SimCoverageTracker::HyperLogLog::Estimate() const {
+  const double m = registers_.size();
+  double sum = 0;
+  int zeros = 0;
+  for (uint8_t reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    if (reg == 0) ++zeros;
+  }
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  const double raw = alpha * m * m / sum;
+  // Linear counting is the better estimator while most registers are still
+  // empty; the usual 2.5m threshold decides which regime we are in.
+  if (raw <= 2.5 * m && zeros > 0) {
+    return m * std::log(m / zeros);
+  }
+  return raw;
+}
+
+SimCoverageTracker::SimCoverageTracker(int precision_bits)
+    : precision_bits_(precision_bits),
+      states_(precision_bits),
+      info_states_(precision_bits) {}
+
+void SimCoverageTracker::RecordStateHash(uint64_t hash) {
+  states_.Add(hash);
+  ++states_recorded_;
+}
+
+void SimCoverageTracker::RecordInfoStateKey(const std::string& key) {
+  info_states_.Add(std::hash<std::string>()(key));
+  ++info_states_recorded_;
+}
+
+void SimCoverageTracker::Merge(const SimCoverageTracker& other) {
+  states_.Merge(other.states_);
+  info_states_.Merge(other.info_states_);
+  states_recorded_ += other.states_recorded_;
+  info_states_recorded_ += other.info_states_recorded_;
+}
+
+double SimCoverageTracker::ApproxDistinctStates() const {
+  return states_.Estimate();
+}
+
+double SimCoverageTracker::ApproxDistinctInfoStates() const {
+  return info_states_.Estimate();
+}
+
 // Checks that the game can be loaded.
 
 void LoadGameTest(const std::string& game_name) {
@@ -187,9 +291,12 @@ void TestHistoryContainsActions(const Game& game,
   }
 }
 
-void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
+void RandomSimulation(std::mt19937* rng, const Game& game, bool undo,
+                      SimCoverageTracker* coverage) {
   std::vector<HistoryItem> history;
   std::vector<double> episode_returns(game.NumPlayers(), 0);
+  const bool provides_information_state =
+      game.GetType().provides_information_state;
 
   int infostate_vector_size =
       game.GetType().provides_information_state_as_normalized_vector
@@ -219,6 +326,13 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
   while (!state->IsTerminal()) {
     std::cout << "player " << state->CurrentPlayer() << std::endl;
 
+    if (coverage != nullptr) {
+      coverage->RecordStateHash(state->HashValue());
+      if (provides_information_state && state->CurrentPlayer() >= 0) {
+        coverage->RecordInfoStateKey(state->InformationStateKey());
+      }
+    }
+
     LegalActionsIsEmptyForOtherPlayers(game, *state);
     LegalActionsAreSorted(game, *state);
 
@@ -229,6 +343,11 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
 
     if (history.size() < 10 || IsPowerOfTwo(history.size())) {
       TestSerializeDeserialize(game, state.get());
+
+      // The writer-based rendering must match the plain one.
+      std::string appended;
+      state->AppendToString(&appended);
+      SPIEL_CHECK_EQ(appended, state->ToString());
     }
 
     if (state->IsChanceNode()) {
@@ -240,6 +359,23 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
       std::cout << "sampled outcome: "
                 << state->ActionToString(kChancePlayerId, action) << std::endl;
 
+      // The state's direct sampler must agree with the explicit distribution.
+      // Skip draws within rounding distance of an interval boundary, where
+      // the direct and cumulative computations may differ in the last bit.
+      constexpr double kBoundaryEps = 1e-9;
+      const double z = std::uniform_real_distribution<double>(0.0, 1.0)(*rng);
+      std::pair<Action, double> sampled = state->SampleChanceOutcome(z);
+      double sum = 0;
+      for (const std::pair<Action, double>& outcome : outcomes) {
+        if (sum + kBoundaryEps <= z &&
+            z < sum + outcome.second - kBoundaryEps) {
+          SPIEL_CHECK_EQ(sampled.first, outcome.first);
+          SPIEL_CHECK_FLOAT_EQ(sampled.second, outcome.second);
+          break;
+        }
+        sum += outcome.second;
+      }
+
       history.emplace_back(state->Clone(), kChancePlayerId, action);
       state->ApplyAction(action);
 
@@ -325,6 +461,10 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
 
   SPIEL_CHECK_LE(game_length, game.MaxGameLength());
 
+  if (coverage != nullptr) {
+    coverage->RecordStateHash(state->HashValue());
+  }
+
   std::cout << "Reached a terminal state!" << std::endl;
   SPIEL_CHECK_EQ(state->CurrentPlayer(), kTerminalPlayerId);
   std::vector<double> rewards = state->Rewards();
@@ -358,12 +498,13 @@ void RandomSimulation(std::mt19937* rng, const Game& game, bool undo) {
 }
 
 // Perform sims random simulations of the specified game.
-void RandomSimTest(const Game& game, int num_sims) {
+void RandomSimTest(const Game& game, int num_sims,
+                   SimCoverageTracker* coverage) {
   std::mt19937 rng;
   std::cout << "\nRandomSimTest, game = " << game.GetType().short_name
             << ", num_sims = " << num_sims << std::endl;
   for (int sim = 0; sim < num_sims; ++sim) {
-    RandomSimulation(&rng, game, /*undo=*/false);
+    RandomSimulation(&rng, game, /*undo=*/false, coverage);
   }
 }
 
@@ -372,8 +513,166 @@ void RandomSimTestWithUndo(const Game& game, int num_sims) {
   std::cout << "RandomSimTestWithUndo, game = " << game.GetType().short_name
             << ", num_sims = " << num_sims << std::endl;
   for (int sim = 0; sim < num_sims; ++sim) {
-    RandomSimulation(&rng, game, /*undo=*/true);
+    RandomSimulation(&rng, game, /*undo=*/true, /*coverage=*/nullptr);
+  }
+}
+
+// A quiet counterpart of RandomSimulation for soak runs: no per-step
+// logging, no history kept, and the per-step checks gated on full_checks.
+// Returns the number of applied actions (chance nodes included).
+int64_t QuietRandomSimulation(std::mt19937* rng, const Game& game,
+                              bool full_checks,
+                              SimCoverageTracker* coverage) {
+  std::unique_ptr<State> state = game.NewInitialState();
+  std::vector<double> episode_returns(game.NumPlayers(), 0);
+  const bool provides_information_state =
+      game.GetType().provides_information_state;
+  int64_t steps = 0;
+  int game_length = 0;
+
+  while (!state->IsTerminal()) {
+    if (coverage != nullptr) {
+      coverage->RecordStateHash(state->HashValue());
+      if (provides_information_state && state->CurrentPlayer() >= 0) {
+        coverage->RecordInfoStateKey(state->InformationStateKey());
+      }
+    }
+
+    if (full_checks) {
+      LegalActionsIsEmptyForOtherPlayers(game, *state);
+      LegalActionsAreSorted(game, *state);
+      // Serialization round-trips are the expensive check, so run them at
+      // the same decaying cadence RandomSimulation uses.
+      if (steps < 10 || IsPowerOfTwo(steps)) {
+        TestSerializeDeserialize(game, state.get());
+      }
+    }
+
+    if (state->IsChanceNode()) {
+      std::vector<std::pair<Action, double>> outcomes = state->ChanceOutcomes();
+      Action action = SampleChanceOutcome(
+          outcomes, std::uniform_real_distribution<double>(0.0, 1.0)(*rng));
+      state->ApplyAction(action);
+    } else if (state->CurrentPlayer() == kSimultaneousPlayerId) {
+      if (full_checks) {
+        std::vector<double> rewards = state->Rewards();
+        for (int p = 0; p < game.NumPlayers(); ++p) {
+          episode_returns[p] += rewards[p];
+        }
+      }
+      std::vector<Action> joint_action;
+      joint_action.reserve(game.NumPlayers());
+      for (int p = 0; p < game.NumPlayers(); ++p) {
+        std::vector<Action> actions = state->LegalActions(p);
+        std::uniform_int_distribution<> dis(0, actions.size() - 1);
+        joint_action.push_back(actions[dis(*rng)]);
+      }
+      if (full_checks) {
+        ApplyActionTestClone(game, state.get(), joint_action);
+      } else {
+        state->ApplyActions(joint_action);
+      }
+      game_length++;
+    } else {
+      std::vector<Action> actions = state->LegalActions();
+      if (full_checks) {
+        std::vector<double> rewards = state->Rewards();
+        for (int p = 0; p < game.NumPlayers(); ++p) {
+          episode_returns[p] += rewards[p];
+        }
+        LegalActionsMaskTest(game, *state, actions);
+        SPIEL_CHECK_FALSE(actions.empty());
+      }
+      std::uniform_int_distribution<> dis(0, actions.size() - 1);
+      Action action = actions[dis(*rng)];
+      if (full_checks) {
+        ApplyActionTestClone(game, state.get(), action);
+      } else {
+        state->ApplyAction(action);
+      }
+      game_length++;
+    }
+    ++steps;
+  }
+
+  SPIEL_CHECK_LE(game_length, game.MaxGameLength());
+  if (coverage != nullptr) {
+    coverage->RecordStateHash(state->HashValue());
+  }
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), kTerminalPlayerId);
+  std::vector<double> rewards = state->Rewards();
+  std::vector<double> returns = state->Returns();
+  for (int p = 0; p < game.NumPlayers(); ++p) {
+    SPIEL_CHECK_GE(returns[p], game.MinUtility());
+    SPIEL_CHECK_LE(returns[p], game.MaxUtility());
+    if (full_checks) {
+      episode_returns[p] += rewards[p];
+      SPIEL_CHECK_TRUE(Near(episode_returns[p], returns[p]));
+    }
   }
+  return steps;
+}
+
+SimThroughput ParallelRandomSimTest(const Game& game, int num_sims,
+                                    int num_threads, SimCheckMode mode,
+                                    int seed, SimCoverageTracker* coverage) {
+  SPIEL_CHECK_GE(num_threads, 1);
+  std::cout << "\nParallelRandomSimTest, game = " << game.GetType().short_name
+            << ", num_sims = " << num_sims << ", num_threads = " << num_threads
+            << ", mode = "
+            << (mode == SimCheckMode::kFullChecks ? "full_checks" : "fast_sim")
+            << std::endl;
+  const bool full_checks = mode == SimCheckMode::kFullChecks;
+  std::vector<int64_t> thread_steps(num_threads, 0);
+  // The tracker is not thread-safe, so each worker records into its own and
+  // the sketches are merged once the workers have joined.
+  std::vector<SimCoverageTracker> thread_coverage;
+  if (coverage != nullptr) {
+    thread_coverage.resize(num_threads,
+                           SimCoverageTracker(coverage->precision_bits()));
+  }
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    workers.emplace_back([&game, &thread_steps, &thread_coverage, coverage,
+                          num_sims, num_threads, full_checks, seed, t]() {
+      std::mt19937 rng(seed + t);
+      int64_t steps = 0;
+      SimCoverageTracker* local_coverage =
+          coverage != nullptr ? &thread_coverage[t] : nullptr;
+      for (int sim = t; sim < num_sims; sim += num_threads) {
+        steps += QuietRandomSimulation(&rng, game, full_checks, local_coverage);
+      }
+      thread_steps[t] = steps;
+    });
+  }
+  for (std::thread& worker : workers) worker.join();
+  if (coverage != nullptr) {
+    for (const SimCoverageTracker& tracker : thread_coverage) {
+      coverage->Merge(tracker);
+    }
+  }
+
+  SimThroughput throughput;
+  throughput.episodes = num_sims;
+  for (int64_t steps : thread_steps) throughput.steps += steps;
+  throughput.seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  std::cout << throughput.episodes << " episodes (" << throughput.steps
+            << " steps) in " << throughput.seconds << "s: "
+            << throughput.episodes / throughput.seconds << " episodes/s, "
+            << throughput.steps / throughput.seconds << " steps/s"
+            << std::endl;
+  if (coverage != nullptr) {
+    std::cout << "Coverage: ~" << coverage->ApproxDistinctStates()
+              << " distinct states over " << coverage->states_recorded()
+              << " visits, ~" << coverage->ApproxDistinctInfoStates()
+              << " distinct info states over "
+              << coverage->info_states_recorded() << " visits" << std::endl;
+  }
+  return throughput;
 }
 
 // Format chance outcomes as a string, for error messages.
@@ -416,6 +715,15 @@ void CheckChanceOutcomes(const State& state) {
           absl::StrCat("Invalid probabilities; sum=", sum,
                        "; all outcomes=", ChanceOutcomeStr(chance_outcomes)));
     }
+    // When the game exposes a fixed outcome table, it must agree with
+    // ChanceOutcomes() exactly.
+    const ActionsAndProbs* static_outcomes = state.StaticChanceOutcomes();
+    if (static_outcomes != nullptr && *static_outcomes != chance_outcomes) {
+      SpielFatalError(absl::StrCat(
+          "StaticChanceOutcomes()=", ChanceOutcomeStr(*static_outcomes),
+          " inconsistent with ChanceOutcomes()=",
+          ChanceOutcomeStr(chance_outcomes), "."));
+    }
   }
   // Handles chance nodes, player nodes, including simultaneous nodes if
   // supported.
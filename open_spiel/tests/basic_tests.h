@@ -15,8 +15,10 @@
 #ifndef THIRD_PARTY_OPEN_SPIEL_TESTS_BASIC_TESTS_H_
 #define THIRD_PARTY_OPEN_SPIEL_TESTS_BASIC_TESTS_H_
 
+#include <cstdint>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "open_spiel/game_parameters.h"
 #include "open_spiel/spiel.h"
@@ -33,8 +35,97 @@ void ChanceOutcomesTest(const Game& game);
 // Test to ensure that there are no chance outcomes.
 void NoChanceOutcomesTest(const Game& game);
 
-// Perform num_sims random simulations of the specified game.
-void RandomSimTest(const Game& game, int num_sims);
+// Approximate counter of the distinct states and information states touched
+// by a batch of random simulations. Backed by HyperLogLog sketches keyed on
+// State::HashValue() (and on a hash of InformationStateKey() at decision
+// nodes), so recording is O(1) per step and the memory footprint is a few
+// kilobytes no matter how many states are visited. Use the estimates to see
+// how much of a simulation budget is spent revisiting the same states.
+// Not thread-safe; give each thread its own tracker and combine the results
+// with Merge().
+class SimCoverageTracker {
+ public:
+  // Precision b gives 2^b one-byte registers per sketch and a relative
+  // error of roughly 1.04 / sqrt(2^b): about 1.6% at the default of 12.
+  explicit SimCoverageTracker(int precision_bits = 12);
+
+  // Records a visited state by its transposition hash.
+  void RecordStateHash(uint64_t hash);
+
+  // Records the information state key of the player to move.
+  void RecordInfoStateKey(const std::string& key);
+
+  // Folds another tracker of the same precision into this one. The estimates
+  // then cover the union of what the two trackers saw.
+  void Merge(const SimCoverageTracker& other);
+
+  // Approximate numbers of distinct states / information states recorded.
+  double ApproxDistinctStates() const;
+  double ApproxDistinctInfoStates() const;
+
+  // Total (non-distinct) observation counts, for computing revisit ratios.
+  int64_t states_recorded() const { return states_recorded_; }
+  int64_t info_states_recorded() const { return info_states_recorded_; }
+
+  int precision_bits() const { return precision_bits_; }
+
+ private:
+  class HyperLogLog {
+   public:
+    explicit HyperLogLog(int precision_bits);
+    void Add(uint64_t hash);
+    void Merge(const HyperLogLog& other);
+    double Estimate() const;
+
+   private:
+    int precision_bits_;
+    std::vector<uint8_t> registers_;
+  };
+
+  int precision_bits_;
+  HyperLogLog states_;
+  HyperLogLog info_states_;
+  int64_t states_recorded_ = 0;
+  int64_t info_states_recorded_ = 0;
+};
+
+// Perform num_sims random simulations of the specified game. If coverage is
+// non-null, every visited state is recorded into it, along with the
+// information state key at each decision node for games that provide one.
+void RandomSimTest(const Game& game, int num_sims,
+                   SimCoverageTracker* coverage = nullptr);
+
+// Checking level for ParallelRandomSimTest.
+enum class SimCheckMode {
+  // Per-step invariant checks: clone consistency, legal action lists and
+  // masks, and serialization round-trips (at a decaying cadence within each
+  // episode, as in RandomSimTest).
+  kFullChecks,
+  // Applies sampled actions only, checking just the terminal conditions.
+  // Use this to measure raw simulation speed.
+  kFastSim,
+};
+
+// Throughput of a ParallelRandomSimTest run. steps counts applied actions,
+// chance nodes included (a simultaneous move counts as one step).
+struct SimThroughput {
+  int64_t episodes = 0;
+  int64_t steps = 0;
+  double seconds = 0;
+};
+
+// Performs num_sims random simulations of the specified game spread over
+// num_threads threads and returns the achieved throughput. Unlike
+// RandomSimTest this does not log per-step state, so it is suitable for long
+// soak runs. Thread t seeds its generator with seed + t, so runs are
+// reproducible for a given (seed, num_threads) pair and no two threads
+// replay the same episodes. If coverage is non-null, each thread records the
+// states it visits into a private tracker and the results are merged into
+// coverage after the workers join.
+SimThroughput ParallelRandomSimTest(const Game& game, int num_sims,
+                                    int num_threads, SimCheckMode mode,
+                                    int seed = 0,
+                                    SimCoverageTracker* coverage = nullptr);
 
 // Perform num_sims random simulations of the specified game. Also tests the
 // Undo function. Note: for every step in the simulation, the entire simulation
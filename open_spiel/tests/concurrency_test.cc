@@ -0,0 +1,163 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stress tests for the thread-safety contract documented in spiel.h: Game
+// methods and all const State accessors are safe for concurrent use; the
+// internal memoization caches must not race. The checks here are equality
+// checks (every thread must observe identical results), which catch logic
+// bugs such as a half-filled cache being returned; data races themselves are
+// caught by building this binary with ThreadSanitizer (configure with
+// CMAKE_CXX_FLAGS and CMAKE_EXE_LINKER_FLAGS set to -fsanitize=thread) and
+// running it.
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "open_spiel/game_parameters.h"
+#include "open_spiel/spiel.h"
+#include "open_spiel/spiel_utils.h"
+
+namespace open_spiel {
+namespace {
+
+constexpr int kNumThreads = 8;
+constexpr int kNumStepsPerGame = 30;
+constexpr int kNumReadsPerStep = 20;
+
+// Hammers the const accessors of `state` from kNumThreads threads at once and
+// checks that every thread sees the single-threaded answer.
+void ReadStateConcurrently(const Game& game, const State& state) {
+  // Compute the expected answers serially first; this also warms the caches
+  // on some runs and leaves them cold on others (we alternate below), so both
+  // the lock-free hit path and the racing-fill path get exercised.
+  // Legal actions are only queried off terminal states: spiel.h makes no
+  // promise about them there (tic_tac_toe reports the empty cells of a won
+  // board, and SimMoveState::LegalActions refuses outright).
+  const bool expected_terminal = state.IsTerminal();
+  const std::vector<Action> expected_actions =
+      expected_terminal ? std::vector<Action>() : state.LegalActions();
+  const std::string expected_string = state.ToString();
+  const bool provides_information_state =
+      game.GetType().provides_information_state;
+  std::vector<std::string> expected_keys;
+  if (provides_information_state && !state.IsChanceNode()) {
+    for (int player = 0; player < state.NumPlayers(); ++player) {
+      expected_keys.push_back(state.InformationStateKey(player));
+    }
+  }
+
+  std::vector<std::thread> readers;
+  readers.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    readers.emplace_back([&, t]() {
+      for (int i = 0; i < kNumReadsPerStep; ++i) {
+        SPIEL_CHECK_EQ(state.ToString(), expected_string);
+        SPIEL_CHECK_EQ(state.IsTerminal(), expected_terminal);
+        if (expected_terminal) continue;
+        SPIEL_CHECK_TRUE(state.LegalActionsCached() == expected_actions);
+        SPIEL_CHECK_TRUE(state.LegalActions() == expected_actions);
+        if (!state.IsSimultaneousNode()) {
+          // Lazy enumeration must agree with LegalActions() as a set; only
+          // check the count here since the order is implementation-defined.
+          int num_yielded = 0;
+          state.ForEachLegalAction([&num_yielded](Action action) {
+            ++num_yielded;
+            return true;
+          });
+          SPIEL_CHECK_EQ(num_yielded,
+                         static_cast<int>(expected_actions.size()));
+        }
+        if (provides_information_state && !state.IsChanceNode()) {
+          // Stagger the player each thread asks for first so the per-player
+          // fills race in different orders.
+          for (int p = 0; p < state.NumPlayers(); ++p) {
+            const int player = (p + t) % state.NumPlayers();
+            SPIEL_CHECK_EQ(state.InformationStateKeyCached(player),
+                           expected_keys[player]);
+          }
+        }
+      }
+    });
+  }
+  for (auto& reader : readers) reader.join();
+}
+
+// Plays a random game, stopping at every node to read it from many threads.
+// Mutations happen only between the joins, matching the contract.
+void SharedStateReadTest(const std::string& game_name) {
+  std::cout << "SharedStateReadTest, game = " << game_name << std::endl;
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::mt19937 rng(8213);
+  for (int step = 0; step < kNumStepsPerGame && !state->IsTerminal(); ++step) {
+    // Alternate between reading a cold cache (threads race to fill it) and a
+    // cache pre-warmed by the serial expected-value computation.
+    if (step % 2 == 0) state->LegalActionsCached();
+    ReadStateConcurrently(*game, *state);
+    std::vector<Action> actions = state->LegalActions();
+    std::uniform_int_distribution<int> dist(0, actions.size() - 1);
+    state->ApplyAction(actions[dist(rng)]);
+  }
+  ReadStateConcurrently(*game, *state);
+}
+
+// Calls Game methods from many threads at once; a Game must be logically
+// immutable after construction.
+void ConcurrentGameMethodsTest(const std::string& game_name) {
+  std::cout << "ConcurrentGameMethodsTest, game = " << game_name << std::endl;
+  std::unique_ptr<Game> game = LoadGame(game_name);
+  const std::string expected_parameters =
+      GameParametersToString(game->GetParameters());
+  const std::string expected_string = game->ToString();
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kNumReadsPerStep; ++i) {
+        SPIEL_CHECK_GT(game->NumPlayers(), 0);
+        SPIEL_CHECK_GT(game->NumDistinctActions(), 0);
+        SPIEL_CHECK_LT(game->MinUtility(), game->MaxUtility());
+        SPIEL_CHECK_EQ(game->ToString(), expected_string);
+        SPIEL_CHECK_EQ(GameParametersToString(game->GetParameters()),
+                       expected_parameters);
+        // Each thread builds, steps, and recycles its own states; distinct
+        // states are independent, and the pool is internally synchronized.
+        std::unique_ptr<State> state = game->NewStateFromPool();
+        if (!state->IsTerminal()) {
+          state->ApplyAction(state->LegalActions()[0]);
+        }
+        game->ReleaseStateToPool(std::move(state));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace open_spiel
+
+int main(int argc, char** argv) {
+  // A perfect-information game, a simultaneous-move game, and games with
+  // chance nodes and information states, to cover the different accessor
+  // paths.
+  for (const std::string& game_name :
+       {"tic_tac_toe", "kuhn_poker", "leduc_poker", "goofspiel"}) {
+    open_spiel::SharedStateReadTest(game_name);
+    open_spiel::ConcurrentGameMethodsTest(game_name);
+  }
+}
@@ -14,16 +14,26 @@
 
 #include "open_spiel/spiel.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "open_spiel/games/leduc_poker.h"
 #include "open_spiel/games/liars_dice.h"
 #include "open_spiel/policy.h"
+#include "open_spiel/policy_compaction.h"
+#include "open_spiel/policy_file.h"
 #include "open_spiel/simultaneous_move_game.h"
+#include "open_spiel/spiel_scratch.h"
 #include "open_spiel/spiel_utils.h"
 #include "open_spiel/tests/basic_tests.h"
 
@@ -49,6 +59,274 @@ void KuhnTests() {
   }
 }
 
+void StatePoolTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+
+  // An empty pool just gives a fresh initial state.
+  std::unique_ptr<State> state = game->NewStateFromPool();
+  SPIEL_CHECK_EQ(state->ToString(), game->NewInitialState()->ToString());
+
+  // Play a move, release the state, and draw again: the same object should
+  // come back, reset to the initial state.
+  state->ApplyAction(state->LegalActions()[0]);
+  State* released = state.get();
+  game->ReleaseStateToPool(std::move(state));
+  std::unique_ptr<State> recycled = game->NewStateFromPool();
+  SPIEL_CHECK_EQ(recycled.get(), released);
+  SPIEL_CHECK_EQ(recycled->History().size(), 0);
+  SPIEL_CHECK_EQ(recycled->ToString(), game->NewInitialState()->ToString());
+}
+
+void ScratchVectorTest() {
+  {
+    ScratchVector<int> outer;
+    outer->reserve(64);
+    outer->push_back(1);
+
+    // A nested handle of the same type gets a distinct buffer.
+    ScratchVector<int> inner;
+    SPIEL_CHECK_TRUE(inner->empty());
+    inner->push_back(2);
+    SPIEL_CHECK_EQ(outer->size(), 1);
+    SPIEL_CHECK_EQ((*outer)[0], 1);
+  }
+
+  // Both buffers went back to this thread's pool; a new handle comes back
+  // empty but keeps the capacity grown above.
+  ScratchVector<int> reused;
+  SPIEL_CHECK_TRUE(reused->empty());
+  SPIEL_CHECK_GE(reused->capacity(), 1);
+}
+
+void LegalActionsCacheTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+
+  // The cached accessor agrees with LegalActions() and hands back the same
+  // vector on repeated calls at the same node.
+  const std::vector<Action>& actions = state->LegalActionsCached();
+  SPIEL_CHECK_TRUE(actions == state->LegalActions());
+  SPIEL_CHECK_EQ(&actions, &state->LegalActionsCached());
+  SPIEL_CHECK_TRUE(state->LegalActionsMask() == state->LegalActionsMask(0));
+
+  // Applying an action invalidates the cache. Copied, not a reference: the
+  // reference LegalActionsCached() returns is only valid until the state
+  // next changes, and the undo below refills the same vector.
+  Action first = actions[0];
+  state->ApplyAction(first);
+  const std::vector<Action> after = state->LegalActionsCached();
+  SPIEL_CHECK_TRUE(after == state->LegalActions());
+  SPIEL_CHECK_TRUE(std::find(after.begin(), after.end(), first) ==
+                   after.end());
+
+  // A clone starts with an empty cache but computes the same actions.
+  std::unique_ptr<State> clone = state->Clone();
+  SPIEL_CHECK_TRUE(clone->LegalActionsCached() == after);
+
+  // Undoing an action must not leave a stale cache behind.
+  state->UndoAction(0, first);
+  SPIEL_CHECK_TRUE(state->LegalActionsCached() == state->LegalActions());
+  SPIEL_CHECK_EQ(state->LegalActionsCached().size(), after.size() + 1);
+}
+
+void InformationStateKeyCacheTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  std::unique_ptr<State> state = game->NewInitialState();
+  while (state->IsChanceNode()) {
+    state->ApplyAction(state->LegalActions()[0]);
+  }
+
+  // The cached accessor agrees with InformationStateKey() for every player
+  // and hands back the same string on repeated calls at the same node.
+  for (int p = 0; p < game->NumPlayers(); ++p) {
+    const std::string& key = state->InformationStateKeyCached(p);
+    SPIEL_CHECK_EQ(key, state->InformationStateKey(p));
+    SPIEL_CHECK_EQ(&key, &state->InformationStateKeyCached(p));
+  }
+  SPIEL_CHECK_EQ(state->InformationStateKeyCached(),
+                 state->InformationStateKey());
+
+  // Applying an action invalidates the cache for all players.
+  state->ApplyAction(state->LegalActions()[0]);
+  for (int p = 0; p < game->NumPlayers(); ++p) {
+    SPIEL_CHECK_EQ(state->InformationStateKeyCached(p),
+                   state->InformationStateKey(p));
+  }
+
+  // A clone starts with an empty cache but computes the same keys.
+  std::unique_ptr<State> clone = state->Clone();
+  SPIEL_CHECK_EQ(clone->InformationStateKeyCached(0),
+                 state->InformationStateKeyCached(0));
+}
+
+void ActionHistoryTest() {
+  // Fill across several chunk boundaries and read everything back.
+  ActionHistory history;
+  const int n = 3 * ActionHistory::kChunkSize + 10;
+  for (int i = 0; i < n; ++i) history.push_back(i);
+  SPIEL_CHECK_EQ(history.size(), n);
+  for (int i = 0; i < n; ++i) SPIEL_CHECK_EQ(history[i], i);
+
+  // Copies share storage until they append, then diverge independently.
+  ActionHistory copy = history;
+  copy.push_back(1000);
+  history.push_back(2000);
+  SPIEL_CHECK_EQ(copy[n], 1000);
+  SPIEL_CHECK_EQ(history[n], 2000);
+  for (int i = 0; i < n; ++i) SPIEL_CHECK_EQ(copy[i], i);
+
+  // pop_back then push overwrites the slot without disturbing the copy.
+  history.pop_back();
+  history.push_back(3000);
+  SPIEL_CHECK_EQ(history.back(), 3000);
+  SPIEL_CHECK_EQ(copy[n], 1000);
+
+  // Popping below a chunk boundary and rebuilding leaves copies intact.
+  ActionHistory other = history;
+  while (history.size() > ActionHistory::kChunkSize - 4) history.pop_back();
+  history.push_back(7);
+  SPIEL_CHECK_EQ(history.back(), 7);
+  SPIEL_CHECK_EQ(other.size(), n + 1);
+  for (int i = 0; i < n; ++i) SPIEL_CHECK_EQ(other[i], i);
+
+  // Iteration and the vector round trip agree.
+  std::vector<Action> actions = history.ToVector();
+  SPIEL_CHECK_EQ(actions.size(), history.size());
+  int index = 0;
+  for (Action action : history) SPIEL_CHECK_EQ(action, actions[index++]);
+
+  // States expose the same behaviour through History(): a deep clone keeps
+  // the full history and diverges from the original after one move.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(state->LegalActions()[0]);
+  state->ApplyAction(state->LegalActions()[0]);
+  std::unique_ptr<State> clone = state->Clone();
+  SPIEL_CHECK_TRUE(clone->History() == state->History());
+  clone->ApplyAction(clone->LegalActions()[0]);
+  SPIEL_CHECK_EQ(clone->History().size(), state->History().size() + 1);
+}
+
+void SpanTest() {
+  // A span is a window onto the container it was built from, not a copy.
+  std::vector<Action> actions = {3, 1, 4, 1, 5};
+  Span<Action> view = actions;
+  SPIEL_CHECK_EQ(view.size(), actions.size());
+  SPIEL_CHECK_EQ(view.front(), 3);
+  SPIEL_CHECK_EQ(view.back(), 5);
+  SPIEL_CHECK_EQ(view.data(), actions.data());
+  actions[2] = 9;
+  SPIEL_CHECK_EQ(view[2], 9);
+  int index = 0;
+  for (Action action : view) SPIEL_CHECK_EQ(action, actions[index++]);
+  SPIEL_CHECK_TRUE(view.ToVector() == actions);
+  SPIEL_CHECK_TRUE(Span<Action>().empty());
+
+  // The view accessors agree with their copying counterparts without
+  // allocating a new vector per call.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  state->ApplyAction(state->LegalActions()[0]);
+  state->ApplyAction(state->LegalActions()[0]);
+  Span<Action> legal_view = state->LegalActionsView();
+  SPIEL_CHECK_TRUE(legal_view.ToVector() == state->LegalActions());
+  SPIEL_CHECK_EQ(legal_view.data(), state->LegalActionsView().data());
+  const ActionHistory& history_view = state->HistoryView();
+  std::vector<Action> history = state->History();
+  SPIEL_CHECK_EQ(history_view.size(), history.size());
+  for (int i = 0; i < history.size(); ++i) {
+    SPIEL_CHECK_EQ(history_view[i], history[i]);
+  }
+}
+
+void HistoryTrackingTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_TRUE(game->GetType().history_independent_state);
+
+  // A state with tracking disabled plays identically to a tracked twin.
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::unique_ptr<State> rollout = state->Clone();
+  rollout->DisableHistoryTracking();
+  int moves = 0;
+  while (!rollout->IsTerminal()) {
+    Action action = rollout->LegalActions()[0];
+    rollout->ApplyAction(action);
+    state->ApplyAction(action);
+    SPIEL_CHECK_EQ(rollout->ToString(), state->ToString());
+    ++moves;
+  }
+  SPIEL_CHECK_EQ(state->History().size(), moves);
+
+  // Clones of a suppressed state inherit the setting and stay playable.
+  std::unique_ptr<State> fresh = game->NewInitialState();
+  fresh->DisableHistoryTracking();
+  std::unique_ptr<State> child = fresh->Child(fresh->LegalActions()[0]);
+  SPIEL_CHECK_FALSE(child->IsTerminal());
+}
+
+void BatchNormalizedVectorsTest() {
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+
+  // Walk a few moves down one line of play, keeping every state.
+  std::vector<std::unique_ptr<State>> states;
+  states.push_back(game->NewInitialState());
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<State> next = states.back()->Clone();
+    next->ApplyAction(next->LegalActions()[0]);
+    states.push_back(std::move(next));
+  }
+
+  std::vector<const State*> state_ptrs;
+  for (const auto& state : states) state_ptrs.push_back(state.get());
+
+  const int size = game->ObservationNormalizedVectorSize();
+  std::vector<double> buffer(state_ptrs.size() * size, -1);
+  game->BatchObservationNormalizedVectors(state_ptrs, buffer.data());
+
+  // The float32 batch must agree with the double one.
+  std::vector<float> float_buffer(state_ptrs.size() * size, -1);
+  game->BatchObservationNormalizedVectors(state_ptrs, float_buffer.data());
+
+  // Each row of the batch must match the single-state call.
+  for (int i = 0; i < state_ptrs.size(); ++i) {
+    std::vector<double> expected =
+        state_ptrs[i]->ObservationAsNormalizedVector();
+    SPIEL_CHECK_EQ(expected.size(), size);
+    for (int j = 0; j < size; ++j) {
+      SPIEL_CHECK_EQ(buffer[i * size + j], expected[j]);
+      SPIEL_CHECK_EQ(float_buffer[i * size + j],
+                     static_cast<float>(expected[j]));
+    }
+  }
+}
+
+void StepOutputsTest() {
+  // The default StepOutputs must agree with the four calls it fuses, at
+  // every decision and terminal node of a playout.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  std::vector<double> observation(game->ObservationNormalizedVectorSize());
+  std::vector<uint64_t> mask(state->LegalActionsBitsetWords());
+  std::vector<double> rewards(game->NumPlayers());
+  StepView view;
+  view.observation = observation.data();
+  view.legal_mask = mask.data();
+  view.rewards = rewards.data();
+  while (true) {
+    const int player = state->IsTerminal() ? 0 : state->CurrentPlayer();
+    state->StepOutputs(player, &view);
+    SPIEL_CHECK_EQ(view.done, state->IsTerminal());
+    SPIEL_CHECK_TRUE(observation ==
+                     state->ObservationAsNormalizedVector(player));
+    std::vector<uint64_t> expected_mask(mask.size());
+    state->LegalActionsBitset(expected_mask.data());
+    SPIEL_CHECK_TRUE(mask == expected_mask);
+    SPIEL_CHECK_TRUE(rewards == state->Rewards());
+    if (view.done) break;
+    state->ApplyAction(state->LegalActions()[0]);
+  }
+}
+
 void TicTacToeTests() {
   auto tic_tac_toe = LoadGame("tic_tac_toe");
   NoChanceOutcomesTest(*tic_tac_toe);
@@ -109,6 +387,19 @@ void FlatJointactionTest() {
   state.ApplyAction(16);
   std::vector<Action> expected_joint_action{4, 5, 100};
   SPIEL_CHECK_EQ(state.JointAction(), expected_joint_action);
+
+  // The callback iteration visits the same joint actions in the same order
+  // as expanding each flat id, without materializing the flat list.
+  SPIEL_CHECK_EQ(state.NumFlatJointActions(), 18);
+  Action expected_flat_action = 0;
+  state.ForEachJointAction(
+      [&state, &expected_flat_action](Action flat_action,
+                                      const std::vector<Action>& actions) {
+        SPIEL_CHECK_EQ(flat_action, expected_flat_action);
+        SPIEL_CHECK_EQ(actions, state.FlatJointActionToActions(flat_action));
+        ++expected_flat_action;
+      });
+  SPIEL_CHECK_EQ(expected_flat_action, 18);
 }
 
 using PolicyGenerator = std::function<TabularPolicy(const Game& game)>;
@@ -171,6 +462,113 @@ void PolicyTest() {
   }
 }
 
+void SmallActionsAndProbsTest() {
+  // The inline buffer holds kInlineCapacity pairs without allocating and
+  // spills transparently beyond it.
+  SmallActionsAndProbs small;
+  SPIEL_CHECK_TRUE(small.empty());
+  for (int i = 0; i < 3 * SmallActionsAndProbs::kInlineCapacity; ++i) {
+    small.push_back({i, i * 0.5});
+  }
+  SPIEL_CHECK_EQ(small.size(), 3 * SmallActionsAndProbs::kInlineCapacity);
+  for (int i = 0; i < small.size(); ++i) {
+    SPIEL_CHECK_EQ(small[i].first, i);
+    SPIEL_CHECK_FLOAT_EQ(small[i].second, i * 0.5);
+  }
+
+  // Copies are deep; clearing keeps any heap buffer for reuse.
+  SmallActionsAndProbs copy = small;
+  small.clear();
+  SPIEL_CHECK_TRUE(small.empty());
+  SPIEL_CHECK_EQ(copy.size(), 3 * SmallActionsAndProbs::kInlineCapacity);
+
+  // The out-parameter policy lookup matches the allocating one.
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  TabularPolicy policy = GetRandomPolicy(*game);
+  SmallActionsAndProbs state_policy;
+  for (const auto& entry : policy.PolicyTable()) {
+    policy.GetStatePolicy(entry.first, &state_policy);
+    SPIEL_CHECK_EQ(state_policy.size(), entry.second.size());
+    for (int i = 0; i < state_policy.size(); ++i) {
+      SPIEL_CHECK_TRUE(state_policy[i] == entry.second[i]);
+      SPIEL_CHECK_FLOAT_EQ(GetProb(state_policy, state_policy[i].first),
+                           entry.second[i].second);
+    }
+  }
+  policy.GetStatePolicy("no such info state", &state_policy);
+  SPIEL_CHECK_TRUE(state_policy.empty());
+}
+
+void PolicyFileTest() {
+  const char* filename = "/tmp/open_spiel_policy_file_test";
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  TabularPolicy policy = GetRandomPolicy(*game, /*seed=*/2987298);
+  const auto& table = policy.PolicyTable();
+
+  WritePolicyFile(filename, table);
+  FrozenTabularPolicy frozen(filename);
+  SPIEL_CHECK_EQ(frozen.num_entries(), table.size());
+
+  // Every entry must round-trip exactly, and unknown keys return empty.
+  for (const auto& entry : table) {
+    SPIEL_CHECK_TRUE(frozen.GetStatePolicy(entry.first) == entry.second);
+  }
+  SPIEL_CHECK_TRUE(frozen.GetStatePolicy("no such info state").empty());
+  SPIEL_CHECK_TRUE(frozen.GetStatePolicy("").empty());
+  std::remove(filename);
+}
+
+void PolicyCompactionTest() {
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+
+  // A lossless compaction (tolerance 0) reproduces a random policy exactly,
+  // including after a save/load round trip.
+  TabularPolicy random_policy = GetRandomPolicy(*game, /*seed=*/618373);
+  const auto& random_table = random_policy.PolicyTable();
+  CompactTabularPolicy compact(random_table);
+  SPIEL_CHECK_EQ(compact.num_entries(), random_table.size());
+  for (const auto& entry : random_table) {
+    SPIEL_CHECK_TRUE(compact.GetStatePolicy(entry.first) == entry.second);
+  }
+  SPIEL_CHECK_TRUE(compact.GetStatePolicy("no such info state").empty());
+
+  const char* filename = "/tmp/open_spiel_policy_compaction_test";
+  compact.Save(filename);
+  CompactTabularPolicy loaded{std::string(filename)};
+  SPIEL_CHECK_EQ(loaded.num_entries(), compact.num_entries());
+  for (const auto& entry : random_table) {
+    SPIEL_CHECK_TRUE(loaded.GetStatePolicy(entry.first) == entry.second);
+  }
+  std::remove(filename);
+
+  // Deterministic and uniform policies compact well below one probability's
+  // worth of bytes per action, and decode to the exact distributions.
+  TabularPolicy first_action = GetFirstActionPolicy(*game);
+  CompactTabularPolicy compact_first(first_action.PolicyTable());
+  for (const auto& entry : first_action.PolicyTable()) {
+    SPIEL_CHECK_TRUE(compact_first.GetStatePolicy(entry.first) ==
+                     entry.second);
+  }
+  std::size_t explicit_bytes = 0;
+  for (const auto& entry : first_action.PolicyTable()) {
+    explicit_bytes += entry.first.size() +
+                      entry.second.size() * (sizeof(Action) + sizeof(double));
+  }
+  SPIEL_CHECK_LT(compact_first.ApproxBytes(),
+                 explicit_bytes + first_action.PolicyTable().size() *
+                                      2 * sizeof(uint64_t));
+
+  // A tolerance snaps near-converged entries onto the compact classes: an
+  // almost-deterministic distribution comes back exactly deterministic.
+  std::unordered_map<std::string, ActionsAndProbs> near_table;
+  near_table["info"] = {{0, 1e-9}, {1, 1.0 - 2e-9}, {2, 1e-9}};
+  CompactTabularPolicy snapped(near_table, /*tolerance=*/1e-6);
+  ActionsAndProbs snapped_entry = snapped.GetStatePolicy("info");
+  SPIEL_CHECK_EQ(snapped_entry[1].second, 1.0);
+  SPIEL_CHECK_EQ(snapped_entry[0].second, 0.0);
+  SPIEL_CHECK_EQ(snapped_entry[2].second, 0.0);
+}
+
 void LeducPokerDeserializeTest() {
   // Example Leduc state: player 1 gets the 0th card, player 2 gets the 3rd card
   // and the first two actions are: check, check.
@@ -205,6 +603,102 @@ void LeducPokerDeserializeTest() {
       serialized_game_and_state);
 }
 
+void TextStateSerializationTest() {
+  // DeserializeState must accept SerializeState's own output verbatim,
+  // trailing newline included -- consumers such as the subgame transform
+  // feed it the raw string, without DeserializeGameAndState's trimming.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : std::vector<Action>{4, 0, 2}) {
+    state->ApplyAction(action);
+  }
+  std::string serialized = game->SerializeState(*state);
+  SPIEL_CHECK_FALSE(serialized.empty());
+  SPIEL_CHECK_EQ(serialized.back(), '\n');
+  std::unique_ptr<State> restored = game->DeserializeState(serialized);
+  SPIEL_CHECK_EQ(restored->ToString(), state->ToString());
+  SPIEL_CHECK_TRUE(restored->History() == state->History());
+
+  // The joint-action replay path, same raw format.
+  game = LoadGame("goofspiel");
+  state = game->NewInitialState();
+  if (state->IsChanceNode()) {
+    state->ApplyAction(state->ChanceOutcomes()[0].first);
+  }
+  state->ApplyActions({state->LegalActions(0)[0], state->LegalActions(1)[1]});
+  restored = game->DeserializeState(game->SerializeState(*state));
+  SPIEL_CHECK_EQ(restored->ToString(), state->ToString());
+  SPIEL_CHECK_TRUE(restored->History() == state->History());
+}
+
+void BinarySerializationTest() {
+  // The default implementation round-trips the history as varints.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::unique_ptr<State> state = game->NewInitialState();
+  for (Action action : std::vector<Action>{4, 0, 2, 6, 3}) {
+    state->ApplyAction(action);
+  }
+  std::string binary = game->SerializeStateBinary(*state);
+  std::unique_ptr<State> restored = game->DeserializeStateBinary(binary);
+  SPIEL_CHECK_EQ(restored->ToString(), state->ToString());
+  SPIEL_CHECK_TRUE(restored->History() == state->History());
+
+  // A simultaneous-move game exercises the joint-action replay path.
+  game = LoadGame("goofspiel");
+  state = game->NewInitialState();
+  for (int i = 0; i < 4 && !state->IsTerminal(); ++i) {
+    if (state->IsChanceNode()) {
+      state->ApplyAction(state->ChanceOutcomes()[0].first);
+    } else {
+      std::vector<Action> joint_action;
+      for (int p = 0; p < game->NumPlayers(); ++p) {
+        joint_action.push_back(state->LegalActions(p)[0]);
+      }
+      state->ApplyActions(joint_action);
+    }
+  }
+  restored = game->DeserializeStateBinary(game->SerializeStateBinary(*state));
+  SPIEL_CHECK_EQ(restored->ToString(), state->ToString());
+  SPIEL_CHECK_TRUE(restored->History() == state->History());
+}
+
+void LoadGameCachedTest() {
+  std::shared_ptr<const Game> a = LoadGameCached("tic_tac_toe");
+  std::shared_ptr<const Game> b = LoadGameCached("tic_tac_toe");
+  SPIEL_CHECK_TRUE(a.get() == b.get());
+
+  // The key is the canonical parameter string, however the load is spelled.
+  std::shared_ptr<const Game> c =
+      LoadGameCached("pig", {{"winscore", GameParameter(20)}});
+  std::shared_ptr<const Game> d = LoadGameCached("pig(winscore=20)");
+  SPIEL_CHECK_TRUE(c.get() == d.get());
+  SPIEL_CHECK_TRUE(a.get() != c.get());
+
+  // Cached games are usable like freshly loaded ones.
+  std::unique_ptr<State> state = a->NewInitialState();
+  SPIEL_CHECK_EQ(state->CurrentPlayer(), 0);
+}
+
+void HashValueTest() {
+  // Different move orders reaching the same position must agree on the key,
+  // and the GameType bit advertises games with a real implementation.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  SPIEL_CHECK_TRUE(game->GetType().provides_hash_value);
+  std::unique_ptr<State> a = game->NewInitialState();
+  std::unique_ptr<State> b = game->NewInitialState();
+  for (Action action : std::vector<Action>{0, 4, 8}) a->ApplyAction(action);
+  for (Action action : std::vector<Action>{8, 4, 0}) b->ApplyAction(action);
+  SPIEL_CHECK_EQ(a->HashValue(), b->HashValue());
+  SPIEL_CHECK_NE(a->HashValue(), game->NewInitialState()->HashValue());
+
+  // Games without an override still get the (slow) string-hash default.
+  std::unique_ptr<Game> kuhn = LoadGame("kuhn_poker");
+  SPIEL_CHECK_FALSE(kuhn->GetType().provides_hash_value);
+  std::unique_ptr<State> state = kuhn->NewInitialState();
+  SPIEL_CHECK_EQ(state->HashValue(),
+                 std::hash<std::string>()(state->ToString()));
+}
+
 void GameParametersTest() {
   // Bare name
   auto params = GameParametersFromString("game_one");
@@ -242,6 +736,221 @@ void GameParametersTest() {
   SPIEL_CHECK_EQ(game2.size(), 2);
   SPIEL_CHECK_EQ(game2["name"].string_value(), "nested2");
   SPIEL_CHECK_EQ(game2["param"].string_value(), "val");
+
+  // Equality is type-aware: string "42" and int 42 differ.
+  SPIEL_CHECK_TRUE(GameParameter(42) == GameParameter(42));
+  SPIEL_CHECK_TRUE(GameParameter(42) != GameParameter(std::string("42")));
+  SPIEL_CHECK_TRUE(GameParameter(true) != GameParameter(1));
+
+  // Equal maps digest equally; changing any key, value, or type changes
+  // the digest.
+  auto same_params = GameParametersFromString(
+      "game_four(str=strval,int=42,float=-1.2,game1=nested(),"
+      "game2=nested2(param=val),bool1=True,bool2=False)");
+  SPIEL_CHECK_EQ(GameParametersDigest(params),
+                 GameParametersDigest(same_params));
+  same_params["int"] = GameParameter(43);
+  SPIEL_CHECK_NE(GameParametersDigest(params),
+                 GameParametersDigest(same_params));
+  same_params["int"] = GameParameter(std::string("42"));
+  SPIEL_CHECK_NE(GameParametersDigest(params),
+                 GameParametersDigest(same_params));
+}
+
+void StatsTest() {
+  // The registry works regardless of whether the SPIEL_STATS_* macros are
+  // compiled in. References stay valid across further registrations.
+  stats::Counter& counter = stats::GetCounter("spiel_test/counter");
+  counter.value.fetch_add(3);
+  stats::TimerStat& timer = stats::GetTimer("spiel_test/timer");
+  { stats::ScopedTimer scoped(timer); }
+  stats::Gauge& gauge = stats::GetGauge("spiel_test/gauge");
+  gauge.value.store(7);
+  SPIEL_CHECK_TRUE(&counter == &stats::GetCounter("spiel_test/counter"));
+  SPIEL_CHECK_EQ(counter.value.load(), 3);
+  SPIEL_CHECK_EQ(timer.count.load(), 1);
+  SPIEL_CHECK_GE(timer.nanos.load(), 0);
+
+  std::string report = stats::DumpStats();
+  SPIEL_CHECK_TRUE(report.find("spiel_test/counter: 3") != std::string::npos);
+  SPIEL_CHECK_TRUE(report.find("spiel_test/gauge: 7") != std::string::npos);
+  SPIEL_CHECK_TRUE(report.find("spiel_test/timer: ") != std::string::npos);
+
+  // The JSON snapshot carries the same values, one object per line.
+  std::string json = stats::StatsAsJsonLine();
+  SPIEL_CHECK_TRUE(json.find("\"time_ms\":") != std::string::npos);
+  SPIEL_CHECK_TRUE(json.find("\"spiel_test/counter\":3") != std::string::npos);
+  SPIEL_CHECK_TRUE(json.find("\"spiel_test/gauge\":7") != std::string::npos);
+  SPIEL_CHECK_TRUE(json.find("\"spiel_test/timer\":{\"seconds\":") !=
+                   std::string::npos);
+  SPIEL_CHECK_TRUE(json.find('\n') == std::string::npos);
+
+  stats::ResetStats();
+  SPIEL_CHECK_EQ(counter.value.load(), 0);
+  SPIEL_CHECK_EQ(gauge.value.load(), 0);
+  SPIEL_CHECK_EQ(timer.count.load(), 0);
+
+  // The macros must be usable in statement position whether or not they are
+  // enabled.
+  SPIEL_STATS_INC("spiel_test/macro");
+  SPIEL_STATS_ADD("spiel_test/macro", 2);
+  SPIEL_STATS_SET_GAUGE("spiel_test/macro_gauge", 5);
+}
+
+void JsonlStatsWriterTest() {
+  const std::string filename = "/tmp/open_spiel_stats_test.jsonl";
+  std::remove(filename.c_str());
+  stats::GetCounter("spiel_test/writer").value.store(11);
+  {
+    stats::JsonlStatsWriter writer(filename, /*period_ms=*/5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  // The destructor flushed a final snapshot, so the file has at least one
+  // complete line carrying the counter.
+  std::ifstream file(filename);
+  SPIEL_CHECK_TRUE(file.is_open());
+  std::string line;
+  int num_lines = 0;
+  while (std::getline(file, line)) {
+    ++num_lines;
+    SPIEL_CHECK_EQ(line.front(), '{');
+    SPIEL_CHECK_EQ(line.back(), '}');
+    SPIEL_CHECK_TRUE(line.find("\"spiel_test/writer\":11") !=
+                     std::string::npos);
+  }
+  SPIEL_CHECK_GE(num_lines, 1);
+  std::remove(filename.c_str());
+  stats::ResetStats();
+}
+
+void NumberFormattingTest() {
+  // Integers, including both limits, format to their exact digits.
+  std::string out;
+  AppendInt(0, &out);
+  AppendInt(-42, &out);
+  out.push_back(' ');
+  AppendInt(std::numeric_limits<int64_t>::max(), &out);
+  out.push_back(' ');
+  AppendInt(std::numeric_limits<int64_t>::min(), &out);
+  SPIEL_CHECK_EQ(out, "0-42 9223372036854775807 -9223372036854775808");
+
+  // Doubles take the shortest form that still parses back exactly.
+  SPIEL_CHECK_EQ(FormatDouble(0.25), "0.25");
+  SPIEL_CHECK_EQ(FormatDouble(-3.0), "-3");
+  for (double value :
+       {1.0 / 3.0, 0.1, 1e-300, -2.5e17, 6.02214076e23, 0.0,
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::epsilon()}) {
+    SPIEL_CHECK_EQ(std::stod(FormatDouble(value)), value);
+  }
+
+  // Double game parameters now survive the string round trip exactly,
+  // including values that need an exponent or all 17 digits.
+  for (double value : {1.0 / 3.0, 2e-8, 12345.6789}) {
+    GameParameter parameter =
+        GameParameterFromString(GameParameter(value).ToString());
+    SPIEL_CHECK_EQ(parameter.double_value(), value);
+  }
+}
+
+void FastRngTest() {
+  // Same seed, same sequence.
+  FastRng rng1(1234);
+  FastRng rng2(1234);
+  for (int i = 0; i < 100; ++i) {
+    SPIEL_CHECK_EQ(rng1(), rng2());
+  }
+
+  // FastRng is a standard uniform random bit generator, so the <random>
+  // distributions work with it unchanged.
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  for (int i = 0; i < 100; ++i) {
+    double z = dist(rng1);
+    SPIEL_CHECK_GE(z, 0.0);
+    SPIEL_CHECK_LT(z, 1.0);
+  }
+
+  // Streaming out and back in restores the exact state, as for std::mt19937.
+  std::stringstream stream;
+  stream << rng1;
+  FastRng restored;
+  stream >> restored;
+  for (int i = 0; i < 100; ++i) {
+    SPIEL_CHECK_EQ(rng1(), restored());
+  }
+}
+
+void SymmetryTransformTest() {
+  // The 90-degree cell permutation composes to the identity after four
+  // applications.
+  std::vector<int> rotation = SymmetryCellPermutation(3, 3, /*transform=*/1);
+  std::vector<int> composed(9);
+  for (int cell = 0; cell < 9; ++cell) composed[cell] = cell;
+  for (int step = 0; step < 4; ++step) {
+    std::vector<int> next(9);
+    for (int cell = 0; cell < 9; ++cell) next[cell] = rotation[composed[cell]];
+    composed = next;
+  }
+  for (int cell = 0; cell < 9; ++cell) {
+    SPIEL_CHECK_EQ(composed[cell], cell);
+  }
+
+  // Mirroring the observation of a corner opening gives the observation of
+  // the mirrored corner opening.
+  std::unique_ptr<Game> game = LoadGame("tic_tac_toe");
+  std::vector<int> shape = game->ObservationNormalizedVectorShape();
+  std::unique_ptr<State> left = game->NewInitialState()->Child(0);
+  std::unique_ptr<State> right = game->NewInitialState()->Child(2);
+  std::vector<double> left_observation;
+  std::vector<double> right_observation;
+  left->ObservationAsNormalizedVector(0, &left_observation);
+  right->ObservationAsNormalizedVector(0, &right_observation);
+  std::vector<double> mirrored(left_observation.size());
+  SymmetryTransformPlanes(shape, /*transform=*/4, left_observation.data(),
+                          mirrored.data());
+  SPIEL_CHECK_TRUE(mirrored == right_observation);
+}
+
+void SimCoverageTrackerTest() {
+  // The sketch estimate stays within a few percent of the true cardinality
+  // and does not react to repeats.
+  SimCoverageTracker tracker;
+  for (uint64_t i = 0; i < 20000; ++i) tracker.RecordStateHash(i);
+  double estimate = tracker.ApproxDistinctStates();
+  SPIEL_CHECK_GE(estimate, 20000 * 0.95);
+  SPIEL_CHECK_LE(estimate, 20000 * 1.05);
+  for (uint64_t i = 0; i < 20000; ++i) tracker.RecordStateHash(i);
+  SPIEL_CHECK_EQ(tracker.ApproxDistinctStates(), estimate);
+  SPIEL_CHECK_EQ(tracker.states_recorded(), 40000);
+
+  // Merging two trackers that saw halves of the stream gives the same
+  // estimate as one tracker that saw all of it.
+  SimCoverageTracker left;
+  SimCoverageTracker right;
+  for (uint64_t i = 0; i < 10000; ++i) left.RecordStateHash(i);
+  for (uint64_t i = 10000; i < 20000; ++i) right.RecordStateHash(i);
+  left.Merge(right);
+  SPIEL_CHECK_EQ(left.ApproxDistinctStates(), estimate);
+
+  // Random simulations report plausible coverage: kuhn_poker has only a few
+  // dozen states and 12 information sets, so the estimates must stay well
+  // below the visit counts.
+  SimCoverageTracker coverage;
+  std::unique_ptr<Game> game = LoadGame("kuhn_poker");
+  RandomSimTest(*game, /*num_sims=*/100, &coverage);
+  SPIEL_CHECK_GT(coverage.states_recorded(), 0);
+  SPIEL_CHECK_GT(coverage.info_states_recorded(), 0);
+  SPIEL_CHECK_GT(coverage.ApproxDistinctStates(), 0);
+  SPIEL_CHECK_LE(coverage.ApproxDistinctStates(), 100.0);
+  SPIEL_CHECK_LE(coverage.ApproxDistinctInfoStates(), 20.0);
+
+  // The parallel harness merges per-thread trackers into the caller's.
+  SimCoverageTracker parallel_coverage;
+  ParallelRandomSimTest(*game, /*num_sims=*/100, /*num_threads=*/2,
+                        SimCheckMode::kFastSim, /*seed=*/0,
+                        &parallel_coverage);
+  SPIEL_CHECK_GT(parallel_coverage.states_recorded(), 0);
+  SPIEL_CHECK_GT(parallel_coverage.ApproxDistinctStates(), 0);
 }
 
 }  // namespace
@@ -251,9 +960,31 @@ void GameParametersTest() {
 int main(int argc, char** argv) {
   open_spiel::testing::GeneralTests();
   open_spiel::testing::KuhnTests();
+  open_spiel::testing::StatePoolTest();
+  open_spiel::testing::ScratchVectorTest();
+  open_spiel::testing::LegalActionsCacheTest();
+  open_spiel::testing::InformationStateKeyCacheTest();
+  open_spiel::testing::ActionHistoryTest();
+  open_spiel::testing::SpanTest();
+  open_spiel::testing::HistoryTrackingTest();
+  open_spiel::testing::BatchNormalizedVectorsTest();
+  open_spiel::testing::StepOutputsTest();
   open_spiel::testing::TicTacToeTests();
   open_spiel::testing::FlatJointactionTest();
   open_spiel::testing::PolicyTest();
+  open_spiel::testing::SmallActionsAndProbsTest();
+  open_spiel::testing::PolicyFileTest();
+  open_spiel::testing::PolicyCompactionTest();
   open_spiel::testing::LeducPokerDeserializeTest();
+  open_spiel::testing::TextStateSerializationTest();
+  open_spiel::testing::BinarySerializationTest();
+  open_spiel::testing::LoadGameCachedTest();
+  open_spiel::testing::HashValueTest();
   open_spiel::testing::GameParametersTest();
+  open_spiel::testing::StatsTest();
+  open_spiel::testing::JsonlStatsWriterTest();
+  open_spiel::testing::NumberFormattingTest();
+  open_spiel::testing::FastRngTest();
+  open_spiel::testing::SymmetryTransformTest();
+  open_spiel::testing::SimCoverageTrackerTest();
 }
@@ -0,0 +1,72 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "open_spiel/thread_affinity.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <thread>
+
+namespace open_spiel {
+
+#if defined(__linux__)
+
+int NumAvailableCpus() {
+  cpu_set_t process_mask;
+  CPU_ZERO(&process_mask);
+  if (sched_getaffinity(0, sizeof(process_mask), &process_mask) == 0) {
+    const int count = CPU_COUNT(&process_mask);
+    if (count > 0) return count;
+  }
+  const int count = std::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+bool PinCurrentThreadToCpu(int cpu) {
+  if (cpu < 0) return false;
+  cpu_set_t process_mask;
+  CPU_ZERO(&process_mask);
+  if (sched_getaffinity(0, sizeof(process_mask), &process_mask) != 0) {
+    return false;
+  }
+  // Find the cpu-th set bit: `cpu` indexes the CPUs the process may run on,
+  // not raw CPU ids, so pinning composes with an outer taskset/cgroup mask.
+  int seen = 0;
+  for (int id = 0; id < CPU_SETSIZE; ++id) {
+    if (!CPU_ISSET(id, &process_mask)) continue;
+    if (seen++ == cpu) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(id, &mask);
+      return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+    }
+  }
+  return false;
+}
+
+#else  // !defined(__linux__)
+
+int NumAvailableCpus() {
+  const int count = std::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+bool PinCurrentThreadToCpu(int cpu) { return false; }
+
+#endif  // defined(__linux__)
+
+}  // namespace open_spiel
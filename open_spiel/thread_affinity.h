@@ -0,0 +1,47 @@
+// Copyright 2019 DeepMind Technologies Ltd. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_OPEN_SPIEL_THREAD_AFFINITY_H_
+#define THIRD_PARTY_OPEN_SPIEL_THREAD_AFFINITY_H_
+
+// A thin portability layer over thread placement, used by the multithreaded
+// solvers. Its purpose is memory locality on multi-socket machines: Linux
+// places a page on the NUMA node of the thread that first touches it, so a
+// worker that stays on one CPU for the lifetime of a run keeps the table
+// entries it inserts node-local, and its repeated regret updates to those
+// entries avoid cross-socket traffic. Without pinning the scheduler is free
+// to migrate workers between sockets, after which every table access may be
+// remote.
+//
+// Only Linux is supported; on other platforms pinning is a no-op that
+// reports failure, which callers treat as "run unpinned".
+
+namespace open_spiel {
+
+// The number of CPUs the calling process may run on: the size of the
+// process's affinity mask where one is available, otherwise the hardware
+// concurrency. Always at least 1.
+int NumAvailableCpus();
+
+// Pins the calling thread to one CPU. `cpu` indexes the CPUs the process may
+// run on (so worker indices can be used directly even when the process is
+// confined to a subset of the machine), and should be less than
+// NumAvailableCpus(). Returns false if pinning is unsupported on this
+// platform or the call fails; the thread then runs wherever the scheduler
+// puts it.
+bool PinCurrentThreadToCpu(int cpu);
+
+}  // namespace open_spiel
+
+#endif  // THIRD_PARTY_OPEN_SPIEL_THREAD_AFFINITY_H_